@@ -0,0 +1,80 @@
+/*
+[configuration]
+
+[OptionRangeFloat]
+GUIName = Bloom Strength
+OptionName = BLOOM_STRENGTH
+MinValue = 0.0
+MaxValue = 2.0
+StepAmount = 0.05
+DefaultValue = 0.6
+
+[OptionRangeFloat]
+GUIName = Bloom Threshold
+OptionName = BLOOM_THRESHOLD
+MinValue = 0.0
+MaxValue = 1.0
+StepAmount = 0.05
+DefaultValue = 0.6
+
+[Pass]
+EntryPoint = extract_bright
+Input0 = ColorBuffer
+Output = bright
+OutputScale = 0.5
+
+[Pass]
+EntryPoint = blur_horizontal
+Input0 = bright
+Output = blurred_h
+OutputScale = 0.5
+
+[Pass]
+EntryPoint = blur_vertical
+Input0 = blurred_h
+Output = blurred
+OutputScale = 0.5
+
+[Pass]
+EntryPoint = combine
+Input0 = ColorBuffer
+Input1 = blurred
+
+[/configuration]
+*/
+
+// Five-tap gaussian, applied once in each direction at half resolution.
+float4 Blur(float2 direction)
+{
+	float2 offset = direction * GetInvResolution();
+	float4 sum = Sample() * 0.2270270270;
+	sum += SampleLocation(GetCoordinates() + offset * 1.3846153846) * 0.3162162162;
+	sum += SampleLocation(GetCoordinates() - offset * 1.3846153846) * 0.3162162162;
+	sum += SampleLocation(GetCoordinates() + offset * 3.2307692308) * 0.0702702703;
+	sum += SampleLocation(GetCoordinates() - offset * 3.2307692308) * 0.0702702703;
+	return sum;
+}
+
+void extract_bright()
+{
+	float4 color = Sample();
+	float luma = dot(color.rgb, float3(0.299, 0.587, 0.114));
+	SetOutput(color * max(luma - GetOption(BLOOM_THRESHOLD), 0.0) / max(luma, 0.0001));
+}
+
+void blur_horizontal()
+{
+	SetOutput(Blur(float2(1.0, 0.0)));
+}
+
+void blur_vertical()
+{
+	SetOutput(Blur(float2(0.0, 1.0)));
+}
+
+void combine()
+{
+	float4 color = SampleInput(0);
+	float4 bloom = SampleInput(1);
+	SetOutput(float4(color.rgb + bloom.rgb * GetOption(BLOOM_STRENGTH), color.a));
+}
@@ -177,11 +177,18 @@ private:
   // size (in samples)
   std::vector<std::vector<cplx>> signal;
 
+  // the channel allocation maps of the setup, looked up once in Init() instead
+  // of for every bin
+  const std::vector<std::vector<float *>> *alloc;
+  // which of the left, center and right phases each non-LFE channel is built
+  // with
+  std::vector<unsigned int> phase_index;
+
   // helper functions
   inline float sqr(double x);
   inline double amplitude(const cplx &x);
   inline double phase(const cplx &x);
-  inline cplx polar(double a, double p);
+  inline cplx unit_phasor(const cplx &x);
   inline float min(double a, double b);
   inline float max(double a, double b);
   inline float clamp(double x);
@@ -18,6 +18,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 #include "FreeSurround/FreeSurroundDecoder.h"
 #include "FreeSurround/ChannelMaps.h"
+#include <algorithm>
 #include <cmath>
 
 #undef min
@@ -54,7 +55,13 @@ void DPL2FSDecoder::Init(channel_setup chsetup, unsigned int blsize,
     rf = std::vector<cplx>(N / 2 + 1);
     forward = kiss_fftr_alloc(N, 0, 0, 0);
     inverse = kiss_fftr_alloc(N, 1, 0, 0);
-    C = static_cast<unsigned int>(chn_alloc[setup].size());
+    alloc = &chn_alloc[setup];
+    C = static_cast<unsigned int>(alloc->size());
+
+    // the last channel is the LFE, which is always built from the center phase
+    phase_index.resize(C - 1);
+    for (unsigned int c = 0; c < C - 1; c++)
+      phase_index[c] = 1 + static_cast<int>(sign(chn_xsf[setup][c]));
 
     // Allocate per-channel buffers
     outbuf.resize((N + N / 2) * C);
@@ -118,7 +125,12 @@ void DPL2FSDecoder::set_front_separation(float v) { front_separation = v; }
 void DPL2FSDecoder::set_rear_separation(float v) { rear_separation = v; }
 void DPL2FSDecoder::set_low_cutoff(float v) { lo_cut = v * (N / 2); }
 void DPL2FSDecoder::set_high_cutoff(float v) { hi_cut = v * (N / 2); }
-void DPL2FSDecoder::set_bass_redirection(bool v) { use_lfe = v; }
+void DPL2FSDecoder::set_bass_redirection(bool v) {
+  use_lfe = v;
+  // without bass redirection, the LFE channel is silent
+  if (!use_lfe && !signal.empty())
+    std::fill(signal[C - 1].begin(), signal[C - 1].end(), cplx(0, 0));
+}
 
 // helper functions
 inline float DPL2FSDecoder::sqr(double x) { return static_cast<float>(x * x); }
@@ -128,8 +140,10 @@ inline double DPL2FSDecoder::amplitude(const cplx &x) {
 inline double DPL2FSDecoder::phase(const cplx &x) {
   return atan2(x.imag(), x.real());
 }
-inline cplx DPL2FSDecoder::polar(double a, double p) {
-  return cplx(a * cos(p), a * sin(p));
+// the same as polar(1, phase(x)), without the trigonometry
+inline cplx DPL2FSDecoder::unit_phasor(const cplx &x) {
+  const double a = std::abs(x);
+  return a == 0 ? cplx(1, 0) : x / a;
 }
 inline float DPL2FSDecoder::min(double a, double b) {
   return static_cast<float>(a < b ? a : b);
@@ -170,13 +184,20 @@ void DPL2FSDecoder::buffered_decode(float *input) {
   for (unsigned int f = 1; f < N / 2; f++) {
     // get Lt/Rt amplitudes & phases
     double ampL = amplitude(lf[f]), ampR = amplitude(rf[f]);
-    double phaseL = phase(lf[f]), phaseR = phase(rf[f]);
     // calculate the amplitude & phase differences
     double ampDiff =
         clamp((ampL + ampR < epsilon) ? 0 : (ampR - ampL) / (ampR + ampL));
-    double phaseDiff = abs(phaseL - phaseR);
-    if (phaseDiff > pi)
-      phaseDiff = 2 * pi - phaseDiff;
+    // the phase difference, wrapped into [0, pi], is the angle between the two
+    // bins, which takes one atan2 instead of two. A zero bin has a phase of 0,
+    // which the angle doesn't capture.
+    double phaseDiff;
+    if (ampL == 0 || ampR == 0) {
+      phaseDiff = abs(phase(lf[f]) - phase(rf[f]));
+      if (phaseDiff > pi)
+        phaseDiff = 2 * pi - phaseDiff;
+    } else {
+      phaseDiff = abs(phase(lf[f] * std::conj(rf[f])));
+    }
 
     // decode into x/y soundfield position
     double x, y;
@@ -195,10 +216,9 @@ void DPL2FSDecoder::buffered_decode(float *input) {
 
     // get total signal amplitude
     double amp_total = sqrt(ampL * ampL + ampR * ampR);
-    // and total L/C/R signal phases
-    double phase_of[] = {
-        phaseL, atan2(lf[f].imag() + rf[f].imag(), lf[f].real() + rf[f].real()),
-        phaseR};
+    // and total L/C/R signal phases, as unit phasors
+    const cplx phase_of[] = {unit_phasor(lf[f]), unit_phasor(lf[f] + rf[f]),
+                             unit_phasor(rf[f])};
     // compute 2d channel map indexes p/q and update x/y to fractional offsets
     // in the map grid
     int p = map_to_grid(x), q = map_to_grid(y);
@@ -207,11 +227,12 @@ void DPL2FSDecoder::buffered_decode(float *input) {
       // look up channel map at respective position (with bilinear
       // interpolation) and build the
       // signal
-      std::vector<float *> &a = chn_alloc[setup][c];
-      signal[c][f] = polar(
-          amp_total * ((1 - x) * (1 - y) * a[q][p] + x * (1 - y) * a[q][p + 1] +
-                       (1 - x) * y * a[q + 1][p] + x * y * a[q + 1][p + 1]),
-          phase_of[1 + static_cast<int>(sign(chn_xsf[setup][c]))]);
+      const std::vector<float *> &a = (*alloc)[c];
+      signal[c][f] =
+          amp_total *
+          ((1 - x) * (1 - y) * a[q][p] + x * (1 - y) * a[q][p + 1] +
+           (1 - x) * y * a[q + 1][p] + x * y * a[q + 1][p + 1]) *
+          phase_of[phase_index[c]];
     }
 
     // optionally redirect bass
@@ -221,7 +242,7 @@ void DPL2FSDecoder::buffered_decode(float *input) {
           f < lo_cut ? 1
                      : 0.5 * (1 + cos(pi * (f - lo_cut) / (hi_cut - lo_cut)));
       // assign LFE channel
-      signal[C - 1][f] = lfe_level * polar(amp_total, phase_of[1]);
+      signal[C - 1][f] = lfe_level * amp_total * phase_of[1];
       // subtract the signal from the other channels
       for (unsigned int c = 0; c < C - 1; c++)
         signal[c][f] *= (1 - lfe_level);
@@ -232,8 +253,10 @@ void DPL2FSDecoder::buffered_decode(float *input) {
   memcpy(&outbuf[0], &outbuf[C * N / 2], N * C * 4);
   // and clear the rest
   memset(&outbuf[C * N], 0, C * 4 * N / 2);
-  // backtransform each channel and overlap-add
-  for (unsigned int c = 0; c < C; c++) {
+  // backtransform each channel and overlap-add, skipping the silent LFE
+  // channel when bass redirection is off
+  const unsigned int active_channels = use_lfe ? C : C - 1;
+  for (unsigned int c = 0; c < active_channels; c++) {
     // back-transform into time domain
     kiss_fftri(inverse, (kiss_fft_cpx *)&signal[c][0], &dst[0]);
     // add the result to the last 2/3 of the output buffer, windowed (and
@@ -9,6 +9,7 @@
 #include "AudioCommon/NullSoundStream.h"
 #include "AudioCommon/OpenALStream.h"
 #include "AudioCommon/OpenSLESStream.h"
+#include "AudioCommon/PipeWireStream.h"
 #include "AudioCommon/PulseAudioStream.h"
 #include "AudioCommon/WASAPIStream.h"
 #include "Common/Common.h"
@@ -39,6 +40,8 @@ static std::unique_ptr<SoundStream> CreateSoundStreamForBackend(std::string_view
     return std::make_unique<AlsaSound>();
   else if (backend == BACKEND_PULSEAUDIO && PulseAudio::isValid())
     return std::make_unique<PulseAudio>();
+  else if (backend == BACKEND_PIPEWIRE && PipeWireStream::isValid())
+    return std::make_unique<PipeWireStream>();
   else if (backend == BACKEND_OPENSLES && OpenSLESStream::isValid())
     return std::make_unique<OpenSLESStream>();
   else if (backend == BACKEND_WASAPI && WASAPIStream::isValid())
@@ -116,6 +119,8 @@ std::vector<std::string> GetSoundBackends()
     backends.emplace_back(BACKEND_ALSA);
   if (PulseAudio::isValid())
     backends.emplace_back(BACKEND_PULSEAUDIO);
+  if (PipeWireStream::isValid())
+    backends.emplace_back(BACKEND_PIPEWIRE);
   if (OpenALStream::isValid())
     backends.emplace_back(BACKEND_OPENAL);
   if (OpenSLESStream::isValid())
@@ -13,4 +13,13 @@ enum class DPL2Quality
   High = 2,
   Highest = 3
 };
+
+enum class ResamplingQuality
+{
+  // Linear interpolation between two frames.
+  Linear = 0,
+  // Windowed sinc interpolation over 8 or 16 frames.
+  Sinc8 = 1,
+  Sinc16 = 2
+};
 }  // namespace AudioCommon
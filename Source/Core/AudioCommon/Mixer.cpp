@@ -13,6 +13,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
+#include "Common/Thread.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 
@@ -31,8 +32,24 @@ static u32 DPL2QualityToFrameBlockSize(AudioCommon::DPL2Quality quality)
   }
 }
 
+static std::unique_ptr<AudioCommon::SincResampler>
+CreateSincResampler(AudioCommon::ResamplingQuality quality)
+{
+  switch (quality)
+  {
+  case AudioCommon::ResamplingQuality::Sinc8:
+    return std::make_unique<AudioCommon::SincResampler>(8);
+  case AudioCommon::ResamplingQuality::Sinc16:
+    return std::make_unique<AudioCommon::SincResampler>(16);
+  default:
+    return nullptr;
+  }
+}
+
 Mixer::Mixer(unsigned int BackendSampleRate)
-    : m_sampleRate(BackendSampleRate), m_stretcher(BackendSampleRate),
+    : m_sampleRate(BackendSampleRate),
+      m_sinc_resampler(CreateSincResampler(Config::Get(Config::MAIN_AUDIO_RESAMPLING_QUALITY))),
+      m_stretcher(BackendSampleRate),
       m_surround_decoder(BackendSampleRate,
                          DPL2QualityToFrameBlockSize(Config::Get(Config::MAIN_DPL2_QUALITY)))
 {
@@ -41,6 +58,8 @@ Mixer::Mixer(unsigned int BackendSampleRate)
 
 Mixer::~Mixer()
 {
+  if (m_is_stretching)
+    StopStretchThread();
 }
 
 void Mixer::DoState(PointerWrap& p)
@@ -54,27 +73,15 @@ void Mixer::DoState(PointerWrap& p)
 unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
                                    bool consider_framelimit)
 {
-  unsigned int currentSample = 0;
-
-  // Cache access in non-volatile variable
-  // This is the only function changing the read value, so it's safe to
-  // cache it locally although it's written here.
-  // The writing pointer will be modified outside, but it will only increase,
-  // so we will just ignore new written data while interpolating.
-  // Without this cache, the compiler wouldn't be allowed to optimize the
-  // interpolation loop.
-  u32 indexR = m_indexR.load();
-  u32 indexW = m_indexW.load();
-
   // render numleft sample pairs to samples[]
-  // advance indexR with sample position
+  // advance the read position with sample position
   // remember fractional offset
 
   float emulationspeed = SConfig::GetInstance().m_EmulationSpeed;
   float aid_sample_rate = static_cast<float>(m_input_sample_rate);
   if (consider_framelimit && emulationspeed > 0.0f)
   {
-    float numLeft = static_cast<float>(((indexW - indexR) & INDEX_MASK) / 2);
+    float numLeft = static_cast<float>(m_buffer.Size() / 2);
 
     u32 low_waterwark = m_input_sample_rate * SConfig::GetInstance().iTimingVariance / 1000;
     low_waterwark = std::min(low_waterwark, MAX_SAMPLES / 2);
@@ -94,52 +101,121 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
   s32 lvolume = m_LVolume.load();
   s32 rvolume = m_RVolume.load();
 
-  // TODO: consider a higher-quality resampling algorithm.
-  for (; currentSample < numSamples * 2 && ((indexW - indexR) & INDEX_MASK) > 2; currentSample += 2)
+  // Actual number of samples written to the buffer without padding.
+  const unsigned int actual_sample_count =
+      m_mixer->m_sinc_resampler ?
+          MixSinc(*m_mixer->m_sinc_resampler, samples, numSamples, ratio, lvolume, rvolume) :
+          MixLinear(samples, numSamples, ratio, lvolume, rvolume);
+
+  // Padding
+  short s[2];
+  s[0] = (m_last_frame[1] * rvolume) >> 8;
+  s[1] = (m_last_frame[0] * lvolume) >> 8;
+  for (unsigned int currentSample = actual_sample_count * 2; currentSample < numSamples * 2;
+       currentSample += 2)
   {
-    u32 indexR2 = indexR + 2;  // next sample
+    int sampleR = std::clamp(s[0] + samples[currentSample + 0], -32767, 32767);
+    int sampleL = std::clamp(s[1] + samples[currentSample + 1], -32767, 32767);
+
+    samples[currentSample + 0] = sampleR;
+    samples[currentSample + 1] = sampleL;
+  }
 
-    s16 l1 = Common::swap16(m_buffer[indexR & INDEX_MASK]);   // current
-    s16 l2 = Common::swap16(m_buffer[indexR2 & INDEX_MASK]);  // next
+  return actual_sample_count;
+}
+
+unsigned int Mixer::MixerFifo::MixLinear(short* samples, unsigned int num_samples, u32 ratio,
+                                         s32 lvolume, s32 rvolume)
+{
+  // The producer only ever adds frames, so anything it writes while interpolating is simply left
+  // for the next call.
+  const u32 available = static_cast<u32>(m_buffer.Size());
+  u32 index = 0;
+  unsigned int currentSample = 0;
+  for (; currentSample < num_samples * 2 && index + 2 < available; currentSample += 2)
+  {
+    u32 index2 = index + 2;  // next sample
+
+    s16 l1 = Common::swap16(m_buffer.Peek(index));   // current
+    s16 l2 = Common::swap16(m_buffer.Peek(index2));  // next
     int sampleL = ((l1 << 16) + (l2 - l1) * (u16)m_frac) >> 16;
     sampleL = (sampleL * lvolume) >> 8;
     sampleL += samples[currentSample + 1];
     samples[currentSample + 1] = std::clamp(sampleL, -32767, 32767);
 
-    s16 r1 = Common::swap16(m_buffer[(indexR + 1) & INDEX_MASK]);   // current
-    s16 r2 = Common::swap16(m_buffer[(indexR2 + 1) & INDEX_MASK]);  // next
+    s16 r1 = Common::swap16(m_buffer.Peek(index + 1));   // current
+    s16 r2 = Common::swap16(m_buffer.Peek(index2 + 1));  // next
     int sampleR = ((r1 << 16) + (r2 - r1) * (u16)m_frac) >> 16;
     sampleR = (sampleR * rvolume) >> 8;
     sampleR += samples[currentSample];
     samples[currentSample] = std::clamp(sampleR, -32767, 32767);
 
     m_frac += ratio;
-    indexR += 2 * (u16)(m_frac >> 16);
+    index += 2 * (u16)(m_frac >> 16);
     m_frac &= 0xffff;
   }
 
-  // Actual number of samples written to the buffer without padding.
-  unsigned int actual_sample_count = currentSample / 2;
+  // A large ratio can step past the frames that were available.
+  index = std::min(index, available & ~1u);
+  if (index != 0)
+  {
+    m_last_frame[0] = Common::swap16(m_buffer.Peek(index - 2));
+    m_last_frame[1] = Common::swap16(m_buffer.Peek(index - 1));
+    m_buffer.Pop(index);
+  }
 
-  // Padding
-  short s[2];
-  s[0] = Common::swap16(m_buffer[(indexR - 1) & INDEX_MASK]);
-  s[1] = Common::swap16(m_buffer[(indexR - 2) & INDEX_MASK]);
-  s[0] = (s[0] * rvolume) >> 8;
-  s[1] = (s[1] * lvolume) >> 8;
-  for (; currentSample < numSamples * 2; currentSample += 2)
+  return currentSample / 2;
+}
+
+unsigned int Mixer::MixerFifo::MixSinc(const AudioCommon::SincResampler& resampler,
+                                       short* samples, unsigned int num_samples, u32 ratio,
+                                       s32 lvolume, s32 rvolume)
+{
+  const u32 history = resampler.GetHistorySize();
+  const u32 max_output = std::min(num_samples, MAX_SAMPLES);
+
+  // Only copy out the frames this call can use: the ones under the filter for every output
+  // frame, and one for rounding.
+  const u64 last_position = m_frac + static_cast<u64>(ratio) * max_output;
+  const u64 needed_frames = (last_position >> 16) + resampler.GetNumTaps() - history + 1;
+  const u32 num_frames = static_cast<u32>(
+      std::min<u64>({m_buffer.Size() / 2, needed_frames, MAX_SAMPLES}));
+
+  m_buffer.Peek(m_sinc_input.data(), 0, num_frames * 2);
+  for (u32 i = 0; i < num_frames; i++)
   {
-    int sampleR = std::clamp(s[0] + samples[currentSample + 0], -32767, 32767);
-    int sampleL = std::clamp(s[1] + samples[currentSample + 1], -32767, 32767);
+    m_sinc_left[history + i] = Common::swap16(m_sinc_input[i * 2]);
+    m_sinc_right[history + i] = Common::swap16(m_sinc_input[i * 2 + 1]);
+  }
 
-    samples[currentSample + 0] = sampleR;
-    samples[currentSample + 1] = sampleL;
+  u32 pos = m_frac;
+  const u32 written = resampler.Resample(m_sinc_left.data(), m_sinc_right.data(),
+                                         history + num_frames, &pos, ratio, m_sinc_output.data(),
+                                         max_output);
+
+  for (u32 i = 0; i < written; i++)
+  {
+    int sampleL = (m_sinc_output[i * 2] * lvolume) >> 8;
+    sampleL += samples[i * 2 + 1];
+    samples[i * 2 + 1] = std::clamp(sampleL, -32767, 32767);
+
+    int sampleR = (m_sinc_output[i * 2 + 1] * rvolume) >> 8;
+    sampleR += samples[i * 2];
+    samples[i * 2] = std::clamp(sampleR, -32767, 32767);
   }
 
-  // Flush cached variable
-  m_indexR.store(indexR);
+  // A large ratio can step past the frames that were available.
+  const u32 consumed = std::min(pos >> 16, num_frames);
+  m_frac = pos & 0xffff;
+  if (consumed != 0)
+  {
+    m_last_frame = {m_sinc_left[history + consumed - 1], m_sinc_right[history + consumed - 1]};
+    std::copy_n(m_sinc_left.begin() + consumed, history, m_sinc_left.begin());
+    std::copy_n(m_sinc_right.begin() + consumed, history, m_sinc_right.begin());
+    m_buffer.Pop(consumed * 2);
+  }
 
-  return actual_sample_count;
+  return written;
 }
 
 unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
@@ -151,34 +227,152 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
 
   if (SConfig::GetInstance().m_audio_stretch)
   {
-    unsigned int available_samples =
-        std::min(m_dma_mixer.AvailableSamples(), m_streaming_mixer.AvailableSamples());
-
-    m_scratch_buffer.fill(0);
-
-    m_dma_mixer.Mix(m_scratch_buffer.data(), available_samples, false);
-    m_streaming_mixer.Mix(m_scratch_buffer.data(), available_samples, false);
-    m_wiimote_speaker_mixer.Mix(m_scratch_buffer.data(), available_samples, false);
-
+    // The FIFOs are only read by one thread at a time. While stretching, that's the stretch
+    // thread, and starting or joining it hands them over.
     if (!m_is_stretching)
     {
-      m_stretcher.Clear();
+      StartStretchThread();
       m_is_stretching = true;
     }
-    m_stretcher.ProcessSamples(m_scratch_buffer.data(), available_samples, num_samples);
-    m_stretcher.GetStretchedSamples(samples, num_samples);
+    MixStretched(samples, num_samples);
   }
   else
   {
+    if (m_is_stretching)
+    {
+      StopStretchThread();
+      m_is_stretching = false;
+    }
     m_dma_mixer.Mix(samples, num_samples, true);
     m_streaming_mixer.Mix(samples, num_samples, true);
     m_wiimote_speaker_mixer.Mix(samples, num_samples, true);
-    m_is_stretching = false;
   }
 
   return num_samples;
 }
 
+void Mixer::StartStretchThread()
+{
+  m_stretched_buffer.Clear();
+  m_stretch_primed = false;
+  m_stretch_stable_frames = 0;
+  m_stretch_target_frames.store(m_sampleRate * STRETCH_INITIAL_TARGET_MS / 1000);
+  m_stretch_underruns.store(0);
+
+  m_stretch_thread_running.Set();
+  m_stretch_thread = std::thread(&Mixer::StretchThread, this);
+}
+
+void Mixer::StopStretchThread()
+{
+  m_stretch_thread_running.Clear();
+  m_stretch_wakeup.Set();
+  m_stretch_thread.join();
+}
+
+void Mixer::StretchThread()
+{
+  Common::SetCurrentThreadName("Audio stretch thread");
+  m_stretcher.Clear();
+
+  while (m_stretch_thread_running.IsSet())
+  {
+    // Every Mix call wakes this thread back up, so the frames that are missing are the ones the
+    // backend has played since the last time around. Stretching exactly that many keeps the
+    // stretcher's view of the output rate the same as when it was called from Mix directly.
+    const u32 buffered_frames = static_cast<u32>(m_stretched_buffer.Size() / 2);
+    const u32 target_frames = m_stretch_target_frames.load(std::memory_order_relaxed);
+    if (buffered_frames >= target_frames)
+    {
+      m_stretch_wakeup.WaitFor(std::chrono::milliseconds(STRETCH_IDLE_WAIT_MS));
+      continue;
+    }
+
+    const u32 num_out = std::min(target_frames - buffered_frames, MAX_SAMPLES);
+    const u32 num_in = std::min(
+        {m_dma_mixer.AvailableSamples(), m_streaming_mixer.AvailableSamples(), MAX_SAMPLES});
+
+    m_stretch_input_buffer.fill(0);
+    m_dma_mixer.Mix(m_stretch_input_buffer.data(), num_in, false);
+    m_streaming_mixer.Mix(m_stretch_input_buffer.data(), num_in, false);
+    m_wiimote_speaker_mixer.Mix(m_stretch_input_buffer.data(), num_in, false);
+
+    m_stretcher.ProcessSamples(m_stretch_input_buffer.data(), num_in, num_out);
+    m_stretcher.GetStretchedSamples(m_stretch_output_buffer.data(), num_out);
+    m_stretched_buffer.Push(m_stretch_output_buffer.data(), num_out * 2);
+  }
+}
+
+void Mixer::MixStretched(short* samples, unsigned int num_samples)
+{
+  const u32 num_frames = std::min(num_samples, static_cast<u32>(m_stretched_buffer.Size() / 2));
+  m_stretched_buffer.Peek(samples, 0, num_frames * 2);
+  m_stretched_buffer.Pop(num_frames * 2);
+  m_stretch_wakeup.Set();
+
+  if (num_frames != 0)
+    m_last_stretched_frame = {samples[num_frames * 2 - 2], samples[num_frames * 2 - 1]};
+  for (u32 i = num_frames; i < num_samples; i++)
+  {
+    samples[i * 2] = m_last_stretched_frame[0];
+    samples[i * 2 + 1] = m_last_stretched_frame[1];
+  }
+
+  // The stretch thread needs a moment to fill the buffer for the first time, which isn't worth
+  // raising the latency over.
+  const bool underrun = num_frames != num_samples;
+  if (!underrun)
+    m_stretch_primed = true;
+  UpdateStretchTarget(num_samples, underrun && m_stretch_primed);
+}
+
+void Mixer::UpdateStretchTarget(unsigned int num_samples, bool underrun)
+{
+  // The stretch thread can only stay ahead when the backend asks for less than half of what is
+  // buffered at a time.
+  const u32 min_target = std::min(
+      std::max(num_samples * 2, m_sampleRate * STRETCH_MIN_TARGET_MS / 1000), MAX_SAMPLES);
+  const u32 target = m_stretch_target_frames.load(std::memory_order_relaxed);
+
+  u32 new_target = target;
+  if (underrun)
+  {
+    m_stretch_underruns.fetch_add(1, std::memory_order_relaxed);
+    m_stretch_stable_frames = 0;
+    new_target = target + target / 2;
+  }
+  else
+  {
+    m_stretch_stable_frames += num_samples;
+    if (m_stretch_stable_frames >= m_sampleRate * STRETCH_STABLE_TIME_MS / 1000)
+    {
+      m_stretch_stable_frames = 0;
+      new_target = target - target / 8;
+    }
+  }
+  new_target = std::clamp(new_target, min_target, MAX_SAMPLES);
+
+  if (new_target != target)
+  {
+    if (underrun)
+    {
+      INFO_LOG(AUDIO, "Audio stretching underrun, raising the target latency to %u ms",
+               new_target * 1000 / m_sampleRate);
+    }
+    m_stretch_target_frames.store(new_target, std::memory_order_relaxed);
+  }
+}
+
+Mixer::StretchStatistics Mixer::GetStretchStatistics() const
+{
+  StretchStatistics statistics;
+  statistics.target_latency_ms =
+      m_stretch_target_frames.load(std::memory_order_relaxed) * 1000 / m_sampleRate;
+  statistics.buffered_ms = static_cast<u32>(m_stretched_buffer.Size() / 2) * 1000 / m_sampleRate;
+  statistics.underruns = m_stretch_underruns.load(std::memory_order_relaxed);
+  return statistics;
+}
+
 unsigned int Mixer::MixSurround(float* samples, unsigned int num_samples)
 {
   if (!num_samples)
@@ -205,31 +399,11 @@ unsigned int Mixer::MixSurround(float* samples, unsigned int num_samples)
 
 void Mixer::MixerFifo::PushSamples(const short* samples, unsigned int num_samples)
 {
-  // Cache access in non-volatile variable
-  // indexR isn't allowed to cache in the audio throttling loop as it
-  // needs to get updates to not deadlock.
-  u32 indexW = m_indexW.load();
-
-  // Check if we have enough free space
-  // indexW == m_indexR results in empty buffer, so indexR must always be smaller than indexW
-  if (num_samples * 2 + ((indexW - m_indexR.load()) & INDEX_MASK) >= MAX_SAMPLES * 2)
-    return;
-
   // AyuanX: Actual re-sampling work has been moved to sound thread
   // to alleviate the workload on main thread
-  // and we simply store raw data here to make fast mem copy
-  int over_bytes = num_samples * 4 - (MAX_SAMPLES * 2 - (indexW & INDEX_MASK)) * sizeof(short);
-  if (over_bytes > 0)
-  {
-    memcpy(&m_buffer[indexW & INDEX_MASK], samples, num_samples * 4 - over_bytes);
-    memcpy(&m_buffer[0], samples + (num_samples * 4 - over_bytes) / sizeof(short), over_bytes);
-  }
-  else
-  {
-    memcpy(&m_buffer[indexW & INDEX_MASK], samples, num_samples * 4);
-  }
-
-  m_indexW.fetch_add(num_samples * 2);
+  // and we simply store raw data here to make fast mem copy.
+  // The samples are dropped if there isn't enough free space for all of them.
+  m_buffer.Push(samples, num_samples * 2);
 }
 
 void Mixer::PushSamples(const short* samples, unsigned int num_samples)
@@ -386,8 +560,12 @@ void Mixer::MixerFifo::SetVolume(unsigned int lvolume, unsigned int rvolume)
 
 unsigned int Mixer::MixerFifo::AvailableSamples() const
 {
-  unsigned int samples_in_fifo = ((m_indexW.load() - m_indexR.load()) & INDEX_MASK) / 2;
-  if (samples_in_fifo <= 1)
-    return 0;  // Mixer::MixerFifo::Mix always keeps one sample in the buffer.
-  return (samples_in_fifo - 1) * m_mixer->m_sampleRate / m_input_sample_rate;
+  // Mixer::MixerFifo::Mix always keeps the frames after the current position that the
+  // interpolation needs in the buffer.
+  const unsigned int lookahead =
+      m_mixer->m_sinc_resampler ? m_mixer->m_sinc_resampler->GetNumTaps() / 2 : 1;
+  unsigned int samples_in_fifo = static_cast<unsigned int>(m_buffer.Size() / 2);
+  if (samples_in_fifo <= lookahead)
+    return 0;
+  return (samples_in_fifo - lookahead) * m_mixer->m_sampleRate / m_input_sample_rate;
 }
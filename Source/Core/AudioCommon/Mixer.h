@@ -6,11 +6,17 @@
 
 #include <array>
 #include <atomic>
+#include <memory>
+#include <thread>
 
 #include "AudioCommon/AudioStretcher.h"
+#include "AudioCommon/SincResampler.h"
 #include "AudioCommon/SurroundDecoder.h"
 #include "AudioCommon/WaveFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
+#include "Common/SPSCRingBuffer.h"
 
 class PointerWrap;
 
@@ -46,13 +52,29 @@ public:
   float GetCurrentSpeed() const { return m_speed.load(); }
   void UpdateSpeed(float val) { m_speed.store(val); }
 
+  struct StretchStatistics
+  {
+    // How far ahead of the backend the stretch thread currently tries to stay.
+    u32 target_latency_ms;
+    u32 buffered_ms;
+    // Mix calls that ran out of stretched samples since stretching was enabled.
+    u32 underruns;
+  };
+  StretchStatistics GetStretchStatistics() const;
+
 private:
   static constexpr u32 MAX_SAMPLES = 1024 * 4;  // 128 ms
-  static constexpr u32 INDEX_MASK = MAX_SAMPLES * 2 - 1;
   static constexpr int MAX_FREQ_SHIFT = 200;  // Per 32000 Hz
   static constexpr float CONTROL_FACTOR = 0.2f;
   static constexpr u32 CONTROL_AVG = 32;  // In freq_shift per FIFO size offset
 
+  // The stretch thread's target latency grows by half on an underrun, and shrinks by an eighth
+  // after every STRETCH_STABLE_TIME_MS without one, down to STRETCH_MIN_TARGET_MS.
+  static constexpr u32 STRETCH_INITIAL_TARGET_MS = 20;
+  static constexpr u32 STRETCH_MIN_TARGET_MS = 5;
+  static constexpr u32 STRETCH_STABLE_TIME_MS = 2000;
+  static constexpr u32 STRETCH_IDLE_WAIT_MS = 10;
+
   const unsigned int SURROUND_CHANNELS = 6;
 
   class MixerFifo final
@@ -70,16 +92,31 @@ private:
     unsigned int AvailableSamples() const;
 
   private:
+    // Both return the number of frames written to samples, and consume the input they used.
+    unsigned int MixLinear(short* samples, unsigned int num_samples, u32 ratio, s32 lvolume,
+                           s32 rvolume);
+    unsigned int MixSinc(const AudioCommon::SincResampler& resampler, short* samples,
+                         unsigned int num_samples, u32 ratio, s32 lvolume, s32 rvolume);
+
     Mixer* m_mixer;
     unsigned m_input_sample_rate;
-    std::array<short, MAX_SAMPLES * 2> m_buffer{};
-    std::atomic<u32> m_indexW{0};
-    std::atomic<u32> m_indexR{0};
+    // Big endian stereo frames, written by the emulation thread and read by the audio thread.
+    Common::SPSCRingBuffer<short, MAX_SAMPLES * 2> m_buffer;
     // Volume ranges from 0-256
     std::atomic<s32> m_LVolume{256};
     std::atomic<s32> m_RVolume{256};
     float m_numLeftI = 0.0f;
     u32 m_frac = 0;
+
+    // Only touched by the audio thread. The last frame that was consumed, in host byte order, is
+    // repeated when the FIFO runs dry.
+    std::array<s16, 2> m_last_frame{};
+    // Deinterleaved input for the sinc resampler. The frames before the read position that the
+    // filter still needs are kept at the start.
+    std::array<s16, MAX_SAMPLES + AudioCommon::SincResampler::MAX_TAPS> m_sinc_left{};
+    std::array<s16, MAX_SAMPLES + AudioCommon::SincResampler::MAX_TAPS> m_sinc_right{};
+    std::array<s16, MAX_SAMPLES * 2> m_sinc_input;
+    std::array<s32, MAX_SAMPLES * 2> m_sinc_output;
   };
 
   MixerFifo m_dma_mixer{this, 32000};
@@ -87,8 +124,35 @@ private:
   MixerFifo m_wiimote_speaker_mixer{this, 3000};
   unsigned int m_sampleRate;
 
+  // Null when linear interpolation is used.
+  std::unique_ptr<AudioCommon::SincResampler> m_sinc_resampler;
+
+  // Audio stretching runs SoundTouch on its own thread, which keeps m_stretched_buffer filled
+  // ahead of the backend, so that Mix only has to copy the stretched samples out.
+  void StartStretchThread();
+  void StopStretchThread();
+  void StretchThread();
+  void MixStretched(short* samples, unsigned int num_samples);
+  void UpdateStretchTarget(unsigned int num_samples, bool underrun);
+
+  // Only touched by the audio thread.
   bool m_is_stretching = false;
+  bool m_stretch_primed = false;
+  u32 m_stretch_stable_frames = 0;
+  std::array<short, 2> m_last_stretched_frame{};
+
+  std::thread m_stretch_thread;
+  Common::Flag m_stretch_thread_running;
+  Common::Event m_stretch_wakeup;
+  Common::SPSCRingBuffer<short, MAX_SAMPLES * 2> m_stretched_buffer;
+  std::atomic<u32> m_stretch_target_frames{0};
+  std::atomic<u32> m_stretch_underruns{0};
+
+  // Only touched by the stretch thread.
   AudioCommon::AudioStretcher m_stretcher;
+  std::array<short, MAX_SAMPLES * 2> m_stretch_input_buffer;
+  std::array<short, MAX_SAMPLES * 2> m_stretch_output_buffer;
+
   AudioCommon::SurroundDecoder m_surround_decoder;
   std::array<short, MAX_SAMPLES * 2> m_scratch_buffer;
 
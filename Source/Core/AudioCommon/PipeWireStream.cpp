@@ -0,0 +1,149 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "AudioCommon/PipeWireStream.h"
+
+#include <algorithm>
+
+#include <spa/param/audio/format-utils.h>
+
+#include "Common/Logging/Log.h"
+#include "Core/Config/MainSettings.h"
+
+namespace
+{
+constexpr u32 CHANNELS = 2;
+constexpr u32 FRAME_SIZE = CHANNELS * sizeof(s16);
+
+// PipeWire's own limits for node.latency.
+constexpr int MIN_QUANTUM = 32;
+constexpr int MAX_QUANTUM = 8192;
+}  // namespace
+
+PipeWireStream::PipeWireStream()
+{
+  pw_init(nullptr, nullptr);
+
+  m_stream_events.version = PW_VERSION_STREAM_EVENTS;
+  m_stream_events.state_changed = StateChangedCallback;
+  m_stream_events.process = ProcessCallback;
+}
+
+PipeWireStream::~PipeWireStream()
+{
+  if (m_loop)
+    pw_thread_loop_stop(m_loop);
+  if (m_stream)
+    pw_stream_destroy(m_stream);
+  if (m_loop)
+    pw_thread_loop_destroy(m_loop);
+
+  pw_deinit();
+}
+
+bool PipeWireStream::Init()
+{
+  m_loop = pw_thread_loop_new("Audio thread - pipewire", nullptr);
+  if (!m_loop)
+  {
+    ERROR_LOG(AUDIO, "PipeWire failed to create a thread loop");
+    return false;
+  }
+
+  const u32 sample_rate = m_mixer->GetSampleRate();
+  const int quantum =
+      std::clamp(Config::Get(Config::MAIN_AUDIO_PIPEWIRE_QUANTUM), MIN_QUANTUM, MAX_QUANTUM);
+
+  pw_properties* properties =
+      pw_properties_new(PW_KEY_MEDIA_TYPE, "Audio", PW_KEY_MEDIA_CATEGORY, "Playback",
+                        PW_KEY_MEDIA_ROLE, "Game", PW_KEY_APP_NAME, "Dolphin", nullptr);
+  pw_properties_setf(properties, PW_KEY_NODE_LATENCY, "%d/%u", quantum, sample_rate);
+
+  // Takes ownership of the properties.
+  m_stream = pw_stream_new_simple(pw_thread_loop_get_loop(m_loop), "Playback", properties,
+                                  &m_stream_events, this);
+  if (!m_stream)
+  {
+    ERROR_LOG(AUDIO, "PipeWire failed to create a stream");
+    return false;
+  }
+
+  spa_audio_info_raw format{};
+  format.format = SPA_AUDIO_FORMAT_S16;
+  format.rate = sample_rate;
+  format.channels = CHANNELS;
+  format.position[0] = SPA_AUDIO_CHANNEL_FL;
+  format.position[1] = SPA_AUDIO_CHANNEL_FR;
+
+  u8 pod_buffer[1024];
+  spa_pod_builder builder{};
+  spa_pod_builder_init(&builder, pod_buffer, sizeof(pod_buffer));
+  const spa_pod* params[] = {spa_format_audio_raw_build(&builder, SPA_PARAM_EnumFormat, &format)};
+
+  // The stream starts out inactive, and is activated by SetRunning. Mixer::Mix doesn't take any
+  // locks, so it is safe to run on the realtime thread.
+  const auto flags =
+      static_cast<pw_stream_flags>(PW_STREAM_FLAG_AUTOCONNECT | PW_STREAM_FLAG_MAP_BUFFERS |
+                                   PW_STREAM_FLAG_RT_PROCESS | PW_STREAM_FLAG_INACTIVE);
+  const int result = pw_stream_connect(m_stream, PW_DIRECTION_OUTPUT, PW_ID_ANY, flags, params, 1);
+  if (result < 0)
+  {
+    ERROR_LOG(AUDIO, "PipeWire failed to connect the stream: %s", spa_strerror(result));
+    return false;
+  }
+
+  if (pw_thread_loop_start(m_loop) < 0)
+  {
+    ERROR_LOG(AUDIO, "PipeWire failed to start the thread loop");
+    return false;
+  }
+
+  NOTICE_LOG(AUDIO, "PipeWire backend requesting a quantum of %d frames", quantum);
+  return true;
+}
+
+bool PipeWireStream::SetRunning(bool running)
+{
+  pw_thread_loop_lock(m_loop);
+  const int result = pw_stream_set_active(m_stream, running);
+  pw_thread_loop_unlock(m_loop);
+
+  return result >= 0;
+}
+
+void PipeWireStream::StateChangedCallback(void* userdata, pw_stream_state old_state,
+                                          pw_stream_state state, const char* error)
+{
+  if (state == PW_STREAM_STATE_ERROR)
+    ERROR_LOG(AUDIO, "PipeWire stream error: %s", error ? error : "unknown");
+}
+
+// Called on PipeWire's realtime thread.
+void PipeWireStream::ProcessCallback(void* userdata)
+{
+  PipeWireStream* const stream = static_cast<PipeWireStream*>(userdata);
+
+  pw_buffer* const buffer = pw_stream_dequeue_buffer(stream->m_stream);
+  if (!buffer)
+    return;
+
+  spa_data& data = buffer->buffer->datas[0];
+  if (data.data)
+  {
+    u32 num_frames = data.maxsize / FRAME_SIZE;
+#if PW_CHECK_VERSION(0, 3, 49)
+    // Only fill what the graph will play this cycle, so that nothing is queued past the quantum.
+    if (buffer->requested != 0)
+      num_frames = std::min(num_frames, static_cast<u32>(buffer->requested));
+#endif
+
+    stream->m_mixer->Mix(static_cast<s16*>(data.data), num_frames);
+
+    data.chunk->offset = 0;
+    data.chunk->stride = FRAME_SIZE;
+    data.chunk->size = num_frames * FRAME_SIZE;
+  }
+
+  pw_stream_queue_buffer(stream->m_stream, buffer);
+}
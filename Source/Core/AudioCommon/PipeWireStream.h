@@ -0,0 +1,37 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#if defined(HAVE_PIPEWIRE) && HAVE_PIPEWIRE
+#include <pipewire/pipewire.h>
+#endif
+
+#include "AudioCommon/SoundStream.h"
+#include "Common/CommonTypes.h"
+
+// Plays the mix as a native PipeWire stream. The mixer is called straight from PipeWire's
+// realtime thread into the buffer that is being dequeued, so the latency is the graph's quantum,
+// which is requested with the AudioPipeWireQuantum setting.
+class PipeWireStream final : public SoundStream
+{
+#if defined(HAVE_PIPEWIRE) && HAVE_PIPEWIRE
+public:
+  PipeWireStream();
+  ~PipeWireStream() override;
+
+  bool Init() override;
+  bool SetRunning(bool running) override;
+  static bool isValid() { return true; }
+
+private:
+  static void StateChangedCallback(void* userdata, pw_stream_state old_state,
+                                   pw_stream_state state, const char* error);
+  static void ProcessCallback(void* userdata);
+
+  pw_stream_events m_stream_events{};
+  pw_thread_loop* m_loop = nullptr;
+  pw_stream* m_stream = nullptr;
+#endif
+};
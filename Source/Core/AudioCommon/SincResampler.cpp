@@ -0,0 +1,111 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "AudioCommon/SincResampler.h"
+
+#include <cmath>
+
+#include "Common/Assert.h"
+#include "Common/Intrinsics.h"
+#include "Common/MathUtil.h"
+
+namespace AudioCommon
+{
+SincResampler::SincResampler(u32 num_taps) : m_num_taps(num_taps)
+{
+  ASSERT(num_taps != 0 && num_taps % 8 == 0 && num_taps <= MAX_TAPS);
+
+  // The input is only ever upsampled or slightly downsampled, so the cutoff is at the input's
+  // Nyquist frequency. A Blackman window trades a wider transition band for less ringing.
+  m_coeffs.resize(NUM_PHASES * num_taps);
+  const double half_width = num_taps / 2.0;
+  for (u32 phase = 0; phase < NUM_PHASES; phase++)
+  {
+    const double frac = static_cast<double>(phase) / NUM_PHASES;
+
+    double weights[MAX_TAPS];
+    double total_weight = 0.0;
+    for (u32 tap = 0; tap < num_taps; tap++)
+    {
+      const double distance = static_cast<double>(tap) - GetHistorySize() - frac;
+      const double x = MathUtil::PI * distance;
+      const double sinc = distance == 0.0 ? 1.0 : std::sin(x) / x;
+      const double t = distance / half_width;
+      const double window = 0.42 + 0.5 * std::cos(MathUtil::PI * t) +
+                            0.08 * std::cos(2.0 * MathUtil::PI * t);
+      weights[tap] = sinc * window;
+      total_weight += weights[tap];
+    }
+
+    // Normalize every phase to unity gain, putting the rounding error on the largest tap, so that
+    // a constant input doesn't pick up a ripple.
+    s16* coeffs = &m_coeffs[phase * num_taps];
+    s32 total_coeffs = 0;
+    u32 largest_tap = 0;
+    for (u32 tap = 0; tap < num_taps; tap++)
+    {
+      coeffs[tap] =
+          static_cast<s16>(std::lround(weights[tap] / total_weight * (1 << COEFF_SHIFT)));
+      total_coeffs += coeffs[tap];
+      if (std::abs(coeffs[tap]) > std::abs(coeffs[largest_tap]))
+        largest_tap = tap;
+    }
+    coeffs[largest_tap] += static_cast<s16>((1 << COEFF_SHIFT) - total_coeffs);
+  }
+}
+
+u32 SincResampler::Resample(const s16* left, const s16* right, u32 num_frames, u32* pos,
+                            u32 ratio, s32* output, u32 max_frames) const
+{
+  u32 current_pos = *pos;
+  u32 written = 0;
+  for (; written < max_frames; written++)
+  {
+    const u32 first_frame = current_pos >> 16;
+    if (first_frame + m_num_taps > num_frames)
+      break;
+
+    const s16* coeffs = &m_coeffs[((current_pos & 0xFFFF) >> (16 - PHASE_BITS)) * m_num_taps];
+    const s16* left_taps = left + first_frame;
+    const s16* right_taps = right + first_frame;
+
+#ifdef _M_X86
+    // The taps are at most 2.0 in total magnitude, so PMADDWD's sums can't overflow.
+    __m128i left_sums = _mm_setzero_si128();
+    __m128i right_sums = _mm_setzero_si128();
+    for (u32 tap = 0; tap < m_num_taps; tap += 8)
+    {
+      const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(coeffs + tap));
+      left_sums = _mm_add_epi32(
+          left_sums, _mm_madd_epi16(
+                         _mm_loadu_si128(reinterpret_cast<const __m128i*>(left_taps + tap)), c));
+      right_sums = _mm_add_epi32(
+          right_sums, _mm_madd_epi16(
+                          _mm_loadu_si128(reinterpret_cast<const __m128i*>(right_taps + tap)), c));
+    }
+    // [l0 + l2, r0 + r2, l1 + l3, r1 + r3], then the two halves for [l, r].
+    const __m128i pair_sums = _mm_add_epi32(_mm_unpacklo_epi32(left_sums, right_sums),
+                                            _mm_unpackhi_epi32(left_sums, right_sums));
+    const __m128i sums = _mm_add_epi32(pair_sums, _mm_unpackhi_epi64(pair_sums, pair_sums));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(output + written * 2),
+                     _mm_srai_epi32(sums, COEFF_SHIFT));
+#else
+    s32 left_sum = 0;
+    s32 right_sum = 0;
+    for (u32 tap = 0; tap < m_num_taps; tap++)
+    {
+      left_sum += left_taps[tap] * coeffs[tap];
+      right_sum += right_taps[tap] * coeffs[tap];
+    }
+    output[written * 2] = left_sum >> COEFF_SHIFT;
+    output[written * 2 + 1] = right_sum >> COEFF_SHIFT;
+#endif
+
+    current_pos += ratio;
+  }
+
+  *pos = current_pos;
+  return written;
+}
+}  // namespace AudioCommon
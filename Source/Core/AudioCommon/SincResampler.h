@@ -0,0 +1,45 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace AudioCommon
+{
+// Windowed sinc interpolation of 16-bit stereo audio. The filter is precomputed for 256 positions
+// between two input frames, so interpolating an output frame is one dot product per channel.
+class SincResampler
+{
+public:
+  static constexpr u32 MAX_TAPS = 16;
+
+  // num_taps must be a multiple of 8, and at most MAX_TAPS.
+  explicit SincResampler(u32 num_taps);
+
+  u32 GetNumTaps() const { return m_num_taps; }
+  // Frames the filter reads before the interpolated position.
+  u32 GetHistorySize() const { return m_num_taps / 2 - 1; }
+
+  // Interpolates the deinterleaved input in left and right, starting at the 16.16 fixed point
+  // frame position *pos and advancing it by ratio per output frame. Position 0 is GetHistorySize()
+  // frames into the input, so that the filter has the frames before it. Writes interleaved left
+  // and right frames to output, which aren't clamped, until max_frames have been written or the
+  // next one would need frames past num_frames. Returns the number of frames written.
+  u32 Resample(const s16* left, const s16* right, u32 num_frames, u32* pos, u32 ratio, s32* output,
+               u32 max_frames) const;
+
+private:
+  static constexpr u32 PHASE_BITS = 8;
+  static constexpr u32 NUM_PHASES = 1 << PHASE_BITS;
+  // The filter is in 2.14 fixed point, so that the center tap of 1.0 fits.
+  static constexpr u32 COEFF_SHIFT = 14;
+
+  u32 m_num_taps;
+  // NUM_PHASES rows of m_num_taps coefficients.
+  std::vector<s16> m_coeffs;
+};
+}  // namespace AudioCommon
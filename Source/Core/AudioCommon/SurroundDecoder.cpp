@@ -32,9 +32,11 @@ size_t SurroundDecoder::QueryFramesNeededForSurroundOutput(const size_t output_f
 {
   if (m_decoded_fifo.size() < output_frames * SURROUND_CHANNELS)
   {
-    // Output stereo frames needed to have at least the desired number of surround frames
+    // Output stereo frames needed to have at least the desired number of surround frames, in
+    // whole blocks. A period that is already a multiple of the block size mustn't get an extra
+    // block, which wouldn't fit in the mixer's buffer with the largest block size.
     size_t frames_needed = output_frames - m_decoded_fifo.size() / SURROUND_CHANNELS;
-    return frames_needed + m_frame_block_size - frames_needed % m_frame_block_size;
+    return (frames_needed + m_frame_block_size - 1) / m_frame_block_size * m_frame_block_size;
   }
 
   return 0;
@@ -50,11 +52,9 @@ void SurroundDecoder::PutFrames(const short* in, const size_t num_frames_in)
   while (remaining_frames > 0)
   {
     // Convert to float
+    constexpr float scale = 1.0f / std::numeric_limits<short>::max();
     for (size_t i = 0, end = m_frame_block_size * STEREO_CHANNELS; i < end; ++i)
-    {
-      m_float_conversion_buffer[i] = in[i + frame_index * STEREO_CHANNELS] /
-                                     static_cast<float>(std::numeric_limits<short>::max());
-    }
+      m_float_conversion_buffer[i] = in[i + frame_index * STEREO_CHANNELS] * scale;
 
     // Decode
     const float* dpl2_fs = m_fsdecoder->decode(m_float_conversion_buffer.data());
@@ -30,7 +30,9 @@ private:
 
   std::unique_ptr<DPL2FSDecoder> m_fsdecoder;
   std::array<float, 32768> m_float_conversion_buffer;
-  FixedSizeQueue<float, 32768> m_decoded_fifo;
+  // Holds less than one mix period and one block of 6 channel frames, which are at most 4096
+  // frames each.
+  FixedSizeQueue<float, 8192 * 6> m_decoded_fifo;
 };
 
 }  // namespace AudioCommon
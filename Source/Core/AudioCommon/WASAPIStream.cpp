@@ -8,6 +8,7 @@
 
 // clang-format off
 #include <Audioclient.h>
+#include <avrt.h>
 #include <comdef.h>
 #include <mmdeviceapi.h>
 #include <devpkey.h>
@@ -21,6 +22,11 @@
 #include "Core/ConfigManager.h"
 #include "VideoCommon/OnScreenDisplay.h"
 
+#pragma comment(lib, "avrt.lib")
+
+// REFERENCE_TIME is in units of 100 ns.
+constexpr REFERENCE_TIME REFTIMES_PER_MS = 10000;
+
 WASAPIStream::WASAPIStream()
 {
   CoInitialize(nullptr);
@@ -275,13 +281,12 @@ bool WASAPIStream::SetRunning(bool running)
       return false;
     }
 
+    // Start from the smallest period the device supports, the user's latency setting is only
+    // added on top of it.
     REFERENCE_TIME device_period = 0;
 
     result = m_audio_client->GetDevicePeriod(nullptr, &device_period);
 
-    device_period += SConfig::GetInstance().iLatency * (10000 / m_format.Format.nChannels);
-    INFO_LOG(AUDIO, "Audio period set to %d", device_period);
-
     if (!HandleWinAPI("Failed to obtain device period", result))
     {
       device->Release();
@@ -290,6 +295,9 @@ bool WASAPIStream::SetRunning(bool running)
       return false;
     }
 
+    device_period += SConfig::GetInstance().iLatency * REFTIMES_PER_MS;
+    INFO_LOG(AUDIO, "Audio period set to %lld", static_cast<long long>(device_period));
+
     result = m_audio_client->Initialize(
         AUDCLNT_SHAREMODE_EXCLUSIVE,
         AUDCLNT_STREAMFLAGS_EVENTCALLBACK | AUDCLNT_STREAMFLAGS_NOPERSIST, device_period,
@@ -329,7 +337,7 @@ bool WASAPIStream::SetRunning(bool running)
       device_period =
           static_cast<REFERENCE_TIME>(
               10000.0 * 1000 * m_frames_in_buffer / m_format.Format.nSamplesPerSec + 0.5) +
-          SConfig::GetInstance().iLatency * 10000;
+          SConfig::GetInstance().iLatency * REFTIMES_PER_MS;
 
       result = m_audio_client->Initialize(
           AUDCLNT_SHAREMODE_EXCLUSIVE,
@@ -388,7 +396,6 @@ bool WASAPIStream::SetRunning(bool running)
 
     m_running = true;
     m_thread = std::thread([this] { SoundLoop(); });
-    m_thread.detach();
   }
   else
   {
@@ -397,10 +404,6 @@ bool WASAPIStream::SetRunning(bool running)
     if (m_thread.joinable())
       m_thread.join();
 
-    while (!m_stopped)
-    {
-    }
-
     if (m_audio_client)
     {
       m_audio_renderer->Release();
@@ -419,22 +422,31 @@ void WASAPIStream::SoundLoop()
   Common::SetCurrentThreadName("WASAPI Handler");
   BYTE* data;
 
+  // With exclusive mode's small buffers, a late wakeup is an audible glitch, so let the
+  // multimedia class scheduler prioritize this thread.
+  DWORD task_index = 0;
+  HANDLE mmcss_handle = AvSetMmThreadCharacteristicsW(L"Pro Audio", &task_index);
+  if (!mmcss_handle)
+    WARN_LOG(AUDIO, "WASAPI: Failed to register the audio thread with MMCSS");
+
   if (m_audio_renderer)
   {
     m_audio_renderer->GetBuffer(m_frames_in_buffer, &data);
     m_audio_renderer->ReleaseBuffer(m_frames_in_buffer, AUDCLNT_BUFFERFLAGS_SILENT);
   }
 
-  m_stopped = false;
-
   while (m_running)
   {
     if (!m_audio_renderer)
+      break;
+
+    // The device asks for exactly one buffer per event, which is mixed straight into it.
+    if (WaitForSingleObject(m_need_data_event, 1000) != WAIT_OBJECT_0)
       continue;
 
-    WaitForSingleObject(m_need_data_event, 1000);
+    if (FAILED(m_audio_renderer->GetBuffer(m_frames_in_buffer, &data)))
+      continue;
 
-    m_audio_renderer->GetBuffer(m_frames_in_buffer, &data);
     GetMixer()->Mix(reinterpret_cast<s16*>(data), m_frames_in_buffer);
 
     float volume = SConfig::GetInstance().m_IsMuted ? 0 : SConfig::GetInstance().m_Volume / 100.;
@@ -445,7 +457,8 @@ void WASAPIStream::SoundLoop()
     m_audio_renderer->ReleaseBuffer(m_frames_in_buffer, 0);
   }
 
-  m_stopped = true;
+  if (mmcss_handle)
+    AvRevertMmThreadCharacteristics(mmcss_handle);
 }
 
 #endif  // _WIN32
@@ -40,7 +40,6 @@ public:
 private:
   u32 m_frames_in_buffer = 0;
   std::atomic<bool> m_running = false;
-  std::atomic<bool> m_stopped = false;
   std::thread m_thread;
 
   IAudioClient* m_audio_client = nullptr;
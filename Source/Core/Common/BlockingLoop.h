@@ -4,7 +4,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <mutex>
 #include <thread>
 
@@ -164,6 +166,13 @@ public:
         // loop.
         if (m_may_sleep.TestAndClear())
         {
+          // New work often shows up right after we're done, so spin a little before sleeping.
+          if (SpinForWakeup())
+          {
+            m_may_sleep.Set();
+            break;
+          }
+
           // Try to set the sleeping state.
           if (m_running_state-- != STATE_DONE)
             break;
@@ -232,6 +241,29 @@ public:
   void AllowSleep() { m_may_sleep.Set(); }
 
 private:
+  // Waits a short while for a Wakeup() call without leaving the STATE_DONE state, so neither
+  // thread has to go through the OS to sleep and wake up. The spin time doubles each time this
+  // catches a wakeup and halves each time it doesn't, so idle loops quickly go back to sleeping.
+  bool SpinForWakeup()
+  {
+    const auto end = std::chrono::steady_clock::now() + std::chrono::microseconds(m_spin_time_us);
+    while (std::chrono::steady_clock::now() < end)
+    {
+      if (m_running_state.load() != STATE_DONE)
+      {
+        m_spin_time_us = std::min(m_spin_time_us * 2, MAX_SPIN_TIME_US);
+        return true;
+      }
+      std::this_thread::yield();
+    }
+
+    m_spin_time_us = std::max(m_spin_time_us / 2, MIN_SPIN_TIME_US);
+    return false;
+  }
+
+  static constexpr int MIN_SPIN_TIME_US = 2;
+  static constexpr int MAX_SPIN_TIME_US = 200;
+
   std::mutex m_wait_lock;
   std::mutex m_prepare_lock;
 
@@ -252,5 +284,7 @@ private:
 
   Flag m_may_sleep;  // If this is set, we fall back from the busy loop to an event based
                      // synchronization.
+
+  int m_spin_time_us = MIN_SPIN_TIME_US;  // Only used by the worker thread.
 };
 }  // namespace Common
@@ -59,6 +59,12 @@ public:
   PointerWrap(u8** ptr_, Mode mode_) : ptr(ptr_), mode(mode_) {}
   void SetMode(Mode mode_) { mode = mode_; }
   Mode GetMode() const { return mode; }
+
+  // Lets a state be written into a buffer that may be too small for it, such as one sized from an
+  // earlier save. Nothing is written past the end: from the first value that doesn't fit, the
+  // mode switches to MODE_MEASURE, so ptr still ends up where the end of the state would be.
+  void SetWriteEnd(u8* end) { write_end = end; }
+  bool WriteOverflowed() const { return write_overflowed; }
   template <typename K, class V>
   void Do(std::map<K, V>& x)
   {
@@ -300,6 +306,9 @@ public:
   }
 
 private:
+  u8* write_end = nullptr;
+  bool write_overflowed = false;
+
   template <typename T>
   void DoContiguousContainer(T& container)
   {
@@ -326,6 +335,12 @@ private:
       break;
 
     case MODE_WRITE:
+      if (write_end && size > static_cast<size_t>(write_end - *ptr))
+      {
+        mode = MODE_MEASURE;
+        write_overflowed = true;
+        break;
+      }
       memcpy(*ptr, data, size);
       break;
 
@@ -3,8 +3,11 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <atomic>
+#include <iterator>
 #include <list>
 #include <map>
+#include <mutex>
 #include <shared_mutex>
 
 #include "Common/Config/Config.h"
@@ -19,6 +22,8 @@ static u32 s_callback_guards = 0;
 
 static std::shared_mutex s_layers_rw_lock;
 
+static std::atomic<u64> s_config_version{1};
+
 using ReadLock = std::shared_lock<std::shared_mutex>;
 using WriteLock = std::unique_lock<std::shared_mutex>;
 
@@ -29,6 +34,7 @@ static void AddLayerInternal(std::shared_ptr<Layer> layer)
 
     const Config::LayerType layer_type = layer->GetLayer();
     s_layers.insert_or_assign(layer_type, std::move(layer));
+    detail::OnLayerChanged();
   }
   InvokeConfigChangedCallbacks();
 }
@@ -38,6 +44,42 @@ void AddLayer(std::unique_ptr<ConfigLayerLoader> loader)
   AddLayerInternal(std::make_shared<Layer>(std::move(loader)));
 }
 
+static bool HasSameValues(const Layer& a, const Layer& b)
+{
+  // Deleted keys are kept in the map without a value, so skip over those on both sides
+  const auto has_value = [](const auto& entry) { return entry.second.has_value(); };
+  const LayerMap& a_map = a.GetLayerMap();
+  const LayerMap& b_map = b.GetLayerMap();
+
+  auto a_it = std::find_if(a_map.begin(), a_map.end(), has_value);
+  auto b_it = std::find_if(b_map.begin(), b_map.end(), has_value);
+  while (a_it != a_map.end() && b_it != b_map.end())
+  {
+    if (*a_it != *b_it)
+      return false;
+    a_it = std::find_if(std::next(a_it), a_map.end(), has_value);
+    b_it = std::find_if(std::next(b_it), b_map.end(), has_value);
+  }
+  return a_it == a_map.end() && b_it == b_map.end();
+}
+
+bool UpdateLayer(std::unique_ptr<ConfigLayerLoader> loader)
+{
+  auto layer = std::make_shared<Layer>(std::move(loader));
+  {
+    WriteLock lock(s_layers_rw_lock);
+
+    const Config::LayerType layer_type = layer->GetLayer();
+    const auto it = s_layers.find(layer_type);
+    if (it != s_layers.end() && HasSameValues(*it->second, *layer))
+      return false;
+    s_layers.insert_or_assign(layer_type, std::move(layer));
+    detail::OnLayerChanged();
+  }
+  InvokeConfigChangedCallbacks();
+  return true;
+}
+
 std::shared_ptr<Layer> GetLayer(LayerType layer)
 {
   ReadLock lock(s_layers_rw_lock);
@@ -57,6 +99,7 @@ void RemoveLayer(LayerType layer)
     WriteLock lock(s_layers_rw_lock);
 
     s_layers.erase(layer);
+    detail::OnLayerChanged();
   }
   InvokeConfigChangedCallbacks();
 }
@@ -110,6 +153,7 @@ void Shutdown()
 
   s_layers.clear();
   s_callbacks.clear();
+  detail::OnLayerChanged();
 }
 
 void ClearCurrentRunLayer()
@@ -117,12 +161,14 @@ void ClearCurrentRunLayer()
   WriteLock lock(s_layers_rw_lock);
 
   s_layers.insert_or_assign(LayerType::CurrentRun, std::make_shared<Layer>(LayerType::CurrentRun));
+  detail::OnLayerChanged();
 }
 
   //Narrysmod - Add this 
 void ClearCurrentVanguardLayer()
 {
   s_layers[LayerType::Vanguard] = std::make_unique<Layer>(LayerType::Vanguard);
+  detail::OnLayerChanged();
 }
 
 static const std::map<System, std::string> system_to_name = {
@@ -167,6 +213,16 @@ const std::string& GetLayerName(LayerType layer)
   return layer_to_name.at(layer);
 }
 
+u64 GetConfigVersion()
+{
+  return s_config_version.load();
+}
+
+void detail::OnLayerChanged()
+{
+  ++s_config_version;
+}
+
 LayerType GetActiveLayerForConfig(const Location& config)
 {
   ReadLock lock(s_layers_rw_lock);
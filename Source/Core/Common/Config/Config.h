@@ -20,6 +20,9 @@ using ConfigChangedCallback = std::function<void()>;
 
 // Layer management
 void AddLayer(std::unique_ptr<ConfigLayerLoader> loader);
+// Same as AddLayer, but does nothing (and doesn't notify anyone) when the layer that would be
+// replaced already holds exactly the same values. Returns whether the layer was replaced.
+bool UpdateLayer(std::unique_ptr<ConfigLayerLoader> loader);
 std::shared_ptr<Layer> GetLayer(LayerType layer);
 void RemoveLayer(LayerType layer);
 
@@ -42,18 +45,35 @@ std::optional<System> GetSystemFromName(const std::string& system);
 const std::string& GetLayerName(LayerType layer);
 LayerType GetActiveLayerForConfig(const Location&);
 
+// Changes whenever any layer is added, removed or changed. Settings are read from the layers once
+// per version and then come from their cache, so Get is cheap enough to call on hot paths.
+u64 GetConfigVersion();
+
 template <typename T>
-T Get(LayerType layer, const Info<T>& info)
+T GetUncached(const Info<T>& info)
 {
-  if (layer == LayerType::Meta)
-    return Get(info);
-  return GetLayer(layer)->Get(info);
+  return GetLayer(GetActiveLayerForConfig(info.location))->Get(info);
 }
 
 template <typename T>
 T Get(const Info<T>& info)
 {
-  return GetLayer(GetActiveLayerForConfig(info.location))->Get(info);
+  // Read the version first, so that a change made while the layers are read invalidates the value
+  const u64 config_version = GetConfigVersion();
+  if (const std::optional<T> cached = info.cached_value.Get(config_version))
+    return *cached;
+
+  const T value = GetUncached(info);
+  info.cached_value.Set(config_version, value);
+  return value;
+}
+
+template <typename T>
+T Get(LayerType layer, const Info<T>& info)
+{
+  if (layer == LayerType::Meta)
+    return Get(info);
+  return GetLayer(layer)->Get(info);
 }
 
 template <typename T>
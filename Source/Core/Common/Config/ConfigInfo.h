@@ -4,9 +4,13 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstring>
+#include <optional>
 #include <string>
 #include <type_traits>
 
+#include "Common/CommonTypes.h"
 #include "Common/Config/Enums.h"
 
 namespace Config
@@ -16,6 +20,51 @@ namespace detail
 // std::underlying_type may only be used with enum types, so make sure T is an enum type first.
 template <typename T>
 using UnderlyingType = typename std::enable_if_t<std::is_enum<T>{}, std::underlying_type<T>>::type;
+
+template <typename T>
+constexpr bool IsCacheable = std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(u32);
+
+// The value of a setting as of a config version. The value and the low bits of the version are
+// packed into one atomic, so reading a cached value takes no lock. Only settings of up to 32 bits
+// are cached, which covers the booleans, numbers and enums that get read on hot paths.
+template <typename T>
+class CachedValue
+{
+public:
+  std::optional<T> Get(u64 config_version) const
+  {
+    if constexpr (IsCacheable<T>)
+    {
+      const u64 packed = m_packed.load(std::memory_order_relaxed);
+      if (static_cast<u32>(packed >> 32) != static_cast<u32>(config_version))
+        return std::nullopt;
+
+      const u32 bits = static_cast<u32>(packed);
+      T value;
+      std::memcpy(&value, &bits, sizeof(T));
+      return value;
+    }
+    else
+    {
+      return std::nullopt;
+    }
+  }
+
+  void Set(u64 config_version, const T& value) const
+  {
+    if constexpr (IsCacheable<T>)
+    {
+      u32 bits = 0;
+      std::memcpy(&bits, &value, sizeof(T));
+      m_packed.store(u64{static_cast<u32>(config_version)} << 32 | bits,
+                     std::memory_order_relaxed);
+    }
+  }
+
+private:
+  // Config versions start at 1, so version 0 means nothing is cached yet
+  mutable std::atomic<u64> m_packed{0};
+};
 }  // namespace detail
 
 struct Location
@@ -37,6 +86,16 @@ struct Info
   {
   }
 
+  // The cached value isn't copied, it is simply read again by the copy
+  Info(const Info& other) : location{other.location}, default_value{other.default_value} {}
+  Info& operator=(const Info& other)
+  {
+    location = other.location;
+    default_value = other.default_value;
+    cached_value.Set(0, default_value);
+    return *this;
+  }
+
   // Make it easy to convert Info<Enum> into Info<UnderlyingType<Enum>>
   // so that enum settings can still easily work with code that doesn't care about the enum values.
   template <typename Enum,
@@ -49,5 +108,8 @@ struct Info
 
   Location location;
   T default_value;
+
+  // Filled in by Config::Get
+  detail::CachedValue<T> cached_value;
 };
 }  // namespace Config
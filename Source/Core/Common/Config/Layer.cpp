@@ -52,6 +52,7 @@ bool Layer::DeleteKey(const Location& location)
   {
     iter->second.reset();
     had_value = true;
+    detail::OnLayerChanged();
   }
 
   return had_value;
@@ -64,6 +65,7 @@ void Layer::DeleteAllKeys()
   {
     pair.second.reset();
   }
+  detail::OnLayerChanged();
 }
 
 Section Layer::GetSection(System system, const std::string& section)
@@ -83,6 +85,7 @@ void Layer::Load()
   if (m_loader)
     m_loader->Load(this);
   m_is_dirty = false;
+  detail::OnLayerChanged();
 }
 
 void Layer::Save()
@@ -48,6 +48,13 @@ template <typename T>
 struct Info;
 
 class Layer;
+
+namespace detail
+{
+// Invalidates the cached values of all settings. Called whenever a layer's values change.
+void OnLayerChanged();
+}  // namespace detail
+
 using LayerMap = std::map<Location, std::optional<std::string>>;
 
 class ConfigLayerLoader
@@ -136,6 +143,7 @@ public:
       return;
     m_is_dirty = true;
     m_map.insert_or_assign(location, std::move(new_value));
+    detail::OnLayerChanged();
   }
 
   Section GetSection(System system, const std::string& section);
@@ -2,9 +2,15 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include "Common/Crypto/AES.h"
+
+#include <cstring>
+
 #include <mbedtls/aes.h>
 
-#include "Common/Crypto/AES.h"
+#include "Common/Assert.h"
+#include "Common/CPUDetect.h"
+#include "Common/Intrinsics.h"
 
 namespace Common::AES
 {
@@ -33,4 +39,252 @@ std::vector<u8> Encrypt(const u8* key, u8* iv, const u8* src, size_t size)
 {
   return DecryptEncrypt(key, iv, src, size, Mode::Encrypt);
 }
+
+#ifdef _M_X86
+FUNCTION_TARGET_AES
+static void EncryptCBCAESNI(const std::array<u8, 16>* round_keys, u8* iv, const u8* src, u8* dst,
+                            size_t size)
+{
+  __m128i keys[11];
+  for (size_t i = 0; i < 11; i++)
+    keys[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(round_keys[i].data()));
+
+  __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(iv));
+  for (size_t offset = 0; offset < size; offset += 16)
+  {
+    block = _mm_xor_si128(block, _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + offset)));
+    block = _mm_xor_si128(block, keys[0]);
+    for (size_t i = 1; i < 10; i++)
+      block = _mm_aesenc_si128(block, keys[i]);
+    block = _mm_aesenclast_si128(block, keys[10]);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + offset), block);
+  }
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(iv), block);
+}
+#elif defined(_M_ARM_64)
+FUNCTION_TARGET_ARM_CRYPTO
+static void EncryptCBCARM(const std::array<u8, 16>* round_keys, u8* iv, const u8* src, u8* dst,
+                          size_t size)
+{
+  uint8x16_t keys[11];
+  for (size_t i = 0; i < 11; i++)
+    keys[i] = vld1q_u8(round_keys[i].data());
+
+  // AESE adds the round key before the S-box instead of after MixColumns, which puts the last
+  // round key in a plain XOR.
+  uint8x16_t block = vld1q_u8(iv);
+  for (size_t offset = 0; offset < size; offset += 16)
+  {
+    block = veorq_u8(block, vld1q_u8(src + offset));
+    for (size_t i = 0; i < 9; i++)
+      block = vaesmcq_u8(vaeseq_u8(block, keys[i]));
+    block = veorq_u8(vaeseq_u8(block, keys[9]), keys[10]);
+    vst1q_u8(dst + offset, block);
+  }
+  vst1q_u8(iv, block);
+}
+#endif
+
+// Decrypting four blocks at once hides the latency of the AES instructions
+constexpr size_t PARALLEL_BLOCKS = 4;
+
+#ifdef _M_X86
+FUNCTION_TARGET_AES
+static void InvertRoundKeysAESNI(const std::array<u8, 16>* enc_keys, std::array<u8, 16>* dec_keys)
+{
+  std::memcpy(dec_keys[0].data(), enc_keys[10].data(), 16);
+  for (size_t i = 1; i < 10; i++)
+  {
+    const __m128i key = _mm_loadu_si128(reinterpret_cast<const __m128i*>(enc_keys[10 - i].data()));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dec_keys[i].data()), _mm_aesimc_si128(key));
+  }
+  std::memcpy(dec_keys[10].data(), enc_keys[0].data(), 16);
+}
+
+FUNCTION_TARGET_AES
+static void DecryptCBCAESNI(const std::array<u8, 16>* round_keys, u8* iv, const u8* src, u8* dst,
+                            size_t size)
+{
+  __m128i keys[11];
+  for (size_t i = 0; i < 11; i++)
+    keys[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(round_keys[i].data()));
+
+  __m128i prev = _mm_loadu_si128(reinterpret_cast<const __m128i*>(iv));
+  size_t offset = 0;
+  for (; offset + PARALLEL_BLOCKS * 16 <= size; offset += PARALLEL_BLOCKS * 16)
+  {
+    __m128i in[PARALLEL_BLOCKS];
+    __m128i blocks[PARALLEL_BLOCKS];
+    for (size_t j = 0; j < PARALLEL_BLOCKS; j++)
+    {
+      in[j] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + offset + j * 16));
+      blocks[j] = _mm_xor_si128(in[j], keys[0]);
+    }
+    for (size_t i = 1; i < 10; i++)
+    {
+      for (size_t j = 0; j < PARALLEL_BLOCKS; j++)
+        blocks[j] = _mm_aesdec_si128(blocks[j], keys[i]);
+    }
+    for (size_t j = 0; j < PARALLEL_BLOCKS; j++)
+    {
+      blocks[j] = _mm_xor_si128(_mm_aesdeclast_si128(blocks[j], keys[10]), prev);
+      prev = in[j];
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + offset + j * 16), blocks[j]);
+    }
+  }
+  for (; offset < size; offset += 16)
+  {
+    const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + offset));
+    __m128i block = _mm_xor_si128(in, keys[0]);
+    for (size_t i = 1; i < 10; i++)
+      block = _mm_aesdec_si128(block, keys[i]);
+    block = _mm_xor_si128(_mm_aesdeclast_si128(block, keys[10]), prev);
+    prev = in;
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + offset), block);
+  }
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(iv), prev);
+}
+#elif defined(_M_ARM_64)
+FUNCTION_TARGET_ARM_CRYPTO
+static void InvertRoundKeysARM(const std::array<u8, 16>* enc_keys, std::array<u8, 16>* dec_keys)
+{
+  std::memcpy(dec_keys[0].data(), enc_keys[10].data(), 16);
+  for (size_t i = 1; i < 10; i++)
+    vst1q_u8(dec_keys[i].data(), vaesimcq_u8(vld1q_u8(enc_keys[10 - i].data())));
+  std::memcpy(dec_keys[10].data(), enc_keys[0].data(), 16);
+}
+
+FUNCTION_TARGET_ARM_CRYPTO
+static void DecryptCBCARM(const std::array<u8, 16>* round_keys, u8* iv, const u8* src, u8* dst,
+                          size_t size)
+{
+  uint8x16_t keys[11];
+  for (size_t i = 0; i < 11; i++)
+    keys[i] = vld1q_u8(round_keys[i].data());
+
+  // Like for encryption, AESD adds the round key first, so the last one is a plain XOR
+  uint8x16_t prev = vld1q_u8(iv);
+  size_t offset = 0;
+  for (; offset + PARALLEL_BLOCKS * 16 <= size; offset += PARALLEL_BLOCKS * 16)
+  {
+    uint8x16_t in[PARALLEL_BLOCKS];
+    uint8x16_t blocks[PARALLEL_BLOCKS];
+    for (size_t j = 0; j < PARALLEL_BLOCKS; j++)
+      blocks[j] = in[j] = vld1q_u8(src + offset + j * 16);
+    for (size_t i = 0; i < 9; i++)
+    {
+      for (size_t j = 0; j < PARALLEL_BLOCKS; j++)
+        blocks[j] = vaesimcq_u8(vaesdq_u8(blocks[j], keys[i]));
+    }
+    for (size_t j = 0; j < PARALLEL_BLOCKS; j++)
+    {
+      blocks[j] = veorq_u8(veorq_u8(vaesdq_u8(blocks[j], keys[9]), keys[10]), prev);
+      prev = in[j];
+      vst1q_u8(dst + offset + j * 16, blocks[j]);
+    }
+  }
+  for (; offset < size; offset += 16)
+  {
+    const uint8x16_t in = vld1q_u8(src + offset);
+    uint8x16_t block = in;
+    for (size_t i = 0; i < 9; i++)
+      block = vaesimcq_u8(vaesdq_u8(block, keys[i]));
+    block = veorq_u8(veorq_u8(vaesdq_u8(block, keys[9]), keys[10]), prev);
+    prev = in;
+    vst1q_u8(dst + offset, block);
+  }
+  vst1q_u8(iv, prev);
+}
+#endif
+
+CBCEncryptor::CBCEncryptor(const u8* key)
+{
+  mbedtls_aes_init(&m_context);
+  mbedtls_aes_setkey_enc(&m_context, key, 128);
+
+  // Whether mbedtls expanded the key itself or with AES-NI, the round keys are stored in the
+  // order of the bytes of the key.
+  ASSERT(m_context.nr == NUM_ROUNDS);
+  std::memcpy(m_round_keys.data(), m_context.rk, sizeof(m_round_keys));
+
+  m_use_hardware = cpu_info.bAES;
+}
+
+CBCEncryptor::~CBCEncryptor()
+{
+  mbedtls_aes_free(&m_context);
+}
+
+void CBCEncryptor::Encrypt(u8* iv, const u8* src, u8* dst, size_t size) const
+{
+  DEBUG_ASSERT(size % 16 == 0);
+
+#ifdef _M_X86
+  if (m_use_hardware)
+  {
+    EncryptCBCAESNI(m_round_keys.data(), iv, src, dst, size);
+    return;
+  }
+#elif defined(_M_ARM_64)
+  if (m_use_hardware)
+  {
+    EncryptCBCARM(m_round_keys.data(), iv, src, dst, size);
+    return;
+  }
+#endif
+
+  mbedtls_aes_crypt_cbc(&m_context, MBEDTLS_AES_ENCRYPT, size, iv, src, dst);
+}
+
+CBCDecryptor::CBCDecryptor(const u8* key)
+{
+  mbedtls_aes_init(&m_context);
+  mbedtls_aes_setkey_dec(&m_context, key, 128);
+
+  m_use_hardware = cpu_info.bAES;
+  if (!m_use_hardware)
+    return;
+
+  // mbedtls's own decryption keys are laid out differently depending on whether it uses AES-NI, so
+  // they are derived from the encryption keys instead
+  mbedtls_aes_context enc_context;
+  mbedtls_aes_init(&enc_context);
+  mbedtls_aes_setkey_enc(&enc_context, key, 128);
+  ASSERT(enc_context.nr == NUM_ROUNDS);
+  std::array<std::array<u8, 16>, NUM_ROUNDS + 1> enc_keys;
+  std::memcpy(enc_keys.data(), enc_context.rk, sizeof(enc_keys));
+  mbedtls_aes_free(&enc_context);
+
+#ifdef _M_X86
+  InvertRoundKeysAESNI(enc_keys.data(), m_round_keys.data());
+#elif defined(_M_ARM_64)
+  InvertRoundKeysARM(enc_keys.data(), m_round_keys.data());
+#endif
+}
+
+CBCDecryptor::~CBCDecryptor()
+{
+  mbedtls_aes_free(&m_context);
+}
+
+void CBCDecryptor::Decrypt(u8* iv, const u8* src, u8* dst, size_t size) const
+{
+  DEBUG_ASSERT(size % 16 == 0);
+
+#ifdef _M_X86
+  if (m_use_hardware)
+  {
+    DecryptCBCAESNI(m_round_keys.data(), iv, src, dst, size);
+    return;
+  }
+#elif defined(_M_ARM_64)
+  if (m_use_hardware)
+  {
+    DecryptCBCARM(m_round_keys.data(), iv, src, dst, size);
+    return;
+  }
+#endif
+
+  mbedtls_aes_crypt_cbc(&m_context, MBEDTLS_AES_DECRYPT, size, iv, src, dst);
+}
 }  // namespace Common::AES
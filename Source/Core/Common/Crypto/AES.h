@@ -4,9 +4,12 @@
 
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <vector>
 
+#include <mbedtls/aes.h>
+
 #include "Common/CommonTypes.h"
 
 namespace Common::AES
@@ -21,4 +24,56 @@ std::vector<u8> DecryptEncrypt(const u8* key, u8* iv, const u8* src, size_t size
 // Convenience functions
 std::vector<u8> Decrypt(const u8* key, u8* iv, const u8* src, size_t size);
 std::vector<u8> Encrypt(const u8* key, u8* iv, const u8* src, size_t size);
+
+// AES-128-CBC encryption with a key that is expanded once. Uses AES-NI or the ARMv8 crypto
+// extension when the CPU has them, and mbedtls otherwise. Encrypt can be called from several
+// threads at once.
+class CBCEncryptor
+{
+public:
+  explicit CBCEncryptor(const u8* key);
+  ~CBCEncryptor();
+
+  CBCEncryptor(const CBCEncryptor&) = delete;
+  CBCEncryptor& operator=(const CBCEncryptor&) = delete;
+
+  // size must be a multiple of 16. Like mbedtls_aes_crypt_cbc, iv is updated to the last block
+  // of the output, so that one call can continue where the previous one ended.
+  void Encrypt(u8* iv, const u8* src, u8* dst, size_t size) const;
+
+private:
+  static constexpr size_t NUM_ROUNDS = 10;
+
+  // mbedtls only reads the context while encrypting.
+  mutable mbedtls_aes_context m_context;
+  std::array<std::array<u8, 16>, NUM_ROUNDS + 1> m_round_keys;
+  bool m_use_hardware = false;
+};
+
+// AES-128-CBC decryption with a key that is expanded once. Unlike encryption, the blocks of CBC
+// decryption don't depend on each other, so the hardware paths decrypt several at a time. Decrypt
+// can be called from several threads at once.
+class CBCDecryptor
+{
+public:
+  explicit CBCDecryptor(const u8* key);
+  ~CBCDecryptor();
+
+  CBCDecryptor(const CBCDecryptor&) = delete;
+  CBCDecryptor& operator=(const CBCDecryptor&) = delete;
+
+  // size must be a multiple of 16, and src and dst may be the same. Like mbedtls_aes_crypt_cbc,
+  // iv is updated to the last block of the input, so that one call can continue where the
+  // previous one ended.
+  void Decrypt(u8* iv, const u8* src, u8* dst, size_t size) const;
+
+private:
+  static constexpr size_t NUM_ROUNDS = 10;
+
+  // mbedtls only reads the context while decrypting.
+  mutable mbedtls_aes_context m_context;
+  // The round keys of the equivalent inverse cipher, only set up for the hardware paths
+  std::array<std::array<u8, 16>, NUM_ROUNDS + 1> m_round_keys;
+  bool m_use_hardware = false;
+};
 }  // namespace Common::AES
@@ -0,0 +1,273 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Common/Crypto/SHA1.h"
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+
+#include <mbedtls/sha1.h>
+
+#include "Common/CPUDetect.h"
+#include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
+#include "Common/Swap.h"
+
+namespace Common::SHA1
+{
+namespace
+{
+constexpr size_t BLOCK_SIZE = 64;
+
+// Processes num_blocks whole blocks of data in the five words of state.
+using ProcessBlocksFunction = void (*)(u32* state, const u8* data, size_t num_blocks);
+
+#ifdef _M_X86
+
+FUNCTION_TARGET_SHA
+inline __m128i LoadW(const u8* data, __m128i byte_swap)
+{
+  return _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), byte_swap);
+}
+
+// Returns the next four words of the message schedule from the previous sixteen.
+FUNCTION_TARGET_SHA
+inline __m128i NextW(__m128i w0, __m128i w1, __m128i w2, __m128i w3)
+{
+  return _mm_sha1msg2_epu32(_mm_xor_si128(_mm_sha1msg1_epu32(w0, w1), w2), w3);
+}
+
+// Four rounds. Except before the first step, e holds ABCD from before the previous step, which
+// SHA1NEXTE turns into E for this one.
+template <int Function>
+FUNCTION_TARGET_SHA inline void Step(__m128i* abcd, __m128i* e, __m128i w)
+{
+  const __m128i e_w = _mm_sha1nexte_epu32(*e, w);
+  *e = *abcd;
+  *abcd = _mm_sha1rnds4_epu32(*abcd, e_w, Function);
+}
+
+FUNCTION_TARGET_SHA
+void ProcessBlocksSHA(u32* state, const u8* data, size_t num_blocks)
+{
+  // The words are big endian, and the SHA instructions want A in the highest lane.
+  const __m128i byte_swap = _mm_set_epi64x(0x0001020304050607, 0x08090a0b0c0d0e0f);
+
+  __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0x1B);
+  __m128i e = _mm_set_epi32(static_cast<int>(state[4]), 0, 0, 0);
+
+  for (; num_blocks > 0; num_blocks--, data += BLOCK_SIZE)
+  {
+    const __m128i abcd_save = abcd;
+    const __m128i e_save = e;
+
+    __m128i w0 = LoadW(data, byte_swap);
+    __m128i w1 = LoadW(data + 16, byte_swap);
+    __m128i w2 = LoadW(data + 32, byte_swap);
+    __m128i w3 = LoadW(data + 48, byte_swap);
+
+    const __m128i e_w0 = _mm_add_epi32(e, w0);
+    e = abcd;
+    abcd = _mm_sha1rnds4_epu32(abcd, e_w0, 0);
+    Step<0>(&abcd, &e, w1);
+    Step<0>(&abcd, &e, w2);
+    Step<0>(&abcd, &e, w3);
+    w0 = NextW(w0, w1, w2, w3);
+    Step<0>(&abcd, &e, w0);
+    w1 = NextW(w1, w2, w3, w0);
+    Step<1>(&abcd, &e, w1);
+    w2 = NextW(w2, w3, w0, w1);
+    Step<1>(&abcd, &e, w2);
+    w3 = NextW(w3, w0, w1, w2);
+    Step<1>(&abcd, &e, w3);
+    w0 = NextW(w0, w1, w2, w3);
+    Step<1>(&abcd, &e, w0);
+    w1 = NextW(w1, w2, w3, w0);
+    Step<1>(&abcd, &e, w1);
+    w2 = NextW(w2, w3, w0, w1);
+    Step<2>(&abcd, &e, w2);
+    w3 = NextW(w3, w0, w1, w2);
+    Step<2>(&abcd, &e, w3);
+    w0 = NextW(w0, w1, w2, w3);
+    Step<2>(&abcd, &e, w0);
+    w1 = NextW(w1, w2, w3, w0);
+    Step<2>(&abcd, &e, w1);
+    w2 = NextW(w2, w3, w0, w1);
+    Step<2>(&abcd, &e, w2);
+    w3 = NextW(w3, w0, w1, w2);
+    Step<3>(&abcd, &e, w3);
+    w0 = NextW(w0, w1, w2, w3);
+    Step<3>(&abcd, &e, w0);
+    w1 = NextW(w1, w2, w3, w0);
+    Step<3>(&abcd, &e, w1);
+    w2 = NextW(w2, w3, w0, w1);
+    Step<3>(&abcd, &e, w2);
+    w3 = NextW(w3, w0, w1, w2);
+    Step<3>(&abcd, &e, w3);
+
+    e = _mm_sha1nexte_epu32(e, e_save);
+    abcd = _mm_add_epi32(abcd, abcd_save);
+  }
+
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_shuffle_epi32(abcd, 0x1B));
+  state[4] = static_cast<u32>(_mm_extract_epi32(e, 3));
+}
+
+#elif defined(_M_ARM_64)
+
+// Returns the next four words of the message schedule from the previous sixteen.
+FUNCTION_TARGET_ARM_CRYPTO
+inline uint32x4_t NextW(uint32x4_t w0, uint32x4_t w1, uint32x4_t w2, uint32x4_t w3)
+{
+  return vsha1su1q_u32(vsha1su0q_u32(w0, w1, w2), w3);
+}
+
+// Four rounds each, with the round constant already added to the words.
+FUNCTION_TARGET_ARM_CRYPTO
+inline void StepChoose(uint32x4_t* abcd, u32* e, uint32x4_t w_k)
+{
+  const u32 next_e = vsha1h_u32(vgetq_lane_u32(*abcd, 0));
+  *abcd = vsha1cq_u32(*abcd, *e, w_k);
+  *e = next_e;
+}
+
+FUNCTION_TARGET_ARM_CRYPTO
+inline void StepParity(uint32x4_t* abcd, u32* e, uint32x4_t w_k)
+{
+  const u32 next_e = vsha1h_u32(vgetq_lane_u32(*abcd, 0));
+  *abcd = vsha1pq_u32(*abcd, *e, w_k);
+  *e = next_e;
+}
+
+FUNCTION_TARGET_ARM_CRYPTO
+inline void StepMajority(uint32x4_t* abcd, u32* e, uint32x4_t w_k)
+{
+  const u32 next_e = vsha1h_u32(vgetq_lane_u32(*abcd, 0));
+  *abcd = vsha1mq_u32(*abcd, *e, w_k);
+  *e = next_e;
+}
+
+FUNCTION_TARGET_ARM_CRYPTO
+void ProcessBlocksARM(u32* state, const u8* data, size_t num_blocks)
+{
+  const uint32x4_t k0 = vdupq_n_u32(0x5A827999);
+  const uint32x4_t k1 = vdupq_n_u32(0x6ED9EBA1);
+  const uint32x4_t k2 = vdupq_n_u32(0x8F1BBCDC);
+  const uint32x4_t k3 = vdupq_n_u32(0xCA62C1D6);
+
+  uint32x4_t abcd = vld1q_u32(state);
+  u32 e = state[4];
+
+  for (; num_blocks > 0; num_blocks--, data += BLOCK_SIZE)
+  {
+    const uint32x4_t abcd_save = abcd;
+    const u32 e_save = e;
+
+    // The words are big endian.
+    uint32x4_t w0 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data)));
+    uint32x4_t w1 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 16)));
+    uint32x4_t w2 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 32)));
+    uint32x4_t w3 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 48)));
+
+    StepChoose(&abcd, &e, vaddq_u32(w0, k0));
+    StepChoose(&abcd, &e, vaddq_u32(w1, k0));
+    StepChoose(&abcd, &e, vaddq_u32(w2, k0));
+    StepChoose(&abcd, &e, vaddq_u32(w3, k0));
+    w0 = NextW(w0, w1, w2, w3);
+    StepChoose(&abcd, &e, vaddq_u32(w0, k0));
+    w1 = NextW(w1, w2, w3, w0);
+    StepParity(&abcd, &e, vaddq_u32(w1, k1));
+    w2 = NextW(w2, w3, w0, w1);
+    StepParity(&abcd, &e, vaddq_u32(w2, k1));
+    w3 = NextW(w3, w0, w1, w2);
+    StepParity(&abcd, &e, vaddq_u32(w3, k1));
+    w0 = NextW(w0, w1, w2, w3);
+    StepParity(&abcd, &e, vaddq_u32(w0, k1));
+    w1 = NextW(w1, w2, w3, w0);
+    StepParity(&abcd, &e, vaddq_u32(w1, k1));
+    w2 = NextW(w2, w3, w0, w1);
+    StepMajority(&abcd, &e, vaddq_u32(w2, k2));
+    w3 = NextW(w3, w0, w1, w2);
+    StepMajority(&abcd, &e, vaddq_u32(w3, k2));
+    w0 = NextW(w0, w1, w2, w3);
+    StepMajority(&abcd, &e, vaddq_u32(w0, k2));
+    w1 = NextW(w1, w2, w3, w0);
+    StepMajority(&abcd, &e, vaddq_u32(w1, k2));
+    w2 = NextW(w2, w3, w0, w1);
+    StepMajority(&abcd, &e, vaddq_u32(w2, k2));
+    w3 = NextW(w3, w0, w1, w2);
+    StepParity(&abcd, &e, vaddq_u32(w3, k3));
+    w0 = NextW(w0, w1, w2, w3);
+    StepParity(&abcd, &e, vaddq_u32(w0, k3));
+    w1 = NextW(w1, w2, w3, w0);
+    StepParity(&abcd, &e, vaddq_u32(w1, k3));
+    w2 = NextW(w2, w3, w0, w1);
+    StepParity(&abcd, &e, vaddq_u32(w2, k3));
+    w3 = NextW(w3, w0, w1, w2);
+    StepParity(&abcd, &e, vaddq_u32(w3, k3));
+
+    abcd = vaddq_u32(abcd, abcd_save);
+    e += e_save;
+  }
+
+  vst1q_u32(state, abcd);
+  state[4] = e;
+}
+
+#endif
+
+ProcessBlocksFunction GetProcessBlocksFunction()
+{
+#ifdef _M_X86
+  if (cpu_info.bSHA1 && cpu_info.bSSE4_1)
+    return ProcessBlocksSHA;
+#elif defined(_M_ARM_64)
+  if (cpu_info.bSHA1)
+    return ProcessBlocksARM;
+#endif
+  return nullptr;
+}
+}  // Anonymous namespace
+
+void CalculateDigest(const u8* data, size_t size, u8* digest)
+{
+  static const ProcessBlocksFunction process_blocks = GetProcessBlocksFunction();
+  if (!process_blocks)
+  {
+    mbedtls_sha1_ret(data, size, digest);
+    return;
+  }
+
+  std::array<u32, 5> state{0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+
+  const size_t whole_blocks = size / BLOCK_SIZE;
+  process_blocks(state.data(), data, whole_blocks);
+
+  // The padding is a 1 bit, zeroes, and the size in bits, which may need a second block.
+  std::array<u8, BLOCK_SIZE * 2> last_blocks{};
+  const size_t remaining = size % BLOCK_SIZE;
+  if (remaining != 0)
+    std::memcpy(last_blocks.data(), data + whole_blocks * BLOCK_SIZE, remaining);
+  last_blocks[remaining] = 0x80;
+  const size_t num_last_blocks = remaining + 1 + sizeof(u64) > BLOCK_SIZE ? 2 : 1;
+  const u64 size_in_bits = Common::swap64(static_cast<u64>(size) * 8);
+  std::memcpy(last_blocks.data() + num_last_blocks * BLOCK_SIZE - sizeof(u64), &size_in_bits,
+              sizeof(u64));
+  process_blocks(state.data(), last_blocks.data(), num_last_blocks);
+
+  for (size_t i = 0; i < state.size(); i++)
+  {
+    const u32 word = Common::swap32(state[i]);
+    std::memcpy(digest + i * sizeof(u32), &word, sizeof(u32));
+  }
+}
+
+Digest CalculateDigest(const u8* data, size_t size)
+{
+  Digest digest;
+  CalculateDigest(data, size, digest.data());
+  return digest;
+}
+}  // namespace Common::SHA1
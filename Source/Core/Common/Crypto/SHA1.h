@@ -0,0 +1,19 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "Common/CommonTypes.h"
+
+namespace Common::SHA1
+{
+using Digest = std::array<u8, 20>;
+
+// Uses the SHA instructions of the CPU when it has them, and mbedtls otherwise.
+void CalculateDigest(const u8* data, size_t size, u8* digest);
+Digest CalculateDigest(const u8* data, size_t size);
+}  // namespace Common::SHA1
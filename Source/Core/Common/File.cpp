@@ -8,10 +8,12 @@
 
 #ifdef _WIN32
 #include <io.h>
+#include <windows.h>
 
 #include "Common/CommonFuncs.h"
 #include "Common/StringUtil.h"
 #else
+#include <sys/file.h>
 #include <unistd.h>
 #endif
 
@@ -117,6 +119,35 @@ bool IOFile::Flush()
   return m_good;
 }
 
+bool IOFile::Lock(bool exclusive)
+{
+  if (!IsOpen())
+    return false;
+
+#ifdef _WIN32
+  OVERLAPPED overlapped = {};
+  const HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(m_file)));
+  return LockFileEx(handle, exclusive ? LOCKFILE_EXCLUSIVE_LOCK : 0, 0, MAXDWORD, MAXDWORD,
+                    &overlapped) != 0;
+#else
+  return flock(fileno(m_file), exclusive ? LOCK_EX : LOCK_SH) == 0;
+#endif
+}
+
+bool IOFile::Unlock()
+{
+  if (!IsOpen())
+    return false;
+
+#ifdef _WIN32
+  OVERLAPPED overlapped = {};
+  const HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(m_file)));
+  return UnlockFileEx(handle, 0, MAXDWORD, MAXDWORD, &overlapped) != 0;
+#else
+  return flock(fileno(m_file), LOCK_UN) == 0;
+#endif
+}
+
 bool IOFile::Resize(u64 size)
 {
 #ifdef _WIN32
@@ -80,6 +80,11 @@ public:
   bool Resize(u64 size);
   bool Flush();
 
+  // Advisory lock on the whole file, for processes that share it. Blocks until the lock is held.
+  // Other processes only see buffered writes once they are flushed, so flush before unlocking.
+  bool Lock(bool exclusive);
+  bool Unlock();
+
   // clear error state
   void Clear()
   {
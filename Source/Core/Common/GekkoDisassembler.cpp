@@ -34,12 +34,14 @@
 
 #include "Common/GekkoDisassembler.h"
 
+#include <algorithm>
 #include <array>
 #include <string>
 
 #include <fmt/format.h>
 
 #include "Common/CommonTypes.h"
+#include "Common/ThreadPool.h"
 
 namespace Common
 {
@@ -150,14 +152,14 @@ constexpr std::array<const char*, 32> regnames{
 };
 
 // Initialize static class variables.
-u32* GekkoDisassembler::m_instr = nullptr;
-u32* GekkoDisassembler::m_iaddr = nullptr;
-std::string GekkoDisassembler::m_opcode;
-std::string GekkoDisassembler::m_operands;
-unsigned char GekkoDisassembler::m_type = 0;
-unsigned char GekkoDisassembler::m_flags = PPCF_ILLEGAL;
-unsigned short GekkoDisassembler::m_sreg = 0;
-u32 GekkoDisassembler::m_displacement = 0;
+thread_local u32* GekkoDisassembler::m_instr = nullptr;
+thread_local u32* GekkoDisassembler::m_iaddr = nullptr;
+thread_local std::string GekkoDisassembler::m_opcode;
+thread_local std::string GekkoDisassembler::m_operands;
+thread_local unsigned char GekkoDisassembler::m_type = 0;
+thread_local unsigned char GekkoDisassembler::m_flags = PPCF_ILLEGAL;
+thread_local unsigned short GekkoDisassembler::m_sreg = 0;
+thread_local u32 GekkoDisassembler::m_displacement = 0;
 
 static u32 HelperRotateMask(int r, int mb, int me)
 {
@@ -2358,6 +2360,27 @@ std::string GekkoDisassembler::Disassemble(u32 opcode, u32 current_instruction_a
   return m_opcode.append("\t").append(m_operands);
 }
 
+std::vector<std::string> GekkoDisassembler::DisassembleRange(const u32* opcodes, size_t count,
+                                                             u32 start_address, bool big_endian)
+{
+  // Big enough that handing out a chunk costs far less than disassembling it
+  constexpr size_t CHUNK_SIZE = 4096;
+
+  std::vector<std::string> result(count);
+  const auto disassemble_chunk = [&](size_t chunk) {
+    const size_t end = std::min(count, (chunk + 1) * CHUNK_SIZE);
+    for (size_t i = chunk * CHUNK_SIZE; i < end; i++)
+      result[i] = Disassemble(opcodes[i], start_address + static_cast<u32>(i * 4), big_endian);
+  };
+
+  const size_t chunks = (count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+  if (chunks > 1)
+    ThreadPool::ParallelFor(chunks, disassemble_chunk);
+  else if (chunks == 1)
+    disassemble_chunk(0);
+  return result;
+}
+
 constexpr std::array<const char*, 32> gpr_names{
     " r0", " r1 (sp)", " r2 (rtoc)", " r3", " r4", " r5", " r6", " r7", " r8", " r9", "r10",
     "r11", "r12",      "r13",        "r14", "r15", "r16", "r17", "r18", "r19", "r20", "r21",
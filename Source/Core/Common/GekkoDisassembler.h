@@ -34,8 +34,10 @@
 
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 
@@ -46,6 +48,10 @@ class GekkoDisassembler final
 public:
   static std::string Disassemble(u32 opcode, u32 current_instruction_address,
                                  bool big_endian = true);
+  // Disassembles count consecutive instructions starting at start_address. Large ranges are
+  // split into chunks which are disassembled in parallel.
+  static std::vector<std::string> DisassembleRange(const u32* opcodes, size_t count,
+                                                   u32 start_address, bool big_endian = true);
   static const char* GetGPRName(u32 index);
   static const char* GetFPRName(u32 index);
 
@@ -109,13 +115,14 @@ private:
     PPCF_64 = (1 << 3),        // 64-bit only instruction
   };
 
-  static u32* m_instr;            // Pointer to instruction to disassemble
-  static u32* m_iaddr;            // Instruction.address., usually the same as instr
-  static std::string m_opcode;    // Buffer for opcode, min. 10 chars.
-  static std::string m_operands;  // Operand buffer, min. 24 chars.
-  static unsigned char m_type;    // Type of instruction, see below
-  static unsigned char m_flags;   // Additional flags
-  static unsigned short m_sreg;   // Register in load/store instructions
-  static u32 m_displacement;      // Branch- or load/store displacement
+  // Per thread, so that several threads can disassemble at once
+  static thread_local u32* m_instr;            // Pointer to instruction to disassemble
+  static thread_local u32* m_iaddr;            // Instruction.address., usually the same as instr
+  static thread_local std::string m_opcode;    // Buffer for opcode, min. 10 chars.
+  static thread_local std::string m_operands;  // Operand buffer, min. 24 chars.
+  static thread_local unsigned char m_type;    // Type of instruction, see below
+  static thread_local unsigned char m_flags;   // Additional flags
+  static thread_local unsigned short m_sreg;   // Register in load/store instructions
+  static thread_local u32 m_displacement;      // Branch- or load/store displacement
 };
 }  // namespace Common
@@ -40,6 +40,12 @@
 #ifndef __SSE3__
 #define FUNCTION_TARGET_SSE3 [[gnu::target("sse3")]]
 #endif
+#ifndef __SHA__
+#define FUNCTION_TARGET_SHA [[gnu::target("sha,sse4.1")]]
+#endif
+#ifndef __AES__
+#define FUNCTION_TARGET_AES [[gnu::target("aes")]]
+#endif
 
 #elif defined(_MSC_VER) || defined(__INTEL_COMPILER)
 
@@ -52,6 +58,27 @@
 
 #endif  // _M_X86
 
+#if defined(_M_ARM_64)
+
+/**
+ * The ARMv8 crypto extension is optional, so GCC and Clang also need it to be enabled per function
+ * unless the target architecture always has it.
+ */
+#ifdef _MSC_VER
+#include <arm64_neon.h>
+#else
+#include <arm_neon.h>
+#ifndef __ARM_FEATURE_CRYPTO
+#ifdef __clang__
+#define FUNCTION_TARGET_ARM_CRYPTO [[gnu::target("crypto")]]
+#else
+#define FUNCTION_TARGET_ARM_CRYPTO [[gnu::target("+crypto")]]
+#endif
+#endif
+#endif
+
+#endif  // _M_ARM_64
+
 /**
  * Define the FUNCTION_TARGET macros to nothing if they are not needed, or not on an X86 platform.
  * This way when a function is defined with FUNCTION_TARGET you don't need to define a second
@@ -70,3 +97,12 @@
 #ifndef FUNCTION_TARGET_SSE3
 #define FUNCTION_TARGET_SSE3
 #endif
+#ifndef FUNCTION_TARGET_SHA
+#define FUNCTION_TARGET_SHA
+#endif
+#ifndef FUNCTION_TARGET_AES
+#define FUNCTION_TARGET_AES
+#endif
+#ifndef FUNCTION_TARGET_ARM_CRYPTO
+#define FUNCTION_TARGET_ARM_CRYPTO
+#endif
@@ -4,6 +4,10 @@
 
 #pragma once
 
+#include <atomic>
+
+#include "Common/CommonTypes.h"
+
 namespace Common::Log
 {
 enum LOG_TYPE
@@ -72,6 +76,15 @@ enum LOG_LEVELS
 
 static const char LOG_LEVEL_TO_CHAR[7] = "-NEWID";
 
+// The most detailed level that gets logged for each type, or 0 if nothing does. The LogManager
+// keeps these up to date, so that the log macros skip disabled messages with a single compare.
+extern std::atomic<u8> g_log_levels[NUMBER_OF_LOGS];
+
+inline bool IsLogEnabled(LOG_TYPE type, LOG_LEVELS level)
+{
+  return g_log_levels[type].load(std::memory_order_relaxed) >= level;
+}
+
 void GenericLog(Common::Log::LOG_LEVELS level, Common::Log::LOG_TYPE type, const char* file,
                 int line, const char* fmt, ...)
 #ifdef __GNUC__
@@ -88,11 +101,11 @@ void GenericLog(Common::Log::LOG_LEVELS level, Common::Log::LOG_TYPE type, const
 #endif  // loglevel
 #endif  // logging
 
-// Let the compiler optimize this out
+// Let the compiler optimize this out. The arguments of disabled messages aren't evaluated.
 #define GENERIC_LOG(t, v, ...)                                                                     \
   do                                                                                               \
   {                                                                                                \
-    if (v <= MAX_LOGLEVEL)                                                                         \
+    if (v <= MAX_LOGLEVEL && Common::Log::IsLogEnabled(t, v))                                      \
       Common::Log::GenericLog(v, t, __FILE__, __LINE__, __VA_ARGS__);                              \
   } while (0)
 
@@ -5,13 +5,18 @@
 #include "Common/Logging/LogManager.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cstdarg>
 #include <cstring>
+#include <ctime>
 #include <locale>
+#include <memory>
 #include <mutex>
 #include <ostream>
 #include <string>
+#include <vector>
 
+#include <fmt/chrono.h>
 #include <fmt/format.h>
 
 #include "Common/CommonPaths.h"
@@ -19,12 +24,17 @@
 #include "Common/FileUtil.h"
 #include "Common/Logging/ConsoleListener.h"
 #include "Common/Logging/Log.h"
+#include "Common/SPSCQueue.h"
 #include "Common/StringUtil.h"
-#include "Common/Timer.h"
+#include "Common/Thread.h"
 
 namespace Common::Log
 {
 constexpr size_t MAX_MSGLEN = 1024;
+// Messages a thread can have waiting for the writer before further ones are dropped
+constexpr u32 MAX_QUEUED_MESSAGES = 1 << 16;
+
+std::atomic<u8> g_log_levels[NUMBER_OF_LOGS];
 
 const Config::Info<bool> LOGGER_WRITE_TO_FILE{{Config::System::Logger, "Options", "WriteToFile"},
                                               false};
@@ -62,6 +72,66 @@ private:
   bool m_enable;
 };
 
+namespace
+{
+struct QueuedMessage
+{
+  std::chrono::system_clock::time_point time;
+  LOG_LEVELS level;
+  LOG_TYPE type;
+  // Always a __FILE__, so it doesn't have to be copied
+  const char* file;
+  int line;
+  std::string text;
+};
+
+struct ThreadQueue
+{
+  SPSCQueue<QueuedMessage> messages;
+  std::atomic<u32> dropped{0};
+  std::atomic<bool> retired{false};
+};
+
+// The queues outlive the LogManager, since threads keep a pointer to theirs
+std::mutex s_queues_mutex;
+std::vector<std::unique_ptr<ThreadQueue>> s_queues;
+
+struct ThreadQueueOwner
+{
+  ~ThreadQueueOwner()
+  {
+    // The writer frees the queue once it's empty
+    if (queue)
+      queue->retired = true;
+    queue = nullptr;
+  }
+
+  ThreadQueue* queue = nullptr;
+};
+
+thread_local ThreadQueueOwner t_queue;
+
+ThreadQueue* GetThreadQueue()
+{
+  if (t_queue.queue)
+    return t_queue.queue;
+
+  auto queue = std::make_unique<ThreadQueue>();
+  std::lock_guard lk(s_queues_mutex);
+  t_queue.queue = queue.get();
+  s_queues.push_back(std::move(queue));
+  return t_queue.queue;
+}
+
+// Same format as Timer::GetTimeFormatted
+std::string FormatTime(std::chrono::system_clock::time_point time)
+{
+  const std::time_t seconds = std::chrono::system_clock::to_time_t(time);
+  const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch());
+  return fmt::format("{:%M:%S}:{:03}", fmt::localtime(seconds), ms.count() % 1000);
+}
+}  // Anonymous namespace
+
 void GenericLog(LOG_LEVELS level, LOG_TYPE type, const char* file, int line, const char* fmt, ...)
 {
   va_list args;
@@ -166,10 +236,20 @@ LogManager::LogManager()
         Config::Info<bool>{{Config::System::Logger, "Logs", container.m_short_name}, false});
 
   m_path_cutoff_point = DeterminePathCutOffPoint();
+  UpdateLogLevels();
+
+  m_writer_thread = std::thread([this] { WriterThread(); });
 }
 
 LogManager::~LogManager()
 {
+  for (std::atomic<u8>& level : g_log_levels)
+    level.store(0, std::memory_order_relaxed);
+
+  m_writer_running = false;
+  m_writer_event.Set();
+  m_writer_thread.join();
+
   // The log window listener pointer is owned by the GUI code.
   delete m_listeners[LogListener::CONSOLE_LISTENER];
   delete m_listeners[LogListener::FILE_LISTENER];
@@ -204,19 +284,95 @@ void LogManager::Log(LOG_LEVELS level, LOG_TYPE type, const char* file, int line
 void LogManager::LogWithFullPath(LOG_LEVELS level, LOG_TYPE type, const char* file, int line,
                                  const char* format, va_list args)
 {
-  if (!IsEnabled(type, level) || !static_cast<bool>(m_listener_ids))
+  if (!IsLogEnabled(type, level))
+    return;
+
+  ThreadQueue* const queue = GetThreadQueue();
+  if (queue->messages.Size() >= MAX_QUEUED_MESSAGES)
+  {
+    queue->dropped.fetch_add(1, std::memory_order_relaxed);
     return;
+  }
 
   char temp[MAX_MSGLEN];
   CharArrayFromFormatV(temp, MAX_MSGLEN, format, args);
+  queue->messages.Push(
+      QueuedMessage{std::chrono::system_clock::now(), level, type, file, line, temp});
+  m_writer_event.Set();
+}
+
+void LogManager::WriterThread()
+{
+  Common::SetCurrentThreadName("Log writer");
+
+  while (m_writer_running)
+  {
+    m_writer_event.Wait();
+    WriteQueuedMessages();
+  }
+
+  // Whatever was logged before the shutdown
+  WriteQueuedMessages();
+}
+
+void LogManager::WriteQueuedMessages()
+{
+  std::vector<QueuedMessage> messages;
+  u32 dropped = 0;
+  {
+    std::lock_guard lk(s_queues_mutex);
+    for (auto it = s_queues.begin(); it != s_queues.end();)
+    {
+      ThreadQueue& queue = **it;
+      // Nothing gets pushed after this, so the queue is done once it has been emptied
+      const bool retired = queue.retired;
+      for (QueuedMessage message; queue.messages.Pop(message);)
+        messages.push_back(std::move(message));
+      dropped += queue.dropped.exchange(0, std::memory_order_relaxed);
+      it = retired ? s_queues.erase(it) : it + 1;
+    }
+  }
+
+  if (messages.empty() && dropped == 0)
+    return;
+
+  // Each queue is in order, but messages from different threads have to be merged
+  std::stable_sort(messages.begin(), messages.end(),
+                   [](const QueuedMessage& a, const QueuedMessage& b) { return a.time < b.time; });
 
-  const std::string msg =
-      fmt::format("{} {}:{} {}[{}]: {}\n", Common::Timer::GetTimeFormatted(), file, line,
-                  LOG_LEVEL_TO_CHAR[static_cast<int>(level)], GetShortName(type), temp);
+  std::lock_guard lk(m_listeners_mutex);
+  const auto write = [this](LOG_LEVELS level, const std::string& msg) {
+    for (auto listener_id : m_listener_ids)
+    {
+      if (m_listeners[listener_id])
+        m_listeners[listener_id]->Log(level, msg.c_str());
+    }
+  };
+
+  for (const QueuedMessage& message : messages)
+  {
+    write(message.level,
+          fmt::format("{} {}:{} {}[{}]: {}\n", FormatTime(message.time), message.file,
+                      message.line, LOG_LEVEL_TO_CHAR[static_cast<int>(message.level)],
+                      GetShortName(message.type), message.text));
+  }
+
+  if (dropped != 0)
+  {
+    write(LWARNING, fmt::format("{} {} log messages were dropped, because they were logged faster "
+                                "than they could be written\n",
+                                FormatTime(std::chrono::system_clock::now()), dropped));
+  }
+}
 
-  for (auto listener_id : m_listener_ids)
-    if (m_listeners[listener_id])
-      m_listeners[listener_id]->Log(level, msg.c_str());
+void LogManager::UpdateLogLevels()
+{
+  const bool has_listeners = static_cast<bool>(m_listener_ids);
+  for (size_t i = 0; i < m_log.size(); ++i)
+  {
+    const u8 level = m_log[i].m_enable && has_listeners ? static_cast<u8>(m_level) : 0;
+    g_log_levels[i].store(level, std::memory_order_relaxed);
+  }
 }
 
 LOG_LEVELS LogManager::GetLogLevel() const
@@ -227,11 +383,13 @@ LOG_LEVELS LogManager::GetLogLevel() const
 void LogManager::SetLogLevel(LOG_LEVELS level)
 {
   m_level = level;
+  UpdateLogLevels();
 }
 
 void LogManager::SetEnable(LOG_TYPE type, bool enable)
 {
   m_log[type].m_enable = enable;
+  UpdateLogLevels();
 }
 
 bool LogManager::IsEnabled(LOG_TYPE type, LOG_LEVELS level) const
@@ -251,12 +409,17 @@ const char* LogManager::GetFullName(LOG_TYPE type) const
 
 void LogManager::RegisterListener(LogListener::LISTENER id, LogListener* listener)
 {
+  std::lock_guard lk(m_listeners_mutex);
   m_listeners[id] = listener;
 }
 
 void LogManager::EnableListener(LogListener::LISTENER id, bool enable)
 {
-  m_listener_ids[id] = enable;
+  {
+    std::lock_guard lk(m_listeners_mutex);
+    m_listener_ids[id] = enable;
+  }
+  UpdateLogLevels();
 }
 
 bool LogManager::IsListenerEnabled(LogListener::LISTENER id) const
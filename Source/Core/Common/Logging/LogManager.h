@@ -5,9 +5,13 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <cstdarg>
+#include <mutex>
+#include <thread>
 
 #include "Common/BitSet.h"
+#include "Common/Event.h"
 #include "Common/Logging/Log.h"
 
 namespace Common::Log
@@ -29,6 +33,10 @@ public:
   };
 };
 
+// Messages are formatted on the thread that logs them and go through a queue for that thread to
+// a writer thread, which adds the rest of the line and passes it to the listeners. So logging
+// doesn't wait for the file or the console, and a thread only takes a lock to log when the
+// writer has to be woken up.
 class LogManager
 {
 public:
@@ -67,6 +75,11 @@ private:
   LogManager();
   ~LogManager();
 
+  // Refreshes g_log_levels
+  void UpdateLogLevels();
+  void WriterThread();
+  void WriteQueuedMessages();
+
   LogManager(const LogManager&) = delete;
   LogManager& operator=(const LogManager&) = delete;
   LogManager(LogManager&&) = delete;
@@ -76,6 +89,12 @@ private:
   std::array<LogContainer, NUMBER_OF_LOGS> m_log{};
   std::array<LogListener*, LogListener::NUMBER_OF_LISTENERS> m_listeners{};
   BitSet32 m_listener_ids;
+  // Makes sure that listeners aren't used by the writer while they're being replaced
+  std::mutex m_listeners_mutex;
   size_t m_path_cutoff_point = 0;
+
+  std::thread m_writer_thread;
+  Common::Event m_writer_event;
+  std::atomic<bool> m_writer_running{true};
 };
 }  // namespace Common::Log
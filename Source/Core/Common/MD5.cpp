@@ -4,35 +4,129 @@
 
 #include "Common/MD5.h"
 
-#include <fstream>
+#include <algorithm>
+#include <array>
 #include <functional>
+#include <future>
 #include <mbedtls/md5.h>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <fmt/format.h>
 
+#include "Common/CommonPaths.h"
+#include "Common/FileUtil.h"
 #include "Common/StringUtil.h"
 #include "DiscIO/Blob.h"
 
 namespace MD5
 {
+// Sums of files that haven't changed since they were last summed are reused, so that checking
+// a game in NetPlay is only slow the first time. Each line holds the size and modification time
+// of a file, its sum and its path.
+static std::mutex s_cache_mutex;
+
+static std::string GetCachePath()
+{
+  return File::GetUserPath(D_CACHE_IDX) + "md5sums.txt";
+}
+
+static std::string GetCacheKey(const std::string& file_path)
+{
+  const File::FileInfo info(file_path);
+  return fmt::format("{} {} ", info.GetSize(), info.GetModificationTime());
+}
+
+static std::string LookUpCachedSum(const std::string& file_path, const std::string& key)
+{
+  std::lock_guard lk(s_cache_mutex);
+
+  std::string contents;
+  if (!File::ReadFileToString(GetCachePath(), contents))
+    return {};
+
+  for (const std::string& line : SplitString(contents, '\n'))
+  {
+    // key, 32 hex digits, a space, the path
+    if (line.size() == key.size() + 33 + file_path.size() && StringBeginsWith(line, key) &&
+        StringEndsWith(line, file_path) && line[key.size() + 32] == ' ')
+    {
+      return line.substr(key.size(), 32);
+    }
+  }
+
+  return {};
+}
+
+static void StoreCachedSum(const std::string& file_path, const std::string& key,
+                           const std::string& sum)
+{
+  std::lock_guard lk(s_cache_mutex);
+
+  std::string contents;
+  File::ReadFileToString(GetCachePath(), contents);
+
+  // Drop the stale sum of this file, if any
+  std::string new_contents;
+  for (const std::string& line : SplitString(contents, '\n'))
+  {
+    if (!line.empty() && !StringEndsWith(line, ' ' + file_path))
+      new_contents += line + '\n';
+  }
+  new_contents += key + sum + ' ' + file_path + '\n';
+
+  File::WriteStringToFile(GetCachePath(), new_contents);
+}
+
 std::string MD5Sum(const std::string& file_path, std::function<bool(int)> report_progress)
 {
-  std::string output_string;
-  std::vector<u8> data(8 * 1024 * 1024);
+  const std::string cache_key = GetCacheKey(file_path);
+  std::string output_string = LookUpCachedSum(file_path, cache_key);
+  if (!output_string.empty())
+  {
+    report_progress(100);
+    return output_string;
+  }
+
+  constexpr size_t BLOCK_SIZE = 8 * 1024 * 1024;
+  std::vector<u8> data(BLOCK_SIZE);
+  std::vector<u8> next_data(BLOCK_SIZE);
   u64 read_offset = 0;
   mbedtls_md5_context ctx;
 
   std::unique_ptr<DiscIO::BlobReader> file(DiscIO::CreateBlobReader(file_path));
+  if (!file)
+    return output_string;
   u64 game_size = file->GetDataSize();
 
+  const auto read_block = [&file, game_size](u64 offset, std::vector<u8>* buffer) {
+    const size_t read_size = std::min<u64>(buffer->size(), game_size - offset);
+    return file->Read(offset, read_size, buffer->data());
+  };
+
   mbedtls_md5_starts_ret(&ctx);
 
+  // Compressed formats take about as long to decompress as MD5 takes to hash, so the next block
+  // is read while the current one is being hashed.
+  std::future<bool> next_read;
+  if (read_offset < game_size)
+    next_read = std::async(std::launch::async, read_block, read_offset, &next_data);
+
   while (read_offset < game_size)
   {
-    size_t read_size = std::min(static_cast<u64>(data.size()), game_size - read_offset);
-    if (!file->Read(read_offset, read_size, data.data()))
+    if (!next_read.get())
       return output_string;
+    std::swap(data, next_data);
+
+    const size_t read_size = std::min(static_cast<u64>(data.size()), game_size - read_offset);
+    if (read_offset + read_size < game_size)
+    {
+      next_read =
+          std::async(std::launch::async, read_block, read_offset + read_size, &next_data);
+    }
 
     mbedtls_md5_update_ret(&ctx, data.data(), read_size);
     read_offset += read_size;
@@ -40,7 +134,11 @@ std::string MD5Sum(const std::string& file_path, std::function<bool(int)> report
     int progress =
         static_cast<int>(static_cast<float>(read_offset) / static_cast<float>(game_size) * 100);
     if (!report_progress(progress))
+    {
+      if (next_read.valid())
+        next_read.wait();
       return output_string;
+    }
   }
 
   std::array<u8, 16> output;
@@ -50,6 +148,8 @@ std::string MD5Sum(const std::string& file_path, std::function<bool(int)> report
   for (u8 n : output)
     output_string += fmt::format("{:02x}", n);
 
+  StoreCachedSum(file_path, cache_key, output_string);
+
   return output_string;
 }
 }  // namespace MD5
@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <set>
 #include <string>
@@ -67,21 +68,24 @@ static int AshmemCreateFileMapping(const char* name, size_t size)
 }
 #endif
 
-void MemArena::GrabSHMSegment(size_t size)
+void MemArena::GrabSHMSegment(size_t size, std::string_view base_name)
 {
 #ifdef _WIN32
-  const std::string name = "dolphin-emu." + std::to_string(GetCurrentProcessId());
+  const std::string name = std::string(base_name) + "." + std::to_string(GetCurrentProcessId());
   hMemoryMapping = CreateFileMapping(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0,
                                      static_cast<DWORD>(size), UTF8ToTStr(name).c_str());
+  if (hMemoryMapping)
+    m_segment_name = name;
 #elif defined(ANDROID)
-  fd = AshmemCreateFileMapping(("dolphin-emu." + std::to_string(getpid())).c_str(), size);
+  fd = AshmemCreateFileMapping((std::string(base_name) + "." + std::to_string(getpid())).c_str(),
+                               size);
   if (fd < 0)
   {
     NOTICE_LOG(MEMMAP, "Ashmem allocation failed");
     return;
   }
 #else
-  const std::string file_name = "/dolphin-emu." + std::to_string(getpid());
+  const std::string file_name = "/" + std::string(base_name) + "." + std::to_string(getpid());
   fd = shm_open(file_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
   if (fd == -1)
   {
@@ -96,6 +100,7 @@ void MemArena::GrabSHMSegment(size_t size)
 
 void MemArena::ReleaseSHMSegment()
 {
+  m_segment_name.clear();
 #ifdef _WIN32
   CloseHandle(hMemoryMapping);
   hMemoryMapping = 0;
@@ -119,6 +124,10 @@ void* MemArena::CreateView(s64 offset, size_t size, void* base)
   }
   else
   {
+#ifdef MADV_HUGEPAGE
+    if (m_large_pages)
+      madvise(retval, size, MADV_HUGEPAGE);
+#endif
     return retval;
   }
 #endif
@@ -140,16 +149,22 @@ u8* MemArena::FindMemoryBase()
 #else
   const size_t memory_size = 0x400000000;
 #endif
+  // Huge pages can only back views at 2 MiB aligned addresses, so reserve enough to align the base
+  constexpr size_t alignment = 0x200000;
+  const auto align_base = [](void* base) {
+    return reinterpret_cast<u8*>((reinterpret_cast<uintptr_t>(base) + alignment - 1) &
+                                 ~(alignment - 1));
+  };
 
 #ifdef _WIN32
-  u8* base = static_cast<u8*>(VirtualAlloc(nullptr, memory_size, MEM_RESERVE, PAGE_READWRITE));
+  void* base = VirtualAlloc(nullptr, memory_size + alignment, MEM_RESERVE, PAGE_READWRITE);
   if (!base)
   {
     PanicAlert("Failed to map enough memory space: %s", GetLastErrorString().c_str());
     return nullptr;
   }
   VirtualFree(base, 0, MEM_RELEASE);
-  return base;
+  return align_base(base);
 #else
 #ifdef ANDROID
   // Android 4.3 changed how mmap works.
@@ -159,14 +174,14 @@ u8* MemArena::FindMemoryBase()
 #else
   const int flags = MAP_ANON | MAP_PRIVATE;
 #endif
-  void* base = mmap(nullptr, memory_size, PROT_NONE, flags, -1, 0);
+  void* base = mmap(nullptr, memory_size + alignment, PROT_NONE, flags, -1, 0);
   if (base == MAP_FAILED)
   {
     PanicAlert("Failed to map enough memory space: %s", LastStrerrorString().c_str());
     return nullptr;
   }
-  munmap(base, memory_size);
-  return static_cast<u8*>(base);
+  munmap(base, memory_size + alignment);
+  return align_base(base);
 #endif
 }
 
@@ -5,6 +5,8 @@
 #pragma once
 
 #include <cstddef>
+#include <string>
+#include <string_view>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -21,8 +23,15 @@ namespace Common
 class MemArena
 {
 public:
-  void GrabSHMSegment(size_t size);
+  // The segment is named "<base_name>.<pid>". Where the platform allows it, other processes can
+  // open it under the name returned by GetSegmentName() for as long as it is held.
+  void GrabSHMSegment(size_t size, std::string_view base_name = "dolphin-emu");
+  // Asks for views created from now on to be backed by transparent huge pages. The OS is free to
+  // ignore this; it needs shmem huge pages set to "advise" on Linux and does nothing elsewhere.
+  void SetLargePages(bool large_pages) { m_large_pages = large_pages; }
   void ReleaseSHMSegment();
+  // Empty if the segment isn't held or can't be opened by name on this platform.
+  const std::string& GetSegmentName() const { return m_segment_name; }
   void* CreateView(s64 offset, size_t size, void* base = nullptr);
   void ReleaseView(void* view, size_t size);
 
@@ -35,6 +44,8 @@ private:
 #else
   int fd;
 #endif
+  std::string m_segment_name;
+  bool m_large_pages = false;
 };
 
 }  // namespace Common
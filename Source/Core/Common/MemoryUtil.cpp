@@ -33,16 +33,56 @@ namespace Common
 // This is purposely not a full wrapper for virtualalloc/mmap, but it
 // provides exactly the primitive operations that Dolphin needs.
 
-void* AllocateExecutableMemory(size_t size)
+#ifdef _WIN32
+static bool EnableLockMemoryPrivilege()
+{
+  HANDLE token;
+  if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token))
+    return false;
+
+  TOKEN_PRIVILEGES privileges{};
+  privileges.PrivilegeCount = 1;
+  privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+  bool success = LookupPrivilegeValue(nullptr, SE_LOCK_MEMORY_NAME, &privileges.Privileges[0].Luid);
+  // AdjustTokenPrivileges also succeeds when the privilege wasn't granted to the user
+  success = success && AdjustTokenPrivileges(token, FALSE, &privileges, 0, nullptr, nullptr) &&
+            GetLastError() == ERROR_SUCCESS;
+  CloseHandle(token);
+  return success;
+}
+
+static void* AllocateLargePages(size_t size, DWORD protect)
+{
+  static const bool privilege_enabled = EnableLockMemoryPrivilege();
+  const size_t large_page_size = GetLargePageMinimum();
+  if (!privilege_enabled || large_page_size == 0)
+    return nullptr;
+
+  // VirtualFree releases the whole allocation, so rounding up the size is invisible to callers
+  size = (size + large_page_size - 1) & ~(large_page_size - 1);
+  void* ptr = VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE | MEM_LARGE_PAGES, protect);
+  if (!ptr)
+    WARN_LOG(MEMMAP, "Failed to allocate large pages: %s", GetLastErrorString().c_str());
+  return ptr;
+}
+#endif
+
+void* AllocateExecutableMemory(size_t size, bool large_pages)
 {
 #if defined(_WIN32)
-  void* ptr = VirtualAlloc(nullptr, size, MEM_COMMIT, PAGE_EXECUTE_READWRITE);
+  void* ptr = large_pages ? AllocateLargePages(size, PAGE_EXECUTE_READWRITE) : nullptr;
+  if (!ptr)
+    ptr = VirtualAlloc(nullptr, size, MEM_COMMIT, PAGE_EXECUTE_READWRITE);
 #else
   void* ptr =
       mmap(nullptr, size, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_ANON | MAP_PRIVATE, -1, 0);
 
   if (ptr == MAP_FAILED)
     ptr = nullptr;
+#ifdef MADV_HUGEPAGE
+  else if (large_pages)
+    madvise(ptr, size, MADV_HUGEPAGE);
+#endif
 #endif
 
   if (ptr == nullptr)
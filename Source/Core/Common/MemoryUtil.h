@@ -9,7 +9,10 @@
 
 namespace Common
 {
-void* AllocateExecutableMemory(size_t size);
+// With large_pages, the allocation is backed by large pages if the OS allows it. On Windows that
+// needs the "Lock pages in memory" privilege; on Linux it needs transparent huge pages set to
+// "madvise" or "always". Otherwise this quietly falls back to normal pages.
+void* AllocateExecutableMemory(size_t size, bool large_pages = false);
 void* AllocateMemoryPages(size_t size);
 void FreeMemoryPages(void* ptr, size_t size);
 void* AllocateAlignedMemory(size_t size, size_t alignment);
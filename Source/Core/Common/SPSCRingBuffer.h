@@ -0,0 +1,94 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+// A lockless, fixed size ring buffer of trivially copyable elements between a single producer
+// thread and a single consumer thread. Unlike SPSCQueue, nothing is allocated after construction,
+// and elements are pushed and read in blocks.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+#include "Common/CommonTypes.h"
+
+namespace Common
+{
+template <typename T, size_t Capacity>
+class SPSCRingBuffer
+{
+  static_assert(std::is_trivially_copyable_v<T>, "SPSCRingBuffer only copies elements");
+  static_assert(Capacity != 0 && (Capacity & (Capacity - 1)) == 0,
+                "SPSCRingBuffer capacity must be a power of two");
+  static_assert(Capacity <= 0x80000000, "SPSCRingBuffer positions are 32 bits");
+
+public:
+  // Can be called from either thread. The result is only a lower bound of what the consumer can
+  // read, and an upper bound of what the producer has written, while the other one is busy.
+  size_t Size() const
+  {
+    return m_write_position.load(std::memory_order_acquire) -
+           m_read_position.load(std::memory_order_acquire);
+  }
+
+  // Producer only. Appends all of the elements, or none of them if they don't fit.
+  bool Push(const T* elements, size_t count)
+  {
+    const u32 write_position = m_write_position.load(std::memory_order_relaxed);
+    const u32 read_position = m_read_position.load(std::memory_order_acquire);
+    if (count > Capacity - (write_position - read_position))
+      return false;
+
+    const size_t offset = write_position & MASK;
+    const size_t first_count = std::min(count, Capacity - offset);
+    std::copy_n(elements, first_count, m_buffer.begin() + offset);
+    std::copy_n(elements + first_count, count - first_count, m_buffer.begin());
+
+    m_write_position.store(write_position + static_cast<u32>(count), std::memory_order_release);
+    return true;
+  }
+
+  // Consumer only. Returns the element that is offset elements past the read position, which
+  // must be less than Size().
+  const T& Peek(size_t offset) const
+  {
+    return m_buffer[(m_read_position.load(std::memory_order_relaxed) + offset) & MASK];
+  }
+
+  // Consumer only. Copies count elements starting offset elements past the read position, all of
+  // which must be less than Size().
+  void Peek(T* elements, size_t offset, size_t count) const
+  {
+    const size_t start = (m_read_position.load(std::memory_order_relaxed) + offset) & MASK;
+    const size_t first_count = std::min(count, Capacity - start);
+    std::copy_n(m_buffer.begin() + start, first_count, elements);
+    std::copy_n(m_buffer.begin(), count - first_count, elements + first_count);
+  }
+
+  // Consumer only. Hands count elements, at most Size(), back to the producer.
+  void Pop(size_t count)
+  {
+    const u32 read_position = m_read_position.load(std::memory_order_relaxed);
+    m_read_position.store(read_position + static_cast<u32>(count), std::memory_order_release);
+  }
+
+  // Not thread-safe
+  void Clear()
+  {
+    m_read_position.store(m_write_position.load(std::memory_order_relaxed),
+                          std::memory_order_relaxed);
+  }
+
+private:
+  static constexpr size_t MASK = Capacity - 1;
+
+  std::array<T, Capacity> m_buffer{};
+  // Free running, so that a full buffer can be told apart from an empty one.
+  std::atomic<u32> m_write_position{0};
+  std::atomic<u32> m_read_position{0};
+};
+}  // namespace Common
@@ -5,13 +5,24 @@
 #include "Common/Thread.h"
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
+#include "Common/Trace.h"
 
 #ifdef _WIN32
 #include <windows.h>
 #else
+#include <pthread.h>
+#include <sched.h>
 #include <unistd.h>
 #endif
 
+#ifdef ANDROID
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <string>
+#include <utility>
+#endif
+
 #ifdef __APPLE__
 #include <mach/mach.h>
 #elif defined BSD4_4 || defined __FreeBSD__ || defined __OpenBSD__
@@ -66,6 +77,8 @@ void SwitchCurrentThread()
 // https://docs.microsoft.com/en-us/visualstudio/debugger/how-to-set-a-thread-name-in-native-code
 void SetCurrentThreadName(const char* szThreadName)
 {
+  Trace::SetCurrentThreadName(szThreadName);
+
   static const DWORD MS_VC_EXCEPTION = 0x406D1388;
 
 #pragma pack(push, 8)
@@ -92,6 +105,11 @@ void SetCurrentThreadName(const char* szThreadName)
   }
 }
 
+void RaiseCurrentThreadPriority()
+{
+  SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_HIGHEST);
+}
+
 #else  // !WIN32, so must be POSIX threads
 
 void SetThreadAffinity(std::thread::native_handle_type thread, u32 mask)
@@ -131,6 +149,8 @@ void SwitchCurrentThread()
 
 void SetCurrentThreadName(const char* szThreadName)
 {
+  Trace::SetCurrentThreadName(szThreadName);
+
 #ifdef __APPLE__
   pthread_setname_np(szThreadName);
 #elif defined __FreeBSD__ || defined __OpenBSD__
@@ -148,6 +168,73 @@ void SetCurrentThreadName(const char* szThreadName)
 #endif
 }
 
+void RaiseCurrentThreadPriority()
+{
+#ifdef __APPLE__
+  pthread_set_qos_class_self_np(QOS_CLASS_USER_INTERACTIVE, 0);
+#else
+  // Needs CAP_SYS_NICE or an RLIMIT_RTPRIO allowance on Linux. The lowest real-time priority is
+  // enough to run ahead of every normal thread.
+  sched_param param{};
+  param.sched_priority = sched_get_priority_min(SCHED_RR);
+  pthread_setschedparam(pthread_self(), SCHED_RR, &param);
+#endif
+}
+
+#endif
+
+#ifdef ANDROID
+// The big cores are the ones that reach the highest frequency, all others count as little. Returns
+// the masks of both, or two empty masks if the cores can't be told apart.
+static std::pair<u32, u32> GetCoreClassMasks()
+{
+  static const std::pair<u32, u32> masks = [] {
+    std::array<u64, 32> max_freqs{};
+    u64 highest = 0;
+    for (u32 i = 0; i < max_freqs.size(); ++i)
+    {
+      // Cores that are offline have no cpufreq entry and are left out
+      std::ifstream file("/sys/devices/system/cpu/cpu" + std::to_string(i) +
+                         "/cpufreq/cpuinfo_max_freq");
+      if (file >> max_freqs[i])
+        highest = std::max(highest, max_freqs[i]);
+    }
+
+    u32 big = 0;
+    u32 little = 0;
+    for (u32 i = 0; i < max_freqs.size(); ++i)
+    {
+      if (max_freqs[i] == highest)
+        big |= 1u << i;
+      else if (max_freqs[i] != 0)
+        little |= 1u << i;
+    }
+
+    if (highest == 0 || little == 0)
+      return std::pair<u32, u32>();
+    return std::pair(big, little);
+  }();
+  return masks;
+}
+#endif
+
+void SetCurrentThreadCoreClass(CoreClass core_class)
+{
+#ifdef ANDROID
+  const auto [big, little] = GetCoreClassMasks();
+  const u32 mask = core_class == CoreClass::Performance ? big : little;
+  if (mask == 0)
+    return;
+
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (int i = 0; i != sizeof(mask) * 8; ++i)
+    if ((mask >> i) & 1)
+      CPU_SET(i, &cpu_set);
+
+  // Bionic has no pthread_setaffinity_np, but pid 0 is the calling thread here
+  sched_setaffinity(0, sizeof(cpu_set), &cpu_set);
 #endif
+}
 
 }  // namespace Common
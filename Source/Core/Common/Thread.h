@@ -36,4 +36,21 @@ inline void YieldCPU()
 
 void SetCurrentThreadName(const char* name);
 
+// Asks the OS to schedule the current thread ahead of normal ones, for threads that spend most of
+// their time waiting and need to react quickly once woken up. Best effort: if the process isn't
+// allowed to do that, the priority stays as it is.
+void RaiseCurrentThreadPriority();
+
+// Cores of CPUs that mix fast cores with power-efficient ones (big.LITTLE)
+enum class CoreClass
+{
+  Performance,
+  Efficiency,
+};
+
+// Keeps the current thread on cores of the given class, so that the threads emulation waits on
+// don't land on little cores, and background workers don't take big ones away from them. Only does
+// something on Android, and only if the cores differ in how fast they can run.
+void SetCurrentThreadCoreClass(CoreClass core_class);
+
 }  // namespace Common
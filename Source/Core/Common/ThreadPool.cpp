@@ -0,0 +1,233 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Common/ThreadPool.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/Thread.h"
+
+namespace Common::ThreadPool
+{
+namespace
+{
+constexpr size_t NUM_PRIORITIES = 2;
+
+struct Worker
+{
+  std::mutex mutex;
+  // Indexed by priority
+  std::array<std::deque<std::function<void()>>, NUM_PRIORITIES> queues;
+  std::thread thread;
+};
+
+class Pool
+{
+public:
+  Pool()
+  {
+    // Leave the CPU and GPU threads a core each
+    const unsigned int threads = std::thread::hardware_concurrency();
+    const size_t count = threads > 3 ? threads - 2 : 1;
+
+    for (size_t i = 0; i < count; i++)
+      m_workers.push_back(std::make_unique<Worker>());
+    for (size_t i = 0; i < count; i++)
+      m_workers[i]->thread = std::thread(&Pool::WorkerLoop, this, i);
+  }
+
+  ~Pool()
+  {
+    // Like WorkQueueThread, the jobs that are still queued are run first, so that anything waiting
+    // for them finishes
+    {
+      std::lock_guard lk(m_sleep_mutex);
+      m_shutdown = true;
+    }
+    m_wakeup.notify_all();
+    for (auto& worker : m_workers)
+      worker->thread.join();
+  }
+
+  size_t GetWorkerCount() const { return m_workers.size(); }
+
+  void Submit(Priority priority, std::function<void()> job)
+  {
+    // Jobs submitted by a job stay on its worker, which is likely to have the data in its cache
+    const size_t index = t_worker_index != NO_WORKER ?
+                             t_worker_index :
+                             m_next_worker.fetch_add(1, std::memory_order_relaxed) %
+                                 m_workers.size();
+    Worker& worker = *m_workers[index];
+    // Counted first, so that the count never drops below zero when the job is taken right away
+    {
+      std::lock_guard lk(m_sleep_mutex);
+      m_queued++;
+    }
+    {
+      std::lock_guard lk(worker.mutex);
+      worker.queues[static_cast<size_t>(priority)].push_back(std::move(job));
+    }
+    m_wakeup.notify_one();
+  }
+
+private:
+  static constexpr size_t NO_WORKER = static_cast<size_t>(-1);
+  static thread_local size_t t_worker_index;
+
+  // Takes the oldest job of the worker's own queue, or else steals one from the others. A job of
+  // a higher priority is taken from anywhere before one of a lower priority.
+  bool TakeJob(size_t index, std::function<void()>* job)
+  {
+    for (size_t priority = 0; priority < NUM_PRIORITIES; priority++)
+    {
+      for (size_t i = 0; i < m_workers.size(); i++)
+      {
+        Worker& worker = *m_workers[(index + i) % m_workers.size()];
+        std::lock_guard lk(worker.mutex);
+        auto& queue = worker.queues[priority];
+        if (queue.empty())
+          continue;
+
+        // Thieves take from the back to stay out of the way of the owner
+        if (i == 0)
+        {
+          *job = std::move(queue.front());
+          queue.pop_front();
+        }
+        else
+        {
+          *job = std::move(queue.back());
+          queue.pop_back();
+        }
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void WorkerLoop(size_t index)
+  {
+    Common::SetCurrentThreadName(fmt::format("Pool worker {}", index).c_str());
+    t_worker_index = index;
+
+    while (true)
+    {
+      std::function<void()> job;
+      if (TakeJob(index, &job))
+      {
+        {
+          std::lock_guard lk(m_sleep_mutex);
+          m_queued--;
+        }
+        job();
+        continue;
+      }
+
+      std::unique_lock lk(m_sleep_mutex);
+      m_wakeup.wait(lk, [this] { return m_shutdown || m_queued != 0; });
+      if (m_shutdown && m_queued == 0)
+        return;
+    }
+  }
+
+  std::vector<std::unique_ptr<Worker>> m_workers;
+  std::atomic<size_t> m_next_worker{0};
+
+  // Guards the two below, which tell the workers when to sleep
+  std::mutex m_sleep_mutex;
+  size_t m_queued = 0;
+  bool m_shutdown = false;
+  std::condition_variable m_wakeup;
+};
+
+thread_local size_t Pool::t_worker_index = Pool::NO_WORKER;
+
+Pool& GetPool()
+{
+  static Pool s_pool;
+  return s_pool;
+}
+}  // Anonymous namespace
+
+size_t GetWorkerCount()
+{
+  return GetPool().GetWorkerCount();
+}
+
+void Submit(Priority priority, std::function<void()> job)
+{
+  GetPool().Submit(priority, std::move(job));
+}
+
+void ParallelFor(size_t count, const std::function<void(size_t)>& job)
+{
+  if (count == 0)
+    return;
+
+  // Helpers can start after everything is done and this function has returned, so the state is
+  // shared with them. They only touch the job while there are indices left to run.
+  struct State
+  {
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> done{0};
+    size_t count;
+    const std::function<void(size_t)>* job;
+  };
+  const auto state = std::make_shared<State>();
+  state->count = count;
+  state->job = &job;
+
+  const auto run = [state] {
+    for (size_t i; (i = state->next.fetch_add(1, std::memory_order_relaxed)) < state->count;)
+    {
+      (*state->job)(i);
+      state->done.fetch_add(1, std::memory_order_release);
+    }
+  };
+
+  const size_t helpers = std::min(count - 1, GetWorkerCount());
+  for (size_t i = 0; i < helpers; i++)
+    Submit(Priority::High, run);
+  run();
+
+  // The last jobs are already running on other threads, and jobs are short
+  while (state->done.load(std::memory_order_acquire) != count)
+    std::this_thread::yield();
+}
+
+JobGroup::~JobGroup()
+{
+  Wait();
+}
+
+void JobGroup::Submit(Priority priority, std::function<void()> job)
+{
+  {
+    std::lock_guard lk(m_mutex);
+    m_pending++;
+  }
+  ThreadPool::Submit(priority, [this, job = std::move(job)] {
+    job();
+    // The group may be destroyed as soon as the count reaches zero and the lock is released
+    std::lock_guard lk(m_mutex);
+    if (--m_pending == 0)
+      m_done.notify_all();
+  });
+}
+
+void JobGroup::Wait()
+{
+  std::unique_lock lk(m_mutex);
+  m_done.wait(lk, [this] { return m_pending == 0; });
+}
+}  // namespace Common::ThreadPool
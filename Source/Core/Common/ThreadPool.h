@@ -0,0 +1,58 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+
+// A process-wide pool of worker threads for short jobs, shared by every subsystem that wants to
+// spread work over the cores, so that they don't each start their own threads and oversubscribe
+// the machine.
+//
+// Each worker has its own queues and takes jobs from the other workers when it runs out. There are
+// two workers fewer than cores, so that the CPU and GPU threads always have a core to themselves.
+// Jobs that an emulation thread waits on go ahead of background jobs.
+namespace Common::ThreadPool
+{
+enum class Priority
+{
+  // Something is waiting for the result, e.g. the parts of a texture being decoded
+  High,
+  // Background work, e.g. loading custom textures from disk
+  Low,
+};
+
+// The workers are started on first use
+size_t GetWorkerCount();
+
+void Submit(Priority priority, std::function<void()> job);
+
+// Runs job(0) to job(count - 1) on the workers and the calling thread, and returns once all of
+// them have finished. The calling thread runs jobs itself until none are left, so this makes
+// progress even when every worker is busy, and can be used from within a job.
+void ParallelFor(size_t count, const std::function<void(size_t)>& job);
+
+// Keeps track of the jobs submitted through it, so that they can be waited for before the data
+// they use goes away. Don't wait from within a job.
+class JobGroup
+{
+public:
+  JobGroup() = default;
+  ~JobGroup();
+
+  JobGroup(const JobGroup&) = delete;
+  JobGroup& operator=(const JobGroup&) = delete;
+
+  void Submit(Priority priority, std::function<void()> job);
+  void Wait();
+
+private:
+  std::mutex m_mutex;
+  std::condition_variable m_done;
+  size_t m_pending = 0;
+};
+}  // namespace Common::ThreadPool
@@ -0,0 +1,180 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Common/Trace.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/File.h"
+
+namespace Common::Trace
+{
+std::atomic<bool> g_enabled{false};
+
+namespace
+{
+// 1.5 MiB per thread
+constexpr size_t EVENTS_PER_THREAD = 1 << 16;
+
+struct Event
+{
+  const char* name;
+  u64 start_us;
+  u64 end_us;
+};
+
+struct ThreadBuffer
+{
+  std::array<Event, EVENTS_PER_THREAD> events;
+  // Only written by the thread the buffer belongs to
+  std::atomic<u64> count{0};
+  u32 tid = 0;
+  // These are guarded by s_mutex
+  std::string name;
+  bool retired = false;
+};
+
+// Buffers stay around when their thread exits, so that their events still make it into the
+// trace. They are freed when the next recording starts.
+struct ThreadBufferOwner
+{
+  ~ThreadBufferOwner();
+
+  ThreadBuffer* buffer = nullptr;
+  std::string name;
+};
+
+std::mutex s_mutex;
+std::vector<std::unique_ptr<ThreadBuffer>> s_buffers;
+u32 s_next_tid = 1;
+
+thread_local ThreadBufferOwner t_owner;
+
+ThreadBufferOwner::~ThreadBufferOwner()
+{
+  if (!buffer)
+    return;
+
+  std::lock_guard lk(s_mutex);
+  buffer->retired = true;
+}
+
+ThreadBuffer* GetThreadBuffer()
+{
+  if (t_owner.buffer)
+    return t_owner.buffer;
+
+  auto buffer = std::make_unique<ThreadBuffer>();
+  std::lock_guard lk(s_mutex);
+  buffer->tid = s_next_tid++;
+  buffer->name = t_owner.name;
+  t_owner.buffer = buffer.get();
+  s_buffers.push_back(std::move(buffer));
+  return t_owner.buffer;
+}
+
+void AppendEscaped(fmt::memory_buffer& out, std::string_view str)
+{
+  for (const char c : str)
+  {
+    if (c == '"' || c == '\\')
+      out.push_back('\\');
+    if (static_cast<unsigned char>(c) >= 0x20)
+      out.push_back(c);
+  }
+}
+}  // Anonymous namespace
+
+void Start()
+{
+  std::lock_guard lk(s_mutex);
+  s_buffers.erase(std::remove_if(s_buffers.begin(), s_buffers.end(),
+                                 [](const auto& buffer) { return buffer->retired; }),
+                  s_buffers.end());
+  for (const auto& buffer : s_buffers)
+    buffer->count.store(0, std::memory_order_relaxed);
+
+  g_enabled = true;
+}
+
+bool StopAndWrite(const std::string& path)
+{
+  g_enabled = false;
+
+  File::IOFile file(path, "wb");
+  if (!file)
+    return false;
+
+  fmt::memory_buffer out;
+  const auto flush = [&file, &out] {
+    file.WriteBytes(out.data(), out.size());
+    out.clear();
+  };
+
+  fmt::format_to(out, "{{\"traceEvents\":[\n");
+  bool first = true;
+
+  std::lock_guard lk(s_mutex);
+  for (const auto& buffer : s_buffers)
+  {
+    fmt::format_to(out, "{}{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},"
+                        "\"args\":{{\"name\":\"",
+                   first ? "" : ",\n", buffer->tid);
+    AppendEscaped(out, buffer->name.empty() ? fmt::format("Thread {}", buffer->tid) : buffer->name);
+    fmt::format_to(out, "\"}}}}");
+    first = false;
+
+    const u64 count = buffer->count.load(std::memory_order_acquire);
+    const u64 begin = count > EVENTS_PER_THREAD ? count - EVENTS_PER_THREAD : 0;
+    for (u64 i = begin; i < count; ++i)
+    {
+      const Event& event = buffer->events[i % EVENTS_PER_THREAD];
+      fmt::format_to(out, ",\n{{\"name\":\"");
+      AppendEscaped(out, event.name);
+      fmt::format_to(out, "\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{},\"dur\":{}}}",
+                     buffer->tid, event.start_us, event.end_us - event.start_us);
+
+      if (out.size() >= 0x10000)
+        flush();
+    }
+  }
+
+  fmt::format_to(out, "\n]}}\n");
+  flush();
+  return file.IsGood();
+}
+
+void SetCurrentThreadName(const char* name)
+{
+  t_owner.name = name;
+  if (!t_owner.buffer)
+    return;
+
+  std::lock_guard lk(s_mutex);
+  t_owner.buffer->name = name;
+}
+
+u64 GetTimeUs()
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void AddEvent(const char* name, u64 start_us, u64 end_us)
+{
+  ThreadBuffer* const buffer = GetThreadBuffer();
+  const u64 index = buffer->count.load(std::memory_order_relaxed);
+  buffer->events[index % EVENTS_PER_THREAD] = {name, start_us, end_us};
+  buffer->count.store(index + 1, std::memory_order_release);
+}
+}  // namespace Common::Trace
@@ -0,0 +1,69 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+// Records timed scopes into a ring buffer per thread while recording is enabled, and writes them
+// out in the Chrome trace event format, which Perfetto and chrome://tracing display as a timeline
+// of what each thread was doing.
+//
+// Recording a scope only touches the buffer of the calling thread, so it takes no locks. The
+// buffers keep the last events of each thread. Event names must be string literals.
+//
+// Builds without USE_TRACING compile the TRACE_SCOPE macro to nothing.
+namespace Common::Trace
+{
+extern std::atomic<bool> g_enabled;
+
+inline bool IsEnabled()
+{
+  return g_enabled.load(std::memory_order_relaxed);
+}
+
+// Clears the events of a previous recording
+void Start();
+// Stops recording and writes everything that was recorded. Returns false if the file couldn't be
+// written.
+bool StopAndWrite(const std::string& path);
+
+// Names the calling thread in traces
+void SetCurrentThreadName(const char* name);
+
+u64 GetTimeUs();
+void AddEvent(const char* name, u64 start_us, u64 end_us);
+
+class Scope
+{
+public:
+  explicit Scope(const char* name) : m_name(name), m_start_us(IsEnabled() ? GetTimeUs() : 0) {}
+  ~Scope()
+  {
+    if (m_start_us != 0 && IsEnabled())
+      AddEvent(m_name, m_start_us, GetTimeUs());
+  }
+
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+
+private:
+  const char* m_name;
+  u64 m_start_us;
+};
+}  // namespace Common::Trace
+
+#ifdef USE_TRACING
+#define TRACE_SCOPE_CONCAT_(a, b) a##b
+#define TRACE_SCOPE_CONCAT(a, b) TRACE_SCOPE_CONCAT_(a, b)
+#define TRACE_SCOPE(name) Common::Trace::Scope TRACE_SCOPE_CONCAT(trace_scope_, __LINE__)(name)
+#else
+#define TRACE_SCOPE(name)                                                                          \
+  do                                                                                               \
+  {                                                                                                \
+  } while (0)
+#endif
@@ -1096,6 +1096,16 @@ public:
     ABI_CallFunction(func);
   }
 
+  template <typename FunctionPointer>
+  void ABI_CallFunctionPCR(FunctionPointer func, const void* param1, u32 param2, X64Reg reg3)
+  {
+    if (reg3 != ABI_PARAM3)
+      MOV(32, R(ABI_PARAM3), R(reg3));
+    MOV(64, R(ABI_PARAM1), Imm64(reinterpret_cast<u64>(param1)));
+    MOV(32, R(ABI_PARAM2), Imm32(param2));
+    ABI_CallFunction(func);
+  }
+
   // Pass a register as a parameter.
   template <typename FunctionPointer>
   void ABI_CallFunctionR(FunctionPointer func, X64Reg reg1)
@@ -1158,6 +1168,13 @@ public:
     auto trampoline = &XEmitter::CallLambdaTrampoline<T, Args...>;
     ABI_CallFunctionPC(trampoline, reinterpret_cast<const void*>(f), p1);
   }
+
+  template <typename T, typename... Args>
+  void ABI_CallLambdaCR(const std::function<T(Args...)>* f, u32 p1, X64Reg reg2)
+  {
+    auto trampoline = &XEmitter::CallLambdaTrampoline<T, Args...>;
+    ABI_CallFunctionPCR(trampoline, reinterpret_cast<const void*>(f), p1, reg2);
+  }
 };  // class XEmitter
 
 class X64CodeBlock : public Common::CodeBlock<XEmitter>
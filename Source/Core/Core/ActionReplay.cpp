@@ -25,6 +25,7 @@
 #include <atomic>
 #include <iterator>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <unordered_set>
 #include <utility>
@@ -40,6 +41,7 @@
 
 #include "Core/ARDecrypt.h"
 #include "Core/ConfigManager.h"
+#include "Core/PatchEngine.h"
 #include "Core/PowerPC/MMU.h"
 
 namespace ActionReplay
@@ -90,6 +92,52 @@ static std::atomic<bool> s_use_internal_log{false};
 static const ARCode* s_current_code = nullptr;
 static bool s_disable_logging = false;
 
+// After their first run, the active codes run from a flat list of operations, which has the line
+// skips of conditional codes resolved to jumps and runs of constant writes merged, so that running
+// them every frame doesn't decode every line again. Every line has the operation it would run if
+// it was reached on its own, as a skip can land on the second line of a two-line code.
+namespace
+{
+struct CompiledOp
+{
+  enum class Type : u8
+  {
+    None,
+    End,
+    Writes,
+    Normal,
+    Conditional,
+    FillAndSlide,
+    MemoryCopy,
+    SelfModification,
+    UnsupportedZeroCode,
+  };
+
+  Type type = Type::None;
+  u32 address = 0;
+  u32 data = 0;
+  // The first line of a two-line zero code, the zero code of UnsupportedZeroCode, or the index
+  // into CompiledCode::writes of Writes
+  u32 extra = 0;
+  // The line to continue at, and the one to continue at when a conditional code's check fails
+  u32 next = 0;
+  u32 skip_target = 0;
+};
+
+struct CompiledCode
+{
+  // Into s_active_codes. Codes that only write constants are merged into the ones before them,
+  // which only write constants as well.
+  size_t code_index;
+  std::vector<CompiledOp> ops;
+  std::vector<PatchEngine::WriteList> writes;
+};
+}  // Anonymous namespace
+
+// Protected by s_lock, like the codes they come from
+static std::vector<CompiledCode> s_compiled_codes;
+static bool s_compiled_codes_valid = false;
+
 struct ARAddr
 {
   union
@@ -126,6 +174,7 @@ void ApplyCodes(const std::vector<ARCode>& codes)
 
 void SetSyncedCodesAsActive()
 {
+  s_compiled_codes_valid = false;
   s_active_codes.clear();
   s_active_codes.reserve(s_synced_codes.size());
   s_active_codes = s_synced_codes;
@@ -814,6 +863,36 @@ static bool ConditionalCode(const ARAddr& addr, const u32 data, int* const pSkip
   return true;
 }
 
+static bool IsSelfModificationCode(const ARAddr& addr)
+{
+  return addr >= 0x00002000 && addr < 0x00003000;
+}
+
+static bool SelfModificationCode()
+{
+  LogInfo("This action replay simulator does not support codes that modify Action Replay itself.");
+  PanicAlertT(
+      "This action replay simulator does not support codes that modify Action Replay itself.");
+  return false;
+}
+
+static bool UnsupportedZeroCode(const u8 zcode)
+{
+  if (zcode == ZCODE_ROW)
+  {
+    // Todo: Set register 1BB4 to 1
+    LogInfo("ZCode: Executes all codes in the same row, Set register 1BB4 to 1 (zcode not "
+            "supported)");
+    PanicAlertT("Zero 3 code not supported");
+  }
+  else
+  {
+    LogInfo("ZCode: Unknown");
+    PanicAlertT("Zero code unknown to Dolphin: %08x", zcode);
+  }
+  return false;
+}
+
 // NOTE: Lock needed to give mutual exclusion to s_current_code and LogInfo
 static bool RunCodeLocked(const ARCode& arcode)
 {
@@ -885,14 +964,8 @@ static bool RunCodeLocked(const ARCode& arcode)
     }
 
     // ActionReplay program self modification codes
-    if (addr >= 0x00002000 && addr < 0x00003000)
-    {
-      LogInfo(
-          "This action replay simulator does not support codes that modify Action Replay itself.");
-      PanicAlertT(
-          "This action replay simulator does not support codes that modify Action Replay itself.");
-      return false;
-    }
+    if (IsSelfModificationCode(addr))
+      return SelfModificationCode();
 
     // skip these weird init lines
     // TODO: Where are the "weird init lines"?
@@ -920,11 +993,7 @@ static bool RunCodeLocked(const ARCode& arcode)
         break;
 
       case ZCODE_ROW:  // Executes all codes in the same row
-        // Todo: Set register 1BB4 to 1
-        LogInfo("ZCode: Executes all codes in the same row, Set register 1BB4 to 1 (zcode not "
-                "supported)");
-        PanicAlertT("Zero 3 code not supported");
-        return false;
+        return UnsupportedZeroCode(zcode);
 
       case ZCODE_04:  // Fill & Slide or Memory Copy
         if (0x3 == ((data >> 25) & 0x03))
@@ -942,9 +1011,7 @@ static bool RunCodeLocked(const ARCode& arcode)
         break;
 
       default:
-        LogInfo("ZCode: Unknown");
-        PanicAlertT("Zero code unknown to Dolphin: %08x", zcode);
-        return false;
+        return UnsupportedZeroCode(zcode);
       }
 
       // done handling zero codes
@@ -973,6 +1040,257 @@ static bool RunCodeLocked(const ARCode& arcode)
   return true;
 }
 
+static bool IsConstantWrite(const ARAddr& addr, const u32 data)
+{
+  // Larger fills are left to write themselves rather than being merged byte by byte
+  constexpr u32 MAX_MERGED_FILL = 64;
+
+  if (addr == 0 || IsSelfModificationCode(addr) || addr.type != 0x00 ||
+      addr.subtype != SUB_RAM_WRITE)
+  {
+    return false;
+  }
+
+  switch (addr.size)
+  {
+  case DATATYPE_8BIT:
+    return (data >> 8) < MAX_MERGED_FILL;
+  case DATATYPE_16BIT:
+    return (data >> 16) < MAX_MERGED_FILL / 2;
+  default:
+    return true;
+  }
+}
+
+// Same writes as Subtype_RamWriteAndFill
+static void AddConstantWrite(const ARAddr& addr, const u32 data, PatchEngine::WriteList* writes)
+{
+  const u32 new_addr = addr.GCAddress();
+  switch (addr.size)
+  {
+  case DATATYPE_8BIT:
+    for (u32 i = 0; i <= data >> 8; ++i)
+      writes->Add(new_addr + i, data & 0xFF, sizeof(u8));
+    break;
+  case DATATYPE_16BIT:
+    for (u32 i = 0; i <= data >> 16; ++i)
+      writes->Add(new_addr + i * 2, data & 0xFFFF, sizeof(u16));
+    break;
+  default:
+    writes->Add(new_addr, data, sizeof(u32));
+    break;
+  }
+}
+
+static CompiledCode CompileCode(const ARCode& arcode, size_t code_index)
+{
+  const std::vector<AREntry>& lines = arcode.ops;
+  const u32 count = static_cast<u32>(lines.size());
+  CompiledCode compiled{code_index, std::vector<CompiledOp>(count), {}};
+  std::vector<bool> is_skip_target(count + 1);
+
+  for (u32 i = 0; i < count; ++i)
+  {
+    const ARAddr addr(lines[i].cmd_addr);
+    const u32 data = lines[i].value;
+    CompiledOp& op = compiled.ops[i];
+    op.address = addr;
+    op.data = data;
+    op.next = i + 1;
+
+    if (IsSelfModificationCode(addr))
+    {
+      op.type = CompiledOp::Type::SelfModification;
+    }
+    else if (addr == 0)
+    {
+      const u8 zcode = data >> 29;
+      switch (zcode)
+      {
+      case ZCODE_END:
+        op.type = CompiledOp::Type::End;
+        break;
+      case ZCODE_NORM:
+        break;
+      case ZCODE_04:
+        // Runs on the line after it. A code that ends on it does nothing.
+        if (i + 1 == count)
+          break;
+        op.type = ((data >> 25) & 0x03) == 0x3 ? CompiledOp::Type::MemoryCopy :
+                                                  CompiledOp::Type::FillAndSlide;
+        op.address = lines[i + 1].cmd_addr;
+        op.data = lines[i + 1].value;
+        op.extra = data;
+        op.next = i + 2;
+        break;
+      default:
+        op.type = CompiledOp::Type::UnsupportedZeroCode;
+        op.extra = zcode;
+        break;
+      }
+    }
+    else if (addr.type == 0x00)
+    {
+      op.type = CompiledOp::Type::Normal;
+    }
+    else
+    {
+      op.type = CompiledOp::Type::Conditional;
+      op.skip_target = count;
+      if (addr.subtype == CONDTIONAL_ONE_LINE || addr.subtype == CONDTIONAL_TWO_LINES)
+      {
+        op.skip_target = std::min(count, i + 2 + addr.subtype);
+      }
+      else if (addr.subtype == CONDTIONAL_ALL_LINES_UNTIL)
+      {
+        // Skips up to and including the next "00000000 40000000" line
+        const auto endif = std::find(lines.begin() + i + 1, lines.end(), AREntry(0, 0x40000000));
+        if (endif != lines.end())
+          op.skip_target = static_cast<u32>(endif - lines.begin()) + 1;
+      }
+      is_skip_target[op.skip_target] = true;
+    }
+  }
+
+  // Merge consecutive constant writes that nothing can skip into the middle of
+  for (u32 i = 0; i < count;)
+  {
+    if (!IsConstantWrite(lines[i].cmd_addr, lines[i].value))
+    {
+      ++i;
+      continue;
+    }
+
+    PatchEngine::WriteList writes;
+    u32 end = i;
+    do
+    {
+      AddConstantWrite(lines[end].cmd_addr, lines[end].value, &writes);
+      ++end;
+    } while (end < count && !is_skip_target[end] &&
+             IsConstantWrite(lines[end].cmd_addr, lines[end].value));
+    writes.Finalize();
+
+    CompiledOp& op = compiled.ops[i];
+    op.type = CompiledOp::Type::Writes;
+    op.extra = static_cast<u32>(compiled.writes.size());
+    op.next = end;
+    compiled.writes.push_back(std::move(writes));
+    i = end;
+  }
+
+  return compiled;
+}
+
+// Returns the writes of a code that does nothing but write constants
+static std::optional<PatchEngine::WriteList> GetConstantWrites(const CompiledCode& code)
+{
+  PatchEngine::WriteList writes;
+  for (u32 i = 0; i < code.ops.size(); i = code.ops[i].next)
+  {
+    const CompiledOp& op = code.ops[i];
+    if (op.type == CompiledOp::Type::End)
+      break;
+    if (op.type == CompiledOp::Type::Writes)
+      writes.Add(code.writes[op.extra]);
+    else if (op.type != CompiledOp::Type::None)
+      return std::nullopt;
+  }
+  return writes;
+}
+
+static void CompileActiveCodesLocked()
+{
+  s_compiled_codes.clear();
+
+  // Codes that only write constants can't fail, so consecutive ones are merged into one list
+  bool previous_is_constant = false;
+  for (size_t i = 0; i < s_active_codes.size(); ++i)
+  {
+    CompiledCode compiled = CompileCode(s_active_codes[i], i);
+    std::optional<PatchEngine::WriteList> writes = GetConstantWrites(compiled);
+    if (writes && previous_is_constant)
+    {
+      s_compiled_codes.back().writes.front().Add(*writes);
+      continue;
+    }
+
+    if (writes)
+    {
+      CompiledOp op;
+      op.type = CompiledOp::Type::Writes;
+      op.next = 1;
+      compiled.ops = {op};
+      compiled.writes.clear();
+      compiled.writes.push_back(std::move(*writes));
+    }
+    previous_is_constant = writes.has_value();
+    s_compiled_codes.push_back(std::move(compiled));
+  }
+
+  for (CompiledCode& compiled : s_compiled_codes)
+  {
+    for (PatchEngine::WriteList& writes : compiled.writes)
+      writes.Finalize();
+  }
+  s_compiled_codes_valid = true;
+}
+
+// NOTE: Lock needed to give mutual exclusion to s_current_code
+static bool RunCompiledCodeLocked(const CompiledCode& code)
+{
+  for (u32 i = 0; i < code.ops.size();)
+  {
+    const CompiledOp& op = code.ops[i];
+    i = op.next;
+
+    switch (op.type)
+    {
+    case CompiledOp::Type::None:
+      break;
+
+    case CompiledOp::Type::End:
+      return true;
+
+    case CompiledOp::Type::Writes:
+      code.writes[op.extra].Apply();
+      break;
+
+    case CompiledOp::Type::Normal:
+      if (!NormalCode(op.address, op.data))
+        return false;
+      break;
+
+    case CompiledOp::Type::Conditional:
+    {
+      int skip_count = 0;
+      if (!ConditionalCode(op.address, op.data, &skip_count))
+        return false;
+      if (skip_count != 0)
+        i = op.skip_target;
+      break;
+    }
+
+    case CompiledOp::Type::FillAndSlide:
+      if (!ZeroCode_FillAndSlide(op.extra, op.address, op.data))
+        return false;
+      break;
+
+    case CompiledOp::Type::MemoryCopy:
+      if (!ZeroCode_MemoryCopy(op.extra, op.address, op.data))
+        return false;
+      break;
+
+    case CompiledOp::Type::SelfModification:
+      return SelfModificationCode();
+
+    case CompiledOp::Type::UnsupportedZeroCode:
+      return UnsupportedZeroCode(static_cast<u8>(op.extra));
+    }
+  }
+  return true;
+}
+
 void RunAllActive()
 {
   if (!SConfig::GetInstance().bEnableCheats)
@@ -982,14 +1300,39 @@ void RunAllActive()
   // are only atomic ops unless contested. It should be rare for this to
   // be contested.
   std::lock_guard<std::mutex> guard(s_lock);
-  s_active_codes.erase(std::remove_if(s_active_codes.begin(), s_active_codes.end(),
-                                      [](const ARCode& code) {
-                                        bool success = RunCodeLocked(code);
-                                        LogInfo("\n");
-                                        return !success;
-                                      }),
-                       s_active_codes.end());
-  s_disable_logging = true;
+
+  // The first run after the codes change goes line by line, so that it gets logged
+  if (!s_disable_logging)
+  {
+    s_active_codes.erase(std::remove_if(s_active_codes.begin(), s_active_codes.end(),
+                                        [](const ARCode& code) {
+                                          bool success = RunCodeLocked(code);
+                                          LogInfo("\n");
+                                          return !success;
+                                        }),
+                         s_active_codes.end());
+    s_disable_logging = true;
+    s_compiled_codes_valid = false;
+    return;
+  }
+
+  if (!s_compiled_codes_valid)
+    CompileActiveCodesLocked();
+
+  std::vector<size_t> failed_codes;
+  for (const CompiledCode& code : s_compiled_codes)
+  {
+    s_current_code = &s_active_codes[code.code_index];
+    if (!RunCompiledCodeLocked(code))
+      failed_codes.push_back(code.code_index);
+  }
+
+  if (failed_codes.empty())
+    return;
+
+  for (auto it = failed_codes.rbegin(); it != failed_codes.rend(); ++it)
+    s_active_codes.erase(s_active_codes.begin() + *it);
+  s_compiled_codes_valid = false;
 }
 
 }  // namespace ActionReplay
@@ -86,7 +86,9 @@ private:
   int iSyncGpuMaxDistance;
   int iSyncGpuMinDistance;
   float fSyncGpuOverclock;
+  bool bSyncGPUAdaptive;
   bool bFastDiscSpeed;
+  bool bFastBulkDiscReads;
   bool bDSPHLE;
   bool bHLE_BS2;
   int iSelectedLanguage;
@@ -119,7 +121,9 @@ void ConfigCache::SaveConfig(const SConfig& config)
   iSyncGpuMaxDistance = config.iSyncGpuMaxDistance;
   iSyncGpuMinDistance = config.iSyncGpuMinDistance;
   fSyncGpuOverclock = config.fSyncGpuOverclock;
+  bSyncGPUAdaptive = config.bSyncGPUAdaptive;
   bFastDiscSpeed = config.bFastDiscSpeed;
+  bFastBulkDiscReads = config.bFastBulkDiscReads;
   bDSPHLE = config.bDSPHLE;
   bHLE_BS2 = config.bHLE_BS2;
   iSelectedLanguage = config.SelectedLanguage;
@@ -165,7 +169,9 @@ void ConfigCache::RestoreConfig(SConfig* config)
   config->iSyncGpuMaxDistance = iSyncGpuMaxDistance;
   config->iSyncGpuMinDistance = iSyncGpuMinDistance;
   config->fSyncGpuOverclock = fSyncGpuOverclock;
+  config->bSyncGPUAdaptive = bSyncGPUAdaptive;
   config->bFastDiscSpeed = bFastDiscSpeed;
+  config->bFastBulkDiscReads = bFastBulkDiscReads;
   config->bDSPHLE = bDSPHLE;
   config->bHLE_BS2 = bHLE_BS2;
   config->SelectedLanguage = iSelectedLanguage;
@@ -230,9 +236,18 @@ static GPUDeterminismMode ParseGPUDeterminismMode(const std::string& mode)
 // Boot the ISO or file
 bool BootCore(std::unique_ptr<BootParameters> boot, const WindowSystemInfo& wsi)
 {
+  boot = ApplyBootSettings(std::move(boot));
   if (!boot)
     return false;
 
+  return Core::Init(std::move(boot), wsi);
+}
+
+std::unique_ptr<BootParameters> ApplyBootSettings(std::unique_ptr<BootParameters> boot)
+{
+  if (!boot)
+    return nullptr;
+
   SConfig& StartUp = SConfig::GetInstance();
 
   StartUp.bRunCompareClient = false;
@@ -241,7 +256,7 @@ bool BootCore(std::unique_ptr<BootParameters> boot, const WindowSystemInfo& wsi)
   config_cache.SaveConfig(StartUp);
 
   if (!StartUp.SetPathsAndGameMetadata(*boot))
-    return false;
+    return nullptr;
 
   // Load game specific settings
   if (!std::holds_alternative<BootParameters::IPL>(boot->parameters))
@@ -263,7 +278,10 @@ bool BootCore(std::unique_ptr<BootParameters> boot, const WindowSystemInfo& wsi)
     core_section->Get("MMU", &StartUp.bMMU, StartUp.bMMU);
     core_section->Get("LowDCBZHack", &StartUp.bLowDCBZHack, StartUp.bLowDCBZHack);
     core_section->Get("SyncGPU", &StartUp.bSyncGPU, StartUp.bSyncGPU);
+    core_section->Get("SyncGpuAdaptive", &StartUp.bSyncGPUAdaptive, StartUp.bSyncGPUAdaptive);
     core_section->Get("FastDiscSpeed", &StartUp.bFastDiscSpeed, StartUp.bFastDiscSpeed);
+    core_section->Get("FastBulkDiscReads", &StartUp.bFastBulkDiscReads,
+                      StartUp.bFastBulkDiscReads);
     core_section->Get("DSPHLE", &StartUp.bDSPHLE, StartUp.bDSPHLE);
     core_section->Get("CPUCore", &StartUp.cpu_core, StartUp.cpu_core);
     core_section->Get("HLE_BS2", &StartUp.bHLE_BS2, StartUp.bHLE_BS2);
@@ -348,6 +366,14 @@ bool BootCore(std::unique_ptr<BootParameters> boot, const WindowSystemInfo& wsi)
     }
   }
 
+  // Neither movies nor netplay know about fast bulk reads, so they're off for them to stay in sync.
+  // The adaptive SyncGPU distance depends on how fast the host runs, so it would desync them too.
+  if (Movie::IsMovieActive() || NetPlay::IsNetPlayRunning())
+  {
+    StartUp.bFastBulkDiscReads = false;
+    StartUp.bSyncGPUAdaptive = false;
+  }
+
   if (NetPlay::IsNetPlayRunning())
   {
     const NetPlay::NetSettings& netplay_settings = NetPlay::GetNetSettings();
@@ -443,14 +469,12 @@ bool BootCore(std::unique_ptr<BootParameters> boot, const WindowSystemInfo& wsi)
                         std::holds_alternative<BootParameters::Disc>(boot->parameters);
   if (load_ipl)
   {
-    return Core::Init(
-        std::make_unique<BootParameters>(
-            BootParameters::IPL{StartUp.m_region,
-                                std::move(std::get<BootParameters::Disc>(boot->parameters))},
-            boot->savestate_path),
-        wsi);
+    return std::make_unique<BootParameters>(
+        BootParameters::IPL{StartUp.m_region,
+                            std::move(std::get<BootParameters::Disc>(boot->parameters))},
+        boot->savestate_path);
   }
-  return Core::Init(std::move(boot), wsi);
+  return boot;
 }
 
 // SYSCONF can be modified during emulation by the user and internally, which makes it
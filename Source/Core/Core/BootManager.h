@@ -12,6 +12,12 @@ struct WindowSystemInfo;
 namespace BootManager
 {
 bool BootCore(std::unique_ptr<BootParameters> parameters, const WindowSystemInfo& wsi);
+
+// Applies the settings for booting the game, including its game INI, and returns the parameters
+// to boot it with. Returns nullptr if the game can't be booted. The settings are reverted by
+// RestoreConfig.
+std::unique_ptr<BootParameters> ApplyBootSettings(std::unique_ptr<BootParameters> parameters);
+
 void SetEmulationSpeedReset(bool value);
 
 // Synchronise Dolphin's configuration with the SYSCONF (which may have changed during emulation),
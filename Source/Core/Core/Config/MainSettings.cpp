@@ -11,6 +11,7 @@
 #include "Core/HW/EXI/EXI_Device.h"
 #include "Core/HW/Memmap.h"
 #include "Core/HW/SI/SI_Device.h"
+#include "Core/HW/SystemTimers.h"
 #include "Core/PowerPC/PowerPC.h"
 
 namespace Config
@@ -22,7 +23,10 @@ const Info<bool> MAIN_LOAD_IPL_DUMP{{System::Main, "Core", "LoadIPLDump"}, true}
 const Info<PowerPC::CPUCore> MAIN_CPU_CORE{{System::Main, "Core", "CPUCore"},
                                            PowerPC::DefaultCPUCore()};
 const Info<bool> MAIN_JIT_FOLLOW_BRANCH{{System::Main, "Core", "JITFollowBranch"}, true};
+const Info<bool> MAIN_JIT_WARMUP{{System::Main, "Core", "JITWarmup"}, false};
+const Info<u32> MAIN_JIT_TIER_UP_THRESHOLD{{System::Main, "Core", "JITTierUpThreshold"}, 0};
 const Info<bool> MAIN_FASTMEM{{System::Main, "Core", "Fastmem"}, true};
+const Info<bool> MAIN_LARGE_PAGES{{System::Main, "Core", "LargePages"}, false};
 const Info<bool> MAIN_DSP_HLE{{System::Main, "Core", "DSPHLE"}, true};
 const Info<int> MAIN_TIMING_VARIANCE{{System::Main, "Core", "TimingVariance"}, 40};
 const Info<bool> MAIN_CPU_THREAD{{System::Main, "Core", "CPUThread"}, true};
@@ -38,6 +42,9 @@ const Info<AudioCommon::DPL2Quality> MAIN_DPL2_QUALITY{{System::Main, "Core", "D
 const Info<int> MAIN_AUDIO_LATENCY{{System::Main, "Core", "AudioLatency"}, 20};
 const Info<bool> MAIN_AUDIO_STRETCH{{System::Main, "Core", "AudioStretch"}, false};
 const Info<int> MAIN_AUDIO_STRETCH_LATENCY{{System::Main, "Core", "AudioStretchMaxLatency"}, 80};
+const Info<AudioCommon::ResamplingQuality> MAIN_AUDIO_RESAMPLING_QUALITY{
+    {System::Main, "Core", "AudioResamplingQuality"}, AudioCommon::ResamplingQuality::Linear};
+const Info<int> MAIN_AUDIO_PIPEWIRE_QUANTUM{{System::Main, "Core", "AudioPipeWireQuantum"}, 256};
 const Info<std::string> MAIN_MEMCARD_A_PATH{{System::Main, "Core", "MemcardAPath"}, ""};
 const Info<std::string> MAIN_MEMCARD_B_PATH{{System::Main, "Core", "MemcardBPath"}, ""};
 const Info<std::string> MAIN_AGP_CART_A_PATH{{System::Main, "Core", "AgpCartAPath"}, ""};
@@ -92,6 +99,7 @@ const Info<bool> MAIN_LOW_DCBZ_HACK{{System::Main, "Core", "LowDCBZHack"}, false
 const Info<bool> MAIN_FPRF{{System::Main, "Core", "FPRF"}, false};
 const Info<bool> MAIN_ACCURATE_NANS{{System::Main, "Core", "AccurateNaNs"}, false};
 const Info<float> MAIN_EMULATION_SPEED{{System::Main, "Core", "EmulationSpeed"}, 1.0f};
+const Info<bool> MAIN_LOW_LATENCY_PACING{{System::Main, "Core", "LowLatencyPacing"}, false};
 const Info<float> MAIN_OVERCLOCK{{System::Main, "Core", "Overclock"}, 1.0f};
 const Info<bool> MAIN_OVERCLOCK_ENABLE{{System::Main, "Core", "OverclockEnable"}, false};
 const Info<bool> MAIN_RAM_OVERRIDE_ENABLE{{System::Main, "Core", "RAMOverrideEnable"}, false};
@@ -106,6 +114,10 @@ const Info<bool> MAIN_CUSTOM_RTC_ENABLE{{System::Main, "Core", "EnableCustomRTC"
 const Info<u32> MAIN_CUSTOM_RTC_VALUE{{System::Main, "Core", "CustomRTCValue"}, 946684800};
 const Info<bool> MAIN_AUTO_DISC_CHANGE{{System::Main, "Core", "AutoDiscChange"}, false};
 const Info<bool> MAIN_ALLOW_SD_WRITES{{System::Main, "Core", "WiiSDCardAllowWrites"}, true};
+const Info<int> MAIN_INPUT_POLLING_RATE{{System::Main, "Core", "InputPollingRate"}, 0};
+const Info<bool> MAIN_MEMORY_WATCHER_SHARED_MEMORY{
+    {System::Main, "Core", "MemoryWatcherSharedMemory"}, false};
+const Info<bool> MAIN_RECORD_TRACE{{System::Main, "Core", "RecordTrace"}, false};
 
 // Main.Display
 
@@ -126,6 +138,8 @@ const Info<bool> MAIN_DISABLE_SCREENSAVER{{System::Main, "Display", "DisableScre
 
 const Info<bool> MAIN_DSP_CAPTURE_LOG{{System::Main, "DSP", "CaptureLog"}, false};
 const Info<bool> MAIN_DSP_JIT{{System::Main, "DSP", "EnableJIT"}, true};
+const Info<bool> MAIN_DSP_THREAD{{System::Main, "DSP", "LLEOnThread"}, false};
+const Info<bool> MAIN_DSP_HLE_PARALLEL_MIX{{System::Main, "DSP", "HLEParallelMix"}, true};
 const Info<bool> MAIN_DUMP_AUDIO{{System::Main, "DSP", "DumpAudio"}, false};
 const Info<bool> MAIN_DUMP_AUDIO_SILENT{{System::Main, "DSP", "DumpAudioSilent"}, false};
 const Info<bool> MAIN_DUMP_UCODE{{System::Main, "DSP", "DumpUCode"}, false};
@@ -149,4 +163,18 @@ const Info<bool> MAIN_NETWORK_SSL_VERIFY_CERTIFICATES{
 const Info<bool> MAIN_NETWORK_SSL_DUMP_ROOT_CA{{System::Main, "Network", "SSLDumpRootCA"}, false};
 const Info<bool> MAIN_NETWORK_SSL_DUMP_PEER_CERT{{System::Main, "Network", "SSLDumpPeerCert"},
                                                  false};
+
+// Main.Vanguard
+
+const Info<SystemTimers::VanguardStepMode> MAIN_VANGUARD_STEP_MODE{
+    {System::Main, "Vanguard", "StepMode"}, SystemTimers::VanguardStepMode::Field};
+const Info<u32> MAIN_VANGUARD_STEP_CYCLES{{System::Main, "Vanguard", "StepCycles"}, 100000};
+const Info<u32> MAIN_VANGUARD_STATE_RING_SIZE{{System::Main, "Vanguard", "StateRingSize"}, 8};
+const Info<bool> MAIN_VANGUARD_SPILL_STATES_TO_DISK{
+    {System::Main, "Vanguard", "SpillStatesToDisk"}, false};
+const Info<bool> MAIN_VANGUARD_DELTA_STATES{{System::Main, "Vanguard", "DeltaStates"}, false};
+const Info<bool> MAIN_VANGUARD_SHARED_MEMORY{{System::Main, "Vanguard", "SharedMemory"}, true};
+const Info<bool> MAIN_VANGUARD_PRECISE_CODE_INVALIDATION{
+    {System::Main, "Vanguard", "PreciseCodeInvalidation"}, false};
+const Info<u32> MAIN_VANGUARD_APPLY_BUDGET{{System::Main, "Vanguard", "ApplyBudget"}, 2000};
 }  // namespace Config
@@ -16,6 +16,12 @@ enum class CPUCore;
 namespace AudioCommon
 {
 enum class DPL2Quality;
+enum class ResamplingQuality;
+}
+
+namespace SystemTimers
+{
+enum class VanguardStepMode;
 }
 
 namespace Config
@@ -26,7 +32,15 @@ extern const Info<bool> MAIN_SKIP_IPL;
 extern const Info<bool> MAIN_LOAD_IPL_DUMP;
 extern const Info<PowerPC::CPUCore> MAIN_CPU_CORE;
 extern const Info<bool> MAIN_JIT_FOLLOW_BRANCH;
+// Record the blocks each game compiles and compile them again as soon as it next starts
+extern const Info<bool> MAIN_JIT_WARMUP;
+// Interpret each block this many times before compiling it, so code that only runs once or twice
+// (boot, loading) never pays for compilation. 0 compiles every block the first time it runs.
+extern const Info<u32> MAIN_JIT_TIER_UP_THRESHOLD;
 extern const Info<bool> MAIN_FASTMEM;
+// Ask the OS to back emulated RAM and the JIT code space with large pages, to cut down on TLB
+// misses. Silently falls back to normal pages where that isn't possible.
+extern const Info<bool> MAIN_LARGE_PAGES;
 // Should really be in the DSP section, but we're kind of stuck with bad decisions made in the past.
 extern const Info<bool> MAIN_DSP_HLE;
 extern const Info<int> MAIN_TIMING_VARIANCE;
@@ -41,6 +55,8 @@ extern const Info<AudioCommon::DPL2Quality> MAIN_DPL2_QUALITY;
 extern const Info<int> MAIN_AUDIO_LATENCY;
 extern const Info<bool> MAIN_AUDIO_STRETCH;
 extern const Info<int> MAIN_AUDIO_STRETCH_LATENCY;
+extern const Info<AudioCommon::ResamplingQuality> MAIN_AUDIO_RESAMPLING_QUALITY;
+extern const Info<int> MAIN_AUDIO_PIPEWIRE_QUANTUM;
 extern const Info<std::string> MAIN_MEMCARD_A_PATH;
 extern const Info<std::string> MAIN_MEMCARD_B_PATH;
 extern const Info<std::string> MAIN_AGP_CART_A_PATH;
@@ -74,6 +90,7 @@ extern const Info<bool> MAIN_LOW_DCBZ_HACK;
 extern const Info<bool> MAIN_FPRF;
 extern const Info<bool> MAIN_ACCURATE_NANS;
 extern const Info<float> MAIN_EMULATION_SPEED;
+extern const Info<bool> MAIN_LOW_LATENCY_PACING;
 extern const Info<float> MAIN_OVERCLOCK;
 extern const Info<bool> MAIN_OVERCLOCK_ENABLE;
 extern const Info<bool> MAIN_RAM_OVERRIDE_ENABLE;
@@ -87,11 +104,21 @@ extern const Info<bool> MAIN_CUSTOM_RTC_ENABLE;
 extern const Info<u32> MAIN_CUSTOM_RTC_VALUE;
 extern const Info<bool> MAIN_AUTO_DISC_CHANGE;
 extern const Info<bool> MAIN_ALLOW_SD_WRITES;
+// Poll input devices this many times per second on a thread of their own, so the CPU thread never
+// waits on host device I/O. 0 polls them whenever emulation asks for input instead.
+extern const Info<int> MAIN_INPUT_POLLING_RATE;
+// Export the values of watched memory in binary to a shared memory file instead of sending them
+// as text over the MemoryWatcher socket.
+extern const Info<bool> MAIN_MEMORY_WATCHER_SHARED_MEMORY;
+// Record a trace of the whole emulation session to Dump/Traces, for builds with USE_TRACING.
+extern const Info<bool> MAIN_RECORD_TRACE;
 
 // Main.DSP
 
 extern const Info<bool> MAIN_DSP_CAPTURE_LOG;
 extern const Info<bool> MAIN_DSP_JIT;
+extern const Info<bool> MAIN_DSP_THREAD;
+extern const Info<bool> MAIN_DSP_HLE_PARALLEL_MIX;
 extern const Info<bool> MAIN_DUMP_AUDIO;
 extern const Info<bool> MAIN_DUMP_AUDIO_SILENT;
 extern const Info<bool> MAIN_DUMP_UCODE;
@@ -126,4 +153,22 @@ extern const Info<bool> MAIN_NETWORK_SSL_DUMP_WRITE;
 extern const Info<bool> MAIN_NETWORK_SSL_VERIFY_CERTIFICATES;
 extern const Info<bool> MAIN_NETWORK_SSL_DUMP_ROOT_CA;
 extern const Info<bool> MAIN_NETWORK_SSL_DUMP_PEER_CERT;
+
+// Main.Vanguard
+
+extern const Info<SystemTimers::VanguardStepMode> MAIN_VANGUARD_STEP_MODE;
+extern const Info<u32> MAIN_VANGUARD_STEP_CYCLES;
+// Number of RTC states kept in memory. 0 sends every state straight to disk.
+extern const Info<u32> MAIN_VANGUARD_STATE_RING_SIZE;
+extern const Info<bool> MAIN_VANGUARD_SPILL_STATES_TO_DISK;
+// Store ring states as the pages that differ from the first state saved for the game
+extern const Info<bool> MAIN_VANGUARD_DELTA_STATES;
+// Export emulated memory as named shared memory the RTC can map for reads
+extern const Info<bool> MAIN_VANGUARD_SHARED_MEMORY;
+// Invalidate only the JIT blocks on the cache lines a poke touches, so corruptions of code take
+// effect straight away without clearing the whole cache
+extern const Info<bool> MAIN_VANGUARD_PRECISE_CODE_INVALIDATION;
+// How long each step may spend applying queued blast units, in microseconds. Whatever is left
+// over carries on at the next step.
+extern const Info<u32> MAIN_VANGUARD_APPLY_BUDGET;
 }  // namespace Config
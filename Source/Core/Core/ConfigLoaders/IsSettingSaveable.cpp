@@ -25,7 +25,7 @@ bool IsSettingSaveable(const Config::Location& config_location)
 
   if (config_location.system == Config::System::Main)
   {
-    for (const char* section : {"NetPlay", "General", "Display", "Network"})
+    for (const char* section : {"NetPlay", "General", "Display", "Network", "Vanguard"})
     {
       if (config_location.section == section)
         return true;
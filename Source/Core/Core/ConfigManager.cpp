@@ -212,6 +212,7 @@ void SConfig::SaveCoreSettings(IniFile& ini)
   core->Set("SyncGpuMaxDistance", iSyncGpuMaxDistance);
   core->Set("SyncGpuMinDistance", iSyncGpuMinDistance);
   core->Set("SyncGpuOverclock", fSyncGpuOverclock);
+  core->Set("SyncGpuAdaptive", bSyncGPUAdaptive);
   core->Set("FPRF", bFPRF);
   core->Set("AccurateNaNs", bAccurateNaNs);
   core->Set("EnableCheats", bEnableCheats);
@@ -257,6 +258,7 @@ void SConfig::SaveMovieSettings(IniFile& ini)
   IniFile::Section* movie = ini.GetOrCreateSection("Movie");
 
   movie->Set("PauseMovie", m_PauseMovie);
+  movie->Set("SeekIndex", m_MovieSeekIndex);
   movie->Set("Author", m_strMovieAuthor);
   movie->Set("DumpFrames", m_DumpFrames);
   movie->Set("DumpFramesSilent", m_DumpFramesSilent);
@@ -521,7 +523,9 @@ void SConfig::LoadCoreSettings(IniFile& ini)
   core->Get("SyncGpuMaxDistance", &iSyncGpuMaxDistance, 200000);
   core->Get("SyncGpuMinDistance", &iSyncGpuMinDistance, -200000);
   core->Get("SyncGpuOverclock", &fSyncGpuOverclock, 1.0f);
+  core->Get("SyncGpuAdaptive", &bSyncGPUAdaptive, false);
   core->Get("FastDiscSpeed", &bFastDiscSpeed, false);
+  core->Get("FastBulkDiscReads", &bFastBulkDiscReads, false);
   core->Get("LowDCBZHack", &bLowDCBZHack, false);
   core->Get("FPRF", &bFPRF, false);
   core->Get("AccurateNaNs", &bAccurateNaNs, false);
@@ -540,6 +544,7 @@ void SConfig::LoadMovieSettings(IniFile& ini)
   IniFile::Section* movie = ini.GetOrCreateSection("Movie");
 
   movie->Get("PauseMovie", &m_PauseMovie, false);
+  movie->Get("SeekIndex", &m_MovieSeekIndex, false);
   movie->Get("Author", &m_strMovieAuthor, "");
   movie->Get("DumpFrames", &m_DumpFrames, false);
   movie->Get("DumpFramesSilent", &m_DumpFramesSilent, false);
@@ -722,7 +727,9 @@ void SConfig::SetRunningGameMetadata(const std::string& game_id, const std::stri
   Config::AddLayer(ConfigLoaders::GenerateGlobalGameConfigLoader(game_id, revision));
   Config::AddLayer(ConfigLoaders::GenerateLocalGameConfigLoader(game_id, revision));
 
-  if (Core::IsRunning())
+  // Booting a game in place of another one loads all of this for the new game, and the hardware
+  // isn't up while its settings are applied
+  if (Core::IsRunning() && !Core::IsWarmBooting())
   {
     // TODO: have a callback mechanism for title changes?
     if (!g_symbolDB.IsEmpty())
@@ -764,7 +771,9 @@ void SConfig::LoadDefaults()
   bLowDCBZHack = false;
   iBBDumpPort = -1;
   bSyncGPU = false;
+  bSyncGPUAdaptive = false;
   bFastDiscSpeed = false;
+  bFastBulkDiscReads = false;
   bEnableMemcardSdWriting = true;
   SelectedLanguage = 0;
   bOverrideRegionSettings = false;
@@ -53,6 +53,7 @@ struct BootParameters;
 #define BACKEND_CUBEB "Cubeb"
 #define BACKEND_OPENAL "OpenAL"
 #define BACKEND_PULSEAUDIO "Pulse"
+#define BACKEND_PIPEWIRE "PipeWire"
 #define BACKEND_OPENSLES "OpenSLES"
 #define BACKEND_WASAPI _trans("WASAPI (Exclusive Mode)")
 
@@ -134,11 +135,15 @@ struct SConfig
   bool bLowDCBZHack = false;
   int iBBDumpPort = 0;
   bool bFastDiscSpeed = false;
+  // Only large reads after the game has booted skip the disc timing. Not synced over netplay or
+  // stored in movies, so it's forced off for both.
+  bool bFastBulkDiscReads = false;
 
   bool bSyncGPU = false;
   int iSyncGpuMaxDistance;
   int iSyncGpuMinDistance;
   float fSyncGpuOverclock;
+  bool bSyncGPUAdaptive = false;
 
   int SelectedLanguage = 0;
   bool bOverrideRegionSettings = false;
@@ -281,6 +286,7 @@ struct SConfig
 
   std::string m_WirelessMac;
   bool m_PauseMovie;
+  bool m_MovieSeekIndex;
   bool m_ShowLag;
   bool m_ShowFrameCount;
   bool m_ShowRTC;
@@ -9,6 +9,7 @@
 #include <cstring>
 #include <mutex>
 #include <queue>
+#include <thread>
 #include <utility>
 #include <variant>
 
@@ -21,9 +22,9 @@
 
 #include "AudioCommon/AudioCommon.h"
 
-#include "Common/CPUDetect.h"
 #include "Common/CommonPaths.h"
 #include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
 #include "Common/Event.h"
 #include "Common/FileUtil.h"
 #include "Common/Flag.h"
@@ -34,11 +35,13 @@
 #include "Common/StringUtil.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
+#include "Common/Trace.h"
 #include "Common/Version.h"
 
 #include "Core/Analytics.h"
 #include "Core/Boot/Boot.h"
 #include "Core/BootManager.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/CoreTiming.h"
 #include "Core/DSPEmulator.h"
@@ -73,6 +76,10 @@
 #include "Core/MemoryWatcher.h"
 #endif
 
+#include "DiscIO/Enums.h"
+#include "DiscIO/Volume.h"
+#include "DiscIO/VolumeWad.h"
+
 #include "InputCommon/ControlReference/ControlReference.h"
 #include "InputCommon/ControllerInterface/ControllerInterface.h"
 #include "InputCommon/GCAdapter.h"
@@ -108,6 +115,14 @@ static bool s_request_refresh_info = false;
 static bool s_is_throttler_temp_disabled = false;
 static bool s_frame_step = false;
 static std::atomic<bool> s_stop_frame_step;
+// Movie frame number to pause at, or 0 for none
+static std::atomic<u64> s_break_at_frame{0};
+
+// Set by WarmBoot until the next game is up. The emu thread takes the parameters once the running
+// game has stopped.
+static std::atomic<bool> s_is_warm_booting{false};
+static std::mutex s_warm_boot_lock;
+static std::unique_ptr<BootParameters> s_warm_boot;
 
 #ifdef USE_MEMORYWATCHER
 static std::unique_ptr<MemoryWatcher> s_memory_watcher;
@@ -129,7 +144,7 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
 
 bool GetIsThrottlerTempDisabled()
 {
-  return s_is_throttler_temp_disabled;
+  return s_is_throttler_temp_disabled || Movie::IsSeeking();
 }
 
 void SetIsThrottlerTempDisabled(bool disable)
@@ -183,6 +198,11 @@ bool IsRunningAndStarted()
   return s_is_started && !s_is_stopping;
 }
 
+bool IsWarmBooting()
+{
+  return s_is_warm_booting;
+}
+
 bool IsRunningInCurrentThread()
 {
   return IsRunning() && IsCPUThread();
@@ -295,6 +315,58 @@ void Stop()  // - Hammertime!
   }
 }
 
+// Returns whether the game runs on a Wii, or nothing if it can't be told without booting it
+static std::optional<bool> IsWiiGame(const BootParameters& boot)
+{
+  struct Visitor
+  {
+    std::optional<bool> operator()(const BootParameters::Disc& disc) const
+    {
+      return disc.volume->GetVolumeType() == DiscIO::Platform::WiiDisc;
+    }
+    std::optional<bool> operator()(const BootParameters::Executable& executable) const
+    {
+      if (!executable.reader->IsValid())
+        return std::nullopt;
+      return executable.reader->IsWii();
+    }
+    std::optional<bool> operator()(const DiscIO::VolumeWAD&) const { return true; }
+    std::optional<bool> operator()(const BootParameters::NANDTitle&) const { return true; }
+    std::optional<bool> operator()(const BootParameters::IPL&) const { return false; }
+    std::optional<bool> operator()(const BootParameters::DFF&) const { return std::nullopt; }
+  };
+  return std::visit(Visitor{}, boot.parameters);
+}
+
+// Called from GUI thread
+bool WarmBoot(std::unique_ptr<BootParameters>&& boot)
+{
+  // The controllers are only set up for the console that was booted, and movies and NetPlay
+  // expect a fresh start
+  if (!boot || !IsRunningAndStarted() || s_is_booting.IsSet() || Movie::IsMovieActive() ||
+      NetPlay::IsNetPlayRunning() || FifoPlayer::GetInstance().IsPlaying() ||
+      IsWiiGame(*boot) != SConfig::GetInstance().bWii)
+  {
+    return false;
+  }
+
+  {
+    std::lock_guard guard(s_warm_boot_lock);
+    if (s_warm_boot)
+      return false;
+    s_warm_boot = std::move(boot);
+    s_is_warm_booting = true;
+  }
+
+  // Stop the running game the same way Stop does, the emu thread then carries on with the next one
+  INFO_LOG(CONSOLE, "%s", StopMessage(true, "Stop CPU for the next game").c_str());
+  Fifo::EmulatorState(false);
+  CPU::Stop();
+  if (SConfig::GetInstance().bCPUThread)
+    g_video_backend->Video_ExitLoop();
+  return true;
+}
+
 void DeclareAsCPUThread()
 {
   tls_is_cpu_thread.SetValue(true);
@@ -328,6 +400,7 @@ static void CpuThread(const std::optional<std::string>& savestate_path, bool del
     Common::SetCurrentThreadName("CPU thread");
   else
     Common::SetCurrentThreadName("CPU-GPU thread");
+  Common::SetCurrentThreadCoreClass(Common::CoreClass::Performance);
 
   // This needs to be delayed until after the video backend is ready.
   DolphinAnalytics::Instance().ReportGameStart();
@@ -416,8 +489,61 @@ static void FifoPlayerThread(const std::optional<std::string>& savestate_path,
 // Initialize and create emulation thread
 // Call browser: Init():s_emu_thread().
 // See the BootManager.cpp file description for a complete call schedule.
+#ifdef USE_TRACING
+static void WriteTrace()
+{
+  const std::string dir = File::GetUserPath(D_DUMP_IDX) + "Traces" DIR_SEP;
+  File::CreateFullPath(dir);
+
+  const std::time_t cur_time = std::time(nullptr);
+  const std::string path = fmt::format("{}{}_{:%Y-%m-%d_%H-%M-%S}.json", dir,
+                                       SConfig::GetInstance().GetGameID(),
+                                       *std::localtime(&cur_time));
+  if (Common::Trace::StopAndWrite(path))
+    NOTICE_LOG(CORE, "Wrote trace to %s", path.c_str());
+  else
+    ERROR_LOG(CORE, "Could not write trace to %s", path.c_str());
+}
+#endif
+
+// Logs how long a step of booting took and returns the time the next one starts at
+static u64 LogBootPhase(const char* name, u64 start_us)
+{
+  const u64 now_us = Common::Timer::GetTimeUs();
+  INFO_LOG(BOOT, "%s took %.1f ms", name, (now_us - start_us) / 1000.0);
+  return now_us;
+}
+
+// NARRYSMOD_HIJACK - Snag the boot path
+static std::string GetRomPath(const BootParameters& boot)
+{
+  if (std::holds_alternative<BootParameters::Disc>(boot.parameters))
+    return std::get<BootParameters::Disc>(boot.parameters).path;
+  return "";
+}
+
+static void ShutdownHardware()
+{
+  // We must set up this flag before executing HW::Shutdown()
+  s_hardware_initialized = false;
+  INFO_LOG(CONSOLE, "%s", StopMessage(false, "Shutting down HW").c_str());
+  HW::Shutdown();
+  INFO_LOG(CONSOLE, "%s", StopMessage(false, "HW shutdown").c_str());
+
+  // Clear on screen messages that haven't expired
+  OSD::ClearMessages();
+
+  // The config must be restored only after the whole HW has shut down,
+  // not when it is still running.
+  BootManager::RestoreConfig();
+
+  PatchEngine::Shutdown();
+  HLE::Clear();
+}
+
 static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi)
 {
+  u64 boot_start_us = Common::Timer::GetTimeUs();
   const SConfig& core_parameter = SConfig::GetInstance();
   if (s_on_state_changed_callback)
     s_on_state_changed_callback(State::Starting);
@@ -427,6 +553,7 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
     s_is_started = false;
     s_is_stopping = false;
     s_wants_determinism = false;
+    s_is_warm_booting = false;
 
     if (s_on_state_changed_callback)
       s_on_state_changed_callback(State::Uninitialized);
@@ -438,46 +565,62 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
 
   
 
-  // NARRYSMOD_HIJACK - Snag the boot path
-  std::string romPath = "";
-  if (std::holds_alternative<BootParameters::Disc>(boot->parameters))
-    romPath = std::get<BootParameters::Disc>(boot->parameters).path;
-
-  VanguardClientUnmanaged::LOAD_GAME_START(romPath);
+  VanguardClientUnmanaged::LOAD_GAME_START(GetRomPath(*boot));
 
   // For a time this acts as the CPU thread...
   DeclareAsCPUThread();
   s_frame_step = false;
 
+#ifdef USE_TRACING
+  // Declared first so that the trace also covers shutting everything down
+  if (Config::Get(Config::MAIN_RECORD_TRACE))
+    Common::Trace::Start();
+  Common::ScopeGuard trace_guard{[] {
+    if (Common::Trace::IsEnabled())
+      WriteTrace();
+  }};
+#endif
+
   Movie::Init(*boot);
   Common::ScopeGuard movie_guard{&Movie::Shutdown};
 
   HW::Init();
 
-  Common::ScopeGuard hw_guard{[] {
-    // We must set up this flag before executing HW::Shutdown()
-    s_hardware_initialized = false;
-    INFO_LOG(CONSOLE, "%s", StopMessage(false, "Shutting down HW").c_str());
-    HW::Shutdown();
-    INFO_LOG(CONSOLE, "%s", StopMessage(false, "HW shutdown").c_str());
-
-    // Clear on screen messages that haven't expired
-    OSD::ClearMessages();
-
-    // The config must be restored only after the whole HW has shut down,
-    // not when it is still running.
-    BootManager::RestoreConfig();
-
-    PatchEngine::Shutdown();
-    HLE::Clear();
+  // Cleared while a warm boot swaps the hardware out
+  bool hardware_up = true;
+  Common::ScopeGuard hw_guard{[&hardware_up] {
+    if (hardware_up)
+      ShutdownHardware();
   }};
 
+  u64 phase_start_us = LogBootPhase("Hardware init", boot_start_us);
+
+  // Running DSP LLE on a thread changes when the DSP sees memory writes from the CPU, so it has to
+  // come from a setting that NetPlay and movies can sync rather than from the host's core count.
+  SConfig::GetInstance().bDSPThread = Config::Get(Config::MAIN_DSP_THREAD);
+
+  // The DSP emulator only depends on the hardware, so it is set up while the video backend, which
+  // mostly waits on the driver, initializes on this thread. For LLE that covers loading the ROMs
+  // and setting up the DSP JIT.
+  bool dsp_initialized = false;
+  std::thread dsp_init_thread([&dsp_initialized, &core_parameter] {
+    Common::SetCurrentThreadName("DSP init");
+    TRACE_SCOPE("DSP init");
+    dsp_initialized =
+        DSP::GetDSPEmulator()->Initialize(core_parameter.bWii, core_parameter.bDSPThread);
+  });
+  // If booting fails before the DSP is waited for, it still has to be done before HW shuts down
+  Common::ScopeGuard dsp_init_guard{[&dsp_init_thread] { dsp_init_thread.join(); }};
+
   VideoBackendBase::PopulateBackendInfo();
 
-  if (!g_video_backend->Initialize(wsi))
   {
-    PanicAlert("Failed to initialize video backend!");
-    return;
+    TRACE_SCOPE("Video backend init");
+    if (!g_video_backend->Initialize(wsi))
+    {
+      PanicAlert("Failed to initialize video backend!");
+      return;
+    }
   }
   Common::ScopeGuard video_guard{[] { g_video_backend->Shutdown(); }};
 
@@ -486,17 +629,17 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
   g_renderer->BeginUIFrame();
   g_renderer->EndUIFrame();
 
-  if (cpu_info.HTT)
-    SConfig::GetInstance().bDSPThread = cpu_info.num_cores > 4;
-  else
-    SConfig::GetInstance().bDSPThread = cpu_info.num_cores > 2;
+  phase_start_us = LogBootPhase("Video backend init", phase_start_us);
 
-  if (!DSP::GetDSPEmulator()->Initialize(core_parameter.bWii, core_parameter.bDSPThread))
+  dsp_init_guard.Exit();
+  if (!dsp_initialized)
   {
     PanicAlert("Failed to initialize DSP emulation!");
     return;
   }
 
+  phase_start_us = LogBootPhase("Waiting for DSP init", phase_start_us);
+
   // The frontend will likely have initialized the controller interface, as it needs
   // it to provide the configuration dialogs. In this case, instead of re-initializing
   // entirely, we switch the window used for inputs to the render window. This way, the
@@ -516,17 +659,15 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
     Keyboard::LoadConfig();
   }
 
-  const std::optional<std::string> savestate_path = boot->savestate_path;
-  const bool delete_savestate = boot->delete_savestate;
-
   // Load and Init Wiimotes - only if we are booting in Wii mode
   bool init_wiimotes = false;
   if (core_parameter.bWii && !SConfig::GetInstance().m_bt_passthrough_enabled)
   {
     if (init_controllers)
     {
-      Wiimote::Initialize(savestate_path ? Wiimote::InitializeMode::DO_WAIT_FOR_WIIMOTES :
-                                           Wiimote::InitializeMode::DO_NOT_WAIT_FOR_WIIMOTES);
+      Wiimote::Initialize(boot->savestate_path ?
+                              Wiimote::InitializeMode::DO_WAIT_FOR_WIIMOTES :
+                              Wiimote::InitializeMode::DO_NOT_WAIT_FOR_WIIMOTES);
       init_wiimotes = true;
     }
     else
@@ -558,83 +699,151 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
   AudioCommon::InitSoundStream();
   Common::ScopeGuard audio_guard{&AudioCommon::ShutdownSoundStream};
 
-  // The hardware is initialized.
-  s_hardware_initialized = true;
-  s_is_booting.Clear();
-  s_done_booting.Set();
+  phase_start_us = LogBootPhase("Input and audio init", phase_start_us);
 
+  // Games booted with WarmBoot run on the same host side, so everything above stays up
+  for (bool first_game = true;; first_game = false)
+  {
+    if (!first_game)
+    {
+      boot_start_us = Common::Timer::GetTimeUs();
+      s_done_booting.Reset();
+      s_is_booting.Set();
+      DeclareAsCPUThread();
+      s_frame_step = false;
 
-  // Set execution state to known values (CPU/FIFO/Audio Paused)
-  CPU::Break();
+      hardware_up = false;
+      ShutdownHardware();
+      Movie::Shutdown();
+
+      boot = BootManager::ApplyBootSettings(std::move(boot));
+      if (!boot)
+      {
+        PanicAlert("Failed to boot the next game!");
+        return;
+      }
+      VanguardClientUnmanaged::LOAD_GAME_START(GetRomPath(*boot));
+
+      Movie::Init(*boot);
+      HW::Init();
+      hardware_up = true;
+      g_video_backend->ResetEmulatedState();
+
+      SConfig::GetInstance().bDSPThread = Config::Get(Config::MAIN_DSP_THREAD);
+      if (!DSP::GetDSPEmulator()->Initialize(core_parameter.bWii, core_parameter.bDSPThread))
+      {
+        PanicAlert("Failed to initialize DSP emulation!");
+        return;
+      }
+
+      // Picks up the game-specific input profiles
+      Pad::LoadConfig();
+      Keyboard::LoadConfig();
+      if (init_wiimotes)
+        Wiimote::ResetAllWiimotes();
+      if (core_parameter.bWii && !SConfig::GetInstance().m_bt_passthrough_enabled)
+        Wiimote::LoadConfig();
+
+      phase_start_us = LogBootPhase("Hardware reinit", boot_start_us);
+    }
 
-  // Load GCM/DOL/ELF whatever ... we boot with the interpreter core
-  PowerPC::SetMode(PowerPC::CoreMode::Interpreter);
+    // The hardware is initialized.
+    s_hardware_initialized = true;
+    s_is_warm_booting = false;
+    s_is_booting.Clear();
+    s_done_booting.Set();
 
-  // Determine the CPU thread function
-  void (*cpuThreadFunc)(const std::optional<std::string>& savestate_path, bool delete_savestate);
-  if (std::holds_alternative<BootParameters::DFF>(boot->parameters))
-    cpuThreadFunc = FifoPlayerThread;
-  else
-    cpuThreadFunc = CpuThread;
+    // Set execution state to known values (CPU/FIFO/Audio Paused)
+    CPU::Break();
 
-  if (!CBoot::BootUp(std::move(boot)))
-    return;
+    // Load GCM/DOL/ELF whatever ... we boot with the interpreter core
+    PowerPC::SetMode(PowerPC::CoreMode::Interpreter);
 
-  // Initialise Wii filesystem contents.
-  // This is done here after Boot and not in HW to ensure that we operate
-  // with the correct title context since save copying requires title directories to exist.
-  Common::ScopeGuard wiifs_guard{&Core::CleanUpWiiFileSystemContents};
-  if (SConfig::GetInstance().bWii)
-    Core::InitializeWiiFileSystemContents();
-  else
-    wiifs_guard.Dismiss();
+    const std::optional<std::string> savestate_path = boot->savestate_path;
+    const bool delete_savestate = boot->delete_savestate;
 
-  // This adds the SyncGPU handler to CoreTiming, so now CoreTiming::Advance might block.
-  Fifo::Prepare();
+    // Determine the CPU thread function
+    void (*cpuThreadFunc)(const std::optional<std::string>& savestate_path, bool delete_savestate);
+    if (std::holds_alternative<BootParameters::DFF>(boot->parameters))
+      cpuThreadFunc = FifoPlayerThread;
+    else
+      cpuThreadFunc = CpuThread;
 
-  // Setup our core, but can't use dynarec if we are compare server
-  if (core_parameter.cpu_core != PowerPC::CPUCore::Interpreter &&
-      (!core_parameter.bRunCompareServer || core_parameter.bRunCompareClient))
-  {
-    PowerPC::SetMode(PowerPC::CoreMode::JIT);
-  }
-  else
-  {
-    PowerPC::SetMode(PowerPC::CoreMode::Interpreter);
-  }
+    if (!CBoot::BootUp(std::move(boot)))
+      return;
 
-  // ENTER THE VIDEO THREAD LOOP
-  if (core_parameter.bCPUThread)
-  {
-    // This thread, after creating the EmuWindow, spawns a CPU
-    // thread, and then takes over and becomes the video thread
-    Common::SetCurrentThreadName("Video thread");
-    UndeclareAsCPUThread();
+    // Initialise Wii filesystem contents.
+    // This is done here after Boot and not in HW to ensure that we operate
+    // with the correct title context since save copying requires title directories to exist.
+    Common::ScopeGuard wiifs_guard{&Core::CleanUpWiiFileSystemContents};
+    if (SConfig::GetInstance().bWii)
+      Core::InitializeWiiFileSystemContents();
+    else
+      wiifs_guard.Dismiss();
+
+    // This adds the SyncGPU handler to CoreTiming, so now CoreTiming::Advance might block.
+    Fifo::Prepare();
+
+    // Setup our core, but can't use dynarec if we are compare server
+    if (core_parameter.cpu_core != PowerPC::CPUCore::Interpreter &&
+        (!core_parameter.bRunCompareServer || core_parameter.bRunCompareClient))
+    {
+      PowerPC::SetMode(PowerPC::CoreMode::JIT);
+    }
+    else
+    {
+      PowerPC::SetMode(PowerPC::CoreMode::Interpreter);
+    }
+
+    LogBootPhase("Loading the game", phase_start_us);
+    LogBootPhase("Booting", boot_start_us);
+
+    // A stop that came in while the hardware was swapped out may have been undone by setting it
+    // up again
+    if (!first_game && s_is_stopping)
+      return;
 
-    // Spawn the CPU thread. The CPU thread will signal the event that boot is complete.
-    s_cpu_thread = std::thread(cpuThreadFunc, savestate_path, delete_savestate);
+    // ENTER THE VIDEO THREAD LOOP
+    if (core_parameter.bCPUThread)
+    {
+      // This thread, after creating the EmuWindow, spawns a CPU
+      // thread, and then takes over and becomes the video thread
+      Common::SetCurrentThreadName("Video thread");
+      Common::SetCurrentThreadCoreClass(Common::CoreClass::Performance);
+      UndeclareAsCPUThread();
 
-    // become the GPU thread
-    Fifo::RunGpuLoop();
+      // Spawn the CPU thread. The CPU thread will signal the event that boot is complete.
+      s_cpu_thread = std::thread(cpuThreadFunc, savestate_path, delete_savestate);
 
-    // We have now exited the Video Loop
-    INFO_LOG(CONSOLE, "%s", StopMessage(false, "Video Loop Ended").c_str());
+      // become the GPU thread
+      Fifo::RunGpuLoop();
 
-    // Join with the CPU thread.
-    s_cpu_thread.join();
-    INFO_LOG(CONSOLE, "%s", StopMessage(true, "CPU thread stopped.").c_str());
-  }
-  else  // SingleCore mode
-  {
-    // Become the CPU thread
-    cpuThreadFunc(savestate_path, delete_savestate);
-  }
+      // We have now exited the Video Loop
+      INFO_LOG(CONSOLE, "%s", StopMessage(false, "Video Loop Ended").c_str());
+
+      // Join with the CPU thread.
+      s_cpu_thread.join();
+      INFO_LOG(CONSOLE, "%s", StopMessage(true, "CPU thread stopped.").c_str());
+    }
+    else  // SingleCore mode
+    {
+      // Become the CPU thread
+      cpuThreadFunc(savestate_path, delete_savestate);
+    }
 
 #ifdef USE_GDBSTUB
-  INFO_LOG(CONSOLE, "%s", StopMessage(true, "Stopping GDB ...").c_str());
-  gdb_deinit();
-  INFO_LOG(CONSOLE, "%s", StopMessage(true, "GDB stopped.").c_str());
+    INFO_LOG(CONSOLE, "%s", StopMessage(true, "Stopping GDB ...").c_str());
+    gdb_deinit();
+    INFO_LOG(CONSOLE, "%s", StopMessage(true, "GDB stopped.").c_str());
 #endif
+
+    {
+      std::lock_guard guard(s_warm_boot_lock);
+      boot = std::move(s_warm_boot);
+    }
+    if (!boot || s_is_stopping)
+      return;
+  }
 }
 
 // Set or get the running state
@@ -881,6 +1090,15 @@ void Callback_FramePresented()
 // Called from VideoInterface::Update (CPU thread) at emulated field boundaries
 void Callback_NewField()
 {
+  const u64 break_at_frame = s_break_at_frame.load();
+  if (break_at_frame != 0 && Movie::GetCurrentFrame() >= break_at_frame)
+  {
+    s_break_at_frame.store(0);
+    CPU::Break();
+    if (s_on_state_changed_callback)
+      s_on_state_changed_callback(Core::GetState());
+  }
+
   if (s_frame_step)
   {
     // To ensure that s_stop_frame_step is up to date, wait for the GPU thread queue to empty,
@@ -941,21 +1159,26 @@ void UpdateTitle()
       // interested.
       static u64 ticks = 0;
       static u64 idleTicks = 0;
+      static u64 idleCount = 0;
       u64 newTicks = CoreTiming::GetTicks();
       u64 newIdleTicks = CoreTiming::GetIdleTicks();
+      u64 newIdleCount = CoreTiming::GetIdleCount();
 
       u64 diff = (newTicks - ticks) / 1000000;
       u64 idleDiff = (newIdleTicks - idleTicks) / 1000000;
 
       ticks = newTicks;
       idleTicks = newIdleTicks;
+      const u64 idleCountDiff = newIdleCount - idleCount;
+      idleCount = newIdleCount;
 
       float TicksPercentage =
           (float)diff / (float)(SystemTimers::GetTicksPerSecond() / 1000000) * 100;
 
-      SFPS += fmt::format(" | CPU: ~{} MHz [Real: {} + IdleSkip: {}] / {} MHz (~{:3.0f}%)", diff,
-                          diff - idleDiff, idleDiff, SystemTimers::GetTicksPerSecond() / 1000000,
-                          TicksPercentage);
+      SFPS += fmt::format(
+          " | CPU: ~{} MHz [Real: {} + IdleSkip: {} in {} skips] / {} MHz (~{:3.0f}%)", diff,
+          diff - idleDiff, idleDiff, idleCountDiff, SystemTimers::GetTicksPerSecond() / 1000000,
+          TicksPercentage);
     }
   }
 
@@ -1082,6 +1305,11 @@ void DoFrameStep()
   }
 }
 
+void BreakAtFrame(u64 frame)
+{
+  s_break_at_frame.store(frame);
+}
+
 void UpdateInputGate(bool require_focus)
 {
   ControlReference::SetInputGate((!require_focus || Host_RendererHasFocus()) &&
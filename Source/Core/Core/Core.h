@@ -92,6 +92,13 @@ enum class ConsoleType : u32
 
 bool Init(std::unique_ptr<BootParameters> boot, const WindowSystemInfo& wsi);
 void Stop();
+
+// Boots another game in place of the running one. Only the emulated hardware is shut down and
+// initialized again, while the video backend with its caches, the controllers and the audio
+// stream stay up. Returns false without taking the parameters if the core isn't running, a movie
+// or NetPlay is active, or the game is for the other console. The caller then has to stop the
+// core and boot the game normally. For use by Host only.
+bool WarmBoot(std::unique_ptr<BootParameters>&& boot);
 void Shutdown();
 
 void DeclareAsCPUThread();
@@ -101,6 +108,7 @@ std::string StopMessage(bool main_thread, std::string_view message);
 
 bool IsRunning();
 bool IsRunningAndStarted();       // is running and the CPU loop has been entered
+bool IsWarmBooting();             // a game is being booted with WarmBoot
 bool IsRunningInCurrentThread();  // this tells us whether we are running in the CPU thread.
 bool IsCPUThread();               // this tells us whether we are the CPU thread.
 bool IsGPUThread();
@@ -164,6 +172,9 @@ void QueueHostJob(std::function<void()> job, bool run_during_stop = false);
 void HostDispatchJobs();
 
 void DoFrameStep();
+// Pauses emulation at the start of the field where Movie's frame counter reaches the given value.
+// Unlike frame stepping, nothing is paused on the way there. Pass 0 to cancel.
+void BreakAtFrame(u64 frame);
 
 void UpdateInputGate(bool require_focus);
 
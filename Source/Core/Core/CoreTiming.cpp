@@ -17,6 +17,7 @@
 #include "Common/ChunkFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/SPSCQueue.h"
+#include "Common/Trace.h"
 
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
@@ -31,6 +32,11 @@ struct EventType
 {
   TimedCallback callback;
   const std::string* name;
+  bool coalesce;
+  // Bumped by RemoveEvent, which invalidates every queued event of this type at once
+  u32 generation = 0;
+  // Number of queued events of this type that haven't been removed
+  u32 queued = 0;
 };
 
 struct Event
@@ -39,6 +45,7 @@ struct Event
   u64 fifo_order;
   u64 userdata;
   EventType* type;
+  u32 generation = 0;
 };
 
 // Sort by time, unless the times are the same, in which case sort by the order added to the queue
@@ -60,7 +67,10 @@ static std::unordered_map<std::string, EventType> s_event_types;
 // We don't use std::priority_queue because we need to be able to serialize, unserialize and
 // erase arbitrary events (RemoveEvent()) regardless of the queue order. These aren't accomodated
 // by the standard adaptor class.
+// Removed events are left in place and skipped when they reach the front, so that removing
+// doesn't have to search the queue. s_removed_events counts them.
 static std::vector<Event> s_event_queue;
+static size_t s_removed_events;
 static u64 s_event_fifo_id;
 static std::mutex s_ts_write_lock;
 static Common::SPSCQueue<Event, false> s_ts_queue;
@@ -69,6 +79,7 @@ static float s_last_OC_factor;
 static constexpr int MAX_SLICE_LENGTH = 20000;
 
 static s64 s_idled_cycles;
+static u64 s_idle_count;
 static u32 s_fake_dec_start_value;
 static u64 s_fake_dec_start_ticks;
 
@@ -83,6 +94,49 @@ static void EmptyTimedCallback(u64 userdata, s64 cyclesLate)
 {
 }
 
+static bool IsRemoved(const Event& ev)
+{
+  return ev.generation != ev.type->generation;
+}
+
+static void PushEvent(Event ev)
+{
+  ev.generation = ev.type->generation;
+  ev.type->queued++;
+  s_event_queue.emplace_back(std::move(ev));
+  std::push_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
+}
+
+static Event PopEvent()
+{
+  std::pop_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
+  Event ev = std::move(s_event_queue.back());
+  s_event_queue.pop_back();
+  if (IsRemoved(ev))
+    s_removed_events--;
+  else
+    ev.type->queued--;
+  return ev;
+}
+
+// Makes sure the front of the queue is the next event that will actually run
+static void SkipRemovedEvents()
+{
+  while (!s_event_queue.empty() && IsRemoved(s_event_queue.front()))
+    PopEvent();
+}
+
+static void CompactEventQueue()
+{
+  if (s_removed_events == 0)
+    return;
+
+  s_event_queue.erase(std::remove_if(s_event_queue.begin(), s_event_queue.end(), IsRemoved),
+                      s_event_queue.end());
+  std::make_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
+  s_removed_events = 0;
+}
+
 // Changing the CPU speed in Dolphin isn't actually done by changing the physical clock rate,
 // but by changing the amount of work done in a particular amount of time. This tends to be more
 // compatible because it stops the games from actually knowing directly that the clock rate has
@@ -100,7 +154,7 @@ static int CyclesToDowncount(int cycles)
   return static_cast<int>(cycles * s_last_OC_factor);
 }
 
-EventType* RegisterEvent(const std::string& name, TimedCallback callback)
+EventType* RegisterEvent(const std::string& name, TimedCallback callback, bool coalesce)
 {
   // check for existing type with same name.
   // we want event type names to remain unique so that we can use them for serialization.
@@ -109,7 +163,7 @@ EventType* RegisterEvent(const std::string& name, TimedCallback callback)
              "during Init to avoid breaking save states.",
              name.c_str());
 
-  auto info = s_event_types.emplace(name, EventType{callback, nullptr});
+  auto info = s_event_types.emplace(name, EventType{callback, nullptr, coalesce});
   EventType* event_type = &info.first->second;
   event_type->name = &info.first->first;
   return event_type;
@@ -129,6 +183,7 @@ void Init()
   g.slice_length = MAX_SLICE_LENGTH;
   g.global_timer = 0;
   s_idled_cycles = 0;
+  s_idle_count = 0;
 
   // The time between CoreTiming being intialized and the first call to Advance() is considered
   // the slice boundary between slice -1 and slice 0. Dispatcher loops must call Advance() before
@@ -165,6 +220,10 @@ void DoState(PointerWrap& p)
   p.DoMarker("CoreTimingData");
 
   MoveEvents();
+  if (p.GetMode() == PointerWrap::MODE_READ)
+    ClearPendingEvents();
+  else
+    CompactEventQueue();
   p.DoEachElement(s_event_queue, [](PointerWrap& pw, Event& ev) {
     pw.Do(ev.time);
     pw.Do(ev.fifo_order);
@@ -194,6 +253,8 @@ void DoState(PointerWrap& p)
                  name.c_str());
         ev.type = s_ev_lost;
       }
+      ev.generation = ev.type->generation;
+      ev.type->queued++;
     }
   });
   p.DoMarker("CoreTimingEvents");
@@ -223,9 +284,17 @@ u64 GetIdleTicks()
   return static_cast<u64>(s_idled_cycles);
 }
 
+u64 GetIdleCount()
+{
+  return s_idle_count;
+}
+
 void ClearPendingEvents()
 {
+  for (auto& event_type : s_event_types)
+    event_type.second.queued = 0;
   s_event_queue.clear();
+  s_removed_events = 0;
 }
 
 void ScheduleEvent(s64 cycles_into_future, EventType* event_type, u64 userdata, FromThread from)
@@ -253,8 +322,7 @@ void ScheduleEvent(s64 cycles_into_future, EventType* event_type, u64 userdata,
     if (!s_is_global_timer_sane)
       ForceExceptionCheck(cycles_into_future);
 
-    s_event_queue.emplace_back(Event{timeout, s_event_fifo_id++, userdata, event_type});
-    std::push_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
+    PushEvent(Event{timeout, s_event_fifo_id++, userdata, event_type});
   }
   else
   {
@@ -273,15 +341,16 @@ void ScheduleEvent(s64 cycles_into_future, EventType* event_type, u64 userdata,
 
 void RemoveEvent(EventType* event_type)
 {
-  auto itr = std::remove_if(s_event_queue.begin(), s_event_queue.end(),
-                            [&](const Event& e) { return e.type == event_type; });
+  if (event_type->queued == 0)
+    return;
 
-  // Removing random items breaks the invariant so we have to re-establish it.
-  if (itr != s_event_queue.end())
-  {
-    s_event_queue.erase(itr, s_event_queue.end());
-    std::make_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
-  }
+  s_removed_events += event_type->queued;
+  event_type->queued = 0;
+  event_type->generation++;
+
+  // Don't let removed events pile up if they're far in the future
+  if (s_removed_events > s_event_queue.size() / 2)
+    CompactEventQueue();
 }
 
 void RemoveAllEvents(EventType* event_type)
@@ -307,13 +376,14 @@ void MoveEvents()
   for (Event ev; s_ts_queue.Pop(ev);)
   {
     ev.fifo_order = s_event_fifo_id++;
-    s_event_queue.emplace_back(std::move(ev));
-    std::push_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
+    PushEvent(std::move(ev));
   }
 }
 
 void Advance()
 {
+  TRACE_SCOPE("CoreTiming::Advance");
+
   MoveEvents();
 
   int cyclesExecuted = g.slice_length - DowncountToCycles(PowerPC::ppcState.downcount);
@@ -326,9 +396,22 @@ void Advance()
 
   while (!s_event_queue.empty() && s_event_queue.front().time <= g.global_timer)
   {
-    Event evt = std::move(s_event_queue.front());
-    std::pop_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
-    s_event_queue.pop_back();
+    Event evt = PopEvent();
+    if (IsRemoved(evt))
+      continue;
+
+    if (evt.type->coalesce)
+    {
+      SkipRemovedEvents();
+      while (!s_event_queue.empty() && s_event_queue.front().time <= g.global_timer &&
+             s_event_queue.front().type == evt.type &&
+             s_event_queue.front().userdata == evt.userdata)
+      {
+        PopEvent();
+        SkipRemovedEvents();
+      }
+    }
+
     // NOTICE_LOG(POWERPC, "[Scheduler] %-20s (%lld, %lld)", evt.type->name->c_str(),
     //            g.global_timer, evt.time);
     evt.type->callback(evt.userdata, g.global_timer - evt.time);
@@ -337,6 +420,7 @@ void Advance()
   s_is_global_timer_sane = false;
 
   // Still events left (scheduled in the future)
+  SkipRemovedEvents();
   if (!s_event_queue.empty())
   {
     g.slice_length = static_cast<int>(
@@ -358,6 +442,8 @@ void LogPendingEvents()
   std::sort(clone.begin(), clone.end());
   for (const Event& ev : clone)
   {
+    if (IsRemoved(ev))
+      continue;
     INFO_LOG(POWERPC, "PENDING: Now: %" PRId64 " Pending: %" PRId64 " Type: %s", g.global_timer,
              ev.time, ev.type->name->c_str());
   }
@@ -384,6 +470,7 @@ void Idle()
   }
 
   s_idled_cycles += DowncountToCycles(PowerPC::ppcState.downcount);
+  s_idle_count++;
   PowerPC::ppcState.downcount = 0;
 }
 
@@ -396,6 +483,8 @@ std::string GetScheduledEventsSummary()
   std::sort(clone.begin(), clone.end());
   for (const Event& ev : clone)
   {
+    if (IsRemoved(ev))
+      continue;
     text += fmt::format("{} : {} {:016x}\n", *ev.type->name, ev.time, ev.userdata);
   }
   return text;
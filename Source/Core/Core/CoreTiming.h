@@ -46,6 +46,8 @@ typedef void (*TimedCallback)(u64 userdata, s64 cyclesLate);
 // doing something evil
 u64 GetTicks();
 u64 GetIdleTicks();
+// Number of times an idle loop was skipped. Not part of savestates.
+u64 GetIdleCount();
 
 void DoState(PointerWrap& p);
 
@@ -53,7 +55,9 @@ struct EventType;
 
 // Returns the event_type identifier. if name is not unique, an existing event_type will be
 // discarded.
-EventType* RegisterEvent(const std::string& name, TimedCallback callback);
+// When coalesce is set, events of this type that come due back to back with the same userdata only
+// run the callback once. That's only correct for callbacks that just bring some state up to date.
+EventType* RegisterEvent(const std::string& name, TimedCallback callback, bool coalesce = false);
 void UnregisterAllEvents();
 
 enum class FromThread
@@ -161,6 +161,69 @@ u16 Accelerator::Read(const s16* coefs)
   return val;
 }
 
+u32 Accelerator::ReadSamples(const s16* coefs, s16* samples, u32 count)
+{
+  u32 read = 0;
+  while (read < count)
+  {
+    // Within an ADPCM frame, nothing but the decoded value changes from one read to the next until
+    // the next frame header or the end address, so that part can be decoded in one go. The read
+    // that reaches one of those goes through Read() to handle it.
+    if (m_sample_format == 0x00 && !m_reads_stopped && m_current_address + 1 < m_end_address)
+    {
+      const u32 to_frame_end = 15 - (m_current_address & 15);
+      const u32 to_end = m_end_address - 1 - (m_current_address + 1);
+      const u32 run = std::min({count - read, to_frame_end, to_end});
+      if (run != 0)
+      {
+        DecodeADPCMRun(coefs, samples + read, run);
+        read += run;
+        continue;
+      }
+    }
+
+    samples[read++] = static_cast<s16>(Read(coefs));
+    if (m_reads_stopped)
+      break;
+  }
+
+  return read;
+}
+
+void Accelerator::DecodeADPCMRun(const s16* coefs, s16* samples, u32 count)
+{
+  const int scale = 1 << (m_pred_scale & 0xF);
+  const int coef_idx = (m_pred_scale >> 4) & 0x7;
+  const s32 coef1 = coefs[coef_idx * 2 + 0];
+  const s32 coef2 = coefs[coef_idx * 2 + 1];
+
+  s32 yn1 = m_yn1;
+  s32 yn2 = m_yn2;
+  u32 address = m_current_address;
+  u8 byte = ReadMemory(address >> 1);
+  for (u32 i = 0; i < count; i++)
+  {
+    int temp = (address & 1) ? (byte & 0xF) : (byte >> 4);
+    if (temp >= 8)
+      temp -= 16;
+
+    const s32 val32 = (scale * temp) + ((0x400 + coef1 * yn1 + coef2 * yn2) >> 11);
+    yn2 = yn1;
+    yn1 = std::clamp<s32>(val32, -0x7FFF, 0x7FFF);
+    samples[i] = static_cast<s16>(yn1);
+
+    // Runs never cross a frame header, so the next byte only needs to be read every two nibbles.
+    if (++address & 1)
+      continue;
+    if (i + 1 < count)
+      byte = ReadMemory(address >> 1);
+  }
+
+  m_yn1 = static_cast<s16>(yn1);
+  m_yn2 = static_cast<s16>(yn2);
+  SetCurrentAddress(address);
+}
+
 void Accelerator::DoState(PointerWrap& p)
 {
   p.Do(m_start_address);
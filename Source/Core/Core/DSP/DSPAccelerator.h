@@ -16,6 +16,10 @@ public:
   virtual ~Accelerator() = default;
 
   u16 Read(const s16* coefs);
+  // Reads up to count samples like repeated calls to Read() would, but stops right after a read
+  // raised the end exception, so that the caller can react to it. Returns the number of samples
+  // read.
+  u32 ReadSamples(const s16* coefs, s16* samples, u32 count);
   // Zelda ucode reads ARAM through 0xffd3.
   u16 ReadD3();
   void WriteD3(u16 value);
@@ -42,6 +46,9 @@ protected:
   virtual u8 ReadMemory(u32 address) = 0;
   virtual void WriteMemory(u32 address, u8 value) = 0;
 
+  // Decodes a run of ADPCM samples that can't reach a frame header or the end address.
+  void DecodeADPCMRun(const s16* coefs, s16* samples, u32 count);
+
   // DSP accelerator registers.
   u32 m_start_address = 0;
   u32 m_end_address = 0;
@@ -9,6 +9,7 @@
 
 #include "Common/Logging/Log.h"
 
+#include "Core/DSP/DSPCore.h"
 #include "Core/DSP/DSPMemoryMap.h"
 #include "Core/DSP/DSPTables.h"
 
@@ -67,6 +68,90 @@ constexpr u16 idle_skip_sigs[NUM_IDLE_SIGS][MAX_IDLE_SIG_SIZE + 1] = {
      0x0295, 0xFFFF,  // JZ    0x????
      0, 0}};
 
+// Besides the signatures above, any short loop that only polls hardware registers and tests what
+// it read is detected. Every iteration of such a loop does exactly the same thing until the CPU,
+// a DMA or the accelerator changes one of the registers, and none of those can happen while the
+// DSP is running its slice.
+constexpr u16 MAX_IDLE_LOOP_SIZE = 8;
+
+// Hardware registers that can be read without side effects. Reading the low half of a mailbox
+// clears it, and reading the accelerator advances it, so loops that read those aren't idle.
+bool IsIdlePollRegister(u16 addr)
+{
+  switch (addr)
+  {
+  case 0xff00 | DSP_DSCR:
+  case 0xff00 | DSP_ACCAH:
+  case 0xff00 | DSP_ACCAL:
+  case 0xff00 | DSP_DMBH:
+  case 0xff00 | DSP_CMBH:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Returns whether the instruction at addr can be part of an idle loop, and sets polls_hardware
+// if it reads one of the registers above.
+bool IsIdleLoopInstruction(u16 addr, bool* polls_hardware)
+{
+  const UDSPInstruction inst = dsp_imem_read(addr);
+
+  // LR $D, @M. Loading the stack registers or $sr has side effects of its own.
+  if ((inst & 0xffe0) == 0x00c0)
+  {
+    const u16 reg = inst & 0x1f;
+    if (reg == DSP_REG_SR || (reg >= DSP_REG_ST0 && reg <= DSP_REG_ST3))
+      return false;
+    if (!IsIdlePollRegister(dsp_imem_read(static_cast<u16>(addr + 1))))
+      return false;
+    *polls_hardware = true;
+    return true;
+  }
+
+  // LRS $(D+24), @M. Like the signatures, this assumes that $cr points at the hardware registers.
+  if ((inst & 0xf800) == 0x2000)
+  {
+    if (!IsIdlePollRegister(0xff00 | (inst & 0xff)))
+      return false;
+    *polls_hardware = true;
+    return true;
+  }
+
+  // ANDF, ANDCF, CMPI and CMPIS only update $sr.
+  if ((inst & 0xfeff) == 0x02a0 || (inst & 0xfeff) == 0x02c0 || (inst & 0xfeff) == 0x0280 ||
+      (inst & 0xfe00) == 0x0600)
+  {
+    return true;
+  }
+
+  // TST and TSTAXH, as long as their extension is a NOP.
+  if (((inst & 0xf700) == 0xb100 || (inst & 0xfe00) == 0x8600) && (inst & 0xff) == 0)
+    return true;
+
+  return false;
+}
+
+// Checks if the conditional jump at branch_addr closes an idle loop starting at loop_start.
+bool IsIdleLoop(u16 loop_start, u16 branch_addr)
+{
+  if (loop_start >= branch_addr || branch_addr - loop_start > MAX_IDLE_LOOP_SIZE)
+    return false;
+
+  bool polls_hardware = false;
+  for (u16 addr = loop_start; addr < branch_addr;)
+  {
+    const u8 flags = code_flags[addr];
+    if (!(flags & CODE_START_OF_INST) || (flags & (CODE_LOOP_START | CODE_LOOP_END)))
+      return false;
+    if (!IsIdleLoopInstruction(addr, &polls_hardware))
+      return false;
+    addr += GetOpTemplate(dsp_imem_read(addr))->size;
+  }
+
+  return polls_hardware && !(code_flags[branch_addr] & CODE_LOOP_END);
+}
+
 void Reset()
 {
   code_flags.fill(0);
@@ -149,6 +234,21 @@ void AnalyzeRange(u16 start_addr, u16 end_addr)
       }
     }
   }
+
+  for (u16 addr = start_addr; addr < end_addr; addr++)
+  {
+    // Jcc with a condition, looping back to a short polling loop.
+    const UDSPInstruction inst = dsp_imem_read(addr);
+    if (!(code_flags[addr] & CODE_START_OF_INST) || (inst & 0xfff0) != 0x0290 || inst == 0x029f)
+      continue;
+
+    const u16 loop_start = dsp_imem_read(static_cast<u16>(addr + 1));
+    if (!(code_flags[loop_start] & CODE_IDLE_SKIP) && IsIdleLoop(loop_start, addr))
+    {
+      INFO_LOG(DSPLLE, "Idle loop found at %02x", loop_start);
+      code_flags[loop_start] |= CODE_IDLE_SKIP;
+    }
+  }
   INFO_LOG(DSPLLE, "Finished analysis.");
 }
 }  // Anonymous namespace
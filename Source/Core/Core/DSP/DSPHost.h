@@ -17,8 +17,10 @@ namespace DSP::Host
 {
 u8 ReadHostMemory(u32 addr);
 void WriteHostMemory(u8 value, u32 addr);
+// Called before DMA with the host's memory, which may have to wait for the host when the DSP
+// doesn't run on the host's thread.
+void WaitForMemoryAccess();
 void OSD_AddMessage(std::string str, u32 ms);
-bool OnThread();
 bool IsWiiHost();
 void InterruptRequest();
 void CodeLoaded(const u8* ptr, int size);
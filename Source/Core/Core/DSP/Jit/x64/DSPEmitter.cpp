@@ -16,7 +16,6 @@
 
 #include "Core/DSP/DSPAnalyzer.h"
 #include "Core/DSP/DSPCore.h"
-#include "Core/DSP/DSPHost.h"
 #include "Core/DSP/DSPMemoryMap.h"
 #include "Core/DSP/DSPTables.h"
 #include "Core/DSP/Interpreter/DSPIntTables.h"
@@ -28,7 +27,6 @@ namespace DSP::JIT::x64
 {
 constexpr size_t COMPILED_CODE_SIZE = 2097152;
 constexpr size_t MAX_BLOCK_SIZE = 250;
-constexpr u16 DSP_IDLE_SKIP_CYCLES = 0x1000;
 
 DSPEmitter::DSPEmitter()
     : m_compile_status_register{SR_INT_ENABLE | SR_EXT_INT_ENABLE}, m_blocks(MAX_BLOCKS),
@@ -265,14 +263,7 @@ void DSPEmitter::Compile(u16 start_addr)
       DSPJitRegCache c(m_gpr);
       HandleLoop();
       m_gpr.SaveRegs();
-      if (!Host::OnThread() && Analyzer::GetCodeFlags(start_addr) & Analyzer::CODE_IDLE_SKIP)
-      {
-        MOV(16, R(EAX), Imm16(DSP_IDLE_SKIP_CYCLES));
-      }
-      else
-      {
-        MOV(16, R(EAX), Imm16(m_block_size[start_addr]));
-      }
+      MOV(16, R(EAX), Imm16(m_block_size[start_addr]));
       JMP(m_return_dispatcher, true);
       m_gpr.LoadRegs(false);
       m_gpr.FlushRegs(c, false);
@@ -301,14 +292,7 @@ void DSPEmitter::Compile(u16 start_addr)
         DSPJitRegCache c(m_gpr);
         // don't update g_dsp.pc -- the branch insn already did
         m_gpr.SaveRegs();
-        if (!Host::OnThread() && Analyzer::GetCodeFlags(start_addr) & Analyzer::CODE_IDLE_SKIP)
-        {
-          MOV(16, R(EAX), Imm16(DSP_IDLE_SKIP_CYCLES));
-        }
-        else
-        {
-          MOV(16, R(EAX), Imm16(m_block_size[start_addr]));
-        }
+        MOV(16, R(EAX), Imm16(m_block_size[start_addr]));
         JMP(m_return_dispatcher, true);
         m_gpr.LoadRegs(false);
         m_gpr.FlushRegs(c, false);
@@ -364,14 +348,7 @@ void DSPEmitter::Compile(u16 start_addr)
   }
 
   m_gpr.SaveRegs();
-  if (!Host::OnThread() && Analyzer::GetCodeFlags(start_addr) & Analyzer::CODE_IDLE_SKIP)
-  {
-    MOV(16, R(EAX), Imm16(DSP_IDLE_SKIP_CYCLES));
-  }
-  else
-  {
-    MOV(16, R(EAX), Imm16(m_block_size[start_addr]));
-  }
+  MOV(16, R(EAX), Imm16(m_block_size[start_addr]));
   JMP(m_return_dispatcher, true);
 }
 
@@ -418,13 +395,6 @@ void DSPEmitter::CompileDispatcher()
 
   const u8* dispatcherLoop = GetCodePtr();
 
-  FixupBranch exceptionExit;
-  if (Host::OnThread())
-  {
-    CMP(8, M_SDSP_external_interrupt_waiting(), Imm8(0));
-    exceptionExit = J_CC(CC_NE);
-  }
-
   // Check for DSP halt
   TEST(8, M_SDSP_cr(), Imm8(CR_HALT));
   FixupBranch _halt = J_CC(CC_NE);
@@ -444,10 +414,6 @@ void DSPEmitter::CompileDispatcher()
 
   // DSP gave up the remaining cycles.
   SetJumpTarget(_halt);
-  if (Host::OnThread())
-  {
-    SetJumpTarget(exceptionExit);
-  }
   // MOV(32, M(&cyclesLeft), Imm32(0));
   ABI_PopRegistersAndAdjustStack(registers_used, 8);
   RET();
@@ -468,11 +434,6 @@ Gen::OpArg DSPEmitter::M_SDSP_cr()
   return MDisp(R15, static_cast<int>(offsetof(SDSP, cr)));
 }
 
-Gen::OpArg DSPEmitter::M_SDSP_external_interrupt_waiting()
-{
-  return MDisp(R15, static_cast<int>(offsetof(SDSP, external_interrupt_waiting)));
-}
-
 Gen::OpArg DSPEmitter::M_SDSP_r_st(size_t index)
 {
   return MDisp(R15, static_cast<int>(offsetof(SDSP, r.st[index])));
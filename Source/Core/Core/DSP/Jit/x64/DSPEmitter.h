@@ -193,6 +193,10 @@ private:
   using DSPCompiledCode = u32 (*)();
   using Block = const u8*;
 
+  // Cycles reported when an idle loop branches back to itself, which gives up the rest of the
+  // slice.
+  static constexpr u16 DSP_IDLE_SKIP_CYCLES = 0x1000;
+
   // The emitter emits calls to this function. It's present here
   // within the class itself to allow access to member variables.
   static void CompileCurrent(DSPEmitter& emitter);
@@ -208,8 +212,14 @@ private:
 
   void FallBackToInterpreter(UDSPInstruction inst);
 
-  void WriteBranchExit();
-  void WriteBlockLink(u16 dest);
+  // Whether a branch to dest is the back edge of an idle loop the analyzer found at the start of
+  // the current block.
+  bool IsIdleLoopBranch(u16 dest) const;
+  void WriteBranchExit(bool idle_loop = false);
+  // Conditional branches pass wait_for_dest as false and only link to blocks that are already
+  // compiled. A block isn't linkable while it waits on another one, so waiting on the targets of
+  // loops would leave both blocks unlinkable, and CompileCurrent would never stop retrying them.
+  void WriteBlockLink(u16 dest, bool wait_for_dest);
 
   void ReJitConditional(UDSPInstruction opc, void (DSPEmitter::*conditional_fn)(UDSPInstruction));
   void r_jcc(UDSPInstruction opc);
@@ -281,7 +291,6 @@ private:
   Gen::OpArg M_SDSP_pc();
   Gen::OpArg M_SDSP_exceptions();
   Gen::OpArg M_SDSP_cr();
-  Gen::OpArg M_SDSP_external_interrupt_waiting();
   Gen::OpArg M_SDSP_r_st(size_t index);
   Gen::OpArg M_SDSP_reg_stack_ptrs(size_t index);
 
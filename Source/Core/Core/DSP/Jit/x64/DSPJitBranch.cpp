@@ -79,61 +79,72 @@ void DSPEmitter::ReJitConditional(const UDSPInstruction opc,
   SetJumpTarget(skip_code);
 }
 
-void DSPEmitter::WriteBranchExit()
+bool DSPEmitter::IsIdleLoopBranch(u16 dest) const
+{
+  return dest == m_start_address &&
+         (Analyzer::GetCodeFlags(m_start_address) & Analyzer::CODE_IDLE_SKIP);
+}
+
+void DSPEmitter::WriteBranchExit(bool idle_loop)
 {
   DSPJitRegCache c(m_gpr);
   m_gpr.SaveRegs();
-  if (Analyzer::GetCodeFlags(m_start_address) & Analyzer::CODE_IDLE_SKIP)
-  {
-    MOV(16, R(EAX), Imm16(0x1000));
-  }
-  else
-  {
-    MOV(16, R(EAX), Imm16(m_block_size[m_start_address]));
-  }
+  MOV(16, R(EAX), Imm16(idle_loop ? DSP_IDLE_SKIP_CYCLES : m_block_size[m_start_address]));
   JMP(m_return_dispatcher, true);
   m_gpr.LoadRegs(false);
   m_gpr.FlushRegs(c, false);
 }
 
-void DSPEmitter::WriteBlockLink(u16 dest)
+void DSPEmitter::WriteBlockLink(u16 dest, bool wait_for_dest)
 {
+  // A block can loop back to its own start, which is where the link entry is, as long as the loop
+  // is charged for at least one instruction. Other addresses inside the current block don't have
+  // an entry point.
+  const bool is_self_link = dest == m_start_address;
+  if (is_self_link && m_block_size[m_start_address] == 0)
+    return;
+  if (!is_self_link && dest >= m_start_address && dest <= m_compile_pc)
+    return;
+
   // Jump directly to the called block if it has already been compiled.
-  if (!(dest >= m_start_address && dest <= m_compile_pc))
+  const Block link = is_self_link ? m_block_link_entry : m_block_links[dest];
+  if (link != nullptr)
   {
-    if (m_block_links[dest] != nullptr)
-    {
-      m_gpr.FlushRegs();
-      // Check if we have enough cycles to execute the next block
-      MOV(64, R(RAX), ImmPtr(&m_cycles_left));
-      MOV(16, R(ECX), MatR(RAX));
-      CMP(16, R(ECX), Imm16(m_block_size[m_start_address] + m_block_size[dest]));
-      FixupBranch notEnoughCycles = J_CC(CC_BE);
-
-      SUB(16, R(ECX), Imm16(m_block_size[m_start_address]));
-      MOV(16, MatR(RAX), R(ECX));
-      JMP(m_block_links[dest], true);
-      SetJumpTarget(notEnoughCycles);
-    }
-    else
-    {
-      // The destination has not been compiled yet.  Add it to the list
-      // of blocks that this block is waiting on.
-      m_unresolved_jumps[m_start_address].push_back(dest);
-    }
+    // The block isn't finished yet, so another iteration is assumed to take as long as this one.
+    const u16 dest_size = is_self_link ? m_block_size[m_start_address] : m_block_size[dest];
+
+    m_gpr.FlushRegs();
+    // Check if we have enough cycles to execute the next block
+    MOV(64, R(RAX), ImmPtr(&m_cycles_left));
+    MOV(16, R(ECX), MatR(RAX));
+    CMP(16, R(ECX), Imm16(m_block_size[m_start_address] + dest_size));
+    FixupBranch notEnoughCycles = J_CC(CC_BE);
+
+    SUB(16, R(ECX), Imm16(m_block_size[m_start_address]));
+    MOV(16, MatR(RAX), R(ECX));
+    JMP(link, true);
+    SetJumpTarget(notEnoughCycles);
+  }
+  else if (wait_for_dest)
+  {
+    // The destination has not been compiled yet.  Add it to the list
+    // of blocks that this block is waiting on.
+    m_unresolved_jumps[m_start_address].push_back(dest);
   }
 }
 
 void DSPEmitter::r_jcc(const UDSPInstruction opc)
 {
-  u16 dest = dsp_imem_read(m_compile_pc + 1);
+  const u16 dest = dsp_imem_read(m_compile_pc + 1);
   const DSPOPCTemplate* opcode = GetOpTemplate(opc);
 
-  // If the block is unconditional, attempt to link block
-  if (opcode->uncond_branch)
-    WriteBlockLink(dest);
+  // Static targets are linked whether or not the branch is conditional, since this is only reached
+  // when it is taken. The back edge of an idle loop exits instead, to give up the slice.
+  const bool idle_loop = IsIdleLoopBranch(dest);
+  if (!idle_loop)
+    WriteBlockLink(dest, opcode->uncond_branch);
   MOV(16, M_SDSP_pc(), Imm16(dest));
-  WriteBranchExit();
+  WriteBranchExit(idle_loop);
 }
 // Generic jmp implementation
 // Jcc addressA
@@ -172,12 +183,10 @@ void DSPEmitter::r_call(const UDSPInstruction opc)
 {
   MOV(16, R(DX), Imm16(m_compile_pc + 2));
   dsp_reg_store_stack(StackRegister::Call);
-  u16 dest = dsp_imem_read(m_compile_pc + 1);
+  const u16 dest = dsp_imem_read(m_compile_pc + 1);
   const DSPOPCTemplate* opcode = GetOpTemplate(opc);
 
-  // If the block is unconditional, attempt to link block
-  if (opcode->uncond_branch)
-    WriteBlockLink(dest);
+  WriteBlockLink(dest, opcode->uncond_branch);
   MOV(16, M_SDSP_pc(), Imm16(dest));
   WriteBranchExit();
 }
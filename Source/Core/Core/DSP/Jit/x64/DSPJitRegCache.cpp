@@ -88,6 +88,9 @@ static Gen::OpArg GetRegisterPointer(size_t reg)
   }
 }
 
+// Keeps the 40-bit accumulators and the product register in host registers for whole blocks, since
+// almost all of the DSP's arithmetic reads or writes them. They are only written back around ABI
+// calls and at block exits, and only when dirty.
 #define STATIC_REG_ACCS
 //#undef STATIC_REG_ACCS
 
@@ -115,13 +118,14 @@ DSPJitRegCache::DSPJitRegCache(DSPEmitter& emitter)
   m_xregs[RDI].guest_reg = DSP_REG_NONE;
 
 #ifdef STATIC_REG_ACCS
-  m_xregs[R8].guest_reg = DSP_REG_STATIC;  // acc0
-  m_xregs[R9].guest_reg = DSP_REG_STATIC;  // acc1
+  m_xregs[R8].guest_reg = DSP_REG_STATIC;   // acc0
+  m_xregs[R9].guest_reg = DSP_REG_STATIC;   // acc1
+  m_xregs[R10].guest_reg = DSP_REG_STATIC;  // prod
 #else
   m_xregs[R8].guest_reg = DSP_REG_NONE;
   m_xregs[R9].guest_reg = DSP_REG_NONE;
-#endif
   m_xregs[R10].guest_reg = DSP_REG_NONE;
+#endif
   m_xregs[R11].guest_reg = DSP_REG_NONE;
   m_xregs[R12].guest_reg = DSP_REG_NONE;
   m_xregs[R13].guest_reg = DSP_REG_NONE;
@@ -149,6 +153,7 @@ DSPJitRegCache::DSPJitRegCache(DSPEmitter& emitter)
 #ifdef STATIC_REG_ACCS
   m_regs[DSP_REG_ACC0_64].host_reg = R8;
   m_regs[DSP_REG_ACC1_64].host_reg = R9;
+  m_regs[DSP_REG_PROD_64].host_reg = R10;
 #endif
   for (unsigned int i = 0; i < 2; i++)
   {
@@ -362,11 +367,12 @@ void DSPJitRegCache::FlushRegs()
 #ifdef STATIC_REG_ACCS
   ASSERT_MSG(DSPLLE, m_xregs[R8].guest_reg == DSP_REG_STATIC, "wrong xreg state for %d", R8);
   ASSERT_MSG(DSPLLE, m_xregs[R9].guest_reg == DSP_REG_STATIC, "wrong xreg state for %d", R9);
+  ASSERT_MSG(DSPLLE, m_xregs[R10].guest_reg == DSP_REG_STATIC, "wrong xreg state for %d", R10);
 #else
   ASSERT_MSG(DSPLLE, m_xregs[R8].guest_reg == DSP_REG_NONE, "wrong xreg state for %d", R8);
   ASSERT_MSG(DSPLLE, m_xregs[R9].guest_reg == DSP_REG_NONE, "wrong xreg state for %d", R9);
-#endif
   ASSERT_MSG(DSPLLE, m_xregs[R10].guest_reg == DSP_REG_NONE, "wrong xreg state for %d", R10);
+#endif
   ASSERT_MSG(DSPLLE, m_xregs[R11].guest_reg == DSP_REG_NONE, "wrong xreg state for %d", R11);
   ASSERT_MSG(DSPLLE, m_xregs[R12].guest_reg == DSP_REG_NONE, "wrong xreg state for %d", R12);
   ASSERT_MSG(DSPLLE, m_xregs[R13].guest_reg == DSP_REG_NONE, "wrong xreg state for %d", R13);
@@ -8,9 +8,15 @@
 #include <cstring>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include <xxhash.h>
+#include <zstd.h>
+
+#include "Common/Assert.h"
 #include "Common/File.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/HW/Memmap.h"
@@ -18,13 +24,17 @@
 enum
 {
   FILE_ID = 0x0d01f1f0,
-  VERSION_NUMBER = 5,
-  MIN_LOADER_VERSION = 1,
-  // This value is only used if the DFF file was created with overridden RAM sizes.
-  // If the MIN_LOADER_VERSION ever exceeds this, it's alright to remove it.
-  MIN_LOADER_VERSION_FOR_RAM_OVERRIDE = 5,
+  VERSION_NUMBER = 6,
+  // Version 6 stores frames as compressed chunks, which older loaders can't read
+  MIN_LOADER_VERSION = 6,
 };
 
+constexpr int COMPRESSION_LEVEL = 3;
+
+// Number of decompressed frames that are kept around, so that the player and the analyzer can
+// look at the same frames without decompressing them again
+constexpr size_t FRAME_CACHE_SIZE = 4;
+
 #pragma pack(push, 1)
 
 struct FileHeader
@@ -49,7 +59,10 @@ struct FileHeader
   // will crash and burn with mismatched settings.  See PR #8722.
   u32 mem1_size;
   u32 mem2_size;
-  u8 reserved[32];
+  // Added in version 6, where the frame list holds FileCompressedFrameInfo instead
+  u64 memoryBlobListOffset;
+  u32 memoryBlobCount;
+  u8 reserved[20];
 };
 static_assert(sizeof(FileHeader) == 128, "FileHeader should be 128 bytes");
 
@@ -76,6 +89,43 @@ struct FileMemoryUpdate
 };
 static_assert(sizeof(FileMemoryUpdate) == 24, "FileMemoryUpdate should be 24 bytes");
 
+// Each frame is a zstd-compressed chunk holding the FIFO data, followed by the frame's memory
+// updates as FileChunkMemoryUpdate
+struct FileCompressedFrameInfo
+{
+  u64 chunkOffset;
+  u32 chunkCompressedSize;
+  u32 chunkSize;
+  u32 fifoStart;
+  u32 fifoEnd;
+  u32 fifoDataSize;
+  u32 numMemoryUpdates;
+  // Total size of the data of the frame's memory updates
+  u64 memoryUpdatesSize;
+  u8 reserved[24];
+};
+static_assert(sizeof(FileCompressedFrameInfo) == 64, "FileCompressedFrameInfo should be 64 bytes");
+
+struct FileChunkMemoryUpdate
+{
+  u32 fifoPosition;
+  u32 address;
+  u32 blobIndex;
+  u8 type;
+  u8 reserved[3];
+};
+static_assert(sizeof(FileChunkMemoryUpdate) == 16, "FileChunkMemoryUpdate should be 16 bytes");
+
+// The data of memory updates is stored once for every distinct block of data, since games upload
+// the same textures and vertices over and over. Each block is compressed on its own.
+struct FileMemoryBlob
+{
+  u64 dataOffset;
+  u32 compressedSize;
+  u32 dataSize;
+};
+static_assert(sizeof(FileMemoryBlob) == 16, "FileMemoryBlob should be 16 bytes");
+
 #pragma pack(pop)
 
 FifoDataFile::FifoDataFile() = default;
@@ -104,7 +154,107 @@ bool FifoDataFile::GetIsWii() const
 
 void FifoDataFile::AddFrame(const FifoFrameInfo& frameInfo)
 {
-  m_Frames.push_back(frameInfo);
+  std::lock_guard<std::mutex> guard(m_mutex);
+  ASSERT(!m_compressed_file);
+
+  if (!m_compression_context)
+    m_compression_context.reset(ZSTD_createCCtx());
+
+  std::vector<u8> chunk(frameInfo.fifoData);
+  FileCompressedFrameInfo dstFrame{};
+
+  for (const MemoryUpdate& srcUpdate : frameInfo.memoryUpdates)
+  {
+    // Memory update data is identified by its hash and size
+    const u32 dataSize = static_cast<u32>(srcUpdate.data.size());
+    const u64 hash = XXH64(srcUpdate.data.data(), srcUpdate.data.size(), 0);
+    auto blob = m_blob_indices.find(hash);
+    if (blob == m_blob_indices.end() || m_memory_blobs[blob->second].dataSize != dataSize)
+    {
+      FileMemoryBlob dstBlob;
+      dstBlob.dataSize = dataSize;
+      if (!AppendCompressed(srcUpdate.data.data(), srcUpdate.data.size(), &dstBlob.dataOffset,
+                            &dstBlob.compressedSize))
+      {
+        ERROR_LOG(VIDEO, "Failed to compress a memory update of the FIFO log");
+        return;
+      }
+
+      blob = m_blob_indices.insert_or_assign(hash, static_cast<u32>(m_memory_blobs.size())).first;
+      m_memory_blobs.push_back(dstBlob);
+    }
+
+    FileChunkMemoryUpdate dstUpdate{};
+    dstUpdate.fifoPosition = srcUpdate.fifoPosition;
+    dstUpdate.address = srcUpdate.address;
+    dstUpdate.blobIndex = blob->second;
+    dstUpdate.type = srcUpdate.type;
+
+    const u8* const updateBytes = reinterpret_cast<const u8*>(&dstUpdate);
+    chunk.insert(chunk.end(), updateBytes, updateBytes + sizeof(dstUpdate));
+    dstFrame.memoryUpdatesSize += dataSize;
+  }
+
+  dstFrame.chunkSize = static_cast<u32>(chunk.size());
+  dstFrame.fifoStart = frameInfo.fifoStart;
+  dstFrame.fifoEnd = frameInfo.fifoEnd;
+  dstFrame.fifoDataSize = static_cast<u32>(frameInfo.fifoData.size());
+  dstFrame.numMemoryUpdates = static_cast<u32>(frameInfo.memoryUpdates.size());
+  if (!AppendCompressed(chunk.data(), chunk.size(), &dstFrame.chunkOffset,
+                        &dstFrame.chunkCompressedSize))
+  {
+    ERROR_LOG(VIDEO, "Failed to compress a frame of the FIFO log");
+    return;
+  }
+
+  m_compressed_frames.push_back(dstFrame);
+}
+
+std::shared_ptr<const FifoFrameInfo> FifoDataFile::GetFrame(u32 frame) const
+{
+  std::lock_guard<std::mutex> guard(m_mutex);
+  std::shared_ptr<const FifoFrameInfo> frameInfo;
+  const auto it = std::find_if(m_frame_cache.begin(), m_frame_cache.end(),
+                               [frame](const auto& entry) { return entry.first == frame; });
+  if (it != m_frame_cache.end())
+  {
+    frameInfo = std::move(it->second);
+    m_frame_cache.erase(it);
+  }
+  else
+  {
+    frameInfo = ReadFrame(frame);
+  }
+
+  m_frame_cache.emplace(m_frame_cache.begin(), frame, frameInfo);
+  if (m_frame_cache.size() > FRAME_CACHE_SIZE)
+    m_frame_cache.pop_back();
+
+  return frameInfo;
+}
+
+u32 FifoDataFile::GetFrameCount() const
+{
+  std::lock_guard<std::mutex> guard(m_mutex);
+  return static_cast<u32>(m_compressed_frames.size());
+}
+
+u64 FifoDataFile::GetFifoDataSize() const
+{
+  std::lock_guard<std::mutex> guard(m_mutex);
+  u64 size = 0;
+  for (const FileCompressedFrameInfo& frame : m_compressed_frames)
+    size += frame.fifoDataSize;
+  return size;
+}
+
+u64 FifoDataFile::GetMemoryUpdatesSize() const
+{
+  std::lock_guard<std::mutex> guard(m_mutex);
+  u64 size = 0;
+  for (const FileCompressedFrameInfo& frame : m_compressed_frames)
+    size += frame.memoryUpdatesSize;
+  return size;
 }
 
 bool FifoDataFile::Save(const std::string& filename)
@@ -113,12 +263,15 @@ bool FifoDataFile::Save(const std::string& filename)
   if (!file.Open(filename, "wb"))
     return false;
 
+  std::lock_guard<std::mutex> guard(m_mutex);
+  const u32 frameCount = static_cast<u32>(m_compressed_frames.size());
+
   // Add space for header
   PadFile(sizeof(FileHeader), file);
 
   // Add space for frame list
   u64 frameListOffset = file.Tell();
-  PadFile(m_Frames.size() * sizeof(FileFrameInfo), file);
+  PadFile(frameCount * sizeof(FileCompressedFrameInfo), file);
 
   u64 bpMemOffset = file.Tell();
   file.WriteArray(m_BPMem, BP_MEM_SIZE);
@@ -135,15 +288,39 @@ bool FifoDataFile::Save(const std::string& filename)
   u64 texMemOffset = file.Tell();
   file.WriteArray(m_TexMem, TEX_MEM_SIZE);
 
+  // The data is already compressed, so it only needs to be copied over
+  std::vector<FileCompressedFrameInfo> frameList = m_compressed_frames;
+  std::vector<FileMemoryBlob> blobList = m_memory_blobs;
+  std::vector<u8> buffer;
+
+  for (FileMemoryBlob& blob : blobList)
+  {
+    buffer.resize(blob.compressedSize);
+    if (!ReadRaw(blob.dataOffset, blob.compressedSize, buffer.data()))
+      return false;
+
+    blob.dataOffset = file.Tell();
+    file.WriteBytes(buffer.data(), buffer.size());
+  }
+
+  for (FileCompressedFrameInfo& frame : frameList)
+  {
+    buffer.resize(frame.chunkCompressedSize);
+    if (!ReadRaw(frame.chunkOffset, frame.chunkCompressedSize, buffer.data()))
+      return false;
+
+    frame.chunkOffset = file.Tell();
+    file.WriteBytes(buffer.data(), buffer.size());
+  }
+
+  u64 memoryBlobListOffset = file.Tell();
+  file.WriteArray(blobList.data(), blobList.size());
+
   // Write header
-  FileHeader header;
+  FileHeader header{};
   header.fileId = FILE_ID;
   header.file_version = VERSION_NUMBER;
-  // Maintain backwards compatability so long as the RAM sizes aren't overridden.
-  if (Config::Get(Config::MAIN_RAM_OVERRIDE_ENABLE))
-    header.min_loader_version = MIN_LOADER_VERSION_FOR_RAM_OVERRIDE;
-  else
-    header.min_loader_version = MIN_LOADER_VERSION;
+  header.min_loader_version = MIN_LOADER_VERSION;
 
   header.bpMemOffset = bpMemOffset;
   header.bpMemSize = BP_MEM_SIZE;
@@ -161,7 +338,10 @@ bool FifoDataFile::Save(const std::string& filename)
   header.texMemSize = TEX_MEM_SIZE;
 
   header.frameListOffset = frameListOffset;
-  header.frameCount = (u32)m_Frames.size();
+  header.frameCount = frameCount;
+
+  header.memoryBlobListOffset = memoryBlobListOffset;
+  header.memoryBlobCount = static_cast<u32>(blobList.size());
 
   header.flags = m_Flags;
 
@@ -172,30 +352,8 @@ bool FifoDataFile::Save(const std::string& filename)
   file.WriteBytes(&header, sizeof(FileHeader));
 
   // Write frames list
-  for (unsigned int i = 0; i < m_Frames.size(); ++i)
-  {
-    const FifoFrameInfo& srcFrame = m_Frames[i];
-
-    // Write FIFO data
-    file.Seek(0, SEEK_END);
-    u64 dataOffset = file.Tell();
-    file.WriteBytes(srcFrame.fifoData.data(), srcFrame.fifoData.size());
-
-    u64 memoryUpdatesOffset = WriteMemoryUpdates(srcFrame.memoryUpdates, file);
-
-    FileFrameInfo dstFrame;
-    dstFrame.fifoDataSize = static_cast<u32>(srcFrame.fifoData.size());
-    dstFrame.fifoDataOffset = dataOffset;
-    dstFrame.fifoStart = srcFrame.fifoStart;
-    dstFrame.fifoEnd = srcFrame.fifoEnd;
-    dstFrame.memoryUpdatesOffset = memoryUpdatesOffset;
-    dstFrame.numMemoryUpdates = static_cast<u32>(srcFrame.memoryUpdates.size());
-
-    // Write frame info
-    u64 frameOffset = frameListOffset + (i * sizeof(FileFrameInfo));
-    file.Seek(frameOffset, SEEK_SET);
-    file.WriteBytes(&dstFrame, sizeof(FileFrameInfo));
-  }
+  file.Seek(frameListOffset, SEEK_SET);
+  file.WriteArray(frameList.data(), frameList.size());
 
   if (!file.Close())
     return false;
@@ -297,7 +455,25 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
   dataFile->m_ram_size_real = header.mem1_size;
   dataFile->m_exram_size_real = header.mem2_size;
 
-  // Read frames
+  if (dataFile->m_Version >= 6)
+  {
+    // Frames are only read when they're needed, so keep the file open
+    dataFile->m_compressed_frames.resize(header.frameCount);
+    dataFile->m_memory_blobs.resize(header.memoryBlobCount);
+    file.Seek(header.frameListOffset, SEEK_SET);
+    file.ReadArray(dataFile->m_compressed_frames.data(), header.frameCount);
+    file.Seek(header.memoryBlobListOffset, SEEK_SET);
+    if (!file.ReadArray(dataFile->m_memory_blobs.data(), header.memoryBlobCount))
+    {
+      CriticalAlertT("The frame list of the DFF is incomplete");
+      return nullptr;
+    }
+
+    dataFile->m_compressed_file = std::make_unique<File::IOFile>(std::move(file));
+    return dataFile;
+  }
+
+  // Older versions store the frames uncompressed, so compress them as they're read
   for (u32 i = 0; i < header.frameCount; ++i)
   {
     u64 frameOffset = header.frameListOffset + (i * sizeof(FileFrameInfo));
@@ -343,37 +519,6 @@ bool FifoDataFile::GetFlag(u32 flag) const
   return !!(m_Flags & flag);
 }
 
-u64 FifoDataFile::WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates,
-                                     File::IOFile& file)
-{
-  // Add space for memory update list
-  u64 updateListOffset = file.Tell();
-  PadFile(memUpdates.size() * sizeof(FileMemoryUpdate), file);
-
-  for (unsigned int i = 0; i < memUpdates.size(); ++i)
-  {
-    const MemoryUpdate& srcUpdate = memUpdates[i];
-
-    // Write memory
-    file.Seek(0, SEEK_END);
-    u64 dataOffset = file.Tell();
-    file.WriteBytes(srcUpdate.data.data(), srcUpdate.data.size());
-
-    FileMemoryUpdate dstUpdate;
-    dstUpdate.address = srcUpdate.address;
-    dstUpdate.dataOffset = dataOffset;
-    dstUpdate.dataSize = static_cast<u32>(srcUpdate.data.size());
-    dstUpdate.fifoPosition = srcUpdate.fifoPosition;
-    dstUpdate.type = srcUpdate.type;
-
-    u64 updateOffset = updateListOffset + (i * sizeof(FileMemoryUpdate));
-    file.Seek(updateOffset, SEEK_SET);
-    file.WriteBytes(&dstUpdate, sizeof(FileMemoryUpdate));
-  }
-
-  return updateListOffset;
-}
-
 void FifoDataFile::ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
                                      std::vector<MemoryUpdate>& memUpdates, File::IOFile& file)
 {
@@ -396,3 +541,110 @@ void FifoDataFile::ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
     file.ReadBytes(dstUpdate.data.data(), srcUpdate.dataSize);
   }
 }
+
+void FifoDataFile::CompressionContextDeleter::operator()(ZSTD_CCtx* context) const
+{
+  ZSTD_freeCCtx(context);
+}
+
+bool FifoDataFile::AppendCompressed(const u8* data, size_t size, u64* offset, u32* compressedSize)
+{
+  if (!m_compression_context)
+    return false;
+
+  const size_t start = m_compressed_data.size();
+  m_compressed_data.resize(start + ZSTD_compressBound(size));
+  const size_t result =
+      ZSTD_compressCCtx(m_compression_context.get(), &m_compressed_data[start],
+                        m_compressed_data.size() - start, data, size, COMPRESSION_LEVEL);
+  if (ZSTD_isError(result))
+  {
+    m_compressed_data.resize(start);
+    return false;
+  }
+
+  m_compressed_data.resize(start + result);
+  *offset = start;
+  *compressedSize = static_cast<u32>(result);
+  return true;
+}
+
+bool FifoDataFile::ReadRaw(u64 offset, u32 size, u8* data) const
+{
+  if (!m_compressed_file)
+  {
+    if (offset + size > m_compressed_data.size())
+      return false;
+
+    std::memcpy(data, &m_compressed_data[offset], size);
+    return true;
+  }
+
+  if (!m_compressed_file->Seek(offset, SEEK_SET) || !m_compressed_file->ReadBytes(data, size))
+  {
+    // Don't let one bad read fail all the following ones
+    m_compressed_file->Clear();
+    return false;
+  }
+
+  return true;
+}
+
+bool FifoDataFile::ReadCompressed(u64 offset, u32 compressedSize, std::vector<u8>& buffer,
+                                  std::vector<u8>* data) const
+{
+  buffer.resize(compressedSize);
+  if (!ReadRaw(offset, compressedSize, buffer.data()))
+    return false;
+
+  const size_t result = ZSTD_decompress(data->data(), data->size(), buffer.data(), buffer.size());
+  return !ZSTD_isError(result) && result == data->size();
+}
+
+std::shared_ptr<const FifoFrameInfo> FifoDataFile::ReadFrame(u32 frame) const
+{
+  const FileCompressedFrameInfo& srcFrame = m_compressed_frames[frame];
+
+  auto dstFrame = std::make_shared<FifoFrameInfo>();
+  dstFrame->fifoStart = srcFrame.fifoStart;
+  dstFrame->fifoEnd = srcFrame.fifoEnd;
+
+  const u64 updatesSize = u64(srcFrame.numMemoryUpdates) * sizeof(FileChunkMemoryUpdate);
+  std::vector<u8> chunk(srcFrame.chunkSize);
+  std::vector<u8> buffer;
+  if (srcFrame.fifoDataSize + updatesSize != srcFrame.chunkSize ||
+      !ReadCompressed(srcFrame.chunkOffset, srcFrame.chunkCompressedSize, buffer, &chunk))
+  {
+    ERROR_LOG(VIDEO, "Failed to read frame %u of the FIFO log", frame);
+    return dstFrame;
+  }
+
+  dstFrame->fifoData.assign(chunk.begin(), chunk.begin() + srcFrame.fifoDataSize);
+  dstFrame->memoryUpdates.resize(srcFrame.numMemoryUpdates);
+  for (u32 i = 0; i < srcFrame.numMemoryUpdates; ++i)
+  {
+    FileChunkMemoryUpdate srcUpdate;
+    std::memcpy(&srcUpdate, &chunk[srcFrame.fifoDataSize + i * sizeof(FileChunkMemoryUpdate)],
+                sizeof(srcUpdate));
+
+    MemoryUpdate& dstUpdate = dstFrame->memoryUpdates[i];
+    dstUpdate.address = srcUpdate.address;
+    dstUpdate.fifoPosition = srcUpdate.fifoPosition;
+    dstUpdate.type = static_cast<MemoryUpdate::Type>(srcUpdate.type);
+
+    if (srcUpdate.blobIndex >= m_memory_blobs.size())
+    {
+      ERROR_LOG(VIDEO, "Invalid memory update in frame %u of the FIFO log", frame);
+      continue;
+    }
+
+    const FileMemoryBlob& blob = m_memory_blobs[srcUpdate.blobIndex];
+    dstUpdate.data.resize(blob.dataSize);
+    if (!ReadCompressed(blob.dataOffset, blob.compressedSize, buffer, &dstUpdate.data))
+    {
+      ERROR_LOG(VIDEO, "Failed to read a memory update in frame %u of the FIFO log", frame);
+    }
+  }
+
+  return dstFrame;
+}
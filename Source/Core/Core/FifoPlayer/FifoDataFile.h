@@ -5,7 +5,10 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -16,6 +19,10 @@ namespace File
 class IOFile;
 }
 
+struct FileCompressedFrameInfo;
+struct FileMemoryBlob;
+struct ZSTD_CCtx_s;
+
 struct MemoryUpdate
 {
   enum Type
@@ -72,9 +79,15 @@ public:
   u32 GetRamSizeReal() { return m_ram_size_real; }
   u32 GetExRamSizeReal() { return m_exram_size_real; }
 
+  // Frames are compressed as they're added, and decompressed again when requested, so hold on to
+  // the returned frame for as long as it's used instead of calling GetFrame() again. All of these
+  // can be called from any thread.
   void AddFrame(const FifoFrameInfo& frameInfo);
-  const FifoFrameInfo& GetFrame(u32 frame) const { return m_Frames[frame]; }
-  u32 GetFrameCount() const { return static_cast<u32>(m_Frames.size()); }
+  std::shared_ptr<const FifoFrameInfo> GetFrame(u32 frame) const;
+  u32 GetFrameCount() const;
+  // Totals over all frames, without decompressing them
+  u64 GetFifoDataSize() const;
+  u64 GetMemoryUpdatesSize() const;
   bool Save(const std::string& filename);
 
   static std::unique_ptr<FifoDataFile> Load(const std::string& filename, bool flagsOnly);
@@ -90,10 +103,21 @@ private:
   void SetFlag(u32 flag, bool set);
   bool GetFlag(u32 flag) const;
 
-  u64 WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
   static void ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
                                 std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
 
+  struct CompressionContextDeleter
+  {
+    void operator()(ZSTD_CCtx_s* context) const;
+  };
+
+  // These expect m_mutex to be held
+  bool AppendCompressed(const u8* data, size_t size, u64* offset, u32* compressedSize);
+  bool ReadRaw(u64 offset, u32 size, u8* data) const;
+  bool ReadCompressed(u64 offset, u32 compressedSize, std::vector<u8>& buffer,
+                      std::vector<u8>* data) const;
+  std::shared_ptr<const FifoFrameInfo> ReadFrame(u32 frame) const;
+
   u32 m_BPMem[BP_MEM_SIZE];
   u32 m_CPMem[CP_MEM_SIZE];
   u32 m_XFMem[XF_MEM_SIZE];
@@ -105,5 +129,18 @@ private:
   u32 m_Flags = 0;
   u32 m_Version = 0;
 
-  std::vector<FifoFrameInfo> m_Frames;
+  mutable std::mutex m_mutex;
+
+  std::vector<FileCompressedFrameInfo> m_compressed_frames;
+  std::vector<FileMemoryBlob> m_memory_blobs;
+  // Version 6 files stay open, and the compressed data is read from them. Otherwise it lives in
+  // m_compressed_data, where frames are compressed to as they're added.
+  std::unique_ptr<File::IOFile> m_compressed_file;
+  std::vector<u8> m_compressed_data;
+  std::unique_ptr<ZSTD_CCtx_s, CompressionContextDeleter> m_compression_context;
+  // Memory blobs by the hash of their data
+  std::unordered_map<u64, u32> m_blob_indices;
+
+  // The last few frames that were decompressed, most recent first
+  mutable std::vector<std::pair<u32, std::shared_ptr<const FifoFrameInfo>>> m_frame_cache;
 };
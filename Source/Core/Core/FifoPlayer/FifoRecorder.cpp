@@ -18,10 +18,28 @@ static FifoRecorder instance;
 
 FifoRecorder::FifoRecorder() = default;
 
+FifoRecorder::~FifoRecorder()
+{
+  if (!m_frame_worker.joinable())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lk(m_frame_queue_mutex);
+    m_stop_frame_worker = true;
+  }
+  m_frame_queued.notify_one();
+  m_frame_worker.join();
+}
+
 void FifoRecorder::StartRecording(s32 numFrames, CallbackFunc finishedCb)
 {
   std::lock_guard<std::recursive_mutex> lk(m_mutex);
 
+  // The worker may still be adding frames from the previous recording to its file
+  WaitForFrameWorker();
+  if (!m_frame_worker.joinable())
+    m_frame_worker = std::thread(&FifoRecorder::FrameWorkerLoop, this);
+
   m_File = std::make_unique<FifoDataFile>();
 
   // TODO: This, ideally, would be deallocated when done recording.
@@ -63,7 +81,8 @@ void FifoRecorder::StopRecording()
 
 bool FifoRecorder::IsRecordingDone() const
 {
-  return m_WasRecording && m_File != nullptr;
+  std::lock_guard<std::mutex> lk(m_frame_queue_mutex);
+  return m_WasRecording && m_File != nullptr && m_frame_queue.empty() && !m_frame_worker_busy;
 }
 
 FifoDataFile* FifoRecorder::GetRecordedFile() const
@@ -94,21 +113,20 @@ void FifoRecorder::WriteGPCommand(const u8* data, u32 size)
 
   if (m_FrameEnded && !m_FifoData.empty())
   {
-    m_CurrentFrame.fifoData = m_FifoData;
+    // Hand the frame over without copying it, and start the next one with as much space
+    const size_t fifo_size = m_FifoData.size();
+    m_CurrentFrame.fifoData = std::move(m_FifoData);
 
     {
       std::lock_guard<std::recursive_mutex> lk(m_mutex);
-
-      // Copy frame to file
-      // The file will be responsible for freeing the memory allocated for each frame's fifoData
-      m_File->AddFrame(m_CurrentFrame);
-
-      if (m_FinishedCb && m_RequestedRecordingEnd)
-        m_FinishedCb();
+      QueueFrame({m_File.get(), std::move(m_CurrentFrame),
+                  m_RequestedRecordingEnd ? m_FinishedCb : nullptr});
     }
 
+    m_CurrentFrame.fifoData.clear();
     m_CurrentFrame.memoryUpdates.clear();
     m_FifoData.clear();
+    m_FifoData.reserve(fifo_size);
     m_FrameEnded = false;
   }
 
@@ -220,6 +238,54 @@ bool FifoRecorder::IsRecording() const
   return m_IsRecording;
 }
 
+void FifoRecorder::QueueFrame(PendingFrame frame)
+{
+  {
+    std::lock_guard<std::mutex> lk(m_frame_queue_mutex);
+    m_frame_queue.push_back(std::move(frame));
+  }
+  m_frame_queued.notify_one();
+}
+
+void FifoRecorder::WaitForFrameWorker()
+{
+  std::unique_lock<std::mutex> lk(m_frame_queue_mutex);
+  m_frame_queue_empty.wait(lk, [this] { return m_frame_queue.empty() && !m_frame_worker_busy; });
+}
+
+void FifoRecorder::FrameWorkerLoop()
+{
+  Common::SetCurrentThreadName("FIFO recorder");
+
+  std::unique_lock<std::mutex> lk(m_frame_queue_mutex);
+  while (true)
+  {
+    m_frame_queued.wait(lk, [this] { return !m_frame_queue.empty() || m_stop_frame_worker; });
+    if (m_frame_queue.empty())
+      break;
+
+    PendingFrame pending = std::move(m_frame_queue.front());
+    m_frame_queue.pop_front();
+    m_frame_worker_busy = true;
+    lk.unlock();
+
+    pending.file->AddFrame(pending.frame);
+
+    lk.lock();
+    m_frame_worker_busy = false;
+    if (m_frame_queue.empty())
+      m_frame_queue_empty.notify_all();
+
+    // The recording is done once the last frame was added
+    if (pending.finished_callback)
+    {
+      lk.unlock();
+      pending.finished_callback();
+      lk.lock();
+    }
+  }
+}
+
 FifoRecorder& FifoRecorder::GetInstance()
 {
   return instance;
@@ -4,9 +4,12 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <thread>
 #include <vector>
 
 #include "Core/FifoPlayer/FifoDataFile.h"
@@ -17,6 +20,7 @@ public:
   using CallbackFunc = std::function<void()>;
 
   FifoRecorder();
+  ~FifoRecorder();
 
   void StartRecording(s32 numFrames, CallbackFunc finishedCb);
   void StopRecording();
@@ -48,6 +52,27 @@ public:
   static FifoRecorder& GetInstance();
 
 private:
+  // Finished frames are compressed and added to the file on a worker thread, so that the video
+  // thread only has to snapshot the memory that changed.
+  struct PendingFrame
+  {
+    FifoDataFile* file;
+    FifoFrameInfo frame;
+    CallbackFunc finished_callback;
+  };
+
+  void QueueFrame(PendingFrame frame);
+  void WaitForFrameWorker();
+  void FrameWorkerLoop();
+
+  std::thread m_frame_worker;
+  mutable std::mutex m_frame_queue_mutex;
+  std::condition_variable m_frame_queued;
+  std::condition_variable m_frame_queue_empty;
+  std::deque<PendingFrame> m_frame_queue;
+  bool m_frame_worker_busy = false;
+  bool m_stop_frame_worker = false;
+
   // Accessed from both GUI and video threads
 
   std::recursive_mutex m_mutex;
@@ -0,0 +1,83 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/FramePacer.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <thread>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/Timer.h"
+
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/HW/VideoInterface.h"
+#include "VideoCommon/FrameProfiler.h"
+
+namespace FramePacer
+{
+namespace
+{
+// The start of a field is pushed back by the slowest of the last few fields, so that one cheap
+// field doesn't make the next expensive one miss its present.
+constexpr size_t NUM_FIELD_COST_SAMPLES = 16;
+
+// Slack for scheduler wakeup jitter.
+constexpr s64 SAFETY_MARGIN_US = 1000;
+
+std::array<s64, NUM_FIELD_COST_SAMPLES> s_field_costs;
+size_t s_next_field_cost = 0;
+
+// 0 while no paced field is in flight.
+u64 s_field_start_us = 0;
+}  // Anonymous namespace
+
+bool IsEnabled()
+{
+  return Config::Get(Config::MAIN_LOW_LATENCY_PACING) &&
+         SConfig::GetInstance().m_EmulationSpeed == 1.0f && !Core::GetIsThrottlerTempDisabled();
+}
+
+void Reset()
+{
+  s_field_costs.fill(0);
+  s_next_field_cost = 0;
+  s_field_start_us = 0;
+}
+
+void OnFieldPresented()
+{
+  if (!IsEnabled())
+  {
+    s_field_start_us = 0;
+    return;
+  }
+
+  const u64 present_us = Common::Timer::GetTimeUs();
+  if (s_field_start_us != 0)
+  {
+    s_field_costs[s_next_field_cost] = static_cast<s64>(present_us - s_field_start_us);
+    s_next_field_cost = (s_next_field_cost + 1) % NUM_FIELD_COST_SAMPLES;
+  }
+
+  const u32 refresh_rate = VideoInterface::GetTargetRefreshRate();
+  if (refresh_rate != 0)
+  {
+    const s64 period_us = 1000000 / refresh_rate;
+    const s64 cost_us = *std::max_element(s_field_costs.begin(), s_field_costs.end());
+    const s64 delay_us = period_us - cost_us - SAFETY_MARGIN_US;
+    if (delay_us > 0)
+    {
+      FrameProfiler::ScopedTimer timer(FrameProfiler::Category::CPUThreadIdle);
+      std::this_thread::sleep_for(std::chrono::microseconds(delay_us));
+    }
+  }
+
+  s_field_start_us = Common::Timer::GetTimeUs();
+}
+}  // namespace FramePacer
@@ -0,0 +1,22 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+// Low-latency pacing: instead of running the next field as soon as the previous one was handed to
+// the GPU thread, wait for it to be presented, then start emulating the next field as late as the
+// measured frame cost allows. The SI polls of that field then sample host input that much closer
+// to the moment its result reaches the screen.
+
+namespace FramePacer
+{
+// Whether the swap for a field should be waited on. Pacing only makes sense at full speed, so this
+// is false when the speed limit is off or changed.
+bool IsEnabled();
+
+void Reset();
+
+// Call on the CPU thread after a field was output. Sleeps until the next field should start.
+void OnFieldPresented();
+}  // namespace FramePacer
@@ -5,6 +5,7 @@
 #include "Core/HW/AddressSpace.h"
 
 #include <algorithm>
+#include <cstring>
 
 #include "Common/BitUtils.h"
 #include "Core/ConfigManager.h"
@@ -58,6 +59,23 @@ float Accessors::ReadF32(u32 address) const
   return Common::BitCast<float>(ReadU32(address));
 }
 
+void Accessors::ReadBytes(u32 address, u8* data, std::size_t size) const
+{
+  const iterator memory_begin = begin();
+  if (memory_begin != nullptr && address <= end() - memory_begin &&
+      size <= static_cast<std::size_t>(end() - memory_begin) - address)
+  {
+    std::memcpy(data, memory_begin + address, size);
+    return;
+  }
+
+  for (std::size_t i = 0; i < size; i++)
+  {
+    const u32 byte_address = address + static_cast<u32>(i);
+    data[i] = IsValidAddress(byte_address) ? ReadU8(byte_address) : 0;
+  }
+}
+
 Accessors::iterator Accessors::begin() const
 {
   return nullptr;
@@ -91,6 +109,37 @@ struct EffectiveAddressSpaceAccessors : Accessors
   void WriteU64(u32 address, u64 value) override { PowerPC::HostWrite_U64(value, address); }
   float ReadF32(u32 address) const override { return PowerPC::HostRead_F32(address); };
 
+  void ReadBytes(u32 address, u8* data, std::size_t size) const override
+  {
+    // Translate once per page rather than reading byte by byte
+    while (size != 0)
+    {
+      const std::size_t chunk_size = std::min<std::size_t>(0x1000 - (address & 0xfff), size);
+      std::optional<u32> physical_address;
+      if (PowerPC::HostIsRAMAddress(address))
+        physical_address = PowerPC::GetTranslatedAddress(address);
+
+      // Only MEM1 and MEM2 are copied straight out, like in Matches
+      if (!physical_address)
+      {
+        std::memset(data, 0, chunk_size);
+      }
+      else if ((*physical_address >> 28) <= 0x1)
+      {
+        Memory::CopyFromEmu(data, *physical_address, chunk_size);
+      }
+      else
+      {
+        for (std::size_t i = 0; i < chunk_size; i++)
+          data[i] = PowerPC::HostRead_U8(address + static_cast<u32>(i));
+      }
+
+      address += static_cast<u32>(chunk_size);
+      data += chunk_size;
+      size -= chunk_size;
+    }
+  }
+
   bool Matches(u32 haystack_start, const u8* needle_start, std::size_t needle_size) const
   {
     u32 page_base = haystack_start & 0xfffff000;
@@ -36,6 +36,8 @@ struct Accessors
   virtual u64 ReadU64(u32 address) const;
   virtual void WriteU64(u32 address, u64 value);
   virtual float ReadF32(u32 address) const;
+  // Copies a whole range in one call. Bytes at invalid addresses read as zero.
+  virtual void ReadBytes(u32 address, u8* data, std::size_t size) const;
 
   virtual iterator begin() const;
   virtual iterator end() const;
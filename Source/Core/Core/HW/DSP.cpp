@@ -24,12 +24,15 @@
 
 #include "Core/HW/DSP.h"
 
+#include <cstring>
 #include <memory>
 
 #include "AudioCommon/AudioCommon.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/MemArena.h"
 #include "Common/MemoryUtil.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/CoreTiming.h"
 #include "Core/DSPEmulator.h"
@@ -127,6 +130,9 @@ union ARAM_Info
 
 // STATE_TO_SAVE
 static ARAMInfo s_ARAM;
+// Backs GameCube ARAM when it's exported as shared memory
+static Common::MemArena s_aram_arena;
+static bool s_aram_is_shared = false;
 static AudioDMA s_audioDMA;
 static ARAM_DMA s_arDMA;
 static UDSPControl s_dspState;
@@ -203,7 +209,17 @@ void Reinit(bool hle)
     s_ARAM.wii_mode = false;
     s_ARAM.size = ARAM_SIZE;
     s_ARAM.mask = ARAM_MASK;
-    s_ARAM.ptr = static_cast<u8*>(Common::AllocateMemoryPages(s_ARAM.size));
+    s_ARAM.ptr = nullptr;
+    if (Config::Get(Config::MAIN_VANGUARD_SHARED_MEMORY))
+    {
+      s_aram_arena.GrabSHMSegment(s_ARAM.size, "dolphin-emu-aram");
+      s_ARAM.ptr = static_cast<u8*>(s_aram_arena.CreateView(0, s_ARAM.size));
+      if (!s_ARAM.ptr)
+        s_aram_arena.ReleaseSHMSegment();
+    }
+    s_aram_is_shared = s_ARAM.ptr != nullptr;
+    if (!s_aram_is_shared)
+      s_ARAM.ptr = static_cast<u8*>(Common::AllocateMemoryPages(s_ARAM.size));
   }
 
   s_audioDMA = {};
@@ -221,7 +237,16 @@ void Shutdown()
 {
   if (!s_ARAM.wii_mode)
   {
-    Common::FreeMemoryPages(s_ARAM.ptr, s_ARAM.size);
+    if (s_aram_is_shared)
+    {
+      s_aram_arena.ReleaseView(s_ARAM.ptr, s_ARAM.size);
+      s_aram_arena.ReleaseSHMSegment();
+      s_aram_is_shared = false;
+    }
+    else
+    {
+      Common::FreeMemoryPages(s_ARAM.ptr, s_ARAM.size);
+    }
     s_ARAM.ptr = nullptr;
   }
 
@@ -472,6 +497,16 @@ void UpdateAudioDMA()
   }
 }
 
+// Returns whether the current ARAM DMA covers one contiguous range on both sides, so that it can be
+// done with a single copy. Transfers that wrap around either memory or run past the end of MEM1
+// take the slow path, which handles them the way the hardware does.
+static bool IsARAMDMAContiguous()
+{
+  const u32 count = s_arDMA.Cnt.count;
+  return u64(s_arDMA.MMAddr) + count <= Memory::GetRamSizeReal() &&
+         u64(s_arDMA.ARAddr & s_ARAM.mask) + count <= u64(s_ARAM.mask) + 1;
+}
+
 static void Do_ARAM_DMA()
 {
   s_dspState.DMAState = 1;
@@ -491,7 +526,16 @@ static void Do_ARAM_DMA()
     s_arDMA.ARAddr &= 0x3ffffff;
     s_arDMA.MMAddr &= 0x3ffffff;
 
-    if (s_arDMA.ARAddr < s_ARAM.size)
+    if (s_arDMA.ARAddr < s_ARAM.size && IsARAMDMAContiguous())
+    {
+      // Both sides are stored in the byte order of the console, so this is a plain copy
+      std::memcpy(Memory::m_pRAM + s_arDMA.MMAddr, &s_ARAM.ptr[s_arDMA.ARAddr & s_ARAM.mask],
+                  s_arDMA.Cnt.count);
+      s_arDMA.MMAddr += s_arDMA.Cnt.count;
+      s_arDMA.ARAddr += s_arDMA.Cnt.count;
+      s_arDMA.Cnt.count = 0;
+    }
+    else if (s_arDMA.ARAddr < s_ARAM.size)
     {
       while (s_arDMA.Cnt.count)
       {
@@ -515,10 +559,17 @@ static void Do_ARAM_DMA()
         s_arDMA.Cnt.count -= 8;
       }
     }
-    else
+    else if (u64(s_arDMA.MMAddr) + s_arDMA.Cnt.count <= Memory::GetRamSizeReal())
     {
       // Assuming no external ARAM installed; returns zeros on out of bounds reads (verified on real
       // HW)
+      std::memset(Memory::m_pRAM + s_arDMA.MMAddr, 0, s_arDMA.Cnt.count);
+      s_arDMA.MMAddr += s_arDMA.Cnt.count;
+      s_arDMA.ARAddr += s_arDMA.Cnt.count;
+      s_arDMA.Cnt.count = 0;
+    }
+    else
+    {
       while (s_arDMA.Cnt.count)
       {
         Memory::Write_U64(0, s_arDMA.MMAddr);
@@ -538,7 +589,16 @@ static void Do_ARAM_DMA()
     s_arDMA.ARAddr &= 0x3ffffff;
     s_arDMA.MMAddr &= 0x3ffffff;
 
-    if (s_arDMA.ARAddr < s_ARAM.size)
+    // Memory map 4 also mirrors the lowest 4 MiB, see below
+    if (s_arDMA.ARAddr < s_ARAM.size && (s_ARAM_Info.Hex & 0xf) != 4 && IsARAMDMAContiguous())
+    {
+      std::memcpy(&s_ARAM.ptr[s_arDMA.ARAddr & s_ARAM.mask], Memory::m_pRAM + s_arDMA.MMAddr,
+                  s_arDMA.Cnt.count);
+      s_arDMA.MMAddr += s_arDMA.Cnt.count;
+      s_arDMA.ARAddr += s_arDMA.Cnt.count;
+      s_arDMA.Cnt.count = 0;
+    }
+    else if (s_arDMA.ARAddr < s_ARAM.size)
     {
       while (s_arDMA.Cnt.count)
       {
@@ -608,4 +668,9 @@ u8* GetARAMPtr()
   return s_ARAM.ptr;
 }
 
+const std::string& GetARAMSharedMemoryName()
+{
+  return s_aram_arena.GetSegmentName();
+}
+
 }  // end of namespace DSP
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <string>
+
 #include "Common/CommonTypes.h"
 
 class PointerWrap;
@@ -78,6 +80,9 @@ void WriteARAM(u8 value, u32 address);
 
 // Debugger Helper
 u8* GetARAMPtr();
+// GameCube ARAM starts at offset 0 of this shared memory segment. Empty on Wii, where ARAM is in
+// MEM2, and when ARAM isn't shared.
+const std::string& GetARAMSharedMemoryName();
 
 void UpdateAudioDMA();
 void UpdateDSPSlice(int cycles);
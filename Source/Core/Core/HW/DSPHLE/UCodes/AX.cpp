@@ -14,6 +14,7 @@
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/HW/DSP.h"
 #include "Core/HW/DSPHLE/DSPHLE.h"
 #include "Core/HW/DSPHLE/MailHandler.h"
@@ -24,7 +25,9 @@
 
 namespace DSP::HLE
 {
-AXUCode::AXUCode(DSPHLE* dsphle, u32 crc) : UCodeInterface(dsphle, crc), m_cmdlist_size(0)
+AXUCode::AXUCode(DSPHLE* dsphle, u32 crc)
+    : UCodeInterface(dsphle, crc), m_cmdlist_size(0),
+      m_parallel_mix(Config::Get(Config::MAIN_DSP_HLE_PARALLEL_MIX))
 {
   INFO_LOG(DSPHLE, "Instantiating AXUCode: crc=%08x", crc);
 }
@@ -415,15 +418,9 @@ void AXUCode::ProcessPBList(u32 pb_addr)
   // 32KHz to 48KHz, but AX always process at 32KHz.
   constexpr u32 spms = 32;
 
-  AXPB pb;
-
-  while (pb_addr)
-  {
-    AXBuffers buffers = {{m_samples_left, m_samples_right, m_samples_surround, m_samples_auxA_left,
-                          m_samples_auxA_right, m_samples_auxA_surround, m_samples_auxB_left,
-                          m_samples_auxB_right, m_samples_auxB_surround}};
-
-    ReadPB(pb_addr, pb, m_crc);
+  const auto process_voice = [this](HLEAccelerator& accelerator, AXPB& pb,
+                                    const AXBuffers& output) {
+    AXBuffers buffers = output;
 
     u32 updates_addr = HILO_TO_32(pb.updates.data);
     u16* updates = (u16*)HLEMemory_Get_Pointer(updates_addr);
@@ -432,14 +429,33 @@ void AXUCode::ProcessPBList(u32 pb_addr)
     {
       ApplyUpdatesForMs(curr_ms, pb, pb.updates.num_updates, updates);
 
-      ProcessVoice(pb, buffers, spms, ConvertMixerControl(pb.mixer_control),
+      ProcessVoice(accelerator, pb, buffers, spms, ConvertMixerControl(pb.mixer_control),
                    m_coeffs_available ? m_coeffs : nullptr);
 
       // Forward the buffers
       for (auto& ptr : buffers.ptrs)
         ptr += spms;
     }
+  };
+
+  const AXBuffers buffers = {{m_samples_left, m_samples_right, m_samples_surround,
+                              m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
+                              m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround}};
 
+  if (m_parallel_mix)
+  {
+    static ParallelVoiceMixer s_parallel_mixer({32 * 5, 32 * 5, 32 * 5, 32 * 5, 32 * 5, 32 * 5,
+                                                32 * 5, 32 * 5, 32 * 5});
+    if (s_parallel_mixer.ProcessPBList(pb_addr, m_crc, buffers, process_voice))
+      return;
+  }
+
+  AXPB pb;
+
+  while (pb_addr)
+  {
+    ReadPB(pb_addr, pb, m_crc);
+    process_voice(*s_accelerator, pb, buffers);
     WritePB(pb_addr, pb, m_crc);
     pb_addr = HILO_TO_32(pb.next_pb);
   }
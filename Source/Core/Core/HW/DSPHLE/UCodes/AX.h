@@ -93,6 +93,9 @@ protected:
   u16 m_cmdlist[512];
   u32 m_cmdlist_size;
 
+  // Whether long PB lists are mixed on worker threads.
+  bool m_parallel_mix;
+
   // Table of coefficients for polyphase sample rate conversion.
   // The coefficients aren't always available (they are part of the DSP DROM)
   // so we also need to know if they are valid or not.
@@ -13,10 +13,14 @@
 #endif
 
 #include <algorithm>
+#include <array>
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
+#include "Common/ThreadPool.h"
 #include "Core/DSP/DSPAccelerator.h"
 #include "Core/HW/DSP.h"
 #include "Core/HW/DSPHLE/UCodes/AX.h"
@@ -161,23 +165,48 @@ void DumpPB(const PB_TYPE& pb)
 }
 #endif
 
-// Simulated accelerator state.
-static PB_TYPE* acc_pb;
-static bool acc_end_reached;
-
+// Simulated accelerator, along with the state of the voice it is reading for.
 class HLEAccelerator final : public Accelerator
 {
+public:
+  // Sets up the simulated accelerator.
+  void Setup(PB_TYPE* pb)
+  {
+    m_pb = pb;
+    SetStartAddress(HILO_TO_32(pb->audio_addr.loop_addr));
+    SetEndAddress(HILO_TO_32(pb->audio_addr.end_addr));
+    SetCurrentAddress(HILO_TO_32(pb->audio_addr.cur_addr));
+    SetSampleFormat(pb->audio_addr.sample_format);
+    SetYn1(pb->adpcm.yn1);
+    SetYn2(pb->adpcm.yn2);
+    SetPredScale(pb->adpcm.pred_scale);
+    m_end_reached = false;
+  }
+
+  // Reads samples from the accelerator. Also handles looping and
+  // disabling streams that reached the end (this is done by an exception raised
+  // by the accelerator on real hardware).
+  void GetSamples(s16* samples, u32 count)
+  {
+    // See below for explanations about m_end_reached.
+    u32 read = 0;
+    while (read < count && !m_end_reached)
+      read += ReadSamples(m_pb->adpcm.coefs, samples + read, count - read);
+
+    std::fill(samples + read, samples + count, 0);
+  }
+
 protected:
   void OnEndException() override
   {
-    if (acc_pb->audio_addr.looping)
+    if (m_pb->audio_addr.looping)
     {
       // Set the ADPCM info to continue processing at loop_addr.
-      SetPredScale(acc_pb->adpcm_loop_info.pred_scale);
-      if (!acc_pb->is_stream)
+      SetPredScale(m_pb->adpcm_loop_info.pred_scale);
+      if (!m_pb->is_stream)
       {
-        SetYn1(acc_pb->adpcm_loop_info.yn1);
-        SetYn2(acc_pb->adpcm_loop_info.yn2);
+        SetYn1(m_pb->adpcm_loop_info.yn1);
+        SetYn2(m_pb->adpcm_loop_info.yn2);
       }
       else
       {
@@ -186,14 +215,14 @@ protected:
         SetYn2(GetYn2());
 #ifdef AX_GC
         // If we're streaming, increment the loop counter.
-        acc_pb->loop_counter++;
+        m_pb->loop_counter++;
 #endif
       }
     }
     else
     {
       // Non looping voice reached the end -> running = 0.
-      acc_pb->running = 0;
+      m_pb->running = 0;
 
 #ifdef AX_WII
       // One of the few meaningful differences between AXGC and AXWii:
@@ -201,42 +230,21 @@ protected:
       // accelerator to stop reads once the loop address is reached,
       // AXWii has the 0000 samples internally in DRAM and use an internal
       // pointer to it (loop addr does not contain 0000 samples on AXWii!).
-      acc_end_reached = true;
+      m_end_reached = true;
 #endif
     }
   }
 
   u8 ReadMemory(u32 address) override { return ReadARAM(address); }
   void WriteMemory(u32 address, u8 value) override { WriteARAM(value, address); }
-};
-
-static std::unique_ptr<Accelerator> s_accelerator = std::make_unique<HLEAccelerator>();
-
-// Sets up the simulated accelerator.
-void AcceleratorSetup(PB_TYPE* pb)
-{
-  acc_pb = pb;
-  s_accelerator->SetStartAddress(HILO_TO_32(pb->audio_addr.loop_addr));
-  s_accelerator->SetEndAddress(HILO_TO_32(pb->audio_addr.end_addr));
-  s_accelerator->SetCurrentAddress(HILO_TO_32(pb->audio_addr.cur_addr));
-  s_accelerator->SetSampleFormat(pb->audio_addr.sample_format);
-  s_accelerator->SetYn1(pb->adpcm.yn1);
-  s_accelerator->SetYn2(pb->adpcm.yn2);
-  s_accelerator->SetPredScale(pb->adpcm.pred_scale);
-  acc_end_reached = false;
-}
 
-// Reads a sample from the accelerator. Also handles looping and
-// disabling streams that reached the end (this is done by an exception raised
-// by the accelerator on real hardware).
-u16 AcceleratorGetSample()
-{
-  // See below for explanations about acc_end_reached.
-  if (acc_end_reached)
-    return 0;
+private:
+  PB_TYPE* m_pb = nullptr;
+  bool m_end_reached = false;
+};
 
-  return s_accelerator->Read(acc_pb->adpcm.coefs);
-}
+// Used when the voices are processed on the calling thread.
+static std::unique_ptr<HLEAccelerator> s_accelerator = std::make_unique<HLEAccelerator>();
 
 // Reads samples from the input callback, resamples them to <count> samples at
 // the wanted sample rate (computed from the ratio, see below).
@@ -258,7 +266,8 @@ u16 AcceleratorGetSample()
 // We start getting samples not from sample 0, but 0.<curr_pos_frac>. This
 // avoids discontinuities in the audio stream, especially with very low ratios
 // which interpolate a lot of values between two "real" samples.
-u32 ResampleAudio(std::function<s16(u32)> input_callback, s16* output, u32 count, s16* last_samples,
+template <typename InputCallback>
+u32 ResampleAudio(InputCallback input_callback, s16* output, u32 count, s16* last_samples,
                   u32 curr_pos, u32 ratio, int srctype, const s16* coeffs)
 {
   int read_samples_count = 0;
@@ -373,25 +382,102 @@ u32 ResampleAudio(std::function<s16(u32)> input_callback, s16* output, u32 count
   return curr_pos;
 }
 
+// Returns how many input samples ResampleAudio will read to produce <count> samples.
+u32 GetResamplerInputCount(u32 count, u32 curr_pos, u32 ratio, int srctype)
+{
+  if (srctype != SRCTYPE_LINEAR && srctype != SRCTYPE_POLYPHASE)
+    return count;
+
+  // Same arithmetic as the resampler, including how curr_pos wraps.
+  u32 input_count = 0;
+  for (u32 i = 0; i < count; ++i)
+  {
+    curr_pos += ratio;
+    input_count += curr_pos >> 16;
+    curr_pos &= 0xFFFF;
+  }
+  return input_count;
+}
+
 // Read <count> input samples from ARAM, decoding and converting rate
 // if required.
-void GetInputSamples(PB_TYPE& pb, s16* samples, u16 count, const s16* coeffs)
+void GetInputSamples(HLEAccelerator& accelerator, PB_TYPE& pb, s16* samples, u16 count,
+                     const s16* coeffs)
 {
-  AcceleratorSetup(&pb);
+  accelerator.Setup(&pb);
 
   if (coeffs)
     coeffs += pb.coef_select * 0x200;
-  u32 curr_pos =
-      ResampleAudio([](u32) { return AcceleratorGetSample(); }, samples, count, pb.src.last_samples,
-                    pb.src.cur_addr_frac, HILO_TO_32(pb.src.ratio), pb.src_type, coeffs);
+
+  // Decode everything the resampler needs up front, so that the accelerator can decode whole runs
+  // of ADPCM at once. Very high ratios fall back to decoding in chunks as the resampler asks.
+  constexpr u32 MAX_INPUT_SAMPLES = MAX_SAMPLES_PER_FRAME * 16;
+  s16 input[MAX_INPUT_SAMPLES];
+  const u32 input_count = GetResamplerInputCount(count, pb.src.cur_addr_frac,
+                                                 HILO_TO_32(pb.src.ratio), pb.src_type);
+  u32 curr_pos;
+  if (input_count <= MAX_INPUT_SAMPLES)
+  {
+    accelerator.GetSamples(input, input_count);
+    curr_pos = ResampleAudio([&input](u32 i) { return input[i]; }, samples, count,
+                             pb.src.last_samples, pb.src.cur_addr_frac, HILO_TO_32(pb.src.ratio),
+                             pb.src_type, coeffs);
+  }
+  else
+  {
+    const auto read_sample = [&accelerator](u32) {
+      s16 sample;
+      accelerator.GetSamples(&sample, 1);
+      return sample;
+    };
+    curr_pos = ResampleAudio(read_sample, samples, count, pb.src.last_samples,
+                             pb.src.cur_addr_frac, HILO_TO_32(pb.src.ratio), pb.src_type, coeffs);
+  }
   pb.src.cur_addr_frac = (curr_pos & 0xFFFF);
 
   // Update current position, YN1, YN2 and pred scale in the PB.
-  pb.audio_addr.cur_addr_hi = static_cast<u16>(s_accelerator->GetCurrentAddress() >> 16);
-  pb.audio_addr.cur_addr_lo = static_cast<u16>(s_accelerator->GetCurrentAddress());
-  pb.adpcm.yn1 = s_accelerator->GetYn1();
-  pb.adpcm.yn2 = s_accelerator->GetYn2();
-  pb.adpcm.pred_scale = s_accelerator->GetPredScale();
+  pb.audio_addr.cur_addr_hi = static_cast<u16>(accelerator.GetCurrentAddress() >> 16);
+  pb.audio_addr.cur_addr_lo = static_cast<u16>(accelerator.GetCurrentAddress());
+  pb.adpcm.yn1 = accelerator.GetYn1();
+  pb.adpcm.yn2 = accelerator.GetYn2();
+  pb.adpcm.pred_scale = accelerator.GetPredScale();
+}
+
+// Scales samples by a 1.15 fixed point volume that changes by volume_delta after every sample, and
+// clamps the result. input and output may be the same buffer.
+void ApplyVolume(const s16* input, s16* output, u32 count, u16 volume, u16 volume_delta)
+{
+  u32 i = 0;
+
+#ifdef _M_X86
+  // Eight samples at a time. SSE2 has no signed by unsigned multiply, so the high half of the
+  // product is computed as a signed one and corrected for volumes of 0x8000 and above.
+  __m128i volumes = _mm_add_epi16(_mm_set1_epi16(static_cast<s16>(volume)),
+                                  _mm_mullo_epi16(_mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7),
+                                                  _mm_set1_epi16(static_cast<s16>(volume_delta))));
+  const __m128i volumes_step = _mm_set1_epi16(static_cast<s16>(volume_delta * 8));
+  const __m128i min_sample = _mm_set1_epi16(-32767);
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+    const __m128i product_lo = _mm_mullo_epi16(samples, volumes);
+    const __m128i product_hi =
+        _mm_add_epi16(_mm_mulhi_epi16(samples, volumes),
+                      _mm_and_si128(samples, _mm_srai_epi16(volumes, 15)));
+    const __m128i scaled_lo = _mm_srai_epi32(_mm_unpacklo_epi16(product_lo, product_hi), 15);
+    const __m128i scaled_hi = _mm_srai_epi32(_mm_unpackhi_epi16(product_lo, product_hi), 15);
+    const __m128i result = _mm_max_epi16(_mm_packs_epi32(scaled_lo, scaled_hi), min_sample);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), result);
+    volumes = _mm_add_epi16(volumes, volumes_step);
+  }
+  volume += static_cast<u16>(volume_delta * i);
+#endif
+
+  for (; i < count; ++i)
+  {
+    output[i] = static_cast<s16>(std::clamp((input[i] * volume) >> 15, -32767, 32767));  // -32768 ?
+    volume += volume_delta;
+  }
 }
 
 // Add samples to an output buffer, with optional volume ramping.
@@ -406,18 +492,14 @@ void MixAdd(int* out, const s16* input, u32 count, u16* pvol, s16* dpop, bool ra
   if (!ramp)
     volume_delta = 0;
 
+  s16 scaled[MAX_SAMPLES_PER_FRAME];
+  ApplyVolume(input, scaled, count, volume, volume_delta);
   for (u32 i = 0; i < count; ++i)
-  {
-    s64 sample = input[i];
-    sample *= volume;
-    sample >>= 15;
-    sample = std::clamp((s32)sample, -32767, 32767);  // -32768 ?
+    out[i] += scaled[i];
 
-    out[i] += (s16)sample;
-    volume += volume_delta;
-
-    *dpop = (s16)sample;
-  }
+  volume += static_cast<u16>(volume_delta * count);
+  if (count != 0)
+    *dpop = scaled[count - 1];
 }
 
 // Execute a low pass filter on the samples using one history value. Returns
@@ -431,8 +513,8 @@ s16 LowPassFilter(s16* samples, u32 count, s16 yn1, u16 a0, u16 b0)
 
 // Process 1ms of audio (for AX GC) or 3ms of audio (for AX Wii) from a PB and
 // mix it to the output buffers.
-void ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count, AXMixControl mctrl,
-                  const s16* coeffs)
+void ProcessVoice(HLEAccelerator& accelerator, PB_TYPE& pb, const AXBuffers& buffers, u16 count,
+                  AXMixControl mctrl, const s16* coeffs)
 {
   // If the voice is not running, nothing to do.
   if (!pb.running)
@@ -440,15 +522,12 @@ void ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count, AXMixControl
 
   // Read input samples, performing sample rate conversion if needed.
   s16 samples[MAX_SAMPLES_PER_FRAME];
-  GetInputSamples(pb, samples, count, coeffs);
+  GetInputSamples(accelerator, pb, samples, count, coeffs);
 
   // Apply a global volume ramp using the volume envelope parameters.
-  for (u32 i = 0; i < count; ++i)
-  {
-    samples[i] = std::clamp(((s32)samples[i] * pb.vol_env.cur_volume) >> 15, -32767,
-                            32767);  // -32768 ?
-    pb.vol_env.cur_volume += pb.vol_env.cur_volume_delta;
-  }
+  const u16 volume_delta = static_cast<u16>(pb.vol_env.cur_volume_delta);
+  ApplyVolume(samples, samples, count, pb.vol_env.cur_volume, volume_delta);
+  pb.vol_env.cur_volume += static_cast<u16>(volume_delta * count);
 
   // Optionally, execute a low pass filter
   // TODO: LPF code is currently broken, causing Super Monkey Ball sound
@@ -563,5 +642,148 @@ void ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count, AXMixControl
 #endif
 }
 
+// Processes the voices of a PB list on the thread pool. The whole list is read from RAM first, then
+// every worker mixes a contiguous run of voices into its own set of buffers, and the sets are
+// added to the output in list order. Mixing only ever adds integers to the buffers, so the output
+// is the same as when the voices are mixed one after the other.
+class ParallelVoiceMixer
+{
+public:
+  static constexpr size_t NUM_BUFFERS = sizeof(AXBuffers) / sizeof(int*);
+
+  // Shorter lists are cheaper to mix on the calling thread than to hand out to the workers.
+  static constexpr u32 MIN_RUNNING_VOICES = 16;
+  // More than any AX version supports, a longer list is most likely looping.
+  static constexpr u32 MAX_VOICES = 128;
+  static constexpr u32 MAX_WORKERS = 3;
+
+  // Processes all the milliseconds of a frame of one voice, mixing it to the given buffers.
+  using VoiceFunction = std::function<void(HLEAccelerator&, PB_TYPE&, const AXBuffers&)>;
+
+  explicit ParallelVoiceMixer(const std::array<u32, NUM_BUFFERS>& buffer_sizes)
+      : m_buffer_sizes(buffer_sizes)
+  {
+    u32 total_size = 0;
+    for (u32 size : buffer_sizes)
+      total_size += size;
+
+    for (VoiceSet& set : m_sets)
+    {
+      set.samples.resize(total_size);
+      int* ptr = set.samples.data();
+      for (size_t i = 0; i < NUM_BUFFERS; i++)
+      {
+        set.buffers.ptrs[i] = ptr;
+        ptr += buffer_sizes[i];
+      }
+    }
+
+    m_num_workers = static_cast<u32>(
+        std::min<size_t>(Common::ThreadPool::GetWorkerCount(), MAX_WORKERS));
+  }
+
+  // Returns false if the list has to be processed on the calling thread. Neither RAM nor the
+  // output buffers have been written to in that case.
+  bool ProcessPBList(u32 pb_addr, u32 crc, const AXBuffers& output,
+                     const VoiceFunction& process_voice)
+  {
+    if (m_num_workers == 0)
+      return false;
+
+    u32 num_pbs = 0;
+    u32 running_voices = 0;
+    while (pb_addr)
+    {
+      if (num_pbs == MAX_VOICES)
+        return false;
+
+      m_addresses[num_pbs] = pb_addr;
+      ReadPB(pb_addr, m_pbs[num_pbs], crc);
+      if (m_pbs[num_pbs].running)
+        running_voices++;
+      pb_addr = HILO_TO_32(m_pbs[num_pbs].next_pb);
+      num_pbs++;
+    }
+    if (running_voices < MIN_RUNNING_VOICES)
+      return false;
+
+    // Every PB is read before any of them is written back, which only gives the same result when
+    // none of them overlap. See ReadPB for the layout without a low pass filter.
+    const u32 pb_size = HasLpf(crc) ? sizeof(PB_TYPE) :
+                                      sizeof(PB_TYPE) - (offsetof(AXPB, loop_counter) -
+                                                         offsetof(AXPB, lpf));
+    std::array<u32, MAX_VOICES> sorted_addresses;
+    std::copy_n(m_addresses.begin(), num_pbs, sorted_addresses.begin());
+    std::sort(sorted_addresses.begin(), sorted_addresses.begin() + num_pbs);
+    for (u32 i = 1; i < num_pbs; i++)
+    {
+      if (sorted_addresses[i] - sorted_addresses[i - 1] < pb_size)
+        return false;
+    }
+
+    const u32 num_sets = m_num_workers + 1;
+    const u32 pbs_per_set = (num_pbs + num_sets - 1) / num_sets;
+    for (u32 i = 0; i < num_sets; i++)
+    {
+      VoiceSet& set = m_sets[i];
+      set.first_pb = std::min(i * pbs_per_set, num_pbs);
+      set.num_pbs = std::min(pbs_per_set, num_pbs - set.first_pb);
+      set.process_voice = &process_voice;
+    }
+
+    Common::ThreadPool::ParallelFor(num_sets, [this](size_t i) { MixVoiceSet(m_sets[i]); });
+
+    // An update may have relinked the list, in which case the serial walk would have taken a
+    // different path. The results are thrown away and the list is processed again.
+    for (u32 i = 0; i < num_pbs; i++)
+    {
+      const u32 next_pb = i + 1 < num_pbs ? m_addresses[i + 1] : 0;
+      if (HILO_TO_32(m_pbs[i].next_pb) != next_pb)
+        return false;
+    }
+
+    for (u32 i = 0; i < num_sets; i++)
+    {
+      for (size_t j = 0; j < NUM_BUFFERS; j++)
+      {
+        const int* samples = m_sets[i].buffers.ptrs[j];
+        for (u32 k = 0; k < m_buffer_sizes[j]; k++)
+          output.ptrs[j][k] += samples[k];
+      }
+    }
+
+    for (u32 i = 0; i < num_pbs; i++)
+      WritePB(m_addresses[i], m_pbs[i], crc);
+
+    return true;
+  }
+
+private:
+  struct VoiceSet
+  {
+    HLEAccelerator accelerator;
+    std::vector<int> samples;
+    AXBuffers buffers;
+
+    u32 first_pb = 0;
+    u32 num_pbs = 0;
+    const VoiceFunction* process_voice = nullptr;
+  };
+
+  void MixVoiceSet(VoiceSet& set)
+  {
+    std::fill(set.samples.begin(), set.samples.end(), 0);
+    for (u32 i = set.first_pb; i < set.first_pb + set.num_pbs; i++)
+      (*set.process_voice)(set.accelerator, m_pbs[i], set.buffers);
+  }
+
+  std::array<u32, NUM_BUFFERS> m_buffer_sizes;
+  std::array<VoiceSet, MAX_WORKERS + 1> m_sets;
+  std::array<PB_TYPE, MAX_VOICES> m_pbs;
+  std::array<u32, MAX_VOICES> m_addresses;
+
+  u32 m_num_workers = 0;
+};
+
 }  // namespace
 }  // namespace DSP::HLE
@@ -447,19 +447,9 @@ void AXWiiUCode::ProcessPBList(u32 pb_addr)
   // 32KHz to 48KHz, but AX always process at 32KHz.
   constexpr u32 spms = 32;
 
-  AXPBWii pb;
-
-  while (pb_addr)
-  {
-    AXBuffers buffers = {{m_samples_left,      m_samples_right,      m_samples_surround,
-                          m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
-                          m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround,
-                          m_samples_auxC_left, m_samples_auxC_right, m_samples_auxC_surround,
-                          m_samples_wm0,       m_samples_aux0,       m_samples_wm1,
-                          m_samples_aux1,      m_samples_wm2,        m_samples_aux2,
-                          m_samples_wm3,       m_samples_aux3}};
-
-    ReadPB(pb_addr, pb, m_crc);
+  const auto process_voice = [this](HLEAccelerator& accelerator, AXPBWii& pb,
+                                    const AXBuffers& output) {
+    AXBuffers buffers = output;
 
     u16 num_updates[3];
     u16 updates[1024];
@@ -469,7 +459,8 @@ void AXWiiUCode::ProcessPBList(u32 pb_addr)
       for (int curr_ms = 0; curr_ms < 3; ++curr_ms)
       {
         ApplyUpdatesForMs(curr_ms, pb, num_updates, updates);
-        ProcessVoice(pb, buffers, spms, ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
+        ProcessVoice(accelerator, pb, buffers, spms,
+                     ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
                      m_coeffs_available ? m_coeffs : nullptr);
 
         // Forward the buffers
@@ -480,10 +471,35 @@ void AXWiiUCode::ProcessPBList(u32 pb_addr)
     }
     else
     {
-      ProcessVoice(pb, buffers, 96, ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
+      ProcessVoice(accelerator, pb, buffers, 96, ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
                    m_coeffs_available ? m_coeffs : nullptr);
     }
+  };
+
+  const AXBuffers buffers = {{m_samples_left,      m_samples_right,      m_samples_surround,
+                              m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
+                              m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround,
+                              m_samples_auxC_left, m_samples_auxC_right, m_samples_auxC_surround,
+                              m_samples_wm0,       m_samples_aux0,       m_samples_wm1,
+                              m_samples_aux1,      m_samples_wm2,        m_samples_aux2,
+                              m_samples_wm3,       m_samples_aux3}};
 
+  if (m_parallel_mix)
+  {
+    static ParallelVoiceMixer s_parallel_mixer({32 * 3, 32 * 3, 32 * 3, 32 * 3, 32 * 3, 32 * 3,
+                                                32 * 3, 32 * 3, 32 * 3, 32 * 3, 32 * 3, 32 * 3,
+                                                6 * 3, 6 * 3, 6 * 3, 6 * 3, 6 * 3, 6 * 3, 6 * 3,
+                                                6 * 3});
+    if (s_parallel_mixer.ProcessPBList(pb_addr, m_crc, buffers, process_voice))
+      return;
+  }
+
+  AXPBWii pb;
+
+  while (pb_addr)
+  {
+    ReadPB(pb_addr, pb, m_crc);
+    process_voice(*s_accelerator, pb, buffers);
     WritePB(pb_addr, pb, m_crc);
     pb_addr = HILO_TO_32(pb.next_pb);
   }
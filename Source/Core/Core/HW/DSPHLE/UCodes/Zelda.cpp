@@ -10,6 +10,7 @@
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
 #include "Core/HW/DSP.h"
@@ -547,8 +548,9 @@ void ZeldaUCode::RunPendingCommands()
       else if (m_flags & WEIRD_CMD_0C)
       {
         // TODO
-        NOTICE_LOG(DSPHLE, "Received an unhandled 0C command, params: %08x %08x", Read32(),
-                   Read32());
+        const u32 param1 = Read32();
+        const u32 param2 = Read32();
+        NOTICE_LOG(DSPHLE, "Received an unhandled 0C command, params: %08x %08x", param1, param2);
       }
       else
       {
@@ -559,6 +561,7 @@ void ZeldaUCode::RunPendingCommands()
 
     // Command 0D: TODO: find a name and implement.
     case 0x0D:
+    {
       if (m_flags & NO_CMD_0D)
       {
         WARN_LOG(DSPHLE, "Received a 0D command which is NOP'd on this UCode.");
@@ -566,9 +569,12 @@ void ZeldaUCode::RunPendingCommands()
         break;
       }
 
-      WARN_LOG(DSPHLE, "CMD0D: %08x", Read32());
+      // Logs don't evaluate their arguments when they're disabled
+      const u32 param = Read32();
+      WARN_LOG(DSPHLE, "CMD0D: %08x", param);
       SendCommandAck(CommandAck::STANDARD, sync);
       break;
+    }
 
     // Command 0E: Sets the base address of the ARAM for Wii UCodes. Used
     // because the Wii does not have an ARAM, so it simulates it with MRAM
@@ -964,6 +970,105 @@ struct ReverbPB
 };
 #pragma pack(pop)
 
+void ZeldaAudioRenderer::ApplyVolumeInPlace(s16* buf, size_t count, u16 vol, u32 shift)
+{
+  size_t i = 0;
+
+#ifdef _M_X86
+  // Eight samples at a time. SSE2 has no signed by unsigned multiply, so the high half of the
+  // product is computed as a signed one and corrected for volumes of 0x8000 and above.
+  const __m128i volume = _mm_set1_epi16(static_cast<s16>(vol));
+  const __m128i volume_sign = _mm_srai_epi16(volume, 15);
+  const __m128i shift_count = _mm_cvtsi32_si128(static_cast<int>(shift));
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + i));
+    const __m128i product_lo = _mm_mullo_epi16(samples, volume);
+    const __m128i product_hi = _mm_add_epi16(_mm_mulhi_epi16(samples, volume),
+                                             _mm_and_si128(samples, volume_sign));
+    const __m128i scaled_lo =
+        _mm_sra_epi32(_mm_unpacklo_epi16(product_lo, product_hi), shift_count);
+    const __m128i scaled_hi =
+        _mm_sra_epi32(_mm_unpackhi_epi16(product_lo, product_hi), shift_count);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(buf + i), _mm_packs_epi32(scaled_lo, scaled_hi));
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    s32 tmp = (u32)buf[i] * (u32)vol;
+    tmp >>= shift;
+
+    buf[i] = (s16)std::clamp(tmp, -0x8000, 0x7FFF);
+  }
+}
+
+s32 ZeldaAudioRenderer::AddBuffersWithVolumeRamp(s16* dst, const s16* src, size_t count, s32 vol,
+                                                 s32 step)
+{
+  size_t i = 0;
+
+#ifdef _M_X86
+  // Eight samples at a time. The integer part of the ramped volume fits in 16 bits, so the
+  // multiplication is a PMULHW.
+  // The volume wraps around like the scalar version does.
+  const auto ramp = [vol, step](u32 n) {
+    return static_cast<s32>(static_cast<u32>(vol) + static_cast<u32>(step) * n);
+  };
+  __m128i volumes_lo = _mm_setr_epi32(ramp(0), ramp(1), ramp(2), ramp(3));
+  __m128i volumes_hi = _mm_setr_epi32(ramp(4), ramp(5), ramp(6), ramp(7));
+  const __m128i volumes_step = _mm_set1_epi32(static_cast<s32>(static_cast<u32>(step) * 8));
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m128i volume = _mm_packs_epi32(_mm_srai_epi32(volumes_lo, 16),
+                                           _mm_srai_epi32(volumes_hi, 16));
+    const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    __m128i* out = reinterpret_cast<__m128i*>(dst + i);
+    _mm_storeu_si128(out, _mm_add_epi16(_mm_loadu_si128(out), _mm_mulhi_epi16(volume, samples)));
+    volumes_lo = _mm_add_epi32(volumes_lo, volumes_step);
+    volumes_hi = _mm_add_epi32(volumes_hi, volumes_step);
+  }
+  vol = ramp(static_cast<u32>(i));
+#endif
+
+  for (; i < count; ++i)
+  {
+    dst[i] += ((vol >> 16) * src[i]) >> 16;
+    vol += step;
+  }
+
+  return vol;
+}
+
+void ZeldaAudioRenderer::AddBuffersWithVolume(s16* dst, const s16* src, size_t count, u16 vol)
+{
+  size_t i = 0;
+
+#ifdef _M_X86
+  // Same as ApplyVolumeInPlace, with the clamped result added to the destination.
+  const __m128i volume = _mm_set1_epi16(static_cast<s16>(vol));
+  const __m128i volume_sign = _mm_srai_epi16(volume, 15);
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const __m128i product_lo = _mm_mullo_epi16(samples, volume);
+    const __m128i product_hi = _mm_add_epi16(_mm_mulhi_epi16(samples, volume),
+                                             _mm_and_si128(samples, volume_sign));
+    const __m128i scaled_lo = _mm_srai_epi32(_mm_unpacklo_epi16(product_lo, product_hi), 15);
+    const __m128i scaled_hi = _mm_srai_epi32(_mm_unpackhi_epi16(product_lo, product_hi), 15);
+    __m128i* out = reinterpret_cast<__m128i*>(dst + i);
+    _mm_storeu_si128(out, _mm_add_epi16(_mm_loadu_si128(out),
+                                        _mm_packs_epi32(scaled_lo, scaled_hi)));
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    s32 vol_src = ((s32)src[i] * (s32)vol) >> 15;
+    dst[i] += std::clamp(vol_src, -0x8000, 0x7FFF);
+  }
+}
+
 void ZeldaAudioRenderer::PrepareFrame()
 {
   if (m_prepared)
@@ -1378,8 +1483,6 @@ void ZeldaAudioRenderer::LoadInputSamples(MixingBuffer* buffer, VPB* vpb)
   // this practical limit (resampling_ratio = 0xFFFF -> 0x500 samples). Add a
   // margin of 4 that is needed for samples source that do resampling.
   std::array<s16, 0x500 + 4> raw_input_samples;
-  for (size_t i = 0; i < 4; ++i)
-    raw_input_samples[i] = vpb->resample_buffer[i];
 
   if (vpb->use_constant_sample)
   {
@@ -1387,6 +1490,9 @@ void ZeldaAudioRenderer::LoadInputSamples(MixingBuffer* buffer, VPB* vpb)
     return;
   }
 
+  for (size_t i = 0; i < 4; ++i)
+    raw_input_samples[i] = vpb->resample_buffer[i];
+
   switch (vpb->samples_source_type)
   {
   case VPB::SRC_SQUARE_WAVE:
@@ -1429,19 +1535,16 @@ void ZeldaAudioRenderer::LoadInputSamples(MixingBuffer* buffer, VPB* vpb)
   {
     const u16 PATTERN_SIZE = 0x40;
 
-    struct PatternInfo
-    {
-      u16 idx;
-      bool variable_step;
-    };
-    std::map<u16, PatternInfo> samples_source_to_pattern = {
-        {VPB::SRC_CONST_PATTERN_0, {0, false}}, {VPB::SRC_CONST_PATTERN_0_VARIABLE_STEP, {0, true}},
-        {VPB::SRC_CONST_PATTERN_1, {1, false}}, {VPB::SRC_CONST_PATTERN_2, {2, false}},
-        {VPB::SRC_CONST_PATTERN_3, {3, false}},
-    };
-    auto& pattern_info = samples_source_to_pattern[vpb->samples_source_type];
-    u16 pattern_offset = pattern_info.idx * PATTERN_SIZE;
-    s16* pattern = m_const_patterns.data() + pattern_offset;
+    u16 pattern_idx = 0;
+    if (vpb->samples_source_type == VPB::SRC_CONST_PATTERN_1)
+      pattern_idx = 1;
+    else if (vpb->samples_source_type == VPB::SRC_CONST_PATTERN_2)
+      pattern_idx = 2;
+    else if (vpb->samples_source_type == VPB::SRC_CONST_PATTERN_3)
+      pattern_idx = 3;
+    const bool variable_step =
+        vpb->samples_source_type == VPB::SRC_CONST_PATTERN_0_VARIABLE_STEP;
+    s16* pattern = m_const_patterns.data() + pattern_idx * PATTERN_SIZE;
 
     u32 pos = vpb->current_pos_frac << 6;   // log2(PATTERN_SIZE)
     u32 step = vpb->resampling_ratio << 5;  // FIXME: ucode 24B22038 shifts by 6 (?)
@@ -1450,7 +1553,7 @@ void ZeldaAudioRenderer::LoadInputSamples(MixingBuffer* buffer, VPB* vpb)
     {
       (*buffer)[i] = pattern[pos >> 16];
       pos = (pos + step) % (PATTERN_SIZE << 16);
-      if (pattern_info.variable_step)
+      if (variable_step)
         pos = ((pos << 10) + m_buf_back_right[i] * vpb->resampling_ratio) >> 10;
     }
 
@@ -1510,8 +1613,46 @@ void ZeldaAudioRenderer::Resample(VPB* vpb, const s16* src, MixingBuffer* dst)
   }
   else
   {
-    for (auto& dst_sample : *dst)
+    size_t i = 0;
+
+#ifdef _M_X86
+    if (m_resampling_coeffs_fit_simd)
     {
+      // Four samples at a time, with the taps of two samples in each register. PMADDWD leaves
+      // two partial sums a and b per sample, and the result is (2 * (a + b)) >> 16. That is
+      // computed as ((a >> 1) + (b >> 1) + (a & b & 1)) >> 14 so that the sum doesn't overflow.
+      const auto load_taps = [&](u32 sample_pos) {
+        const s16* coeffs = &m_resampling_coeffs[((sample_pos & 0xFFF) >> 6) * 4];
+        const s16* input = &src[sample_pos >> 12];
+        return _mm_madd_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(input)),
+                              _mm_loadl_epi64(reinterpret_cast<const __m128i*>(coeffs)));
+      };
+      const __m128i one = _mm_set1_epi32(1);
+      for (; i + 4 <= dst->size(); i += 4)
+      {
+        const __m128i sums_01 = _mm_unpacklo_epi64(load_taps(pos), load_taps(pos + ratio));
+        const __m128i sums_23 =
+            _mm_unpacklo_epi64(load_taps(pos + 2 * ratio), load_taps(pos + 3 * ratio));
+        pos += 4 * ratio;
+
+        const __m128i shuffled_01 = _mm_shuffle_epi32(sums_01, _MM_SHUFFLE(3, 1, 2, 0));
+        const __m128i shuffled_23 = _mm_shuffle_epi32(sums_23, _MM_SHUFFLE(3, 1, 2, 0));
+        const __m128i a = _mm_unpacklo_epi64(shuffled_01, shuffled_23);
+        const __m128i b = _mm_unpackhi_epi64(shuffled_01, shuffled_23);
+        const __m128i half_sum =
+            _mm_add_epi32(_mm_add_epi32(_mm_srai_epi32(a, 1), _mm_srai_epi32(b, 1)),
+                          _mm_and_si128(_mm_and_si128(a, b), one));
+        const __m128i samples = _mm_srai_epi32(half_sum, 14);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst->data() + i),
+                         _mm_packs_epi32(samples, samples));
+      }
+    }
+#endif
+
+    for (; i < dst->size(); ++i)
+    {
+      s16& dst_sample = (*dst)[i];
+
       // We have 0x40 * 4 coeffs that need to be selected based on the
       // most significant bits of the fractional part of the position. 12
       // bits >> 6 = 6 bits = 0x40. Multiply by 4 since there are 4
@@ -1521,8 +1662,8 @@ void ZeldaAudioRenderer::Resample(VPB* vpb, const s16* src, MixingBuffer* dst)
       const s16* input = &src[pos >> 12];
 
       s64 dst_sample_unclamped = 0;
-      for (size_t i = 0; i < 4; ++i)
-        dst_sample_unclamped += (s64)2 * coeffs[i] * input[i];
+      for (size_t j = 0; j < 4; ++j)
+        dst_sample_unclamped += (s64)2 * coeffs[j] * input[j];
       dst_sample_unclamped >>= 16;
 
       dst_sample = (s16)std::clamp<s64>(dst_sample_unclamped, -0x8000, 0x7FFF);
@@ -1537,6 +1678,18 @@ void ZeldaAudioRenderer::Resample(VPB* vpb, const s16* src, MixingBuffer* dst)
   vpb->current_pos_frac = pos & 0xFFF;
 }
 
+void ZeldaAudioRenderer::SetResamplingCoeffs(std::array<s16, 0x100>&& coeffs)
+{
+  m_resampling_coeffs = coeffs;
+  UpdateResamplingCoeffsFitSIMD();
+}
+
+void ZeldaAudioRenderer::UpdateResamplingCoeffsFitSIMD()
+{
+  m_resampling_coeffs_fit_simd = std::find(m_resampling_coeffs.begin(), m_resampling_coeffs.end(),
+                                           -0x8000) == m_resampling_coeffs.end();
+}
+
 void* ZeldaAudioRenderer::GetARAMPtr() const
 {
   if (m_aram_base_addr)
@@ -1757,10 +1910,13 @@ void ZeldaAudioRenderer::DecodeAFC(VPB* vpb, s16* dst, size_t block_count)
       }
     }
 
+    // Loaded once per block since dst could alias them as far as the compiler knows.
+    const s32 coef_yn1 = m_afc_coeffs[idx * 2];
+    const s32 coef_yn2 = m_afc_coeffs[idx * 2 + 1];
     s32 yn1 = *vpb->AFCYN1(), yn2 = *vpb->AFCYN2();
     for (s16 nibble : nibbles)
     {
-      s32 sample = delta * nibble + yn1 * m_afc_coeffs[idx * 2] + yn2 * m_afc_coeffs[idx * 2 + 1];
+      s32 sample = delta * nibble + yn1 * coef_yn1 + yn2 * coef_yn2;
       sample >>= 11;
       sample = std::clamp(sample, -0x8000, 0x7fff);
       *dst++ = (s16)sample;
@@ -1837,6 +1993,8 @@ void ZeldaAudioRenderer::DoState(PointerWrap& p)
   p.Do(m_buf_unk2);
 
   p.Do(m_resampling_coeffs);
+  if (p.GetMode() == PointerWrap::MODE_READ)
+    UpdateResamplingCoeffsFitSIMD();
   p.Do(m_const_patterns);
   p.Do(m_sine_table);
   p.Do(m_afc_coeffs);
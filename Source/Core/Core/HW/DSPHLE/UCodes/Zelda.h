@@ -24,7 +24,7 @@ public:
   void SetFlags(u32 flags) { m_flags = flags; }
   void SetSineTable(std::array<s16, 0x80>&& sine_table) { m_sine_table = sine_table; }
   void SetConstPatterns(std::array<s16, 0x100>&& patterns) { m_const_patterns = patterns; }
-  void SetResamplingCoeffs(std::array<s16, 0x100>&& coeffs) { m_resampling_coeffs = coeffs; }
+  void SetResamplingCoeffs(std::array<s16, 0x100>&& coeffs);
   void SetAfcCoeffs(std::array<s16, 0x20>&& coeffs) { m_afc_coeffs = coeffs; }
   void SetVPBBaseAddress(u32 addr) { m_vpb_base_addr = addr; }
   void SetReverbPBBaseAddress(u32 addr) { m_reverb_pb_base_addr = addr; }
@@ -40,21 +40,16 @@ private:
   // See Zelda.cpp for the list of possible flags.
   u32 m_flags;
 
-  // Utility functions for audio operations.
+  // Utility functions for audio operations. The buffer versions are vectorized in Zelda.cpp.
 
   // Apply volume to a buffer. The volume is a fixed point integer, usually
   // 1.15 or 4.12 in the DAC UCode.
   template <size_t N, size_t B>
   void ApplyVolumeInPlace(std::array<s16, N>* buf, u16 vol)
   {
-    for (size_t i = 0; i < N; ++i)
-    {
-      s32 tmp = (u32)(*buf)[i] * (u32)vol;
-      tmp >>= 16 - B;
-
-      (*buf)[i] = (s16)std::clamp(tmp, -0x8000, 0x7FFF);
-    }
+    ApplyVolumeInPlace(buf->data(), N, vol, 16 - B);
   }
+  static void ApplyVolumeInPlace(s16* buf, size_t count, u16 vol, u32 shift);
   template <size_t N>
   void ApplyVolumeInPlace_1_15(std::array<s16, N>* buf, u16 vol)
   {
@@ -78,25 +73,13 @@ private:
     if (!vol && !step)
       return vol;
 
-    for (size_t i = 0; i < N; ++i)
-    {
-      (*dst)[i] += ((vol >> 16) * src[i]) >> 16;
-      vol += step;
-    }
-
-    return vol;
+    return AddBuffersWithVolumeRamp(dst->data(), src.data(), N, vol, step);
   }
+  static s32 AddBuffersWithVolumeRamp(s16* dst, const s16* src, size_t count, s32 vol, s32 step);
 
   // Does not use std::array because it needs to be able to process partial
   // buffers. Volume is in 1.15 format.
-  void AddBuffersWithVolume(s16* dst, const s16* src, size_t count, u16 vol)
-  {
-    while (count--)
-    {
-      s32 vol_src = ((s32)*src++ * (s32)vol) >> 15;
-      *dst++ += std::clamp(vol_src, -0x8000, 0x7FFF);
-    }
-  }
+  static void AddBuffersWithVolume(s16* dst, const s16* src, size_t count, u16 vol);
 
   // Whether the frame needs to be prepared or not.
   bool m_prepared = false;
@@ -154,6 +137,10 @@ private:
 
   // Coefficients used for resampling.
   std::array<s16, 0x100> m_resampling_coeffs{};
+  // Whether the coefficients can be used with PMADDWD, which overflows when both of the products
+  // it adds are -0x8000 * -0x8000.
+  bool m_resampling_coeffs_fit_simd = true;
+  void UpdateResamplingCoeffsFitSIMD();
 
   // If non zero, base MRAM address for sound data transfers from ARAM. On
   // the Wii, this points to some MRAM location since there is no ARAM to be
@@ -15,6 +15,7 @@
 #include "Core/DSP/DSPCore.h"
 #include "Core/DSP/Jit/x64/DSPEmitter.h"
 #include "Core/HW/DSP.h"
+#include "Core/HW/DSPLLE/DSPLLE.h"
 #include "Core/HW/DSPLLE/DSPSymbols.h"
 #include "Core/Host.h"
 #include "VideoCommon/OnScreenDisplay.h"
@@ -28,22 +29,24 @@ namespace DSP::Host
 {
 u8 ReadHostMemory(u32 addr)
 {
+  LLE::WaitForHostMemoryAccess();
   return DSP::ReadARAM(addr);
 }
 
 void WriteHostMemory(u8 value, u32 addr)
 {
+  LLE::WaitForHostMemoryAccess();
   DSP::WriteARAM(value, addr);
 }
 
-void OSD_AddMessage(std::string str, u32 ms)
+void WaitForMemoryAccess()
 {
-  OSD::AddMessage(std::move(str), ms);
+  LLE::WaitForHostMemoryAccess();
 }
 
-bool OnThread()
+void OSD_AddMessage(std::string str, u32 ms)
 {
-  return SConfig::GetInstance().bDSPThread;
+  OSD::AddMessage(std::move(str), ms);
 }
 
 bool IsWiiHost()
@@ -54,7 +57,8 @@ bool IsWiiHost()
 void InterruptRequest()
 {
   // Fire an interrupt on the PPC ASAP.
-  DSP::GenerateDSPInterruptFromDSPEmu(DSP::INT_DSP);
+  if (!LLE::DeferInterruptRequest())
+    DSP::GenerateDSPInterruptFromDSPEmu(DSP::INT_DSP);
 }
 
 void CodeLoaded(const u8* ptr, int size)
@@ -4,18 +4,20 @@
 
 #include "Core/HW/DSPLLE/DSPLLE.h"
 
+#include <condition_variable>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <utility>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonPaths.h"
 #include "Common/CommonTypes.h"
-#include "Common/Event.h"
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
 #include "Common/MemoryUtil.h"
 #include "Common/Thread.h"
+#include "Common/Trace.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/DSP/DSPAccelerator.h"
@@ -26,22 +28,37 @@
 #include "Core/DSP/DSPTables.h"
 #include "Core/DSP/Interpreter/DSPInterpreter.h"
 #include "Core/DSP/Jit/DSPEmitterBase.h"
+#include "Core/HW/DSP.h"
 #include "Core/HW/DSPLLE/DSPLLEGlobals.h"
 #include "Core/HW/Memmap.h"
 #include "Core/Host.h"
 
 namespace DSP::LLE
 {
-static Common::Event s_dsp_event;
-static Common::Event s_ppc_event;
-static bool s_request_disable_thread;
+// On the DSP thread, DSP_Update hands each slice of cycles to the thread instead of running it,
+// and the CPU carries on until its next synchronization point: the next DSP_Update, or any access
+// to the mailboxes or the control register. There it waits for the slice to finish, so the CPU
+// only ever sees the DSP at slice boundaries, exactly like when the slice runs inline.
+static bool s_is_dsp_on_thread;
+static std::mutex s_thread_mutex;
+// Wakes the DSP thread for a new slice, for the CPU reaching a synchronization point, or to exit.
+static std::condition_variable s_dsp_wakeup;
+static std::condition_variable s_slice_done;
+// Cycles of the slice in flight, zero when the DSP thread is idle.
+static int s_slice_cycles;
+static bool s_cpu_waiting;
+static bool s_dsp_waiting_for_cpu;
+static bool s_shutdown;
+static u32 s_pending_interrupts;
+// Only touched by the thread that runs the DSP. Always set when the DSP runs inline.
+static bool s_host_memory_accessible = true;
 
 DSPLLE::DSPLLE() = default;
 
 DSPLLE::~DSPLLE()
 {
+  StopDSPThread();
   DSPCore_Shutdown();
-  DSP_StopSoundStream();
 }
 
 void DSPLLE::DoState(PointerWrap& p)
@@ -82,43 +99,109 @@ void DSPLLE::DoState(PointerWrap& p)
     Host::CodeLoaded((const u8*)g_dsp.iram, DSP_IRAM_BYTE_SIZE);
   p.DoArray(g_dsp.dram, DSP_DRAM_SIZE);
   p.Do(g_init_hax);
-  p.Do(m_cycle_count);
+  // Savestates can't hold a slice in flight, so it has to be finished here. If it was waiting to
+  // access memory, that happens at this point rather than at the CPU's next synchronization
+  // point, so saving a state is the one thing that can change the result of the emulation.
+  WaitForDSPThread();
+  p.Do(s_pending_interrupts);
 
   if (g_dsp_jit)
     g_dsp_jit->DoState(p);
 }
 
-// Regular thread
-void DSPLLE::DSPThread(DSPLLE* dsp_lle)
+void DSPLLE::DSPThread()
 {
   Common::SetCurrentThreadName("DSP thread");
 
-  while (dsp_lle->m_is_running.IsSet())
+  std::unique_lock lock(s_thread_mutex);
+  while (true)
   {
-    const int cycles = static_cast<int>(dsp_lle->m_cycle_count.load());
-    if (cycles > 0)
+    s_dsp_wakeup.wait(lock, [] { return s_slice_cycles != 0 || s_shutdown; });
+    if (s_shutdown)
+      break;
+
+    const int cycles = s_slice_cycles;
+    lock.unlock();
+
+    s_host_memory_accessible = false;
     {
-      std::unique_lock dsp_thread_lock(dsp_lle->m_dsp_thread_mutex, std::try_to_lock);
-      if (dsp_thread_lock)
-      {
-        if (g_dsp_jit)
-        {
-          DSPCore_RunCycles(cycles);
-        }
-        else
-        {
-          DSP::Interpreter::RunCyclesThread(cycles);
-        }
-        dsp_lle->m_cycle_count.store(0);
-        continue;
-      }
+      TRACE_SCOPE("DSPLLE slice");
+      DSPCore_RunCycles(cycles);
     }
 
-    s_ppc_event.Set();
-    s_dsp_event.Wait();
+    lock.lock();
+    s_slice_cycles = 0;
+    // The CPU thread and PauseAndLock can both be waiting.
+    s_slice_done.notify_all();
   }
 }
 
+void DSPLLE::StopDSPThread()
+{
+  if (!s_is_dsp_on_thread)
+    return;
+
+  {
+    std::lock_guard guard(s_thread_mutex);
+    s_shutdown = true;
+  }
+  s_dsp_wakeup.notify_one();
+  m_dsp_thread.join();
+  s_is_dsp_on_thread = false;
+  s_host_memory_accessible = true;
+}
+
+void DSPLLE::WaitForDSPThread()
+{
+  if (!s_is_dsp_on_thread)
+    return;
+
+  std::unique_lock lock(s_thread_mutex);
+  if (s_slice_cycles == 0)
+    return;
+
+  s_cpu_waiting = true;
+  if (s_dsp_waiting_for_cpu)
+    s_dsp_wakeup.notify_one();
+  s_slice_done.wait(lock, [] { return s_slice_cycles == 0; });
+  s_cpu_waiting = false;
+}
+
+void DSPLLE::SyncWithDSPThread()
+{
+  if (!s_is_dsp_on_thread)
+    return;
+
+  WaitForDSPThread();
+  for (u32 i = std::exchange(s_pending_interrupts, 0); i != 0; i--)
+    DSP::GenerateDSPInterruptFromDSPEmu(DSP::INT_DSP);
+}
+
+void WaitForHostMemoryAccess()
+{
+  if (s_host_memory_accessible)
+    return;
+
+  std::unique_lock lock(s_thread_mutex);
+  s_dsp_waiting_for_cpu = true;
+  s_slice_done.notify_all();
+  s_dsp_wakeup.wait(lock, [] { return s_cpu_waiting || s_shutdown; });
+  s_dsp_waiting_for_cpu = false;
+
+  // The CPU stays blocked until the slice is done, so there's no need to wait again.
+  s_host_memory_accessible = true;
+}
+
+bool DeferInterruptRequest()
+{
+  if (!s_is_dsp_on_thread)
+    return false;
+
+  std::lock_guard guard(s_thread_mutex);
+  s_pending_interrupts++;
+  return true;
+}
+
 static bool LoadDSPRom(u16* rom, const std::string& filename, u32 size_in_bytes)
 {
   std::string bytes;
@@ -171,20 +254,14 @@ static bool FillDSPInitOptions(DSPInitOptions* opts)
 
 bool DSPLLE::Initialize(bool wii, bool dsp_thread)
 {
-  s_request_disable_thread = false;
-
   DSPInitOptions opts;
   if (!FillDSPInitOptions(&opts))
     return false;
   if (!DSPCore_Init(opts))
     return false;
 
-  // needs to be after DSPCore_Init for the dspjit ptr
-  if (Core::WantsDeterminism() || !g_dsp_jit)
-    dsp_thread = false;
-
   m_wii = wii;
-  m_is_dsp_on_thread = dsp_thread;
+  s_is_dsp_on_thread = dsp_thread;
 
   // DSPLLE directly accesses the fastmem arena.
   // TODO: The fastmem arena is only supposed to be used by the JIT:
@@ -196,8 +273,12 @@ bool DSPLLE::Initialize(bool wii, bool dsp_thread)
 
   if (dsp_thread)
   {
-    m_is_running.Set(true);
-    m_dsp_thread = std::thread(DSPThread, this);
+    s_slice_cycles = 0;
+    s_cpu_waiting = false;
+    s_dsp_waiting_for_cpu = false;
+    s_shutdown = false;
+    s_pending_interrupts = 0;
+    m_dsp_thread = std::thread(DSPThread);
   }
 
   Host_RefreshDSPDebuggerWindow();
@@ -206,39 +287,24 @@ bool DSPLLE::Initialize(bool wii, bool dsp_thread)
 
 void DSPLLE::DSP_StopSoundStream()
 {
-  if (m_is_dsp_on_thread)
-  {
-    m_is_running.Clear();
-    s_ppc_event.Set();
-    s_dsp_event.Set();
-    m_dsp_thread.join();
-  }
+  StopDSPThread();
 }
 
 void DSPLLE::Shutdown()
 {
+  StopDSPThread();
   DSPCore_Shutdown();
 }
 
 u16 DSPLLE::DSP_WriteControlRegister(u16 value)
 {
+  SyncWithDSPThread();
   DSP::Interpreter::WriteCR(value);
 
   if (value & 2)
   {
-    if (!m_is_dsp_on_thread)
-    {
-      DSPCore_CheckExternalInterrupt();
-      DSPCore_CheckExceptions();
-    }
-    else
-    {
-      // External interrupt pending: this is the zelda ucode.
-      // Disable the DSP thread because there is no performance gain.
-      s_request_disable_thread = true;
-
-      DSPCore_SetExternalInterrupt(true);
-    }
+    DSPCore_CheckExternalInterrupt();
+    DSPCore_CheckExceptions();
   }
 
   return DSP::Interpreter::ReadCR();
@@ -246,21 +312,25 @@ u16 DSPLLE::DSP_WriteControlRegister(u16 value)
 
 u16 DSPLLE::DSP_ReadControlRegister()
 {
+  SyncWithDSPThread();
   return DSP::Interpreter::ReadCR();
 }
 
 u16 DSPLLE::DSP_ReadMailBoxHigh(bool cpu_mailbox)
 {
+  SyncWithDSPThread();
   return gdsp_mbox_read_h(cpu_mailbox ? MAILBOX_CPU : MAILBOX_DSP);
 }
 
 u16 DSPLLE::DSP_ReadMailBoxLow(bool cpu_mailbox)
 {
+  SyncWithDSPThread();
   return gdsp_mbox_read_l(cpu_mailbox ? MAILBOX_CPU : MAILBOX_DSP);
 }
 
 void DSPLLE::DSP_WriteMailBoxHigh(bool cpu_mailbox, u16 value)
 {
+  SyncWithDSPThread();
   if (cpu_mailbox)
   {
     if (gdsp_mbox_peek(MAILBOX_CPU) & 0x80000000)
@@ -286,6 +356,7 @@ void DSPLLE::DSP_WriteMailBoxHigh(bool cpu_mailbox, u16 value)
 
 void DSPLLE::DSP_WriteMailBoxLow(bool cpu_mailbox, u16 value)
 {
+  SyncWithDSPThread();
   if (cpu_mailbox)
   {
     gdsp_mbox_write_l(MAILBOX_CPU, value);
@@ -303,30 +374,21 @@ void DSPLLE::DSP_Update(int cycles)
   if (dsp_cycles <= 0)
     return;
 
-  if (m_is_dsp_on_thread)
-  {
-    if (s_request_disable_thread || Core::WantsDeterminism())
-    {
-      DSP_StopSoundStream();
-      m_is_dsp_on_thread = false;
-      s_request_disable_thread = false;
-      SConfig::GetInstance().bDSPThread = false;
-    }
-  }
-
   // If we're not on a thread, run cycles here.
-  if (!m_is_dsp_on_thread)
+  if (!s_is_dsp_on_thread)
   {
     // ~1/6th as many cycles as the period PPC-side.
+    TRACE_SCOPE("DSPLLE slice");
     DSPCore_RunCycles(dsp_cycles);
+    return;
   }
-  else
+
+  SyncWithDSPThread();
   {
-    // Wait for DSP thread to complete its cycle. Note: this logic should be thought through.
-    s_ppc_event.Wait();
-    m_cycle_count.fetch_add(dsp_cycles);
-    s_dsp_event.Set();
+    std::lock_guard guard(s_thread_mutex);
+    s_slice_cycles = dsp_cycles;
   }
+  s_dsp_wakeup.notify_one();
 }
 
 u32 DSPLLE::DSP_UpdateRate()
@@ -336,20 +398,12 @@ u32 DSPLLE::DSP_UpdateRate()
 
 void DSPLLE::PauseAndLock(bool do_lock, bool unpause_on_unlock)
 {
-  if (do_lock)
-  {
-    m_dsp_thread_mutex.lock();
-  }
-  else
-  {
-    m_dsp_thread_mutex.unlock();
+  if (!do_lock || !s_is_dsp_on_thread)
+    return;
 
-    if (m_is_dsp_on_thread)
-    {
-      // Signal the DSP thread so it can perform any outstanding work now (if any)
-      s_ppc_event.Wait();
-      s_dsp_event.Set();
-    }
-  }
+  // Let the slice in flight run until it is done, or until it needs the CPU to reach its next
+  // synchronization point, which won't happen before emulation resumes.
+  std::unique_lock lock(s_thread_mutex);
+  s_slice_done.wait(lock, [] { return s_slice_cycles == 0 || s_dsp_waiting_for_cpu; });
 }
 }  // namespace DSP::LLE
@@ -4,12 +4,9 @@
 
 #pragma once
 
-#include <atomic>
-#include <mutex>
 #include <thread>
 
 #include "Common/CommonTypes.h"
-#include "Common/Flag.h"
 #include "Core/DSPEmulator.h"
 
 class PointerWrap;
@@ -39,12 +36,22 @@ public:
   u32 DSP_UpdateRate() override;
 
 private:
-  static void DSPThread(DSPLLE* dsp_lle);
+  static void DSPThread();
+
+  void StopDSPThread();
+  // Blocks until the DSP thread has finished the slice it was last given. While the CPU waits,
+  // the DSP thread may access memory shared with the CPU.
+  void WaitForDSPThread();
+  // Waits for the DSP thread and raises any interrupts it requested. Only for the CPU thread.
+  void SyncWithDSPThread();
 
   std::thread m_dsp_thread;
-  std::mutex m_dsp_thread_mutex;
-  bool m_is_dsp_on_thread = false;
-  Common::Flag m_is_running;
-  std::atomic<u32> m_cycle_count{};
 };
+
+// Hooks for the DSP::Host implementation. When the DSP runs on its own thread, a slice may only
+// touch memory that the CPU can write, that is main RAM and ARAM, once the CPU has reached its
+// next synchronization point with the DSP. Interrupts are held until then as well, so that they
+// reach the CPU at the same point of emulated time on every run.
+void WaitForHostMemoryAccess();
+bool DeferInterruptRequest();
 }  // namespace DSP::LLE
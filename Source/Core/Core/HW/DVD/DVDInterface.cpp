@@ -5,7 +5,9 @@
 #include "Core/HW/DVD/DVDInterface.h"
 
 #include <algorithm>
+#include <array>
 #include <cinttypes>
+#include <cstring>
 #include <memory>
 #include <optional>
 #include <string>
@@ -60,6 +62,12 @@ constexpr u64 DVD_ECC_BLOCK_SIZE = 16 * DVD_SECTOR_SIZE;
 // is already buffered. Measured in bytes per second.
 constexpr u64 BUFFER_TRANSFER_RATE = 32 * 1024 * 1024;
 
+// With FastBulkDiscReads, reads of at least this many bytes act as if they were buffered...
+constexpr u32 BULK_READ_MIN_LENGTH = 0x40000;
+// ...once this many seconds of emulated time have passed. Until then, the IPL, the apploader and
+// the game's startup code, which are what tends to race against the drive, get accurate timing.
+constexpr u64 BULK_READ_MIN_UPTIME_SECONDS = 10;
+
 namespace DVDInterface
 {
 // internal hardware addresses
@@ -146,8 +154,6 @@ static UDICR s_DICR;
 static u32 s_DIIMMBUF;
 static UDICFG s_DICFG;
 
-static StreamADPCM::ADPCMDecoder s_adpcm_decoder;
-
 // DTK
 static bool s_stream = false;
 static bool s_stop_at_track_end = false;
@@ -157,6 +163,8 @@ static u32 s_current_length;
 static u64 s_next_start;
 static u32 s_next_length;
 static u32 s_pending_samples;
+// The ADPCM decoder lives on the DVD thread, so resetting its filter waits for the next read
+static bool s_reset_dtk_filter = false;
 static bool s_can_configure_dtk = true;
 static bool s_enable_dtk = false;
 static u8 s_dtk_buffer_length = 0;  // TODO: figure out how this affects the regular buffer
@@ -219,6 +227,7 @@ void DoState(PointerWrap& p)
   p.Do(s_next_start);
   p.Do(s_next_length);
   p.Do(s_pending_samples);
+  p.Do(s_reset_dtk_filter);
   p.Do(s_can_configure_dtk);
   p.Do(s_enable_dtk);
   p.Do(s_dtk_buffer_length);
@@ -233,27 +242,6 @@ void DoState(PointerWrap& p)
   p.Do(s_disc_path_to_insert);
 
   DVDThread::DoState(p);
-
-  s_adpcm_decoder.DoState(p);
-}
-
-static size_t ProcessDTKSamples(std::vector<s16>* temp_pcm, const std::vector<u8>& audio_data)
-{
-  size_t samples_processed = 0;
-  size_t bytes_processed = 0;
-  while (samples_processed < temp_pcm->size() / 2 && bytes_processed < audio_data.size())
-  {
-    s_adpcm_decoder.DecodeBlock(&(*temp_pcm)[samples_processed * 2], &audio_data[bytes_processed]);
-    for (size_t i = 0; i < StreamADPCM::SAMPLES_PER_BLOCK * 2; ++i)
-    {
-      // TODO: Fix the mixer so it can accept non-byte-swapped samples.
-      s16* sample = &(*temp_pcm)[samples_processed * 2 + i];
-      *sample = Common::swap16(*sample);
-    }
-    samples_processed += StreamADPCM::SAMPLES_PER_BLOCK;
-    bytes_processed += StreamADPCM::ONE_BLOCK_SIZE;
-  }
-  return samples_processed;
 }
 
 static u32 AdvanceDTK(u32 maximum_samples, u32* samples_to_process)
@@ -280,7 +268,7 @@ static u32 AdvanceDTK(u32 maximum_samples, u32* samples_to_process)
         break;
       }
 
-      s_adpcm_decoder.ResetFilter();
+      s_reset_dtk_filter = true;
     }
 
     s_audio_position += StreamADPCM::ONE_BLOCK_SIZE;
@@ -295,15 +283,17 @@ static void DTKStreamingCallback(DIInterruptType interrupt_type, const std::vect
                                  s64 cycles_late)
 {
   // Determine which audio data to read next.
-  static const int MAXIMUM_SAMPLES = 48000 / 2000 * 7;  // 3.5ms of 48kHz samples
+  static constexpr u32 MAXIMUM_SAMPLES = 48000 / 2000 * 7;  // 3.5ms of 48kHz samples
   u64 read_offset = 0;
   u32 read_length = 0;
 
   if (interrupt_type == DIInterruptType::TCINT)
   {
-    // Send audio to the mixer.
-    std::vector<s16> temp_pcm(s_pending_samples * 2, 0);
-    ProcessDTKSamples(&temp_pcm, audio_data);
+    // Send audio to the mixer. The DVD thread has already decoded it to PCM, and if there was
+    // nothing to read, audio_data is empty and we send silence.
+    std::array<s16, MAXIMUM_SAMPLES * 2> temp_pcm{};
+    std::memcpy(temp_pcm.data(), audio_data.data(),
+                std::min<size_t>(audio_data.size(), s_pending_samples * 2 * sizeof(s16)));
     g_sound_stream->GetMixer()->PushStreamingSamples(temp_pcm.data(), s_pending_samples);
 
     if (s_stream && AudioInterface::IsPlaying())
@@ -328,8 +318,8 @@ static void DTKStreamingCallback(DIInterruptType interrupt_type, const std::vect
   ticks_to_dtk -= cycles_late;
   if (read_length > 0)
   {
-    DVDThread::StartRead(read_offset, read_length, DiscIO::PARTITION_NONE, ReplyType::DTK,
-                         ticks_to_dtk);
+    DVDThread::StartDTKRead(read_offset, read_length, s_reset_dtk_filter, ticks_to_dtk);
+    s_reset_dtk_filter = false;
   }
   else
   {
@@ -383,6 +373,7 @@ void Reset(bool spinup)
   s_current_start = 0;
   s_current_length = 0;
   s_pending_samples = 0;
+  s_reset_dtk_filter = false;
   s_can_configure_dtk = true;
   s_enable_dtk = false;
   s_dtk_buffer_length = 0;
@@ -474,7 +465,7 @@ static void EjectDiscCallback(u64 userdata, s64 cyclesLate)
 
 static void InsertDiscCallback(u64 userdata, s64 cyclesLate)
 {
-  std::unique_ptr<DiscIO::VolumeDisc> new_disc = DiscIO::CreateDisc(s_disc_path_to_insert);
+  std::unique_ptr<DiscIO::VolumeDisc> new_disc = DiscIO::CreateCachedDisc(s_disc_path_to_insert);
 
   if (new_disc)
     SetDisc(std::move(new_disc), {});
@@ -1021,7 +1012,7 @@ void ExecuteCommand(ReplyType reply_type)
           s_current_start = s_next_start;
           s_current_length = s_next_length;
           s_audio_position = s_current_start;
-          s_adpcm_decoder.ResetFilter();
+          s_reset_dtk_filter = true;
           s_stream = true;
         }
       }
@@ -1321,7 +1312,13 @@ void ScheduleReads(u64 offset, u32 length, const DiscIO::Partition& partition, u
   u64 dvd_offset = DVDThread::PartitionOffsetToRawOffset(offset, partition);
   dvd_offset = Common::AlignDown(dvd_offset, DVD_ECC_BLOCK_SIZE);
 
-  if (SConfig::GetInstance().bFastDiscSpeed)
+  // Small reads are the ones that streaming code tends to issue and time itself against, and
+  // large ones are usually a loading screen waiting for the data, so only the latter are sped up
+  const bool fast_bulk_read =
+      SConfig::GetInstance().bFastBulkDiscReads && length >= BULK_READ_MIN_LENGTH &&
+      current_time >= BULK_READ_MIN_UPTIME_SECONDS * ticks_per_second;
+
+  if (SConfig::GetInstance().bFastDiscSpeed || fast_bulk_read)
   {
     // The SUDTR setting makes us act as if all reads are buffered
     buffer_start = std::numeric_limits<u64>::min();
@@ -1460,14 +1457,17 @@ void ScheduleReads(u64 offset, u32 length, const DiscIO::Partition& partition, u
   // buffer start we calculate here is not the actual start of the buffer -
   // it is just the start of the portion we need to read.
   const u64 last_block = dvd_offset;
-  if (last_block == buffer_start + DVD_ECC_BLOCK_SIZE && buffer_start != buffer_end)
+  if (last_block == buffer_start + DVD_ECC_BLOCK_SIZE && buffer_start != buffer_end &&
+      !fast_bulk_read)
   {
     // Special case: reading less than one block at the start of the
     // buffer won't change the buffer state
   }
   else
   {
-    if (last_block >= buffer_end)
+    // A fast bulk read pretends that everything was buffered, but the reads after it can still be
+    // accurate, so the drive is left as if it had just read up to last_block
+    if (last_block >= buffer_end || fast_bulk_read)
       // Full buffer read
       s_read_buffer_start_offset = last_block;
     else
@@ -4,7 +4,9 @@
 
 #include "Core/HW/DVD/DVDThread.h"
 
+#include <array>
 #include <cinttypes>
+#include <cstring>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -20,8 +22,10 @@
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/SPSCQueue.h"
+#include "Common/Swap.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
+#include "Common/Trace.h"
 
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
@@ -29,6 +33,7 @@
 #include "Core/HW/DVD/DVDInterface.h"
 #include "Core/HW/DVD/FileMonitor.h"
 #include "Core/HW/Memmap.h"
+#include "Core/HW/StreamADPCM.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/IOS/ES/Formats.h"
 
@@ -50,6 +55,9 @@ struct ReadRequest
   // because function pointers can't be stored in savestates.
   DVDInterface::ReplyType reply_type;
 
+  // Only used for DVDInterface::ReplyType::DTK
+  bool reset_dtk_filter;
+
   // IDs are used to uniquely identify a request. They must not be
   // identical to IDs of any other requests that currently exist, but
   // it's fine to re-use IDs of requests that have existed in the past.
@@ -71,7 +79,9 @@ static void WaitUntilIdle();
 
 static void StartReadInternal(bool copy_to_ram, u32 output_address, u64 dvd_offset, u32 length,
                               const DiscIO::Partition& partition,
-                              DVDInterface::ReplyType reply_type, s64 ticks_until_completion);
+                              DVDInterface::ReplyType reply_type, s64 ticks_until_completion,
+                              bool reset_dtk_filter);
+static std::vector<u8> DecodeDTK(const std::vector<u8>& adpcm_data, bool reset_filter);
 
 static void FinishRead(u64 id, s64 cycles_late);
 static CoreTiming::EventType* s_finish_read;
@@ -89,6 +99,9 @@ static std::map<u64, ReadResult> s_result_map;
 
 static std::unique_ptr<DiscIO::Volume> s_disc;
 
+// Only used by the DVD thread, and by DoState while the DVD thread is stopped
+static StreamADPCM::ADPCMDecoder s_dtk_decoder;
+
 void Start()
 {
   s_finish_read = CoreTiming::RegisterEvent("FinishReadDVDThread", FinishRead);
@@ -164,6 +177,8 @@ void DoState(PointerWrap& p)
       s_disc.reset();
   }
 
+  s_dtk_decoder.DoState(p);
+
   // TODO: Savestates can be smaller if the buffers of results aren't saved,
   // but instead get re-read from the disc when loading the savestate.
 
@@ -258,7 +273,14 @@ void WaitUntilIdle()
 void StartRead(u64 dvd_offset, u32 length, const DiscIO::Partition& partition,
                DVDInterface::ReplyType reply_type, s64 ticks_until_completion)
 {
-  StartReadInternal(false, 0, dvd_offset, length, partition, reply_type, ticks_until_completion);
+  StartReadInternal(false, 0, dvd_offset, length, partition, reply_type, ticks_until_completion,
+                    false);
+}
+
+void StartDTKRead(u64 dvd_offset, u32 length, bool reset_filter, s64 ticks_until_completion)
+{
+  StartReadInternal(false, 0, dvd_offset, length, DiscIO::PARTITION_NONE,
+                    DVDInterface::ReplyType::DTK, ticks_until_completion, reset_filter);
 }
 
 void StartReadToEmulatedRAM(u32 output_address, u64 dvd_offset, u32 length,
@@ -266,12 +288,13 @@ void StartReadToEmulatedRAM(u32 output_address, u64 dvd_offset, u32 length,
                             s64 ticks_until_completion)
 {
   StartReadInternal(true, output_address, dvd_offset, length, partition, reply_type,
-                    ticks_until_completion);
+                    ticks_until_completion, false);
 }
 
 static void StartReadInternal(bool copy_to_ram, u32 output_address, u64 dvd_offset, u32 length,
                               const DiscIO::Partition& partition,
-                              DVDInterface::ReplyType reply_type, s64 ticks_until_completion)
+                              DVDInterface::ReplyType reply_type, s64 ticks_until_completion,
+                              bool reset_dtk_filter)
 {
   ASSERT(Core::IsCPUThread());
 
@@ -283,6 +306,7 @@ static void StartReadInternal(bool copy_to_ram, u32 output_address, u64 dvd_offs
   request.length = length;
   request.partition = partition;
   request.reply_type = reply_type;
+  request.reset_dtk_filter = reset_dtk_filter;
 
   u64 id = s_next_id++;
   request.id = id;
@@ -342,8 +366,13 @@ static void FinishRead(u64 id, s64 cycles_late)
             (CoreTiming::GetTicks() - request.time_started_ticks) /
                 (SystemTimers::GetTicksPerSecond() / 1000000));
 
+  // DTK audio has been decoded, so its size doesn't match the size that was read
+  const bool read_failed = request.reply_type == DVDInterface::ReplyType::DTK ?
+                               buffer.empty() :
+                               buffer.size() != request.length;
+
   DVDInterface::DIInterruptType interrupt;
-  if (buffer.size() != request.length)
+  if (read_failed)
   {
     PanicAlertT("The disc could not be read (at 0x%" PRIx64 " - 0x%" PRIx64 ").",
                 request.dvd_offset, request.dvd_offset + request.length);
@@ -363,6 +392,29 @@ static void FinishRead(u64 id, s64 cycles_late)
   DVDInterface::FinishExecutingCommand(request.reply_type, interrupt, cycles_late, buffer);
 }
 
+static std::vector<u8> DecodeDTK(const std::vector<u8>& adpcm_data, bool reset_filter)
+{
+  if (reset_filter)
+    s_dtk_decoder.ResetFilter();
+
+  const size_t blocks = adpcm_data.size() / StreamADPCM::ONE_BLOCK_SIZE;
+  std::vector<u8> pcm_data(blocks * StreamADPCM::SAMPLES_PER_BLOCK * 2 * sizeof(s16));
+
+  for (size_t i = 0; i < blocks; ++i)
+  {
+    std::array<s16, StreamADPCM::SAMPLES_PER_BLOCK * 2> pcm;
+    s_dtk_decoder.DecodeBlock(pcm.data(), &adpcm_data[i * StreamADPCM::ONE_BLOCK_SIZE]);
+
+    // TODO: Fix the mixer so it can accept non-byte-swapped samples.
+    for (s16& sample : pcm)
+      sample = Common::swap16(sample);
+
+    std::memcpy(&pcm_data[i * sizeof(pcm)], pcm.data(), sizeof(pcm));
+  }
+
+  return pcm_data;
+}
+
 static void DVDThread()
 {
   Common::SetCurrentThreadName("DVD thread");
@@ -379,9 +431,12 @@ static void DVDThread()
     {
       FileMonitor::Log(*s_disc, request.partition, request.dvd_offset);
 
+      TRACE_SCOPE("DVDThread read");
       std::vector<u8> buffer(request.length);
       if (!s_disc->Read(request.dvd_offset, request.length, buffer.data(), request.partition))
         buffer.resize(0);
+      else if (request.reply_type == DVDInterface::ReplyType::DTK)
+        buffer = DecodeDTK(buffer, request.reset_dtk_filter);
 
       request.realtime_done_us = Common::Timer::GetTimeUs();
 
@@ -57,6 +57,9 @@ bool UpdateRunningGameMetadata(const DiscIO::Partition& partition,
 
 void StartRead(u64 dvd_offset, u32 length, const DiscIO::Partition& partition,
                DVDInterface::ReplyType reply_type, s64 ticks_until_completion);
+// Reads DTK audio and decodes it to PCM on the DVD thread, after resetting the ADPCM filter if
+// reset_filter is true. The result is passed to DVDInterface as byteswapped stereo s16 samples.
+void StartDTKRead(u64 dvd_offset, u32 length, bool reset_filter, s64 ticks_until_completion);
 void StartReadToEmulatedRAM(u32 output_address, u64 dvd_offset, u32 length,
                             const DiscIO::Partition& partition, DVDInterface::ReplyType reply_type,
                             s64 ticks_until_completion);
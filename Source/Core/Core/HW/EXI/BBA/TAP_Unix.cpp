@@ -10,6 +10,8 @@
 
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
+#include "Core/CoreTiming.h"
+#include "Core/HW/EXI/EXI.h"
 #include "Core/HW/EXI/EXI_Device.h"
 #include "Core/HW/EXI/EXI_DeviceEthernet.h"
 
@@ -125,32 +127,53 @@ bool CEXIETHERNET::TAPNetworkInterface::SendFrame(const u8* frame, u32 size)
 }
 
 #ifdef __linux__
+// Frames that arrive in a burst are written to the receive ring one after the other and signaled
+// with a single interrupt update, rather than waking up the CPU thread for each of them.
+constexpr int MAX_FRAMES_PER_WAKEUP = 32;
+
+static bool WaitForFrame(int fd, long timeout_us)
+{
+  fd_set rfds;
+  FD_ZERO(&rfds);
+  FD_SET(fd, &rfds);
+
+  struct timeval timeout;
+  timeout.tv_sec = 0;
+  timeout.tv_usec = timeout_us;
+  return select(fd + 1, &rfds, nullptr, nullptr, &timeout) > 0;
+}
+
 void CEXIETHERNET::TAPNetworkInterface::ReadThreadHandler(TAPNetworkInterface* self)
 {
   while (!self->readThreadShutdown.IsSet())
   {
-    fd_set rfds;
-    FD_ZERO(&rfds);
-    FD_SET(self->fd, &rfds);
-
-    struct timeval timeout;
-    timeout.tv_sec = 0;
-    timeout.tv_usec = 50000;
-    if (select(self->fd + 1, &rfds, nullptr, nullptr, &timeout) <= 0)
+    if (!WaitForFrame(self->fd, 50000))
       continue;
 
-    int readBytes = read(self->fd, self->m_eth_ref->mRecvBuffer.get(), BBA_RECV_SIZE);
-    if (readBytes < 0)
-    {
-      ERROR_LOG(SP1, "Failed to read from BBA, err=%d", readBytes);
-    }
-    else if (self->readEnabled.IsSet())
+    bool received = false;
+    for (int i = 0; i < MAX_FRAMES_PER_WAKEUP; ++i)
     {
-      DEBUG_LOG(SP1, "Read data: %s",
-                ArrayToString(self->m_eth_ref->mRecvBuffer.get(), readBytes, 0x10).c_str());
-      self->m_eth_ref->mRecvBufferLength = readBytes;
-      self->m_eth_ref->RecvHandlePacket();
+      if (i != 0 && !WaitForFrame(self->fd, 0))
+        break;
+
+      int readBytes = read(self->fd, self->m_eth_ref->mRecvBuffer.get(), BBA_RECV_SIZE);
+      if (readBytes < 0)
+      {
+        ERROR_LOG(SP1, "Failed to read from BBA, err=%d", readBytes);
+        break;
+      }
+      else if (self->readEnabled.IsSet())
+      {
+        DEBUG_LOG(SP1, "Read data: %s",
+                  ArrayToString(self->m_eth_ref->mRecvBuffer.get(), readBytes, 0x10).c_str());
+        self->m_eth_ref->mRecvBufferLength = readBytes;
+        self->m_eth_ref->RecvHandlePacket(false);
+        received = true;
+      }
     }
+
+    if (received)
+      ExpansionInterface::ScheduleUpdateInterrupts(CoreTiming::FromThread::NON_CPU, 0);
   }
 }
 #endif
@@ -105,7 +105,8 @@ void Init()
   g_Channels[2]->AddDevice(EXIDEVICE_AD16, 0);
 
   changeDevice = CoreTiming::RegisterEvent("ChangeEXIDevice", ChangeDeviceCallback);
-  updateInterrupts = CoreTiming::RegisterEvent("EXIUpdateInterrupts", UpdateInterruptsCallback);
+  updateInterrupts =
+      CoreTiming::RegisterEvent("EXIUpdateInterrupts", UpdateInterruptsCallback, true);
 }
 
 void Shutdown()
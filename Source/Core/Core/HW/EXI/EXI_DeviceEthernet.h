@@ -300,7 +300,9 @@ private:
   u8 HashIndex(const u8* dest_eth_addr);
   bool RecvMACFilter();
   void inc_rwp();
-  bool RecvHandlePacket();
+  // Writes mRecvBuffer to the receive ring. Backends that hand over several frames at once can
+  // pass false for update_interrupts and call ScheduleUpdateInterrupts once after the last frame.
+  bool RecvHandlePacket(bool update_interrupts = true);
 
   std::unique_ptr<u8[]> mBbaMem;
   std::unique_ptr<u8[]> tx_fifo;
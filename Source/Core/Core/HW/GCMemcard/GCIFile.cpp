@@ -101,5 +101,9 @@ void GCIFile::DoState(PointerWrap& p)
     p.DoPOD<GCMBlock>(*itr);
   }
   p.Do(m_used_blocks);
+
+  // The file may not match the loaded data anymore
+  if (p.GetMode() == PointerWrap::MODE_READ)
+    m_dirty_blocks.assign(m_save_data.size(), true);
 }
 }  // namespace Memcard
@@ -27,6 +27,8 @@ public:
   std::vector<GCMBlock> m_save_data;
   std::vector<u16> m_used_blocks;
   bool m_dirty;
+  // Which blocks of m_save_data differ from the file, so that flushing only has to write those
+  std::vector<bool> m_dirty_blocks;
   std::string m_filename;
 };
 }  // namespace Memcard
@@ -11,6 +11,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <fmt/format.h>
@@ -241,6 +242,8 @@ void GCMemcardDirectory::FlushThread()
   Common::SetCurrentThreadName(fmt::format("Memcard {} flushing thread", m_card_index).c_str());
 
   constexpr std::chrono::seconds flush_interval{1};
+  // Saves that keep being written to still get flushed this often
+  constexpr std::chrono::seconds max_flush_delay{5};
   while (true)
   {
     // no-op until signalled
@@ -249,7 +252,9 @@ void GCMemcardDirectory::FlushThread()
     if (m_exiting.TestAndClear())
       return;
     // no-op as long as signalled within flush_interval
-    while (m_flush_trigger.WaitFor(flush_interval))
+    const auto flush_deadline = std::chrono::steady_clock::now() + max_flush_delay;
+    while (std::chrono::steady_clock::now() < flush_deadline &&
+           m_flush_trigger.WaitFor(flush_interval))
     {
       if (m_exiting.TestAndClear())
         return;
@@ -510,6 +515,7 @@ inline s32 GCMemcardDirectory::SaveAreaRW(u32 block, bool writing)
       int idx = m_saves[i].UsesBlock(block);
       if (idx != -1)
       {
+        const bool was_loaded = !m_saves[i].m_save_data.empty();
         if (!m_saves[i].LoadSaveBlocks())
         {
           int num_blocks = m_saves[i].m_gci_header.m_block_count;
@@ -518,11 +524,19 @@ inline s32 GCMemcardDirectory::SaveAreaRW(u32 block, bool writing)
             m_saves[i].m_save_data.emplace_back();
             num_blocks--;
           }
+          m_saves[i].m_dirty_blocks.assign(m_saves[i].m_save_data.size(), true);
         }
+        else if (!was_loaded)
+        {
+          m_saves[i].m_dirty_blocks.assign(m_saves[i].m_save_data.size(), false);
+        }
+        if (m_saves[i].m_dirty_blocks.size() != m_saves[i].m_save_data.size())
+          m_saves[i].m_dirty_blocks.assign(m_saves[i].m_save_data.size(), true);
 
         if (writing)
         {
           m_saves[i].m_dirty = true;
+          m_saves[i].m_dirty_blocks[idx] = true;
         }
 
         m_last_block = block;
@@ -588,10 +602,56 @@ bool GCMemcardDirectory::SetUsedBlocks(int save_index)
   return true;
 }
 
+namespace
+{
+struct PendingSaveWrite
+{
+  std::string filename;
+  Memcard::DEntry header;
+  // Only the header and the changed blocks are written to an existing file of the right size
+  bool whole_file;
+  std::vector<std::pair<size_t, Memcard::GCMBlock>> changed_blocks;
+  std::vector<Memcard::GCMBlock> all_blocks;
+};
+}  // Anonymous namespace
+
+static bool WriteChangedBlocks(const PendingSaveWrite& write)
+{
+  const u64 expected_size =
+      Memcard::DENTRY_SIZE + u64{Memcard::BLOCK_SIZE} * write.header.m_block_count;
+  File::IOFile gci(write.filename, "r+b");
+  if (!gci || gci.GetSize() != expected_size)
+    return false;
+
+  gci.WriteBytes(&write.header, Memcard::DENTRY_SIZE);
+  for (const auto& [index, block] : write.changed_blocks)
+  {
+    gci.Seek(Memcard::DENTRY_SIZE + s64{Memcard::BLOCK_SIZE} * index, SEEK_SET);
+    gci.WriteBytes(&block, Memcard::BLOCK_SIZE);
+  }
+  return gci.IsGood();
+}
+
+static bool WriteSave(const PendingSaveWrite& write)
+{
+  File::IOFile gci(write.filename, "wb");
+  if (!gci)
+    return false;
+
+  gci.WriteBytes(&write.header, Memcard::DENTRY_SIZE);
+  gci.WriteBytes(write.all_blocks.data(), Memcard::BLOCK_SIZE * write.all_blocks.size());
+  return gci.IsGood();
+}
+
 void GCMemcardDirectory::FlushToFile()
 {
+  std::lock_guard<std::mutex> flush_lock(m_flush_mutex);
+
+  // Collect what needs writing, and write it once the emulated card can be used again
+  std::vector<PendingSaveWrite> writes;
   std::unique_lock<std::mutex> l(m_write_mutex);
-  int errors = 0;
+  // Makes the next write to the block that was written to last mark it as dirty again
+  m_last_block = -1;
   Memcard::DEntry invalid;
   for (Memcard::GCIFile& save : m_saves)
   {
@@ -609,7 +669,11 @@ void GCMemcardDirectory::FlushToFile()
                     "GCI header modified without corresponding save data changes");
           continue;
         }
-        if (save.m_filename.empty())
+
+        PendingSaveWrite write;
+        write.header = save.m_gci_header;
+        const bool is_new_file = save.m_filename.empty();
+        if (is_new_file)
         {
           std::string default_save_name = m_save_directory + save.m_gci_header.GCI_FileName();
 
@@ -625,24 +689,25 @@ void GCMemcardDirectory::FlushToFile()
                         default_save_name.c_str());
           save.m_filename = default_save_name;
         }
-        File::IOFile gci(save.m_filename, "wb");
-        if (gci)
-        {
-          gci.WriteBytes(&save.m_gci_header, Memcard::DENTRY_SIZE);
-          gci.WriteBytes(save.m_save_data.data(), Memcard::BLOCK_SIZE * save.m_save_data.size());
+        write.filename = save.m_filename;
 
-          if (gci.IsGood())
-          {
-            Core::DisplayMessage(fmt::format("Wrote save contents to {}", save.m_filename), 4000);
-          }
-          else
+        // A new file doesn't have the blocks that weren't changed yet
+        write.whole_file = is_new_file || save.m_dirty_blocks.size() != save.m_save_data.size() ||
+                           save.m_save_data.size() != save.m_gci_header.m_block_count;
+        if (write.whole_file)
+        {
+          write.all_blocks = save.m_save_data;
+        }
+        else
+        {
+          for (size_t i = 0; i < save.m_save_data.size(); ++i)
           {
-            ++errors;
-            Core::DisplayMessage(
-                fmt::format("Failed to write save contents to {}", save.m_filename), 4000);
-            ERROR_LOG(EXPANSIONINTERFACE, "Failed to save data to %s", save.m_filename.c_str());
+            if (save.m_dirty_blocks[i])
+              write.changed_blocks.emplace_back(i, save.m_save_data[i]);
           }
         }
+        save.m_dirty_blocks.assign(save.m_save_data.size(), false);
+        writes.push_back(std::move(write));
       }
       else if (save.m_filename.length() != 0)
       {
@@ -676,6 +741,42 @@ void GCMemcardDirectory::FlushToFile()
   File::IOFile hdrfile(m_save_directory + MC_HDR, "wb");
   hdrfile.WriteBytes(mc, BLOCK_SIZE * MC_FST_BLOCKS);
 #endif
+  l.unlock();
+
+  for (PendingSaveWrite& write : writes)
+  {
+    bool written = false;
+    if (!write.whole_file)
+    {
+      written = WriteChangedBlocks(write);
+      if (!written)
+      {
+        // The file doesn't have the size of the save anymore, so it's written whole instead
+        std::lock_guard<std::mutex> lk(m_write_mutex);
+        const auto save = std::find_if(m_saves.begin(), m_saves.end(), [&](const auto& gci) {
+          return gci.m_filename == write.filename;
+        });
+        if (save != m_saves.end())
+        {
+          write.header = save->m_gci_header;
+          write.all_blocks = save->m_save_data;
+        }
+      }
+    }
+    if (!written && !write.all_blocks.empty())
+      written = WriteSave(write);
+
+    if (written)
+    {
+      Core::DisplayMessage(fmt::format("Wrote save contents to {}", write.filename), 4000);
+    }
+    else
+    {
+      Core::DisplayMessage(fmt::format("Failed to write save contents to {}", write.filename),
+                           4000);
+      ERROR_LOG(EXPANSIONINTERFACE, "Failed to save data to %s", write.filename.c_str());
+    }
+  }
 }
 
 void GCMemcardDirectory::DoState(PointerWrap& p)
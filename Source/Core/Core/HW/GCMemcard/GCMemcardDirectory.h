@@ -62,6 +62,8 @@ private:
   std::string m_save_directory;
   Common::Event m_flush_trigger;
   std::mutex m_write_mutex;
+  // Held while writing files, which happens without holding m_write_mutex
+  std::mutex m_flush_mutex;
   Common::Flag m_exiting;
   std::thread m_flush_thread;
 };
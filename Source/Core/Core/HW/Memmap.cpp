@@ -12,12 +12,20 @@
 #include <algorithm>
 #include <array>
 #include <cstring>
+#include <map>
 #include <memory>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/MemArena.h"
+#include "Common/MemoryUtil.h"
 #include "Common/Swap.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
@@ -226,6 +234,15 @@ static std::array<PhysicalMemoryRegion, 4> physical_regions;
 
 static std::vector<LogicalMemoryView> logical_mapped_entries;
 
+// Single pages translated through the page table, keyed by their logical address. These are
+// mapped on demand by the JIT fault handlers and live on top of the BAT mappings above.
+static std::map<u32, void*> page_table_mapped_entries;
+
+// Ranges of the physical view that are protected because they contain memchecks. They are
+// rounded out to 64 KiB, the largest host page size we run on.
+constexpr u32 PHYSICAL_PROTECTION_ALIGNMENT = 0x10000;
+static std::vector<std::pair<u8*, size_t>> physical_protected_ranges;
+
 static u32 GetFlags()
 {
   bool wii = SConfig::GetInstance().bWii;
@@ -288,6 +305,7 @@ void Init()
     mem_size += region.size;
   }
   g_arena.GrabSHMSegment(mem_size);
+  g_arena.SetLargePages(Config::Get(Config::MAIN_LARGE_PAGES));
 
   // Create an anonymous view of the physical memory
   for (PhysicalMemoryRegion& region : physical_regions)
@@ -345,11 +363,73 @@ bool InitFastmemArena()
   return true;
 }
 
+static void ClearPageTableMappings()
+{
+  for (auto& entry : page_table_mapped_entries)
+    g_arena.ReleaseView(entry.second, PowerPC::HW_PAGE_SIZE);
+  page_table_mapped_entries.clear();
+}
+
+bool CanProtectPhysicalMemory()
+{
+  // The DSP LLE accesses the physical view directly, and would crash on protected pages
+  return is_fastmem_arena_initialized && SConfig::GetInstance().bDSPHLE;
+}
+
+static void UnprotectPhysicalMemory()
+{
+  for (const auto& [pointer, size] : physical_protected_ranges)
+    Common::UnWriteProtectMemory(pointer, size);
+  physical_protected_ranges.clear();
+}
+
+void UpdatePhysicalMemchecks()
+{
+  UnprotectPhysicalMemory();
+  if (!CanProtectPhysicalMemory())
+    return;
+
+  // Pages with write-only memchecks are protected first, so that a read memcheck sharing one of
+  // them ends up with the stricter protection.
+  const u32 flags = GetFlags();
+  for (const bool on_read : {false, true})
+  {
+    for (const TMemCheck& mc : PowerPC::memchecks.GetMemChecks())
+    {
+      if (on_read ? !mc.is_break_on_read : (mc.is_break_on_read || !mc.is_break_on_write))
+        continue;
+
+      for (const auto& region : physical_regions)
+      {
+        if ((flags & region.flags) != region.flags)
+          continue;
+
+        const u32 region_last = region.physical_address + (region.size - 1);
+        const u32 start = std::max(mc.start_address, region.physical_address);
+        const u32 last = std::min(mc.end_address, region_last);
+        if (start > last)
+          continue;
+
+        const u32 aligned_start = start & ~(PHYSICAL_PROTECTION_ALIGNMENT - 1);
+        const u32 aligned_last = std::min(last | (PHYSICAL_PROTECTION_ALIGNMENT - 1), region_last);
+        u8* pointer = physical_base + aligned_start;
+        const size_t size = size_t(aligned_last - aligned_start) + 1;
+        if (on_read)
+          Common::ReadProtectMemory(pointer, size);
+        else
+          Common::WriteProtectMemory(pointer, size);
+        physical_protected_ranges.emplace_back(pointer, size);
+      }
+    }
+  }
+}
+
 void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
 {
   if (!is_fastmem_arena_initialized)
     return;
 
+  ClearPageTableMappings();
   for (auto& entry : logical_mapped_entries)
   {
     g_arena.ReleaseView(entry.mapped_pointer, entry.mapped_size);
@@ -389,6 +469,61 @@ void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
   }
 }
 
+bool MapPageTablePage(u32 logical_address, u32 physical_address)
+{
+#ifdef _WIN32
+  // Views have to be aligned to the 64 KiB allocation granularity.
+  return false;
+#else
+  static const bool page_size_matches = sysconf(_SC_PAGESIZE) == PowerPC::HW_PAGE_SIZE;
+  if (!is_fastmem_arena_initialized || !page_size_matches)
+    return false;
+
+  logical_address &= ~static_cast<u32>(PowerPC::HW_PAGE_SIZE - 1);
+  physical_address &= ~static_cast<u32>(PowerPC::HW_PAGE_SIZE - 1);
+  if (page_table_mapped_entries.count(logical_address))
+    return false;
+
+  const u32 flags = GetFlags();
+  for (const auto& physical_region : physical_regions)
+  {
+    if ((flags & physical_region.flags) != physical_region.flags)
+      continue;
+    if (physical_address < physical_region.physical_address ||
+        physical_address - physical_region.physical_address >= physical_region.size)
+    {
+      continue;
+    }
+
+    const u32 position =
+        physical_region.shm_position + physical_address - physical_region.physical_address;
+    void* mapped_pointer =
+        g_arena.CreateView(position, PowerPC::HW_PAGE_SIZE, logical_base + logical_address);
+    if (!mapped_pointer)
+      return false;
+
+    page_table_mapped_entries.emplace(logical_address, mapped_pointer);
+    return true;
+  }
+
+  return false;
+#endif
+}
+
+void UnmapPageTablePage(u32 logical_address)
+{
+  if (page_table_mapped_entries.empty())
+    return;
+
+  logical_address &= ~static_cast<u32>(PowerPC::HW_PAGE_SIZE - 1);
+  const auto it = page_table_mapped_entries.find(logical_address);
+  if (it == page_table_mapped_entries.end())
+    return;
+
+  g_arena.ReleaseView(it->second, PowerPC::HW_PAGE_SIZE);
+  page_table_mapped_entries.erase(it);
+}
+
 void DoState(PointerWrap& p)
 {
   bool wii = SConfig::GetInstance().bWii;
@@ -421,11 +556,27 @@ void Shutdown()
   INFO_LOG(MEMMAP, "Memory system shut down.");
 }
 
+const std::string& GetSharedMemoryName()
+{
+  return g_arena.GetSegmentName();
+}
+
+u32 GetRamSharedMemoryOffset()
+{
+  return physical_regions[0].shm_position;
+}
+
+u32 GetExRamSharedMemoryOffset()
+{
+  return physical_regions[3].shm_position;
+}
+
 void ShutdownFastmemArena()
 {
   if (!is_fastmem_arena_initialized)
     return;
 
+  UnprotectPhysicalMemory();
   u32 flags = GetFlags();
   for (PhysicalMemoryRegion& region : physical_regions)
   {
@@ -436,6 +587,7 @@ void ShutdownFastmemArena()
     g_arena.ReleaseView(base, region.size);
   }
 
+  ClearPageTableMappings();
   for (auto& entry : logical_mapped_entries)
   {
     g_arena.ReleaseView(entry.mapped_pointer, entry.mapped_size);
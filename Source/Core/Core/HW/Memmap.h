@@ -67,7 +67,23 @@ bool InitFastmemArena();
 void ShutdownFastmemArena();
 void DoState(PointerWrap& p);
 
+// MEM1 and MEM2 live in a shared memory segment, which other processes can map to read emulated
+// memory directly. The name is empty if the segment can't be opened by name on this platform.
+const std::string& GetSharedMemoryName();
+u32 GetRamSharedMemoryOffset();
+u32 GetExRamSharedMemoryOffset();
+
 void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table);
+// Protects the pages of the physical view that contain memchecks, so that JIT accesses to them
+// fault and get backpatched to the slow path, which checks them. This isn't possible while
+// something other than the JIT uses the physical view, which CanProtectPhysicalMemory() tells.
+bool CanProtectPhysicalMemory();
+void UpdatePhysicalMemchecks();
+// Maps one page translated through the page table into the logical arena, so fastmem can reach
+// it. Returns false if that isn't possible, e.g. on Windows, where views must be 64 KiB aligned,
+// or on hosts with pages larger than 4 KiB. BAT updates drop all of these mappings.
+bool MapPageTablePage(u32 logical_address, u32 physical_address);
+void UnmapPageTablePage(u32 logical_address);
 
 void Clear();
 
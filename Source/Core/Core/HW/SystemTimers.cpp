@@ -45,6 +45,7 @@ IPC_HLE_PERIOD: For the Wii Remote this is the call schedule:
 
 #include "Core/HW/SystemTimers.h"
 
+#include <algorithm>
 #include <cfloat>
 #include <cinttypes>
 #include <cmath>
@@ -55,6 +56,7 @@ IPC_HLE_PERIOD: For the Wii Remote this is the call schedule:
 #include "Common/Logging/Log.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
@@ -67,7 +69,10 @@ IPC_HLE_PERIOD: For the Wii Remote this is the call schedule:
 #include "Core/PatchEngine.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "VideoCommon/Fifo.h"
+#include "VideoCommon/FrameProfiler.h"
 #include "DolphinQt/NarrysMod/VanguardClient.h"
+#include "DolphinQt/NarrysMod/VanguardLockstep.h"
+#include "DolphinQt/NarrysMod/VanguardReplay.h"
 
 namespace SystemTimers
 {
@@ -81,6 +86,7 @@ CoreTiming::EventType* et_IPC_HLE;
 // PatchEngine updates every 1/60th of a second by default
 CoreTiming::EventType* et_PatchEngine;
 CoreTiming::EventType* et_Throttle;
+CoreTiming::EventType* et_VanguardStep;
 
 u32 s_cpu_core_clock = 486000000u;  // 486 mhz (its not 485, stop bugging me!)
 
@@ -96,6 +102,9 @@ int s_ipc_hle_period;
 // Custom RTC
 s64 s_localtime_rtc_offset = 0;
 
+VanguardStepMode s_vanguard_step_mode;
+u32 s_vanguard_step_cycles;
+
 // For each emulated milliseconds, what was the real time timestamp (excluding sleep time). This is
 // a "special" ring buffer where we only need to read the first and last value.
 std::array<u64, 1000> s_emu_to_real_time_ring_buffer;
@@ -155,7 +164,6 @@ void PatchEngineCallback(u64 userdata, s64 cycles_late)
   // Try to patch mem and run the Action Replay
   if (PatchEngine::ApplyFramePatches())
   {
-    VanguardClientUnmanaged::CORE_STEP();
     next_schedule = vi_interval - cycles_pruned;
     cycles_pruned = 0;
   }
@@ -170,6 +178,29 @@ void PatchEngineCallback(u64 userdata, s64 cycles_late)
   CoreTiming::ScheduleEvent(next_schedule, et_PatchEngine, cycles_pruned);
 }
 
+s64 GetVanguardStepPeriod()
+{
+  switch (s_vanguard_step_mode)
+  {
+  case VanguardStepMode::HalfLine:
+    return VideoInterface::GetTicksPerHalfLine();
+  case VanguardStepMode::Cycles:
+    return std::max<u32>(s_vanguard_step_cycles, 1);
+  case VanguardStepMode::Field:
+  default:
+    return VideoInterface::GetTicksPerField();
+  }
+}
+
+void VanguardStepCallback(u64 userdata, s64 cycles_late)
+{
+  // Checked natively so that a disabled RTC never pays for a transition into managed code
+  if (VanguardClientUnmanaged::RTC_ENABLED)
+    VanguardClientUnmanaged::CORE_STEP();
+
+  CoreTiming::ScheduleEvent(GetVanguardStepPeriod() - cycles_late, et_VanguardStep);
+}
+
 void ThrottleCallback(u64 last_time, s64 cyclesLate)
 {
   // Allow the GPU thread to sleep. Setting this flag here limits the wakeups to 1 kHz.
@@ -203,7 +234,9 @@ void ThrottleCallback(u64 last_time, s64 cyclesLate)
     else if (diff > 1000)
     {
       Common::SleepCurrentThread(diff / 1000);
-      s_time_spent_sleeping += Common::Timer::GetTimeUs() - time;
+      const u64 time_slept = Common::Timer::GetTimeUs() - time;
+      s_time_spent_sleeping += time_slept;
+      FrameProfiler::AddTime(FrameProfiler::Category::CPUThreadIdle, time_slept);
     }
   }
   CoreTiming::ScheduleEvent(next_event - cyclesLate, et_Throttle, last_time + 1000);
@@ -247,6 +280,15 @@ u64 GetFakeTimeBase()
          ((CoreTiming::GetTicks() - CoreTiming::GetFakeTBStartTicks()) / TIMER_RATIO);
 }
 
+void ScheduleVanguardStep()
+{
+  CoreTiming::RemoveEvent(et_VanguardStep);
+  if (!VanguardClientUnmanaged::RTC_ENABLED)
+    return;
+
+  CoreTiming::ScheduleEvent(GetVanguardStepPeriod(), et_VanguardStep);
+}
+
 s64 GetLocalTimeRTCOffset()
 {
   return s_localtime_rtc_offset;
@@ -332,6 +374,9 @@ void Init()
   et_IPC_HLE = CoreTiming::RegisterEvent("IPC_HLE_UpdateCallback", IPC_HLE_UpdateCallback);
   et_PatchEngine = CoreTiming::RegisterEvent("PatchEngine", PatchEngineCallback);
   et_Throttle = CoreTiming::RegisterEvent("Throttle", ThrottleCallback);
+  et_VanguardStep = CoreTiming::RegisterEvent("VanguardStep", VanguardStepCallback);
+  VanguardReplay::RegisterEvents();
+  VanguardLockstep::RegisterEvents();
 
   CoreTiming::ScheduleEvent(VideoInterface::GetTicksPerHalfLine(), et_VI);
   CoreTiming::ScheduleEvent(0, et_DSP);
@@ -340,6 +385,10 @@ void Init()
 
   CoreTiming::ScheduleEvent(VideoInterface::GetTicksPerField(), et_PatchEngine);
 
+  s_vanguard_step_mode = Config::Get(Config::MAIN_VANGUARD_STEP_MODE);
+  s_vanguard_step_cycles = Config::Get(Config::MAIN_VANGUARD_STEP_CYCLES);
+  ScheduleVanguardStep();
+
   if (SConfig::GetInstance().bWii)
     CoreTiming::ScheduleEvent(s_ipc_hle_period, et_IPC_HLE);
 
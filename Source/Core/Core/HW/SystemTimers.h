@@ -39,6 +39,17 @@ enum class Mode
   Wii,
 };
 
+// How often the Vanguard step hook (RTC step corruption) fires
+enum class VanguardStepMode
+{
+  // Once per VI field, the same cadence the patch engine uses
+  Field,
+  // On every VI half-line update
+  HalfLine,
+  // Every MAIN_VANGUARD_STEP_CYCLES CPU cycles
+  Cycles,
+};
+
 u32 GetTicksPerSecond();
 void PreInit();
 void Init();
@@ -54,6 +65,10 @@ u64 GetFakeTimeBase();
 // Custom RTC
 s64 GetLocalTimeRTCOffset();
 
+// (Re)arms the Vanguard step event using the configured period. Does nothing if the RTC is
+// disabled.
+void ScheduleVanguardStep();
+
 // Returns an estimate of how fast/slow the emulation is running (excluding throttling induced sleep
 // time). The estimate is computed over the last 1s of emulated time. Example values:
 //
@@ -20,6 +20,7 @@
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/FifoPlayer/FifoPlayer.h"
+#include "Core/FramePacer.h"
 #include "Core/HW/MMIO.h"
 #include "Core/HW/ProcessorInterface.h"
 #include "Core/HW/SI/SI.h"
@@ -198,6 +199,7 @@ void Preset(bool _bNTSC)
 void Init()
 {
   Preset(true);
+  FramePacer::Reset();
 }
 
 void RegisterMMIO(MMIO::Mapping* mmio, u32 base)
@@ -805,6 +807,8 @@ static void BeginField(FieldType field, u64 ticks)
   // to VI during scanout and delay outputting the frame till then.
   if (xfbAddr)
     g_video_backend->Video_BeginField(xfbAddr, fbWidth, fbStride, fbHeight, ticks);
+
+  FramePacer::OnFieldPresented();
 }
 
 static void EndField()
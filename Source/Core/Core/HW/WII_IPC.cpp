@@ -140,7 +140,7 @@ static void InitState()
 void Init()
 {
   InitState();
-  updateInterrupts = CoreTiming::RegisterEvent("IPCInterrupt", UpdateInterrupts);
+  updateInterrupts = CoreTiming::RegisterEvent("IPCInterrupt", UpdateInterrupts, true);
 }
 
 void Reset()
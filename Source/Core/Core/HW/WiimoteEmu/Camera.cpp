@@ -20,6 +20,7 @@ namespace WiimoteEmu
 void CameraLogic::Reset()
 {
   m_reg_data = {};
+  m_last_update_inputs.reset();
 
   m_is_enabled = false;
 }
@@ -28,6 +29,9 @@ void CameraLogic::DoState(PointerWrap& p)
 {
   p.Do(m_reg_data);
 
+  if (p.GetMode() == PointerWrap::MODE_READ)
+    m_last_update_inputs.reset();
+
   // FYI: m_is_enabled is handled elsewhere.
 }
 
@@ -50,11 +54,18 @@ int CameraLogic::BusWrite(u8 slave_addr, u8 addr, int count, const u8* data_in)
   if (!m_is_enabled)
     return 0;
 
+  m_last_update_inputs.reset();
   return RawWrite(&m_reg_data, addr, count, data_in);
 }
 
 void CameraLogic::Update(const Common::Matrix44& transform)
 {
+  const UpdateInputs inputs{transform.data, m_reg_data.enable_object_tracking, m_reg_data.mode,
+                            static_cast<bool>(IOS::g_gpio_out[IOS::GPIO::SENSOR_BAR])};
+  if (m_last_update_inputs == inputs)
+    return;
+  m_last_update_inputs = inputs;
+
   // IR data is read from offset 0x37 on real hardware.
   auto& data = m_reg_data.camera_data;
   data.fill(0xff);
@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <array>
+#include <optional>
+
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Core/HW/WiimoteEmu/Dynamics.h"
@@ -152,8 +155,28 @@ private:
   int BusRead(u8 slave_addr, u8 addr, int count, u8* data_out) override;
   int BusWrite(u8 slave_addr, u8 addr, int count, const u8* data_in) override;
 
+  // Everything the camera data is computed from.
+  struct UpdateInputs
+  {
+    std::array<float, 16> transform;
+    u8 enable_object_tracking;
+    u8 mode;
+    bool sensor_bar_enabled;
+
+    bool operator==(const UpdateInputs& other) const
+    {
+      return transform == other.transform &&
+             enable_object_tracking == other.enable_object_tracking && mode == other.mode &&
+             sensor_bar_enabled == other.sensor_bar_enabled;
+    }
+  };
+
   Register m_reg_data;
 
+  // What the camera data was last computed from, if it hasn't been touched since. While the remote
+  // is held still or points away from the screen, there is no need to project the points again.
+  std::optional<UpdateInputs> m_last_update_inputs;
+
   // When disabled the camera does not respond on the bus.
   // Change is triggered by wiimote report 0x13.
   bool m_is_enabled;
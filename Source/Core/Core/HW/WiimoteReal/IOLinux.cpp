@@ -241,12 +241,18 @@ int WiimoteLinux::IORead(u8* buf)
 
   if (poll_wakeup.revents & POLLIN)
   {
-    char c;
-    if (read(m_wakeup_pipe_r, &c, 1) != 1)
+    // Every queued write wakes us up, so while the game streams speaker data, wakeups pile up
+    // faster than one per loop. Take all of them at once, since one pass through the loop handles
+    // every write that is queued.
+    std::array<char, 64> drained;
+    if (read(m_wakeup_pipe_r, drained.data(), drained.size()) <= 0)
     {
       ERROR_LOG(WIIMOTE, "Unable to read from wakeup pipe.");
     }
-    return -1;
+
+    // Don't let a wakeup hold back a report that is already here.
+    if (!(poll_sock.revents & POLLIN))
+      return -1;
   }
 
   if (!(poll_sock.revents & POLLIN))
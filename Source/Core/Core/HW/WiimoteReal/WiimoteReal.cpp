@@ -769,6 +769,8 @@ void Wiimote::StopThread()
 void Wiimote::ThreadFunc()
 {
   Common::SetCurrentThreadName("Wiimote Device Thread");
+  // This thread mostly sleeps. Input lag and speaker underruns both come from it waking up late.
+  Common::RaiseCurrentThreadPriority();
 
   bool ok = ConnectInternal();
   //Narrysmod_hijack
@@ -238,6 +238,7 @@ HostFileSystem::FstEntry* HostFileSystem::GetFstEntryForPath(const std::string&
 void HostFileSystem::DoState(PointerWrap& p)
 {
   // Temporarily close the file, to prevent any issues with the savestating of /tmp
+  CloseUnusedHostFiles();
   for (Handle& handle : m_handles)
     handle.host_file.reset();
 
@@ -348,6 +349,7 @@ ResultCode HostFileSystem::Format(Uid uid)
   if (m_root_path.empty())
     return ResultCode::AccessDenied;
   const std::string root = BuildFilename("/");
+  CloseUnusedHostFiles();
   if (!File::DeleteDirRecursively(root) || !File::CreateDir(root))
     return ResultCode::UnknownError;
   ResetFst();
@@ -442,6 +444,9 @@ ResultCode HostFileSystem::Delete(Uid uid, Gid gid, const std::string& path)
   if (!File::Exists(host_path))
     return ResultCode::NotFound;
 
+  // Some hosts can't delete files that are open
+  CloseUnusedHostFiles(host_path);
+
   if (File::IsFile(host_path) && !IsFileOpened(path))
     File::Delete(host_path);
   else if (File::IsDirectory(host_path) && !IsDirectoryInUse(path))
@@ -495,6 +500,10 @@ ResultCode HostFileSystem::Rename(Uid uid, Gid gid, const std::string& old_path,
   const std::string host_old_path = BuildFilename(old_path);
   const std::string host_new_path = BuildFilename(new_path);
 
+  // Some hosts can't rename or delete files that are open
+  CloseUnusedHostFiles(host_old_path);
+  CloseUnusedHostFiles(host_new_path);
+
   // If there is already something of the same type at the new path, delete it.
   if (File::Exists(host_new_path))
   {
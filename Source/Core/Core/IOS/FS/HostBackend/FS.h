@@ -5,8 +5,10 @@
 #pragma once
 
 #include <array>
+#include <list>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -72,12 +74,25 @@ private:
     std::vector<FstEntry> children;
   };
 
+  struct HostFile
+  {
+    std::string host_path;
+    File::IOFile file;
+    /// All changes to the file go through us, so we keep track of its size instead of asking
+    /// the host on every access.
+    u64 size = 0;
+    /// Where the host file's position is, or nullopt if it isn't known. Sequential accesses
+    /// skip seeking, which would also throw away what the host file buffered.
+    std::optional<u64> position = 0;
+    bool last_access_was_write = false;
+  };
+
   struct Handle
   {
     bool opened = false;
     Mode mode = Mode::None;
     std::string wii_path;
-    std::shared_ptr<File::IOFile> host_file;
+    std::shared_ptr<HostFile> host_file;
     u32 file_offset = 0;
   };
   Handle* AssignFreeHandle();
@@ -85,7 +100,12 @@ private:
   Fd ConvertHandleToFd(const Handle* handle) const;
 
   std::string BuildFilename(const std::string& wii_path) const;
-  std::shared_ptr<File::IOFile> OpenHostFile(const std::string& host_path);
+  std::shared_ptr<HostFile> OpenHostFile(const std::string& host_path);
+  /// Seeks the host file to offset if it isn't there already, or if the access switches between
+  /// reading and writing, which C requires a seek for.
+  static void PrepareHostFileAccess(HostFile* host_file, u64 offset, bool write);
+  /// Closes the host files that no handle uses anymore and whose paths start with host_path.
+  void CloseUnusedHostFiles(const std::string& host_path = {});
 
   ResultCode CreateFileOrDirectory(Uid uid, Gid gid, const std::string& path,
                                    FileAttribute attribute, Modes modes, bool is_file);
@@ -111,7 +131,10 @@ private:
   /// filesystem root manually.
   FstEntry m_root_entry{};
   std::string m_root_path;
-  std::map<std::string, std::weak_ptr<File::IOFile>> m_open_files;
+  std::map<std::string, std::weak_ptr<HostFile>> m_open_files;
+  /// Games tend to open, access and close the same few files over and over again, so the most
+  /// recently closed files are kept open on the host. The most recently closed one is first.
+  std::list<std::shared_ptr<HostFile>> m_unused_host_files;
   std::array<Handle, 16> m_handles{};
 };
 
@@ -3,19 +3,31 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <cstdio>
+#include <list>
 #include <memory>
+#include <optional>
+#include <string>
 
 #include "Common/File.h"
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
+#include "Common/StringUtil.h"
 
 #include "Core/IOS/FS/HostBackend/FS.h"
 
 namespace IOS::HLE::FS
 {
+// How many host files are kept open after the emulated software has closed them
+constexpr size_t MAX_UNUSED_HOST_FILES = 8;
+
+// Larger than the default, so that the host file coalesces the small sequential reads and writes
+// that games tend to do with their save files
+constexpr size_t HOST_FILE_BUFFER_SIZE = 0x10000;
+
 // This isn't theadsafe, but it's only called from the CPU thread.
-std::shared_ptr<File::IOFile> HostFileSystem::OpenHostFile(const std::string& host_path)
+std::shared_ptr<HostFileSystem::HostFile> HostFileSystem::OpenHostFile(const std::string& host_path)
 {
   // On the wii, all file operations are strongly ordered.
   // If a game opens the same file twice (or 8 times, looking at you PokePark Wii)
@@ -38,7 +50,23 @@ std::shared_ptr<File::IOFile> HostFileSystem::OpenHostFile(const std::string& ho
   if (search != m_open_files.end())
   {
     // Lock a shared pointer to use.
-    return search->second.lock();
+    std::shared_ptr<HostFile> host_file = search->second.lock();
+
+    const auto unused =
+        std::find(m_unused_host_files.begin(), m_unused_host_files.end(), host_file);
+    if (unused != m_unused_host_files.end())
+    {
+      m_unused_host_files.erase(unused);
+
+      // Nothing had the file open, so something outside of the emulated IOS may have changed it
+      if (host_file.use_count() == 1)
+      {
+        host_file->size = host_file->file.GetSize();
+        host_file->position.reset();
+      }
+    }
+
+    return host_file;
   }
 
   // All files are opened read/write. Actual access rights will be controlled per handle by the
@@ -63,21 +91,44 @@ std::shared_ptr<File::IOFile> HostFileSystem::OpenHostFile(const std::string& ho
     }
   }
 
+  std::setvbuf(file.GetHandle(), nullptr, _IOFBF, HOST_FILE_BUFFER_SIZE);
+
   // This code will be called when all references to the shared pointer below have been removed.
-  auto deleter = [this, host_path](File::IOFile* ptr) {
+  auto deleter = [this, host_path](HostFile* ptr) {
     delete ptr;                     // IOFile's deconstructor closes the file.
     m_open_files.erase(host_path);  // erase the weak pointer from the list of open files.
   };
 
   // Use the custom deleter from above.
-  std::shared_ptr<File::IOFile> file_ptr(new File::IOFile(std::move(file)), deleter);
+  const u64 size = file.GetSize();
+  std::shared_ptr<HostFile> file_ptr(new HostFile{host_path, std::move(file), size}, deleter);
 
   // Store a weak pointer to our newly opened file in the cache.
-  m_open_files[host_path] = std::weak_ptr<File::IOFile>(file_ptr);
+  m_open_files[host_path] = std::weak_ptr<HostFile>(file_ptr);
 
   return file_ptr;
 }
 
+void HostFileSystem::CloseUnusedHostFiles(const std::string& host_path)
+{
+  m_unused_host_files.remove_if([&host_path](const std::shared_ptr<HostFile>& host_file) {
+    return StringBeginsWith(host_file->host_path, host_path);
+  });
+}
+
+void HostFileSystem::PrepareHostFileAccess(HostFile* host_file, u64 offset, bool write)
+{
+  if (host_file->position != offset || host_file->last_access_was_write != write)
+  {
+    if (host_file->file.Seek(offset, SEEK_SET))
+      host_file->position = offset;
+    else
+      host_file->position.reset();
+  }
+
+  host_file->last_access_was_write = write;
+}
+
 Result<FileHandle> HostFileSystem::OpenFile(Uid, Gid, const std::string& path, Mode mode)
 {
   Handle* handle = AssignFreeHandle();
@@ -110,32 +161,51 @@ ResultCode HostFileSystem::Close(Fd fd)
   if (!handle)
     return ResultCode::Invalid;
 
-  // Let go of our pointer to the file, it will automatically close if we are the last handle
-  // accessing it.
+  std::shared_ptr<HostFile> host_file = std::move(handle->host_file);
   *handle = Handle{};
+
+  // Writes are buffered, so flush them now that the emulated software is done with the file
+  if (host_file->last_access_was_write)
+    host_file->file.Flush();
+
+  // Let go of our pointer to the file. Once it has been pushed out of the unused files, it will
+  // automatically close if there is no other handle accessing it.
+  m_unused_host_files.remove(host_file);
+  m_unused_host_files.push_front(std::move(host_file));
+  if (m_unused_host_files.size() > MAX_UNUSED_HOST_FILES)
+    m_unused_host_files.pop_back();
+
   return ResultCode::Success;
 }
 
 Result<u32> HostFileSystem::ReadBytesFromFile(Fd fd, u8* ptr, u32 count)
 {
   Handle* handle = GetHandleFromFd(fd);
-  if (!handle || !handle->host_file->IsOpen())
+  if (!handle || !handle->host_file->file.IsOpen())
     return ResultCode::Invalid;
 
   if ((u8(handle->mode) & u8(Mode::Read)) == 0)
     return ResultCode::AccessDenied;
 
-  const u32 file_size = static_cast<u32>(handle->host_file->GetSize());
+  HostFile* host_file = handle->host_file.get();
+
+  const u32 file_size = static_cast<u32>(host_file->size);
   // IOS has this check in the read request handler.
   if (count + handle->file_offset > file_size)
     count = file_size - handle->file_offset;
 
   // File might be opened twice, need to seek before we read
-  handle->host_file->Seek(handle->file_offset, SEEK_SET);
-  const u32 actually_read = static_cast<u32>(fread(ptr, 1, count, handle->host_file->GetHandle()));
+  PrepareHostFileAccess(host_file, handle->file_offset, false);
+  const u32 actually_read = static_cast<u32>(fread(ptr, 1, count, host_file->file.GetHandle()));
 
-  if (actually_read != count && ferror(handle->host_file->GetHandle()))
+  if (actually_read != count && ferror(host_file->file.GetHandle()))
+  {
+    host_file->position.reset();
     return ResultCode::AccessDenied;
+  }
+
+  if (host_file->position)
+    *host_file->position += actually_read;
 
   // IOS returns the number of bytes read and adds that value to the seek position,
   // instead of adding the *requested* read length.
@@ -146,16 +216,26 @@ Result<u32> HostFileSystem::ReadBytesFromFile(Fd fd, u8* ptr, u32 count)
 Result<u32> HostFileSystem::WriteBytesToFile(Fd fd, const u8* ptr, u32 count)
 {
   Handle* handle = GetHandleFromFd(fd);
-  if (!handle || !handle->host_file->IsOpen())
+  if (!handle || !handle->host_file->file.IsOpen())
     return ResultCode::Invalid;
 
   if ((u8(handle->mode) & u8(Mode::Write)) == 0)
     return ResultCode::AccessDenied;
 
-  // File might be opened twice, need to seek before we read
-  handle->host_file->Seek(handle->file_offset, SEEK_SET);
-  if (!handle->host_file->WriteBytes(ptr, count))
+  HostFile* host_file = handle->host_file.get();
+
+  // File might be opened twice, need to seek before we write
+  PrepareHostFileAccess(host_file, handle->file_offset, true);
+  if (!host_file->file.WriteBytes(ptr, count))
+  {
+    host_file->position.reset();
+    host_file->size = host_file->file.GetSize();
     return ResultCode::AccessDenied;
+  }
+
+  if (host_file->position)
+    *host_file->position += count;
+  host_file->size = std::max<u64>(host_file->size, u64(handle->file_offset) + count);
 
   handle->file_offset += count;
   return count;
@@ -164,7 +244,7 @@ Result<u32> HostFileSystem::WriteBytesToFile(Fd fd, const u8* ptr, u32 count)
 Result<u32> HostFileSystem::SeekFile(Fd fd, std::uint32_t offset, SeekMode mode)
 {
   Handle* handle = GetHandleFromFd(fd);
-  if (!handle || !handle->host_file->IsOpen())
+  if (!handle || !handle->host_file->file.IsOpen())
     return ResultCode::Invalid;
 
   u32 new_position = 0;
@@ -177,14 +257,14 @@ Result<u32> HostFileSystem::SeekFile(Fd fd, std::uint32_t offset, SeekMode mode)
     new_position = handle->file_offset + offset;
     break;
   case SeekMode::End:
-    new_position = handle->host_file->GetSize() + offset;
+    new_position = handle->host_file->size + offset;
     break;
   default:
     return ResultCode::Invalid;
   }
 
   // This differs from POSIX behaviour which allows seeking past the end of the file.
-  if (handle->host_file->GetSize() < new_position)
+  if (handle->host_file->size < new_position)
     return ResultCode::Invalid;
 
   handle->file_offset = new_position;
@@ -194,11 +274,11 @@ Result<u32> HostFileSystem::SeekFile(Fd fd, std::uint32_t offset, SeekMode mode)
 Result<FileStatus> HostFileSystem::GetFileStatus(Fd fd)
 {
   const Handle* handle = GetHandleFromFd(fd);
-  if (!handle || !handle->host_file->IsOpen())
+  if (!handle || !handle->host_file->file.IsOpen())
     return ResultCode::Invalid;
 
   FileStatus status;
-  status.size = handle->host_file->GetSize();
+  status.size = handle->host_file->size;
   status.offset = handle->file_offset;
   return status;
 }
@@ -274,10 +274,20 @@ ReturnCode IOSC::DecryptEncrypt(Common::AES::Mode mode, Handle key_handle, u8* i
   if (entry->data.size() != AES128_KEY_SIZE)
     return IOSC_FAIL_INTERNAL;
 
-  const std::vector<u8> data =
-      Common::AES::DecryptEncrypt(entry->data.data(), iv, input, size, mode);
+  // mbedtls refuses sizes that aren't a multiple of the block size, and leaves the output zeroed
+  if (size % 16 != 0)
+  {
+    const std::vector<u8> data =
+        Common::AES::DecryptEncrypt(entry->data.data(), iv, input, size, mode);
+    std::memcpy(output, data.data(), data.size());
+    return IPC_SUCCESS;
+  }
 
-  std::memcpy(output, data.data(), data.size());
+  // Whole contents go through here when titles are imported, so this works on the buffers directly
+  if (mode == Common::AES::Mode::Encrypt)
+    Common::AES::CBCEncryptor(entry->data.data()).Encrypt(iv, input, output, size);
+  else
+    Common::AES::CBCDecryptor(entry->data.data()).Decrypt(iv, input, output, size);
   return IPC_SUCCESS;
 }
 
@@ -4,8 +4,10 @@
 
 #include "Core/IOS/Network/SSL.h"
 
+#include <algorithm>
 #include <array>
 #include <cstring>
+#include <list>
 #include <memory>
 #include <vector>
 
@@ -35,6 +37,82 @@ static constexpr mbedtls_x509_crt_profile mbedtls_x509_crt_profile_wii = {
     0,         /* No RSA min key size */
 };
 
+namespace
+{
+struct CachedSession
+{
+  std::string hostname;
+  bool verify_certificates;
+  mbedtls_ssl_session session;
+};
+}  // namespace
+
+// A full handshake costs a few round trips and an RSA operation; resuming a session
+// costs neither. Games typically reconnect to the same few servers over and over.
+constexpr size_t SSL_SESSION_CACHE_SIZE = 8;
+
+// Most recently used first
+static std::list<CachedSession> s_session_cache;
+
+static std::list<CachedSession>::iterator FindCachedSession(const WII_SSL& ssl)
+{
+  // A session established without verifying the server must not be resumed by a context that
+  // wants it verified, since resuming skips the verification.
+  return std::find_if(s_session_cache.begin(), s_session_cache.end(),
+                      [&ssl](const CachedSession& cached) {
+                        return cached.hostname == ssl.hostname &&
+                               cached.verify_certificates == ssl.verify_certificates;
+                      });
+}
+
+static void ClearSessionCache()
+{
+  for (CachedSession& cached : s_session_cache)
+    mbedtls_ssl_session_free(&cached.session);
+  s_session_cache.clear();
+}
+
+void NetSSL::SaveSession(int id)
+{
+  const WII_SSL& ssl = _SSL[id];
+
+  auto it = FindCachedSession(ssl);
+  if (it == s_session_cache.end())
+  {
+    if (s_session_cache.size() == SSL_SESSION_CACHE_SIZE)
+    {
+      mbedtls_ssl_session_free(&s_session_cache.back().session);
+      s_session_cache.pop_back();
+    }
+    it = s_session_cache.emplace(s_session_cache.begin());
+    it->hostname = ssl.hostname;
+    it->verify_certificates = ssl.verify_certificates;
+    mbedtls_ssl_session_init(&it->session);
+  }
+  else
+  {
+    s_session_cache.splice(s_session_cache.begin(), s_session_cache, it);
+    mbedtls_ssl_session_free(&it->session);
+    mbedtls_ssl_session_init(&it->session);
+  }
+
+  if (mbedtls_ssl_get_session(&ssl.ctx, &it->session) != 0)
+  {
+    mbedtls_ssl_session_free(&it->session);
+    s_session_cache.erase(it);
+  }
+}
+
+static void ResumeCachedSession(WII_SSL& ssl)
+{
+  const auto it = FindCachedSession(ssl);
+  if (it == s_session_cache.end())
+    return;
+
+  if (mbedtls_ssl_set_session(&ssl.ctx, &it->session) == 0)
+    INFO_LOG(IOS_SSL, "Resuming SSL session for %s", ssl.hostname.c_str());
+}
+
 NetSSL::NetSSL(Kernel& ios, const std::string& device_name) : Device(ios, device_name)
 {
   for (WII_SSL& ssl : _SSL)
@@ -55,7 +133,6 @@ NetSSL::~NetSSL()
       mbedtls_x509_crt_free(&ssl.cacert);
       mbedtls_x509_crt_free(&ssl.clicert);
 
-      mbedtls_ssl_session_free(&ssl.session);
       mbedtls_ssl_free(&ssl.ctx);
       mbedtls_ssl_config_free(&ssl.config);
       mbedtls_ctr_drbg_free(&ssl.ctr_drbg);
@@ -66,6 +143,8 @@ NetSSL::~NetSSL()
       ssl.active = false;
     }
   }
+
+  ClearSessionCache();
 }
 
 int NetSSL::GetSSLFreeID() const
@@ -214,9 +293,10 @@ IPCCommandResult NetSSL::IOCtlV(const IOCtlVRequest& request)
       mbedtls_ssl_conf_max_version(&ssl->config, MBEDTLS_SSL_MAJOR_VERSION_3,
                                    MBEDTLS_SSL_MINOR_VERSION_2);
       mbedtls_ssl_conf_cert_profile(&ssl->config, &mbedtls_x509_crt_profile_wii);
-      mbedtls_ssl_set_session(&ssl->ctx, &ssl->session);
 
-      if (Config::Get(Config::MAIN_NETWORK_SSL_VERIFY_CERTIFICATES) && verifyOption)
+      ssl->verify_certificates =
+          Config::Get(Config::MAIN_NETWORK_SSL_VERIFY_CERTIFICATES) && verifyOption;
+      if (ssl->verify_certificates)
         mbedtls_ssl_conf_authmode(&ssl->config, MBEDTLS_SSL_VERIFY_REQUIRED);
       else
         mbedtls_ssl_conf_authmode(&ssl->config, MBEDTLS_SSL_VERIFY_NONE);
@@ -256,7 +336,6 @@ IPCCommandResult NetSSL::IOCtlV(const IOCtlVRequest& request)
       mbedtls_x509_crt_free(&ssl->cacert);
       mbedtls_x509_crt_free(&ssl->clicert);
 
-      mbedtls_ssl_session_free(&ssl->session);
       mbedtls_ssl_free(&ssl->ctx);
       mbedtls_ssl_config_free(&ssl->config);
       mbedtls_ctr_drbg_free(&ssl->ctr_drbg);
@@ -441,6 +520,7 @@ IPCCommandResult NetSSL::IOCtlV(const IOCtlVRequest& request)
     {
       WII_SSL* ssl = &_SSL[sslID];
       mbedtls_ssl_setup(&ssl->ctx, &ssl->config);
+      ResumeCachedSession(*ssl);
       ssl->sockfd = Memory::Read_U32(BufferOut2);
       WiiSockMan& sm = WiiSockMan::GetInstance();
       ssl->hostfd = sm.GetHostSocket(ssl->sockfd);
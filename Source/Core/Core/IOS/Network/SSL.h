@@ -68,7 +68,6 @@ struct WII_SSL
 {
   mbedtls_ssl_context ctx;
   mbedtls_ssl_config config;
-  mbedtls_ssl_session session;
   mbedtls_entropy_context entropy;
   mbedtls_ctr_drbg_context ctr_drbg;
   mbedtls_x509_crt cacert;
@@ -77,6 +76,7 @@ struct WII_SSL
   int sockfd;
   int hostfd;
   std::string hostname;
+  bool verify_certificates;
   bool active;
 };
 
@@ -94,6 +94,10 @@ public:
 
   int GetSSLFreeID() const;
 
+  // Remembers the session of the SSL context id once its handshake is done, so that the next
+  // connection to the same host can resume it instead of doing a full handshake.
+  static void SaveSession(int id);
+
   static WII_SSL _SSL[NET_SSL_MAXINSTANCES];
 
 private:
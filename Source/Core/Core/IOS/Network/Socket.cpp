@@ -206,11 +206,58 @@ s32 WiiSocket::FCntl(u32 cmd, u32 arg)
   return ret;
 }
 
+// Whether attempting op now could complete it. A blocking operation that would block is only
+// attempted again on a later update anyway, so there is no point in making the host call until
+// select() says the socket is ready for it.
+bool WiiSocket::IsReady(const sockop& op, bool read, bool write, bool except) const
+{
+  // SSL may have data buffered that the socket knows nothing about.
+  if (nonBlock || except || op.is_ssl)
+    return true;
+
+  if (op.request.command == IPC_CMD_IOCTL)
+    return op.net_type != IOCTL_SO_ACCEPT || read;
+
+  if (op.request.command != IPC_CMD_IOCTLV)
+    return true;
+
+  const IOCtlVRequest ioctlv{op.request.address};
+  u32 flags_address;
+  bool ready;
+  switch (op.net_type)
+  {
+  case IOCTLV_SO_SENDTO:
+    if (ioctlv.in_vectors.size() < 2)
+      return true;
+    flags_address = ioctlv.in_vectors[1].address + 0x04;
+    ready = write;
+    break;
+  case IOCTLV_SO_RECVFROM:
+    if (ioctlv.in_vectors.empty())
+      return true;
+    flags_address = ioctlv.in_vectors[0].address + 0x04;
+    ready = read;
+    break;
+  default:
+    return true;
+  }
+
+  // SO_MSG_NONBLOCK and SO_MSG_PEEK return right away whether there is data or not.
+  const u32 flags = Memory::Read_U32(flags_address);
+  return ready || (flags & (SO_MSG_NONBLOCK | SO_MSG_PEEK)) != 0;
+}
+
 void WiiSocket::Update(bool read, bool write, bool except)
 {
   auto it = pending_sockops.begin();
   while (it != pending_sockops.end())
   {
+    if (!IsReady(*it, read, write, except))
+    {
+      ++it;
+      continue;
+    }
+
     s32 ReturnValue = 0;
     bool forceNonBlock = false;
     IPCCommandType ct = it->request.command;
@@ -341,6 +388,7 @@ void WiiSocket::Update(bool read, bool write, bool except)
             switch (ret)
             {
             case 0:
+              Device::NetSSL::SaveSession(sslID);
               WriteReturnValue(SSL_OK, BufferIn);
               break;
             case MBEDTLS_ERR_SSL_WANT_READ:
@@ -708,10 +756,14 @@ void WiiSockMan::Update()
     const WiiSocket& sock = socket_iter->second;
     if (sock.IsValid())
     {
-      FD_SET(sock.fd, &read_fds);
-      FD_SET(sock.fd, &write_fds);
-      FD_SET(sock.fd, &except_fds);
-      nfds = std::max(nfds, sock.fd + 1);
+      // Sockets with nothing pending have nothing to be woken up for.
+      if (!sock.pending_sockops.empty())
+      {
+        FD_SET(sock.fd, &read_fds);
+        FD_SET(sock.fd, &write_fds);
+        FD_SET(sock.fd, &except_fds);
+        nfds = std::max(nfds, sock.fd + 1);
+      }
       ++socket_iter;
     }
     else
@@ -721,22 +773,25 @@ void WiiSockMan::Update()
     }
   }
 
-  const s32 ret = select(nfds, &read_fds, &write_fds, &except_fds, &t);
+  const s32 ret = nfds != 0 ? select(nfds, &read_fds, &write_fds, &except_fds, &t) : 0;
 
   if (ret >= 0)
   {
     for (auto& pair : WiiSockets)
     {
       WiiSocket& sock = pair.second;
+      if (sock.pending_sockops.empty())
+        continue;
       sock.Update(FD_ISSET(sock.fd, &read_fds) != 0, FD_ISSET(sock.fd, &write_fds) != 0,
                   FD_ISSET(sock.fd, &except_fds) != 0);
     }
   }
   else
   {
+    // Without readiness information, try everything.
     for (auto& elem : WiiSockets)
     {
-      elem.second.Update(false, false, false);
+      elem.second.Update(true, true, true);
     }
   }
   UpdatePollCommands();
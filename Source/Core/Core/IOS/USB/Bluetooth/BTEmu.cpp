@@ -372,21 +372,41 @@ void BluetoothEmu::Update()
 
 void BluetoothEmu::ACLPool::Store(const u8* data, const u16 size, const u16 conn_handle)
 {
-  if (m_queue.size() >= 100)
+  if (m_queue.size() >= MAX_PACKETS)
   {
-    // Many simultaneous exchanges of ACL packets tend to cause the queue to fill up.
-    ERROR_LOG(IOS_WIIMOTE, "ACL queue size reached 100 - current packet will be dropped!");
+    ERROR_LOG(IOS_WIIMOTE, "ACL queue size reached %d - current packet will be dropped!",
+              MAX_PACKETS);
     return;
   }
 
   DEBUG_ASSERT_MSG(IOS_WIIMOTE, size < ACL_PKT_SIZE, "ACL packet too large for pool");
 
-  m_queue.push_back(Packet());
-  auto& packet = m_queue.back();
-
+  Packet packet;
   std::copy(data, data + size, packet.data);
   packet.size = size;
   packet.conn_handle = conn_handle;
+  m_queue.push(packet);
+}
+
+void BluetoothEmu::ACLPool::DoState(PointerWrap& p)
+{
+  // Same layout as the std::deque the packets used to be stored in
+  u32 size = static_cast<u32>(m_queue.size());
+  p.Do(size);
+
+  const bool reading = p.GetMode() == PointerWrap::MODE_READ;
+  if (reading)
+    m_queue.clear();
+
+  // Cycle through the queue once, which leaves it in its original order.
+  for (u32 i = 0; i < size; ++i)
+  {
+    Packet packet{};
+    if (!reading)
+      packet = m_queue.pop_front();
+    p.Do(packet);
+    m_queue.push(packet);
+  }
 }
 
 void BluetoothEmu::ACLPool::WriteToEndpoint(const USB::V0BulkMessage& endpoint)
@@ -409,9 +429,9 @@ void BluetoothEmu::ACLPool::WriteToEndpoint(const USB::V0BulkMessage& endpoint)
   // Write the packet to the buffer
   std::copy(data, data + size, (u8*)header + sizeof(hci_acldata_hdr_t));
 
-  m_queue.pop_front();
-
   m_ios.EnqueueIPCReply(endpoint.ios_request, sizeof(hci_acldata_hdr_t) + size);
+
+  m_queue.pop();
 }
 
 bool BluetoothEmu::SendEventInquiryComplete()
@@ -767,6 +787,14 @@ bool BluetoothEmu::SendEventRoleChange(bdaddr_t bd, bool master)
 
 bool BluetoothEmu::SendEventNumberOfCompletedPackets()
 {
+  // This is checked on every update, and most of the time there is nothing to report.
+  if (std::all_of(std::begin(m_packet_count), std::end(m_packet_count),
+                  [](u32 count) { return count == 0; }))
+  {
+    DEBUG_LOG(IOS_WIIMOTE, "SendEventNumberOfCompletedPackets: no packets; no event");
+    return true;
+  }
+
   SQueuedEvent event((u32)(sizeof(hci_event_hdr_t) + sizeof(hci_num_compl_pkts_ep) +
                            (sizeof(hci_num_compl_pkts_info) * m_wiimotes.size())),
                      0);
@@ -828,7 +856,7 @@ bool BluetoothEmu::SendEventModeChange(u16 connection_handle, u8 mode, u16 value
 
   DEBUG_LOG(IOS_WIIMOTE, "Event: SendEventModeChange");
   DEBUG_LOG(IOS_WIIMOTE, "  Connection_Handle: 0x%04x", mode_change->Connection_Handle);
-  DEBUG_LOG(IOS_WIIMOTE, "  Current Mode: 0x%02x", mode_change->CurrentMode = mode);
+  DEBUG_LOG(IOS_WIIMOTE, "  Current Mode: 0x%02x", mode_change->CurrentMode);
 
   AddEventToQueue(event);
 
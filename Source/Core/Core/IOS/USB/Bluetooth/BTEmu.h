@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/FixedSizeQueue.h"
 #include "Core/HW/Wiimote.h"
 #include "Core/IOS/Device.h"
 #include "Core/IOS/IOS.h"
@@ -83,9 +84,12 @@ private:
 
     bool IsEmpty() const { return m_queue.empty(); }
     // For SaveStates
-    void DoState(PointerWrap& p) { p.Do(m_queue); }
+    void DoState(PointerWrap& p);
 
   private:
+    // Many simultaneous exchanges of ACL packets tend to cause the queue to fill up.
+    static constexpr int MAX_PACKETS = 100;
+
     struct Packet
     {
       u8 data[ACL_PKT_SIZE];
@@ -94,7 +98,9 @@ private:
     };
 
     Kernel& m_ios;
-    std::deque<Packet> m_queue;
+    // Fixed size, since a packet is queued for every report a remote sends while the game has
+    // no buffer waiting for it.
+    FixedSizeQueue<Packet, MAX_PACKETS> m_queue;
   } m_acl_pool{m_ios};
 
   u32 m_packet_count[MAX_BBMOTES] = {};
@@ -0,0 +1,206 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/InputScript.h"
+
+#include <atomic>
+#include <iterator>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+#include "Core/HW/WiimoteCommon/DataReport.h"
+#include "Core/HW/WiimoteCommon/WiimoteReport.h"
+#include "Core/Movie.h"
+
+namespace InputScript
+{
+static std::mutex s_script_mutex;
+static Script s_script;
+// Lets the CPU thread skip the lock when nothing is scripted, which is almost always
+static std::atomic<bool> s_active{false};
+
+template <typename T>
+static std::optional<T> GetHeldInput(const std::map<u64, T>& inputs, u64 frame)
+{
+  auto it = inputs.upper_bound(frame);
+  if (it == inputs.begin())
+    return std::nullopt;
+  return std::prev(it)->second;
+}
+
+std::optional<GCPadStatus> Script::GetGCInput(int pad, u64 frame) const
+{
+  return GetHeldInput(gc_pads[pad], frame);
+}
+
+std::optional<u16> Script::GetWiimoteButtons(int wiimote, u64 frame) const
+{
+  return GetHeldInput(wiimote_buttons[wiimote], frame);
+}
+
+static std::optional<int> ParseDevice(const std::string& device, const char* prefix)
+{
+  const std::string_view prefix_view = prefix;
+  if (device.size() != prefix_view.size() + 1 || device.compare(0, prefix_view.size(), prefix))
+    return std::nullopt;
+
+  const char index = device.back();
+  if (index < '0' || index > '3')
+    return std::nullopt;
+  return index - '0';
+}
+
+static bool ParseLine(const std::vector<std::string>& fields, Script* script)
+{
+  u64 frame;
+  u16 buttons;
+  if (fields.size() < 3 || !TryParse(fields[0], &frame) || !TryParse(fields[2], &buttons, 16))
+    return false;
+
+  if (const std::optional<int> wiimote = ParseDevice(fields[1], "wii"))
+  {
+    if (fields.size() != 3)
+      return false;
+    script->wiimote_buttons[*wiimote][frame] = buttons;
+    return true;
+  }
+
+  const std::optional<int> pad = ParseDevice(fields[1], "gc");
+  if (!pad || fields.size() > 9)
+    return false;
+
+  std::array<u8, 6> analog = {GCPadStatus::MAIN_STICK_CENTER_X, GCPadStatus::MAIN_STICK_CENTER_Y,
+                              GCPadStatus::C_STICK_CENTER_X,    GCPadStatus::C_STICK_CENTER_Y,
+                              0,                                0};
+  for (size_t i = 3; i < fields.size(); ++i)
+  {
+    if (!TryParse(fields[i], &analog[i - 3]))
+      return false;
+  }
+
+  GCPadStatus status{};
+  status.button = buttons;
+  status.stickX = analog[0];
+  status.stickY = analog[1];
+  status.substickX = analog[2];
+  status.substickY = analog[3];
+  status.triggerLeft = analog[4];
+  status.triggerRight = analog[5];
+  status.analogA = (buttons & PAD_BUTTON_A) ? 0xFF : 0x00;
+  status.analogB = (buttons & PAD_BUTTON_B) ? 0xFF : 0x00;
+  status.isConnected = true;
+  script->gc_pads[*pad][frame] = status;
+  return true;
+}
+
+std::optional<Script> Parse(std::string_view text, std::string* error)
+{
+  Script script;
+  std::istringstream stream{std::string(text)};
+  std::string line;
+  for (int line_number = 1; std::getline(stream, line); ++line_number)
+  {
+    line = line.substr(0, line.find('#'));
+
+    std::vector<std::string> fields;
+    std::istringstream line_stream(line);
+    for (std::string field; line_stream >> field;)
+      fields.push_back(std::move(field));
+
+    if (fields.empty())
+      continue;
+
+    if (!ParseLine(fields, &script))
+    {
+      *error = fmt::format("line {}: malformed input \"{}\"", line_number, StripSpaces(line));
+      return std::nullopt;
+    }
+  }
+  return script;
+}
+
+bool Load(const std::string& path)
+{
+  std::string text;
+  if (!File::ReadFileToString(path, text))
+  {
+    ERROR_LOG(CORE, "Could not read the input script %s", path.c_str());
+    return false;
+  }
+
+  std::string error;
+  std::optional<Script> script = Parse(text, &error);
+  if (!script)
+  {
+    ERROR_LOG(CORE, "Input script %s: %s", path.c_str(), error.c_str());
+    return false;
+  }
+
+  std::lock_guard lk(s_script_mutex);
+  s_script = std::move(*script);
+  s_active = true;
+  return true;
+}
+
+void Unload()
+{
+  std::lock_guard lk(s_script_mutex);
+  s_script = {};
+  s_active = false;
+}
+
+bool IsActive()
+{
+  return s_active;
+}
+
+void QueueGCInput(int pad, u64 frame, const GCPadStatus& status)
+{
+  std::lock_guard lk(s_script_mutex);
+  s_script.gc_pads[pad][frame] = status;
+  s_active = true;
+}
+
+void QueueWiimoteButtons(int wiimote, u64 frame, u16 buttons)
+{
+  std::lock_guard lk(s_script_mutex);
+  s_script.wiimote_buttons[wiimote][frame] = buttons;
+  s_active = true;
+}
+
+void ApplyGCInput(GCPadStatus* pad_status, int pad)
+{
+  if (!s_active)
+    return;
+
+  std::lock_guard lk(s_script_mutex);
+  if (const std::optional<GCPadStatus> status = s_script.GetGCInput(pad, Movie::GetCurrentFrame()))
+    *pad_status = *status;
+}
+
+void ApplyWiiInput(WiimoteCommon::DataReportBuilder& rpt, int wiimote)
+{
+  if (!s_active || !rpt.HasCore())
+    return;
+
+  std::lock_guard lk(s_script_mutex);
+  const std::optional<u16> buttons =
+      s_script.GetWiimoteButtons(wiimote, Movie::GetCurrentFrame());
+  if (!buttons)
+    return;
+
+  // The bits outside of the button mask carry accelerometer data
+  using WiimoteCommon::ButtonData;
+  ButtonData core;
+  rpt.GetCoreData(&core);
+  core.hex = (core.hex & ~ButtonData::BUTTON_MASK) | (*buttons & ButtonData::BUTTON_MASK);
+  rpt.SetCoreData(core);
+}
+}  // namespace InputScript
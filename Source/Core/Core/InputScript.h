@@ -0,0 +1,61 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "Common/CommonTypes.h"
+#include "InputCommon/GCPadStatus.h"
+
+namespace WiimoteCommon
+{
+class DataReportBuilder;
+}
+
+// Frame-exact scripted input for automated runs. Scripted inputs replace whatever the emulated
+// controllers report, are applied on the CPU thread as the game polls them, and are keyed on the
+// VI count from Movie::GetCurrentFrame(), so a script replays identically at any emulation speed.
+//
+// Scripts are text files with one input per line:
+//
+//   # frame  device  buttons  [stickX stickY substickX substickY triggerL triggerR]
+//   0    gc0   0000
+//   120  gc0   0100  128 255
+//   300  wii0  0008
+//
+// The device is gc0-gc3 or wii0-wii3, buttons are hex (PAD_BUTTON_* / Wiimote core button bits)
+// and missing analog values are centered. An input is held until the next line for its device.
+namespace InputScript
+{
+struct Script
+{
+  // Inputs by the frame they start on
+  std::array<std::map<u64, GCPadStatus>, 4> gc_pads;
+  std::array<std::map<u64, u16>, 4> wiimote_buttons;
+
+  std::optional<GCPadStatus> GetGCInput(int pad, u64 frame) const;
+  std::optional<u16> GetWiimoteButtons(int wiimote, u64 frame) const;
+};
+
+// Returns nothing and sets error (with the line number) if the script is malformed
+std::optional<Script> Parse(std::string_view text, std::string* error);
+
+bool Load(const std::string& path);
+void Unload();
+bool IsActive();
+
+// Inputs can also be fed while the game runs, e.g. by a harness reading them from a socket.
+// Inputs for frames that have already been polled are applied from the next poll on.
+void QueueGCInput(int pad, u64 frame, const GCPadStatus& status);
+void QueueWiimoteButtons(int wiimote, u64 frame, u16 buttons);
+
+// NOTE: CPU Thread
+void ApplyGCInput(GCPadStatus* pad_status, int pad);
+void ApplyWiiInput(WiimoteCommon::DataReportBuilder& rpt, int wiimote);
+}  // namespace InputScript
@@ -2,12 +2,20 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <fcntl.h>
 #include <fstream>
 #include <iostream>
+#include <new>
 #include <sstream>
+#include <sys/mman.h>
 #include <unistd.h>
 
+#include <fmt/format.h>
+
 #include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/HW/Memmap.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/MemoryWatcher.h"
@@ -17,8 +25,16 @@ MemoryWatcher::MemoryWatcher()
   m_running = false;
   if (!LoadAddresses(File::GetUserPath(F_MEMORYWATCHERLOCATIONS_IDX)))
     return;
-  if (!OpenSocket(File::GetUserPath(F_MEMORYWATCHERSOCKET_IDX)))
+
+  if (Config::Get(Config::MAIN_MEMORY_WATCHER_SHARED_MEMORY))
+  {
+    if (!OpenSharedMemory(File::GetUserPath(F_MEMORYWATCHERSHAREDMEMORY_IDX)))
+      return;
+  }
+  else if (!OpenSocket(File::GetUserPath(F_MEMORYWATCHERSOCKET_IDX)))
+  {
     return;
+  }
   m_running = true;
 }
 
@@ -28,6 +44,8 @@ MemoryWatcher::~MemoryWatcher()
     return;
 
   m_running = false;
+  if (m_shared_header)
+    munmap(m_shared_header, m_shared_size);
   close(m_fd);
 }
 
@@ -42,19 +60,27 @@ bool MemoryWatcher::LoadAddresses(const std::string& path)
   while (std::getline(locations, line))
     ParseLine(line);
 
-  return !m_values.empty();
+  return !m_watches.empty();
 }
 
 void MemoryWatcher::ParseLine(const std::string& line)
 {
-  m_values[line] = 0;
-  m_addresses[line] = std::vector<u32>();
+  if (std::any_of(m_watches.begin(), m_watches.end(),
+                  [&line](const Watch& watch) { return watch.address == line; }))
+  {
+    return;
+  }
+
+  Watch watch;
+  watch.address = line;
 
   std::istringstream offsets(line);
   offsets >> std::hex;
   u32 offset;
   while (offsets >> offset)
-    m_addresses[line].push_back(offset);
+    watch.offsets.push_back(offset);
+
+  m_watches.push_back(std::move(watch));
 }
 
 bool MemoryWatcher::OpenSocket(const std::string& path)
@@ -66,34 +92,91 @@ bool MemoryWatcher::OpenSocket(const std::string& path)
   return m_fd >= 0;
 }
 
-u32 MemoryWatcher::ChasePointer(const std::string& line)
+bool MemoryWatcher::OpenSharedMemory(const std::string& path)
+{
+  m_shared_size = sizeof(SharedMemoryHeader) + m_watches.size() * sizeof(u32) +
+                  CHANGE_QUEUE_SIZE * sizeof(u32);
+
+  m_fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (m_fd < 0)
+  {
+    ERROR_LOG(CORE, "Could not create the MemoryWatcher shared memory file %s", path.c_str());
+    return false;
+  }
+
+  void* mapping = MAP_FAILED;
+  if (ftruncate(m_fd, m_shared_size) == 0)
+    mapping = mmap(nullptr, m_shared_size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+  if (mapping == MAP_FAILED)
+  {
+    ERROR_LOG(CORE, "Could not map the MemoryWatcher shared memory file %s", path.c_str());
+    close(m_fd);
+    return false;
+  }
+
+  // The file was just truncated, so everything after the header starts out as zero
+  m_shared_header = new (mapping) SharedMemoryHeader{SHARED_MEMORY_MAGIC,
+                                                     SHARED_MEMORY_VERSION,
+                                                     static_cast<u32>(m_watches.size()),
+                                                     CHANGE_QUEUE_SIZE,
+                                                     {0},
+                                                     {0},
+                                                     {0}};
+  return true;
+}
+
+u32 MemoryWatcher::ChasePointer(const Watch& watch)
 {
   u32 value = 0;
-  for (u32 offset : m_addresses[line])
+  for (u32 offset : watch.offsets)
     value = Memory::Read_U32(value + offset);
   return value;
 }
 
 std::string MemoryWatcher::ComposeMessages()
 {
-  std::ostringstream message_stream;
-  message_stream << std::hex;
+  fmt::memory_buffer message;
 
-  for (auto& entry : m_values)
+  for (Watch& watch : m_watches)
   {
-    std::string address = entry.first;
-    u32& current_value = entry.second;
-
-    u32 new_value = ChasePointer(address);
-    if (new_value != current_value)
+    const u32 new_value = ChasePointer(watch);
+    if (new_value != watch.value)
     {
       // Update the value
-      current_value = new_value;
-      message_stream << address << '\n' << new_value << '\n';
+      watch.value = new_value;
+      fmt::format_to(message, "{}\n{:x}\n", watch.address, new_value);
     }
   }
 
-  return message_stream.str();
+  return fmt::to_string(message);
+}
+
+void MemoryWatcher::WriteSharedMemory()
+{
+  u32* const values = reinterpret_cast<u32*>(m_shared_header + 1);
+  u32* const change_queue = values + m_watches.size();
+
+  const u64 sequence = m_shared_header->sequence.load(std::memory_order_relaxed);
+  m_shared_header->sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  u64 changes = m_shared_header->changes.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < m_watches.size(); ++i)
+  {
+    Watch& watch = m_watches[i];
+    const u32 new_value = ChasePointer(watch);
+    if (new_value == watch.value)
+      continue;
+
+    watch.value = new_value;
+    values[i] = new_value;
+    change_queue[changes % CHANGE_QUEUE_SIZE] = static_cast<u32>(i);
+    ++changes;
+  }
+
+  m_shared_header->changes.store(changes, std::memory_order_relaxed);
+  m_shared_header->frame.fetch_add(1, std::memory_order_relaxed);
+  m_shared_header->sequence.store(sequence + 2, std::memory_order_release);
 }
 
 void MemoryWatcher::Step()
@@ -101,6 +184,12 @@ void MemoryWatcher::Step()
   if (!m_running)
     return;
 
+  if (m_shared_header)
+  {
+    WriteSharedMemory();
+    return;
+  }
+
   std::string message = ComposeMessages();
   sendto(m_fd, message.c_str(), message.size() + 1, 0, reinterpret_cast<sockaddr*>(&m_addr),
          sizeof(m_addr));
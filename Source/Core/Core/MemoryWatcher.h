@@ -4,11 +4,14 @@
 
 #pragma once
 
-#include <map>
+#include <atomic>
+#include <string>
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <vector>
 
+#include "Common/CommonTypes.h"
+
 // MemoryWatcher reads a file containing in-game memory addresses and outputs
 // changes to those memory addresses to a unix domain socket as the game runs.
 //
@@ -17,28 +20,65 @@
 // "ABCD EF" will watch the address at (*0xABCD) + 0xEF.
 // The output to the socket is two lines. The first is the address from the
 // input file, and the second is the new value in hex.
+//
+// With MAIN_MEMORY_WATCHER_SHARED_MEMORY set, nothing is sent over the socket. The values are
+// instead written in binary to a file in the MemoryWatcher directory, which readers should map
+// into memory. It starts with a SharedMemoryHeader, followed by a u32 value for each address in
+// the order of the input file and then by a ring of u32 indices of the values that changed.
+// Everything is in host byte order.
 class MemoryWatcher final
 {
 public:
+  static constexpr u32 SHARED_MEMORY_MAGIC = 0x53574d44;  // "DMWS"
+  static constexpr u32 SHARED_MEMORY_VERSION = 1;
+  static constexpr u32 CHANGE_QUEUE_SIZE = 4096;
+
+  struct SharedMemoryHeader
+  {
+    u32 magic;
+    u32 version;
+    u32 num_values;
+    u32 change_queue_size;
+    // Odd while the values are being written. Readers should retry if it's odd or changed while
+    // they were reading.
+    std::atomic<u64> sequence;
+    // Number of frames the values were updated for
+    std::atomic<u64> frame;
+    // Number of changes written to the ring so far. The latest is at (changes - 1) % size.
+    std::atomic<u64> changes;
+  };
+  static_assert(std::atomic<u64>::is_always_lock_free);
+
   MemoryWatcher();
   ~MemoryWatcher();
   void Step();
 
 private:
+  struct Watch
+  {
+    // Address as stored in the file
+    std::string address;
+    // Offsets to follow, parsed once when the file is loaded
+    std::vector<u32> offsets;
+    u32 value = 0;
+  };
+
   bool LoadAddresses(const std::string& path);
   bool OpenSocket(const std::string& path);
+  bool OpenSharedMemory(const std::string& path);
 
   void ParseLine(const std::string& line);
-  u32 ChasePointer(const std::string& line);
+  static u32 ChasePointer(const Watch& watch);
   std::string ComposeMessages();
+  void WriteSharedMemory();
 
   bool m_running = false;
 
-  int m_fd;
+  int m_fd = -1;
   sockaddr_un m_addr{};
 
-  // Address as stored in the file -> list of offsets to follow
-  std::map<std::string, std::vector<u32>> m_addresses;
-  // Address as stored in the file -> current value
-  std::map<std::string, u32> m_values;
+  std::vector<Watch> m_watches;
+
+  SharedMemoryHeader* m_shared_header = nullptr;
+  size_t m_shared_size = 0;
 };
@@ -6,12 +6,15 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cctype>
 #include <cstring>
 #include <iomanip>
 #include <iterator>
+#include <map>
 #include <mbedtls/config.h>
 #include <mbedtls/md.h>
+#include <memory>
 #include <mutex>
 #include <sstream>
 #include <thread>
@@ -20,6 +23,7 @@
 #include <vector>
 
 #include <fmt/format.h>
+#include <zstd.h>
 
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
@@ -59,8 +63,10 @@
 
 #include "Core/IOS/USB/Bluetooth/BTEmu.h"
 #include "Core/IOS/USB/Bluetooth/WiimoteDevice.h"
+#include "Core/InputScript.h"
 #include "Core/NetPlayProto.h"
 #include "Core/State.h"
+#include "Core/StateDelta.h"
 
 #include "DiscIO/Enums.h"
 
@@ -116,6 +122,28 @@ static WiiManipFunction s_wii_manip_func;
 
 static std::string s_current_file_name;
 
+// The seek index starts out with a state every 10 seconds at 60 Hz. Once it holds
+// SEEK_INDEX_MAX_POINTS states, every other one is dropped and the interval doubles, which bounds
+// its memory use while a seek never has to emulate more than one interval.
+constexpr u64 SEEK_INDEX_INITIAL_INTERVAL = 600;
+constexpr size_t SEEK_INDEX_MAX_POINTS = 128;
+constexpr int SEEK_INDEX_COMPRESSION_LEVEL = 1;
+
+struct SeekPoint
+{
+  std::shared_ptr<const State::Snapshot> base;
+  // The pages of the delta are zstd compressed
+  State::Delta delta;
+  size_t page_data_size;
+};
+
+// Only accessed on the CPU thread, or while it's paused
+static std::map<u64, SeekPoint> s_seek_points;
+static u64 s_seek_interval = SEEK_INDEX_INITIAL_INTERVAL;
+static u64 s_next_seek_point_frame = SEEK_INDEX_INITIAL_INTERVAL;
+static std::atomic<bool> s_seek_point_pending{false};
+static std::atomic<u64> s_seek_target{0};
+
 static void GetSettings();
 static bool IsMovieHeader(const std::array<u8, 4>& magic)
 {
@@ -191,6 +219,78 @@ std::string GetRTCDisplay()
   return format_time.str();
 }
 
+static void ClearSeekIndex()
+{
+  s_seek_points.clear();
+  s_seek_interval = SEEK_INDEX_INITIAL_INTERVAL;
+  s_next_seek_point_frame = SEEK_INDEX_INITIAL_INTERVAL;
+  s_seek_target = 0;
+}
+
+// NOTE: CPU Thread
+static void AddSeekPoint()
+{
+  s_seek_point_pending = false;
+  if (!IsPlayingInput() || s_seek_points.count(s_currentFrame))
+    return;
+
+  State::Snapshot snapshot;
+  State::SaveToSnapshot(snapshot);
+
+  SeekPoint point;
+  const auto next = s_seek_points.lower_bound(s_currentFrame);
+  if (next != s_seek_points.begin())
+  {
+    point.base = std::prev(next)->second.base;
+    point.delta = State::CreateDelta(*point.base, snapshot);
+  }
+  // Deltas grow as the game moves away from its base, and a large one costs about as much to keep
+  // as a full state
+  if (!point.base || point.delta.page_data.size() > point.base->buffer.size() / 4)
+  {
+    point.base = std::make_shared<const State::Snapshot>(std::move(snapshot));
+    point.delta = State::CreateDelta(*point.base, *point.base);
+  }
+
+  point.page_data_size = point.delta.page_data.size();
+  std::vector<u8> compressed(ZSTD_compressBound(point.page_data_size));
+  const size_t compressed_size =
+      ZSTD_compress(compressed.data(), compressed.size(), point.delta.page_data.data(),
+                    point.page_data_size, SEEK_INDEX_COMPRESSION_LEVEL);
+  if (ZSTD_isError(compressed_size))
+    return;
+  compressed.resize(compressed_size);
+  point.delta.page_data = std::move(compressed);
+
+  s_seek_points.emplace(s_currentFrame, std::move(point));
+
+  if (s_seek_points.size() > SEEK_INDEX_MAX_POINTS)
+  {
+    for (auto it = std::next(s_seek_points.begin()); it != s_seek_points.end();)
+    {
+      it = s_seek_points.erase(it);
+      if (it != s_seek_points.end())
+        ++it;
+    }
+    s_seek_interval *= 2;
+  }
+  s_next_seek_point_frame = s_seek_points.rbegin()->first + s_seek_interval;
+}
+
+// NOTE: CPU Thread
+static bool LoadSeekPoint(const SeekPoint& point)
+{
+  State::Delta delta = point.delta;
+  delta.page_data.resize(point.page_data_size);
+  const size_t size = ZSTD_decompress(delta.page_data.data(), delta.page_data.size(),
+                                      point.delta.page_data.data(), point.delta.page_data.size());
+  if (ZSTD_isError(size) || size != delta.page_data.size())
+    return false;
+
+  State::LoadFromSnapshot(State::ApplyDelta(*point.base, delta));
+  return true;
+}
+
 void FrameUpdate()
 {
   s_currentFrame++;
@@ -204,6 +304,57 @@ void FrameUpdate()
   }
 
   s_bPolled = false;
+
+  if (s_seek_target != 0 && s_currentFrame >= s_seek_target)
+    s_seek_target = 0;
+
+  // States can't be saved in the middle of a CoreTiming event like this VI update, so the host
+  // thread has the CPU thread stop at its next safe point instead
+  if (IsPlayingInput() && SConfig::GetInstance().m_MovieSeekIndex &&
+      s_currentFrame >= s_next_seek_point_frame && !s_seek_point_pending.exchange(true))
+  {
+    Core::QueueHostJob([] { Core::RunOnCPUThread(AddSeekPoint, true); });
+  }
+}
+
+bool SeekToFrame(u64 frame)
+{
+  if (!IsPlayingInput() || frame == 0 || frame > s_totalFrames)
+    return false;
+
+  bool success = true;
+  Core::RunOnCPUThread(
+      [&] {
+        // Use the closest state before the frame, unless the frame is reached by just carrying on
+        const auto next = s_seek_points.upper_bound(frame);
+        if (next != s_seek_points.begin() &&
+            (frame < s_currentFrame || std::prev(next)->first > s_currentFrame))
+        {
+          success = LoadSeekPoint(std::prev(next)->second);
+        }
+        else
+        {
+          success = frame >= s_currentFrame;
+        }
+
+        if (success && frame > s_currentFrame)
+        {
+          s_seek_target = frame;
+          Core::BreakAtFrame(frame);
+        }
+      },
+      true);
+
+  if (!success)
+    return false;
+
+  Core::SetState(s_seek_target != 0 ? Core::State::Running : Core::State::Paused);
+  return true;
+}
+
+bool IsSeeking()
+{
+  return s_seek_target != 0;
 }
 
 static void CheckMD5();
@@ -896,6 +1047,7 @@ bool PlayInput(const std::string& movie_path, std::optional<std::string>* savest
   s_currentFrame = 0;
   s_currentLagCount = 0;
   s_currentInputCount = 0;
+  ClearSeekIndex();
 
   s_playMode = MODE_PLAYING;
 
@@ -1268,6 +1420,7 @@ void EndPlayInput(bool cont)
     s_rerecords = 0;
     s_currentByte = 0;
     s_playMode = MODE_NONE;
+    ClearSeekIndex();
     Core::DisplayMessage("Movie End.", 2000);
     s_bRecordingFromSaveState = false;
     // we don't clear these things because otherwise we can't resume playback if we load a movie
@@ -1356,12 +1509,14 @@ void CallGCInputManip(GCPadStatus* PadStatus, int controllerID)
 {
   if (s_gc_manip_func)
     s_gc_manip_func(PadStatus, controllerID);
+  InputScript::ApplyGCInput(PadStatus, controllerID);
 }
 // NOTE: CPU Thread
 void CallWiiInputManip(DataReportBuilder& rpt, int controllerID, int ext, const EncryptionKey& key)
 {
   if (s_wii_manip_func)
     s_wii_manip_func(rpt, controllerID, ext, key);
+  InputScript::ApplyWiiInput(rpt, controllerID);
 }
 
 // NOTE: GPU Thread
@@ -1493,5 +1648,6 @@ void Shutdown()
 {
   s_currentInputCount = s_totalInputCount = s_totalFrames = s_tickCountAtLastInput = 0;
   s_temp_input.clear();
+  ClearSeekIndex();
 }
 }  // namespace Movie
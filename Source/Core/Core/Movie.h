@@ -109,7 +109,8 @@ struct DTMHeader
   u8 language;
   u8 reserved3;
   bool bFollowBranch;
-  std::array<u8, 9> reserved;       // Padding for any new config options
+  bool bDSPThread;
+  std::array<u8, 8> reserved;       // Padding for any new config options
   std::array<char, 40> discChange;  // Name of iso file to switch to, for two disc games.
   std::array<u8, 20> revision;      // Git hash
   u32 DSPiromHash;
@@ -161,6 +162,13 @@ void ChangeWiiPads(bool instantly = false);
 
 void SetReadOnly(bool bEnabled);
 
+// Jumps a movie that is being played back to the given frame. If m_MovieSeekIndex is set, states
+// kept in memory during playback are loaded so that only the frames after the closest one have to
+// be emulated, which happens without throttling. Emulation pauses once the frame is reached.
+// NOTE: Host Thread
+bool SeekToFrame(u64 frame);
+bool IsSeeking();
+
 bool BeginRecordingInput(int controllers);
 void RecordInput(const GCPadStatus* PadStatus, int controllerID);
 void RecordWiimote(int wiimote, const u8* data, u8 size);
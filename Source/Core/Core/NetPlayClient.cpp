@@ -16,8 +16,8 @@
 #include <vector>
 
 #include <fmt/format.h>
-#include <lzo/lzo1x.h>
 #include <mbedtls/md5.h>
+#include <zstd.h>
 
 #include "Common/Assert.h"
 #include "Common/CommonPaths.h"
@@ -499,20 +499,24 @@ unsigned int NetPlayClient::OnData(sf::Packet& packet)
 
   case NP_MSG_WIIMOTE_DATA:
   {
-    PadIndex map;
-    NetWiimote nw;
-    u8 size;
-    packet >> map >> size;
+    // The server relays the data of several Wiimotes in one packet
+    while (!packet.endOfPacket())
+    {
+      PadIndex map;
+      NetWiimote nw;
+      u8 size;
+      packet >> map >> size;
 
-    nw.resize(size);
+      nw.resize(size);
 
-    for (unsigned int i = 0; i < size; ++i)
-      packet >> nw[i];
+      for (unsigned int i = 0; i < size; ++i)
+        packet >> nw[i];
 
-    // Trusting server for good map value (>=0 && <4)
-    // add to Wiimote buffer
-    m_wiimote_buffer.at(map).Push(nw);
-    m_wii_pad_event.Set();
+      // Trusting server for good map value (>=0 && <4)
+      // add to Wiimote buffer
+      m_wiimote_buffer.at(map).Push(nw);
+      m_wii_pad_event.Set();
+    }
   }
   break;
 
@@ -640,6 +644,7 @@ unsigned int NetPlayClient::OnData(sf::Packet& packet)
       packet >> m_net_settings.m_PAL60;
       packet >> m_net_settings.m_DSPEnableJIT;
       packet >> m_net_settings.m_DSPHLE;
+      packet >> m_net_settings.m_DSPThread;
       packet >> m_net_settings.m_WriteToMemcard;
       packet >> m_net_settings.m_CopyWiiSave;
       packet >> m_net_settings.m_OCEnable;
@@ -1580,6 +1585,22 @@ void NetPlayClient::SyncCodeResponse(const bool success)
   }
 }
 
+// Reads the next compressed block written by NetPlayServer::CompressBufferIntoPacket. Returns
+// false once the end of the data has been reached.
+static bool ReadCompressedBlock(sf::Packet& packet, std::vector<u8>* block)
+{
+  u32 block_size = 0;
+  packet >> block_size;
+  if (!block_size)
+    return false;
+
+  block->resize(block_size);
+  for (u8& byte : *block)
+    packet >> byte;
+
+  return true;
+}
+
 bool NetPlayClient::DecompressPacketIntoFile(sf::Packet& packet, const std::string& file_path)
 {
   u64 file_size = Common::PacketReadU64(packet);
@@ -1594,27 +1615,19 @@ bool NetPlayClient::DecompressPacketIntoFile(sf::Packet& packet, const std::stri
     return false;
   }
 
-  std::vector<u8> in_buffer(NETPLAY_LZO_OUT_LEN);
-  std::vector<u8> out_buffer(NETPLAY_LZO_IN_LEN);
+  std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> context(ZSTD_createDCtx(), &ZSTD_freeDCtx);
+  std::vector<u8> in_buffer;
+  std::vector<u8> out_buffer(NETPLAY_SYNC_BLOCK_SIZE);
 
-  while (true)
+  // Every block is written out as soon as it has been decompressed, so the whole file never has
+  // to be held in memory.
+  while (ReadCompressedBlock(packet, &in_buffer))
   {
-    u32 cur_len = 0;       // number of bytes to read
-    lzo_uint new_len = 0;  // number of bytes to write
-
-    packet >> cur_len;
-    if (!cur_len)
-      break;  // We reached the end of the data stream
-
-    for (size_t j = 0; j < cur_len; j++)
-    {
-      packet >> in_buffer[j];
-    }
-
-    if (lzo1x_decompress(in_buffer.data(), cur_len, out_buffer.data(), &new_len, nullptr) !=
-        LZO_E_OK)
+    const size_t new_len = ZSTD_decompressDCtx(context.get(), out_buffer.data(), out_buffer.size(),
+                                               in_buffer.data(), in_buffer.size());
+    if (ZSTD_isError(new_len))
     {
-      PanicAlertT("Internal LZO Error - decompression failed");
+      PanicAlertT("Internal zstd Error - decompression failed");
       return false;
     }
 
@@ -1637,26 +1650,17 @@ std::optional<std::vector<u8>> NetPlayClient::DecompressPacketIntoBuffer(sf::Pac
   if (size == 0)
     return out_buffer;
 
-  std::vector<u8> in_buffer(NETPLAY_LZO_OUT_LEN);
+  std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> context(ZSTD_createDCtx(), &ZSTD_freeDCtx);
+  std::vector<u8> in_buffer;
 
-  lzo_uint i = 0;
-  while (true)
+  size_t i = 0;
+  while (ReadCompressedBlock(packet, &in_buffer))
   {
-    u32 cur_len = 0;       // number of bytes to read
-    lzo_uint new_len = 0;  // number of bytes to write
-
-    packet >> cur_len;
-    if (!cur_len)
-      break;  // We reached the end of the data stream
-
-    for (size_t j = 0; j < cur_len; j++)
-    {
-      packet >> in_buffer[j];
-    }
-
-    if (lzo1x_decompress(in_buffer.data(), cur_len, &out_buffer[i], &new_len, nullptr) != LZO_E_OK)
+    const size_t new_len = ZSTD_decompressDCtx(context.get(), out_buffer.data() + i, size - i,
+                                               in_buffer.data(), in_buffer.size());
+    if (ZSTD_isError(new_len))
     {
-      PanicAlertT("Internal LZO Error - decompression failed");
+      PanicAlertT("Internal zstd Error - decompression failed");
       return {};
     }
 
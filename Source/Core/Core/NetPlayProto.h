@@ -31,6 +31,7 @@ struct NetSettings
   bool m_PAL60;
   bool m_DSPHLE;
   bool m_DSPEnableJIT;
+  bool m_DSPThread;
   bool m_WriteToMemcard;
   bool m_CopyWiiSave;
   bool m_OCEnable;
@@ -196,8 +197,9 @@ enum
   SYNC_CODES_FAILURE = 6,
 };
 
-constexpr u32 NETPLAY_LZO_IN_LEN = 1024 * 64;
-constexpr u32 NETPLAY_LZO_OUT_LEN = NETPLAY_LZO_IN_LEN + (NETPLAY_LZO_IN_LEN / 16) + 64 + 3;
+// Synced saves are split into blocks of this size, which are compressed independently
+constexpr u32 NETPLAY_SYNC_BLOCK_SIZE = 1024 * 256;
+constexpr int NETPLAY_SYNC_COMPRESSION_LEVEL = 3;
 constexpr u32 MAX_NAME_LENGTH = 30;
 constexpr size_t CHUNKED_DATA_UNIT_SIZE = 16384;
 constexpr u8 CHANNEL_COUNT = 2;
@@ -0,0 +1,139 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/NetPlayRollback.h"
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "Common/Assert.h"
+#include "Core/State.h"
+#include "Core/StateDelta.h"
+
+namespace NetPlay
+{
+// Once a delta holds this fraction of its base's size, the next state becomes a new base. Deltas
+// only ever grow as the game moves away from its base, and applying a large delta costs about as
+// much as loading a full state.
+constexpr size_t REBASE_DIVISOR = 4;
+
+static bool operator==(const GCPadStatus& a, const GCPadStatus& b)
+{
+  return a.button == b.button && a.stickX == b.stickX && a.stickY == b.stickY &&
+         a.substickX == b.substickX && a.substickY == b.substickY &&
+         a.triggerLeft == b.triggerLeft && a.triggerRight == b.triggerRight &&
+         a.analogA == b.analogA && a.analogB == b.analogB && a.isConnected == b.isConnected;
+}
+
+GCPadStatus InputPredictor::GetInput(size_t pad, u64 frame)
+{
+  Pad& state = m_pads[pad];
+
+  const auto confirmed = state.confirmed_inputs.find(frame);
+  if (confirmed != state.confirmed_inputs.end())
+    return confirmed->second;
+
+  return state.guesses.emplace(frame, state.last_confirmed_input).first->second;
+}
+
+void InputPredictor::ConfirmInput(size_t pad, u64 frame, const GCPadStatus& status)
+{
+  Pad& state = m_pads[pad];
+
+  state.confirmed_inputs[frame] = status;
+  state.last_confirmed_input = status;
+
+  const auto guess = state.guesses.find(frame);
+  if (guess == state.guesses.end())
+    return;
+
+  if (!(guess->second == status))
+    m_first_mispredicted_frame = std::min(m_first_mispredicted_frame.value_or(frame), frame);
+
+  state.guesses.erase(guess);
+}
+
+void InputPredictor::RollBack(u64 frame)
+{
+  for (Pad& state : m_pads)
+    state.guesses.erase(state.guesses.lower_bound(frame), state.guesses.end());
+
+  if (m_first_mispredicted_frame >= frame)
+    m_first_mispredicted_frame.reset();
+}
+
+void InputPredictor::DiscardBefore(u64 frame)
+{
+  for (Pad& state : m_pads)
+  {
+    state.confirmed_inputs.erase(state.confirmed_inputs.begin(),
+                                 state.confirmed_inputs.lower_bound(frame));
+    state.guesses.erase(state.guesses.begin(), state.guesses.lower_bound(frame));
+  }
+}
+
+void InputPredictor::Clear()
+{
+  m_pads = {};
+  m_first_mispredicted_frame.reset();
+}
+
+RollbackStateRing::RollbackStateRing(size_t max_frames) : m_max_frames(max_frames)
+{
+  ASSERT(max_frames != 0);
+}
+
+void RollbackStateRing::Save(u64 frame)
+{
+  ASSERT(m_entries.empty() || m_entries.back().frame < frame);
+
+  State::Snapshot snapshot;
+  State::SaveToSnapshot(snapshot);
+
+  Entry entry{frame, nullptr, {}};
+  if (!m_entries.empty())
+  {
+    entry.base = m_entries.back().base;
+    entry.delta = State::CreateDelta(*entry.base, snapshot);
+  }
+
+  if (!entry.base || entry.delta.page_data.size() > entry.base->buffer.size() / REBASE_DIVISOR)
+  {
+    entry.base = std::make_shared<const State::Snapshot>(std::move(snapshot));
+    entry.delta = State::CreateDelta(*entry.base, *entry.base);
+  }
+
+  if (m_entries.size() == m_max_frames)
+    m_entries.pop_front();
+  m_entries.push_back(std::move(entry));
+}
+
+bool RollbackStateRing::Load(u64 frame)
+{
+  const auto it = std::find_if(m_entries.begin(), m_entries.end(),
+                               [frame](const Entry& entry) { return entry.frame == frame; });
+  if (it == m_entries.end())
+    return false;
+
+  State::Snapshot snapshot = State::ApplyDelta(*it->base, it->delta);
+  State::LoadFromSnapshot(snapshot);
+
+  m_entries.erase(it + 1, m_entries.end());
+  return true;
+}
+
+std::optional<u64> RollbackStateRing::GetOldestFrame() const
+{
+  if (m_entries.empty())
+    return std::nullopt;
+  return m_entries.front().frame;
+}
+
+void RollbackStateRing::Clear()
+{
+  m_entries.clear();
+}
+}  // namespace NetPlay
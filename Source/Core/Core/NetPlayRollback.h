@@ -0,0 +1,94 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// Building blocks for rolling back netplay: instead of waiting for remote inputs, emulation goes
+// ahead with guessed ones, and when a guess turns out to be wrong, the state from before that
+// frame is loaded and the frames since then are emulated again with the real inputs.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <memory>
+#include <optional>
+
+#include "Common/CommonTypes.h"
+#include "Core/StateDelta.h"
+#include "InputCommon/GCPadStatus.h"
+
+namespace NetPlay
+{
+// Hands out inputs for pads whose real inputs may not have arrived yet, and keeps track of which
+// of those guesses were wrong.
+class InputPredictor
+{
+public:
+  static constexpr size_t NUM_PADS = 4;
+
+  // Returns the real input of pad on frame if it has arrived. Otherwise, returns a guess: the last
+  // real input, since that's what the player is most likely still holding. Asking for the same
+  // frame again returns the same guess.
+  GCPadStatus GetInput(size_t pad, u64 frame);
+
+  // Records the real input of pad on frame, and checks it against the guess for frame, if any.
+  void ConfirmInput(size_t pad, u64 frame, const GCPadStatus& status);
+
+  // The earliest frame that was emulated with a wrong guess. Rolling back to the start of it and
+  // emulating it again fixes that.
+  std::optional<u64> GetFirstMispredictedFrame() const { return m_first_mispredicted_frame; }
+
+  // Forgets the guesses for frame and the frames after it, which is what rolling back to the start
+  // of frame does to them.
+  void RollBack(u64 frame);
+
+  // Forgets the inputs of the frames before frame, once those can't be rolled back to anymore.
+  void DiscardBefore(u64 frame);
+
+  void Clear();
+
+private:
+  struct Pad
+  {
+    std::map<u64, GCPadStatus> confirmed_inputs;
+    std::map<u64, GCPadStatus> guesses;
+    // The most recent real input, kept even once its frame has been discarded
+    GCPadStatus last_confirmed_input{};
+  };
+
+  std::array<Pad, NUM_PADS> m_pads;
+  std::optional<u64> m_first_mispredicted_frame;
+};
+
+// In-memory states for the start of each of the most recent frames. Most of the emulated memory
+// doesn't change from one frame to the next, so the states are stored as deltas against a full
+// state, which is replaced once the deltas against it get large.
+class RollbackStateRing
+{
+public:
+  explicit RollbackStateRing(size_t max_frames);
+
+  // Saves the current state as the start of frame. Frames must be saved in increasing order.
+  void Save(u64 frame);
+
+  // Loads the state saved for the start of frame, and forgets the frames after it, since those
+  // are about to be emulated again. Returns false if frame isn't in the ring anymore.
+  bool Load(u64 frame);
+
+  std::optional<u64> GetOldestFrame() const;
+  void Clear();
+
+private:
+  struct Entry
+  {
+    u64 frame;
+    std::shared_ptr<const State::Snapshot> base;
+    State::Delta delta;
+  };
+
+  size_t m_max_frames;
+  std::deque<Entry> m_entries;
+};
+}  // namespace NetPlay
@@ -9,6 +9,7 @@
 #include <cinttypes>
 #include <cstddef>
 #include <cstdio>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -19,7 +20,7 @@
 #include <vector>
 
 #include <fmt/format.h>
-#include <lzo/lzo1x.h>
+#include <zstd.h>
 
 #include "Common/CommonPaths.h"
 #include "Common/ENetUtil.h"
@@ -248,7 +249,16 @@ void NetPlayServer::ThreadFunc()
     int net;
     if (m_traversal_client)
       m_traversal_client->HandleResends();
-    net = enet_host_service(m_server, &netEvent, 1000);
+    // While relayed inputs are queued, only the events that have already been received are
+    // handled, so that everything that arrived together gets relayed together.
+    net = m_has_queued_inputs ? enet_host_check_events(m_server, &netEvent) : 0;
+    if (net <= 0)
+    {
+      SendQueuedInputs();
+      net = enet_host_service(m_server, &netEvent, 1000);
+    }
+    if (!m_async_queue.Empty())
+      SendQueuedInputs();
     while (!m_async_queue.Empty())
     {
       {
@@ -321,6 +331,8 @@ void NetPlayServer::ThreadFunc()
       break;
       case ENET_EVENT_TYPE_DISCONNECT:
       {
+        SendQueuedInputs();
+
         std::lock_guard<std::recursive_mutex> lkg(m_crit.game);
         if (!netEvent.peer->data)
           break;
@@ -504,6 +516,7 @@ unsigned int NetPlayServer::OnDisconnect(const Client& player)
   auto it = m_players.find(player.pid);
   if (it != m_players.end())
     m_players.erase(it);
+  m_queued_inputs.erase(pid);
 
   // alert other players of disconnect
   SendToClients(spac);
@@ -664,6 +677,10 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
 
   INFO_LOG(NETPLAY, "Got client message: %x", mid);
 
+  // Anything else may depend on the inputs that came before it
+  if (mid != NP_MSG_PAD_DATA && mid != NP_MSG_PAD_HOST_DATA && mid != NP_MSG_WIIMOTE_DATA)
+    SendQueuedInputs();
+
   // don't need lock because this is the only thread that modifies the players
   // only need locks for writes to m_players in this thread
 
@@ -713,8 +730,8 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
     if (player.current_game != m_current_game)
       break;
 
-    sf::Packet spac;
-    spac << static_cast<MessageId>(m_host_input_authority ? NP_MSG_PAD_HOST_DATA : NP_MSG_PAD_DATA);
+    sf::Packet& entries = m_input_entries;
+    entries.clear();
 
     while (!packet.endOfPacket())
     {
@@ -732,20 +749,24 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
       packet >> pad.button >> pad.analogA >> pad.analogB >> pad.stickX >> pad.stickY >>
           pad.substickX >> pad.substickY >> pad.triggerLeft >> pad.triggerRight >> pad.isConnected;
 
-      spac << map << pad.button << pad.analogA << pad.analogB << pad.stickX << pad.stickY
-           << pad.substickX << pad.substickY << pad.triggerLeft << pad.triggerRight
-           << pad.isConnected;
+      entries << map << pad.button << pad.analogA << pad.analogB << pad.stickX << pad.stickY
+              << pad.substickX << pad.substickY << pad.triggerLeft << pad.triggerRight
+              << pad.isConnected;
     }
 
     if (m_host_input_authority)
     {
+      sf::Packet spac;
+      spac << static_cast<MessageId>(NP_MSG_PAD_HOST_DATA);
+      spac.append(entries.getData(), entries.getDataSize());
+
       // Prevent crash before game stop if the golfer disconnects
       if (m_current_golfer != 0 && m_players.find(m_current_golfer) != m_players.end())
         Send(m_players.at(m_current_golfer).socket, spac);
     }
     else
     {
-      SendToClients(spac, player.pid);
+      QueueInputs(NP_MSG_PAD_DATA, entries, player.pid);
     }
   }
   break;
@@ -756,8 +777,8 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
     if (m_current_golfer != 0 && player.pid != m_current_golfer)
       return 1;
 
-    sf::Packet spac;
-    spac << static_cast<MessageId>(NP_MSG_PAD_DATA);
+    sf::Packet& entries = m_input_entries;
+    entries.clear();
 
     while (!packet.endOfPacket())
     {
@@ -768,12 +789,12 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
       packet >> pad.button >> pad.analogA >> pad.analogB >> pad.stickX >> pad.stickY >>
           pad.substickX >> pad.substickY >> pad.triggerLeft >> pad.triggerRight >> pad.isConnected;
 
-      spac << map << pad.button << pad.analogA << pad.analogB << pad.stickX << pad.stickY
-           << pad.substickX << pad.substickY << pad.triggerLeft << pad.triggerRight
-           << pad.isConnected;
+      entries << map << pad.button << pad.analogA << pad.analogB << pad.stickX << pad.stickY
+              << pad.substickX << pad.substickY << pad.triggerLeft << pad.triggerRight
+              << pad.isConnected;
     }
 
-    SendToClients(spac, player.pid);
+    QueueInputs(NP_MSG_PAD_DATA, entries, player.pid);
   }
   break;
 
@@ -786,9 +807,6 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
     PadIndex map;
     u8 size;
     packet >> map >> size;
-    std::vector<u8> data(size);
-    for (u8& byte : data)
-      packet >> byte;
 
     // If the data is not from the correct player,
     // then disconnect them.
@@ -798,14 +816,17 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
     }
 
     // relay to clients
-    sf::Packet spac;
-    spac << (MessageId)NP_MSG_WIIMOTE_DATA;
-    spac << map;
-    spac << size;
-    for (const u8& byte : data)
-      spac << byte;
+    sf::Packet& entries = m_input_entries;
+    entries.clear();
+    entries << map << size;
+    for (u8 i = 0; i < size; ++i)
+    {
+      u8 byte;
+      packet >> byte;
+      entries << byte;
+    }
 
-    SendToClients(spac, player.pid);
+    QueueInputs(NP_MSG_WIIMOTE_DATA, entries, player.pid);
   }
   break;
 
@@ -1290,6 +1311,7 @@ bool NetPlayServer::StartGame()
   spac << m_settings.m_PAL60;
   spac << m_settings.m_DSPEnableJIT;
   spac << m_settings.m_DSPHLE;
+  spac << m_settings.m_DSPThread;
   spac << m_settings.m_WriteToMemcard;
   spac << m_settings.m_CopyWiiSave;
   spac << m_settings.m_OCEnable;
@@ -1765,64 +1787,14 @@ bool NetPlayServer::CompressFileIntoPacket(const std::string& file_path, sf::Pac
     return false;
   }
 
-  const sf::Uint64 size = file.GetSize();
-  packet << size;
-
-  if (size == 0)
-    return true;
-
-  std::vector<u8> in_buffer(NETPLAY_LZO_IN_LEN);
-  std::vector<u8> out_buffer(NETPLAY_LZO_OUT_LEN);
-  std::vector<u8> wrkmem(LZO1X_1_MEM_COMPRESS);
-
-  lzo_uint i = 0;
-  while (true)
+  std::vector<u8> data(file.GetSize());
+  if (!file.ReadBytes(data.data(), data.size()))
   {
-    lzo_uint32 cur_len = 0;  // number of bytes to read
-    lzo_uint out_len = 0;    // number of bytes to write
-
-    if ((i + NETPLAY_LZO_IN_LEN) >= size)
-    {
-      cur_len = static_cast<lzo_uint32>(size - i);
-    }
-    else
-    {
-      cur_len = NETPLAY_LZO_IN_LEN;
-    }
-
-    if (cur_len <= 0)
-      break;  // EOF
-
-    if (!file.ReadBytes(in_buffer.data(), cur_len))
-    {
-      PanicAlertT("Error reading file: %s", file_path.c_str());
-      return false;
-    }
-
-    if (lzo1x_1_compress(in_buffer.data(), cur_len, out_buffer.data(), &out_len, wrkmem.data()) !=
-        LZO_E_OK)
-    {
-      PanicAlertT("Internal LZO Error - compression failed");
-      return false;
-    }
-
-    // The size of the data to write is 'out_len'
-    packet << static_cast<u32>(out_len);
-    for (size_t j = 0; j < out_len; j++)
-    {
-      packet << out_buffer[j];
-    }
-
-    if (cur_len != NETPLAY_LZO_IN_LEN)
-      break;
-
-    i += cur_len;
+    PanicAlertT("Error reading file: %s", file_path.c_str());
+    return false;
   }
 
-  // Mark end of data
-  packet << static_cast<u32>(0);
-
-  return true;
+  return CompressBufferIntoPacket(data, packet);
 }
 
 bool NetPlayServer::CompressBufferIntoPacket(const std::vector<u8>& in_buffer, sf::Packet& packet)
@@ -1833,45 +1805,54 @@ bool NetPlayServer::CompressBufferIntoPacket(const std::vector<u8>& in_buffer, s
   if (size == 0)
     return true;
 
-  std::vector<u8> out_buffer(NETPLAY_LZO_OUT_LEN);
-  std::vector<u8> wrkmem(LZO1X_1_MEM_COMPRESS);
+  // Memory cards and sets of Wii saves can be tens of megabytes, so the blocks are compressed on
+  // several threads. Every thread takes every num_threads-th block.
+  const size_t num_blocks = (size + NETPLAY_SYNC_BLOCK_SIZE - 1) / NETPLAY_SYNC_BLOCK_SIZE;
+  const size_t num_threads =
+      std::clamp<size_t>(std::thread::hardware_concurrency(), 1, std::min<size_t>(num_blocks, 8));
 
-  lzo_uint i = 0;
-  while (true)
+  std::vector<std::vector<u8>> compressed_blocks(num_blocks);
+  std::vector<std::future<bool>> threads;
+  for (size_t first_block = 0; first_block < num_threads; ++first_block)
   {
-    lzo_uint32 cur_len = 0;  // number of bytes to read
-    lzo_uint out_len = 0;    // number of bytes to write
+    threads.emplace_back(std::async(std::launch::async, [&, first_block] {
+      std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> context(ZSTD_createCCtx(),
+                                                                   &ZSTD_freeCCtx);
+      if (!context)
+        return false;
 
-    if ((i + NETPLAY_LZO_IN_LEN) >= size)
-    {
-      cur_len = static_cast<lzo_uint32>(size - i);
-    }
-    else
-    {
-      cur_len = NETPLAY_LZO_IN_LEN;
-    }
-
-    if (cur_len <= 0)
-      break;  // end of buffer
-
-    if (lzo1x_1_compress(&in_buffer[i], cur_len, out_buffer.data(), &out_len, wrkmem.data()) !=
-        LZO_E_OK)
-    {
-      PanicAlertT("Internal LZO Error - compression failed");
-      return false;
-    }
+      for (size_t block = first_block; block < num_blocks; block += num_threads)
+      {
+        const size_t offset = block * NETPLAY_SYNC_BLOCK_SIZE;
+        const size_t block_size = std::min<size_t>(NETPLAY_SYNC_BLOCK_SIZE, size - offset);
+
+        std::vector<u8>& out_buffer = compressed_blocks[block];
+        out_buffer.resize(ZSTD_compressBound(block_size));
+        const size_t out_size =
+            ZSTD_compressCCtx(context.get(), out_buffer.data(), out_buffer.size(),
+                              &in_buffer[offset], block_size, NETPLAY_SYNC_COMPRESSION_LEVEL);
+        if (ZSTD_isError(out_size))
+          return false;
+        out_buffer.resize(out_size);
+      }
+      return true;
+    }));
+  }
 
-    // The size of the data to write is 'out_len'
-    packet << static_cast<u32>(out_len);
-    for (size_t j = 0; j < out_len; j++)
-    {
-      packet << out_buffer[j];
-    }
+  bool success = true;
+  for (std::future<bool>& thread : threads)
+    success &= thread.get();
 
-    if (cur_len != NETPLAY_LZO_IN_LEN)
-      break;
+  if (!success)
+  {
+    PanicAlertT("Internal zstd Error - compression failed");
+    return false;
+  }
 
-    i += cur_len;
+  for (const std::vector<u8>& out_buffer : compressed_blocks)
+  {
+    packet << static_cast<u32>(out_buffer.size());
+    packet.append(out_buffer.data(), out_buffer.size());
   }
 
   // Mark end of data
@@ -1910,6 +1891,46 @@ void NetPlayServer::Send(ENetPeer* socket, const sf::Packet& packet, const u8 ch
   enet_peer_send(socket, channel_id, epac);
 }
 
+// called from ---NETPLAY--- thread
+void NetPlayServer::QueueInputs(MessageId mid, const sf::Packet& entries, PlayerId skip_pid)
+{
+  for (const auto& p : m_players)
+  {
+    if (!p.second.pid || p.second.pid == skip_pid)
+      continue;
+
+    QueuedInputs& queued = m_queued_inputs[p.second.pid];
+    sf::Packet& packet = mid == NP_MSG_WIIMOTE_DATA ? queued.wiimote_data : queued.pad_data;
+    if (packet.getDataSize() == 0)
+      packet << mid;
+    packet.append(entries.getData(), entries.getDataSize());
+  }
+
+  m_has_queued_inputs = true;
+}
+
+// called from ---NETPLAY--- thread
+void NetPlayServer::SendQueuedInputs()
+{
+  if (!m_has_queued_inputs)
+    return;
+
+  for (auto& [pid, queued] : m_queued_inputs)
+  {
+    const auto it = m_players.find(pid);
+    for (sf::Packet* packet : {&queued.pad_data, &queued.wiimote_data})
+    {
+      if (packet->getDataSize() != 0 && it != m_players.end())
+        Send(it->second.socket, *packet);
+
+      // Clearing keeps the allocation around for the next batch
+      packet->clear();
+    }
+  }
+
+  m_has_queued_inputs = false;
+}
+
 void NetPlayServer::KickPlayer(PlayerId player)
 {
   for (auto& current_player : m_players)
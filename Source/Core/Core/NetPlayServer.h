@@ -107,6 +107,13 @@ private:
     u8 channel_id;
   };
 
+  // Inputs to be relayed to a player, each packet holding the entries of several messages
+  struct QueuedInputs
+  {
+    sf::Packet pad_data;
+    sf::Packet wiimote_data;
+  };
+
   struct ChunkedDataQueueEntry
   {
     sf::Packet packet;
@@ -126,6 +133,8 @@ private:
   void SendToClients(const sf::Packet& packet, PlayerId skip_pid = 0,
                      u8 channel_id = DEFAULT_CHANNEL);
   void Send(ENetPeer* socket, const sf::Packet& packet, u8 channel_id = DEFAULT_CHANNEL);
+  void QueueInputs(MessageId mid, const sf::Packet& entries, PlayerId skip_pid);
+  void SendQueuedInputs();
   unsigned int OnConnect(ENetPeer* socket, sf::Packet& rpac);
   unsigned int OnDisconnect(const Client& player);
   unsigned int OnData(sf::Packet& packet, Client& player);
@@ -165,6 +174,10 @@ private:
 
   std::map<PlayerId, Client> m_players;
 
+  std::map<PlayerId, QueuedInputs> m_queued_inputs;
+  bool m_has_queued_inputs = false;
+  sf::Packet m_input_entries;
+
   std::unordered_map<u32, std::vector<std::pair<PlayerId, u64>>> m_timebase_by_frame;
   bool m_desync_detected;
 
@@ -37,8 +37,63 @@ constexpr std::array<const char*, 3> s_patch_type_strings{{
 }};
 
 static std::vector<Patch> s_on_frame;
+static WriteList s_on_frame_writes;
 static std::map<u32, int> s_speed_hacks;
 
+void WriteList::Add(u32 address, u32 value, u32 size)
+{
+  for (u32 i = 0; i < size; ++i)
+    m_pending.emplace_back(address + i, static_cast<u8>(value >> (8 * (size - 1 - i))));
+}
+
+void WriteList::Add(const WriteList& other)
+{
+  for (const Run& run : other.m_runs)
+  {
+    for (size_t i = 0; i < run.data.size(); ++i)
+      m_pending.emplace_back(run.address + static_cast<u32>(i), run.data[i]);
+  }
+  m_pending.insert(m_pending.end(), other.m_pending.begin(), other.m_pending.end());
+}
+
+void WriteList::Finalize()
+{
+  if (m_pending.empty())
+    return;
+
+  std::vector<std::pair<u32, u8>> bytes;
+  for (const Run& run : m_runs)
+  {
+    for (size_t i = 0; i < run.data.size(); ++i)
+      bytes.emplace_back(run.address + static_cast<u32>(i), run.data[i]);
+  }
+  bytes.insert(bytes.end(), m_pending.begin(), m_pending.end());
+  m_pending.clear();
+  m_runs.clear();
+
+  // Sorting stably keeps the writes to each address in order, so the last one is the one to keep
+  std::stable_sort(bytes.begin(), bytes.end(),
+                   [](const auto& a, const auto& b) { return a.first < b.first; });
+  for (size_t i = 0; i < bytes.size(); ++i)
+  {
+    if (i + 1 < bytes.size() && bytes[i + 1].first == bytes[i].first)
+      continue;
+
+    if (m_runs.empty() ||
+        u64{m_runs.back().address} + m_runs.back().data.size() != u64{bytes[i].first})
+    {
+      m_runs.push_back(Run{bytes[i].first, {}});
+    }
+    m_runs.back().data.push_back(bytes[i].second);
+  }
+}
+
+void WriteList::Apply() const
+{
+  for (const Run& run : m_runs)
+    PowerPC::HostWriteBytes(run.data.data(), run.address, run.data.size());
+}
+
 const char* PatchTypeAsString(PatchType type)
 {
   return s_patch_type_strings.at(static_cast<int>(type));
@@ -158,6 +213,39 @@ int GetSpeedhackCycles(const u32 addr)
   return iter->second;
 }
 
+// The patches only ever write constants, so they are merged once here instead of being walked
+// every frame
+static WriteList CompilePatches(const std::vector<Patch>& patches)
+{
+  WriteList writes;
+  for (const Patch& patch : patches)
+  {
+    if (!patch.active)
+      continue;
+
+    for (const PatchEntry& entry : patch.entries)
+    {
+      switch (entry.type)
+      {
+      case PatchType::Patch8Bit:
+        writes.Add(entry.address, entry.value, sizeof(u8));
+        break;
+      case PatchType::Patch16Bit:
+        writes.Add(entry.address, entry.value, sizeof(u16));
+        break;
+      case PatchType::Patch32Bit:
+        writes.Add(entry.address, entry.value, sizeof(u32));
+        break;
+      default:
+        // unknown patchtype
+        break;
+      }
+    }
+  }
+  writes.Finalize();
+  return writes;
+}
+
 void LoadPatches()
 {
   IniFile merged = SConfig::GetInstance().LoadGameIni();
@@ -165,6 +253,7 @@ void LoadPatches()
   IniFile localIni = SConfig::GetInstance().LoadLocalGameIni();
 
   LoadPatchSection("OnFrame", s_on_frame, globalIni, localIni);
+  s_on_frame_writes = CompilePatches(s_on_frame);
 
   // Check if I'm syncing Codes
   if (Config::Get(Config::MAIN_CODE_SYNC_OVERRIDE))
@@ -181,35 +270,6 @@ void LoadPatches()
   LoadSpeedhacks("Speedhacks", merged);
 }
 
-static void ApplyPatches(const std::vector<Patch>& patches)
-{
-  for (const Patch& patch : patches)
-  {
-    if (patch.active)
-    {
-      for (const PatchEntry& entry : patch.entries)
-      {
-        u32 addr = entry.address;
-        u32 value = entry.value;
-        switch (entry.type)
-        {
-        case PatchType::Patch8Bit:
-          PowerPC::HostWrite_U8(static_cast<u8>(value), addr);
-          break;
-        case PatchType::Patch16Bit:
-          PowerPC::HostWrite_U16(static_cast<u16>(value), addr);
-          break;
-        case PatchType::Patch32Bit:
-          PowerPC::HostWrite_U32(value, addr);
-          break;
-        default:
-          // unknown patchtype
-          break;
-        }
-      }
-    }
-  }
-}
 
 // Requires MSR.DR, MSR.IR
 // There's no perfect way to do this, it's just a heuristic.
@@ -249,7 +309,7 @@ bool ApplyFramePatches()
     return false;
   }
 
-  ApplyPatches(s_on_frame);
+  s_on_frame_writes.Apply();
 
   // Run the Gecko code handler
   Gecko::RunCodeHandler();
@@ -261,6 +321,7 @@ bool ApplyFramePatches()
 void Shutdown()
 {
   s_on_frame.clear();
+  s_on_frame_writes = {};
   s_speed_hacks.clear();
   ActionReplay::ApplyCodes({});
   Gecko::Shutdown();
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -37,6 +38,33 @@ struct Patch
   bool user_defined = false;  // False if this code is shipped with Dolphin.
 };
 
+// Constant writes to emulated memory, merged into runs of contiguous bytes so that applying them
+// takes a copy per run rather than a write per entry. Where writes overlap, the one added last
+// wins, like it would when writing them one by one.
+class WriteList
+{
+public:
+  // Writes the size lowest bytes of value, big-endian
+  void Add(u32 address, u32 value, u32 size);
+  void Add(const WriteList& other);
+  // Merges what was added since the last call. Needs to be called before Apply.
+  void Finalize();
+
+  bool IsEmpty() const { return m_runs.empty() && m_pending.empty(); }
+  void Apply() const;
+
+private:
+  struct Run
+  {
+    u32 address;
+    std::vector<u8> data;
+  };
+
+  // Bytes added since the last Finalize, in the order they were added
+  std::vector<std::pair<u32, u8>> m_pending;
+  std::vector<Run> m_runs;
+};
+
 const char* PatchTypeAsString(PatchType type);
 
 int GetSpeedhackCycles(const u32 addr);
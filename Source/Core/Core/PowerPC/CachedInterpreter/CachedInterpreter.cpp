@@ -4,6 +4,7 @@
 
 #include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
 
+#include "Common/BitUtils.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Core/ConfigManager.h"
@@ -11,14 +12,32 @@
 #include "Core/HLE/HLE.h"
 #include "Core/HW/CPU.h"
 #include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/Interpreter/Interpreter.h"
 #include "Core/PowerPC/Jit64Common/Jit64Constants.h"
+#include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PowerPC.h"
 
+// The fields of an instruction, extracted when the block is compiled so that the handlers for the
+// most common instructions don't have to decode them every time they run. The register fields
+// keep the meaning they have in the instruction (rt is RD or RS), and the immediate is already
+// sign extended or shifted into place.
+struct DecodedOperands
+{
+  u8 rt;
+  u8 ra;
+  u8 sh;
+  u8 crf;
+  u32 imm;
+  // The instruction that was fused into this one, if any
+  u32 fused_inst;
+};
+
 struct CachedInterpreter::Instruction
 {
   using CommonCallback = void (*)(UGeckoInstruction);
   using ConditionalCallback = bool (*)(u32);
+  using DecodedCallback = void (*)(const DecodedOperands&);
 
   Instruction() {}
   Instruction(const CommonCallback c, UGeckoInstruction i)
@@ -31,20 +50,31 @@ struct CachedInterpreter::Instruction
   {
   }
 
+  Instruction(const DecodedCallback c, const DecodedOperands& o)
+      : decoded_callback(c), operands(o), type(Type::Decoded)
+  {
+  }
+
   enum class Type
   {
     Abort,
     Common,
     Conditional,
+    Decoded,
   };
 
   union
   {
     const CommonCallback common_callback;
     const ConditionalCallback conditional_callback;
+    const DecodedCallback decoded_callback;
   };
 
-  u32 data = 0;
+  union
+  {
+    u32 data = 0;
+    DecodedOperands operands;
+  };
   Type type = Type::Abort;
 };
 
@@ -100,6 +130,10 @@ void CachedInterpreter::ExecuteOneBlock()
         return;
       break;
 
+    case Instruction::Type::Decoded:
+      code->decoded_callback(code->operands);
+      break;
+
     default:
       ERROR_LOG(POWERPC, "Unknown CachedInterpreter Instruction: %d", static_cast<int>(code->type));
       break;
@@ -190,6 +224,182 @@ static bool CheckIdle(u32 idle_pc)
   return false;
 }
 
+// li, lis, and lis followed by addi or ori on the same register
+static void LoadImmediate(const DecodedOperands& ops)
+{
+  rGPR[ops.rt] = ops.imm;
+}
+
+// addi and addis
+static void AddImmediate(const DecodedOperands& ops)
+{
+  rGPR[ops.rt] = rGPR[ops.ra] + ops.imm;
+}
+
+// ori and oris
+static void OrImmediate(const DecodedOperands& ops)
+{
+  rGPR[ops.ra] = rGPR[ops.rt] | ops.imm;
+}
+
+// rlwinm without a CR0 update
+static void RotateAndMask(const DecodedOperands& ops)
+{
+  rGPR[ops.ra] = Common::RotateLeft(rGPR[ops.rt], ops.sh) & ops.imm;
+}
+
+static void LoadWord(const DecodedOperands& ops)
+{
+  const u32 address = ops.ra ? rGPR[ops.ra] + ops.imm : ops.imm;
+  const u32 value = PowerPC::Read_U32(address);
+  if (!(PowerPC::ppcState.Exceptions & EXCEPTION_DSI))
+    rGPR[ops.rt] = value;
+}
+
+static void StoreWord(const DecodedOperands& ops)
+{
+  const u32 address = ops.ra ? rGPR[ops.ra] + ops.imm : ops.imm;
+  PowerPC::Write_U32(rGPR[ops.rt], address);
+}
+
+static void SetCompareResult(u32 field, bool less, bool greater)
+{
+  u32 f = less ? 0x8 : greater ? 0x4 : 0x2;
+  if (PowerPC::GetXER_SO())
+    f |= 0x1;
+  PowerPC::ppcState.cr.SetField(field, f);
+}
+
+// cmpi and cmpli, followed by the bc which uses the result if they were fused
+static void CompareImmediate(const DecodedOperands& ops)
+{
+  const s32 a = static_cast<s32>(rGPR[ops.ra]);
+  const s32 b = static_cast<s32>(ops.imm);
+  SetCompareResult(ops.crf, a < b, a > b);
+  if (ops.fused_inst)
+    Interpreter::bcx(UGeckoInstruction(ops.fused_inst));
+}
+
+static void CompareLogicalImmediate(const DecodedOperands& ops)
+{
+  const u32 a = rGPR[ops.ra];
+  SetCompareResult(ops.crf, a < ops.imm, a > ops.imm);
+  if (ops.fused_inst)
+    Interpreter::bcx(UGeckoInstruction(ops.fused_inst));
+}
+
+// Whether the instruction at the given index can be left out and done by the handler of the one
+// after it instead. Nothing may have to happen in between, so the second instruction can't have a
+// breakpoint or a hook on it.
+bool CachedInterpreter::CanFuseWithNext(u32 index) const
+{
+  if (index + 1 >= code_block.m_num_instructions || SConfig::GetInstance().bEnableDebugging)
+    return false;
+
+  const PPCAnalyst::CodeOp& op = m_code_buffer[index];
+  const PPCAnalyst::CodeOp& next = m_code_buffer[index + 1];
+  if (op.skip || next.skip || HLE::GetFirstFunctionIndex(next.address) != 0)
+    return false;
+
+  switch (op.inst.OPCD)
+  {
+  case 10:  // cmpli
+  case 11:  // cmpi
+    return next.inst.OPCD == 16;  // bcx
+  case 15:  // lis
+    // addi reads zero rather than r0 when rA is 0
+    return op.inst.RA == 0 &&
+           ((next.inst.OPCD == 14 && next.inst.RD == op.inst.RD &&  // addi
+             next.inst.RA == op.inst.RD && op.inst.RD != 0) ||
+            (next.inst.OPCD == 24 && next.inst.RA == op.inst.RD &&  // ori
+             next.inst.RS == op.inst.RD));
+  default:
+    return false;
+  }
+}
+
+// Emits a handler which works on pre-decoded operands, for the instruction alone or with the
+// previous one fused into it. Returns false if there is no such handler for it.
+bool CachedInterpreter::EmitDecoded(const PPCAnalyst::CodeOp& op,
+                                    const PPCAnalyst::CodeOp* fused_op)
+{
+  const UGeckoInstruction inst = op.inst;
+  DecodedOperands ops{};
+
+  if (fused_op)
+  {
+    const UGeckoInstruction first = fused_op->inst;
+    if (inst.OPCD == 16)  // bcx
+    {
+      ops.ra = static_cast<u8>(first.RA);
+      ops.crf = static_cast<u8>(first.CRFD);
+      ops.fused_inst = inst.hex;
+      if (first.OPCD == 11)  // cmpi
+      {
+        ops.imm = static_cast<u32>(first.SIMM_16);
+        m_code.emplace_back(CompareImmediate, ops);
+      }
+      else
+      {
+        ops.imm = first.UIMM;
+        m_code.emplace_back(CompareLogicalImmediate, ops);
+      }
+      return true;
+    }
+
+    // lis followed by addi or ori
+    const u32 high = first.UIMM << 16;
+    ops.rt = static_cast<u8>(first.RD);
+    ops.imm = inst.OPCD == 14 ? high + static_cast<u32>(inst.SIMM_16) : high | inst.UIMM;
+    m_code.emplace_back(LoadImmediate, ops);
+    return true;
+  }
+
+  ops.rt = static_cast<u8>(inst.RD);
+  ops.ra = static_cast<u8>(inst.RA);
+  switch (inst.OPCD)
+  {
+  case 10:  // cmpli
+    ops.crf = static_cast<u8>(inst.CRFD);
+    ops.imm = inst.UIMM;
+    m_code.emplace_back(CompareLogicalImmediate, ops);
+    return true;
+  case 11:  // cmpi
+    ops.crf = static_cast<u8>(inst.CRFD);
+    ops.imm = static_cast<u32>(inst.SIMM_16);
+    m_code.emplace_back(CompareImmediate, ops);
+    return true;
+  case 14:  // addi
+  case 15:  // addis
+    ops.imm = inst.OPCD == 14 ? static_cast<u32>(inst.SIMM_16) :
+                                static_cast<u32>(inst.SIMM_16) << 16;
+    m_code.emplace_back(inst.RA ? AddImmediate : LoadImmediate, ops);
+    return true;
+  case 21:  // rlwinmx
+    if (inst.Rc)
+      return false;
+    ops.sh = static_cast<u8>(inst.SH);
+    ops.imm = MakeRotationMask(inst.MB, inst.ME);
+    m_code.emplace_back(RotateAndMask, ops);
+    return true;
+  case 24:  // ori
+  case 25:  // oris
+    ops.imm = inst.OPCD == 24 ? inst.UIMM : inst.UIMM << 16;
+    m_code.emplace_back(OrImmediate, ops);
+    return true;
+  case 32:  // lwz
+    ops.imm = static_cast<u32>(inst.SIMM_16);
+    m_code.emplace_back(LoadWord, ops);
+    return true;
+  case 36:  // stw
+    ops.imm = static_cast<u32>(inst.SIMM_16);
+    m_code.emplace_back(StoreWord, ops);
+    return true;
+  default:
+    return false;
+  }
+}
+
 bool CachedInterpreter::HandleFunctionHooking(u32 address)
 {
   return HLE::ReplaceFunctionIfPossible(address, [&](u32 function, HLE::HookType type) {
@@ -235,6 +445,9 @@ void CachedInterpreter::Jit(u32 address)
   b->checkedEntry = GetCodePtr();
   b->normalEntry = GetCodePtr();
 
+  // Set when the previous instruction is left to the handler of the current one
+  const PPCAnalyst::CodeOp* fused_op = nullptr;
+
   for (u32 i = 0; i < code_block.m_num_instructions; i++)
   {
     PPCAnalyst::CodeOp& op = m_code_buffer[i];
@@ -244,6 +457,12 @@ void CachedInterpreter::Jit(u32 address)
     if (HandleFunctionHooking(op.address))
       break;
 
+    if (!fused_op && CanFuseWithNext(i))
+    {
+      fused_op = &op;
+      continue;
+    }
+
     if (!op.skip)
     {
       const bool breakpoint = SConfig::GetInstance().bEnableDebugging &&
@@ -268,11 +487,13 @@ void CachedInterpreter::Jit(u32 address)
 
       if (endblock || memcheck)
         m_code.emplace_back(WritePC, op.address);
-      m_code.emplace_back(PPCTables::GetInterpreterOp(op.inst), op.inst);
+      if (!EmitDecoded(op, fused_op))
+        m_code.emplace_back(PPCTables::GetInterpreterOp(op.inst), op.inst);
+      fused_op = nullptr;
       if (memcheck)
         m_code.emplace_back(CheckDSI, js.downcountAmount);
       if (idle_loop)
-        m_code.emplace_back(CheckIdle, js.blockStart);
+        m_code.emplace_back(CheckIdle, op.branchTo);
       if (endblock)
         m_code.emplace_back(EndBlock, js.downcountAmount);
     }
@@ -39,6 +39,8 @@ private:
   void ExecuteOneBlock();
 
   bool HandleFunctionHooking(u32 address);
+  bool CanFuseWithNext(u32 index) const;
+  bool EmitDecoded(const PPCAnalyst::CodeOp& op, const PPCAnalyst::CodeOp* fused_op);
 
   BlockCache m_block_cache{*this};
   std::vector<Instruction> m_code;
@@ -4,9 +4,12 @@
 
 // Originally written by Sven Peter <sven@fail0verflow.com> for anergistic.
 
+#include <atomic>
+#include <mutex>
 #include <signal.h>
 #include <stdio.h>
 #include <string.h>
+#include <thread>
 #include <unistd.h>
 #ifdef _WIN32
 #include <iphlpapi.h>
@@ -18,7 +21,9 @@
 #include <sys/un.h>
 #endif
 
+#include "Common/Flag.h"
 #include "Common/Logging/Log.h"
+#include "Common/Thread.h"
 #include "Core/HW/CPU.h"
 #include "Core/HW/Memmap.h"
 #include "Core/Host.h"
@@ -27,13 +32,18 @@
 #include "Core/PowerPC/PPCCache.h"
 #include "Core/PowerPC/PowerPC.h"
 
-#define GDB_BFR_MAX 10000
+// Also the packet size reported to gdb, which otherwise splits memory transfers into packets of a
+// few hundred bytes
+#define GDB_BFR_MAX 0x10000
 #define GDB_MAX_BP 10
 
 #define GDB_STUB_START '$'
 #define GDB_STUB_END '#'
 #define GDB_STUB_ACK '+'
 #define GDB_STUB_NAK '-'
+#define GDB_STUB_ESCAPE '}'
+#define GDB_STUB_RUN_LENGTH '*'
+#define GDB_STUB_INTERRUPT 0x03
 
 static int tmpsock = -1;
 static int sock = -1;
@@ -41,9 +51,23 @@ static int sock = -1;
 static u8 cmd_bfr[GDB_BFR_MAX];
 static u32 cmd_len;
 
+// Received bytes are read in bulk and handed out one at a time from here
+static u8 recv_bfr[GDB_BFR_MAX];
+static u32 recv_pos = 0;
+static u32 recv_len = 0;
+
 static u32 sig = 0;
-static u32 send_signal = 0;
-static u32 step_break = 0;
+// Also set by the interrupt thread
+static std::atomic<u32> send_signal{0};
+static std::atomic<u32> step_break{0};
+
+// While the game runs, a thread waits for gdb to send an interrupt, so that nothing has to poll
+// the socket from the CPU thread. The socket (and the receive buffer) belongs to the CPU thread
+// while it's handling an exception.
+static std::thread interrupt_thread;
+static Common::Flag interrupt_thread_shutdown;
+static std::mutex socket_mutex;
+static bool in_exception = false;
 
 typedef struct
 {
@@ -103,17 +127,22 @@ static void hex2mem(u8* dst, u8* src, u32 len)
 
 static u8 gdb_read_byte()
 {
-  ssize_t res;
-  u8 c = '+';
-
-  res = recv(sock, &c, 1, MSG_WAITALL);
-  if (res != 1)
+  if (recv_pos == recv_len)
   {
-    ERROR_LOG(GDB_STUB, "recv failed : %ld", res);
-    gdb_deinit();
+    recv_pos = 0;
+    recv_len = 0;
+
+    ssize_t res = recv(sock, reinterpret_cast<char*>(recv_bfr), sizeof recv_bfr, 0);
+    if (res <= 0)
+    {
+      ERROR_LOG(GDB_STUB, "recv failed : %ld", res);
+      gdb_deinit();
+      return '+';
+    }
+    recv_len = static_cast<u32>(res);
   }
 
-  return c;
+  return recv_bfr[recv_pos++];
 }
 
 static u8 gdb_calc_chksum()
@@ -249,7 +278,7 @@ static void gdb_read_command()
     // ignore ack
     return;
   }
-  else if (c == 0x03)
+  else if (c == GDB_STUB_INTERRUPT)
   {
     CPU::Break();
     gdb_signal(GDB_SIGTRAP);
@@ -292,31 +321,85 @@ static void gdb_read_command()
   gdb_ack();
 }
 
-static int gdb_data_available()
+static int gdb_socket_readable(int fd, long timeout_us)
 {
   struct timeval t;
   fd_set _fds, *fds = &_fds;
 
   FD_ZERO(fds);
-  FD_SET(sock, fds);
+  FD_SET(fd, fds);
 
   t.tv_sec = 0;
-  t.tv_usec = 20;
+  t.tv_usec = timeout_us;
 
-  if (select(sock + 1, fds, nullptr, nullptr, &t) < 0)
+  if (select(fd + 1, fds, nullptr, nullptr, &t) < 0)
   {
     ERROR_LOG(GDB_STUB, "select failed");
     return 0;
   }
 
-  if (FD_ISSET(sock, fds))
+  if (FD_ISSET(fd, fds))
     return 1;
   return 0;
 }
 
-static void gdb_reply(const char* reply)
+static int gdb_data_available()
+{
+  if (recv_pos != recv_len)
+    return 1;
+  return gdb_socket_readable(sock, 20);
+}
+
+static void gdb_interrupt_thread(int fd)
+{
+  Common::SetCurrentThreadName("GDB stub interrupt thread");
+
+  while (!interrupt_thread_shutdown.IsSet())
+  {
+    if (!gdb_socket_readable(fd, 50000))
+      continue;
+
+    std::unique_lock lk(socket_mutex);
+    if (in_exception)
+    {
+      // The CPU thread is reading the socket itself
+      lk.unlock();
+      Common::SleepCurrentThread(10);
+      continue;
+    }
+
+    u8 c;
+    if (recv_pos != recv_len)
+    {
+      c = recv_bfr[recv_pos];
+    }
+    else if (recv(fd, reinterpret_cast<char*>(&c), 1, MSG_PEEK) != 1)
+    {
+      // Disconnected, which the CPU thread finds out about on its own
+      return;
+    }
+
+    if (c != GDB_STUB_INTERRUPT)
+    {
+      // Anything else waits for the next exception
+      lk.unlock();
+      Common::SleepCurrentThread(10);
+      continue;
+    }
+
+    if (recv_pos != recv_len)
+      recv_pos++;
+    else
+      recv(fd, reinterpret_cast<char*>(&c), 1, 0);
+
+    DEBUG_LOG(GDB_STUB, "gdb: interrupted");
+    gdb_break();
+  }
+}
+
+static void gdb_reply_data(const u8* reply, u32 len)
 {
-  u8 chk;
+  u8 chk = 0;
   u32 left;
   u8* ptr;
   int n;
@@ -324,21 +407,22 @@ static void gdb_reply(const char* reply)
   if (!gdb_active())
     return;
 
-  memset(cmd_bfr, 0, sizeof cmd_bfr);
-
-  cmd_len = strlen(reply);
-  if (cmd_len + 4 > sizeof cmd_bfr)
+  if (len + 5 > sizeof cmd_bfr)
+  {
     ERROR_LOG(GDB_STUB, "cmd_bfr overflow in gdb_reply");
+    return;
+  }
 
+  cmd_len = len;
   memcpy(cmd_bfr + 1, reply, cmd_len);
+  for (u32 i = 0; i < len; i++)
+    chk += reply[i];
 
-  cmd_len++;
-  chk = gdb_calc_chksum();
-  cmd_len--;
   cmd_bfr[0] = GDB_STUB_START;
   cmd_bfr[cmd_len + 1] = GDB_STUB_END;
   cmd_bfr[cmd_len + 2] = nibble2hex(chk >> 4);
   cmd_bfr[cmd_len + 3] = nibble2hex(chk);
+  cmd_bfr[cmd_len + 4] = '\0';
 
   DEBUG_LOG(GDB_STUB, "gdb: reply (len: %d): %s", cmd_len, cmd_bfr);
 
@@ -357,6 +441,11 @@ static void gdb_reply(const char* reply)
   }
 }
 
+static void gdb_reply(const char* reply)
+{
+  gdb_reply_data(reinterpret_cast<const u8*>(reply), static_cast<u32>(strlen(reply)));
+}
+
 static void gdb_handle_query()
 {
   DEBUG_LOG(GDB_STUB, "gdb: query '%s'", cmd_bfr + 1);
@@ -366,6 +455,13 @@ static void gdb_handle_query()
     return gdb_reply("T0");
   }
 
+  if (!memcmp(cmd_bfr + 1, "Supported", 9))
+  {
+    char bfr[64];
+    sprintf(bfr, "PacketSize=%x;binary-upload+", GDB_BFR_MAX - 5);
+    return gdb_reply(bfr);
+  }
+
   gdb_reply("");
 }
 
@@ -559,53 +655,118 @@ static void gdb_write_register()
   gdb_reply("OK");
 }
 
+static u32 gdb_parse_addr_len(u32* addr, u32* len, u8 terminator)
+{
+  u32 i = 1;
+  *addr = 0;
+  while (i < cmd_len && cmd_bfr[i] != ',')
+    *addr = (*addr << 4) | hex2char(cmd_bfr[i++]);
+  i++;
+
+  *len = 0;
+  while (i < cmd_len && cmd_bfr[i] != terminator)
+    *len = (*len << 4) | hex2char(cmd_bfr[i++]);
+  return i + 1;
+}
+
+static bool gdb_is_valid_range(u32 addr, u32 len)
+{
+  return len == 0 || (Memory::GetPointer(addr) && Memory::GetPointer(addr + len - 1));
+}
+
 static void gdb_read_mem()
 {
-  static u8 reply[GDB_BFR_MAX - 4];
+  static u8 reply[GDB_BFR_MAX - 5];
   u32 addr, len;
-  u32 i;
 
-  i = 1;
-  addr = 0;
-  while (cmd_bfr[i] != ',')
-    addr = (addr << 4) | hex2char(cmd_bfr[i++]);
-  i++;
-
-  len = 0;
-  while (i < cmd_len)
-    len = (len << 4) | hex2char(cmd_bfr[i++]);
+  gdb_parse_addr_len(&addr, &len, '\0');
   DEBUG_LOG(GDB_STUB, "gdb: read memory: %08x bytes from %08x", len, addr);
 
-  if (len * 2 > sizeof reply)
-    gdb_reply("E01");
-  u8* data = Memory::GetPointer(addr);
-  if (!data)
+  if (len * 2 + 1 > sizeof reply)
+    return gdb_reply("E01");
+  if (!gdb_is_valid_range(addr, len))
     return gdb_reply("E0");
-  mem2hex(reply, data, len);
+  mem2hex(reply, Memory::GetPointer(addr), len);
   reply[len * 2] = '\0';
   gdb_reply((char*)reply);
 }
 
 static void gdb_write_mem()
 {
+  static u8 data[GDB_BFR_MAX / 2];
   u32 addr, len;
-  u32 i;
 
-  i = 1;
-  addr = 0;
-  while (cmd_bfr[i] != ',')
-    addr = (addr << 4) | hex2char(cmd_bfr[i++]);
-  i++;
-
-  len = 0;
-  while (cmd_bfr[i] != ':')
-    len = (len << 4) | hex2char(cmd_bfr[i++]);
+  const u32 i = gdb_parse_addr_len(&addr, &len, ':');
   DEBUG_LOG(GDB_STUB, "gdb: write memory: %08x bytes to %08x", len, addr);
 
-  u8* dst = Memory::GetPointer(addr);
-  if (!dst)
+  if (len > sizeof data || i + len * 2 > cmd_len)
+    return gdb_reply("E01");
+  if (!gdb_is_valid_range(addr, len))
     return gdb_reply("E00");
-  hex2mem(dst, cmd_bfr + i + 1, len);
+  hex2mem(data, cmd_bfr + i, len);
+  Memory::CopyToEmu(addr, data, len);
+  gdb_reply("OK");
+}
+
+static void gdb_read_mem_binary()
+{
+  static u8 reply[GDB_BFR_MAX - 5];
+  u32 addr, len;
+
+  gdb_parse_addr_len(&addr, &len, '\0');
+  DEBUG_LOG(GDB_STUB, "gdb: read binary memory: %08x bytes from %08x", len, addr);
+
+  // Every byte might have to be escaped
+  if (len * 2 + 1 > sizeof reply)
+    return gdb_reply("E01");
+  if (!gdb_is_valid_range(addr, len))
+    return gdb_reply("E01");
+
+  const u8* src = Memory::GetPointer(addr);
+  u32 reply_len = 0;
+  reply[reply_len++] = 'b';
+  for (u32 i = 0; i < len; i++)
+  {
+    const u8 c = src[i];
+    if (c == GDB_STUB_START || c == GDB_STUB_END || c == GDB_STUB_ESCAPE ||
+        c == GDB_STUB_RUN_LENGTH)
+    {
+      reply[reply_len++] = GDB_STUB_ESCAPE;
+      reply[reply_len++] = c ^ 0x20;
+    }
+    else
+    {
+      reply[reply_len++] = c;
+    }
+  }
+  gdb_reply_data(reply, reply_len);
+}
+
+static void gdb_write_mem_binary()
+{
+  static u8 data[GDB_BFR_MAX];
+  u32 addr, len;
+
+  u32 i = gdb_parse_addr_len(&addr, &len, ':');
+  DEBUG_LOG(GDB_STUB, "gdb: write binary memory: %08x bytes to %08x", len, addr);
+
+  if (len > sizeof data)
+    return gdb_reply("E01");
+
+  u32 data_len = 0;
+  while (i < cmd_len && data_len < len)
+  {
+    u8 c = cmd_bfr[i++];
+    if (c == GDB_STUB_ESCAPE && i < cmd_len)
+      c = cmd_bfr[i++] ^ 0x20;
+    data[data_len++] = c;
+  }
+
+  if (data_len != len)
+    return gdb_reply("E01");
+  if (!gdb_is_valid_range(addr, len))
+    return gdb_reply("E00");
+  Memory::CopyToEmu(addr, data, len);
   gdb_reply("OK");
 }
 
@@ -718,7 +879,13 @@ static void gdb_remove_bp()
   gdb_reply("OK");
 }
 
-void gdb_handle_exception()
+static void gdb_set_in_exception(bool value)
+{
+  std::lock_guard lk(socket_mutex);
+  in_exception = value;
+}
+
+static void gdb_handle_commands()
 {
   while (gdb_active())
   {
@@ -763,6 +930,14 @@ void gdb_handle_exception()
       PowerPC::ppcState.iCache.Reset();
       Host_UpdateDisasmDialog();
       break;
+    case 'x':
+      gdb_read_mem_binary();
+      break;
+    case 'X':
+      gdb_write_mem_binary();
+      PowerPC::ppcState.iCache.Reset();
+      Host_UpdateDisasmDialog();
+      break;
     case 's':
       gdb_step();
       return;
@@ -783,6 +958,13 @@ void gdb_handle_exception()
   }
 }
 
+void gdb_handle_exception()
+{
+  gdb_set_in_exception(true);
+  gdb_handle_commands();
+  gdb_set_in_exception(false);
+}
+
 #ifdef _WIN32
 WSADATA InitData;
 #endif
@@ -858,6 +1040,14 @@ static void gdb_init_generic(int domain, const sockaddr* server_addr, socklen_t
 
   close(tmpsock);
   tmpsock = -1;
+
+  recv_pos = 0;
+  recv_len = 0;
+  if (sock >= 0)
+  {
+    interrupt_thread_shutdown.Clear();
+    interrupt_thread = std::thread(gdb_interrupt_thread, sock);
+  }
 }
 
 void gdb_deinit()
@@ -873,6 +1063,10 @@ void gdb_deinit()
     sock = -1;
   }
 
+  interrupt_thread_shutdown.Set();
+  if (interrupt_thread.joinable())
+    interrupt_thread.join();
+
 #ifdef _WIN32
   WSACleanup();
 #endif
@@ -17,6 +17,12 @@ public:
   void Shutdown() override;
   void SingleStep() override;
   int SingleStepInner();
+  // Runs instructions up to the end of the current block (a branch or an exception) and returns
+  // the number of cycles they took. The JITs use this to run cold code without compiling it.
+  int RunBlock();
+  // The last instruction that ran and its address
+  u32 GetLastAddress() const;
+  UGeckoInstruction GetLastInstruction() const { return m_prev_inst; }
 
   void Run() override;
   void ClearCache() override;
@@ -17,6 +17,7 @@
 #endif
 
 #include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
 #include "Common/File.h"
 #include "Common/GekkoDisassembler.h"
 #include "Common/Logging/Log.h"
@@ -25,6 +26,7 @@
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
 #include "Common/x64ABI.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/HLE/HLE.h"
@@ -233,11 +235,25 @@ bool Jit64::HandleFault(uintptr_t access_address, SContext* ctx)
 
   const auto logical_base_ptr = reinterpret_cast<uintptr_t>(Memory::logical_base);
   if (access_address >= logical_base_ptr && access_address < logical_base_ptr + 0x100010000)
-    return BackPatch(static_cast<u32>(access_address - logical_base_ptr), ctx);
+  {
+    const u32 em_address = static_cast<u32>(access_address - logical_base_ptr);
+    if (MapPageTablePage(em_address, ctx))
+      return true;
+    return BackPatch(em_address, ctx);
+  }
 
   return false;
 }
 
+bool Jit64::MapPageTablePage(u32 em_address, SContext* ctx)
+{
+  const auto it = m_back_patch_info.find(reinterpret_cast<u8*>(ctx->CTX_PC));
+  if (it == m_back_patch_info.end())
+    return false;
+
+  return PowerPC::MapPageTablePageForFastmem(em_address, !it->second.read);
+}
+
 bool Jit64::BackPatch(u32 emAddress, SContext* ctx)
 {
   u8* codePtr = reinterpret_cast<u8*>(ctx->CTX_PC);
@@ -325,6 +341,7 @@ bool Jit64::BackPatch(u32 emAddress, SContext* ctx)
 
   ctx->CTX_PC = reinterpret_cast<u64>(trampoline);
 
+  ++counters.backpatched_faults;
   return true;
 }
 
@@ -346,7 +363,8 @@ void Jit64::Init()
   const size_t trampolines_size = jo.memcheck ? TRAMPOLINE_CODE_SIZE_MMU : TRAMPOLINE_CODE_SIZE;
   const size_t farcode_size = jo.memcheck ? FARCODE_SIZE_MMU : FARCODE_SIZE;
   const size_t constpool_size = m_const_pool.CONST_POOL_SIZE;
-  AllocCodeSpace(CODE_SIZE + routines_size + trampolines_size + farcode_size + constpool_size);
+  AllocCodeSpace(CODE_SIZE + routines_size + trampolines_size + farcode_size + constpool_size,
+                 Config::Get(Config::MAIN_LARGE_PAGES));
   AddChildCodeSpace(&asm_routines, routines_size);
   AddChildCodeSpace(&trampolines, trampolines_size);
   AddChildCodeSpace(&m_far_code, farcode_size);
@@ -371,6 +389,11 @@ void Jit64::Init()
   m_far_code.Init();
   Clear();
 
+  m_code_segment = 0;
+  m_near_segment_size = region_size / CODE_SEGMENT_COUNT;
+  m_far_code_start = m_far_code.GetWritableCodePtr();
+  m_far_segment_size = farcode_size / CODE_SEGMENT_COUNT;
+
   code_block.m_stats = &js.st;
   code_block.m_gpa = &js.gpa;
   code_block.m_fpa = &js.fpa;
@@ -386,6 +409,34 @@ void Jit64::ClearCache()
   ClearCodeSpace();
   Clear();
   UpdateMemoryOptions();
+  m_code_segment = 0;
+}
+
+bool Jit64::IsCodeSegmentAlmostFull() const
+{
+  // The same margin as CodeBlock::IsAlmostFull, which should be bigger than the biggest block
+  constexpr size_t MARGIN = 0x10000;
+  const u8* near_end = region + (m_code_segment + 1) * m_near_segment_size;
+  const u8* far_end = m_far_code_start + (m_code_segment + 1) * m_far_segment_size;
+  return GetCodePtr() + MARGIN > near_end || m_far_code.GetCodePtr() + MARGIN > far_end;
+}
+
+void Jit64::AdvanceCodeSegment()
+{
+  m_code_segment = (m_code_segment + 1) % CODE_SEGMENT_COUNT;
+  u8* const near_start = region + m_code_segment * m_near_segment_size;
+  u8* const far_start = m_far_code_start + m_code_segment * m_far_segment_size;
+
+  // Blocks linking to the evicted ones are unlinked and go through the dispatcher again. Nothing
+  // else points into the segment: the dispatcher has reset the stack, so no BLR return addresses
+  // into it are left, and the trampolines of its blocks are only reachable from their code.
+  blocks.EraseHostCodeRange(near_start, near_start + m_near_segment_size);
+  ClearBackPatchInfo(near_start, near_start + m_near_segment_size);
+  ClearBackPatchInfo(far_start, far_start + m_far_segment_size);
+
+  SetCodePtr(near_start);
+  m_far_code.SetCodePtr(far_start);
+  ++counters.code_segment_evictions;
 }
 
 void Jit64::Shutdown()
@@ -402,6 +453,8 @@ void Jit64::Shutdown()
 
 void Jit64::FallBackToInterpreter(UGeckoInstruction inst)
 {
+  js.op->opinfo->fallbackCount++;
+
   gpr.Flush();
   fpr.Flush();
   if (js.op->opinfo->flags & FL_ENDBLOCK)
@@ -731,17 +784,20 @@ void Jit64::Jit(u32 em_address)
 #endif
   }
 
-  if (IsAlmostFull() || m_far_code.IsAlmostFull() || trampolines.IsAlmostFull() ||
-      SConfig::GetInstance().bJITNoBlockCache)
+  // The trampolines are shared by all segments, so running out of them still needs a full clear
+  if (trampolines.IsAlmostFull() || SConfig::GetInstance().bJITNoBlockCache)
   {
     if (!SConfig::GetInstance().bJITNoBlockCache)
     {
-      const auto reason =
-          IsAlmostFull() ? "main" : m_far_code.IsAlmostFull() ? "far" : "trampoline";
-      WARN_LOG(POWERPC, "flushing %s code cache, please report if this happens a lot", reason);
+      WARN_LOG(POWERPC, "flushing trampoline code cache, please report if this happens a lot");
+      ++counters.full_cache_clears;
     }
     ClearCache();
   }
+  else if (IsCodeSegmentAlmostFull())
+  {
+    AdvanceCodeSegment();
+  }
 
   std::size_t block_size = m_code_buffer.size();
 
@@ -765,6 +821,7 @@ void Jit64::Jit(u32 em_address)
         analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_CROR_MERGE);
         analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_CARRY_MERGE);
         analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_FOLLOW);
+        analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_TAKEN_BRANCH_FOLLOW);
       }
       Trace();
     }
@@ -1126,6 +1183,7 @@ void Jit64::EnableOptimization()
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_CROR_MERGE);
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_CARRY_MERGE);
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_FOLLOW);
+  analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_TAKEN_BRANCH_FOLLOW);
 }
 
 void Jit64::IntializeSpeculativeConstants()
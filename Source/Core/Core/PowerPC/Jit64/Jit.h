@@ -48,6 +48,8 @@ public:
 
   bool HandleFault(uintptr_t access_address, SContext* ctx) override;
   bool HandleStackFault() override;
+  // Maps the page behind a faulting logical fastmem access if the page table allows it
+  bool MapPageTablePage(u32 em_address, SContext* ctx);
   bool BackPatch(u32 emAddress, SContext* ctx);
 
   void EnableOptimization();
@@ -112,6 +114,11 @@ public:
   // is set or not.
   Gen::FixupBranch JumpIfCRFieldBit(int field, int bit, bool jump_if_set = true);
   void SetFPRFIfNeeded(Gen::X64Reg xmm);
+  // Rounds a paired single result to single precision and sets FPRF. If the next instruction is a
+  // psq_st(u) of the result, it's merged in so that the result only gets converted once.
+  void FinalizePairedSingle(Gen::X64Reg xmm);
+  // Stores XMM0, already converted to single precision, the way a psq_st(u)(x) would
+  void WritePairedStore(UGeckoInstruction inst);
 
   void HandleNaNs(UGeckoInstruction inst, Gen::X64Reg xmm_out, Gen::X64Reg xmm_in,
                   Gen::X64Reg clobber = Gen::XMM0);
@@ -243,6 +250,9 @@ private:
   void AllocStack();
   void FreeStack();
 
+  bool IsCodeSegmentAlmostFull() const;
+  void AdvanceCodeSegment();
+
   JitBlockCache blocks{*this};
   TrampolineCache trampolines{*this};
 
@@ -254,6 +264,15 @@ private:
   bool m_enable_blr_optimization;
   bool m_cleanup_after_stackfault;
   u8* m_stack;
+
+  // The near and far code space are split into segments which are filled in turn. Once the last
+  // one is full, the blocks in the oldest one are thrown away and its space is reused, so running
+  // out of code space doesn't make every block recompile at once.
+  static constexpr size_t CODE_SEGMENT_COUNT = 4;
+  size_t m_code_segment = 0;
+  size_t m_near_segment_size = 0;
+  u8* m_far_code_start = nullptr;
+  size_t m_far_segment_size = 0;
 };
 
 void LogGeneratedX86(size_t size, const PPCAnalyst::CodeBuffer& code_buffer, const u8* normalEntry,
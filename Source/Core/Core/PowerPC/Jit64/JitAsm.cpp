@@ -190,7 +190,9 @@ void Jit64AsmRoutineManager::Generate()
   ABI_CallFunction(JitTrampoline);
   ABI_PopRegistersAndAdjustStack({}, 0);
 
-  JMP(dispatcher_no_check, true);
+  // The block may have been interpreted rather than compiled, which uses up downcount
+  CMP(32, PPCSTATE(downcount), Imm8(0));
+  JMP(dispatcher, true);
 
   SetJumpTarget(bail);
   do_timing = GetCodePtr();
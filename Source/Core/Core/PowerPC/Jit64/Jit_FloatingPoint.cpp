@@ -205,9 +205,16 @@ void Jit64::fp_arith(UGeckoInstruction inst)
     }
 
     HandleNaNs(inst, Rd, dest);
-    if (single)
-      ForceSinglePrecision(Rd, Rd, packed, true);
-    SetFPRFIfNeeded(Rd);
+    if (inst.OPCD == 4)
+    {
+      FinalizePairedSingle(Rd);
+    }
+    else
+    {
+      if (single)
+        ForceSinglePrecision(Rd, Rd, packed, true);
+      SetFPRFIfNeeded(Rd);
+    }
   };
 
   switch (inst.SUBOP5)
@@ -265,6 +272,8 @@ void Jit64::fmaddXX(UGeckoInstruction inst)
   RCX64Reg Rd = fpr.Bind(d, single ? RCMode::Write : RCMode::ReadWrite);
   RegCache::Realize(Ra, Rb, Rc, Rd);
 
+  // Where the multiplier ends up once the right half has been picked and it has been rounded
+  OpArg Rc_input = R(XMM1);
   switch (inst.SUBOP5)
   {
   case 14:
@@ -278,13 +287,16 @@ void Jit64::fmaddXX(UGeckoInstruction inst)
       Force25BitPrecision(XMM1, R(XMM1), XMM0);
     break;
   default:
-    bool special = inst.SUBOP5 == 30 && (!cpu_info.bFMA || Core::WantsDeterminism());
+    bool special = inst.SUBOP5 == 30 && !use_fma;
     X64Reg tmp1 = special ? XMM0 : XMM1;
     X64Reg tmp2 = special ? XMM1 : XMM0;
+    Rc_input = R(tmp1);
     if (single && round_input)
       Force25BitPrecision(tmp1, Rc, tmp2);
-    else
+    else if (use_fma)
       MOVAPD(tmp1, Rc);
+    else
+      Rc_input = Rc;  // Without FMA, the multiply can read it from where it is
     break;
   }
 
@@ -328,23 +340,22 @@ void Jit64::fmaddXX(UGeckoInstruction inst)
   {
     // We implement nmsub a little differently ((b - a*c) instead of -(a*c - b)), so handle it
     // separately.
-    MOVAPD(XMM1, Rb);
     if (packed)
     {
-      MULPD(XMM0, Ra);
-      SUBPD(XMM1, R(XMM0));
+      avx_op(&XEmitter::VMULPD, &XEmitter::MULPD, XMM0, Rc_input, Ra, true, true);
+      avx_op(&XEmitter::VSUBPD, &XEmitter::SUBPD, XMM1, Rb, R(XMM0));
     }
     else
     {
-      MULSD(XMM0, Ra);
-      SUBSD(XMM1, R(XMM0));
+      avx_op(&XEmitter::VMULSD, &XEmitter::MULSD, XMM0, Rc_input, Ra, true, true);
+      avx_op(&XEmitter::VSUBSD, &XEmitter::SUBSD, XMM1, Rb, R(XMM0));
     }
   }
   else
   {
     if (packed)
     {
-      MULPD(XMM1, Ra);
+      avx_op(&XEmitter::VMULPD, &XEmitter::MULPD, XMM1, Rc_input, Ra, true, true);
       if (inst.SUBOP5 == 28)  // msub
         SUBPD(XMM1, Rb);
       else  //(n)madd(s[01])
@@ -352,7 +363,7 @@ void Jit64::fmaddXX(UGeckoInstruction inst)
     }
     else
     {
-      MULSD(XMM1, Ra);
+      avx_op(&XEmitter::VMULSD, &XEmitter::MULSD, XMM1, Rc_input, Ra, true, true);
       if (inst.SUBOP5 == 28)
         SUBSD(XMM1, Rb);
       else
@@ -362,6 +373,13 @@ void Jit64::fmaddXX(UGeckoInstruction inst)
       XORPD(XMM1, MConst(packed ? psSignBits2 : psSignBits));
   }
 
+  if (inst.OPCD == 4)
+  {
+    HandleNaNs(inst, Rd, XMM1);
+    FinalizePairedSingle(Rd);
+    return;
+  }
+
   if (single)
   {
     HandleNaNs(inst, Rd, XMM1);
@@ -26,15 +26,33 @@ void Jit64::psq_stXX(UGeckoInstruction inst)
   // For performance, the AsmCommon routines assume address translation is on.
   FALLBACK_IF(!MSR.DR);
 
+  bool indexed = inst.OPCD == 4;
+  int s = inst.FS;
+  int w = indexed ? inst.Wx : inst.W;
+  FALLBACK_IF(!inst.RA);
+
+  {
+    RCOpArg Rs = fpr.Use(s, RCMode::Read);
+    RegCache::Realize(Rs);
+
+    if (w)
+      CVTSD2SS(XMM0, Rs);  // one
+    else
+      CVTPD2PS(XMM0, Rs);  // pair
+  }
+
+  WritePairedStore(inst);
+}
+
+void Jit64::WritePairedStore(UGeckoInstruction inst)
+{
   s32 offset = inst.SIMM_12;
   bool indexed = inst.OPCD == 4;
   bool update = (inst.OPCD == 61 && offset) || (inst.OPCD == 4 && !!(inst.SUBOP6 & 32));
   int a = inst.RA;
   int b = indexed ? inst.RB : a;
-  int s = inst.FS;
   int i = indexed ? inst.Ix : inst.I;
   int w = indexed ? inst.Wx : inst.W;
-  FALLBACK_IF(!a);
 
   auto it = js.constantGqr.find(i);
   bool gqrIsConstant = it != js.constantGqr.end();
@@ -43,8 +61,7 @@ void Jit64::psq_stXX(UGeckoInstruction inst)
   RCX64Reg scratch_guard = gpr.Scratch(RSCRATCH_EXTRA);
   RCOpArg Ra = update ? gpr.Bind(a, RCMode::ReadWrite) : gpr.Use(a, RCMode::Read);
   RCOpArg Rb = indexed ? gpr.Use(b, RCMode::Read) : RCOpArg::Imm32((u32)offset);
-  RCOpArg Rs = fpr.Use(s, RCMode::Read);
-  RegCache::Realize(scratch_guard, Ra, Rb, Rs);
+  RegCache::Realize(scratch_guard, Ra, Rb);
 
   MOV_sum(32, RSCRATCH_EXTRA, Ra, Rb);
 
@@ -52,11 +69,6 @@ void Jit64::psq_stXX(UGeckoInstruction inst)
   if (update && !jo.memcheck)
     MOV(32, Ra, R(RSCRATCH_EXTRA));
 
-  if (w)
-    CVTSD2SS(XMM0, Rs);  // one
-  else
-    CVTPD2PS(XMM0, Rs);  // pair
-
   if (gqrIsConstant)
   {
     int type = gqrValue & 0x7;
@@ -109,6 +121,37 @@ void Jit64::psq_stXX(UGeckoInstruction inst)
   }
 }
 
+void Jit64::FinalizePairedSingle(X64Reg xmm)
+{
+  // Transforms usually end in a chain of ps_madd that is stored straight away. Rounding the result
+  // leaves the singles in XMM0, which is exactly what the store wants.
+  const UGeckoInstruction next = js.op[1].inst;
+  const bool merge_store =
+      jo.accurateSinglePrecision && !jo.memcheck && MSR.DR && CanMergeNextInstructions(1) &&
+      (next.OPCD == 60 || next.OPCD == 61) && !next.W && next.FS == js.op->inst.FD && next.RA &&
+      !(SConfig::GetInstance().bFPRF && js.op->wantsFPRF) &&
+      js.fifoWriteAddresses.find(js.op[1].address) == js.fifoWriteAddresses.end();
+
+  if (!merge_store)
+  {
+    ForceSinglePrecision(xmm, R(xmm));
+    SetFPRFIfNeeded(xmm);
+    return;
+  }
+
+  CVTPD2PS(XMM0, R(xmm));
+  CVTPS2PD(xmm, R(XMM0));
+
+  js.downcountAmount += js.op[1].opinfo->numCycles;
+  js.skipInstructions = 1;
+
+  // Anything that goes looking for the store's PC should find it
+  const u32 compiler_pc = js.compilerPC;
+  js.compilerPC = js.op[1].address;
+  WritePairedStore(next);
+  js.compilerPC = compiler_pc;
+}
+
 void Jit64::psq_lXX(UGeckoInstruction inst)
 {
   INSTRUCTION_START
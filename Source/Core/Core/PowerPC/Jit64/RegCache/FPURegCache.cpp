@@ -42,6 +42,12 @@ BitSet32 FPURegCache::GetRegUtilization() const
   return m_jit.js.op->gprInReg;
 }
 
+BitSet32 FPURegCache::GetDiscardableRegs() const
+{
+  // A scalar double only writes ps0, so overwriting an FPR doesn't always kill it
+  return BitSet32{};
+}
+
 BitSet32 FPURegCache::CountRegsIn(preg_t preg, u32 lookahead) const
 {
   BitSet32 regs_used;
@@ -59,6 +59,11 @@ BitSet32 GPRRegCache::GetRegUtilization() const
   return m_jit.js.op->gprInReg;
 }
 
+BitSet32 GPRRegCache::GetDiscardableRegs() const
+{
+  return m_jit.js.op->gprDiscardable;
+}
+
 BitSet32 GPRRegCache::CountRegsIn(preg_t preg, u32 lookahead) const
 {
   BitSet32 regs_used;
@@ -581,7 +581,10 @@ X64Reg RegCache::GetFreeXReg()
 
   if (best_xreg != INVALID_REG)
   {
-    StoreFromRegister(best_preg);
+    if (GetDiscardableRegs()[best_preg])
+      DiscardRegContentsIfCached(best_preg);
+    else
+      StoreFromRegister(best_preg);
     return best_xreg;
   }
 
@@ -608,6 +611,10 @@ float RegCache::ScoreRegister(X64Reg xreg) const
   preg_t preg = m_xregs[xreg].Contents();
   float score = 0;
 
+  // Nothing is going to read the value again, so it can simply be dropped
+  if (GetDiscardableRegs()[preg])
+    return -1;
+
   // If it's not dirty, we don't need a store to write it back to the register file, so
   // bias a bit against dirty registers. Testing shows that a bias of 2 seems roughly
   // right: 3 causes too many extra clobbers, while 1 saves very few clobbers relative
@@ -5,6 +5,7 @@
 #include "Core/PowerPC/Jit64Common/EmuCodeBlock.h"
 
 #include <functional>
+#include <iterator>
 #include <limits>
 
 #include "Common/Assert.h"
@@ -315,6 +316,97 @@ void EmuCodeBlock::MMIOLoadToReg(MMIO::Mapping* mmio, Gen::X64Reg reg_value,
   }
 }
 
+// Visitor that generates code to write a MMIO value.
+template <typename T>
+class MMIOWriteCodeGenerator : public MMIO::WriteHandlingMethodVisitor<T>
+{
+public:
+  MMIOWriteCodeGenerator(Gen::X64CodeBlock* code, BitSet32 registers_in_use,
+                         const Gen::OpArg& value, u32 address)
+      : m_code(code), m_registers_in_use(registers_in_use), m_value(value), m_address(address)
+  {
+  }
+
+  void VisitNop() override
+  {
+    // Do nothing
+  }
+  void VisitDirect(T* addr, u32 mask) override { WriteRegToAddrMask(8 * sizeof(T), addr, mask); }
+  void VisitComplex(const std::function<void(u32, T)>* lambda) override
+  {
+    CallLambda(8 * sizeof(T), lambda);
+  }
+
+private:
+  void WriteRegToAddrMask(int sbits, void* ptr, u32 mask)
+  {
+    // RSCRATCH can hold the value, so the pointer goes in RSCRATCH2
+    m_code->MOV(64, R(RSCRATCH2), ImmPtr(ptr));
+    if (m_value.IsImm())
+    {
+      const u32 value = m_value.AsImm32().Imm32() & mask;
+      m_code->MOV(sbits, MatR(RSCRATCH2), FixImmediate(sbits, Imm32(value)));
+      return;
+    }
+
+    const u32 all_ones = (1ULL << sbits) - 1;
+    if (m_value.IsSimpleReg() && (all_ones & mask) == all_ones)
+    {
+      m_code->MOV(sbits, MatR(RSCRATCH2), m_value);
+      return;
+    }
+
+    if (!m_value.IsSimpleReg(RSCRATCH))
+      m_code->MOV(sbits, R(RSCRATCH), m_value);
+    if ((all_ones & mask) != all_ones)
+      m_code->AND(32, R(RSCRATCH), Imm32(mask));
+    m_code->MOV(sbits, MatR(RSCRATCH2), R(RSCRATCH));
+  }
+
+  void CallLambda(int sbits, const std::function<void(u32, T)>* lambda)
+  {
+    if (m_value.IsImm())
+      m_code->MOV(32, R(RSCRATCH), Imm32(m_value.AsImm32().Imm32() & ((1ULL << sbits) - 1)));
+    else
+      m_code->MOVZX(32, sbits, RSCRATCH, m_value);
+
+    m_code->ABI_PushRegistersAndAdjustStack(m_registers_in_use, 0);
+    m_code->ABI_CallLambdaCR(lambda, m_address, RSCRATCH);
+    m_code->ABI_PopRegistersAndAdjustStack(m_registers_in_use, 0);
+  }
+
+  Gen::X64CodeBlock* m_code;
+  BitSet32 m_registers_in_use;
+  Gen::OpArg m_value;
+  u32 m_address;
+};
+
+void EmuCodeBlock::MMIOWriteRegToAddr(MMIO::Mapping* mmio, const Gen::OpArg& value,
+                                      BitSet32 registers_in_use, u32 address, int access_size)
+{
+  switch (access_size)
+  {
+  case 8:
+  {
+    MMIOWriteCodeGenerator<u8> gen(this, registers_in_use, value, address);
+    mmio->GetHandlerForWrite<u8>(address).Visit(gen);
+    break;
+  }
+  case 16:
+  {
+    MMIOWriteCodeGenerator<u16> gen(this, registers_in_use, value, address);
+    mmio->GetHandlerForWrite<u16>(address).Visit(gen);
+    break;
+  }
+  case 32:
+  {
+    MMIOWriteCodeGenerator<u32> gen(this, registers_in_use, value, address);
+    mmio->GetHandlerForWrite<u32>(address).Visit(gen);
+    break;
+  }
+  }
+}
+
 void EmuCodeBlock::SafeLoadToReg(X64Reg reg_value, const Gen::OpArg& opAddress, int accessSize,
                                  s32 offset, BitSet32 registersInUse, bool signExtend, int flags)
 {
@@ -646,6 +738,13 @@ bool EmuCodeBlock::WriteToConstAddress(int accessSize, OpArg arg, u32 address,
     WriteToConstRamAddress(accessSize, arg, address);
     return false;
   }
+  else if (const u32 mmio_address = PowerPC::IsOptimizableMMIOAccess(address, accessSize);
+           accessSize != 64 && mmio_address)
+  {
+    // Writes to hardware registers don't raise memory exceptions
+    MMIOWriteRegToAddr(Memory::mmio_mapping.get(), arg, registersInUse, mmio_address, accessSize);
+    return false;
+  }
   else
   {
     // Helps external systems know which instruction triggered the write
@@ -1015,3 +1114,14 @@ void EmuCodeBlock::Clear()
   m_back_patch_info.clear();
   m_exception_handler_at_loc.clear();
 }
+
+void EmuCodeBlock::ClearBackPatchInfo(const u8* start, const u8* end)
+{
+  const auto in_range = [start, end](const auto& entry) {
+    return entry.first >= start && entry.first < end;
+  };
+  for (auto it = m_back_patch_info.begin(); it != m_back_patch_info.end();)
+    it = in_range(*it) ? m_back_patch_info.erase(it) : std::next(it);
+  for (auto it = m_exception_handler_at_loc.begin(); it != m_exception_handler_at_loc.end();)
+    it = in_range(*it) ? m_exception_handler_at_loc.erase(it) : std::next(it);
+}
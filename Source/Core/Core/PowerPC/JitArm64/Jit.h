@@ -170,6 +170,7 @@ private:
   {
     u32 length;
     const u8* slowmem_code;
+    bool write;
   };
 
   static void InitializeInstructionTables();
@@ -200,6 +201,8 @@ private:
   // Loadstore routines
   void SafeLoadToReg(u32 dest, s32 addr, s32 offsetReg, u32 flags, s32 offset, bool update);
   void SafeStoreFromReg(s32 dest, u32 value, s32 regOffset, u32 flags, s32 offset);
+  // Computes the effective address of a psq_l(u)(x) or psq_st(u)(x)
+  void ComputePairedAddress(UGeckoInstruction inst, Arm64Gen::ARM64Reg addr_reg);
 
   void DoJit(u32 em_address, JitBlock* b, u32 nextPC);
 
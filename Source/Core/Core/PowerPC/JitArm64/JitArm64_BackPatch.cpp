@@ -166,12 +166,14 @@ void JitArm64::EmitBackpatchRoutine(u32 flags, bool fastmem, bool do_farcode, AR
         m_handler_to_loc[handler] = handler_loc;
         fastmem_area->slowmem_code = handler_loc;
         fastmem_area->length = fastmem_end - fastmem_start;
+        fastmem_area->write = (flags & BackPatchInfo::FLAG_STORE) != 0;
       }
       else
       {
         const u8* handler_loc = handler_loc_iter->second;
         fastmem_area->slowmem_code = handler_loc;
         fastmem_area->length = fastmem_end - fastmem_start;
+        fastmem_area->write = (flags & BackPatchInfo::FLAG_STORE) != 0;
         return;
       }
     }
@@ -314,6 +316,15 @@ bool JitArm64::HandleFastmemFault(uintptr_t access_address, SContext* ctx)
   if ((const u8*)ctx->CTX_PC - fault_location > fastmem_area_length)
     return false;
 
+  // Accesses to pages translated through the page table can keep using fastmem once mapped
+  const uintptr_t logical_base = reinterpret_cast<uintptr_t>(Memory::logical_base);
+  if (access_address >= logical_base && access_address < logical_base + 0x100010000 &&
+      PowerPC::MapPageTablePageForFastmem(static_cast<u32>(access_address - logical_base),
+                                          slow_handler_iter->second.write))
+  {
+    return true;
+  }
+
   ARM64XEmitter emitter((u8*)fault_location);
 
   emitter.BL(slow_handler_iter->second.slowmem_code);
@@ -326,5 +337,6 @@ bool JitArm64::HandleFastmemFault(uintptr_t access_address, SContext* ctx)
 
   emitter.FlushIcache();
   ctx->CTX_PC = reinterpret_cast<std::uintptr_t>(fault_location);
+  ++counters.backpatched_faults;
   return true;
 }
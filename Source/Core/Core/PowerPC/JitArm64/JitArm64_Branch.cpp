@@ -143,6 +143,25 @@ void JitArm64::bcx(UGeckoInstruction inst)
         JumpIfCRFieldBit(inst.BI >> 2, 3 - (inst.BI & 3), !(inst.BO_2 & BO_BRANCH_IF_TRUE));
   }
 
+  if (js.op->branchFollowTaken)
+  {
+    // The block carries on at the branch target, so falling through is the way out
+    gpr.Unlock(WA);
+    FixupBranch taken = B();
+
+    if ((inst.BO & BO_DONT_CHECK_CONDITION) == 0)
+      SetJumpTarget(pConditionDontBranch);
+    if ((inst.BO & BO_DONT_DECREMENT_FLAG) == 0)
+      SetJumpTarget(pCTRDontBranch);
+
+    gpr.Flush(FlushMode::FLUSH_MAINTAIN_STATE);
+    fpr.Flush(FlushMode::FLUSH_MAINTAIN_STATE);
+    WriteExit(js.compilerPC + 4);
+
+    SetJumpTarget(taken);
+    return;
+  }
+
   FixupBranch far_addr = B();
   SwitchToFarCode();
   SetJumpTarget(far_addr);
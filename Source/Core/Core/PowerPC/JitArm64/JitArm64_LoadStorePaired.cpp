@@ -16,6 +16,32 @@
 
 using namespace Arm64Gen;
 
+void JitArm64::ComputePairedAddress(UGeckoInstruction inst, ARM64Reg addr_reg)
+{
+  if (inst.OPCD == 4)
+  {
+    if (inst.RA)
+      ADD(addr_reg, gpr.R(inst.RA), gpr.R(inst.RB));
+    else
+      MOV(addr_reg, gpr.R(inst.RB));
+    return;
+  }
+
+  const s32 offset = inst.SIMM_12;
+  const bool update = inst.OPCD == 57 || inst.OPCD == 61;
+  if (inst.RA || update)  // Always uses the register on update
+  {
+    if (offset >= 0)
+      ADD(addr_reg, gpr.R(inst.RA), offset);
+    else
+      SUB(addr_reg, gpr.R(inst.RA), std::abs(offset));
+  }
+  else
+  {
+    MOVI2R(addr_reg, (u32)offset);
+  }
+}
+
 void JitArm64::psq_l(UGeckoInstruction inst)
 {
   INSTRUCTION_START
@@ -31,8 +57,11 @@ void JitArm64::psq_l(UGeckoInstruction inst)
   // X2 is a temporary
   // Q0 is the return register
   // Q1 is a temporary
-  bool update = inst.OPCD == 57;
-  s32 offset = inst.SIMM_12;
+  const bool indexed = inst.OPCD == 4;
+  const bool update = inst.OPCD == 57 || (indexed && !!(inst.SUBOP6 & 32));
+  const u32 i = indexed ? inst.Ix : inst.I;
+  const u32 w = indexed ? inst.Wx : inst.W;
+  FALLBACK_IF(indexed && update && !inst.RA);
 
   gpr.Lock(W0, W1, W2, W30);
   fpr.Lock(Q0, Q1);
@@ -43,17 +72,7 @@ void JitArm64::psq_l(UGeckoInstruction inst)
   ARM64Reg type_reg = W2;
   ARM64Reg VS;
 
-  if (inst.RA || update)  // Always uses the register on update
-  {
-    if (offset >= 0)
-      ADD(addr_reg, arm_addr, offset);
-    else
-      SUB(addr_reg, arm_addr, std::abs(offset));
-  }
-  else
-  {
-    MOVI2R(addr_reg, (u32)offset);
-  }
+  ComputePairedAddress(inst, addr_reg);
 
   if (update)
   {
@@ -64,7 +83,7 @@ void JitArm64::psq_l(UGeckoInstruction inst)
   if (js.assumeNoPairedQuantize)
   {
     VS = fpr.RW(inst.RS, REG_REG_SINGLE);
-    if (!inst.W)
+    if (!w)
     {
       ADD(EncodeRegTo64(addr_reg), EncodeRegTo64(addr_reg), MEM_REG);
       m_float_emit.LD1(32, 1, EncodeRegToDouble(VS), EncodeRegTo64(addr_reg));
@@ -77,11 +96,11 @@ void JitArm64::psq_l(UGeckoInstruction inst)
   }
   else
   {
-    LDR(INDEX_UNSIGNED, scale_reg, PPC_REG, PPCSTATE_OFF(spr[SPR_GQR0 + inst.I]));
+    LDR(INDEX_UNSIGNED, scale_reg, PPC_REG, PPCSTATE_OFF(spr) + (SPR_GQR0 + i) * 4);
     UBFM(type_reg, scale_reg, 16, 18);   // Type
     UBFM(scale_reg, scale_reg, 24, 29);  // Scale
 
-    MOVP2R(X30, inst.W ? single_load_quantized : paired_load_quantized);
+    MOVP2R(X30, w ? single_load_quantized : paired_load_quantized);
     LDR(X30, X30, ArithOption(EncodeRegTo64(type_reg), true));
     BLR(X30);
 
@@ -89,7 +108,7 @@ void JitArm64::psq_l(UGeckoInstruction inst)
     m_float_emit.ORR(EncodeRegToDouble(VS), D0, D0);
   }
 
-  if (inst.W)
+  if (w)
   {
     m_float_emit.FMOV(S0, 0x70);  // 1.0 as a Single
     m_float_emit.INS(32, VS, 1, Q0, 0);
@@ -113,8 +132,11 @@ void JitArm64::psq_st(UGeckoInstruction inst)
   // X1 is the address
   // Q0 is the store register
 
-  bool update = inst.OPCD == 61;
-  s32 offset = inst.SIMM_12;
+  const bool indexed = inst.OPCD == 4;
+  const bool update = inst.OPCD == 61 || (indexed && !!(inst.SUBOP6 & 32));
+  const u32 i = indexed ? inst.Ix : inst.I;
+  const u32 w = indexed ? inst.Wx : inst.W;
+  FALLBACK_IF(indexed && update && !inst.RA);
 
   gpr.Lock(W0, W1, W2, W30);
   fpr.Lock(Q0, Q1);
@@ -135,17 +157,7 @@ void JitArm64::psq_st(UGeckoInstruction inst)
   gprs_in_use &= BitSet32(~7);
   fprs_in_use &= BitSet32(~3);
 
-  if (inst.RA || update)  // Always uses the register on update
-  {
-    if (offset >= 0)
-      ADD(addr_reg, gpr.R(inst.RA), offset);
-    else
-      SUB(addr_reg, gpr.R(inst.RA), std::abs(offset));
-  }
-  else
-  {
-    MOVI2R(addr_reg, (u32)offset);
-  }
+  ComputePairedAddress(inst, addr_reg);
 
   if (update)
   {
@@ -158,9 +170,9 @@ void JitArm64::psq_st(UGeckoInstruction inst)
     u32 flags = BackPatchInfo::FLAG_STORE;
 
     if (single)
-      flags |= (inst.W ? BackPatchInfo::FLAG_SIZE_F32I : BackPatchInfo::FLAG_SIZE_F32X2I);
+      flags |= (w ? BackPatchInfo::FLAG_SIZE_F32I : BackPatchInfo::FLAG_SIZE_F32X2I);
     else
-      flags |= (inst.W ? BackPatchInfo::FLAG_SIZE_F32 : BackPatchInfo::FLAG_SIZE_F32X2);
+      flags |= (w ? BackPatchInfo::FLAG_SIZE_F32 : BackPatchInfo::FLAG_SIZE_F32X2);
 
     EmitBackpatchRoutine(flags, jo.fastmem, jo.fastmem, VS, EncodeRegTo64(addr_reg), gprs_in_use,
                          fprs_in_use);
@@ -173,13 +185,13 @@ void JitArm64::psq_st(UGeckoInstruction inst)
     }
     else
     {
-      if (inst.W)
+      if (w)
         m_float_emit.FCVT(32, 64, D0, VS);
       else
         m_float_emit.FCVTN(32, D0, VS);
     }
 
-    LDR(INDEX_UNSIGNED, scale_reg, PPC_REG, PPCSTATE_OFF(spr[SPR_GQR0 + inst.I]));
+    LDR(INDEX_UNSIGNED, scale_reg, PPC_REG, PPCSTATE_OFF(spr) + (SPR_GQR0 + i) * 4);
     UBFM(type_reg, scale_reg, 0, 2);    // Type
     UBFM(scale_reg, scale_reg, 8, 13);  // Scale
 
@@ -192,7 +204,7 @@ void JitArm64::psq_st(UGeckoInstruction inst)
     SwitchToFarCode();
     SetJumpTarget(fail);
     // Slow
-    MOVP2R(X30, &paired_store_quantized[16 + inst.W * 8]);
+    MOVP2R(X30, &paired_store_quantized[16 + w * 8]);
     LDR(EncodeRegTo64(type_reg), X30, ArithOption(EncodeRegTo64(type_reg), true));
 
     ABI_PushRegisters(gprs_in_use);
@@ -205,7 +217,7 @@ void JitArm64::psq_st(UGeckoInstruction inst)
     SetJumpTarget(pass);
 
     // Fast
-    MOVP2R(X30, &paired_store_quantized[inst.W * 8]);
+    MOVP2R(X30, &paired_store_quantized[w * 8]);
     LDR(EncodeRegTo64(type_reg), X30, ArithOption(EncodeRegTo64(type_reg), true));
     BLR(EncodeRegTo64(type_reg));
 
@@ -148,7 +148,11 @@ void JitArm64::GenerateAsm()
   MOVP2R(X30, reinterpret_cast<void*>(&JitTrampoline));
   BLR(X30);
   LDR(INDEX_UNSIGNED, DISPATCHER_PC, PPC_REG, PPCSTATE_OFF(pc));
-  B(dispatcher_no_check);
+
+  // The block may have been interpreted rather than compiled, which uses up downcount
+  LDR(INDEX_UNSIGNED, ARM64Reg::W0, PPC_REG, PPCSTATE_OFF(downcount));
+  CMP(ARM64Reg::W0, ARM64Reg::WZR);
+  B(dispatcher);
 
   SetJumpTarget(bail);
   do_timing = GetCodePtr();
@@ -5,11 +5,23 @@
 #include "Core/PowerPC/JitCommon/JitBase.h"
 
 #include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/Timer.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/HW/CPU.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/Interpreter/Interpreter.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PowerPC.h"
 
+// Enough to warm the cache up within the first few frames without a visible hitch
+constexpr size_t WARMUP_BLOCKS_PER_MISS = 64;
+
+// How often a branch has to be seen before it's judged, and how many of those may fall through
+constexpr u32 MIN_BRANCH_SAMPLES = 4;
+constexpr u32 MAX_NOT_TAKEN_EIGHTHS = 1;
+
 const u8* JitBase::Dispatch(JitBase& jit)
 {
   return jit.GetBlockCache()->Dispatch();
@@ -17,15 +29,82 @@ const u8* JitBase::Dispatch(JitBase& jit)
 
 void JitTrampoline(JitBase& jit, u32 em_address)
 {
+  ++jit.counters.block_cache_misses;
+
+  // Piggyback on the cache miss to compile a few blocks recorded by an earlier session. One of
+  // them may well be the block that was missing.
+  const u64 warmup_start_us = Common::Timer::GetTimeUs();
+  jit.warmup_cache.CompileSome(jit, WARMUP_BLOCKS_PER_MISS);
+  jit.counters.compile_time_us += Common::Timer::GetTimeUs() - warmup_start_us;
+  if (jit.GetBlockCache()->GetBlockFromStartAddress(em_address, MSR.Hex))
+    return;
+
+  // The dispatcher checks the downcount again on return, in case this ran the block instead
+  if (jit.InterpretColdBlock(em_address))
+    return;
+
+  const u64 start_us = Common::Timer::GetTimeUs();
   jit.Jit(em_address);
+  jit.counters.compile_time_us += Common::Timer::GetTimeUs() - start_us;
+  ++jit.counters.blocks_compiled;
 }
 
-JitBase::JitBase() : m_code_buffer(code_buffer_size)
+JitBase::JitBase()
+    : m_code_buffer(code_buffer_size),
+      m_tier_up_threshold(Config::Get(Config::MAIN_JIT_TIER_UP_THRESHOLD))
 {
+  analyzer.SetTakenBranchHints(&m_taken_branch_hints);
 }
 
 JitBase::~JitBase() = default;
 
+bool JitBase::InterpretColdBlock(u32 em_address)
+{
+  // Breakpoints and stepping are handled by the compiled code
+  if (m_tier_up_threshold == 0 || SConfig::GetInstance().bEnableDebugging)
+    return false;
+
+  const u64 key = em_address | (u64{MSR.Hex & JitBaseBlockCache::JIT_CACHE_MSR_MASK} << 32);
+  const auto iter = m_cold_block_runs.try_emplace(key, 0).first;
+  if (++iter->second > m_tier_up_threshold)
+  {
+    // Forget about it, so that it starts out cold again if it ever gets invalidated
+    m_cold_block_runs.erase(iter);
+    return false;
+  }
+
+  // Everything is in ppcState between blocks, so the interpreter can just pick up from there
+  Interpreter* const interpreter = Interpreter::getInstance();
+  PowerPC::ppcState.downcount -= interpreter->RunBlock();
+  RecordColdBranch(interpreter->GetLastAddress(), interpreter->GetLastInstruction());
+
+  // Compiled blocks check for interrupts after rfi and mtmsr, so do the same here
+  PowerPC::CheckExternalExceptions();
+  return true;
+}
+
+void JitBase::RecordColdBranch(u32 address, UGeckoInstruction inst)
+{
+  // Only forward bcx without LK is worth following, see PPCAnalyzer::Analyze
+  const bool conditional =
+      (inst.BO & BO_DONT_DECREMENT_FLAG) == 0 || (inst.BO & BO_DONT_CHECK_CONDITION) == 0;
+  if (inst.OPCD != 16 || inst.LK || !conditional || inst.AA || SignExt16(inst.BD << 2) <= 0)
+    return;
+
+  BranchCounts& counts = m_branch_counts[address];
+  counts.total++;
+  if (PC != address + 4)
+    counts.taken++;
+
+  if (counts.total < MIN_BRANCH_SAMPLES)
+    return;
+
+  if ((counts.total - counts.taken) * 8 <= counts.total * MAX_NOT_TAKEN_EIGHTHS)
+    m_taken_branch_hints.insert(address);
+  else
+    m_taken_branch_hints.erase(address);
+}
+
 bool JitBase::CanMergeNextInstructions(int count) const
 {
   if (CPU::IsStepping() || js.instructionsLeft < count)
@@ -44,7 +123,11 @@ bool JitBase::CanMergeNextInstructions(int count) const
 
 void JitBase::UpdateMemoryOptions()
 {
+  // Fastmem accesses to watched pages fault and get backpatched to the slow path, which checks
+  // memchecks. The logical view leaves those pages out, and the physical view protects them
+  // where it can.
   bool any_watchpoints = PowerPC::memchecks.HasAny();
-  jo.fastmem = SConfig::GetInstance().bFastmem && jo.fastmem_arena && (MSR.DR || !any_watchpoints);
+  jo.fastmem = SConfig::GetInstance().bFastmem && jo.fastmem_arena &&
+               (MSR.DR || !any_watchpoints || Memory::CanProtectPhysicalMemory());
   jo.memcheck = SConfig::GetInstance().bMMU || any_watchpoints;
 }
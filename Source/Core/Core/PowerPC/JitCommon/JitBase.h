@@ -4,8 +4,10 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <map>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "Common/CommonTypes.h"
@@ -15,6 +17,8 @@
 #include "Core/PowerPC/CPUCoreBase.h"
 #include "Core/PowerPC/JitCommon/JitAsmCommon.h"
 #include "Core/PowerPC/JitCommon/JitCache.h"
+#include "Core/PowerPC/JitCommon/JitWarmupCache.h"
+#include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 
 //#define JIT_LOG_GENERATED_CODE  // Enables logging of generated code
@@ -100,6 +104,24 @@ protected:
 
   bool CanMergeNextInstructions(int count) const;
 
+  // Blocks that haven't been compiled yet, keyed by effective address and MSR bits, with the
+  // number of times they've been interpreted so far
+  std::unordered_map<u64, u32> m_cold_block_runs;
+  // How many times a block is interpreted before it gets compiled. 0 compiles straight away.
+  u32 m_tier_up_threshold = 0;
+
+  struct BranchCounts
+  {
+    u32 taken = 0;
+    u32 total = 0;
+  };
+  // How the forward conditional branches that ended interpreted blocks went, by address
+  std::unordered_map<u32, BranchCounts> m_branch_counts;
+  // The ones that were nearly always taken. The analyzer follows these.
+  std::unordered_set<u32> m_taken_branch_hints;
+
+  void RecordColdBranch(u32 address, UGeckoInstruction inst);
+
   void UpdateMemoryOptions();
 
 public:
@@ -111,6 +133,10 @@ public:
 
   virtual void Jit(u32 em_address) = 0;
 
+  // Runs the block at PC in the interpreter if it hasn't run often enough to be worth compiling.
+  // Returns false if it should be compiled instead.
+  bool InterpretColdBlock(u32 em_address);
+
   virtual const CommonAsmRoutinesBase* GetAsmRoutines() = 0;
 
   virtual bool HandleFault(uintptr_t access_address, SContext* ctx) = 0;
@@ -121,6 +147,25 @@ public:
   // This should probably be removed from public:
   JitOptions jo{};
   JitState js{};
+
+  JitWarmupCache warmup_cache;
+
+  // The counters behind JitInterface::Statistics. They're atomic so that the overlay can read
+  // them from the GPU thread, and are only updated off the fast paths.
+  struct Counters
+  {
+    std::atomic<u64> fast_map_misses{0};
+    std::atomic<u64> block_cache_misses{0};
+    std::atomic<u64> blocks_compiled{0};
+    std::atomic<u64> bytes_emitted{0};
+    std::atomic<u64> compile_time_us{0};
+    std::atomic<u64> icache_invalidations{0};
+    std::atomic<u64> blocks_destroyed{0};
+    std::atomic<u64> full_cache_clears{0};
+    std::atomic<u64> code_segment_evictions{0};
+    std::atomic<u64> backpatched_faults{0};
+  };
+  Counters counters;
 };
 
 void JitTrampoline(JitBase& jit, u32 em_address);
@@ -40,6 +40,8 @@ bool JitBlock::OverlapsPhysicalRange(u32 address, u32 length) const
 
 JitBaseBlockCache::JitBaseBlockCache(JitBase& jit) : m_jit{jit}
 {
+  block_map.assign(BLOCK_MAP_INITIAL_CAPACITY, {0, 0, 0, BLOCK_MAP_EMPTY});
+  page_blocks_index.reset(new u32[CODE_PAGE_COUNT]());
 }
 
 JitBaseBlockCache::~JitBaseBlockCache() = default;
@@ -65,13 +67,23 @@ void JitBaseBlockCache::Clear()
 #endif
   m_jit.js.fifoWriteAddresses.clear();
   m_jit.js.pairedQuantizeAddresses.clear();
-  for (auto& e : block_map)
+  for (JitBlock& block : blocks)
   {
-    DestroyBlock(e.second);
+    if (block.in_use)
+      DestroyBlock(block);
   }
-  block_map.clear();
+  blocks.clear();
+  free_blocks.clear();
   links_to.clear();
-  block_range_map.clear();
+
+  std::fill(block_map.begin(), block_map.end(), BlockMapEntry{0, 0, 0, BLOCK_MAP_EMPTY});
+  block_map_used = 0;
+  block_map_live = 0;
+
+  for (const PageBlocks& entry : page_blocks)
+    page_blocks_index[entry.page] = 0;
+  page_blocks.clear();
+  free_page_blocks.clear();
 
   valid_block.ClearAll();
 
@@ -91,19 +103,38 @@ JitBlock** JitBaseBlockCache::GetFastBlockMap()
 
 void JitBaseBlockCache::RunOnBlocks(std::function<void(const JitBlock&)> f)
 {
-  for (const auto& e : block_map)
-    f(e.second);
+  for (const JitBlock& block : blocks)
+  {
+    if (block.in_use)
+      f(block);
+  }
 }
 
 JitBlock* JitBaseBlockCache::AllocateBlock(u32 em_address)
 {
   u32 physicalAddress = PowerPC::JitCache_TranslateAddress(em_address).address;
-  JitBlock& b = block_map.emplace(physicalAddress, JitBlock())->second;
+
+  u32 index;
+  if (!free_blocks.empty())
+  {
+    index = free_blocks.back();
+    free_blocks.pop_back();
+    blocks[index] = JitBlock();
+  }
+  else
+  {
+    index = static_cast<u32>(blocks.size());
+    blocks.emplace_back();
+  }
+
+  JitBlock& b = blocks[index];
   b.effectiveAddress = em_address;
   b.physicalAddress = physicalAddress;
   b.msrBits = MSR.Hex & JIT_CACHE_MSR_MASK;
-  b.linkData.clear();
   b.fast_block_map_index = 0;
+  b.slab_index = index;
+  b.in_use = true;
+  InsertIntoBlockMap(b);
   return &b;
 }
 
@@ -115,13 +146,11 @@ void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
   block.fast_block_map_index = index;
 
   block.physical_addresses = physical_addresses;
+  m_jit.counters.bytes_emitted += block.codeSize;
 
-  u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
   for (u32 addr : physical_addresses)
-  {
     valid_block.Set(addr / 32);
-    block_range_map[addr & range_mask].insert(&block);
-  }
+  AddBlockToPages(block);
 
   if (block_link)
   {
@@ -160,15 +189,20 @@ JitBlock* JitBaseBlockCache::GetBlockFromStartAddress(u32 addr, u32 msr)
     translated_addr = translated.address;
   }
 
-  auto iter = block_map.equal_range(translated_addr);
-  for (; iter.first != iter.second; iter.first++)
+  // The table is never more than half full, so there's always an empty entry to stop at
+  const u32 msr_bits = msr & JIT_CACHE_MSR_MASK;
+  const size_t mask = block_map.size() - 1;
+  for (size_t i = HashBlockMapKey(translated_addr, addr, msr_bits) & mask;; i = (i + 1) & mask)
   {
-    JitBlock& b = iter.first->second;
-    if (b.effectiveAddress == addr && b.msrBits == (msr & JIT_CACHE_MSR_MASK))
-      return &b;
+    const BlockMapEntry& entry = block_map[i];
+    if (entry.slab_index == BLOCK_MAP_EMPTY)
+      return nullptr;
+    if (entry.slab_index != BLOCK_MAP_DELETED && entry.physical_address == translated_addr &&
+        entry.effective_address == addr && entry.msr_bits == msr_bits)
+    {
+      return &blocks[entry.slab_index];
+    }
   }
-
-  return nullptr;
 }
 
 const u8* JitBaseBlockCache::Dispatch()
@@ -176,7 +210,10 @@ const u8* JitBaseBlockCache::Dispatch()
   JitBlock* block = fast_block_map[FastLookupIndexForAddress(PC)];
 
   if (!block || block->effectiveAddress != PC || block->msrBits != (MSR.Hex & JIT_CACHE_MSR_MASK))
+  {
+    ++m_jit.counters.fast_map_misses;
     block = MoveBlockIntoFastCache(PC, MSR.Hex & JIT_CACHE_MSR_MASK);
+  }
 
   if (!block)
     return nullptr;
@@ -186,6 +223,8 @@ const u8* JitBaseBlockCache::Dispatch()
 
 void JitBaseBlockCache::InvalidateICache(u32 address, u32 length, bool forced)
 {
+  ++m_jit.counters.icache_invalidations;
+
   auto translated = PowerPC::JitCache_TranslateAddress(address);
   if (!translated.valid)
     return;
@@ -221,52 +260,228 @@ void JitBaseBlockCache::InvalidateICache(u32 address, u32 length, bool forced)
   }
 }
 
+void JitBaseBlockCache::InvalidateExternalWrite(u32 address, u32 length)
+{
+  auto translated = PowerPC::JitCache_TranslateAddress(address);
+  if (!translated.valid || length == 0)
+    return;
+
+  // Done in 64 bits so that a write at the very top of the address space can't wrap around
+  const u64 start = translated.address;
+  const u64 end = std::min<u64>(start + length, u64{1} << 32);
+
+  u64 line = start & ~u64{31};
+  while (line < end)
+  {
+    const u64 page = line / CODE_PAGE_SIZE;
+    if (page_blocks_index[page] == 0)
+    {
+      line = (page + 1) * CODE_PAGE_SIZE;
+      continue;
+    }
+
+    if (!valid_block.Test(static_cast<u32>(line / 32)))
+    {
+      line += 32;
+      continue;
+    }
+
+    // Erase each run of cache lines holding code in one go
+    u64 run_end = line + 32;
+    while (run_end < end && valid_block.Test(static_cast<u32>(run_end / 32)))
+      run_end += 32;
+
+    const u32 erase_start = static_cast<u32>(std::max(line, start));
+    const u32 erase_length = static_cast<u32>(std::min(run_end, end) - erase_start);
+    ErasePhysicalRange(erase_start, erase_length);
+
+    // The code was modified, so drop any exception checks recorded for it
+    const u32 em_start = address + static_cast<u32>(erase_start - start);
+    for (u32 i = 0; i < erase_length; i += 4)
+    {
+      m_jit.js.fifoWriteAddresses.erase((em_start & ~3u) + i);
+      m_jit.js.pairedQuantizeAddresses.erase((em_start & ~3u) + i);
+    }
+
+    line = run_end;
+  }
+}
+
 void JitBaseBlockCache::ErasePhysicalRange(u32 address, u32 length)
 {
-  // Iterate over all macro blocks which overlap the given range.
-  u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
-  auto start = block_range_map.lower_bound(address & range_mask);
-  auto end = block_range_map.lower_bound(address + length);
-  while (start != end)
+  if (length == 0)
+    return;
+
+  // Iterate over all pages which overlap the given range.
+  const u32 first_page = address / CODE_PAGE_SIZE;
+  const u32 last_page = static_cast<u32>((u64{address} + length - 1) / CODE_PAGE_SIZE);
+  for (u32 page = first_page; page <= last_page; page++)
+  {
+    const u32 index = page_blocks_index[page];
+    if (index == 0)
+      continue;
+
+    // Erasing a block moves the last entry of the list into its slot. Going backwards, that entry
+    // has already been checked.
+    const std::vector<u32>& page_list = page_blocks[index - 1].blocks;
+    for (size_t i = page_list.size(); i-- > 0;)
+    {
+      JitBlock& block = blocks[page_list[i]];
+      if (block.OverlapsPhysicalRange(address, length))
+        EraseBlock(block);
+    }
+  }
+}
+
+void JitBaseBlockCache::EraseHostCodeRange(const u8* start, const u8* end)
+{
+  for (JitBlock& block : blocks)
+  {
+    if (block.in_use && block.checkedEntry >= start && block.checkedEntry < end)
+      EraseBlock(block);
+  }
+}
+
+void JitBaseBlockCache::EraseBlock(JitBlock& block)
+{
+  // Not counted when the whole cache is cleared
+  ++m_jit.counters.blocks_destroyed;
+
+  DestroyBlock(block);
+  RemoveBlockFromPages(block);
+  RemoveFromBlockMap(block);
+
+  block.in_use = false;
+  free_blocks.push_back(block.slab_index);
+}
+
+u32 JitBaseBlockCache::HashBlockMapKey(u32 physical_address, u32 effective_address, u32 msr_bits)
+{
+  u32 hash = (physical_address >> 2) ^ (effective_address * 0x85EBCA6B) ^ msr_bits;
+  hash ^= hash >> 15;
+  hash *= 0x2C1B3C6D;
+  hash ^= hash >> 12;
+  return hash;
+}
+
+void JitBaseBlockCache::InsertIntoBlockMap(const JitBlock& block)
+{
+  // Keep the table at most half full. If most of it is deleted entries, rehashing at the same size
+  // is enough to get rid of them.
+  if ((block_map_used + 1) * 2 > block_map.size())
+  {
+    const bool grow = block_map_live * 4 >= block_map.size();
+    ResizeBlockMap(grow ? block_map.size() * 2 : block_map.size());
+  }
+
+  const size_t mask = block_map.size() - 1;
+  size_t i = HashBlockMapKey(block.physicalAddress, block.effectiveAddress, block.msrBits) & mask;
+  while (block_map[i].slab_index != BLOCK_MAP_EMPTY && block_map[i].slab_index != BLOCK_MAP_DELETED)
+    i = (i + 1) & mask;
+
+  if (block_map[i].slab_index == BLOCK_MAP_EMPTY)
+    block_map_used++;
+  block_map_live++;
+  block_map[i] = {block.physicalAddress, block.effectiveAddress, block.msrBits, block.slab_index};
+}
+
+void JitBaseBlockCache::RemoveFromBlockMap(const JitBlock& block)
+{
+  const size_t mask = block_map.size() - 1;
+  size_t i = HashBlockMapKey(block.physicalAddress, block.effectiveAddress, block.msrBits) & mask;
+  for (; block_map[i].slab_index != BLOCK_MAP_EMPTY; i = (i + 1) & mask)
+  {
+    if (block_map[i].slab_index == block.slab_index)
+    {
+      // Later entries may have probed past this one, so it can't simply be emptied
+      block_map[i].slab_index = BLOCK_MAP_DELETED;
+      block_map_live--;
+      return;
+    }
+  }
+}
+
+void JitBaseBlockCache::ResizeBlockMap(size_t capacity)
+{
+  std::vector<BlockMapEntry> old_map(capacity, {0, 0, 0, BLOCK_MAP_EMPTY});
+  std::swap(old_map, block_map);
+  block_map_used = 0;
+  block_map_live = 0;
+
+  const size_t mask = capacity - 1;
+  for (const BlockMapEntry& entry : old_map)
   {
-    // Iterate over all blocks in the macro block.
-    auto iter = start->second.begin();
-    while (iter != start->second.end())
+    if (entry.slab_index == BLOCK_MAP_EMPTY || entry.slab_index == BLOCK_MAP_DELETED)
+      continue;
+
+    size_t i = HashBlockMapKey(entry.physical_address, entry.effective_address, entry.msr_bits) &
+               mask;
+    while (block_map[i].slab_index != BLOCK_MAP_EMPTY)
+      i = (i + 1) & mask;
+    block_map[i] = entry;
+    block_map_used++;
+    block_map_live++;
+  }
+}
+
+void JitBaseBlockCache::AddBlockToPages(const JitBlock& block)
+{
+  // physical_addresses is sorted, so all the addresses on a page are next to each other
+  u32 last_page = CODE_PAGE_COUNT;
+  for (u32 addr : block.physical_addresses)
+  {
+    const u32 page = addr / CODE_PAGE_SIZE;
+    if (page == last_page)
+      continue;
+    last_page = page;
+
+    u32& index = page_blocks_index[page];
+    if (index == 0)
     {
-      JitBlock* block = *iter;
-      if (block->OverlapsPhysicalRange(address, length))
+      if (free_page_blocks.empty())
       {
-        // If the block overlaps, also remove all other occupied slots in the other macro blocks.
-        // This will leak empty macro blocks, but they may be reused or cleared later on.
-        for (u32 addr : block->physical_addresses)
-          if ((addr & range_mask) != start->first)
-            block_range_map[addr & range_mask].erase(block);
-
-        // And remove the block.
-        DestroyBlock(*block);
-        auto block_map_iter = block_map.equal_range(block->physicalAddress);
-        while (block_map_iter.first != block_map_iter.second)
-        {
-          if (&block_map_iter.first->second == block)
-          {
-            block_map.erase(block_map_iter.first);
-            break;
-          }
-          block_map_iter.first++;
-        }
-        iter = start->second.erase(iter);
+        page_blocks.push_back({page, {}});
+        index = static_cast<u32>(page_blocks.size());
       }
       else
       {
-        iter++;
+        index = free_page_blocks.back() + 1;
+        free_page_blocks.pop_back();
+        page_blocks[index - 1].page = page;
       }
     }
+    page_blocks[index - 1].blocks.push_back(block.slab_index);
+  }
+}
+
+void JitBaseBlockCache::RemoveBlockFromPages(const JitBlock& block)
+{
+  u32 last_page = CODE_PAGE_COUNT;
+  for (u32 addr : block.physical_addresses)
+  {
+    const u32 page = addr / CODE_PAGE_SIZE;
+    if (page == last_page)
+      continue;
+    last_page = page;
+
+    const u32 index = page_blocks_index[page];
+    if (index == 0)
+      continue;
+
+    std::vector<u32>& page_list = page_blocks[index - 1].blocks;
+    const auto iter = std::find(page_list.begin(), page_list.end(), block.slab_index);
+    if (iter != page_list.end())
+    {
+      *iter = page_list.back();
+      page_list.pop_back();
+    }
 
-    // If the macro block is empty, drop it.
-    if (start->second.empty())
-      start = block_range_map.erase(start);
-    else
-      start++;
+    // Keep the list's storage around for the next page that needs one
+    if (page_list.empty())
+    {
+      page_blocks_index[page] = 0;
+      free_page_blocks.push_back(index - 1);
+    }
   }
 }
 
@@ -5,8 +5,8 @@
 #pragma once
 
 #include <array>
-#include <bitset>
 #include <cstring>
+#include <deque>
 #include <functional>
 #include <map>
 #include <memory>
@@ -74,6 +74,11 @@ struct JitBlock : public JitBlockData
   // This set stores all physical addresses of all occupied instructions.
   std::set<u32> physical_addresses;
 
+  // Position of this block in the block cache's slab. It doesn't change for as long as the block
+  // exists, and is reused once the block is destroyed.
+  u32 slab_index;
+  bool in_use;
+
   // Block profiling data, structure is inlined in Jit.cpp
   struct ProfileData
   {
@@ -154,7 +159,13 @@ public:
   const u8* Dispatch();
 
   void InvalidateICache(u32 address, u32 length, bool forced);
+  // Invalidates the blocks overlapping a write made from outside the emulated CPU, such as a
+  // debugger or corruption tool. Pages without compiled code are skipped with a single lookup, so
+  // this stays cheap for large writes to data.
+  void InvalidateExternalWrite(u32 address, u32 length);
   void ErasePhysicalRange(u32 address, u32 length);
+  // Erases every block whose host code starts in the given range, so that the range can be reused
+  void EraseHostCodeRange(const u8* start, const u8* end);
 
   u32* GetBlockBitSet() const;
 
@@ -175,19 +186,59 @@ private:
   // Fast but risky block lookup based on fast_block_map.
   size_t FastLookupIndexForAddress(u32 address);
 
+  // Destroys the block and removes it from every structure that refers to it
+  void EraseBlock(JitBlock& block);
+
+  static u32 HashBlockMapKey(u32 physical_address, u32 effective_address, u32 msr_bits);
+  void InsertIntoBlockMap(const JitBlock& block);
+  void RemoveFromBlockMap(const JitBlock& block);
+  void ResizeBlockMap(size_t capacity);
+
+  void AddBlockToPages(const JitBlock& block);
+  void RemoveBlockFromPages(const JitBlock& block);
+
   // links_to hold all exit points of all valid blocks in a reverse way.
   // It is used to query all blocks which links to an address.
   std::multimap<u32, JitBlock*> links_to;  // destination_PC -> number
 
-  // Map indexed by the physical address of the entry point.
-  // This is used to query the block based on the current PC in a slow way.
-  std::multimap<u32, JitBlock> block_map;  // start_addr -> block
+  // Every block lives in this slab, indexed by JitBlock::slab_index. A deque never moves its
+  // elements, so pointers to blocks stay valid while new ones are allocated. Destroyed blocks go
+  // on the free list and are reused before the slab grows.
+  std::deque<JitBlock> blocks;
+  std::vector<u32> free_blocks;
 
-  // Range of overlapping code indexed by a masked physical address.
-  // This is used for invalidation of memory regions. The range is grouped
-  // in macro blocks of each 0x100 bytes.
-  static constexpr u32 BLOCK_RANGE_MAP_ELEMENTS = 0x100;
-  std::map<u32, std::set<JitBlock*>> block_range_map;
+  // Open-addressed hash table (linear probing) of every block, keyed by its physical address,
+  // effective address and MSR bits. This is used to query the block based on the current PC in a
+  // slow way. The key is copied into the entry so that probing doesn't have to touch the blocks.
+  struct BlockMapEntry
+  {
+    u32 physical_address;
+    u32 effective_address;
+    u32 msr_bits;
+    u32 slab_index;
+  };
+  static constexpr u32 BLOCK_MAP_EMPTY = 0xFFFFFFFF;
+  static constexpr u32 BLOCK_MAP_DELETED = 0xFFFFFFFE;
+  static constexpr size_t BLOCK_MAP_INITIAL_CAPACITY = 0x10000;
+  std::vector<BlockMapEntry> block_map;
+  // Entries that aren't empty, including deleted ones, which still lengthen probe sequences
+  size_t block_map_used = 0;
+  size_t block_map_live = 0;
+
+  // The blocks overlapping each physical page, for invalidation of memory regions. The per-page
+  // lists are kept in a pool and only ever cleared, so they reuse their storage once the cache has
+  // warmed up.
+  static constexpr u32 CODE_PAGE_SIZE = 0x1000;
+  static constexpr u32 CODE_PAGE_COUNT = static_cast<u32>((1ULL << 32) / CODE_PAGE_SIZE);
+  struct PageBlocks
+  {
+    u32 page;
+    std::vector<u32> blocks;
+  };
+  // Indexed by page. 0 means no blocks, otherwise this is the index into page_blocks plus one.
+  std::unique_ptr<u32[]> page_blocks_index;
+  std::vector<PageBlocks> page_blocks;
+  std::vector<u32> free_page_blocks;
 
   // This bitsets shows which cachelines overlap with any blocks.
   // It is used to provide a fast way to query if no icache invalidation is needed.
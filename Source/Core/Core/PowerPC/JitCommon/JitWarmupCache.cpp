@@ -0,0 +1,198 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/PowerPC/JitCommon/JitWarmupCache.h"
+
+#include <algorithm>
+
+#include <xxhash.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/JitCommon/JitBase.h"
+#include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PowerPC.h"
+
+// On disk, each value is the code hash (low word first), the physical address of the block's
+// entry point and then the block's instructions.
+class JitWarmupCache::Reader final : public LinearDiskCacheReader<Key, u32>
+{
+public:
+  explicit Reader(JitWarmupCache& cache) : m_cache(cache) {}
+
+  void Read(const Key& key, const u32* value, u32 value_size) override
+  {
+    if (value_size < 4)
+      return;
+
+    Entry entry;
+    entry.key = key;
+    entry.hash = value[0] | (u64{value[1]} << 32);
+    entry.physical_address = value[2];
+    entry.instructions.assign(value + 3, value + value_size);
+
+    m_cache.m_known.emplace(key.effective_address, key.msr_bits);
+    m_cache.m_pending.push_back(std::move(entry));
+  }
+
+private:
+  JitWarmupCache& m_cache;
+};
+
+void JitWarmupCache::Load()
+{
+  m_loaded = true;
+
+  const std::string& game_id = SConfig::GetInstance().GetGameID();
+  if (!Config::Get(Config::MAIN_JIT_WARMUP) || game_id.empty())
+    return;
+
+  const std::string dir = File::GetUserPath(D_CACHE_IDX) + "JitWarmup" DIR_SEP;
+  if (!File::IsDirectory(dir) && !File::CreateDir(dir))
+    return;
+
+  Reader reader(*this);
+  const u32 count = m_file.OpenAndRead(dir + game_id + ".cache", reader);
+  m_recording = true;
+
+  // Compile in the order the blocks were first recorded, which roughly follows boot order
+  std::reverse(m_pending.begin(), m_pending.end());
+  INFO_LOG(DYNA_REC, "Loaded %u blocks to warm up the JIT cache with", count);
+}
+
+bool JitWarmupCache::HashInstructions(const u32* instructions, size_t count, u64* hash)
+{
+  std::vector<u32> code(count);
+  for (size_t i = 0; i < count; i++)
+  {
+    // Check the address ourselves, since Memory::Read_U32 complains about unmapped addresses
+    const u32 address = instructions[i] & ~FLAGS_MASK;
+    const bool in_ram = address < Memory::GetRamSizeReal() ||
+                        (Memory::m_pEXRAM && (address >> 28) == 0x1 &&
+                         (address & 0x0FFFFFFF) < Memory::GetExRamSizeReal());
+    if (!in_ram)
+      return false;
+    code[i] = Memory::Read_U32(address);
+  }
+
+  *hash = XXH64(code.data(), code.size() * sizeof(u32), 0);
+  return true;
+}
+
+void JitWarmupCache::CompileSome(JitBase& jit, size_t max_blocks)
+{
+  if (!m_loaded)
+    Load();
+
+  if (m_pending.empty())
+    return;
+
+  // Breakpoints and single stepping change how blocks are compiled, and without a block cache
+  // every compile would throw the previous one away
+  if (SConfig::GetInstance().bEnableDebugging || SConfig::GetInstance().bJITNoBlockCache)
+  {
+    m_pending.clear();
+    return;
+  }
+
+  JitBaseBlockCache& block_cache = *jit.GetBlockCache();
+  const u32 msr_bits = MSR.Hex & JitBaseBlockCache::JIT_CACHE_MSR_MASK;
+
+  // Some JITs compile the block at PC rather than the address they are given
+  const u32 pc = PC;
+  size_t compiled = 0;
+  while (compiled < max_blocks && !m_pending.empty())
+  {
+    const Entry entry = std::move(m_pending.back());
+    m_pending.pop_back();
+
+    // Blocks are compiled for the current MSR, and the address has to translate the way it did
+    // when the block was recorded, or it would be compiled from other code
+    if (entry.key.msr_bits != msr_bits)
+      continue;
+    const auto translated = PowerPC::JitCache_TranslateAddress(entry.key.effective_address);
+    if (!translated.valid || translated.address != entry.physical_address)
+      continue;
+
+    u64 hash;
+    if (!HashInstructions(entry.instructions.data(), entry.instructions.size(), &hash) ||
+        hash != entry.hash)
+    {
+      continue;
+    }
+
+    if (block_cache.GetBlockFromStartAddress(entry.key.effective_address, MSR.Hex))
+      continue;
+
+    // Put back the exception checks the block ended up needing last time, so that it doesn't
+    // have to be recompiled as soon as it runs
+    for (u32 instruction : entry.instructions)
+    {
+      const u32 address =
+          entry.key.effective_address + ((instruction & ~FLAGS_MASK) - entry.physical_address);
+      if (instruction & FLAG_FIFO_WRITE)
+        jit.js.fifoWriteAddresses.insert(address);
+      if (instruction & FLAG_PAIRED_QUANTIZE)
+        jit.js.pairedQuantizeAddresses.insert(address);
+    }
+
+    PC = entry.key.effective_address;
+    jit.Jit(entry.key.effective_address);
+    compiled++;
+  }
+  PC = pc;
+  jit.counters.blocks_compiled += compiled;
+}
+
+void JitWarmupCache::RecordAndClose(JitBase& jit)
+{
+  if (!m_recording)
+    return;
+
+  std::vector<u32> value;
+  u32 count = 0;
+  jit.GetBlockCache()->RunOnBlocks([&](const JitBlock& block) {
+    if (block.physical_addresses.empty() ||
+        !m_known.emplace(block.effectiveAddress, block.msrBits).second)
+    {
+      return;
+    }
+
+    value.assign(3, 0);
+    for (u32 address : block.physical_addresses)
+    {
+      const u32 em_address = block.effectiveAddress + (address - block.physicalAddress);
+      u32 flags = 0;
+      if (jit.js.fifoWriteAddresses.count(em_address))
+        flags |= FLAG_FIFO_WRITE;
+      if (jit.js.pairedQuantizeAddresses.count(em_address))
+        flags |= FLAG_PAIRED_QUANTIZE;
+      value.push_back(address | flags);
+    }
+
+    u64 hash;
+    if (!HashInstructions(value.data() + 3, value.size() - 3, &hash))
+      return;
+    value[0] = static_cast<u32>(hash);
+    value[1] = static_cast<u32>(hash >> 32);
+    value[2] = block.physicalAddress;
+
+    m_file.Append({block.effectiveAddress, block.msrBits}, value.data(),
+                  static_cast<u32>(value.size()));
+    count++;
+  });
+
+  INFO_LOG(DYNA_REC, "Recorded %u new blocks to warm up the JIT cache with", count);
+  m_file.Sync();
+  m_file.Close();
+  m_recording = false;
+  m_known.clear();
+  m_pending.clear();
+}
@@ -0,0 +1,65 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/LinearDiskCache.h"
+
+class JitBase;
+
+// Per-game profile of the blocks a previous session compiled, so that they can be compiled again
+// as soon as the game starts instead of one at a time as execution discovers them. Only the
+// block entry points, the instructions they cover and the exception checks they needed are
+// stored, never host code. Every block is checked against a hash of its guest code before
+// being compiled, so stale entries (other discs with the same ID, overlays, self-modifying code)
+// are simply skipped.
+class JitWarmupCache final
+{
+public:
+  // Compiles up to max_blocks blocks from the profile. The profile is loaded on the first call,
+  // once the game ID is known. Does nothing once the profile has been used up.
+  void CompileSome(JitBase& jit, size_t max_blocks);
+
+  // Adds the blocks currently in the JIT cache that the profile doesn't have yet, then closes it
+  void RecordAndClose(JitBase& jit);
+
+private:
+  struct Key
+  {
+    u32 effective_address;
+    u32 msr_bits;
+  };
+
+  struct Entry
+  {
+    Key key;
+    u64 hash;
+    u32 physical_address;
+    // Physical addresses of the block's instructions, with the flags below in the low bits
+    std::vector<u32> instructions;
+  };
+
+  class Reader;
+
+  static constexpr u32 FLAG_FIFO_WRITE = 1;
+  static constexpr u32 FLAG_PAIRED_QUANTIZE = 2;
+  static constexpr u32 FLAGS_MASK = 3;
+
+  void Load();
+  static bool HashInstructions(const u32* instructions, size_t count, u64* hash);
+
+  bool m_loaded = false;
+  bool m_recording = false;
+  LinearDiskCache<Key, u32> m_file;
+  // Every block the file already holds, as (effective address, MSR bits)
+  std::set<std::pair<u32, u32>> m_known;
+  std::vector<Entry> m_pending;
+};
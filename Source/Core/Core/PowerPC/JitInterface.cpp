@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <cinttypes>
 #include <cstdio>
+#include <map>
 #include <string>
 #include <unordered_set>
 
@@ -16,6 +17,8 @@
 #include "Common/PerformanceCounter.h"
 #endif
 
+#include <fmt/format.h>
+
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/File.h"
@@ -117,6 +120,58 @@ void WriteProfileResults(const std::string& filename)
   }
 }
 
+void WriteFunctionProfileResults(const std::string& filename)
+{
+  Profiler::ProfileStats prof_stats;
+  GetProfileResults(&prof_stats);
+
+  File::IOFile f(filename, "w");
+  if (!f)
+  {
+    PanicAlert("Failed to open %s", filename.c_str());
+    return;
+  }
+
+  for (const auto& stat : prof_stats.function_stats)
+  {
+    if (stat.tick_counter == 0)
+      continue;
+
+    // Semicolons separate the frames of a stack
+    std::string name = stat.name;
+    std::replace(name.begin(), name.end(), ';', ':');
+    fprintf(f.GetHandle(), "%s %" PRIu64 "\n", name.c_str(), stat.tick_counter);
+  }
+}
+
+static void AggregateFunctionStats(Profiler::ProfileStats* prof_stats)
+{
+  std::map<u32, Profiler::FunctionStat> functions;
+  for (const auto& block : prof_stats->block_stats)
+  {
+    const Common::Symbol* symbol = g_symbolDB.GetSymbolFromAddr(block.addr);
+    const u32 address = symbol ? symbol->address : block.addr;
+
+    auto it = functions.find(address);
+    if (it == functions.end())
+    {
+      std::string name = symbol ? symbol->function_name : fmt::format("{:08x}", block.addr);
+      it = functions.emplace(address, Profiler::FunctionStat(address, std::move(name))).first;
+    }
+
+    Profiler::FunctionStat& function = it->second;
+    function.cost += block.cost;
+    function.tick_counter += block.tick_counter;
+    function.run_count += block.run_count;
+    function.num_blocks++;
+  }
+
+  prof_stats->function_stats.clear();
+  for (auto& entry : functions)
+    prof_stats->function_stats.push_back(std::move(entry.second));
+  std::sort(prof_stats->function_stats.begin(), prof_stats->function_stats.end());
+}
+
 void GetProfileResults(Profiler::ProfileStats* prof_stats)
 {
   // Can't really do this with no g_jit core available
@@ -145,10 +200,31 @@ void GetProfileResults(Profiler::ProfileStats* prof_stats)
   });
 
   sort(prof_stats->block_stats.begin(), prof_stats->block_stats.end());
+  AggregateFunctionStats(prof_stats);
   if (old_state == Core::State::Running)
     Core::SetState(Core::State::Running);
 }
 
+Statistics GetStatistics()
+{
+  Statistics statistics;
+  if (!g_jit)
+    return statistics;
+
+  const JitBase::Counters& counters = g_jit->counters;
+  statistics.fast_map_misses = counters.fast_map_misses;
+  statistics.block_cache_misses = counters.block_cache_misses;
+  statistics.blocks_compiled = counters.blocks_compiled;
+  statistics.bytes_emitted = counters.bytes_emitted;
+  statistics.compile_time_us = counters.compile_time_us;
+  statistics.icache_invalidations = counters.icache_invalidations;
+  statistics.blocks_destroyed = counters.blocks_destroyed;
+  statistics.full_cache_clears = counters.full_cache_clears;
+  statistics.code_segment_evictions = counters.code_segment_evictions;
+  statistics.backpatched_faults = counters.backpatched_faults;
+  return statistics;
+}
+
 int GetHostCode(u32* address, const u8** code, u32* code_size)
 {
   if (!g_jit)
@@ -226,6 +302,12 @@ void InvalidateICache(u32 address, u32 size, bool forced)
     g_jit->GetBlockCache()->InvalidateICache(address, size, forced);
 }
 
+void InvalidateExternalWrite(u32 address, u32 size)
+{
+  if (g_jit)
+    g_jit->GetBlockCache()->InvalidateExternalWrite(address, size);
+}
+
 void CompileExceptionCheck(ExceptionType type)
 {
   if (!g_jit)
@@ -267,6 +349,7 @@ void Shutdown()
 {
   if (g_jit)
   {
+    g_jit->warmup_cache.RecordAndClose(*g_jit);
     g_jit->Shutdown();
     delete g_jit;
     g_jit = nullptr;
@@ -32,6 +32,28 @@ enum class ExceptionType
   SpeculativeConstants
 };
 
+// What the JIT has been doing, for the statistics overlay and for benchmarking. The counters
+// start from zero whenever a JIT is created and aren't part of savestates.
+struct Statistics
+{
+  // Times the dispatcher had to look the PC up in the full block map
+  u64 fast_map_misses = 0;
+  // Times it didn't find a compiled block there either
+  u64 block_cache_misses = 0;
+  u64 blocks_compiled = 0;
+  u64 bytes_emitted = 0;
+  // Host time spent compiling blocks
+  u64 compile_time_us = 0;
+  u64 icache_invalidations = 0;
+  u64 blocks_destroyed = 0;
+  // Times the whole cache was thrown away because the code buffer was full
+  u64 full_cache_clears = 0;
+  // Times the oldest code segment was emptied to make room (Jit64 only)
+  u64 code_segment_evictions = 0;
+  // Fastmem accesses that faulted and were patched to take the slow path
+  u64 backpatched_faults = 0;
+};
+
 void DoState(PointerWrap& p);
 
 CPUCoreBase* InitJitCore(PowerPC::CPUCore core);
@@ -46,8 +68,13 @@ enum class ProfilingState
 
 void SetProfilingState(ProfilingState state);
 void WriteProfileResults(const std::string& filename);
+// Writes the time spent in each guest function in the folded stacks format taken by flame graph
+// tools (e.g. flamegraph.pl or speedscope)
+void WriteFunctionProfileResults(const std::string& filename);
 void GetProfileResults(Profiler::ProfileStats* prof_stats);
 int GetHostCode(u32* address, const u8** code, u32* code_size);
+// Returns zeroes when the interpreter is in use. Safe to call from any thread.
+Statistics GetStatistics();
 
 // Memory Utilities
 bool HandleFault(uintptr_t access_address, SContext* ctx);
@@ -63,6 +90,9 @@ void ClearSafe();
 
 // If "forced" is true, a recompile is being requested on code that hasn't been modified.
 void InvalidateICache(u32 address, u32 size, bool forced);
+// For writes from outside the emulated CPU. Only blocks on the touched cache lines are destroyed,
+// and pages that have never held code are skipped entirely.
+void InvalidateExternalWrite(u32 address, u32 size);
 
 void CompileExceptionCheck(ExceptionType type);
 
@@ -4,6 +4,8 @@
 
 #include "Core/PowerPC/MMU.h"
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstring>
 #include <string>
@@ -27,10 +29,6 @@
 
 namespace PowerPC
 {
-constexpr size_t HW_PAGE_SIZE = 4096;
-constexpr u32 HW_PAGE_INDEX_SHIFT = 12;
-constexpr u32 HW_PAGE_INDEX_MASK = 0x3f;
-
 // EFB RE
 /*
 GXPeekZ
@@ -166,11 +164,27 @@ BatTable dbat_table;
 
 static void GenerateDSIException(u32 effective_address, bool write);
 
+template <XCheckTLBFlag flag>
+static u8* LookupHostPage(u32 address);
+template <XCheckTLBFlag flag>
+static void UpdateHostPageCache(u32 address, u32 physical_address);
+
 template <XCheckTLBFlag flag, typename T, bool never_translate = false>
 static T ReadFromHardware(u32 em_address)
 {
   if (!never_translate && MSR.DR)
   {
+    const u32 page_offset = em_address & (HW_PAGE_SIZE - 1);
+    if (flag == XCheckTLBFlag::Read && page_offset <= HW_PAGE_SIZE - sizeof(T))
+    {
+      if (const u8* host_page = LookupHostPage<flag>(em_address))
+      {
+        T value;
+        std::memcpy(&value, host_page + page_offset, sizeof(T));
+        return bswap(value);
+      }
+    }
+
     auto translated_addr = TranslateAddress<flag>(em_address);
     if (!translated_addr.Success())
     {
@@ -178,6 +192,8 @@ static T ReadFromHardware(u32 em_address)
         GenerateDSIException(em_address, false);
       return 0;
     }
+    if (translated_addr.result == TranslateAddressResult::PAGE_TABLE_TRANSLATED)
+      UpdateHostPageCache<flag>(em_address, translated_addr.address);
     if ((em_address & (HW_PAGE_SIZE - 1)) > HW_PAGE_SIZE - sizeof(T))
     {
       // This could be unaligned down to the byte level... hopefully this is rare, so doing it this
@@ -259,6 +275,17 @@ static void WriteToHardware(u32 em_address, const T data)
 {
   if (!never_translate && MSR.DR)
   {
+    const u32 page_offset = em_address & (HW_PAGE_SIZE - 1);
+    if (flag == XCheckTLBFlag::Write && page_offset <= HW_PAGE_SIZE - sizeof(T))
+    {
+      if (u8* host_page = LookupHostPage<flag>(em_address))
+      {
+        const T swapped_data = bswap(data);
+        std::memcpy(host_page + page_offset, &swapped_data, sizeof(T));
+        return;
+      }
+    }
+
     auto translated_addr = TranslateAddress<flag>(em_address);
     if (!translated_addr.Success())
     {
@@ -266,6 +293,8 @@ static void WriteToHardware(u32 em_address, const T data)
         GenerateDSIException(em_address, true);
       return;
     }
+    if (translated_addr.result == TranslateAddressResult::PAGE_TABLE_TRANSLATED)
+      UpdateHostPageCache<flag>(em_address, translated_addr.address);
     if ((em_address & (sizeof(T) - 1)) &&
         (em_address & (HW_PAGE_SIZE - 1)) > HW_PAGE_SIZE - sizeof(T))
     {
@@ -421,6 +450,25 @@ TryReadInstResult TryReadInstruction(u32 address)
   return TryReadInstResult{true, from_bat, hex, address};
 }
 
+TryReadInstResult HostTryReadInstruction(const u32 address)
+{
+  if (!HostIsInstructionRAMAddress(address))
+    return TryReadInstResult{false, false, 0, 0};
+
+  u32 physical_address = address;
+  bool from_bat = true;
+  if (MSR.IR)
+  {
+    const auto tlb_addr = TranslateAddress<XCheckTLBFlag::OpcodeNoException>(address);
+    physical_address = tlb_addr.address;
+    from_bat = tlb_addr.result == TranslateAddressResult::BAT_TRANSLATED;
+  }
+
+  const u32 hex =
+      ReadFromHardware<XCheckTLBFlag::OpcodeNoException, u32, true>(physical_address);
+  return TryReadInstResult{true, from_bat, hex, physical_address};
+}
+
 u32 HostRead_Instruction(const u32 address)
 {
   UGeckoInstruction inst = HostRead_U32(address);
@@ -641,17 +689,17 @@ std::string HostGetString(u32 address, size_t size)
 
 bool IsOptimizableRAMAddress(const u32 address)
 {
-  if (PowerPC::memchecks.HasAny())
-    return false;
-
   if (!MSR.DR)
     return false;
 
   // TODO: This API needs to take an access size
   //
   // We store whether an access can be optimized to an unchecked access
-  // in dbat_table.
+  // in dbat_table. Pages with memchecks don't get BAT_PHYSICAL_BIT, and since an access can be
+  // up to 8 bytes long, the page its end lands in has to be free of them too.
   u32 bat_result = dbat_table[address >> BAT_INDEX_SHIFT];
+  if (PowerPC::memchecks.HasAny())
+    bat_result &= dbat_table[(address + 7) >> BAT_INDEX_SHIFT];
   return (bat_result & BAT_PHYSICAL_BIT) != 0;
 }
 
@@ -690,6 +738,41 @@ bool HostIsInstructionRAMAddress(u32 address)
   return !(address & 3) && IsRAMAddress<XCheckTLBFlag::OpcodeNoException>(address, MSR.IR);
 }
 
+void HostWriteBytes(const u8* data, u32 address, size_t size)
+{
+  while (size != 0)
+  {
+    const size_t chunk_size = std::min<size_t>(HW_PAGE_SIZE - (address & (HW_PAGE_SIZE - 1)), size);
+
+    u32 physical_address = address;
+    bool translated = true;
+    if (MSR.DR)
+    {
+      const auto translated_addr = TranslateAddress<XCheckTLBFlag::NoException>(address);
+      translated = translated_addr.Success();
+      physical_address = translated_addr.address;
+    }
+
+    // The chunk doesn't cross a page, so checking its ends covers all of it
+    const u32 physical_end = physical_address + static_cast<u32>(chunk_size) - 1;
+    if (translated && (physical_address >> 28) <= 0x1 &&
+        IsRAMAddress<XCheckTLBFlag::NoException>(physical_address, false) &&
+        IsRAMAddress<XCheckTLBFlag::NoException>(physical_end, false))
+    {
+      Memory::CopyToEmu(physical_address, data, chunk_size);
+    }
+    else
+    {
+      for (size_t i = 0; i < chunk_size; ++i)
+        HostWrite_U8(data[i], address + static_cast<u32>(i));
+    }
+
+    address += static_cast<u32>(chunk_size);
+    data += chunk_size;
+    size -= chunk_size;
+  }
+}
+
 void DMA_LCToMemory(const u32 mem_address, const u32 cache_address, const u32 num_blocks)
 {
   // TODO: It's not completely clear this is the right spot for this code;
@@ -1050,6 +1133,9 @@ static void UpdateTLBEntry(const XCheckTLBFlag flag, UPTE2 PTE2, const u32 addre
   const int tag = address >> HW_PAGE_INDEX_SHIFT;
   TLBEntry& tlbe = ppcState.tlb[IsOpcodeFlag(flag)][tag & HW_PAGE_INDEX_MASK];
   const int index = tlbe.recent == 0 && tlbe.tag[0] != TLBEntry::INVALID_TAG;
+  // Fastmem mappings of page table pages only live as long as the data TLB entry they mirror
+  if (!IsOpcodeFlag(flag) && tlbe.tag[index] != TLBEntry::INVALID_TAG)
+    Memory::UnmapPageTablePage(tlbe.tag[index] << HW_PAGE_INDEX_SHIFT);
   tlbe.recent = index;
   tlbe.paddr[index] = PTE2.RPN << HW_PAGE_INDEX_SHIFT;
   tlbe.pte[index] = PTE2.Hex;
@@ -1061,6 +1147,11 @@ void InvalidateTLBEntry(u32 address)
   const u32 entry_index = (address >> HW_PAGE_INDEX_SHIFT) & HW_PAGE_INDEX_MASK;
 
   TLBEntry& tlbe = ppcState.tlb[0][entry_index];
+  for (u32 tag : tlbe.tag)
+  {
+    if (tag != TLBEntry::INVALID_TAG)
+      Memory::UnmapPageTablePage(tag << HW_PAGE_INDEX_SHIFT);
+  }
   tlbe.tag[0] = TLBEntry::INVALID_TAG;
   tlbe.tag[1] = TLBEntry::INVALID_TAG;
 
@@ -1069,6 +1160,95 @@ void InvalidateTLBEntry(u32 address)
   tlbe_i.tag[1] = TLBEntry::INVALID_TAG;
 }
 
+// Direct-mapped cache from recently used effective pages to the host memory behind them, for
+// data accesses that go through the TLB and land in RAM. A hit skips the BAT check, the TLB
+// lookup and the physical memory map. Entries don't have to be invalidated with the TLB: they are
+// only used while the TLB entry they were made from still holds the same translation. They do
+// depend on the BATs not covering the page, so BAT updates clear the cache.
+struct HostPageCacheEntry
+{
+  u32 tag = TLBEntry::INVALID_TAG;
+  u32 physical_page = 0;
+  u8* host_page = nullptr;
+  u8 way = 0;
+};
+
+constexpr u32 HOST_PAGE_CACHE_SIZE = 256;
+
+// Indexed by whether the access is a write
+static std::array<std::array<HostPageCacheEntry, HOST_PAGE_CACHE_SIZE>, 2> s_host_page_cache;
+
+static void ClearHostPageCache()
+{
+  s_host_page_cache = {};
+}
+
+static u8* GetHostPage(u32 physical_page)
+{
+  if ((physical_page & 0xF8000000) == 0x00000000)
+    return &Memory::m_pRAM[physical_page & Memory::GetRamMask()];
+
+  if (Memory::m_pEXRAM && (physical_page >> 28) == 0x1 &&
+      (physical_page & 0x0FFFFFFF) < Memory::GetExRamSizeReal())
+  {
+    return &Memory::m_pEXRAM[physical_page & 0x0FFFFFFF];
+  }
+
+  return nullptr;
+}
+
+template <XCheckTLBFlag flag>
+static u8* LookupHostPage(u32 address)
+{
+  const u32 tag = address >> HW_PAGE_INDEX_SHIFT;
+  const HostPageCacheEntry& entry =
+      s_host_page_cache[flag == XCheckTLBFlag::Write][tag % HOST_PAGE_CACHE_SIZE];
+  if (entry.tag != tag)
+    return nullptr;
+
+  TLBEntry& tlbe = ppcState.tlb[0][tag & HW_PAGE_INDEX_MASK];
+  if (tlbe.tag[entry.way] != tag || tlbe.paddr[entry.way] != entry.physical_page)
+    return nullptr;
+
+  // The first write to a page has to go through the page table to set the C bit
+  if (flag == XCheckTLBFlag::Write)
+  {
+    UPTE2 PTE2;
+    PTE2.Hex = tlbe.pte[entry.way];
+    if (PTE2.C == 0)
+      return nullptr;
+  }
+
+  // Same as a TLB hit
+  tlbe.recent = entry.way;
+  return entry.host_page;
+}
+
+template <XCheckTLBFlag flag>
+static void UpdateHostPageCache(u32 address, u32 physical_address)
+{
+  if (flag != XCheckTLBFlag::Read && flag != XCheckTLBFlag::Write)
+    return;
+
+  const u32 tag = address >> HW_PAGE_INDEX_SHIFT;
+  const TLBEntry& tlbe = ppcState.tlb[0][tag & HW_PAGE_INDEX_MASK];
+  const u32 physical_page = physical_address & ~(HW_PAGE_SIZE - 1);
+  u8 way;
+  if (tlbe.tag[0] == tag && tlbe.paddr[0] == physical_page)
+    way = 0;
+  else if (tlbe.tag[1] == tag && tlbe.paddr[1] == physical_page)
+    way = 1;
+  else
+    return;
+
+  u8* host_page = GetHostPage(physical_page);
+  if (!host_page)
+    return;
+
+  s_host_page_cache[flag == XCheckTLBFlag::Write][tag % HOST_PAGE_CACHE_SIZE] = {
+      tag, physical_page, host_page, way};
+}
+
 // Page Address Translation
 static TranslateAddressResult TranslatePageAddress(const u32 address, const XCheckTLBFlag flag)
 {
@@ -1253,6 +1433,7 @@ static void UpdateFakeMMUBat(BatTable& bat_table, u32 start_addr)
 void DBATUpdated()
 {
   dbat_table = {};
+  ClearHostPageCache();
   UpdateBATs(dbat_table, SPR_DBAT0U);
   bool extended_bats = SConfig::GetInstance().bWii && HID4.SBE;
   if (extended_bats)
@@ -1266,6 +1447,7 @@ void DBATUpdated()
 
 #ifndef _ARCH_32
   Memory::UpdateLogicalMemory(dbat_table);
+  Memory::UpdatePhysicalMemchecks();
 #endif
 
   // IsOptimizable*Address and dcbz depends on the BAT mapping, so we need a flush here.
@@ -1311,4 +1493,29 @@ std::optional<u32> GetTranslatedAddress(u32 address)
   return std::optional<u32>(result.address);
 }
 
+bool MapPageTablePageForFastmem(u32 address, bool write)
+{
+  // Accesses through the mapping wouldn't hit memchecks
+  if (PowerPC::memchecks.OverlapsMemcheck(address, HW_PAGE_SIZE))
+    return false;
+
+  // Translating here has the same side effects the faulting access would have had
+  const TranslateAddressResult result = write ? TranslateAddress<XCheckTLBFlag::Write>(address) :
+                                                TranslateAddress<XCheckTLBFlag::Read>(address);
+  if (result.result != TranslateAddressResult::PAGE_TABLE_TRANSLATED)
+    return false;
+
+  // Accesses through the mapping don't update the R and C bits, so the page can only be mapped
+  // once both are set. The translation above sets R, but C only for writes.
+  const u32 tag = address >> HW_PAGE_INDEX_SHIFT;
+  const TLBEntry& tlbe = ppcState.tlb[0][tag & HW_PAGE_INDEX_MASK];
+  const int way = tlbe.tag[0] == tag ? 0 : 1;
+  UPTE2 PTE2;
+  PTE2.Hex = tlbe.pte[way];
+  if (tlbe.tag[way] != tag || !PTE2.C)
+    return false;
+
+  return Memory::MapPageTablePage(address, result.address);
+}
+
 }  // namespace PowerPC
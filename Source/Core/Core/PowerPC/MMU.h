@@ -30,6 +30,8 @@ void HostWrite_U32(u32 var, u32 address);
 void HostWrite_U64(u64 var, u32 address);
 void HostWrite_F32(float var, u32 address);
 void HostWrite_F64(double var, u32 address);
+// Same as calling HostWrite_U8 for each byte, but translates once per page and copies RAM at once
+void HostWriteBytes(const u8* data, u32 address, size_t size);
 
 std::string HostGetString(u32 address, size_t size = 0);
 
@@ -52,6 +54,9 @@ struct TryReadInstResult
   u32 physical_address;
 };
 TryReadInstResult TryReadInstruction(u32 address);
+// Same as TryReadInstruction, but reads straight from memory and doesn't touch the iCache or the
+// TLB, so that code can be analyzed from other threads while the CPU is paused.
+TryReadInstResult HostTryReadInstruction(u32 address);
 
 u8 Read_U8(u32 address);
 u16 Read_U16(u32 address);
@@ -85,6 +90,10 @@ void ClearCacheLine(u32 address);  // Zeroes 32 bytes; address should be 32-byte
 // TLB functions
 void SDRUpdated();
 void InvalidateTLBEntry(u32 address);
+// For the JIT fault handlers: translates a data access that missed the logical fastmem arena the
+// way the access itself would, and maps its page into the arena if it goes through the page table
+// to RAM. Returns true if the access can simply be retried.
+bool MapPageTablePageForFastmem(u32 address, bool write);
 void DBATUpdated();
 void IBATUpdated();
 
@@ -103,6 +112,10 @@ struct TranslateResult
 };
 TranslateResult JitCache_TranslateAddress(u32 address);
 
+constexpr size_t HW_PAGE_SIZE = 4096;
+constexpr u32 HW_PAGE_INDEX_SHIFT = 12;
+constexpr u32 HW_PAGE_INDEX_MASK = 0x3f;
+
 constexpr int BAT_INDEX_SHIFT = 17;
 constexpr u32 BAT_PAGE_SIZE = 1 << BAT_INDEX_SHIFT;
 constexpr u32 BAT_MAPPED_BIT = 0x1;
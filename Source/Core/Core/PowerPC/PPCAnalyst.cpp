@@ -5,18 +5,25 @@
 #include "Core/PowerPC/PPCAnalyst.h"
 
 #include <algorithm>
+#include <atomic>
+#include <bitset>
 #include <map>
 #include <queue>
+#include <sstream>
 #include <string>
 #include <vector>
 
 #include <fmt/format.h>
 
 #include "Common/Assert.h"
+#include "Common/CommonPaths.h"
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
+#include "Common/ThreadPool.h"
 #include "Core/ConfigManager.h"
+#include "Core/HLE/HLE.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
@@ -43,6 +50,9 @@ constexpr u32 BRANCH_FOLLOWING_THRESHOLD = 2;
 
 constexpr u32 INVALID_BRANCH_TARGET = 0xFFFFFFFF;
 
+// Longer loops are unlikely to be waiting on anything
+constexpr size_t MAX_BUSY_WAIT_LOOP_INSTRUCTIONS = 32;
+
 static u32 EvaluateBranchTarget(UGeckoInstruction instr, u32 pc)
 {
   switch (instr.OPCD)
@@ -104,7 +114,7 @@ bool AnalyzeFunction(u32 startAddr, Common::Symbol& func, u32 max_size)
         func.flags |= Common::FFLAG_STRAIGHT;
       return true;
     }
-    const PowerPC::TryReadInstResult read_result = PowerPC::TryReadInstruction(addr);
+    const PowerPC::TryReadInstResult read_result = PowerPC::HostTryReadInstruction(addr);
     const UGeckoInstruction instr = read_result.hex;
     if (read_result.valid && PPCTables::IsValidInstruction(instr))
     {
@@ -255,11 +265,11 @@ static bool CanSwapAdjacentOps(const CodeOp& a, const CodeOp& b)
 // called by another function. Therefore, let's scan the
 // entire space for bl operations and find what functions
 // get called.
-static void FindFunctionsFromBranches(u32 startAddr, u32 endAddr, Common::SymbolDB* func_db)
+static void FindBranchTargets(u32 startAddr, u32 endAddr, std::vector<u32>* targets)
 {
   for (u32 addr = startAddr; addr < endAddr; addr += 4)
   {
-    const PowerPC::TryReadInstResult read_result = PowerPC::TryReadInstruction(addr);
+    const PowerPC::TryReadInstResult read_result = PowerPC::HostTryReadInstruction(addr);
     const UGeckoInstruction instr = read_result.hex;
 
     if (read_result.valid && PPCTables::IsValidInstruction(instr))
@@ -275,7 +285,7 @@ static void FindFunctionsFromBranches(u32 startAddr, u32 endAddr, Common::Symbol
             target += addr;
           if (PowerPC::HostIsRAMAddress(target))
           {
-            func_db->AddFunction(target);
+            targets->push_back(target);
           }
         }
       }
@@ -287,6 +297,24 @@ static void FindFunctionsFromBranches(u32 startAddr, u32 endAddr, Common::Symbol
   }
 }
 
+static void FindFunctionsFromBranches(u32 startAddr, u32 endAddr, PPCSymbolDB* func_db)
+{
+  // The scan covers all of RAM, so it's split into parts that are scanned in parallel
+  constexpr u32 BYTES_PER_JOB = 0x10000;
+  startAddr &= ~3U;
+  const size_t job_count = endAddr > startAddr ? (endAddr - startAddr - 1) / BYTES_PER_JOB + 1 : 0;
+  std::vector<std::vector<u32>> targets(job_count);
+  Common::ThreadPool::ParallelFor(job_count, [&](size_t job) {
+    const u32 start = startAddr + static_cast<u32>(job) * BYTES_PER_JOB;
+    FindBranchTargets(start, start + std::min(BYTES_PER_JOB, endAddr - start), &targets[job]);
+  });
+
+  std::vector<u32> all_targets;
+  for (const std::vector<u32>& job_targets : targets)
+    all_targets.insert(all_targets.end(), job_targets.begin(), job_targets.end());
+  func_db->AddFunctions(all_targets);
+}
+
 static void FindFunctionsFromHandlers(PPCSymbolDB* func_db)
 {
   static const std::map<u32, const char* const> handlers = {
@@ -309,7 +337,7 @@ static void FindFunctionsFromHandlers(PPCSymbolDB* func_db)
 
   for (const auto& entry : handlers)
   {
-    const PowerPC::TryReadInstResult read_result = PowerPC::TryReadInstruction(entry.first);
+    const PowerPC::TryReadInstResult read_result = PowerPC::HostTryReadInstruction(entry.first);
     if (read_result.valid && PPCTables::IsValidInstruction(read_result.hex))
     {
       // Check if this function is already mapped
@@ -334,13 +362,13 @@ static void FindFunctionsAfterReturnInstruction(PPCSymbolDB* func_db)
     {
       // Skip zeroes (e.g. Donkey Kong Country Returns) and nop (e.g. libogc)
       // that sometimes pad function to 16 byte boundary.
-      PowerPC::TryReadInstResult read_result = PowerPC::TryReadInstruction(location);
+      PowerPC::TryReadInstResult read_result = PowerPC::HostTryReadInstruction(location);
       while (read_result.valid && (location & 0xf) != 0)
       {
         if (read_result.hex != 0 && read_result.hex != 0x60000000)
           break;
         location += 4;
-        read_result = PowerPC::TryReadInstruction(location);
+        read_result = PowerPC::HostTryReadInstruction(location);
       }
       if (read_result.valid && PPCTables::IsValidInstruction(read_result.hex))
       {
@@ -357,14 +385,8 @@ static void FindFunctionsAfterReturnInstruction(PPCSymbolDB* func_db)
   }
 }
 
-void FindFunctions(u32 startAddr, u32 endAddr, PPCSymbolDB* func_db)
+static void AnalyzeFoundFunctions(PPCSymbolDB* func_db)
 {
-  // Step 1: Find all functions
-  FindFunctionsFromBranches(startAddr, endAddr, func_db);
-  FindFunctionsFromHandlers(func_db);
-  FindFunctionsAfterReturnInstruction(func_db);
-
-  // Step 2:
   func_db->FillInCallers();
 
   int numLeafs = 0, numNice = 0, numUnNice = 0;
@@ -432,6 +454,140 @@ void FindFunctions(u32 startAddr, u32 endAddr, PPCSymbolDB* func_db)
            unniceSize);
 }
 
+void FindFunctions(u32 startAddr, u32 endAddr, PPCSymbolDB* func_db)
+{
+  // Step 1: Find all functions
+  FindFunctionsFromBranches(startAddr, endAddr, func_db);
+  FindFunctionsFromHandlers(func_db);
+  FindFunctionsAfterReturnInstruction(func_db);
+
+  // Step 2:
+  AnalyzeFoundFunctions(func_db);
+}
+
+namespace
+{
+struct CachedFunction
+{
+  u32 address;
+  u32 size;
+  u32 hash;
+  std::string name;
+};
+}  // Anonymous namespace
+
+static std::string GetFunctionCachePath(u32 startAddr, u32 endAddr)
+{
+  const SConfig& config = SConfig::GetInstance();
+  return fmt::format("{}Symbols" DIR_SEP "{}_r{}_{:08x}_{:08x}.txt",
+                     File::GetUserPath(D_CACHE_IDX), config.GetGameID(), config.GetRevision(),
+                     startAddr, endAddr);
+}
+
+static std::vector<CachedFunction> ReadFunctionCache(const std::string& path)
+{
+  std::string text;
+  if (!File::ReadFileToString(path, text))
+    return {};
+
+  std::vector<CachedFunction> functions;
+  std::istringstream stream(text);
+  std::string line;
+  while (std::getline(stream, line))
+  {
+    CachedFunction function;
+    std::istringstream line_stream(line);
+    line_stream >> std::hex >> function.address >> function.size >> function.hash;
+    line_stream.ignore(1);
+    std::getline(line_stream, function.name);
+    if (!line_stream || function.size == 0 || function.name.empty())
+    {
+      WARN_LOG(SYMBOLS, "Ignoring the malformed function cache %s", path.c_str());
+      return {};
+    }
+    functions.push_back(std::move(function));
+  }
+  return functions;
+}
+
+// Only trusts the cache when the code of every function in it is still the same, which it isn't
+// when e.g. another part of the game has been loaded since the cache was written.
+static bool LoadFunctionCache(const std::string& path, PPCSymbolDB* func_db)
+{
+  const std::vector<CachedFunction> functions = ReadFunctionCache(path);
+  if (functions.empty())
+    return false;
+
+  std::atomic<bool> unchanged{true};
+  Common::ThreadPool::ParallelFor(functions.size(), [&](size_t i) {
+    const CachedFunction& function = functions[i];
+    if (!unchanged.load(std::memory_order_relaxed))
+      return;
+    if (!PowerPC::HostIsInstructionRAMAddress(function.address) ||
+        HashSignatureDB::ComputeCodeChecksum(function.address,
+                                             function.address + function.size - 4) != function.hash)
+    {
+      unchanged = false;
+    }
+  });
+  if (!unchanged)
+    return false;
+
+  std::vector<u32> addresses;
+  addresses.reserve(functions.size());
+  for (const CachedFunction& function : functions)
+    addresses.push_back(function.address);
+  func_db->AddFunctions(addresses);
+
+  for (const CachedFunction& function : functions)
+  {
+    const auto it = func_db->AccessSymbols().find(function.address);
+    if (it != func_db->AccessSymbols().end() && it->second.name != function.name)
+      it->second.Rename(function.name);
+  }
+  return true;
+}
+
+static void SaveFunctionCache(const std::string& path, u32 startAddr, u32 endAddr,
+                              const PPCSymbolDB& func_db)
+{
+  std::string text;
+  for (const auto& entry : func_db.Symbols())
+  {
+    const Common::Symbol& function = entry.second;
+    if (function.type != Common::Symbol::Type::Function || function.size == 0 ||
+        function.address < startAddr || function.address >= endAddr)
+    {
+      continue;
+    }
+    text += fmt::format("{:08x} {:08x} {:08x} {}\n", function.address, function.size,
+                        function.hash, function.name);
+  }
+
+  if (!File::CreateFullPath(path) || !File::WriteStringToFile(path, text))
+    WARN_LOG(SYMBOLS, "Could not write the function cache %s", path.c_str());
+}
+
+void FindFunctionsCached(u32 startAddr, u32 endAddr, PPCSymbolDB* func_db)
+{
+  if (SConfig::GetInstance().GetGameID().empty())
+  {
+    FindFunctions(startAddr, endAddr, func_db);
+    return;
+  }
+
+  const std::string path = GetFunctionCachePath(startAddr, endAddr);
+  if (LoadFunctionCache(path, func_db))
+  {
+    INFO_LOG(SYMBOLS, "Loaded the functions from %s", path.c_str());
+    AnalyzeFoundFunctions(func_db);
+    return;
+  }
+
+  FindFunctions(startAddr, endAddr, func_db);
+  SaveFunctionCache(path, startAddr, endAddr, *func_db);
+}
+
 static bool isCmp(const CodeOp& a)
 {
   return (a.inst.OPCD == 10 || a.inst.OPCD == 11) ||
@@ -674,11 +830,13 @@ void PPCAnalyzer::SetInstructionStats(CodeBlock* block, CodeOp* code, const Gekk
   }
 }
 
-bool PPCAnalyzer::IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instructions)
+bool PPCAnalyzer::IsBusyWaitLoop(CodeOp* code, size_t instructions)
 {
   // Very basic algorithm to detect busy wait loops:
-  //   * It loops to itself and does not contain any other branches.
-  //   * It does not write to memory.
+  //   * It is a short run of instructions ending in a branch back to its start, which doesn't
+  //     have to be the start of the block. Other branches may only leave the loop.
+  //   * It does not write to memory. Reading from RAM or MMIO (polling a flag) is fine, and so
+  //     is reading the timebase.
   //   * It only reads from registers it wrote to earlier in the loop, or it
   //     does not write to these registers.
   //
@@ -686,17 +844,35 @@ bool PPCAnalyzer::IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instruct
   // used busy loops are DSP register interactions, which are bl/cmp/bne
   // (with the bl target a pure function that follows the above rules). We
   // don't detect these at the moment.
+  const u32 loop_start = code[instructions].branchTo;
+  size_t first = instructions;
+  while (code[first].address != loop_start)
+  {
+    if (first == 0 || instructions - first >= MAX_BUSY_WAIT_LOOP_INSTRUCTIONS)
+      return false;
+    first--;
+  }
+
   std::bitset<32> write_disallowed_regs;
   std::bitset<32> written_regs;
-  for (size_t i = 0; i <= instructions; ++i)
+  for (size_t i = first; i <= instructions; ++i)
   {
+    const UGeckoInstruction inst = code[i].inst;
     if (code[i].opinfo->type == OpType::Branch)
     {
       if (code[i].branchUsesCtr)
         return false;
-      if (code[i].branchTo == block->m_address && i == instructions)
+      if (i == instructions)
         return true;
     }
+    else if (code[i].opinfo->type == OpType::System)
+    {
+      // Ordering barriers, which MMIO polling loops are often full of, and reading the timebase
+      const bool barrier = inst.OPCD == 31 && (inst.SUBOP10 == 598 || inst.SUBOP10 == 854);
+      const bool mftb = inst.OPCD == 31 && inst.SUBOP10 == 371;
+      if (!barrier && !mftb)
+        return false;
+    }
     else if (code[i].opinfo->type != OpType::Integer && code[i].opinfo->type != OpType::Load)
     {
       // In the future, some subsets of other instruction types might get
@@ -704,24 +880,18 @@ bool PPCAnalyzer::IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instruct
       // restricted instruction set.
       return false;
     }
-    else
+
+    for (int reg : code[i].regsIn)
     {
-      for (int reg : code[i].regsIn)
-      {
-        if (reg == -1)
-          continue;
-        if (written_regs[reg])
-          continue;
-        write_disallowed_regs[reg] = true;
-      }
-      for (int reg : code[i].regsOut)
-      {
-        if (reg == -1)
-          continue;
-        if (write_disallowed_regs[reg])
-          return false;
-        written_regs[reg] = true;
-      }
+      if (written_regs[reg])
+        continue;
+      write_disallowed_regs[reg] = true;
+    }
+    for (int reg : code[i].regsOut)
+    {
+      if (write_disallowed_regs[reg])
+        return false;
+      written_regs[reg] = true;
     }
   }
   return false;
@@ -875,14 +1045,28 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std:
       }
     }
 
+    if (conditional_continue && HasOption(OPTION_TAKEN_BRANCH_FOLLOW) && inst.OPCD == 16 &&
+        !inst.LK && code[i].branchTo > address && block_size > 1 &&
+        numFollows < BRANCH_FOLLOWING_THRESHOLD && m_taken_branch_hints &&
+        m_taken_branch_hints->count(address))
+    {
+      // Only forward branches, so that a loop never gets unrolled into its own block
+      follow = true;
+      code[i].branchFollowTaken = true;
+    }
+
     code[i].branchIsIdleLoop =
-        code[i].branchTo == block->m_address && IsBusyWaitLoop(block, code, i);
+        code[i].branchTo != INVALID_BRANCH_TARGET && code[i].branchTo <= code[i].address &&
+        IsBusyWaitLoop(code, i);
 
     if (follow && numFollows < BRANCH_FOLLOWING_THRESHOLD)
     {
-      // Follow the unconditional branch.
+      // Follow the unconditional branch, or the conditional one that is usually taken.
       numFollows++;
       address = code[i].branchTo;
+      // As with conditional continues, the matching CALL/RET pair can't be guaranteed past here
+      if (code[i].branchFollowTaken)
+        found_call = false;
     }
     else
     {
@@ -916,7 +1100,9 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std:
   // Scan for flag dependencies; assume the next block (or any branch that can leave the block)
   // wants flags, to be safe.
   bool wantsCR0 = true, wantsCR1 = true, wantsFPRF = true, wantsCA = true;
-  BitSet32 fprInUse, gprInUse, gprInReg, fprInXmm;
+  BitSet32 fprInUse, gprInUse, gprInReg, fprInXmm, gprDiscardable;
+  // Breakpoints can stop the block before any instruction
+  const bool can_discard = !SConfig::GetInstance().bEnableDebugging;
   for (int i = block->m_num_instructions - 1; i >= 0; i--)
   {
     CodeOp& op = code[i];
@@ -941,8 +1127,17 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std:
     op.fprInUse = fprInUse;
     op.gprInReg = gprInReg;
     op.fprInXmm = fprInXmm;
-    // TODO: if there's no possible endblocks or exceptions in between, tell the regcache
-    // we can throw away a register if it's going to be overwritten later.
+    // Loads and stores can raise exceptions, the gather pipe is checked right after stores, and
+    // HLE hooks read registers from memory. Anything else that leaves the block ends it.
+    const bool can_leave = !can_discard || op.canEndBlock ||
+                           (op.opinfo->flags & (FL_LOADSTORE | FL_USE_FPU)) ||
+                           (i > 0 && (code[i - 1].opinfo->flags & FL_LOADSTORE)) ||
+                           HLE::GetFunctionIndex(op.address) != 0;
+    if (can_leave)
+      gprDiscardable = BitSet32{};
+    else
+      gprDiscardable = (gprDiscardable | op.regsOut) & ~op.regsIn;
+    op.gprDiscardable = gprDiscardable;
     gprInUse |= op.regsIn;
     gprInReg |= op.regsIn;
     fprInUse |= op.fregsIn;
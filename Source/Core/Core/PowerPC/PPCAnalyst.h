@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <set>
+#include <unordered_set>
 #include <vector>
 
 #include "Common/BitSet.h"
@@ -35,6 +36,8 @@ struct CodeOp  // 16B
   bool isBranchTarget;
   bool branchUsesCtr;
   bool branchIsIdleLoop;
+  // A conditional branch whose target the block carries on at. Not taking it leaves the block.
+  bool branchFollowTaken;
   bool wantsCR0;
   bool wantsCR1;
   bool wantsFPRF;
@@ -52,6 +55,9 @@ struct CodeOp  // 16B
   BitSet32 gprInUse;
   // just because a register is in use doesn't mean we actually need or want it in an x86 register.
   BitSet32 gprInReg;
+  // registers whose current value is overwritten before anything reads it, with no way out of
+  // the block in between. These don't need writing back when they get evicted.
+  BitSet32 gprDiscardable;
   // we do double stores from GPRs, so we don't want to load a PowerPC floating point register into
   // an XMM only to move it again to a GPR afterwards.
   BitSet32 fprInXmm;
@@ -195,12 +201,19 @@ public:
 
     // Reorder cror instructions next to their associated fcmp.
     OPTION_CROR_MERGE = (1 << 6),
+
+    // Follow forward conditional branches that were nearly always taken while the code was being
+    // interpreted, so that the hot path ends up in one block. See SetTakenBranchHints.
+    // Requires JIT support to be enabled.
+    OPTION_TAKEN_BRANCH_FOLLOW = (1 << 7),
   };
 
   // Option setting/getting
   void SetOption(AnalystOption option) { m_options |= option; }
   void ClearOption(AnalystOption option) { m_options &= ~(option); }
   bool HasOption(AnalystOption option) const { return !!(m_options & option); }
+  // Addresses of conditional branches that are usually taken. The set is owned by the caller.
+  void SetTakenBranchHints(const std::unordered_set<u32>* hints) { m_taken_branch_hints = hints; }
   u32 Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std::size_t block_size);
 
 private:
@@ -214,13 +227,17 @@ private:
   void ReorderInstructionsCore(u32 instructions, CodeOp* code, bool reverse, ReorderType type);
   void ReorderInstructions(u32 instructions, CodeOp* code);
   void SetInstructionStats(CodeBlock* block, CodeOp* code, const GekkoOPInfo* opinfo, u32 index);
-  bool IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instructions);
+  bool IsBusyWaitLoop(CodeOp* code, size_t instructions);
 
   // Options
   u32 m_options = 0;
+  const std::unordered_set<u32>* m_taken_branch_hints = nullptr;
 };
 
 void FindFunctions(u32 startAddr, u32 endAddr, PPCSymbolDB* func_db);
+// Same as FindFunctions, but remembers the functions it found for the running game, and finds
+// them again without scanning the next time as long as their code is unchanged
+void FindFunctionsCached(u32 startAddr, u32 endAddr, PPCSymbolDB* func_db);
 bool AnalyzeFunction(u32 startAddr, Common::Symbol& func, u32 max_size = 0);
 bool ReanalyzeFunction(u32 start_addr, Common::Symbol& func, u32 max_size = 0);
 
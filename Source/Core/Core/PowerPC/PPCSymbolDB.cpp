@@ -16,6 +16,7 @@
 #include "Common/File.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
+#include "Common/ThreadPool.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PowerPC.h"
@@ -47,6 +48,40 @@ Common::Symbol* PPCSymbolDB::AddFunction(u32 start_addr)
   return ptr;
 }
 
+void PPCSymbolDB::AddFunctions(const std::vector<u32>& start_addrs)
+{
+  std::vector<u32> new_addrs;
+  for (const u32 start_addr : start_addrs)
+  {
+    if (m_functions.find(start_addr) == m_functions.end())
+      new_addrs.push_back(start_addr);
+  }
+  std::sort(new_addrs.begin(), new_addrs.end());
+  new_addrs.erase(std::unique(new_addrs.begin(), new_addrs.end()), new_addrs.end());
+
+  // Analysis only reads memory, so the functions can be analyzed independently. Inserting them
+  // stays on this thread.
+  constexpr size_t FUNCTIONS_PER_JOB = 256;
+  std::vector<Common::Symbol> symbols(new_addrs.size());
+  std::vector<char> analyzed(new_addrs.size());
+  Common::ThreadPool::ParallelFor(
+      (new_addrs.size() + FUNCTIONS_PER_JOB - 1) / FUNCTIONS_PER_JOB, [&](size_t job) {
+        const size_t end = std::min(new_addrs.size(), (job + 1) * FUNCTIONS_PER_JOB);
+        for (size_t i = job * FUNCTIONS_PER_JOB; i < end; ++i)
+          analyzed[i] = PPCAnalyst::AnalyzeFunction(new_addrs[i], symbols[i]);
+      });
+
+  for (size_t i = 0; i < new_addrs.size(); ++i)
+  {
+    if (!analyzed[i])
+      continue;
+
+    Common::Symbol* ptr = &(m_functions[new_addrs[i]] = std::move(symbols[i]));
+    ptr->type = Common::Symbol::Type::Function;
+    m_checksum_to_function[ptr->hash].insert(ptr);
+  }
+}
+
 void PPCSymbolDB::AddKnownSymbol(u32 startAddr, u32 size, const std::string& name,
                                  Common::Symbol::Type type)
 {
@@ -21,6 +21,8 @@ public:
   ~PPCSymbolDB() override;
 
   Common::Symbol* AddFunction(u32 start_addr) override;
+  // Same as calling AddFunction for each address, but analyzes the functions in parallel
+  void AddFunctions(const std::vector<u32>& start_addrs);
   void AddKnownSymbol(u32 startAddr, u32 size, const std::string& name,
                       Common::Symbol::Type type = Common::Symbol::Type::Function);
 
@@ -187,6 +187,23 @@ void LogCompiledInstructions()
     }
   }
 
+  std::vector<const GekkoOPInfo*> fallbacks;
+  for (size_t i = 0; i < m_numInstructions; i++)
+  {
+    if (m_allInstructions[i]->fallbackCount > 0)
+      fallbacks.push_back(m_allInstructions[i]);
+  }
+  std::sort(fallbacks.begin(), fallbacks.end(), [](const GekkoOPInfo* a, const GekkoOPInfo* b) {
+    return a->fallbackCount > b->fallbackCount;
+  });
+
+  f.Open(fmt::format("{}inst_fallback{}.txt", File::GetUserPath(D_LOGS_IDX), time), "w");
+  for (const GekkoOPInfo* info : fallbacks)
+  {
+    fprintf(f.GetHandle(), "%s\t%i\t%i\n", info->opname, info->fallbackCount,
+            info->compileCount);
+  }
+
 #ifdef OPLOG
   f.Open(fmt::format("{}" OP_TO_LOG "_at{}.txt", File::GetUserPath(D_LOGS_IDX), time), "w");
   for (auto& rsplocation : rsplocations)
@@ -38,6 +38,7 @@ static CPUCoreBase* s_cpu_core_base = nullptr;
 static bool s_cpu_core_base_is_injected = false;
 Interpreter* const s_interpreter = Interpreter::getInstance();
 static CoreMode s_mode = CoreMode::Interpreter;
+static u64 s_exception_count = 0;
 
 BreakPoints breakpoints;
 MemChecks memchecks;
@@ -544,7 +545,10 @@ void CheckExceptions()
   else
   {
     CheckExternalExceptions();
+    return;
   }
+
+  ++s_exception_count;
 }
 
 void CheckExternalExceptions()
@@ -596,9 +600,18 @@ void CheckExternalExceptions()
       DEBUG_ASSERT_MSG(POWERPC, 0, "Unknown EXT interrupt: Exceptions == %08x", exceptions);
       ERROR_LOG(POWERPC, "Unknown EXTERNAL INTERRUPT exception: Exceptions == %08x", exceptions);
     }
+
+    // Every interrupt that was taken has been cleared
+    if (ppcState.Exceptions != exceptions)
+      ++s_exception_count;
   }
 }
 
+u64 GetExceptionCount()
+{
+  return s_exception_count;
+}
+
 void CheckBreakPoints()
 {
   if (PowerPC::breakpoints.IsAddressBreakPoint(PC))
@@ -204,6 +204,8 @@ void InjectExternalCPUCore(CPUCoreBase* core);
 void SingleStep();
 void CheckExceptions();
 void CheckExternalExceptions();
+// Number of exceptions and interrupts taken. Not part of savestates.
+u64 GetExceptionCount();
 void CheckBreakPoints();
 void RunLoop();
 
@@ -6,6 +6,7 @@
 
 #include <cstddef>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -26,9 +27,25 @@ struct BlockStat
 
   bool operator<(const BlockStat& other) const { return cost > other.cost; }
 };
+// The blocks of a guest function, as found in the symbol DB
+struct FunctionStat
+{
+  FunctionStat(u32 _addr, std::string _name) : addr(_addr), name(std::move(_name)) {}
+  // Blocks outside of any known function get an entry of their own
+  u32 addr;
+  std::string name;
+  u64 cost = 0;
+  u64 tick_counter = 0;
+  // Sum of the run counts of the blocks, not the number of calls
+  u64 run_count = 0;
+  u32 num_blocks = 0;
+
+  bool operator<(const FunctionStat& other) const { return tick_counter > other.tick_counter; }
+};
 struct ProfileStats
 {
   std::vector<BlockStat> block_stats;
+  std::vector<FunctionStat> function_stats;
   u64 cost_sum;
   u64 timecost_sum;
   u64 countsPerSec;
@@ -11,6 +11,7 @@
 #include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
@@ -102,15 +103,11 @@ bool GetRefs(MEGASignature* sig, std::istringstream* iss)
   return true;
 }
 
-bool Compare(u32 address, u32 size, const MEGASignature& sig)
+bool Compare(const std::vector<u32>& code, const MEGASignature& sig)
 {
-  if (size != sig.code.size() * sizeof(u32))
-    return false;
-
   for (size_t i = 0; i < sig.code.size(); ++i)
   {
-    if (sig.code[i] != 0 &&
-        PowerPC::HostRead_U32(static_cast<u32>(address + i * sizeof(u32))) != sig.code[i])
+    if (sig.code[i] != 0 && code[i] != sig.code[i])
       return false;
   }
   return true;
@@ -123,6 +120,7 @@ MEGASignatureDB::~MEGASignatureDB() = default;
 void MEGASignatureDB::Clear()
 {
   m_signatures.clear();
+  m_signatures_by_length.clear();
 }
 
 bool MEGASignatureDB::Load(const std::string& file_path)
@@ -141,6 +139,7 @@ bool MEGASignatureDB::Load(const std::string& file_path)
 
     if (GetCode(&sig, &iss) && GetName(&sig, &iss) && GetRefs(&sig, &iss))
     {
+      m_signatures_by_length[sig.code.size()].push_back(m_signatures.size());
       m_signatures.push_back(std::move(sig));
     }
     else
@@ -159,12 +158,27 @@ bool MEGASignatureDB::Save(const std::string& file_path) const
 
 void MEGASignatureDB::Apply(PPCSymbolDB* symbol_db) const
 {
+  std::vector<u32> code;
   for (auto& it : symbol_db->AccessSymbols())
   {
     auto& symbol = it.second;
-    for (const auto& sig : m_signatures)
+    if (symbol.size % sizeof(u32) != 0)
+      continue;
+
+    // Only signatures of the same length can match, so most symbols are skipped without reading
+    // their code
+    const auto candidates = m_signatures_by_length.find(symbol.size / sizeof(u32));
+    if (candidates == m_signatures_by_length.end())
+      continue;
+
+    code.resize(symbol.size / sizeof(u32));
+    for (size_t i = 0; i < code.size(); ++i)
+      code[i] = PowerPC::HostRead_U32(static_cast<u32>(symbol.address + i * sizeof(u32)));
+
+    for (const size_t index : candidates->second)
     {
-      if (Compare(symbol.address, symbol.size, sig))
+      const MEGASignature& sig = m_signatures[index];
+      if (Compare(code, sig))
       {
         symbol.name = sig.name;
         INFO_LOG(SYMBOLS, "Found %s at %08x (size: %08x)!", sig.name.c_str(), symbol.address,
@@ -4,7 +4,9 @@
 
 #pragma once
 
+#include <cstddef>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -54,4 +56,6 @@ public:
 
 private:
   std::vector<MEGASignature> m_signatures;
+  // Indices into m_signatures by code length in instructions, in file order
+  std::unordered_map<size_t, std::vector<size_t>> m_signatures_by_length;
 };
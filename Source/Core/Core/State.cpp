@@ -4,8 +4,12 @@
 
 #include "Core/State.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <lzo/lzo1x.h>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -13,16 +17,19 @@
 #include <vector>
 
 #include <fmt/format.h>
+#include <zstd.h>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Event.h"
 #include "Common/File.h"
 #include "Common/FileUtil.h"
+#include "Common/MappedFile.h"
 #include "Common/MsgHandler.h"
 #include "Common/ScopeGuard.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
+#include "Common/Trace.h"
 #include "Common/Version.h"
 
 #include "Core/ConfigManager.h"
@@ -31,12 +38,15 @@
 #include "Core/GeckoCode.h"
 #include "Core/HW/HW.h"
 #include "Core/HW/Memmap.h"
+#include "Core/HW/SystemTimers.h"
 #include "Core/HW/Wiimote.h"
 #include "Core/Host.h"
 #include "Core/Movie.h"
 #include "Core/NetPlayClient.h"
 #include "Core/PowerPC/PowerPC.h"
 
+#include "DiscIO/MultithreadedCompressor.h"
+
 #include "VideoCommon/FrameDump.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoBackendBase.h"
@@ -60,6 +70,21 @@ static unsigned char __LZO_MMODEL out[OUT_LEN];
 
 static HEAP_ALLOC(wrkmem, LZO1X_1_MEM_COMPRESS);
 
+// A StateHeader size of this value means that the state is split into chunks that are compressed
+// independently with zstd, so that they can be compressed and decompressed in parallel. A
+// ChunkedStateHeader follows the StateHeader, and each chunk is stored as its compressed size
+// followed by the compressed data. Any other non-zero size means the legacy LZO stream.
+constexpr u32 CHUNKED_STATE_MARKER = 0xFFFFFFFF;
+constexpr u32 STATE_CHUNK_SIZE = 4 * 1024 * 1024;
+constexpr int STATE_ZSTD_LEVEL = 1;
+
+struct ChunkedStateHeader
+{
+  u64 uncompressed_size;
+  u32 chunk_size;
+  u32 chunk_count;
+};
+
 static AfterLoadCallbackFunc s_on_after_load_callback;
 
 // Temporary undo state buffer
@@ -73,8 +98,16 @@ static Common::Event g_compressAndDumpStateSyncEvent;
 
 static std::thread g_save_thread;
 
+// While saving a snapshot, the offset of each top-level section gets recorded here
+static std::vector<u32>* s_snapshot_sections;
+static const u8* s_snapshot_start;
+
+// The size of the last state that was saved. A state usually has the same size as the one before
+// it, so it is written straight into a buffer of that size, and only measured when it didn't fit.
+static size_t s_last_state_size = 0;
+
 // Don't forget to increase this after doing changes on the savestate system
-constexpr u32 STATE_VERSION = 120;  // Last changed in PR 8904
+constexpr u32 STATE_VERSION = 122;  // Last changed when DTK decoding moved to the DVD thread
 
 // Maps savestate versions to Dolphin versions.
 // Versions after 42 don't need to be added to this list,
@@ -148,8 +181,16 @@ static bool DoStateVersion(PointerWrap& p, std::string* version_created_by)
   return true;
 }
 
+static void MarkSection(PointerWrap& p)
+{
+  if (s_snapshot_sections && p.GetMode() == PointerWrap::MODE_WRITE)
+    s_snapshot_sections->push_back(static_cast<u32>(*p.ptr - s_snapshot_start));
+}
+
 static void DoState(PointerWrap& p)
 {
+  MarkSection(p);
+
   std::string version_created_by;
   if (!DoStateVersion(p, &version_created_by))
   {
@@ -199,17 +240,26 @@ static void DoState(PointerWrap& p)
 
   // Begin with video backend, so that it gets a chance to clear its caches and writeback modified
   // things to RAM
+  MarkSection(p);
   g_video_backend->DoState(p);
   p.DoMarker("video_backend");
 
+  MarkSection(p);
   PowerPC::DoState(p);
   p.DoMarker("PowerPC");
   // CoreTiming needs to be restored before restoring Hardware because
   // the controller code might need to schedule an event if the controller has changed.
+  MarkSection(p);
   CoreTiming::DoState(p);
   p.DoMarker("CoreTiming");
+  // The Vanguard step is re-armed rather than restored, so that states made before it existed, or
+  // with a different step period, keep stepping.
+  if (p.GetMode() == PointerWrap::MODE_READ)
+    SystemTimers::ScheduleVanguardStep();
+  MarkSection(p);
   HW::DoState(p);
   p.DoMarker("HW");
+  MarkSection(p);
   if (SConfig::GetInstance().bWii)
     Wiimote::DoState(p);
   p.DoMarker("Wiimote");
@@ -221,6 +271,43 @@ static void DoState(PointerWrap& p)
 #endif
 }
 
+// Saves the state into the buffer and resizes it to fit. Returns false if the save was aborted.
+// NOTE: CPU Thread
+static bool SaveToVector(std::vector<u8>& buffer, std::vector<u32>* sections)
+{
+  if (s_last_state_size == 0)
+  {
+    u8* ptr = nullptr;
+    PointerWrap p(&ptr, PointerWrap::MODE_MEASURE);
+    DoState(p);
+    s_last_state_size = reinterpret_cast<size_t>(ptr);
+  }
+
+  while (true)
+  {
+    buffer.resize(s_last_state_size);
+    u8* const start = buffer.data();
+    u8* ptr = start;
+    PointerWrap p(&ptr, PointerWrap::MODE_WRITE);
+    p.SetWriteEnd(start + buffer.size());
+
+    if (sections)
+      sections->clear();
+    s_snapshot_sections = sections;
+    s_snapshot_start = start;
+    DoState(p);
+    s_snapshot_sections = nullptr;
+    s_snapshot_start = nullptr;
+
+    s_last_state_size = static_cast<size_t>(ptr - start);
+    if (!p.WriteOverflowed())
+    {
+      buffer.resize(s_last_state_size);
+      return p.GetMode() == PointerWrap::MODE_WRITE;
+    }
+  }
+}
+
 void LoadFromBuffer(std::vector<u8>& buffer)
 {
   if (NetPlay::IsNetPlayRunning())
@@ -240,17 +327,20 @@ void LoadFromBuffer(std::vector<u8>& buffer)
 
 void SaveToBuffer(std::vector<u8>& buffer)
 {
-  Core::RunOnCPUThread(
-      [&] {
-        u8* ptr = nullptr;
-        PointerWrap p(&ptr, PointerWrap::MODE_MEASURE);
+  Core::RunOnCPUThread([&] { SaveToVector(buffer, nullptr); }, true);
+}
 
-        DoState(p);
-        const size_t buffer_size = reinterpret_cast<size_t>(ptr);
-        buffer.resize(buffer_size);
+void SaveToSnapshot(Snapshot& snapshot)
+{
+  Core::RunOnCPUThread([&] { SaveToVector(snapshot.buffer, &snapshot.sections); }, true);
+}
 
-        ptr = &buffer[0];
-        p.SetMode(PointerWrap::MODE_WRITE);
+void LoadFromSnapshot(const Snapshot& snapshot)
+{
+  Core::RunOnCPUThread(
+      [&] {
+        u8* ptr = const_cast<u8*>(snapshot.buffer.data());
+        PointerWrap p(&ptr, PointerWrap::MODE_READ);
         DoState(p);
       },
       true);
@@ -311,8 +401,154 @@ struct CompressAndDumpState_args
   bool wait;
 };
 
+namespace
+{
+struct ZstdCompressContextDeleter
+{
+  void operator()(ZSTD_CCtx* context) const { ZSTD_freeCCtx(context); }
+};
+
+struct ZstdDecompressContextDeleter
+{
+  void operator()(ZSTD_DCtx* context) const { ZSTD_freeDCtx(context); }
+};
+
+struct ChunkCompressState
+{
+  std::unique_ptr<ZSTD_CCtx, ZstdCompressContextDeleter> context;
+};
+
+struct Chunk
+{
+  const u8* data;
+  size_t size;
+};
+}  // Anonymous namespace
+
+static bool WriteChunkedState(File::IOFile& f, const u8* data, size_t size)
+{
+  const ChunkedStateHeader chunked_header{
+      size, STATE_CHUNK_SIZE,
+      static_cast<u32>((size + STATE_CHUNK_SIZE - 1) / STATE_CHUNK_SIZE)};
+  if (!f.WriteArray(&chunked_header, 1))
+    return false;
+
+  using DiscIO::ConversionResult;
+  using DiscIO::ConversionResultCode;
+
+  DiscIO::MultithreadedCompressor<ChunkCompressState, Chunk, std::vector<u8>> compressor(
+      [](ChunkCompressState* state) {
+        state->context.reset(ZSTD_createCCtx());
+        return state->context ? ConversionResultCode::Success :
+                                ConversionResultCode::InternalError;
+      },
+      [](ChunkCompressState* state, Chunk chunk) -> ConversionResult<std::vector<u8>> {
+        std::vector<u8> compressed(ZSTD_compressBound(chunk.size));
+        const size_t result =
+            ZSTD_compressCCtx(state->context.get(), compressed.data(), compressed.size(),
+                              chunk.data, chunk.size, STATE_ZSTD_LEVEL);
+        if (ZSTD_isError(result))
+          return ConversionResultCode::InternalError;
+
+        compressed.resize(result);
+        return compressed;
+      },
+      [&f](std::vector<u8> compressed) {
+        const u32 compressed_size = static_cast<u32>(compressed.size());
+        if (!f.WriteArray(&compressed_size, 1) ||
+            !f.WriteBytes(compressed.data(), compressed.size()))
+        {
+          return ConversionResultCode::WriteFailed;
+        }
+        return ConversionResultCode::Success;
+      });
+
+  for (size_t offset = 0; offset < size; offset += STATE_CHUNK_SIZE)
+  {
+    compressor.CompressAndWrite({data + offset, std::min<size_t>(STATE_CHUNK_SIZE, size - offset)});
+    if (compressor.GetStatus() != ConversionResultCode::Success)
+      break;
+  }
+
+  compressor.Shutdown();
+  return compressor.GetStatus() == ConversionResultCode::Success;
+}
+
+// Reads a chunked state whose data (everything after the StateHeader) is already in memory
+static bool ReadChunkedState(const u8* data, size_t size, std::vector<u8>& buffer)
+{
+  ChunkedStateHeader chunked_header;
+  if (size < sizeof(chunked_header))
+    return false;
+  std::memcpy(&chunked_header, data, sizeof(chunked_header));
+  if (chunked_header.chunk_size == 0)
+    return false;
+
+  const u8* compressed = data + sizeof(chunked_header);
+  const size_t compressed_size_total = size - sizeof(chunked_header);
+
+  // Find where each chunk starts so that they can all be decompressed at once
+  std::vector<Chunk> chunks;
+  chunks.reserve(chunked_header.chunk_count);
+  for (size_t offset = 0; offset + sizeof(u32) <= compressed_size_total;)
+  {
+    u32 compressed_size;
+    std::memcpy(&compressed_size, compressed + offset, sizeof(u32));
+    offset += sizeof(u32);
+    if (compressed_size > compressed_size_total - offset)
+      return false;
+
+    chunks.push_back({compressed + offset, compressed_size});
+    offset += compressed_size;
+  }
+
+  const u64 uncompressed_size = chunked_header.uncompressed_size;
+  const u64 chunk_size = chunked_header.chunk_size;
+  if (chunks.size() != chunked_header.chunk_count ||
+      (uncompressed_size + chunk_size - 1) / chunk_size != chunks.size())
+  {
+    return false;
+  }
+
+  buffer.resize(uncompressed_size);
+
+  std::atomic<size_t> next_chunk{0};
+  std::atomic<bool> success{true};
+  const auto decompress_chunks = [&] {
+    std::unique_ptr<ZSTD_DCtx, ZstdDecompressContextDeleter> context(ZSTD_createDCtx());
+    if (!context)
+    {
+      success = false;
+      return;
+    }
+
+    for (size_t i = next_chunk++; i < chunks.size() && success; i = next_chunk++)
+    {
+      const u64 offset = i * chunk_size;
+      const size_t expected_size =
+          static_cast<size_t>(std::min<u64>(chunk_size, buffer.size() - offset));
+      const size_t result = ZSTD_decompressDCtx(context.get(), buffer.data() + offset,
+                                                expected_size, chunks[i].data, chunks[i].size);
+      if (result != expected_size)
+        success = false;
+    }
+  };
+
+  const size_t thread_count =
+      std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), chunks.size());
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < thread_count; ++i)
+    threads.emplace_back(decompress_chunks);
+  decompress_chunks();
+  for (std::thread& thread : threads)
+    thread.join();
+
+  return success;
+}
+
 static void CompressAndDumpState(CompressAndDumpState_args save_args)
 {
+  TRACE_SCOPE("State::CompressAndDumpState");
   std::lock_guard<std::mutex> lk(*save_args.buffer_mutex);
 
   // ScopeGuard is used here to ensure that g_compressAndDumpStateSyncEvent.Set()
@@ -364,39 +600,17 @@ static void CompressAndDumpState(CompressAndDumpState_args save_args)
   // Setting up the header
   StateHeader header{};
   SConfig::GetInstance().GetGameID().copy(header.gameID, std::size(header.gameID));
-  header.size = g_use_compression ? (u32)buffer_size : 0;
+  header.size = g_use_compression ? CHUNKED_STATE_MARKER : 0;
   header.time = Common::Timer::GetDoubleTime();
 
   f.WriteArray(&header, 1);
 
   if (header.size != 0)  // non-zero header size means the state is compressed
   {
-    lzo_uint i = 0;
-    while (true)
+    if (!WriteChunkedState(f, buffer_data, buffer_size))
     {
-      lzo_uint32 cur_len = 0;
-      lzo_uint out_len = 0;
-
-      if ((i + IN_LEN) >= buffer_size)
-      {
-        cur_len = (lzo_uint32)(buffer_size - i);
-      }
-      else
-      {
-        cur_len = IN_LEN;
-      }
-
-      if (lzo1x_1_compress(buffer_data + i, cur_len, out, &out_len, wrkmem) != LZO_E_OK)
-        PanicAlertT("Internal LZO Error - compression failed");
-
-      // The size of the data to write is 'out_len'
-      f.WriteArray((lzo_uint32*)&out_len, 1);
-      f.WriteBytes(out, out_len);
-
-      if (cur_len != IN_LEN)
-        break;
-
-      i += cur_len;
+      Core::DisplayMessage("Could not save state", 2000);
+      return;
     }
   }
   else  // uncompressed
@@ -413,26 +627,19 @@ void SaveAs(const std::string& filename, bool wait)
   if (s_load_or_save_in_progress)
     return;
 
+  TRACE_SCOPE("State::SaveAs");
+
   s_load_or_save_in_progress = true;
 
   Core::RunOnCPUThread(
       [&] {
-        // Measure the size of the buffer.
-        u8* ptr = nullptr;
-        PointerWrap p(&ptr, PointerWrap::MODE_MEASURE);
-        DoState(p);
-        const size_t buffer_size = reinterpret_cast<size_t>(ptr);
-
-        // Then actually do the write.
+        bool saved;
         {
           std::lock_guard<std::mutex> lk(g_cs_current_buffer);
-          g_current_buffer.resize(buffer_size);
-          ptr = &g_current_buffer[0];
-          p.SetMode(PointerWrap::MODE_WRITE);
-          DoState(p);
+          saved = SaveToVector(g_current_buffer, nullptr);
         }
 
-        if (p.GetMode() == PointerWrap::MODE_WRITE)
+        if (saved)
         {
           Core::DisplayMessage("Saving State...", 1000);
 
@@ -457,6 +664,31 @@ void SaveAs(const std::string& filename, bool wait)
   s_load_or_save_in_progress = false;
 }
 
+void SaveBufferAs(const std::string& filename, std::vector<u8> buffer, bool wait)
+{
+  if (buffer.empty())
+    return;
+
+  Core::RunOnCPUThread(
+      [&] {
+        Flush();
+        {
+          std::lock_guard<std::mutex> lk(g_cs_current_buffer);
+          g_current_buffer = std::move(buffer);
+        }
+
+        CompressAndDumpState_args save_args;
+        save_args.buffer_vector = &g_current_buffer;
+        save_args.buffer_mutex = &g_cs_current_buffer;
+        save_args.filename = filename;
+        save_args.wait = wait;
+
+        g_save_thread = std::thread(CompressAndDumpState, save_args);
+        g_compressAndDumpStateSyncEvent.Wait();
+      },
+      true);
+}
+
 bool ReadHeader(const std::string& filename, StateHeader& header)
 {
   Flush();
@@ -484,73 +716,100 @@ std::string GetInfoStringOfSlot(int slot, bool translate)
   return Common::Timer::GetDateTimeFormatted(header.time);
 }
 
-static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_data)
+// The contents of a state file, ready to be handed to DoState. Uncompressed states are read in
+// place from the mapped file, while compressed ones are decompressed into the buffer.
+struct StateFileData
+{
+  File::MappedFile file;
+  std::vector<u8> buffer;
+  const u8* data = nullptr;
+  size_t size = 0;
+};
+
+static bool LoadFileStateData(const std::string& filename, StateFileData& ret_data)
 {
   Flush();
-  File::IOFile f(filename, "rb");
-  if (!f)
+  File::MappedFile& f = ret_data.file;
+  if (!f.Open(filename))
   {
     Core::DisplayMessage("State not found", 2000);
-    return;
+    return false;
   }
 
   StateHeader header;
-  f.ReadArray(&header, 1);
+  if (f.GetSize() < sizeof(header))
+  {
+    Core::DisplayMessage("The savestate could not be loaded", 2000);
+    return false;
+  }
+  std::memcpy(&header, f.GetData(), sizeof(header));
 
   if (strncmp(SConfig::GetInstance().GetGameID().c_str(), header.gameID, 6))
   {
     Core::DisplayMessage(fmt::format("State belongs to a different game (ID {})",
                                      std::string_view{header.gameID, std::size(header.gameID)}),
                          2000);
-    return;
+    return false;
   }
 
-  std::vector<u8> buffer;
+  const u8* const data = f.GetData() + sizeof(header);
+  const size_t size = f.GetSize() - sizeof(header);
 
-  if (header.size != 0)  // non-zero size means the state is compressed
+  if (header.size == 0)  // uncompressed
+  {
+    ret_data.data = data;
+    ret_data.size = size;
+    return true;
+  }
+
+  if (header.size == CHUNKED_STATE_MARKER)
+  {
+    // Chunks are decompressed straight from the mapping into the returned buffer
+    if (!ReadChunkedState(data, size, ret_data.buffer))
+    {
+      Core::DisplayMessage("The savestate could not be decompressed", 2000);
+      return false;
+    }
+  }
+  else  // LZO compressed
   {
     //Narrysmod - Don't show this message
     //Core::DisplayMessage("Decompressing State...", 500);
 
+    std::vector<u8>& buffer = ret_data.buffer;
     buffer.resize(header.size);
 
     lzo_uint i = 0;
-    while (true)
+    size_t offset = 0;
+    while (offset + sizeof(lzo_uint32) <= size)
     {
-      lzo_uint32 cur_len = 0;  // number of bytes to read
-      lzo_uint new_len = 0;    // number of bytes to write
+      lzo_uint32 cur_len = 0;                // number of bytes to read
+      lzo_uint new_len = buffer.size() - i;  // number of bytes that may be written
 
-      if (!f.ReadArray(&cur_len, 1))
+      std::memcpy(&cur_len, data + offset, sizeof(cur_len));
+      offset += sizeof(cur_len);
+      if (cur_len > size - offset)
         break;
 
-      f.ReadBytes(out, cur_len);
-      const int res = lzo1x_decompress(out, cur_len, &buffer[i], &new_len, nullptr);
+      const int res = lzo1x_decompress_safe(data + offset, cur_len, buffer.data() + i, &new_len,
+                                            nullptr);
       if (res != LZO_E_OK)
       {
         // This doesn't seem to happen anymore.
         PanicAlertT("Internal LZO Error - decompression failed (%d) (%li, %li) \n"
                     "Try loading the state again",
                     res, i, new_len);
-        return;
+        return false;
       }
 
+      offset += cur_len;
       i += new_len;
     }
   }
-  else  // uncompressed
-  {
-    const size_t size = (size_t)(f.GetSize() - sizeof(StateHeader));
-    buffer.resize(size);
 
-    if (!f.ReadBytes(&buffer[0], size))
-    {
-      PanicAlert("wtf? reading bytes: %zu", size);
-      return;
-    }
-  }
-
-  // all good
-  ret_data.swap(buffer);
+  ret_data.data = ret_data.buffer.data();
+  ret_data.size = ret_data.buffer.size();
+  return true;
 }
 
 void LoadAs(const std::string& filename)
@@ -565,6 +824,8 @@ void LoadAs(const std::string& filename)
     return;
   }
 
+  TRACE_SCOPE("State::LoadAs");
+
   s_load_or_save_in_progress = true;
 
   Core::RunOnCPUThread(
@@ -583,14 +844,13 @@ void LoadAs(const std::string& filename)
         bool loaded = false;
         bool loadedSuccessfully = false;
 
-        // brackets here are so buffer gets freed ASAP
+        // brackets here are so the mapping and buffer get freed ASAP
         {
-          std::vector<u8> buffer;
-          LoadFileStateData(filename, buffer);
-
-          if (!buffer.empty())
+          StateFileData state_data;
+          if (LoadFileStateData(filename, state_data) && state_data.size != 0)
           {
-            u8* ptr = &buffer[0];
+            // DoState only reads through the pointer in MODE_READ
+            u8* ptr = const_cast<u8*>(state_data.data);
             PointerWrap p(&ptr, PointerWrap::MODE_READ);
             DoState(p);
             loaded = true;
@@ -641,6 +901,8 @@ void Shutdown()
 {
   Flush();
 
+  s_last_state_size = 0;
+
   // swapping with an empty vector, rather than clear()ing
   // this gives a better guarantee to free the allocated memory right NOW (as opposed to, actually,
   // never)
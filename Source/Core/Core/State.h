@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Core/StateDelta.h"
 
 namespace State
 {
@@ -50,6 +51,17 @@ void LoadAs(const std::string& filename);
 void SaveToBuffer(std::vector<u8>& buffer);
 void LoadFromBuffer(std::vector<u8>& buffer);
 
+// Like SaveToBuffer, but also records where each section starts so the result can be used with
+// CreateDelta/ApplyDelta.
+void SaveToSnapshot(Snapshot& snapshot);
+// Unlike LoadFromBuffer, this is allowed during netplay, since rolling back loads the same state
+// on every player's side.
+void LoadFromSnapshot(const Snapshot& snapshot);
+
+// Writes a state produced by SaveToBuffer out as a regular state file. Unless wait is set, the
+// compression and file I/O happen on the save thread.
+void SaveBufferAs(const std::string& filename, std::vector<u8> buffer, bool wait = false);
+
 void LoadLastSaved(int i = 1);
 void SaveFirstSaved();
 void UndoSaveState();
@@ -0,0 +1,114 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/StateDelta.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "Common/Assert.h"
+
+namespace State
+{
+namespace
+{
+struct Section
+{
+  u32 start;
+  u32 end;
+};
+
+std::vector<Section> GetSections(const std::vector<u32>& starts, size_t size)
+{
+  std::vector<Section> sections;
+  if (starts.empty())
+  {
+    sections.push_back({0, static_cast<u32>(size)});
+    return sections;
+  }
+
+  for (size_t i = 0; i < starts.size(); ++i)
+  {
+    const u32 end = i + 1 < starts.size() ? starts[i + 1] : static_cast<u32>(size);
+    sections.push_back({starts[i], end});
+  }
+  return sections;
+}
+
+u32 GetPageEnd(const std::vector<Section>& sections, u32 offset)
+{
+  const auto it = std::upper_bound(sections.begin(), sections.end(), offset,
+                                   [](u32 value, const Section& s) { return value < s.end; });
+  ASSERT(it != sections.end());
+  return std::min(offset + DELTA_PAGE_SIZE, it->end);
+}
+}  // Anonymous namespace
+
+Delta CreateDelta(const Snapshot& base, const Snapshot& snapshot)
+{
+  const std::vector<Section> base_sections = GetSections(base.sections, base.buffer.size());
+  const std::vector<Section> sections = GetSections(snapshot.sections, snapshot.buffer.size());
+
+  Delta delta;
+  delta.size = static_cast<u32>(snapshot.buffer.size());
+  delta.sections = snapshot.sections;
+
+  for (size_t i = 0; i < sections.size(); ++i)
+  {
+    const Section& section = sections[i];
+    const u32 base_length =
+        i < base_sections.size() ? base_sections[i].end - base_sections[i].start : 0;
+
+    for (u32 offset = section.start; offset < section.end; offset += DELTA_PAGE_SIZE)
+    {
+      const u32 length = std::min(DELTA_PAGE_SIZE, section.end - offset);
+      const u32 relative = offset - section.start;
+      const u8* page = snapshot.buffer.data() + offset;
+
+      if (relative + length <= base_length &&
+          std::memcmp(page, base.buffer.data() + base_sections[i].start + relative, length) == 0)
+      {
+        continue;
+      }
+
+      delta.page_offsets.push_back(offset);
+      delta.page_data.insert(delta.page_data.end(), page, page + length);
+    }
+  }
+
+  return delta;
+}
+
+Snapshot ApplyDelta(const Snapshot& base, const Delta& delta)
+{
+  const std::vector<Section> base_sections = GetSections(base.sections, base.buffer.size());
+  const std::vector<Section> sections = GetSections(delta.sections, delta.size);
+
+  Snapshot snapshot;
+  snapshot.buffer.resize(delta.size);
+  snapshot.sections = delta.sections;
+
+  // Start from the base and then patch in the pages that changed. Anything past the end of the
+  // matching base section is always stored in the delta.
+  for (size_t i = 0; i < sections.size() && i < base_sections.size(); ++i)
+  {
+    const u32 length = std::min(sections[i].end - sections[i].start,
+                                base_sections[i].end - base_sections[i].start);
+    std::memcpy(snapshot.buffer.data() + sections[i].start,
+                base.buffer.data() + base_sections[i].start, length);
+  }
+
+  const u8* data = delta.page_data.data();
+  for (const u32 offset : delta.page_offsets)
+  {
+    const u32 length = GetPageEnd(sections, offset) - offset;
+    std::memcpy(snapshot.buffer.data() + offset, data, length);
+    data += length;
+  }
+  ASSERT(data == delta.page_data.data() + delta.page_data.size());
+
+  return snapshot;
+}
+}  // namespace State
@@ -0,0 +1,38 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// Delta savestates: a state stored as just the pages that differ from a full base state.
+
+#pragma once
+
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace State
+{
+constexpr u32 DELTA_PAGE_SIZE = 0x1000;
+
+// A serialised state along with the offsets at which each top-level DoState section starts.
+// Sections are diffed independently, so a section changing length (a few more CoreTiming events,
+// say) doesn't throw off the page alignment of the RAM that follows it.
+struct Snapshot
+{
+  std::vector<u8> buffer;
+  std::vector<u32> sections;
+};
+
+struct Delta
+{
+  u32 size = 0;
+  std::vector<u32> sections;
+  // Offsets into the rebuilt state of every page that differs from the base, and their contents.
+  // Pages are counted from the start of their section, so the last page of a section may be short.
+  std::vector<u32> page_offsets;
+  std::vector<u8> page_data;
+};
+
+Delta CreateDelta(const Snapshot& base, const Snapshot& snapshot);
+Snapshot ApplyDelta(const Snapshot& base, const Delta& delta);
+}  // namespace State
@@ -0,0 +1,255 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "DiscIO/CachedBlob.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "Common/Align.h"
+#include "DiscIO/Blob.h"
+#include "DiscIO/VolumeWii.h"
+
+namespace DiscIO
+{
+// Formats without blocks are cached in lines of this size. Lines are at least one Wii cluster,
+// since the emulated drive rarely reads less than that.
+constexpr u32 DEFAULT_LINE_SIZE = 0x20000;
+constexpr u32 MIN_LINE_SIZE = VolumeWii::BLOCK_TOTAL_SIZE;
+constexpr u32 MAX_LINE_SIZE = 0x200000;
+
+constexpr u64 CACHE_SIZE = 0x2000000;
+constexpr u64 MIN_CACHE_LINES = 8;
+constexpr u64 MAX_CACHE_LINES = 256;
+
+constexpr u64 READ_AHEAD_SIZE = 0x400000;
+// A read is only considered sequential if it starts in the line where the previous one ended, or
+// in the line after it. Read-ahead starts after this many reads in a row have been.
+constexpr u32 SEQUENTIAL_READS_FOR_READ_AHEAD = 2;
+
+static u64 GetNumCacheLines(u32 line_size)
+{
+  return std::clamp<u64>(CACHE_SIZE / line_size, MIN_CACHE_LINES, MAX_CACHE_LINES);
+}
+
+static u32 GetNumReadAheadLines(u32 line_size)
+{
+  // Leave at least half of the cache for lines that have been read, so that the read-ahead can't
+  // evict the lines that are about to be used.
+  return static_cast<u32>(
+      std::clamp<u64>(READ_AHEAD_SIZE / line_size, 1, GetNumCacheLines(line_size) / 2));
+}
+
+CachedBlobReader::CachedBlobReader(std::unique_ptr<BlobReader> blob_reader, u32 line_size)
+    : m_blob_reader(std::move(blob_reader)), m_line_size(line_size),
+      m_read_ahead_lines(GetNumReadAheadLines(line_size)), m_load_buffer(line_size),
+      m_cache(GetNumCacheLines(line_size))
+{
+  for (CacheLine& line : m_cache)
+    line.data.resize(line_size);
+
+  m_read_ahead_thread.Reset([this](ReadAheadRequest request) { ReadAhead(request); });
+}
+
+CachedBlobReader::~CachedBlobReader()
+{
+  // The queued read-aheads are still taken off the queue while the thread is joined, but they
+  // won't be read.
+  m_shutting_down.Set();
+}
+
+std::unique_ptr<CachedBlobReader> CachedBlobReader::Create(std::unique_ptr<BlobReader> blob_reader)
+{
+  if (!blob_reader)
+    return nullptr;
+
+  // Lines are made of whole blocks, so that a compressed block is only ever decompressed once
+  // while it's cached.
+  const u64 block_size = blob_reader->GetBlockSize();
+  u32 line_size = DEFAULT_LINE_SIZE;
+  if (block_size >= MIN_LINE_SIZE)
+    line_size = static_cast<u32>(std::min<u64>(block_size, MAX_LINE_SIZE));
+  else if (block_size != 0)
+    line_size = static_cast<u32>(Common::AlignUp<u64>(MIN_LINE_SIZE, block_size));
+
+  return std::unique_ptr<CachedBlobReader>(
+      new CachedBlobReader(std::move(blob_reader), line_size));
+}
+
+u32 CachedBlobReader::GetLineSize(u64 space) const
+{
+  if (space == RAW_SPACE || m_line_size % VolumeWii::BLOCK_TOTAL_SIZE != 0)
+    return m_line_size;
+
+  // Keep the decrypted lines lined up with the encrypted blocks they come from.
+  return m_line_size / VolumeWii::BLOCK_TOTAL_SIZE * VolumeWii::BLOCK_DATA_SIZE;
+}
+
+bool CachedBlobReader::Read(u64 offset, u64 size, u8* out_ptr)
+{
+  return ReadCached(RAW_SPACE, offset, size, out_ptr);
+}
+
+bool CachedBlobReader::ReadWiiDecrypted(u64 offset, u64 size, u8* out_ptr,
+                                        u64 partition_data_offset)
+{
+  if (!SupportsReadWiiDecrypted())
+    return false;
+
+  return ReadCached(partition_data_offset, offset, size, out_ptr);
+}
+
+bool CachedBlobReader::ReadCached(u64 space, u64 offset, u64 size, u8* out_ptr)
+{
+  if (size == 0)
+    return true;
+
+  const u32 line_size = GetLineSize(space);
+  UpdateReadAhead(space, offset / line_size, (offset + size - 1) / line_size + 1);
+
+  while (size > 0)
+  {
+    const u64 index = offset / line_size;
+    const u64 line_offset = offset % line_size;
+    const u64 bytes_to_read = std::min(line_size - line_offset, size);
+
+    bool copied;
+    {
+      std::lock_guard lk(m_cache_mutex);
+      copied = CopyFromCache(space, index, line_offset, bytes_to_read, out_ptr);
+    }
+    if (!copied && LoadCacheLine(space, index))
+    {
+      std::lock_guard lk(m_cache_mutex);
+      copied = CopyFromCache(space, index, line_offset, bytes_to_read, out_ptr);
+    }
+    if (!copied)
+    {
+      // The line can't be cached as a whole, so only read what was asked for.
+      std::lock_guard lk(m_blob_mutex);
+      if (!ReadFromBlob(space, offset, bytes_to_read, out_ptr))
+        return false;
+    }
+
+    offset += bytes_to_read;
+    size -= bytes_to_read;
+    out_ptr += bytes_to_read;
+  }
+
+  return true;
+}
+
+void CachedBlobReader::UpdateReadAhead(u64 space, u64 first_index, u64 end_index)
+{
+  const bool sequential = space == m_last_space && first_index + 1 >= m_last_end_index &&
+                          first_index <= m_last_end_index;
+  m_last_space = space;
+  m_last_end_index = end_index;
+
+  if (!sequential)
+  {
+    m_sequential_reads = 0;
+    m_read_ahead_end_index = 0;
+    return;
+  }
+
+  if (++m_sequential_reads < SEQUENTIAL_READS_FOR_READ_AHEAD)
+    return;
+
+  // Only queue the lines that haven't been queued by an earlier read.
+  const u64 target_end_index = end_index + m_read_ahead_lines;
+  for (u64 i = std::max(end_index, m_read_ahead_end_index); i < target_end_index; i++)
+    m_read_ahead_thread.EmplaceItem(ReadAheadRequest{space, i});
+  m_read_ahead_end_index = std::max(m_read_ahead_end_index, target_end_index);
+}
+
+void CachedBlobReader::ReadAhead(ReadAheadRequest request)
+{
+  if (m_shutting_down.IsSet())
+    return;
+
+  LoadCacheLine(request.space, request.index);
+}
+
+bool CachedBlobReader::CopyFromCache(u64 space, u64 index, u64 line_offset, u64 size,
+                                     u8* out_ptr)
+{
+  for (CacheLine& line : m_cache)
+  {
+    if (!line.valid || line.space != space || line.index != index)
+      continue;
+
+    if (line_offset + size > line.size)
+      return false;
+
+    std::copy_n(line.data.begin() + line_offset, size, out_ptr);
+    line.last_used = ++m_use_counter;
+    return true;
+  }
+
+  return false;
+}
+
+CachedBlobReader::CacheLine* CachedBlobReader::GetEmptyCacheLine()
+{
+  CacheLine* oldest = &m_cache[0];
+  for (CacheLine& line : m_cache)
+  {
+    if (!line.valid)
+      return &line;
+    if (line.last_used < oldest->last_used)
+      oldest = &line;
+  }
+  return oldest;
+}
+
+bool CachedBlobReader::LoadCacheLine(u64 space, u64 index)
+{
+  std::lock_guard blob_lock(m_blob_mutex);
+
+  {
+    std::lock_guard cache_lock(m_cache_mutex);
+    for (const CacheLine& line : m_cache)
+    {
+      // Read by the other thread while this one was waiting for the blob.
+      if (line.valid && line.space == space && line.index == index)
+        return true;
+    }
+  }
+
+  const u32 line_size = GetLineSize(space);
+  const u64 offset = index * line_size;
+  u64 size = line_size;
+  if (space == RAW_SPACE && m_blob_reader->IsDataSizeAccurate())
+  {
+    const u64 data_size = m_blob_reader->GetDataSize();
+    if (offset >= data_size)
+      return false;
+    size = std::min(size, data_size - offset);
+  }
+
+  if (!ReadFromBlob(space, offset, size, m_load_buffer.data()))
+    return false;
+
+  std::lock_guard cache_lock(m_cache_mutex);
+  CacheLine* line = GetEmptyCacheLine();
+  std::swap(line->data, m_load_buffer);
+  line->space = space;
+  line->index = index;
+  line->size = static_cast<u32>(size);
+  line->valid = true;
+  line->last_used = ++m_use_counter;
+  return true;
+}
+
+bool CachedBlobReader::ReadFromBlob(u64 space, u64 offset, u64 size, u8* out_ptr)
+{
+  if (space == RAW_SPACE)
+    return m_blob_reader->Read(offset, size, out_ptr);
+
+  return m_blob_reader->ReadWiiDecrypted(offset, size, out_ptr, space);
+}
+
+}  // namespace DiscIO
@@ -0,0 +1,118 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Flag.h"
+#include "Common/WorkQueueThread.h"
+#include "DiscIO/Blob.h"
+
+namespace DiscIO
+{
+// Reads another blob in whole lines of one or more of its blocks, and keeps the most recently
+// used lines in memory. When the reads look sequential, the lines after them are read on a worker
+// thread before they are asked for, so that slow storage and the decompression of compressed
+// formats overlap with emulation instead of stalling the thread that reads the disc.
+class CachedBlobReader final : public BlobReader
+{
+public:
+  static std::unique_ptr<CachedBlobReader> Create(std::unique_ptr<BlobReader> blob_reader);
+  ~CachedBlobReader() override;
+
+  BlobType GetBlobType() const override { return m_blob_reader->GetBlobType(); }
+
+  u64 GetRawSize() const override { return m_blob_reader->GetRawSize(); }
+  u64 GetDataSize() const override { return m_blob_reader->GetDataSize(); }
+  bool IsDataSizeAccurate() const override { return m_blob_reader->IsDataSizeAccurate(); }
+
+  u64 GetBlockSize() const override { return m_blob_reader->GetBlockSize(); }
+  bool HasFastRandomAccessInBlock() const override
+  {
+    return m_blob_reader->HasFastRandomAccessInBlock();
+  }
+  std::string GetCompressionMethod() const override
+  {
+    return m_blob_reader->GetCompressionMethod();
+  }
+
+  bool Read(u64 offset, u64 size, u8* out_ptr) override;
+
+  bool SupportsReadWiiDecrypted() const override
+  {
+    return m_blob_reader->SupportsReadWiiDecrypted();
+  }
+  bool ReadWiiDecrypted(u64 offset, u64 size, u8* out_ptr, u64 partition_data_offset) override;
+
+private:
+  // Raw reads, and the decrypted reads of each partition, are cached as separate address spaces.
+  // Decrypted address spaces are identified by their partition_data_offset.
+  static constexpr u64 RAW_SPACE = std::numeric_limits<u64>::max();
+
+  struct CacheLine
+  {
+    u64 space = RAW_SPACE;
+    u64 index = 0;
+    u64 last_used = 0;
+    u32 size = 0;
+    bool valid = false;
+    std::vector<u8> data;
+  };
+
+  struct ReadAheadRequest
+  {
+    u64 space;
+    u64 index;
+  };
+
+  CachedBlobReader(std::unique_ptr<BlobReader> blob_reader, u32 line_size);
+
+  u32 GetLineSize(u64 space) const;
+
+  bool ReadCached(u64 space, u64 offset, u64 size, u8* out_ptr);
+  void UpdateReadAhead(u64 space, u64 first_index, u64 end_index);
+  void ReadAhead(ReadAheadRequest request);
+
+  // Needs m_cache_mutex to be held.
+  bool CopyFromCache(u64 space, u64 index, u64 line_offset, u64 size, u8* out_ptr);
+  CacheLine* GetEmptyCacheLine();
+
+  // Takes both locks. Returns false if the whole line couldn't be read, which happens at the end
+  // of the disc or a partition.
+  bool LoadCacheLine(u64 space, u64 index);
+
+  // Needs m_blob_mutex to be held.
+  bool ReadFromBlob(u64 space, u64 offset, u64 size, u8* out_ptr);
+
+  std::unique_ptr<BlobReader> m_blob_reader;
+  const u32 m_line_size;
+  const u32 m_read_ahead_lines;
+
+  // The wrapped blob isn't thread-safe, so this is held for every read from it. It's always
+  // taken before m_cache_mutex.
+  std::mutex m_blob_mutex;
+  std::vector<u8> m_load_buffer;
+
+  std::mutex m_cache_mutex;
+  std::vector<CacheLine> m_cache;
+  u64 m_use_counter = 0;
+
+  // Only touched by the thread that calls Read and ReadWiiDecrypted.
+  u64 m_last_space = RAW_SPACE;
+  u64 m_last_end_index = 0;
+  u32 m_sequential_reads = 0;
+  u64 m_read_ahead_end_index = 0;
+
+  Common::Flag m_shutting_down;
+  // Declared last, so that it's joined before anything it uses is destroyed.
+  Common::WorkQueueThread<ReadAheadRequest> m_read_ahead_thread;
+};
+
+}  // namespace DiscIO
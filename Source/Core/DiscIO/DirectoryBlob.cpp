@@ -8,9 +8,11 @@
 #include <array>
 #include <cinttypes>
 #include <cstring>
+#include <list>
 #include <locale>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <utility>
@@ -62,6 +64,38 @@ constexpr u8 ENTRY_SIZE = 0x0c;
 constexpr u8 FILE_ENTRY = 0;
 constexpr u8 DIRECTORY_ENTRY = 1;
 
+bool OpenFileCache::Read(const std::string& path, u64 offset, u64 size, u8* buffer)
+{
+  std::lock_guard lk(m_mutex);
+
+  auto it = std::find_if(m_files.begin(), m_files.end(),
+                         [&path](const OpenFile& open_file) { return open_file.path == path; });
+  if (it != m_files.end())
+  {
+    m_files.splice(m_files.begin(), m_files, it);
+  }
+  else
+  {
+    File::IOFile file(path, "rb");
+    if (!file)
+      return false;
+
+    if (m_files.size() >= MAX_OPEN_FILES)
+      m_files.pop_back();
+    m_files.push_front(OpenFile{path, std::move(file)});
+  }
+
+  File::IOFile& file = m_files.front().file;
+  if (!file.Seek(offset, SEEK_SET) || !file.ReadBytes(buffer, size))
+  {
+    // Don't keep a file around in an unknown state
+    m_files.pop_front();
+    return false;
+  }
+
+  return true;
+}
+
 DiscContent::DiscContent(u64 offset, u64 size, const std::string& path)
     : m_offset(offset), m_size(size), m_content_source(path)
 {
@@ -96,7 +130,7 @@ u64 DiscContent::GetSize() const
   return m_size;
 }
 
-bool DiscContent::Read(u64* offset, u64* length, u8** buffer) const
+bool DiscContent::Read(u64* offset, u64* length, u8** buffer, OpenFileCache* open_files) const
 {
   if (m_size == 0)
     return true;
@@ -110,9 +144,11 @@ bool DiscContent::Read(u64* offset, u64* length, u8** buffer) const
 
     if (std::holds_alternative<std::string>(m_content_source))
     {
-      File::IOFile file(std::get<std::string>(m_content_source), "rb");
-      if (!file.Seek(offset_in_content, SEEK_SET) || !file.ReadBytes(*buffer, bytes_to_read))
+      if (!open_files->Read(std::get<std::string>(m_content_source), offset_in_content,
+                            bytes_to_read, *buffer))
+      {
         return false;
+      }
     }
     else if (std::holds_alternative<const u8*>(m_content_source))
     {
@@ -180,7 +216,7 @@ bool DiscContentContainer::Read(u64 offset, u64 length, u8* buffer) const
     // Zero fill to start of DiscContent data
     PadToAddress(it->GetOffset(), &offset, &length, &buffer);
 
-    if (!it->Read(&offset, &length, &buffer))
+    if (!it->Read(&offset, &length, &buffer, m_open_files.get()))
       return false;
 
     ++it;
@@ -6,8 +6,10 @@
 
 #include <array>
 #include <cstddef>
+#include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <string>
@@ -15,6 +17,7 @@
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/File.h"
 #include "Common/FileUtil.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/WiiEncryptionCache.h"
@@ -22,7 +25,6 @@
 namespace File
 {
 struct FSTEntry;
-class IOFile;
 }  // namespace File
 
 namespace DiscIO
@@ -34,6 +36,28 @@ class DirectoryBlobReader;
 // Returns true if the path is inside a DirectoryBlob and doesn't represent the DirectoryBlob itself
 bool ShouldHideFromGameList(const std::string& volume_path);
 
+// Keeps the most recently read host files open, so that a game which reads a file in many small
+// pieces doesn't make us open and close it for every one of them.
+class OpenFileCache
+{
+public:
+  // Seeks to offset in the file at path and reads size bytes from it
+  bool Read(const std::string& path, u64 offset, u64 size, u8* buffer);
+
+private:
+  static constexpr size_t MAX_OPEN_FILES = 16;
+
+  struct OpenFile
+  {
+    std::string path;
+    File::IOFile file;
+  };
+
+  std::mutex m_mutex;
+  // The most recently used file is first
+  std::list<OpenFile> m_files;
+};
+
 class DiscContent
 {
 public:
@@ -53,7 +77,7 @@ public:
   u64 GetOffset() const;
   u64 GetEndOffset() const;
   u64 GetSize() const;
-  bool Read(u64* offset, u64* length, u8** buffer) const;
+  bool Read(u64* offset, u64* length, u8** buffer, OpenFileCache* open_files) const;
 
   bool operator==(const DiscContent& other) const { return GetEndOffset() == other.GetEndOffset(); }
   bool operator!=(const DiscContent& other) const { return !(*this == other); }
@@ -86,6 +110,8 @@ public:
 
 private:
   std::set<DiscContent> m_contents;
+  // Behind a pointer, since std::mutex would otherwise make this type immovable
+  std::unique_ptr<OpenFileCache> m_open_files = std::make_unique<OpenFileCache>();
 };
 
 class DirectoryBlobPartition
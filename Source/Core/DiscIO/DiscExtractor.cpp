@@ -6,13 +6,18 @@
 
 #include <algorithm>
 #include <cinttypes>
+#include <condition_variable>
 #include <locale>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/File.h"
 #include "Common/FileUtil.h"
 #include "Common/StringUtil.h"
+#include "Common/WorkQueueThread.h"
 #include "DiscIO/Enums.h"
 #include "DiscIO/Filesystem.h"
 #include "DiscIO/Volume.h"
@@ -127,10 +132,80 @@ bool ExportFile(const Volume& volume, const Partition& partition, std::string_vi
   return ExportFile(volume, partition, file_system->FindFileInfo(path).get(), export_filename);
 }
 
-void ExportDirectory(const Volume& volume, const Partition& partition, const FileInfo& directory,
-                     bool recursive, const std::string& filesystem_path,
-                     const std::string& export_folder,
-                     const std::function<bool(const std::string& path)>& update_progress)
+namespace
+{
+constexpr size_t EXPORT_CHUNK_SIZE = 0x800000;
+constexpr size_t EXPORT_MAX_PENDING_SIZE = 0x4000000;
+
+struct ExportedFile
+{
+  File::IOFile file;
+  std::string path;
+  // Only touched by the writer thread once the file has been opened
+  bool failed = false;
+};
+
+struct PendingFile
+{
+  const FileInfo* file_info;
+  std::string path;
+  std::string export_path;
+};
+
+// Writes the exported data on a thread of its own, so that reading and decrypting the next chunk
+// doesn't have to wait for the disk. Submit blocks while too much data is waiting to be written.
+class ExportWriter
+{
+public:
+  ExportWriter() : m_thread([this](WriteJob job) { Write(std::move(job)); }) {}
+
+  void Submit(std::shared_ptr<ExportedFile> file, std::vector<u8> data)
+  {
+    {
+      std::unique_lock lk(m_mutex);
+      m_done.wait(lk, [this, &data] {
+        return m_pending_size == 0 || m_pending_size + data.size() <= EXPORT_MAX_PENDING_SIZE;
+      });
+      m_pending_size += data.size();
+    }
+    m_thread.EmplaceItem(WriteJob{std::move(file), std::move(data)});
+  }
+
+private:
+  struct WriteJob
+  {
+    std::shared_ptr<ExportedFile> file;
+    std::vector<u8> data;
+  };
+
+  void Write(WriteJob job)
+  {
+    if (!job.file->failed && !job.file->file.WriteBytes(job.data.data(), job.data.size()))
+    {
+      job.file->failed = true;
+      ERROR_LOG(DISCIO, "Could not export %s", job.file->path.c_str());
+    }
+
+    {
+      std::lock_guard lk(m_mutex);
+      m_pending_size -= job.data.size();
+    }
+    m_done.notify_one();
+  }
+
+  std::mutex m_mutex;
+  std::condition_variable m_done;
+  size_t m_pending_size = 0;
+  // Declared last so that it finishes the queued writes before the rest goes away
+  Common::WorkQueueThread<WriteJob> m_thread;
+};
+
+// Creates the directories and lists the files that have to be exported. Returns false if the
+// extraction got cancelled.
+bool CollectFiles(const FileInfo& directory, bool recursive, const std::string& filesystem_path,
+                  const std::string& export_folder,
+                  const std::function<bool(const std::string& path)>& update_progress,
+                  std::vector<PendingFile>* files)
 {
   File::CreateFullPath(export_folder + '/');
 
@@ -140,21 +215,76 @@ void ExportDirectory(const Volume& volume, const Partition& partition, const Fil
     const std::string path = filesystem_path + name;
     const std::string export_path = export_folder + '/' + name;
 
+    if (!file_info.IsDirectory())
+    {
+      if (File::Exists(export_path))
+        NOTICE_LOG(DISCIO, "%s already exists", export_path.c_str());
+      files->push_back({&file_info, path, export_path});
+      continue;
+    }
+
     if (update_progress(path))
-      return;
+      return false;
 
     DEBUG_LOG(DISCIO, "%s", export_path.c_str());
 
-    if (!file_info.IsDirectory())
+    if (recursive && !CollectFiles(file_info, recursive, path, export_path, update_progress, files))
+      return false;
+  }
+
+  return true;
+}
+}  // Anonymous namespace
+
+void ExportDirectory(const Volume& volume, const Partition& partition, const FileInfo& directory,
+                     bool recursive, const std::string& filesystem_path,
+                     const std::string& export_folder,
+                     const std::function<bool(const std::string& path)>& update_progress)
+{
+  std::vector<PendingFile> files;
+  if (!CollectFiles(directory, recursive, filesystem_path, export_folder, update_progress, &files))
+    return;
+
+  // Going through the disc front to back keeps the reads sequential, and lets every encrypted
+  // group be decrypted once instead of once per file that it holds a part of
+  std::stable_sort(files.begin(), files.end(), [](const PendingFile& a, const PendingFile& b) {
+    return a.file_info->GetOffset() < b.file_info->GetOffset();
+  });
+
+  ExportWriter writer;
+  for (const PendingFile& pending : files)
+  {
+    if (update_progress(pending.path))
+      return;
+
+    if (File::Exists(pending.export_path))
+      continue;
+
+    DEBUG_LOG(DISCIO, "%s", pending.export_path.c_str());
+
+    auto exported = std::make_shared<ExportedFile>();
+    exported->path = pending.export_path;
+    if (!exported->file.Open(pending.export_path, "wb"))
     {
-      if (File::Exists(export_path))
-        NOTICE_LOG(DISCIO, "%s already exists", export_path.c_str());
-      else if (!ExportFile(volume, partition, &file_info, export_path))
-        ERROR_LOG(DISCIO, "Could not export %s", export_path.c_str());
+      ERROR_LOG(DISCIO, "Could not export %s", pending.export_path.c_str());
+      continue;
     }
-    else if (recursive)
+
+    u64 offset = pending.file_info->GetOffset();
+    u64 size = pending.file_info->GetSize();
+    while (size)
     {
-      ExportDirectory(volume, partition, file_info, recursive, path, export_path, update_progress);
+      const size_t read_size = static_cast<size_t>(std::min<u64>(size, EXPORT_CHUNK_SIZE));
+      std::vector<u8> buffer(read_size);
+      if (!volume.Read(offset, read_size, buffer.data(), partition))
+      {
+        ERROR_LOG(DISCIO, "Could not export %s", pending.export_path.c_str());
+        break;
+      }
+
+      writer.Submit(exported, std::move(buffer));
+      size -= read_size;
+      offset += read_size;
     }
   }
 }
@@ -38,6 +38,8 @@ bool ExportFile(const Volume& volume, const Partition& partition, std::string_vi
 // update_progress is called once for each child (file or directory).
 // If update_progress returns true, the extraction gets cancelled.
 // filesystem_path is supposed to be the path corresponding to the directory argument.
+// The directories are created first, and the files are then exported in the order they are
+// stored on the disc.
 void ExportDirectory(const Volume& volume, const Partition& partition, const FileInfo& directory,
                      bool recursive, const std::string& filesystem_path,
                      const std::string& export_folder,
@@ -4,16 +4,20 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <functional>
-#include <memory>
+#include <map>
+#include <mutex>
+#include <optional>
 #include <thread>
 #include <utility>
 #include <variant>
 #include <vector>
 
 #include "Common/Assert.h"
-#include "Common/Event.h"
 #include "Common/Result.h"
 
 namespace DiscIO
@@ -49,15 +53,14 @@ public:
       std::function<ConversionResultCode(OutputParameters)> output)
       : m_set_up_compress_thread_state(std::move(set_up_compress_thread_state)),
         m_compress(std::move(compress)), m_output(std::move(output)),
-        m_threads(std::max<unsigned int>(1, std::thread::hardware_concurrency()))
+        m_threads(std::max<unsigned int>(1, std::thread::hardware_concurrency())),
+        m_max_items_in_flight(m_threads * ITEMS_IN_FLIGHT_PER_THREAD)
   {
-    m_compress_threads = std::make_unique<CompressThread[]>(m_threads);
-
+    m_compress_threads.reserve(m_threads);
     for (size_t i = 0; i < m_threads; ++i)
     {
-      m_compress_threads[i].thread =
-          std::thread(std::mem_fn(&MultithreadedCompressor::CompressThreadFunction), this,
-                      &m_compress_threads[i]);
+      m_compress_threads.emplace_back(
+          std::mem_fn(&MultithreadedCompressor::CompressThreadFunction), this);
     }
 
     m_output_thread =
@@ -75,15 +78,13 @@ public:
     if (GetStatus() != ConversionResultCode::Success)
       return;
 
-    CompressThread& compress_thread = m_compress_threads[m_current_index];
+    std::unique_lock lock(m_mutex);
 
-    compress_thread.compress_ready_event.Wait();
-    compress_thread.compress_parameters = std::move(parameters);
-    compress_thread.compress_event.Set();
+    m_space_available.wait(
+        lock, [this] { return m_next_input_index - m_next_output_index < m_max_items_in_flight; });
 
-    ++m_current_index;
-    if (m_current_index >= m_threads)
-      m_current_index -= m_threads;
+    m_pending_items.push_back(PendingItem{m_next_input_index++, std::move(parameters)});
+    m_item_pending.notify_one();
   }
 
   void SetError(ConversionResultCode result)
@@ -99,42 +100,35 @@ public:
 
   void Shutdown()
   {
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].compress_ready_event.Wait();
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].compress_done_event.Wait();
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].output_ready_event.Wait();
+    {
+      std::unique_lock lock(m_mutex);
+      m_space_available.wait(lock, [this] { return m_next_output_index == m_next_input_index; });
 
-    m_shutting_down.store(true);
+      m_shutting_down.store(true);
+    }
 
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].compress_event.Set();
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].output_event.Set();
+    m_item_pending.notify_all();
+    m_output_available.notify_all();
 
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].thread.join();
+    for (std::thread& thread : m_compress_threads)
+      thread.join();
 
     m_output_thread.join();
   }
 
 private:
-  struct CompressThread
-  {
-    std::thread thread;
-
-    Common::Event compress_ready_event;
-    Common::Event compress_event;
-    Common::Event compress_done_event;
-    Common::Event output_ready_event;
-    Common::Event output_event;
+  // How many items can be queued, being compressed or waiting for the output thread at once.
+  // Results are allowed to pile up for the output thread, so that a compression thread that
+  // finishes early moves on to the next item instead of waiting for a slower one to be written.
+  static constexpr size_t ITEMS_IN_FLIGHT_PER_THREAD = 3;
 
-    CompressParameters compress_parameters;
-    OutputParameters output_parameters;
+  struct PendingItem
+  {
+    size_t index;
+    CompressParameters parameters;
   };
 
-  void CompressThreadFunction(CompressThread* state)
+  void CompressThreadFunction()
   {
     CompressThreadState compress_thread_state;
 
@@ -142,67 +136,75 @@ private:
     if (setup_result != ConversionResultCode::Success)
       SetError(setup_result);
 
-    state->compress_ready_event.Set();
-    state->compress_done_event.Set();
-
     while (true)
     {
-      state->compress_event.Wait();
+      std::unique_lock lock(m_mutex);
+      m_item_pending.wait(lock,
+                          [this] { return m_shutting_down.load() || !m_pending_items.empty(); });
 
       if (m_shutting_down.load())
         return;
 
-      CompressParameters parameters = std::move(state->compress_parameters);
+      PendingItem item = std::move(m_pending_items.front());
+      m_pending_items.pop_front();
 
-      state->compress_done_event.Reset();
-      state->compress_ready_event.Set();
+      lock.unlock();
 
       ConversionResult<OutputParameters> result =
-          m_compress(&compress_thread_state, std::move(parameters));
+          m_compress(&compress_thread_state, std::move(item.parameters));
 
+      // A failed item is still handed to the output thread as an empty result, so that the items
+      // after it aren't left waiting for it
+      std::optional<OutputParameters> output;
       if (result)
-      {
-        state->output_ready_event.Wait();
-        state->output_parameters = std::move(*result);
-        state->output_event.Set();
-      }
+        output = std::move(*result);
       else
-      {
         SetError(result.Error());
-      }
 
-      state->compress_done_event.Set();
+      lock.lock();
+
+      const bool is_next_output = item.index == m_next_output_index;
+      m_finished_items.emplace(item.index, std::move(output));
+
+      lock.unlock();
+
+      if (is_next_output)
+        m_output_available.notify_one();
     }
   }
 
   void OutputThreadFunction()
   {
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].output_ready_event.Set();
-
-    size_t index = 0;
-
     while (true)
     {
-      CompressThread& compress_thread = m_compress_threads[index];
-
-      compress_thread.output_event.Wait();
+      std::unique_lock lock(m_mutex);
+      m_output_available.wait(lock, [this] {
+        return m_shutting_down.load() || m_finished_items.count(m_next_output_index) != 0;
+      });
 
       if (m_shutting_down.load())
         return;
 
-      OutputParameters parameters = std::move(compress_thread.output_parameters);
+      auto it = m_finished_items.find(m_next_output_index);
+      std::optional<OutputParameters> parameters = std::move(it->second);
+      m_finished_items.erase(it);
 
-      compress_thread.output_ready_event.Set();
+      lock.unlock();
 
-      const ConversionResultCode result = m_output(std::move(parameters));
+      if (parameters)
+      {
+        const ConversionResultCode result = m_output(std::move(*parameters));
+
+        if (result != ConversionResultCode::Success)
+          SetError(result);
+      }
 
-      if (result != ConversionResultCode::Success)
-        SetError(result);
+      // Only advance once the output function is done, so that Shutdown waits for it
+      lock.lock();
+      ++m_next_output_index;
+      lock.unlock();
 
-      ++index;
-      if (index >= m_threads)
-        index -= m_threads;
+      m_space_available.notify_all();
     }
   }
 
@@ -211,12 +213,23 @@ private:
       m_compress;
   std::function<ConversionResultCode(OutputParameters)> m_output;
 
-  // We can't use std::vector for this, because Common::Event is not movable
-  std::unique_ptr<CompressThread[]> m_compress_threads;
+  std::vector<std::thread> m_compress_threads;
   std::thread m_output_thread;
 
   const size_t m_threads;
-  size_t m_current_index = 0;
+  const size_t m_max_items_in_flight;
+
+  // Everything below is guarded by m_mutex, except for the atomics
+  std::mutex m_mutex;
+  std::condition_variable m_item_pending;
+  std::condition_variable m_output_available;
+  std::condition_variable m_space_available;
+
+  std::deque<PendingItem> m_pending_items;
+  // The reorder buffer. Its size is bounded by m_max_items_in_flight.
+  std::map<size_t, std::optional<OutputParameters>> m_finished_items;
+  size_t m_next_input_index = 0;
+  size_t m_next_output_index = 0;
 
   std::atomic<ConversionResultCode> m_result = ConversionResultCode::Success;
   std::atomic<bool> m_shutting_down = false;
@@ -8,7 +8,9 @@
 #include <array>
 #include <cinttypes>
 #include <cstring>
+#include <mutex>
 
+#include "Common/Align.h"
 #include "Common/Crypto/AES.h"
 #include "Common/File.h"
 #include "Common/FileUtil.h"
@@ -16,6 +18,7 @@
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
+#include "Common/ThreadPool.h"
 #include "Core/IOS/ES/Formats.h"
 
 namespace DiscIO
@@ -42,6 +45,7 @@ void NANDImporter::ImportNANDBin(const std::string& path_to_bin,
 
   FindSuperblock();
   ProcessEntry(0, nand_root);
+  ExtractFiles();
   ExportKeys(nand_root);
   ExtractCertificates(nand_root);
 }
@@ -169,31 +173,55 @@ void NANDImporter::ProcessDirectory(const NANDFSTEntry& entry, const std::string
 }
 
 void NANDImporter::ProcessFile(const NANDFSTEntry& entry, const std::string& parent_path)
+{
+  m_update_callback();
+  INFO_LOG(DISCIO, "File: %s", FormatDebugString(entry).c_str());
+
+  m_files.push_back(
+      {GetPath(entry, parent_path), Common::swap16(entry.sub), Common::swap32(entry.size)});
+}
+
+void NANDImporter::ExtractFiles()
 {
   constexpr size_t NAND_AES_KEY_OFFSET = 0x158;
   constexpr size_t NAND_FAT_BLOCK_SIZE = 0x4000;
+  // Up to 1 MiB is decrypted before it gets written out
+  constexpr size_t BLOCKS_PER_WRITE = 64;
+
+  // Every cluster is encrypted on its own with a zero IV, so the files can be decrypted in any
+  // order, and on any thread
+  const Common::AES::CBCDecryptor decryptor(&m_nand_keys[NAND_AES_KEY_OFFSET]);
+  std::mutex callback_mutex;
+
+  Common::ThreadPool::ParallelFor(m_files.size(), [&](size_t index) {
+    const PendingFile& pending = m_files[index];
+    File::IOFile file(pending.path, "wb");
+    std::vector<u8> buffer(std::min<size_t>(Common::AlignUp(pending.size, NAND_FAT_BLOCK_SIZE),
+                                            BLOCKS_PER_WRITE * NAND_FAT_BLOCK_SIZE));
+
+    u16 sub = pending.first_block;
+    u32 remaining_bytes = pending.size;
+    while (remaining_bytes > 0)
+    {
+      size_t buffered = 0;
+      while (remaining_bytes > 0 && buffered < buffer.size())
+      {
+        std::array<u8, 16> iv{};
+        decryptor.Decrypt(iv.data(), &m_nand[NAND_FAT_BLOCK_SIZE * sub], &buffer[buffered],
+                          NAND_FAT_BLOCK_SIZE);
+        const u32 size = std::min<u32>(remaining_bytes, NAND_FAT_BLOCK_SIZE);
+        buffered += size;
+        remaining_bytes -= size;
+        sub = Common::swap16(&m_nand[m_nand_fat_offset + 2 * sub]);
+      }
+      file.WriteBytes(buffer.data(), buffered);
+    }
 
-  m_update_callback();
-  INFO_LOG(DISCIO, "File: %s", FormatDebugString(entry).c_str());
+    std::lock_guard lk(callback_mutex);
+    m_update_callback();
+  });
 
-  const std::string path = GetPath(entry, parent_path);
-  File::IOFile file(path, "wb");
-  std::array<u8, 16> key{};
-  std::copy(&m_nand_keys[NAND_AES_KEY_OFFSET], &m_nand_keys[NAND_AES_KEY_OFFSET + key.size()],
-            key.begin());
-  u16 sub = Common::swap16(entry.sub);
-  u32 remaining_bytes = Common::swap32(entry.size);
-
-  while (remaining_bytes > 0)
-  {
-    std::array<u8, 16> iv{};
-    std::vector<u8> block = Common::AES::Decrypt(
-        key.data(), iv.data(), &m_nand[NAND_FAT_BLOCK_SIZE * sub], NAND_FAT_BLOCK_SIZE);
-    u32 size = remaining_bytes < NAND_FAT_BLOCK_SIZE ? remaining_bytes : NAND_FAT_BLOCK_SIZE;
-    file.WriteBytes(block.data(), size);
-    remaining_bytes -= size;
-    sub = Common::swap16(&m_nand[m_nand_fat_offset + 2 * sub]);
-  }
+  m_files.clear();
 }
 
 bool NANDImporter::ExtractCertificates(const std::string& nand_root)
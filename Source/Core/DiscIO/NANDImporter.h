@@ -49,13 +49,23 @@ private:
   void ProcessEntry(u16 entry_number, const std::string& parent_path);
   void ProcessFile(const NANDFSTEntry& entry, const std::string& parent_path);
   void ProcessDirectory(const NANDFSTEntry& entry, const std::string& parent_path);
+  void ExtractFiles();
   void ExportKeys(const std::string& nand_root);
 
+  struct PendingFile
+  {
+    std::string path;
+    u16 first_block;
+    u32 size;
+  };
+
   std::vector<u8> m_nand;
   std::vector<u8> m_nand_keys;
   size_t m_nand_fat_offset = 0;
   size_t m_nand_fst_offset = 0;
   std::function<void()> m_update_callback;
   size_t m_nand_root_length = 0;
+  // Files are only listed while walking the file system, and then extracted all at once
+  std::vector<PendingFile> m_files;
 };
 }  // namespace DiscIO
@@ -16,6 +16,7 @@
 #include "Common/StringUtil.h"
 
 #include "DiscIO/Blob.h"
+#include "DiscIO/CachedBlob.h"
 #include "DiscIO/Enums.h"
 #include "DiscIO/VolumeDisc.h"
 #include "DiscIO/VolumeGC.h"
@@ -66,6 +67,12 @@ std::unique_ptr<VolumeDisc> CreateDisc(const std::string& path)
   return reader ? CreateDisc(reader) : nullptr;
 }
 
+std::unique_ptr<VolumeDisc> CreateCachedDisc(const std::string& path)
+{
+  std::unique_ptr<BlobReader> reader(CachedBlobReader::Create(CreateBlobReader(path)));
+  return reader ? CreateDisc(reader) : nullptr;
+}
+
 static std::unique_ptr<VolumeWAD> CreateWAD(std::unique_ptr<BlobReader>& reader)
 {
   // Check for WAD
@@ -118,7 +118,8 @@ public:
   virtual bool IsDatelDisc() const = 0;
   virtual bool SupportsIntegrityCheck() const { return false; }
   virtual bool CheckH3TableIntegrity(const Partition& partition) const { return false; }
-  virtual bool CheckBlockIntegrity(u64 block_index, const std::vector<u8>& encrypted_data,
+  // encrypted_data must point to a whole block, VolumeWii::BLOCK_TOTAL_SIZE bytes.
+  virtual bool CheckBlockIntegrity(u64 block_index, const u8* encrypted_data,
                                    const Partition& partition) const
   {
     return false;
@@ -165,6 +166,9 @@ protected:
 };
 
 std::unique_ptr<VolumeDisc> CreateDisc(const std::string& path);
+// Like CreateDisc, but the blob is read through a CachedBlobReader. Meant for the disc that the
+// emulated drive reads from.
+std::unique_ptr<VolumeDisc> CreateCachedDisc(const std::string& path);
 std::unique_ptr<VolumeWAD> CreateWAD(const std::string& path);
 std::unique_ptr<Volume> CreateVolume(const std::string& path);
 
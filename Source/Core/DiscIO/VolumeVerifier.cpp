@@ -14,6 +14,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <unordered_set>
 
 #include <mbedtls/md5.h>
@@ -361,7 +362,9 @@ constexpr u64 SL_DVD_R_SIZE = 4707319808;  // Wii RVT-R
 constexpr u64 DL_DVD_SIZE = 8511160320;    // Wii retail
 constexpr u64 DL_DVD_R_SIZE = 8543666176;  // Wii RVT-R
 
-constexpr u64 BLOCK_SIZE = 0x20000;
+// A Wii group, so that reads are large and aligned, and that every read has enough Wii blocks to
+// verify to keep all the hardware threads busy.
+constexpr u64 BLOCK_SIZE = 0x200000;
 
 VolumeVerifier::VolumeVerifier(const Volume& volume, bool redump_verification,
                                Hashes<bool> hashes_to_calculate)
@@ -1105,8 +1108,7 @@ void VolumeVerifier::Process()
 
   IOS::ES::Content content{};
   bool content_read = false;
-  bool block_read = false;
-  u64 bytes_to_read = BLOCK_SIZE;
+  u64 bytes_to_read = BLOCK_SIZE - m_progress % BLOCK_SIZE;
   if (m_content_index < m_content_offsets.size() &&
       m_content_offsets[m_content_index] == m_progress)
   {
@@ -1119,17 +1121,29 @@ void VolumeVerifier::Process()
   {
     bytes_to_read = std::min(bytes_to_read, m_content_offsets[m_content_index] - m_progress);
   }
-  else if (m_block_index < m_blocks.size() && m_blocks[m_block_index].offset == m_progress)
-  {
-    bytes_to_read = VolumeWii::BLOCK_TOTAL_SIZE;
-    block_read = true;
-  }
-  else if (m_block_index < m_blocks.size() && m_blocks[m_block_index].offset > m_progress)
+  bytes_to_read = std::min(bytes_to_read, m_max_progress - m_progress);
+
+  // Blocks are verified from the data that is read, so a read can't end in the middle of one.
+  size_t end_block_index = m_block_index;
+  while (end_block_index < m_blocks.size() &&
+         m_blocks[end_block_index].offset < m_progress + bytes_to_read)
   {
-    bytes_to_read = std::min(bytes_to_read, m_blocks[m_block_index].offset - m_progress);
+    const u64 block_offset = m_blocks[end_block_index].offset;
+    if (block_offset + VolumeWii::BLOCK_TOTAL_SIZE > m_progress + bytes_to_read)
+    {
+      if (block_offset > m_progress)
+      {
+        bytes_to_read = block_offset - m_progress;
+        break;
+      }
+
+      bytes_to_read = std::min(block_offset + VolumeWii::BLOCK_TOTAL_SIZE, m_max_progress) -
+                      m_progress;
+    }
+    end_block_index++;
   }
-  bytes_to_read = std::min(bytes_to_read, m_max_progress - m_progress);
 
+  const bool block_read = end_block_index != m_block_index;
   const bool is_data_needed = m_calculating_any_hash || content_read || block_read;
   const bool read_succeeded = is_data_needed && ReadChunkAndWaitForAsyncOperations(bytes_to_read);
 
@@ -1182,61 +1196,78 @@ void VolumeVerifier::Process()
     m_content_index++;
   }
 
-  if (m_block_index < m_blocks.size() &&
-      m_blocks[m_block_index].offset < m_progress + bytes_to_read)
+  if (block_read)
   {
-    m_block_future = std::async(
+    m_block_future = std::async(std::launch::async, [this, read_succeeded, bytes_to_read,
+                                                     begin = m_block_index, end = end_block_index,
+                                                     progress = m_progress] {
+      VerifyBlocks(begin, end, progress, read_succeeded ? bytes_to_read : 0);
+    });
+
+    m_block_index = end_block_index;
+  }
+
+  m_progress += bytes_to_read;
+}
+
+void VolumeVerifier::VerifyBlocks(size_t begin, size_t end, u64 data_offset, u64 data_size)
+{
+  // The blocks are independent, so they are split evenly between the hardware threads. A block
+  // that isn't entirely in m_data is read again on its own.
+  std::vector<u8> results(end - begin);
+  const size_t num_tasks =
+      std::min<size_t>(results.size(), std::max(std::thread::hardware_concurrency(), 1u));
+  std::vector<std::future<void>> futures(num_tasks);
+  for (size_t task = 0; task < num_tasks; ++task)
+  {
+    futures[task] = std::async(
         std::launch::async,
-        [this, read_succeeded, bytes_to_read](size_t block_index, u64 progress) {
-          while (block_index < m_blocks.size() &&
-                 m_blocks[block_index].offset < progress + bytes_to_read)
+        [this, &results, begin, data_offset, data_size](size_t task_begin, size_t task_end) {
+          for (size_t i = task_begin; i < task_end; ++i)
           {
-            bool success;
-            if (m_blocks[block_index].offset == progress)
+            const BlockToVerify& block = m_blocks[i];
+            if (block.offset >= data_offset &&
+                block.offset + VolumeWii::BLOCK_TOTAL_SIZE <= data_offset + data_size)
             {
-              success = read_succeeded &&
-                        m_volume.CheckBlockIntegrity(m_blocks[block_index].block_index, m_data,
-                                                     m_blocks[block_index].partition);
+              results[i - begin] = m_volume.CheckBlockIntegrity(
+                  block.block_index, m_data.data() + (block.offset - data_offset),
+                  block.partition);
             }
             else
             {
               std::lock_guard lk(m_volume_mutex);
-              success = m_volume.CheckBlockIntegrity(m_blocks[block_index].block_index,
-                                                     m_blocks[block_index].partition);
+              results[i - begin] = m_volume.CheckBlockIntegrity(block.block_index, block.partition);
             }
-
-            const u64 offset = m_blocks[block_index].offset;
-            if (success)
-            {
-              m_biggest_verified_offset =
-                  std::max(m_biggest_verified_offset, offset + VolumeWii::BLOCK_TOTAL_SIZE);
-            }
-            else
-            {
-              if (m_scrubber.CanBlockBeScrubbed(offset))
-              {
-                WARN_LOG(DISCIO, "Integrity check failed for unused block at 0x%" PRIx64, offset);
-                m_unused_block_errors[m_blocks[block_index].partition]++;
-              }
-              else
-              {
-                WARN_LOG(DISCIO, "Integrity check failed for block at 0x%" PRIx64, offset);
-                m_block_errors[m_blocks[block_index].partition]++;
-              }
-            }
-            block_index++;
           }
         },
-        m_block_index, m_progress);
+        begin + task * results.size() / num_tasks, begin + (task + 1) * results.size() / num_tasks);
+  }
+
+  for (std::future<void>& future : futures)
+    future.get();
 
-    while (m_block_index < m_blocks.size() &&
-           m_blocks[m_block_index].offset < m_progress + bytes_to_read)
+  for (size_t i = begin; i < end; ++i)
+  {
+    const u64 offset = m_blocks[i].offset;
+    if (results[i - begin])
     {
-      m_block_index++;
+      m_biggest_verified_offset =
+          std::max(m_biggest_verified_offset, offset + VolumeWii::BLOCK_TOTAL_SIZE);
+    }
+    else
+    {
+      if (m_scrubber.CanBlockBeScrubbed(offset))
+      {
+        WARN_LOG(DISCIO, "Integrity check failed for unused block at 0x%" PRIx64, offset);
+        m_unused_block_errors[m_blocks[i].partition]++;
+      }
+      else
+      {
+        WARN_LOG(DISCIO, "Integrity check failed for block at 0x%" PRIx64, offset);
+        m_block_errors[m_blocks[i].partition]++;
+      }
     }
   }
-
-  m_progress += bytes_to_read;
 }
 
 u64 VolumeVerifier::GetBytesProcessed() const
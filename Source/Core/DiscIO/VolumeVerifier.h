@@ -162,6 +162,9 @@ private:
   void SetUpHashing();
   void WaitForAsyncOperations() const;
   bool ReadChunkAndWaitForAsyncOperations(u64 bytes_to_read);
+  // Verifies m_blocks[begin] to m_blocks[end - 1], using the data_size bytes in m_data that were
+  // read from data_offset where possible.
+  void VerifyBlocks(size_t begin, size_t end, u64 data_offset, u64 data_size);
 
   void AddProblem(Severity severity, std::string text);
 
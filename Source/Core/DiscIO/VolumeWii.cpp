@@ -23,6 +23,8 @@
 #include "Common/Align.h"
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Common/Crypto/AES.h"
+#include "Common/Crypto/SHA1.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/Swap.h"
@@ -388,12 +390,9 @@ bool VolumeWii::CheckH3TableIntegrity(const Partition& partition) const
   return h3_table_sha1 == contents[0].sha1;
 }
 
-bool VolumeWii::CheckBlockIntegrity(u64 block_index, const std::vector<u8>& encrypted_data,
+bool VolumeWii::CheckBlockIntegrity(u64 block_index, const u8* encrypted_data,
                                     const Partition& partition) const
 {
-  if (encrypted_data.size() != BLOCK_TOTAL_SIZE)
-    return false;
-
   auto it = m_partitions.find(partition);
   if (it == m_partitions.end())
     return false;
@@ -407,31 +406,31 @@ bool VolumeWii::CheckBlockIntegrity(u64 block_index, const std::vector<u8>& encr
     return false;
 
   HashBlock hashes;
-  DecryptBlockHashes(encrypted_data.data(), &hashes, aes_context);
+  DecryptBlockHashes(encrypted_data, &hashes, aes_context);
 
   u8 cluster_data[BLOCK_DATA_SIZE];
-  DecryptBlockData(encrypted_data.data(), cluster_data, aes_context);
+  DecryptBlockData(encrypted_data, cluster_data, aes_context);
 
   for (u32 hash_index = 0; hash_index < 31; ++hash_index)
   {
     u8 h0_hash[SHA1_SIZE];
-    mbedtls_sha1_ret(cluster_data + hash_index * 0x400, 0x400, h0_hash);
+    Common::SHA1::CalculateDigest(cluster_data + hash_index * 0x400, 0x400, h0_hash);
     if (memcmp(h0_hash, hashes.h0[hash_index], SHA1_SIZE))
       return false;
   }
 
   u8 h1_hash[SHA1_SIZE];
-  mbedtls_sha1_ret(reinterpret_cast<u8*>(hashes.h0), sizeof(hashes.h0), h1_hash);
+  Common::SHA1::CalculateDigest(reinterpret_cast<u8*>(hashes.h0), sizeof(hashes.h0), h1_hash);
   if (memcmp(h1_hash, hashes.h1[block_index % 8], SHA1_SIZE))
     return false;
 
   u8 h2_hash[SHA1_SIZE];
-  mbedtls_sha1_ret(reinterpret_cast<u8*>(hashes.h1), sizeof(hashes.h1), h2_hash);
+  Common::SHA1::CalculateDigest(reinterpret_cast<u8*>(hashes.h1), sizeof(hashes.h1), h2_hash);
   if (memcmp(h2_hash, hashes.h2[block_index / 8 % 8], SHA1_SIZE))
     return false;
 
   u8 h3_hash[SHA1_SIZE];
-  mbedtls_sha1_ret(reinterpret_cast<u8*>(hashes.h2), sizeof(hashes.h2), h3_hash);
+  Common::SHA1::CalculateDigest(reinterpret_cast<u8*>(hashes.h2), sizeof(hashes.h2), h3_hash);
   if (memcmp(h3_hash, partition_details.h3_table->data() + block_index / 64 * SHA1_SIZE, SHA1_SIZE))
     return false;
 
@@ -450,80 +449,77 @@ bool VolumeWii::CheckBlockIntegrity(u64 block_index, const Partition& partition)
   std::vector<u8> cluster(BLOCK_TOTAL_SIZE);
   if (!m_reader->Read(cluster_offset, cluster.size(), cluster.data()))
     return false;
-  return CheckBlockIntegrity(block_index, cluster, partition);
+  return CheckBlockIntegrity(block_index, cluster.data(), partition);
 }
 
 bool VolumeWii::HashGroup(const std::array<u8, BLOCK_DATA_SIZE> in[BLOCKS_PER_GROUP],
                           HashBlock out[BLOCKS_PER_GROUP],
                           const std::function<bool(size_t block)>& read_function)
 {
-  std::array<std::future<void>, BLOCKS_PER_GROUP> hash_futures;
+  // One task for each subgroup of 8 blocks, which share H1 hashes. A task per block would spend
+  // a large part of its time on creating its thread.
+  constexpr size_t BLOCKS_PER_SUBGROUP = 8;
+  std::array<std::future<void>, BLOCKS_PER_GROUP / BLOCKS_PER_SUBGROUP> hash_futures;
   bool success = true;
 
-  for (size_t i = 0; i < BLOCKS_PER_GROUP; ++i)
+  for (size_t subgroup = 0; subgroup < hash_futures.size(); ++subgroup)
   {
-    if (read_function && success)
-      success = read_function(i);
+    const size_t h1_base = subgroup * BLOCKS_PER_SUBGROUP;
+    for (size_t i = h1_base; i < h1_base + BLOCKS_PER_SUBGROUP; ++i)
+    {
+      if (read_function && success)
+        success = read_function(i);
+    }
 
-    hash_futures[i] = std::async(std::launch::async, [&in, &out, &hash_futures, success, i]() {
-      const size_t h1_base = Common::AlignDown(i, 8);
+    if (!success)
+      break;
 
-      if (success)
+    hash_futures[subgroup] = std::async(std::launch::async, [&in, &out, subgroup, h1_base]() {
+      for (size_t i = h1_base; i < h1_base + BLOCKS_PER_SUBGROUP; ++i)
       {
         // H0 hashes
         for (size_t j = 0; j < 31; ++j)
-          mbedtls_sha1_ret(in[i].data() + j * 0x400, 0x400, out[i].h0[j]);
+          Common::SHA1::CalculateDigest(in[i].data() + j * 0x400, 0x400, out[i].h0[j]);
 
         // H0 padding
         std::memset(out[i].padding_0, 0, sizeof(HashBlock::padding_0));
 
         // H1 hash
-        mbedtls_sha1_ret(reinterpret_cast<u8*>(out[i].h0), sizeof(HashBlock::h0),
-                         out[h1_base].h1[i - h1_base]);
+        Common::SHA1::CalculateDigest(reinterpret_cast<u8*>(out[i].h0), sizeof(HashBlock::h0),
+                                      out[h1_base].h1[i - h1_base]);
       }
 
-      if (i % 8 == 7)
-      {
-        for (size_t j = 0; j < 7; ++j)
-          hash_futures[h1_base + j].get();
-
-        if (success)
-        {
-          // H1 padding
-          std::memset(out[h1_base].padding_1, 0, sizeof(HashBlock::padding_1));
-
-          // H1 copies
-          for (size_t j = 1; j < 8; ++j)
-            std::memcpy(out[h1_base + j].h1, out[h1_base].h1, sizeof(HashBlock::h1));
-
-          // H2 hash
-          mbedtls_sha1_ret(reinterpret_cast<u8*>(out[i].h1), sizeof(HashBlock::h1),
-                           out[0].h2[h1_base / 8]);
-        }
-
-        if (i == BLOCKS_PER_GROUP - 1)
-        {
-          for (size_t j = 0; j < 7; ++j)
-            hash_futures[j * 8 + 7].get();
+      // H1 padding
+      std::memset(out[h1_base].padding_1, 0, sizeof(HashBlock::padding_1));
 
-          if (success)
-          {
-            // H2 padding
-            std::memset(out[0].padding_2, 0, sizeof(HashBlock::padding_2));
+      // H1 copies
+      for (size_t j = 1; j < BLOCKS_PER_SUBGROUP; ++j)
+        std::memcpy(out[h1_base + j].h1, out[h1_base].h1, sizeof(HashBlock::h1));
 
-            // H2 copies
-            for (size_t j = 1; j < BLOCKS_PER_GROUP; ++j)
-              std::memcpy(out[j].h2, out[0].h2, sizeof(HashBlock::h2));
-          }
-        }
-      }
+      // H2 hash
+      Common::SHA1::CalculateDigest(reinterpret_cast<u8*>(out[h1_base].h1), sizeof(HashBlock::h1),
+                                    out[0].h2[subgroup]);
     });
   }
 
   // Wait for all the async tasks to finish
-  hash_futures.back().get();
+  for (std::future<void>& future : hash_futures)
+  {
+    if (future.valid())
+      future.get();
+  }
 
-  return success;
+  if (!success)
+    return false;
+
+  // H2 padding
+  std::memset(out[0].padding_2, 0, sizeof(HashBlock::padding_2));
+
+  // H2 copies
+  for (size_t j = 1; j < BLOCKS_PER_GROUP; ++j)
+    std::memcpy(out[j].h2, out[0].h2, sizeof(HashBlock::h2));
+
+  return true;
 }
 
 bool VolumeWii::EncryptGroup(
@@ -563,25 +559,24 @@ bool VolumeWii::EncryptGroup(
 
   std::vector<std::future<void>> encryption_futures(threads);
 
-  mbedtls_aes_context aes_context;
-  mbedtls_aes_setkey_enc(&aes_context, key.data(), 128);
+  const Common::AES::CBCEncryptor encryptor(key.data());
 
   for (size_t i = 0; i < threads; ++i)
   {
     encryption_futures[i] = std::async(
         std::launch::async,
-        [&unencrypted_data, &unencrypted_hashes, &aes_context, &out](size_t start, size_t end) {
+        [&unencrypted_data, &unencrypted_hashes, &encryptor, &out](size_t start, size_t end) {
           for (size_t i = start; i < end; ++i)
           {
             u8* out_ptr = out->data() + i * BLOCK_TOTAL_SIZE;
 
             u8 iv[16] = {};
-            mbedtls_aes_crypt_cbc(&aes_context, MBEDTLS_AES_ENCRYPT, BLOCK_HEADER_SIZE, iv,
-                                  reinterpret_cast<u8*>(&unencrypted_hashes[i]), out_ptr);
+            encryptor.Encrypt(iv, reinterpret_cast<u8*>(&unencrypted_hashes[i]), out_ptr,
+                              BLOCK_HEADER_SIZE);
 
             std::memcpy(iv, out_ptr + 0x3D0, sizeof(iv));
-            mbedtls_aes_crypt_cbc(&aes_context, MBEDTLS_AES_ENCRYPT, BLOCK_DATA_SIZE, iv,
-                                  unencrypted_data[i].data(), out_ptr + BLOCK_HEADER_SIZE);
+            encryptor.Encrypt(iv, unencrypted_data[i].data(), out_ptr + BLOCK_HEADER_SIZE,
+                              BLOCK_DATA_SIZE);
           }
         },
         i * BLOCKS_PER_GROUP / threads, (i + 1) * BLOCKS_PER_GROUP / threads);
@@ -13,6 +13,7 @@
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <thread>
 #include <type_traits>
 #include <utility>
 
@@ -42,6 +43,18 @@
 
 namespace DiscIO
 {
+// How much decompressed data a reader keeps around. At least a few chunks are kept regardless, so
+// that the chunks being decompressed ahead of the reads don't push out the one being read.
+constexpr u64 CHUNK_CACHE_SIZE = 32 * 1024 * 1024;
+constexpr size_t MAX_DECOMPRESSION_WORKERS = 4;
+
+static size_t GetNumDecompressionWorkers()
+{
+  // Leave one core for the thread that is waiting on the data.
+  const size_t cores = std::max(std::thread::hardware_concurrency(), 2u);
+  return std::min(cores - 1, MAX_DECOMPRESSION_WORKERS);
+}
+
 static void PushBack(std::vector<u8>* vector, const u8* begin, const u8* end)
 {
   const size_t offset_in_vector = vector->size();
@@ -78,13 +91,18 @@ std::pair<int, int> GetAllowedCompressionLevels(WIARVZCompressionType compressio
 
 template <bool RVZ>
 WIARVZFileReader<RVZ>::WIARVZFileReader(File::IOFile file, const std::string& path)
-    : m_file(std::move(file)), m_encryption_cache(this)
+    : m_file(std::move(file)), m_path(path), m_encryption_cache(this)
 {
   m_valid = Initialize(path);
 }
 
 template <bool RVZ>
-WIARVZFileReader<RVZ>::~WIARVZFileReader() = default;
+WIARVZFileReader<RVZ>::~WIARVZFileReader()
+{
+  // Don't make the workers finish decompressing chunks that nobody is going to read.
+  m_shutting_down.Set();
+  m_decompression_workers.clear();
+}
 
 template <bool RVZ>
 bool WIARVZFileReader<RVZ>::Initialize(const std::string& path)
@@ -237,6 +255,9 @@ bool WIARVZFileReader<RVZ>::Initialize(const std::string& path)
   if (HasDataOverlap())
     return false;
 
+  m_max_cached_chunks =
+      std::max<u64>(GetNumDecompressionWorkers() + 2, CHUNK_CACHE_SIZE / chunk_size);
+
   return true;
 }
 
@@ -482,22 +503,18 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
     const u64 group_offset_in_data = i * chunk_size;
     const u64 offset_in_group = *offset - group_offset_in_data - data_offset;
 
+    const bool sequential = m_last_group_index != std::numeric_limits<u64>::max() &&
+                            total_group_index == m_last_group_index + 1;
+    m_last_group_index = total_group_index;
+
+    const u64 full_chunk_size = chunk_size;
     chunk_size = std::min(chunk_size, data_size - group_offset_in_data);
 
     const u64 bytes_to_read = std::min(chunk_size - offset_in_group, *size);
-    u32 group_data_size = Common::swap32(group.data_size);
-
-    WIARVZCompressionType compression_type = m_compression_type;
-    u32 rvz_packed_size = 0;
-    if constexpr (RVZ)
-    {
-      if ((group_data_size & 0x80000000) == 0)
-        compression_type = WIARVZCompressionType::None;
 
-      group_data_size &= 0x7FFFFFFF;
-
-      rvz_packed_size = Common::swap32(group.rvz_packed_size);
-    }
+    WIARVZCompressionType compression_type;
+    u32 rvz_packed_size;
+    const u32 group_data_size = GetGroupCompression(group, &compression_type, &rvz_packed_size);
 
     if (group_data_size == 0)
     {
@@ -511,9 +528,17 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
           ReadCompressedData(group_offset_in_file, group_data_size, chunk_size, compression_type,
                              exception_lists, rvz_packed_size, group_offset_in_data);
 
+      // Reading a group right after the previous one most likely means that the next ones will
+      // be read too, so get them decompressing while this one is being read.
+      if (sequential)
+      {
+        PrefetchGroups(i + 1, full_chunk_size, data_size, group_index, number_of_groups,
+                       exception_lists);
+      }
+
       if (!chunk.Read(offset_in_group, bytes_to_read, *out_ptr))
       {
-        m_cached_chunk_offset = std::numeric_limits<u64>::max();  // Invalidate the cache
+        InvalidateCachedChunk(group_offset_in_file);
         return false;
       }
 
@@ -543,9 +568,42 @@ WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_siz
                                           WIARVZCompressionType compression_type,
                                           u32 exception_lists, u32 rvz_packed_size, u64 data_offset)
 {
-  if (offset_in_file == m_cached_chunk_offset)
-    return m_cached_chunk;
+  const auto it = FindCachedChunk(offset_in_file);
+  if (it != m_cached_chunks.end())
+  {
+    std::unique_lock lock(m_cached_chunks_mutex);
+    m_cached_chunk_decompressed.wait(lock, [&it] { return !it->pending; });
+    const bool failed = it->failed;
+    lock.unlock();
+
+    if (!failed)
+    {
+      m_cached_chunks.splice(m_cached_chunks.begin(), m_cached_chunks, it);
+      return *it->chunk;
+    }
+
+    // Let the chunk be read again from m_file, so that the error is handled like any other.
+    m_cached_chunks.erase(it);
+  }
+
+  while (m_cached_chunks.size() >= m_max_cached_chunks && EvictCachedChunk(false))
+  {
+  }
 
+  CachedChunk& cached_chunk = m_cached_chunks.emplace_front();
+  cached_chunk.offset_in_file = offset_in_file;
+  cached_chunk.chunk =
+      CreateChunk(&m_file, offset_in_file, compressed_size, decompressed_size, compression_type,
+                  exception_lists, rvz_packed_size, data_offset);
+  return *cached_chunk.chunk;
+}
+
+template <bool RVZ>
+std::unique_ptr<typename WIARVZFileReader<RVZ>::Chunk>
+WIARVZFileReader<RVZ>::CreateChunk(File::IOFile* file, u64 offset_in_file, u64 compressed_size,
+                                   u64 decompressed_size, WIARVZCompressionType compression_type,
+                                   u32 exception_lists, u32 rvz_packed_size, u64 data_offset) const
+{
   std::unique_ptr<Decompressor> decompressor;
   switch (compression_type)
   {
@@ -574,11 +632,154 @@ WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_siz
 
   const bool compressed_exception_lists = compression_type > WIARVZCompressionType::Purge;
 
-  m_cached_chunk =
-      Chunk(&m_file, offset_in_file, compressed_size, decompressed_size, exception_lists,
-            compressed_exception_lists, rvz_packed_size, data_offset, std::move(decompressor));
-  m_cached_chunk_offset = offset_in_file;
-  return m_cached_chunk;
+  return std::make_unique<Chunk>(file, offset_in_file, compressed_size, decompressed_size,
+                                 exception_lists, compressed_exception_lists, rvz_packed_size,
+                                 data_offset, std::move(decompressor));
+}
+
+template <bool RVZ>
+typename std::list<typename WIARVZFileReader<RVZ>::CachedChunk>::iterator
+WIARVZFileReader<RVZ>::FindCachedChunk(u64 offset_in_file)
+{
+  return std::find_if(m_cached_chunks.begin(), m_cached_chunks.end(),
+                      [offset_in_file](const CachedChunk& cached_chunk) {
+                        return cached_chunk.offset_in_file == offset_in_file;
+                      });
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::InvalidateCachedChunk(u64 offset_in_file)
+{
+  const auto it = FindCachedChunk(offset_in_file);
+  if (it != m_cached_chunks.end())
+    m_cached_chunks.erase(it);
+}
+
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::EvictCachedChunk(bool keep_most_recently_used)
+{
+  if (m_cached_chunks.empty())
+    return false;
+
+  const auto first = keep_most_recently_used ? std::next(m_cached_chunks.begin()) :
+                                               m_cached_chunks.begin();
+
+  std::lock_guard lock(m_cached_chunks_mutex);
+  for (auto it = m_cached_chunks.end(); it != first;)
+  {
+    --it;
+    if (!it->pending)
+    {
+      m_cached_chunks.erase(it);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+template <bool RVZ>
+u32 WIARVZFileReader<RVZ>::GetGroupCompression(const GroupEntry& group,
+                                               WIARVZCompressionType* compression_type,
+                                               u32* rvz_packed_size) const
+{
+  u32 group_data_size = Common::swap32(group.data_size);
+
+  *compression_type = m_compression_type;
+  *rvz_packed_size = 0;
+  if constexpr (RVZ)
+  {
+    if ((group_data_size & 0x80000000) == 0)
+      *compression_type = WIARVZCompressionType::None;
+
+    group_data_size &= 0x7FFFFFFF;
+
+    *rvz_packed_size = Common::swap32(group.rvz_packed_size);
+  }
+
+  return group_data_size;
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::PrefetchGroups(u64 first_group, u64 chunk_size, u64 data_size,
+                                           u32 group_index, u32 number_of_groups,
+                                           u32 exception_lists)
+{
+  // Stored and purged groups are about as fast to read as they are to hand over to a worker.
+  if (m_compression_type <= WIARVZCompressionType::Purge)
+    return;
+
+  if (m_decompression_workers.empty())
+    StartDecompressionWorkers();
+
+  const u64 last_group =
+      std::min<u64>(number_of_groups, first_group + m_decompression_workers.size());
+  for (u64 i = first_group; i < last_group; ++i)
+  {
+    const u64 total_group_index = group_index + i;
+    if (total_group_index >= m_group_entries.size())
+      return;
+
+    WIARVZCompressionType compression_type;
+    u32 rvz_packed_size;
+    const u32 group_data_size = GetGroupCompression(m_group_entries[total_group_index],
+                                                    &compression_type, &rvz_packed_size);
+    if (group_data_size == 0 || compression_type <= WIARVZCompressionType::Purge)
+      continue;
+
+    const u64 group_offset_in_file =
+        static_cast<u64>(Common::swap32(m_group_entries[total_group_index].data_offset)) << 2;
+    if (FindCachedChunk(group_offset_in_file) != m_cached_chunks.end())
+      continue;
+
+    if (m_cached_chunks.size() >= m_max_cached_chunks && !EvictCachedChunk(true))
+      return;
+
+    DecompressionWorker& worker = *m_decompression_workers[m_next_decompression_worker];
+    m_next_decompression_worker =
+        (m_next_decompression_worker + 1) % m_decompression_workers.size();
+
+    // Queue the chunk right behind the one that is being read, which must stay in the cache.
+    const u64 group_offset_in_data = i * chunk_size;
+    const auto it = m_cached_chunks.emplace(
+        m_cached_chunks.empty() ? m_cached_chunks.end() : std::next(m_cached_chunks.begin()));
+    it->offset_in_file = group_offset_in_file;
+    it->chunk = CreateChunk(&worker.file, group_offset_in_file, group_data_size,
+                            std::min(chunk_size, data_size - group_offset_in_data),
+                            compression_type, exception_lists, rvz_packed_size,
+                            group_offset_in_data);
+    it->pending = true;
+    worker.thread.EmplaceItem(&*it);
+  }
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::StartDecompressionWorkers()
+{
+  const size_t num_workers = GetNumDecompressionWorkers();
+  for (size_t i = 0; i < num_workers; ++i)
+  {
+    auto worker = std::make_unique<DecompressionWorker>();
+    if (!worker->file.Open(m_path, "rb"))
+      break;
+
+    worker->thread.Reset(
+        [this](CachedChunk* cached_chunk) { DecompressCachedChunk(cached_chunk); });
+    m_decompression_workers.push_back(std::move(worker));
+  }
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::DecompressCachedChunk(CachedChunk* cached_chunk)
+{
+  const bool success = !m_shutting_down.IsSet() && cached_chunk->chunk->DecompressAll();
+
+  {
+    std::lock_guard lock(m_cached_chunks_mutex);
+    cached_chunk->pending = false;
+    cached_chunk->failed = !success;
+  }
+  m_cached_chunk_decompressed.notify_all();
 }
 
 template <bool RVZ>
@@ -621,17 +822,33 @@ WIARVZFileReader<RVZ>::Chunk::Chunk(File::IOFile* file, u64 offset_in_file, u64
 
 template <bool RVZ>
 bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
+{
+  if (!DecompressUntil(offset + size))
+    return false;
+
+  std::memcpy(out_ptr, m_out.data.data() + offset + m_out_bytes_used_for_exceptions, size);
+  return true;
+}
+
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::Chunk::DecompressAll()
+{
+  return DecompressUntil(m_out.data.size() - m_out_bytes_allocated_for_exceptions);
+}
+
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::Chunk::DecompressUntil(u64 end_offset)
 {
   if (!m_decompressor || !m_file ||
-      offset + size > m_out.data.size() - m_out_bytes_allocated_for_exceptions)
+      end_offset > m_out.data.size() - m_out_bytes_allocated_for_exceptions)
   {
     return false;
   }
 
-  while (offset + size > m_out.bytes_written - m_out_bytes_used_for_exceptions)
+  while (end_offset > m_out.bytes_written - m_out_bytes_used_for_exceptions)
   {
     u64 bytes_to_read;
-    if (offset + size == m_out.data.size())
+    if (end_offset == m_out.data.size())
     {
       // Read all the remaining data.
       bytes_to_read = m_in.data.size() - m_in.bytes_written;
@@ -643,8 +860,7 @@ bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
 
       // The compressed data is probably not much bigger than the decompressed data.
       // Add a few bytes for possible compression overhead and for any hash exceptions.
-      bytes_to_read =
-          offset + size - (m_out.bytes_written - m_out_bytes_used_for_exceptions) + 0x100;
+      bytes_to_read = end_offset - (m_out.bytes_written - m_out_bytes_used_for_exceptions) + 0x100;
 
       // Align the access in an attempt to gain speed. But we don't actually know the
       // block size of the underlying storage device, so we just use the Wii block size.
@@ -724,7 +940,6 @@ bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
     }
   }
 
-  std::memcpy(out_ptr, m_out.data.data() + offset + m_out_bytes_used_for_exceptions, size);
   return true;
 }
 
@@ -1013,7 +1228,7 @@ std::optional<std::vector<u8>> WIARVZFileReader<RVZ>::Compress(Compressor* compr
 {
   if (compressor)
   {
-    if (!compressor->Start() || !compressor->Compress(data, size) || !compressor->End())
+    if (!compressor->Start(size) || !compressor->Compress(data, size) || !compressor->End())
       return std::nullopt;
 
     data = compressor->GetData();
@@ -1537,7 +1752,11 @@ WIARVZFileReader<RVZ>::ProcessAndCompress(CompressThreadState* state, CompressPa
 
     if (state->compressor)
     {
-      if (!state->compressor->Start())
+      u64 size_to_compress = entry.main_data.size();
+      if (compressed_exception_lists)
+        size_to_compress += entry.exception_lists.size();
+
+      if (!state->compressor->Start(size_to_compress))
         return ConversionResultCode::InternalError;
     }
 
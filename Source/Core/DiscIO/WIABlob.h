@@ -5,16 +5,22 @@
 #pragma once
 
 #include <array>
+#include <condition_variable>
 #include <limits>
+#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/File.h"
+#include "Common/Flag.h"
 #include "Common/Swap.h"
+#include "Common/WorkQueueThread.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/MultithreadedCompressor.h"
 #include "DiscIO/WIACompression.h"
@@ -187,6 +193,8 @@ private:
           u64 data_offset, std::unique_ptr<Decompressor> decompressor);
 
     bool Read(u64 offset, u64 size, u8* out_ptr);
+    // Decompresses all of the data, so that reading it later won't access the file.
+    bool DecompressAll();
 
     // This can only be called once at least one byte of data has been read
     void GetHashExceptions(std::vector<HashExceptionEntry>* exception_list,
@@ -199,6 +207,7 @@ private:
     }
 
   private:
+    bool DecompressUntil(u64 end_offset);
     bool Decompress();
     bool HandleExceptions(const u8* data, size_t bytes_allocated, size_t bytes_written,
                           size_t* bytes_used, bool align);
@@ -224,12 +233,48 @@ private:
   bool Initialize(const std::string& path);
   bool HasDataOverlap() const;
 
+  // A chunk of the file, which is kept around until the chunks that were used after it push it
+  // out. While pending is set, a decompression worker owns the chunk.
+  struct CachedChunk
+  {
+    u64 offset_in_file;
+    std::unique_ptr<Chunk> chunk;
+    bool pending = false;
+    bool failed = false;
+  };
+
+  // Each worker has a file handle of its own, so that it doesn't have to share the seek position
+  // of m_file with the thread that is reading.
+  struct DecompressionWorker
+  {
+    File::IOFile file;
+    Common::WorkQueueThread<CachedChunk*> thread;
+  };
+
   bool ReadFromGroups(u64* offset, u64* size, u8** out_ptr, u64 chunk_size, u32 sector_size,
                       u64 data_offset, u64 data_size, u32 group_index, u32 number_of_groups,
                       u32 exception_lists);
+  void PrefetchGroups(u64 first_group, u64 chunk_size, u64 data_size, u32 group_index,
+                      u32 number_of_groups, u32 exception_lists);
+  // Returns the size of the group's data in the file, or 0 if it has none.
+  u32 GetGroupCompression(const GroupEntry& group, WIARVZCompressionType* compression_type,
+                          u32* rvz_packed_size) const;
+
   Chunk& ReadCompressedData(u64 offset_in_file, u64 compressed_size, u64 decompressed_size,
                             WIARVZCompressionType compression_type, u32 exception_lists = 0,
                             u32 rvz_packed_size = 0, u64 data_offset = 0);
+  std::unique_ptr<Chunk> CreateChunk(File::IOFile* file, u64 offset_in_file, u64 compressed_size,
+                                     u64 decompressed_size, WIARVZCompressionType compression_type,
+                                     u32 exception_lists, u32 rvz_packed_size,
+                                     u64 data_offset) const;
+  typename std::list<CachedChunk>::iterator FindCachedChunk(u64 offset_in_file);
+  void InvalidateCachedChunk(u64 offset_in_file);
+  // Evicts the least recently used chunk that no worker owns. Returns false if there was nothing
+  // that could be evicted.
+  bool EvictCachedChunk(bool keep_most_recently_used);
+
+  void StartDecompressionWorkers();
+  void DecompressCachedChunk(CachedChunk* cached_chunk);
 
   static bool ApplyHashExceptions(const std::vector<HashExceptionEntry>& exception_list,
                                   VolumeWii::HashBlock hash_blocks[VolumeWii::BLOCKS_PER_GROUP]);
@@ -356,10 +401,17 @@ private:
   WIARVZCompressionType m_compression_type;
 
   File::IOFile m_file;
-  Chunk m_cached_chunk;
-  u64 m_cached_chunk_offset = std::numeric_limits<u64>::max();
+  std::string m_path;
   WiiEncryptionCache m_encryption_cache;
 
+  // Most recently used first
+  std::list<CachedChunk> m_cached_chunks;
+  size_t m_max_cached_chunks = 1;
+  // Protects the pending and failed flags of the cached chunks.
+  std::mutex m_cached_chunks_mutex;
+  std::condition_variable m_cached_chunk_decompressed;
+  u64 m_last_group_index = std::numeric_limits<u64>::max();
+
   std::vector<HashExceptionEntry> m_exception_list;
   bool m_write_to_exception_list = false;
   u64 m_exception_list_last_group_index;
@@ -372,6 +424,11 @@ private:
 
   std::map<u64, DataEntry> m_data_entries;
 
+  Common::Flag m_shutting_down;
+  size_t m_next_decompression_worker = 0;
+  // Declared last, so that the workers are stopped before anything they use is destroyed.
+  std::vector<std::unique_ptr<DecompressionWorker>> m_decompression_workers;
+
   // Perhaps we could set WIA_VERSION_WRITE_COMPATIBLE to 0.9, but WIA version 0.9 was never in
   // any official release of wit, and interim versions (either source or binaries) are hard to find.
   // Since we've been unable to check if we're write compatible with 0.9, we set it 1.0 to be safe.
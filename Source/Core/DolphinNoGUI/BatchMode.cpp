@@ -0,0 +1,325 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "DolphinNoGUI/BatchMode.h"
+
+#include <OptionParser.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+#include <xxhash.h>
+
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/HW/DSP.h"
+#include "Core/HW/Memmap.h"
+#include "Core/Movie.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "DolphinNoGUI/Platform.h"
+
+namespace BatchMode
+{
+namespace
+{
+// Same layout as the RTC's memory domains
+constexpr u32 SRAM_OFFSET = 0x80000000;
+constexpr u32 EXRAM_OFFSET = 0x90000000;
+constexpr u32 ARAM_OFFSET = 0x80000000;
+
+struct BlastUnit
+{
+  std::string domain;
+  u32 address;
+  std::vector<u8> data;
+};
+
+std::thread s_thread;
+std::atomic<int> s_exit_code{0};
+
+// One unit per line: "<domain> <address> <hex bytes>", e.g. "SRAM 0x3A1C0 DEADBEEF". Addresses are
+// relative to the start of the domain. Blank lines and lines starting with # are ignored.
+bool ReadBlastFile(const std::string& path, std::vector<BlastUnit>* units)
+{
+  std::ifstream file;
+  File::OpenFStream(file, path, std::ios_base::in);
+  if (!file)
+    return false;
+
+  std::string line;
+  while (std::getline(file, line))
+  {
+    line = StripSpaces(line);
+    if (line.empty() || line[0] == '#')
+      continue;
+
+    std::istringstream stream(line);
+    std::string address_str, data_str;
+    BlastUnit unit;
+    if (!(stream >> unit.domain >> address_str >> data_str) ||
+        !TryParse(address_str, &unit.address) || data_str.size() % 2 != 0)
+    {
+      return false;
+    }
+
+    for (size_t i = 0; i < data_str.size(); i += 2)
+    {
+      u8 value;
+      if (!TryParse(data_str.substr(i, 2), &value, 16))
+        return false;
+      unit.data.push_back(value);
+    }
+
+    units->push_back(std::move(unit));
+  }
+
+  return true;
+}
+
+void CopyIntoRange(u8* base, u32 size, u32 emulated_base, const BlastUnit& unit)
+{
+  if (!base || unit.address >= size)
+    return;
+
+  const u32 length = std::min<u32>(static_cast<u32>(unit.data.size()), size - unit.address);
+  std::memcpy(base + unit.address, unit.data.data(), length);
+  JitInterface::InvalidateExternalWrite(emulated_base + unit.address, length);
+}
+
+void ApplyBlast(const std::vector<BlastUnit>& units)
+{
+  const bool is_wii = SConfig::GetInstance().bWii;
+  for (const BlastUnit& unit : units)
+  {
+    if (unit.domain == "SRAM")
+    {
+      CopyIntoRange(Memory::m_pRAM, Memory::GetRamSizeReal(), SRAM_OFFSET, unit);
+    }
+    else if (unit.domain == "EXRAM" && is_wii)
+    {
+      CopyIntoRange(Memory::m_pEXRAM, Memory::GetExRamSizeReal(), EXRAM_OFFSET, unit);
+    }
+    else if (unit.domain == "ARAM")
+    {
+      // The Wii aliases ARAM onto MEM2, so go through the regular accessor there
+      for (size_t i = 0; i < unit.data.size(); ++i)
+        DSP::WriteARAM(unit.data[i], ARAM_OFFSET + unit.address + static_cast<u32>(i));
+    }
+  }
+}
+
+u64 Hash(const u8* data, size_t size)
+{
+  return data ? XXH64(data, size, 0) : 0;
+}
+
+std::string MakeReport(u64 frames)
+{
+  // The Null backend doesn't render anything, but the XFB lives in emulated RAM, so the RAM hash
+  // also covers what would have been displayed.
+  std::string report = fmt::format("{{\"frames\":{},\"sram\":\"{:016x}\"", frames,
+                                   Hash(Memory::m_pRAM, Memory::GetRamSizeReal()));
+  if (SConfig::GetInstance().bWii)
+  {
+    report += fmt::format(",\"exram\":\"{:016x}\"",
+                          Hash(Memory::m_pEXRAM, Memory::GetExRamSizeReal()));
+  }
+  else
+  {
+    report += fmt::format(",\"aram\":\"{:016x}\"", Hash(DSP::GetARAMPtr(), DSP::ARAM_SIZE));
+  }
+  return report + "}\n";
+}
+
+bool WaitForState(Platform* platform, Core::State state)
+{
+  while (platform->IsRunning() && Core::GetState() != state)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  return platform->IsRunning();
+}
+
+// Returns the first line that differs, or nothing if the reports match
+std::optional<std::string> CompareReports(const std::string& report, const std::string& golden)
+{
+  const std::vector<std::string> lines = SplitString(report, '\n');
+  const std::vector<std::string> golden_lines = SplitString(golden, '\n');
+  for (size_t i = 0; i < std::max(lines.size(), golden_lines.size()); ++i)
+  {
+    const std::string_view line = i < lines.size() ? StripSpaces(lines[i]) : "";
+    const std::string_view golden_line =
+        i < golden_lines.size() ? StripSpaces(golden_lines[i]) : "";
+    if (line != golden_line)
+      return line.empty() ? "(end of report)" : std::string(line);
+  }
+  return std::nullopt;
+}
+
+int RunBatch(const Options& options, Platform* platform)
+{
+  std::vector<BlastUnit> units;
+  if (!options.blast_path.empty() && !ReadBlastFile(options.blast_path, &units))
+  {
+    std::fprintf(stderr, "Could not read the blast file %s\n", options.blast_path.c_str());
+    return 1;
+  }
+
+  std::string golden;
+  if (!options.golden_path.empty() && !File::ReadFileToString(options.golden_path, golden))
+  {
+    std::fprintf(stderr, "Could not read the golden report %s\n", options.golden_path.c_str());
+    return 1;
+  }
+
+  if (!WaitForState(platform, Core::State::Running))
+    return 1;
+
+  u64 end_frame = 0;
+  u64 next_checkpoint = 0;
+  Core::RunAsCPUThread([&] {
+    ApplyBlast(units);
+    const u64 start_frame = Movie::GetCurrentFrame();
+    end_frame = options.frames != 0 || !Movie::IsPlayingInput() ?
+                    start_frame + options.frames :
+                    Movie::GetTotalFrames();
+    // BreakAtFrame(0) would cancel the break instead
+    end_frame = std::max(end_frame, start_frame + 1);
+    next_checkpoint = options.checkpoint_interval != 0 ?
+                          std::min(start_frame + options.checkpoint_interval, end_frame) :
+                          end_frame;
+    Core::BreakAtFrame(next_checkpoint);
+  });
+
+  std::string report;
+  while (true)
+  {
+    if (!WaitForState(platform, Core::State::Paused))
+      return 1;
+
+    bool done = false;
+    Core::RunAsCPUThread([&] {
+      // Reaching the end of a movie pauses too, and that may come before the checkpoint
+      const u64 frame = Movie::GetCurrentFrame();
+      if (frame < next_checkpoint)
+        return;
+
+      report += MakeReport(frame);
+      done = frame >= end_frame;
+      if (!done)
+      {
+        next_checkpoint = std::min<u64>(next_checkpoint + options.checkpoint_interval, end_frame);
+        Core::BreakAtFrame(next_checkpoint);
+      }
+    });
+    if (done)
+      break;
+
+    Core::SetState(Core::State::Running);
+  }
+
+  if (options.report_path.empty())
+  {
+    std::fputs(report.c_str(), stdout);
+    std::fflush(stdout);
+  }
+  else if (!File::WriteStringToFile(options.report_path, report))
+  {
+    std::fprintf(stderr, "Could not write the report to %s\n", options.report_path.c_str());
+    return 1;
+  }
+
+  if (!options.golden_path.empty())
+  {
+    if (const std::optional<std::string> mismatch = CompareReports(report, golden))
+    {
+      std::fprintf(stderr, "The report doesn't match the golden report from %s\n",
+                   mismatch->c_str());
+      return 2;
+    }
+  }
+
+  return 0;
+}
+}  // Anonymous namespace
+
+void AddOptions(optparse::OptionParser* parser)
+{
+  parser->add_option("--batch_frames")
+      .action("store")
+      .type("int")
+      .help("Run headless for this many frames, report memory hashes and exit");
+  parser->add_option("--batch_checkpoint_interval")
+      .action("store")
+      .type("int")
+      .help("Also report memory hashes every this many frames. Without --batch_frames, a movie "
+            "given with -m is run to its end");
+  parser->add_option("--batch_golden")
+      .action("store")
+      .help("Report of a known good batch to compare against (exit code 2 on mismatch)");
+  parser->add_option("--batch_blast")
+      .action("store")
+      .help("Blast file to apply before running a batch");
+  parser->add_option("--batch_report")
+      .action("store")
+      .help("Where to write the batch report (default: stdout)");
+}
+
+std::optional<Options> GetOptions(const optparse::Values& values)
+{
+  if (!values.is_set("batch_frames") && !values.is_set("batch_checkpoint_interval"))
+    return std::nullopt;
+
+  Options options;
+  if (values.is_set("batch_frames"))
+    options.frames = static_cast<u32>(static_cast<int>(values.get("batch_frames")));
+  if (values.is_set("batch_checkpoint_interval"))
+  {
+    options.checkpoint_interval =
+        static_cast<u32>(static_cast<int>(values.get("batch_checkpoint_interval")));
+  }
+  if (values.is_set("batch_blast"))
+    options.blast_path = static_cast<const char*>(values.get("batch_blast"));
+  if (values.is_set("batch_report"))
+    options.report_path = static_cast<const char*>(values.get("batch_report"));
+  if (values.is_set("batch_golden"))
+    options.golden_path = static_cast<const char*>(values.get("batch_golden"));
+  return options;
+}
+
+void ApplyConfig()
+{
+  Config::SetCurrent(Config::MAIN_GFX_BACKEND, "Null");
+
+  SConfig& config = SConfig::GetInstance();
+  config.sBackend = BACKEND_NULLSOUND;
+  config.m_EmulationSpeed = 0.0f;
+}
+
+void Start(const Options& options, Platform* platform)
+{
+  s_thread = std::thread([options, platform] {
+    s_exit_code = RunBatch(options, platform);
+    platform->Stop();
+  });
+}
+
+int Finish()
+{
+  if (s_thread.joinable())
+    s_thread.join();
+  return s_exit_code;
+}
+}  // namespace BatchMode
@@ -0,0 +1,51 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <optional>
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+namespace optparse
+{
+class OptionParser;
+class Values;
+}  // namespace optparse
+
+class Platform;
+
+// Unattended corruption runs: boot (usually straight into a savestate with -s), apply a blast
+// file, emulate a fixed number of frames as fast as possible, then report hashes of emulated
+// memory and exit. Many of these can run side by side, each with its own user directory.
+//
+// The same runs verify movies played with -m: hashes are also reported every checkpoint_interval
+// frames, and can be compared against the report of a known good run to find where a movie
+// desyncs.
+namespace BatchMode
+{
+struct Options
+{
+  // 0 runs a movie to its end
+  u32 frames = 0;
+  u32 checkpoint_interval = 0;
+  std::string blast_path;
+  std::string report_path;
+  std::string golden_path;
+};
+
+void AddOptions(optparse::OptionParser* parser);
+// Returns nothing if batch mode wasn't requested
+std::optional<Options> GetOptions(const optparse::Values& options);
+
+// Switches to the Null video backend, no audio output and an unlimited emulation speed
+void ApplyConfig();
+
+// Runs the batch on its own thread once the core has started, then asks the platform to shut
+// down. The result is also returned through the exit code: 0 on success, 1 on errors and 2 if the
+// report doesn't match the golden report.
+void Start(const Options& options, Platform* platform);
+int Finish();
+}  // namespace BatchMode
@@ -0,0 +1,227 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "DolphinNoGUI/CPUBench.h"
+
+#include <OptionParser.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+#include <fmt/format.h>
+
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/Timer.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/CoreTiming.h"
+#include "Core/HW/SystemTimers.h"
+#include "Core/Movie.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "DolphinNoGUI/Platform.h"
+
+namespace CPUBench
+{
+namespace
+{
+std::thread s_thread;
+std::atomic<int> s_exit_code{0};
+
+struct Counters
+{
+  u64 ticks = 0;
+  u64 idle_ticks = 0;
+  u64 exceptions = 0;
+  JitInterface::Statistics jit;
+};
+
+// NOTE: CPU Thread
+Counters ReadCounters()
+{
+  Counters counters;
+  counters.ticks = CoreTiming::GetTicks();
+  counters.idle_ticks = CoreTiming::GetIdleTicks();
+  counters.exceptions = PowerPC::GetExceptionCount();
+  counters.jit = JitInterface::GetStatistics();
+  return counters;
+}
+
+const char* GetCoreName(PowerPC::CPUCore core)
+{
+  switch (core)
+  {
+  case PowerPC::CPUCore::Interpreter:
+    return "interpreter";
+  case PowerPC::CPUCore::CachedInterpreter:
+    return "cachedinterpreter";
+  case PowerPC::CPUCore::JIT64:
+    return "jit64";
+  case PowerPC::CPUCore::JITARM64:
+    return "jitarm64";
+  default:
+    return "unknown";
+  }
+}
+
+std::string MakeReport(u32 frames, u64 host_time_us, const Counters& start, const Counters& end)
+{
+  const double host_seconds = host_time_us / 1000000.0;
+  const u64 ticks = std::max<u64>(end.ticks - start.ticks, 1);
+  const double emulated_seconds = static_cast<double>(ticks) / SystemTimers::GetTicksPerSecond();
+  const double idle_ratio = static_cast<double>(end.idle_ticks - start.idle_ticks) / ticks;
+
+  return fmt::format(
+      "{{\"core\":\"{}\",\"frames\":{},\"host_seconds\":{:.3f},\"emulated_seconds\":{:.3f},"
+      "\"host_ms_per_emulated_second\":{:.3f},\"idle_ratio\":{:.4f},\"exceptions\":{},"
+      "\"block_cache_misses\":{},\"blocks_compiled\":{},\"compile_ms\":{:.3f}}}\n",
+      GetCoreName(SConfig::GetInstance().cpu_core), frames, host_seconds, emulated_seconds,
+      host_seconds * 1000.0 / emulated_seconds, idle_ratio, end.exceptions - start.exceptions,
+      end.jit.block_cache_misses - start.jit.block_cache_misses,
+      end.jit.blocks_compiled - start.jit.blocks_compiled,
+      (end.jit.compile_time_us - start.jit.compile_time_us) / 1000.0);
+}
+
+bool WaitForState(Platform* platform, Core::State state)
+{
+  while (platform->IsRunning() && Core::GetState() != state)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  return platform->IsRunning();
+}
+
+// Emulates the given number of frames from a paused state and pauses again. The host time is
+// off by how long it takes to notice the pause, which is a millisecond at most.
+bool RunFrames(Platform* platform, u32 frames, u64* host_time_us)
+{
+  u64 end_frame = 0;
+  Core::RunAsCPUThread([&] {
+    end_frame = Movie::GetCurrentFrame() + frames;
+    Core::BreakAtFrame(end_frame);
+  });
+
+  const u64 start_time_us = Common::Timer::GetTimeUs();
+  bool done = false;
+  while (!done)
+  {
+    Core::SetState(Core::State::Running);
+    if (!WaitForState(platform, Core::State::Paused))
+      return false;
+    Core::RunAsCPUThread([&] { done = Movie::GetCurrentFrame() >= end_frame; });
+  }
+  *host_time_us = Common::Timer::GetTimeUs() - start_time_us;
+  return true;
+}
+
+int RunBench(const Options& options, Platform* platform)
+{
+  if (!WaitForState(platform, Core::State::Running))
+    return 1;
+
+  // The first frames compile most of the code the game runs, which isn't what the benchmark is
+  // after unless the warm-up is disabled
+  Core::SetState(Core::State::Paused);
+  u64 host_time_us;
+  if (options.warmup != 0 && !RunFrames(platform, options.warmup, &host_time_us))
+    return 1;
+
+  Counters start;
+  Core::RunAsCPUThread([&] { start = ReadCounters(); });
+  if (!RunFrames(platform, options.frames, &host_time_us))
+    return 1;
+  Counters end;
+  Core::RunAsCPUThread([&] { end = ReadCounters(); });
+
+  const std::string report = MakeReport(options.frames, host_time_us, start, end);
+  if (options.report_path.empty())
+  {
+    std::fputs(report.c_str(), stdout);
+    std::fflush(stdout);
+  }
+  else if (!File::WriteStringToFile(options.report_path, report))
+  {
+    std::fprintf(stderr, "Could not write the report to %s\n", options.report_path.c_str());
+    return 1;
+  }
+
+  return 0;
+}
+}  // Anonymous namespace
+
+void AddOptions(optparse::OptionParser* parser)
+{
+  parser->add_option("--cpu_bench")
+      .action("store")
+      .type("int")
+      .help("Time this many frames with only the CPU core doing work, report and exit");
+  parser->add_option("--cpu_bench_warmup")
+      .action("store")
+      .type("int")
+      .help("Frames to emulate before timing starts (default: 60)");
+  parser->add_option("--cpu_bench_core")
+      .action("store")
+      .choices({"interpreter", "cachedinterpreter", "jit64", "jitarm64"})
+      .help("CPU core to benchmark [%choices] (default: the configured one)");
+  parser->add_option("--cpu_bench_report")
+      .action("store")
+      .help("Where to write the benchmark report (default: stdout)");
+}
+
+std::optional<Options> GetOptions(const optparse::Values& values)
+{
+  if (!values.is_set("cpu_bench"))
+    return std::nullopt;
+
+  Options options;
+  options.frames = static_cast<u32>(std::max(static_cast<int>(values.get("cpu_bench")), 1));
+  if (values.is_set("cpu_bench_warmup"))
+  {
+    const int warmup = static_cast<int>(values.get("cpu_bench_warmup"));
+    options.warmup = static_cast<u32>(std::max(warmup, 0));
+  }
+  if (values.is_set("cpu_bench_core"))
+  {
+    const std::string core = static_cast<const char*>(values.get("cpu_bench_core"));
+    for (const PowerPC::CPUCore candidate :
+         {PowerPC::CPUCore::Interpreter, PowerPC::CPUCore::CachedInterpreter,
+          PowerPC::CPUCore::JIT64, PowerPC::CPUCore::JITARM64})
+    {
+      if (core == GetCoreName(candidate))
+        options.cpu_core = candidate;
+    }
+  }
+  if (values.is_set("cpu_bench_report"))
+    options.report_path = static_cast<const char*>(values.get("cpu_bench_report"));
+  return options;
+}
+
+void ApplyConfig(const Options& options)
+{
+  Config::SetCurrent(Config::MAIN_GFX_BACKEND, "Null");
+
+  SConfig& config = SConfig::GetInstance();
+  config.sBackend = BACKEND_NULLSOUND;
+  config.m_EmulationSpeed = 0.0f;
+  if (options.cpu_core)
+    config.cpu_core = *options.cpu_core;
+}
+
+void Start(const Options& options, Platform* platform)
+{
+  s_thread = std::thread([options, platform] {
+    s_exit_code = RunBench(options, platform);
+    platform->Stop();
+  });
+}
+
+int Finish()
+{
+  if (s_thread.joinable())
+    s_thread.join();
+  return s_exit_code;
+}
+}  // namespace CPUBench
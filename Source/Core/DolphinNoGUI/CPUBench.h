@@ -0,0 +1,52 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <optional>
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+namespace optparse
+{
+class OptionParser;
+class Values;
+}  // namespace optparse
+
+namespace PowerPC
+{
+enum class CPUCore;
+}
+
+class Platform;
+
+// CPU core benchmarking: boots (usually straight into a savestate with -s), emulates some
+// warm-up frames, then times a fixed number of frames with the Null video backend, no audio
+// output and no speed limit, so that the result only depends on the CPU core. Along with the host
+// time per emulated second, it reports how much the JIT compiled and how often execution left
+// compiled code, which helps to tell apart regressions in generated code from ones in the JIT.
+namespace CPUBench
+{
+struct Options
+{
+  u32 frames = 0;
+  u32 warmup = 60;
+  std::optional<PowerPC::CPUCore> cpu_core;
+  std::string report_path;
+};
+
+void AddOptions(optparse::OptionParser* parser);
+// Returns nothing if a benchmark wasn't requested
+std::optional<Options> GetOptions(const optparse::Values& options);
+
+// Switches to the Null video backend, no audio output, an unlimited emulation speed and the
+// requested CPU core
+void ApplyConfig(const Options& options);
+
+// Runs the benchmark on its own thread once the core has started, then asks the platform to shut
+// down. The result is also returned through the exit code: 0 on success.
+void Start(const Options& options, Platform* platform);
+int Finish();
+}  // namespace CPUBench
@@ -0,0 +1,219 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "DolphinNoGUI/FifoBench.h"
+
+#include <OptionParser.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/FileUtil.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/FifoPlayer/FifoDataFile.h"
+#include "Core/FifoPlayer/FifoPlayer.h"
+#include "DolphinNoGUI/Platform.h"
+#include "VideoCommon/RenderBase.h"
+
+namespace FifoBench
+{
+namespace
+{
+std::thread s_thread;
+std::atomic<int> s_exit_code{0};
+
+// Only touched on the CPU thread, from the frame written callback
+u32 s_passes_started = 0;
+std::atomic<bool> s_finished{false};
+
+bool WaitForState(Platform* platform, Core::State state)
+{
+  while (platform->IsRunning() && Core::GetState() != state)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  return platform->IsRunning();
+}
+
+// Called by the FIFO player before each frame is written. Recording starts and stops at the
+// beginning of a pass, so that the measured frames cover whole passes over the range.
+void OnFrameWritten(const Options& options)
+{
+  const FifoPlayer& player = FifoPlayer::GetInstance();
+  if (player.GetCurrentFrameNum() != player.GetFrameRangeStart())
+    return;
+
+  const u32 pass = s_passes_started++;
+  if (pass == options.warmup)
+  {
+    g_renderer->SetFrameTimingRecording(true);
+  }
+  else if (pass == options.warmup + options.iterations)
+  {
+    g_renderer->SetFrameTimingRecording(false);
+    s_finished = true;
+  }
+}
+
+std::string MakeReport(const std::vector<Renderer::FrameTiming>& timings)
+{
+  std::string report = "frame,frame_time_us,swap_time_us\n";
+  for (size_t i = 0; i < timings.size(); ++i)
+    report += fmt::format("{},{},{}\n", i, timings[i].frame_time_us, timings[i].swap_time_us);
+  return report;
+}
+
+std::string MakeSummary(const Options& options, const std::vector<Renderer::FrameTiming>& timings)
+{
+  if (timings.empty())
+    return "No frames were presented during the benchmark\n";
+
+  std::vector<u64> frame_times(timings.size());
+  u64 total_frame_time = 0;
+  u64 total_swap_time = 0;
+  for (size_t i = 0; i < timings.size(); ++i)
+  {
+    frame_times[i] = timings[i].frame_time_us;
+    total_frame_time += timings[i].frame_time_us;
+    total_swap_time += timings[i].swap_time_us;
+  }
+  std::sort(frame_times.begin(), frame_times.end());
+
+  const double count = static_cast<double>(timings.size());
+  const u64 p99 = frame_times[std::min(frame_times.size() - 1, frame_times.size() * 99 / 100)];
+  return fmt::format("{} frames over {} passes: {:.3f} ms average frame time "
+                     "({:.3f} ms in Swap), {:.3f} ms minimum, {:.3f} ms 99th percentile\n",
+                     timings.size(), options.iterations, total_frame_time / count / 1000.0,
+                     total_swap_time / count / 1000.0, frame_times.front() / 1000.0,
+                     p99 / 1000.0);
+}
+
+int RunBench(const Options& options, Platform* platform)
+{
+  if (!WaitForState(platform, Core::State::Running))
+    return 1;
+
+  bool has_frames = false;
+  Core::RunAsCPUThread([&] {
+    FifoPlayer& player = FifoPlayer::GetInstance();
+    if (!player.GetFile())
+      return;
+
+    player.SetFrameRangeEnd(options.end_frame.value_or(player.GetFile()->GetFrameCount()));
+    player.SetFrameRangeStart(options.first_frame.value_or(0));
+    has_frames = player.GetFrameRangeStart() < player.GetFrameRangeEnd();
+
+    s_passes_started = 0;
+    s_finished = false;
+    player.SetFrameWrittenCallback([options] { OnFrameWritten(options); });
+  });
+
+  if (!has_frames)
+  {
+    std::fputs("A FIFO log with at least one frame in the range is required\n", stderr);
+    return 1;
+  }
+
+  while (platform->IsRunning() && !s_finished)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  Core::RunAsCPUThread([] { FifoPlayer::GetInstance().SetFrameWrittenCallback(nullptr); });
+  if (!s_finished)
+    return 1;
+
+  const std::vector<Renderer::FrameTiming> timings = g_renderer->TakeFrameTimings();
+  const std::string report = MakeReport(timings);
+  const std::string summary = MakeSummary(options, timings);
+
+  if (options.report_path.empty())
+  {
+    std::fputs(report.c_str(), stdout);
+    std::fflush(stdout);
+    std::fputs(summary.c_str(), stderr);
+  }
+  else if (!File::WriteStringToFile(options.report_path, report))
+  {
+    std::fprintf(stderr, "Could not write the report to %s\n", options.report_path.c_str());
+    return 1;
+  }
+  else
+  {
+    std::fputs(summary.c_str(), stdout);
+  }
+
+  return 0;
+}
+}  // Anonymous namespace
+
+void AddOptions(optparse::OptionParser* parser)
+{
+  parser->add_option("--fifo_bench")
+      .action("store")
+      .type("int")
+      .help("Play the FIFO log in a loop and time this many passes over the frame range");
+  parser->add_option("--fifo_bench_warmup")
+      .action("store")
+      .type("int")
+      .help("Passes to play before timing starts (default: 1)");
+  parser->add_option("--fifo_bench_start")
+      .action("store")
+      .type("int")
+      .help("First frame of the benchmarked range (default: 0)");
+  parser->add_option("--fifo_bench_end")
+      .action("store")
+      .type("int")
+      .help("Frame the benchmarked range ends before (default: end of the log)");
+  parser->add_option("--fifo_bench_report")
+      .action("store")
+      .help("Where to write the per-frame timings as CSV (default: stdout)");
+}
+
+std::optional<Options> GetOptions(const optparse::Values& values)
+{
+  if (!values.is_set("fifo_bench"))
+    return std::nullopt;
+
+  Options options;
+  options.iterations = static_cast<u32>(std::max(static_cast<int>(values.get("fifo_bench")), 1));
+  if (values.is_set("fifo_bench_warmup"))
+  {
+    const int warmup = static_cast<int>(values.get("fifo_bench_warmup"));
+    options.warmup = static_cast<u32>(std::max(warmup, 0));
+  }
+  if (values.is_set("fifo_bench_start"))
+    options.first_frame = static_cast<u32>(static_cast<int>(values.get("fifo_bench_start")));
+  if (values.is_set("fifo_bench_end"))
+    options.end_frame = static_cast<u32>(static_cast<int>(values.get("fifo_bench_end")));
+  if (values.is_set("fifo_bench_report"))
+    options.report_path = static_cast<const char*>(values.get("fifo_bench_report"));
+  return options;
+}
+
+void ApplyConfig()
+{
+  SConfig& config = SConfig::GetInstance();
+  config.bLoopFifoReplay = true;
+  config.sBackend = BACKEND_NULLSOUND;
+  config.m_EmulationSpeed = 0.0f;
+}
+
+void Start(const Options& options, Platform* platform)
+{
+  s_thread = std::thread([options, platform] {
+    s_exit_code = RunBench(options, platform);
+    platform->Stop();
+  });
+}
+
+int Finish()
+{
+  if (s_thread.joinable())
+    s_thread.join();
+  return s_exit_code;
+}
+}  // namespace FifoBench
@@ -0,0 +1,45 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <optional>
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+namespace optparse
+{
+class OptionParser;
+class Values;
+}  // namespace optparse
+
+class Platform;
+
+// GPU benchmarking: plays a frame range of a FIFO log in a loop, discards the first passes as
+// warm-up, then records the timings of every frame presented during the measured passes and
+// writes them out as CSV, along with a summary. The video backend comes from the usual config.
+namespace FifoBench
+{
+struct Options
+{
+  u32 iterations = 0;
+  u32 warmup = 1;
+  std::optional<u32> first_frame;
+  std::optional<u32> end_frame;
+  std::string report_path;
+};
+
+void AddOptions(optparse::OptionParser* parser);
+// Returns nothing if a benchmark wasn't requested
+std::optional<Options> GetOptions(const optparse::Values& options);
+
+// Loops FIFO playback, disables audio output and removes the emulation speed limit
+void ApplyConfig();
+
+// Runs the benchmark on its own thread once the core has started, then asks the platform to shut
+// down. The result is also returned through the exit code: 0 on success.
+void Start(const Options& options, Platform* platform);
+int Finish();
+}  // namespace FifoBench
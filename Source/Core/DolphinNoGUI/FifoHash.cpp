@@ -0,0 +1,166 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "DolphinNoGUI/FifoHash.h"
+
+#include <OptionParser.h>
+#include <array>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+#include <fmt/format.h>
+#include <xxhash.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Core/ConfigManager.h"
+#include "VideoCommon/RenderBase.h"
+
+namespace FifoHash
+{
+namespace
+{
+// The perceptual hash compares the brightness of neighbouring cells in a grid of this size
+constexpr int GRID_WIDTH = 9;
+constexpr int GRID_HEIGHT = 8;
+
+struct FrameHash
+{
+  int width;
+  int height;
+  u64 image_hash;
+  u64 perceptual_hash;
+};
+
+std::mutex s_hashes_mutex;
+std::vector<FrameHash> s_hashes;
+
+u64 HashImage(const u8* data, int width, int height, int stride)
+{
+  const size_t row_size = static_cast<size_t>(width) * 4;
+  if (static_cast<size_t>(stride) == row_size)
+    return XXH64(data, row_size * height, 0);
+
+  XXH64_state_t* const state = XXH64_createState();
+  XXH64_reset(state, 0);
+  for (int y = 0; y < height; ++y)
+    XXH64_update(state, data + static_cast<size_t>(y) * stride, row_size);
+  const u64 hash = XXH64_digest(state);
+  XXH64_freeState(state);
+  return hash;
+}
+
+// Difference hash: averages the brightness of each grid cell, then sets one bit for every pair of
+// horizontally adjacent cells that gets brighter to the right. Small changes in the image, like
+// filtering or precision differences, only flip a few bits.
+u64 PerceptualHash(const u8* data, int width, int height, int stride)
+{
+  std::vector<int> cell_x(width);
+  for (int x = 0; x < width; ++x)
+    cell_x[x] = x * GRID_WIDTH / width;
+
+  // Luma scaled by 1000, to stay in integers
+  std::array<u64, GRID_WIDTH * GRID_HEIGHT> sums{};
+  std::array<u64, GRID_WIDTH * GRID_HEIGHT> counts{};
+  for (int y = 0; y < height; ++y)
+  {
+    const u8* row = data + static_cast<size_t>(y) * stride;
+    const int cell_row = y * GRID_HEIGHT / height * GRID_WIDTH;
+    for (int x = 0; x < width; ++x)
+    {
+      const u8* pixel = row + x * 4;
+      const int cell = cell_row + cell_x[x];
+      sums[cell] += pixel[0] * 299 + pixel[1] * 587 + pixel[2] * 114;
+      counts[cell]++;
+    }
+  }
+
+  u64 hash = 0;
+  for (int y = 0; y < GRID_HEIGHT; ++y)
+  {
+    for (int x = 0; x < GRID_WIDTH - 1; ++x)
+    {
+      // Compare the averages without dividing
+      const int left = y * GRID_WIDTH + x;
+      const int right = left + 1;
+      hash = (hash << 1) | (sums[left] * counts[right] < sums[right] * counts[left]);
+    }
+  }
+  return hash;
+}
+
+void OnFrameReadback(const u8* data, int width, int height, int stride)
+{
+  const FrameHash frame_hash{width, height, HashImage(data, width, height, stride),
+                             PerceptualHash(data, width, height, stride)};
+
+  std::lock_guard<std::mutex> guard(s_hashes_mutex);
+  s_hashes.push_back(frame_hash);
+}
+
+std::string MakeReport()
+{
+  std::string report = "frame,width,height,image_hash,perceptual_hash\n";
+  for (size_t i = 0; i < s_hashes.size(); ++i)
+  {
+    const FrameHash& frame_hash = s_hashes[i];
+    report += fmt::format("{},{},{},{:016x},{:016x}\n", i, frame_hash.width, frame_hash.height,
+                          frame_hash.image_hash, frame_hash.perceptual_hash);
+  }
+  return report;
+}
+}  // Anonymous namespace
+
+void AddOptions(optparse::OptionParser* parser)
+{
+  parser->add_option("--fifo_hash")
+      .action("store_true")
+      .help("Play a FIFO log once without a window, report hashes of every frame and exit");
+  parser->add_option("--fifo_hash_report")
+      .action("store")
+      .help("Where to write the frame hashes as CSV (default: stdout)");
+}
+
+std::optional<Options> GetOptions(const optparse::Values& values)
+{
+  if (!values.is_set("fifo_hash"))
+    return std::nullopt;
+
+  Options options;
+  if (values.is_set("fifo_hash_report"))
+    options.report_path = static_cast<const char*>(values.get("fifo_hash_report"));
+  return options;
+}
+
+void ApplyConfig()
+{
+  SConfig& config = SConfig::GetInstance();
+  config.bLoopFifoReplay = false;
+  config.sBackend = BACKEND_NULLSOUND;
+  config.m_EmulationSpeed = 0.0f;
+
+  Renderer::SetFrameReadbackCallback(OnFrameReadback);
+}
+
+int Finish(const Options& options)
+{
+  Renderer::SetFrameReadbackCallback(nullptr);
+
+  std::lock_guard<std::mutex> guard(s_hashes_mutex);
+  const std::string report = MakeReport();
+  if (options.report_path.empty())
+  {
+    std::fputs(report.c_str(), stdout);
+    std::fflush(stdout);
+  }
+  else if (!File::WriteStringToFile(options.report_path, report))
+  {
+    std::fprintf(stderr, "Could not write the report to %s\n", options.report_path.c_str());
+    return 1;
+  }
+
+  return s_hashes.empty() ? 1 : 0;
+}
+}  // namespace FifoHash
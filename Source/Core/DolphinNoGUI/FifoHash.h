@@ -0,0 +1,37 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <optional>
+#include <string>
+
+namespace optparse
+{
+class OptionParser;
+class Values;
+}  // namespace optparse
+
+// Rendering regression runs: plays a FIFO log once without a window, reads back every presented
+// frame and reports a hash of the image along with a perceptual hash, which stays close for
+// images that look alike. Many of these can run side by side on one GPU.
+namespace FifoHash
+{
+struct Options
+{
+  std::string report_path;
+};
+
+void AddOptions(optparse::OptionParser* parser);
+// Returns nothing if frame hashing wasn't requested
+std::optional<Options> GetOptions(const optparse::Values& options);
+
+// Plays FIFO logs only once, disables audio output, removes the emulation speed limit and starts
+// hashing the frames that will be presented
+void ApplyConfig();
+
+// Stops hashing and writes the report. Call after the core shut down, since the last frame is
+// only read back then. Returns the exit code: 0 on success.
+int Finish(const Options& options);
+}  // namespace FifoHash
@@ -3,6 +3,10 @@
 // Refer to the license.txt file included.
 
 #include "DolphinNoGUI/Platform.h"
+#include "DolphinNoGUI/BatchMode.h"
+#include "DolphinNoGUI/CPUBench.h"
+#include "DolphinNoGUI/FifoBench.h"
+#include "DolphinNoGUI/FifoHash.h"
 
 #include <OptionParser.h>
 #include <cstddef>
@@ -22,6 +26,8 @@
 #include "Core/BootManager.h"
 #include "Core/Core.h"
 #include "Core/Host.h"
+#include "Core/InputScript.h"
+#include "Core/Movie.h"
 
 #include "UICommon/CommandLineParse.h"
 #ifdef USE_DISCORD_PRESENCE
@@ -108,6 +114,11 @@ void Host_TitleChanged()
 
 static std::unique_ptr<Platform> GetPlatform(const optparse::Values& options)
 {
+  // Batch, frame hashing and CPU benchmark runs never show anything
+  if (BatchMode::GetOptions(options) || FifoHash::GetOptions(options) ||
+      CPUBench::GetOptions(options))
+    return Platform::CreateHeadlessPlatform();
+
   std::string platform_name = static_cast<const char*>(options.get("platform"));
 
 #if HAVE_X11
@@ -153,8 +164,24 @@ int main(int argc, char* argv[])
 #endif
       });
 
+  parser->add_option("--input_script")
+      .action("store")
+      .help("Replace controller input with the frame-exact inputs of this script");
+  BatchMode::AddOptions(parser.get());
+  FifoBench::AddOptions(parser.get());
+  FifoHash::AddOptions(parser.get());
+  CPUBench::AddOptions(parser.get());
+
   optparse::Values& options = CommandLineParse::ParseArguments(parser.get(), argc, argv);
   std::vector<std::string> args = parser->args();
+  const std::optional<BatchMode::Options> batch_options = BatchMode::GetOptions(options);
+  const std::optional<FifoBench::Options> bench_options =
+      batch_options ? std::nullopt : FifoBench::GetOptions(options);
+  const std::optional<FifoHash::Options> hash_options =
+      batch_options || bench_options ? std::nullopt : FifoHash::GetOptions(options);
+  const std::optional<CPUBench::Options> cpu_bench_options =
+      batch_options || bench_options || hash_options ? std::nullopt :
+                                                       CPUBench::GetOptions(options);
 
   std::optional<std::string> save_state_path;
   if (options.is_set("save_state"))
@@ -203,6 +230,24 @@ int main(int argc, char* argv[])
   UICommon::SetUserDirectory(user_directory);
   UICommon::Init();
 
+  if (options.is_set("movie"))
+  {
+    // Movies are played back the way they were recorded, as with the GUI
+    Movie::SetReadOnly(true);
+    if (!Movie::PlayInput(static_cast<const char*>(options.get("movie")), &boot->savestate_path))
+    {
+      fprintf(stderr, "Could not play the movie\n");
+      return 1;
+    }
+  }
+
+  if (options.is_set("input_script") &&
+      !InputScript::Load(static_cast<const char*>(options.get("input_script"))))
+  {
+    fprintf(stderr, "Could not load the input script\n");
+    return 1;
+  }
+
   s_platform = GetPlatform(options);
   if (!s_platform || !s_platform->Init())
   {
@@ -234,6 +279,15 @@ int main(int argc, char* argv[])
   sigaction(SIGTERM, &sa, nullptr);
 #endif
 
+  if (batch_options)
+    BatchMode::ApplyConfig();
+  else if (bench_options)
+    FifoBench::ApplyConfig();
+  else if (hash_options)
+    FifoHash::ApplyConfig();
+  else if (cpu_bench_options)
+    CPUBench::ApplyConfig(*cpu_bench_options);
+
   DolphinAnalytics::Instance().ReportDolphinStart("nogui");
 
   if (!BootManager::BootCore(std::move(boot), s_platform->GetWindowSystemInfo()))
@@ -246,12 +300,28 @@ int main(int argc, char* argv[])
   Discord::UpdateDiscordPresence();
 #endif
 
+  if (batch_options)
+    BatchMode::Start(*batch_options, s_platform.get());
+  else if (bench_options)
+    FifoBench::Start(*bench_options, s_platform.get());
+  else if (cpu_bench_options)
+    CPUBench::Start(*cpu_bench_options, s_platform.get());
+
   s_platform->MainLoop();
+  int exit_code = 0;
+  if (batch_options)
+    exit_code = BatchMode::Finish();
+  else if (bench_options)
+    exit_code = FifoBench::Finish();
+  else if (cpu_bench_options)
+    exit_code = CPUBench::Finish();
   Core::Stop();
 
   Core::Shutdown();
+  if (hash_options)
+    exit_code = FifoHash::Finish(*hash_options);
   s_platform.reset();
   UICommon::Shutdown();
 
-  return 0;
+  return exit_code;
 }
@@ -41,6 +41,16 @@ GameConfigEdit::GameConfigEdit(QWidget* parent, QString path, bool read_only)
                  tr("Shortens loading times but may break some games. Can have negative effects on "
                     "performance. Defaults to <b>False</b>"));
 
+  AddDescription(QStringLiteral("FastBulkDiscReads"),
+                 tr("Shortens loading times by skipping the seek and read time of large disc reads "
+                    "once the game has booted, while keeping accurate timing for small reads. "
+                    "Breaks fewer games than FastDiscSpeed. Defaults to <b>False</b>"));
+
+  AddDescription(QStringLiteral("SyncGpuAdaptive"),
+                 tr("With SyncGPU, adjusts how far the CPU thread may run ahead of the GPU thread "
+                    "to how the GPU thread keeps up, within a quarter and four times "
+                    "SyncGpuMaxDistance. Off during NetPlay and movies. Defaults to <b>False</b>"));
+
   AddDescription(QStringLiteral("MMU"), tr("Controls whether or not the Memory Management Unit "
                                            "should be emulated fully. Few games require it."));
 
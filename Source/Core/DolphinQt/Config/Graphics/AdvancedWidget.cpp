@@ -54,11 +54,19 @@ void AdvancedWidget::CreateWidgets()
       new GraphicsBool(tr("Texture Format Overlay"), Config::GFX_TEXFMT_OVERLAY_ENABLE);
   m_enable_api_validation =
       new GraphicsBool(tr("Enable API Validation Layers"), Config::GFX_ENABLE_VALIDATION_LAYER);
+  m_show_frame_profiler = new GraphicsBool(tr("Show Frame Profiler"), Config::GFX_OVERLAY_PROFILER);
+  m_export_frame_profile =
+      new GraphicsBool(tr("Export Frame Profile"), Config::GFX_EXPORT_PROFILER_CSV);
+  m_show_jit_statistics =
+      new GraphicsBool(tr("Show JIT Statistics"), Config::GFX_OVERLAY_JIT_STATS);
 
   debugging_layout->addWidget(m_enable_wireframe, 0, 0);
   debugging_layout->addWidget(m_show_statistics, 0, 1);
   debugging_layout->addWidget(m_enable_format_overlay, 1, 0);
   debugging_layout->addWidget(m_enable_api_validation, 1, 1);
+  debugging_layout->addWidget(m_show_frame_profiler, 2, 0);
+  debugging_layout->addWidget(m_export_frame_profile, 2, 1);
+  debugging_layout->addWidget(m_show_jit_statistics, 3, 0);
 
   // Utility
   auto* utility_box = new QGroupBox(tr("Utility"));
@@ -113,6 +121,8 @@ void AdvancedWidget::CreateWidgets()
   m_use_fullres_framedumps = new GraphicsBool(tr("Dump at Internal Resolution"),
                                               Config::GFX_INTERNAL_RESOLUTION_FRAME_DUMPS);
   m_dump_use_ffv1 = new GraphicsBool(tr("Use Lossless Codec (FFV1)"), Config::GFX_USE_FFV1);
+  m_dump_hardware_encoder =
+      new GraphicsBool(tr("Use Hardware Encoder"), Config::GFX_DUMP_HARDWARE_ENCODER);
   m_dump_bitrate = new GraphicsInteger(0, 1000000, Config::GFX_BITRATE_KBPS, 1000);
 
   dump_layout->addWidget(m_use_fullres_framedumps, 0, 0);
@@ -120,6 +130,7 @@ void AdvancedWidget::CreateWidgets()
   dump_layout->addWidget(m_dump_use_ffv1, 0, 1);
   dump_layout->addWidget(new QLabel(tr("Bitrate (kbps):")), 1, 0);
   dump_layout->addWidget(m_dump_bitrate, 1, 1);
+  dump_layout->addWidget(m_dump_hardware_encoder, 2, 0);
 #endif
 
   // Misc.
@@ -177,6 +188,7 @@ void AdvancedWidget::LoadSettings()
 {
   m_prefetch_custom_textures->setEnabled(Config::Get(Config::GFX_HIRES_TEXTURES));
   m_dump_bitrate->setEnabled(!Config::Get(Config::GFX_USE_FFV1));
+  m_dump_hardware_encoder->setEnabled(!Config::Get(Config::GFX_USE_FFV1));
 
   m_enable_prog_scan->setChecked(Config::Get(Config::SYSCONF_PROGRESSIVE_SCAN));
 
@@ -189,6 +201,7 @@ void AdvancedWidget::SaveSettings()
 {
   m_prefetch_custom_textures->setEnabled(Config::Get(Config::GFX_HIRES_TEXTURES));
   m_dump_bitrate->setEnabled(!Config::Get(Config::GFX_USE_FFV1));
+  m_dump_hardware_encoder->setEnabled(!Config::Get(Config::GFX_USE_FFV1));
 
   Config::SetBase(Config::SYSCONF_PROGRESSIVE_SCAN, m_enable_prog_scan->isChecked());
 
@@ -212,6 +225,18 @@ void AdvancedWidget::AddDescriptions()
       QT_TR_NOOP("Renders the scene as a wireframe.\n\nIf unsure, leave this unchecked.");
   static const char TR_SHOW_STATS_DESCRIPTION[] =
       QT_TR_NOOP("Shows various rendering statistics.\n\nIf unsure, leave this unchecked.");
+  static const char TR_SHOW_FRAME_PROFILER_DESCRIPTION[] = QT_TR_NOOP(
+      "Shows how long each frame took, and how much of it was spent on the CPU and GPU "
+      "threads, waiting for the GPU, decoding textures, compiling shaders, reading back EFB "
+      "copies and presenting.\n\nIf unsure, leave this unchecked.");
+  static const char TR_SHOW_JIT_STATISTICS_DESCRIPTION[] = QT_TR_NOOP(
+      "Shows how often the JIT had to look blocks up, compile them, throw them away and "
+      "patch faulting memory accesses, in total and during the last frame.\n\nIf unsure, "
+      "leave this unchecked.");
+  static const char TR_EXPORT_FRAME_PROFILE_DESCRIPTION[] = QT_TR_NOOP(
+      "Writes the frame profiler's timings for every frame to FrameProfile.csv in the Logs "
+      "folder. Once the file grows past ten minutes at 60 FPS, it is moved to FrameProfile.1.csv "
+      "and a new one is started.\n\nIf unsure, leave this unchecked.");
   static const char TR_TEXTURE_FORMAT_DESCRIPTION[] = QT_TR_NOOP(
       "Modifies textures to show the format they're encoded in.\n\nMay require an emulation "
       "reset to apply.\n\nIf unsure, leave this unchecked.");
@@ -252,6 +277,11 @@ void AdvancedWidget::AddDescriptions()
 #if defined(HAVE_FFMPEG)
   static const char TR_USE_FFV1_DESCRIPTION[] =
       QT_TR_NOOP("Encodes frame dumps using the FFV1 codec.\n\nIf unsure, leave this unchecked.");
+  static const char TR_HARDWARE_ENCODER_DESCRIPTION[] = QT_TR_NOOP(
+      "Encodes frame dumps with the GPU's video encoder (NVENC, AMF, Quick Sync, VAAPI or "
+      "VideoToolbox) when one is available, falling back to the software encoder otherwise. "
+      "Uses H.264 unless another codec is configured.\n\nGreatly reduces the performance cost "
+      "of frame dumping at high resolutions.\n\nIf unsure, leave this unchecked.");
 #endif
   static const char TR_FREE_LOOK_DESCRIPTION[] = QT_TR_NOOP(
       "Allows manipulation of the in-game camera. Move the mouse while holding the right button "
@@ -295,6 +325,9 @@ void AdvancedWidget::AddDescriptions()
   AddDescription(m_show_statistics, TR_SHOW_STATS_DESCRIPTION);
   AddDescription(m_enable_format_overlay, TR_TEXTURE_FORMAT_DESCRIPTION);
   AddDescription(m_enable_api_validation, TR_VALIDATION_LAYER_DESCRIPTION);
+  AddDescription(m_show_frame_profiler, TR_SHOW_FRAME_PROFILER_DESCRIPTION);
+  AddDescription(m_export_frame_profile, TR_EXPORT_FRAME_PROFILE_DESCRIPTION);
+  AddDescription(m_show_jit_statistics, TR_SHOW_JIT_STATISTICS_DESCRIPTION);
   AddDescription(m_dump_textures, TR_DUMP_TEXTURE_DESCRIPTION);
   AddDescription(m_dump_mip_textures, TR_DUMP_MIP_TEXTURE_DESCRIPTION);
   AddDescription(m_dump_base_textures, TR_DUMP_BASE_TEXTURE_DESCRIPTION);
@@ -305,6 +338,7 @@ void AdvancedWidget::AddDescriptions()
   AddDescription(m_use_fullres_framedumps, TR_INTERNAL_RESOLUTION_FRAME_DUMPING_DESCRIPTION);
 #ifdef HAVE_FFMPEG
   AddDescription(m_dump_use_ffv1, TR_USE_FFV1_DESCRIPTION);
+  AddDescription(m_dump_hardware_encoder, TR_HARDWARE_ENCODER_DESCRIPTION);
 #endif
   AddDescription(m_enable_cropping, TR_CROPPING_DESCRIPTION);
   AddDescription(m_enable_prog_scan, TR_PROGRESSIVE_SCAN_DESCRIPTION);
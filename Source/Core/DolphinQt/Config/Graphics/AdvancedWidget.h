@@ -32,6 +32,9 @@ private:
   QCheckBox* m_show_statistics;
   QCheckBox* m_enable_format_overlay;
   QCheckBox* m_enable_api_validation;
+  QCheckBox* m_show_frame_profiler;
+  QCheckBox* m_show_jit_statistics;
+  QCheckBox* m_export_frame_profile;
 
   // Utility
   QCheckBox* m_prefetch_custom_textures;
@@ -48,6 +51,7 @@ private:
 
   // Frame dumping
   QCheckBox* m_dump_use_ffv1;
+  QCheckBox* m_dump_hardware_encoder;
   QCheckBox* m_use_fullres_framedumps;
   QSpinBox* m_dump_bitrate;
 
@@ -91,6 +91,8 @@ void EnhancementsWidget::CreateWidgets()
       new GraphicsBool(tr("Force 24-Bit Color"), Config::GFX_ENHANCE_FORCE_TRUE_COLOR);
   m_disable_copy_filter =
       new GraphicsBool(tr("Disable Copy Filter"), Config::GFX_ENHANCE_DISABLE_COPY_FILTER);
+  m_dynamic_resolution =
+      new GraphicsBool(tr("Dynamic Internal Resolution"), Config::GFX_DYNAMIC_RESOLUTION);
   m_arbitrary_mipmap_detection = new GraphicsBool(tr("Arbitrary Mipmap Detection"),
                                                   Config::GFX_ENHANCE_ARBITRARY_MIPMAP_DETECTION);
 
@@ -113,6 +115,7 @@ void EnhancementsWidget::CreateWidgets()
   enhancements_layout->addWidget(m_force_24bit_color, 7, 1);
   enhancements_layout->addWidget(m_disable_copy_filter, 8, 0);
   enhancements_layout->addWidget(m_arbitrary_mipmap_detection, 8, 1);
+  enhancements_layout->addWidget(m_dynamic_resolution, 9, 0);
 
   // Stereoscopy
   auto* stereoscopy_box = new QGroupBox(tr("Stereoscopy"));
@@ -364,6 +367,11 @@ void EnhancementsWidget::AddDescriptions()
       "resolution, such as in games that use very low resolution mipmaps. Disabling this can also "
       "reduce stutter in games that frequently load new textures. This feature is not compatible "
       "with GPU Texture Decoding.\n\nIf unsure, leave this checked.");
+  static const char TR_DYNAMIC_RESOLUTION_DESCRIPTION[] = QT_TR_NOOP(
+      "Lowers the internal resolution while the GPU can't keep up, and raises it back up to the "
+      "selected internal resolution when there is headroom again.\n\nOnly works in dual core "
+      "mode. Changing the resolution briefly clears the screen in some games.\n\nIf unsure, "
+      "leave this unchecked.");
 
   AddDescription(m_ir_combo, TR_INTERNAL_RESOLUTION_DESCRIPTION);
   AddDescription(m_aa_combo, TR_ANTIALIAS_DESCRIPTION);
@@ -377,6 +385,7 @@ void EnhancementsWidget::AddDescriptions()
   AddDescription(m_force_texture_filtering, TR_FORCE_TEXTURE_FILTERING_DESCRIPTION);
   AddDescription(m_disable_copy_filter, TR_DISABLE_COPY_FILTER_DESCRIPTION);
   AddDescription(m_arbitrary_mipmap_detection, TR_ARBITRARY_MIPMAP_DETECTION_DESCRIPTION);
+  AddDescription(m_dynamic_resolution, TR_DYNAMIC_RESOLUTION_DESCRIPTION);
   AddDescription(m_3d_mode, TR_3D_MODE_DESCRIPTION);
   AddDescription(m_3d_depth, TR_3D_DEPTH_DESCRIPTION);
   AddDescription(m_3d_convergence, TR_3D_CONVERGENCE_DESCRIPTION);
@@ -42,6 +42,7 @@ private:
   QCheckBox* m_force_24bit_color;
   QCheckBox* m_disable_copy_filter;
   QCheckBox* m_arbitrary_mipmap_detection;
+  QCheckBox* m_dynamic_resolution;
 
   // Stereoscopy
   QComboBox* m_3d_mode;
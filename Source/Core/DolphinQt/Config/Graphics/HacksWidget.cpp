@@ -107,11 +107,14 @@ void HacksWidget::CreateWidgets()
   m_vertex_rounding = new GraphicsBool(tr("Vertex Rounding"), Config::GFX_HACK_VERTEX_ROUDING);
   m_save_texture_cache_state =
       new GraphicsBool(tr("Save Texture Cache to State"), Config::GFX_SAVE_TEXTURE_CACHE_TO_STATE);
+  m_save_only_vram_copies_state = new GraphicsBool(tr("Skip RAM-Backed Copies in States"),
+                                                   Config::GFX_SAVE_ONLY_VRAM_COPIES_TO_STATE);
 
   other_layout->addWidget(m_fast_depth_calculation, 0, 0);
   other_layout->addWidget(m_disable_bounding_box, 0, 1);
   other_layout->addWidget(m_vertex_rounding, 1, 0);
   other_layout->addWidget(m_save_texture_cache_state, 1, 1);
+  other_layout->addWidget(m_save_only_vram_copies_state, 2, 0);
 
   main_layout->addWidget(efb_box);
   main_layout->addWidget(texture_cache_box);
@@ -265,6 +268,12 @@ void HacksWidget::AddDescriptions()
       "Includes the contents of the embedded frame buffer (EFB) and upscaled EFB copies "
       "in save states. Fixes missing and/or non-upscaled textures/objects when loading "
       "states at the cost of additional save/load time.\n\nIf unsure, leave this checked.");
+  static const char TR_SAVE_ONLY_VRAM_COPIES_TO_STATE_DESCRIPTION[] = QT_TR_NOOP(
+      "Leaves EFB copies which were also written to RAM out of save states, and only saves "
+      "the ones which exist in video memory alone. Makes saving states faster and the files "
+      "smaller, but those textures are decoded from RAM at native resolution after loading "
+      "until the game copies them again.\n\nOnly has an effect when Save Texture Cache to State is "
+      "enabled.\n\nIf unsure, leave this unchecked.");
   static const char TR_VERTEX_ROUNDING_DESCRIPTION[] =
       QT_TR_NOOP("Rounds 2D vertices to whole pixels.\n\nFixes graphical problems in some games at "
                  "higher internal resolutions. This setting has no effect when native internal "
@@ -282,6 +291,7 @@ void HacksWidget::AddDescriptions()
   AddDescription(m_fast_depth_calculation, TR_FAST_DEPTH_CALC_DESCRIPTION);
   AddDescription(m_disable_bounding_box, TR_DISABLE_BOUNDINGBOX_DESCRIPTION);
   AddDescription(m_save_texture_cache_state, TR_SAVE_TEXTURE_CACHE_TO_STATE_DESCRIPTION);
+  AddDescription(m_save_only_vram_copies_state, TR_SAVE_ONLY_VRAM_COPIES_TO_STATE_DESCRIPTION);
   AddDescription(m_vertex_rounding, TR_VERTEX_ROUNDING_DESCRIPTION);
 }
 
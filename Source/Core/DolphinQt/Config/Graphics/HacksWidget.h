@@ -44,6 +44,7 @@ private:
   QCheckBox* m_disable_bounding_box;
   QCheckBox* m_vertex_rounding;
   QCheckBox* m_save_texture_cache_state;
+  QCheckBox* m_save_only_vram_copies_state;
   QCheckBox* m_defer_efb_copies;
 
   void CreateWidgets();
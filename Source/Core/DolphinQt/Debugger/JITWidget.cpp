@@ -10,14 +10,75 @@
 #include <QTextBrowser>
 #include <QVBoxLayout>
 
+#include <vector>
+
 #include "Common/GekkoDisassembler.h"
+#include "Common/Hash.h"
 #include "Common/StringUtil.h"
+#include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "UICommon/Disassembler.h"
 
 #include "DolphinQt/Host.h"
+#include "DolphinQt/QtUtils/QueueOnObject.h"
 #include "DolphinQt/Settings.h"
 
+// The cache is dropped as a whole once it holds this many blocks
+constexpr size_t MAX_CACHED_BLOCKS = 256;
+
+namespace
+{
+struct PPCBlock
+{
+  struct Instruction
+  {
+    u32 address;
+    u32 hex;
+  };
+
+  std::vector<Instruction> instructions;
+  bool is_first_block_of_function;
+  bool is_last_block_of_function;
+  int num_cycles;
+};
+}  // namespace
+
+static std::string DisassemblePPCBlock(const PPCBlock& block, u32 host_instructions_count,
+                                       u32 host_code_size)
+{
+  const u32 num_instructions = static_cast<u32>(block.instructions.size());
+
+  std::ostringstream ppc_disasm;
+  for (const PPCBlock::Instruction& instruction : block.instructions)
+  {
+    const std::string opcode =
+        Common::GekkoDisassembler::Disassemble(instruction.hex, instruction.address);
+    ppc_disasm << std::setfill('0') << std::setw(8) << std::hex << instruction.address;
+    ppc_disasm << " " << opcode << std::endl;
+  }
+
+  // Add stats to the end of the ppc box since it's generally the shortest.
+  ppc_disasm << std::dec << std::endl;
+
+  // Add some generic analysis
+  if (block.is_first_block_of_function)
+    ppc_disasm << "(first block of function)" << std::endl;
+  if (block.is_last_block_of_function)
+    ppc_disasm << "(last block of function)" << std::endl;
+
+  ppc_disasm << block.num_cycles << " estimated cycles" << std::endl;
+
+  ppc_disasm << "Num instr: PPC: " << num_instructions << " Host: " << host_instructions_count
+             << " (blowup: " << 100 * host_instructions_count / num_instructions - 100 << "%)"
+             << std::endl;
+
+  ppc_disasm << "Num bytes: PPC: " << num_instructions * 4 << " Host: " << host_code_size
+             << " (blowup: " << 100 * host_code_size / (4 * num_instructions) - 100 << "%)"
+             << std::endl;
+
+  return ppc_disasm.str();
+}
+
 JITWidget::JITWidget(QWidget* parent) : QDockWidget(parent)
 {
   setWindowTitle(tr("JIT Blocks"));
@@ -63,6 +124,8 @@ JITWidget::JITWidget(QWidget* parent) : QDockWidget(parent)
 
 JITWidget::~JITWidget()
 {
+  m_jobs.Wait();
+
   auto& settings = Settings::GetQSettings();
 
   settings.setValue(QStringLiteral("jitwidget/geometry"), saveGeometry());
@@ -139,15 +202,27 @@ void JITWidget::Update()
 
   // TODO: Actually do something with the table (Wx doesn't)
 
-  // Get host side code disassembly
-  u32 host_instructions_count = 0;
-  u32 host_code_size = 0;
-  std::string host_instructions_disasm;
-  host_instructions_disasm =
-      DisassembleBlock(m_disassembler.get(), &m_address, &host_instructions_count, &host_code_size);
-
-  m_host_asm_widget->setHtml(
-      QStringLiteral("<pre>%1</pre>").arg(QString::fromStdString(host_instructions_disasm)));
+  // Find the block's host code. Reading it is cheap, disassembling it is what takes time.
+  u32 block_address = m_address;
+  const u8* code = nullptr;
+  u32 code_size = 0;
+  const int host_code_result = JitInterface::GetHostCode(&block_address, &code, &code_size);
+  if (host_code_result == 0)
+    m_address = block_address;
+
+  const CacheKey key{m_address, code, code_size};
+  u64 code_hash = 0;
+  if (host_code_result == 0)
+  {
+    code_hash = Common::GetHash64(code, code_size, 0);
+    const auto it = m_cache.find(key);
+    if (it != m_cache.end() && it->second.code_hash == code_hash)
+    {
+      ++m_request;
+      ShowDisassembly(it->second.disassembly);
+      return;
+    }
+  }
 
   // == Fill in ppc box
   u32 ppc_addr = m_address;
@@ -164,48 +239,78 @@ void JITWidget::Update()
   code_block.m_gpa = &gpa;
   code_block.m_fpa = &fpa;
 
-  if (analyzer.Analyze(ppc_addr, &code_block, &code_buffer, code_buffer.size()) != 0xFFFFFFFF)
-  {
-    std::ostringstream ppc_disasm;
-    for (u32 i = 0; i < code_block.m_num_instructions; i++)
-    {
-      const PPCAnalyst::CodeOp& op = code_buffer[i];
-      const std::string opcode = Common::GekkoDisassembler::Disassemble(op.inst.hex, op.address);
-      ppc_disasm << std::setfill('0') << std::setw(8) << std::hex << op.address;
-      ppc_disasm << " " << opcode << std::endl;
-    }
-
-    // Add stats to the end of the ppc box since it's generally the shortest.
-    ppc_disasm << std::dec << std::endl;
-
-    // Add some generic analysis
-    if (st.isFirstBlockOfFunction)
-      ppc_disasm << "(first block of function)" << std::endl;
-    if (st.isLastBlockOfFunction)
-      ppc_disasm << "(last block of function)" << std::endl;
-
-    ppc_disasm << st.numCycles << " estimated cycles" << std::endl;
-
-    ppc_disasm << "Num instr: PPC: " << code_block.m_num_instructions
-               << " Host: " << host_instructions_count << " (blowup: "
-               << 100 * host_instructions_count / code_block.m_num_instructions - 100 << "%)"
-               << std::endl;
-
-    ppc_disasm << "Num bytes: PPC: " << code_block.m_num_instructions * 4
-               << " Host: " << host_code_size
-               << " (blowup: " << 100 * host_code_size / (4 * code_block.m_num_instructions) - 100
-               << "%)" << std::endl;
-
-    m_ppc_asm_widget->setHtml(
-        QStringLiteral("<pre>%1</pre>").arg(QString::fromStdString(ppc_disasm.str())));
-  }
-  else
+  if (analyzer.Analyze(ppc_addr, &code_block, &code_buffer, code_buffer.size()) == 0xFFFFFFFF)
   {
+    ++m_request;
     m_host_asm_widget->setHtml(
         QStringLiteral("<pre>%1</pre>")
             .arg(QString::fromStdString(StringFromFormat("(non-code address: %08x)", m_address))));
     m_ppc_asm_widget->setHtml(QStringLiteral("<i>---</i>"));
+    return;
   }
+
+  // Both sides are disassembled on the thread pool from copies, so that the block can change
+  // under the code cache without affecting the job.
+  PPCBlock ppc_block;
+  ppc_block.instructions.reserve(code_block.m_num_instructions);
+  for (u32 i = 0; i < code_block.m_num_instructions; i++)
+    ppc_block.instructions.push_back({code_buffer[i].address, code_buffer[i].inst.hex});
+  ppc_block.is_first_block_of_function = st.isFirstBlockOfFunction;
+  ppc_block.is_last_block_of_function = st.isLastBlockOfFunction;
+  ppc_block.num_cycles = st.numCycles;
+
+  std::vector<u8> host_code;
+  if (host_code_result == 0)
+    host_code.assign(code, code + code_size);
+
+  m_ppc_asm_widget->setHtml(QStringLiteral("<i>%1</i>").arg(tr("(disassembling...)")));
+  m_host_asm_widget->setHtml(QStringLiteral("<i>%1</i>").arg(tr("(disassembling...)")));
+
+  const u64 request = ++m_request;
+  m_jobs.Submit(Common::ThreadPool::Priority::Low, [this, request, key, code_hash,
+                                                    host_code_result,
+                                                    ppc_block = std::move(ppc_block),
+                                                    host_code = std::move(host_code)] {
+    Disassembly disassembly;
+    u32 host_instructions_count = 0;
+    const u32 host_code_size = static_cast<u32>(host_code.size());
+    if (host_code_result == 1)
+    {
+      disassembly.host = "(No JIT active)";
+    }
+    else if (host_code_result == 2)
+    {
+      disassembly.host = "(No translation)";
+    }
+    else
+    {
+      std::lock_guard lk(m_disassembler_mutex);
+      disassembly.host = m_disassembler->DisassembleHostBlock(
+          host_code.data(), host_code_size, &host_instructions_count,
+          reinterpret_cast<u64>(std::get<const u8*>(key)));
+    }
+    disassembly.ppc = DisassemblePPCBlock(ppc_block, host_instructions_count, host_code_size);
+
+    QueueOnObject(this, [this, request, key, code_hash, host_code_result,
+                         disassembly = std::move(disassembly)] {
+      if (host_code_result == 0)
+      {
+        if (m_cache.size() >= MAX_CACHED_BLOCKS)
+          m_cache.clear();
+        m_cache[key] = {code_hash, disassembly};
+      }
+      if (request == m_request)
+        ShowDisassembly(disassembly);
+    });
+  });
+}
+
+void JITWidget::ShowDisassembly(const Disassembly& disassembly)
+{
+  m_host_asm_widget->setHtml(
+      QStringLiteral("<pre>%1</pre>").arg(QString::fromStdString(disassembly.host)));
+  m_ppc_asm_widget->setHtml(
+      QStringLiteral("<pre>%1</pre>").arg(QString::fromStdString(disassembly.ppc)));
 }
 
 void JITWidget::closeEvent(QCloseEvent*)
@@ -5,9 +5,14 @@
 #pragma once
 
 #include <QDockWidget>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
 
 #include "Common/CommonTypes.h"
+#include "Common/ThreadPool.h"
 
 class QCloseEvent;
 class QShowEvent;
@@ -27,7 +32,23 @@ public:
   void Compare(u32 address);
 
 private:
+  struct Disassembly
+  {
+    std::string host;
+    std::string ppc;
+  };
+
+  // A block's address and where its host code lives. The cached text is only used while the
+  // hash of the host code matches, since a block compiled again can end up at the same place.
+  using CacheKey = std::tuple<u32, const u8*, u32>;
+  struct CachedDisassembly
+  {
+    u64 code_hash;
+    Disassembly disassembly;
+  };
+
   void Update();
+  void ShowDisassembly(const Disassembly& disassembly);
   void CreateWidgets();
   void ConnectWidgets();
 
@@ -42,5 +63,11 @@ private:
   QPushButton* m_refresh_button;
 
   std::unique_ptr<HostDisassembler> m_disassembler;
+  // Disassembly runs on the thread pool, a block at a time
+  std::mutex m_disassembler_mutex;
+  Common::ThreadPool::JobGroup m_jobs;
+  std::map<CacheKey, CachedDisassembly> m_cache;
+  // Identifies the latest request, so that results for an earlier selection are only cached
+  u64 m_request = 0;
   u32 m_address = 0;
 };
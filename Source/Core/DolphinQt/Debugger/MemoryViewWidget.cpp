@@ -10,11 +10,15 @@
 #include <QMenu>
 #include <QMouseEvent>
 #include <QScrollBar>
+#include <QTimer>
 
 #include <cctype>
 #include <cmath>
+#include <cstring>
 
+#include "Common/BitUtils.h"
 #include "Common/StringUtil.h"
+#include "Common/Swap.h"
 #include "Core/Core.h"
 #include "Core/HW/AddressSpace.h"
 #include "Core/PowerPC/BreakPoints.h"
@@ -37,7 +41,10 @@ MemoryViewWidget::MemoryViewWidget(QWidget* parent) : QTableWidget(parent)
   setFont(Settings::Instance().GetDebugFont());
 
   connect(&Settings::Instance(), &Settings::DebugFontChanged, this, &QWidget::setFont);
-  connect(&Settings::Instance(), &Settings::EmulationStateChanged, this, [this] { Update(); });
+  connect(&Settings::Instance(), &Settings::EmulationStateChanged, this, [this] {
+    UpdateRefreshTimer();
+    Update();
+  });
   connect(Host::GetInstance(), &Host::UpdateDisasmDialog, this, &MemoryViewWidget::Update);
   connect(this, &MemoryViewWidget::customContextMenuRequested, this,
           &MemoryViewWidget::OnContextMenu);
@@ -45,6 +52,9 @@ MemoryViewWidget::MemoryViewWidget(QWidget* parent) : QTableWidget(parent)
 
   setContextMenuPolicy(Qt::CustomContextMenu);
 
+  m_refresh_timer = new QTimer(this);
+  connect(m_refresh_timer, &QTimer::timeout, this, &MemoryViewWidget::RefreshValues);
+
   Update();
 }
 
@@ -65,6 +75,59 @@ static int GetColumnCount(MemoryViewWidget::Type type)
   }
 }
 
+u32 MemoryViewWidget::GetRowAddress(int row) const
+{
+  return m_address - ((rowCount() / 2) * 16) + row * 16;
+}
+
+bool MemoryViewWidget::CanShowValues() const
+{
+  const Core::State state = Core::GetState();
+  return state == Core::State::Paused || (state == Core::State::Running && m_refresh_interval > 0);
+}
+
+void MemoryViewWidget::FetchValues()
+{
+  m_values.resize(static_cast<size_t>(rowCount()) * 16);
+  AddressSpace::GetAccessors(m_address_space)
+      ->ReadBytes(GetRowAddress(0), m_values.data(), m_values.size());
+}
+
+QString MemoryViewWidget::GetValueText(const u8* value) const
+{
+  switch (m_type)
+  {
+  case Type::U8:
+    return QStringLiteral("%1").arg(value[0], 2, 16, QLatin1Char('0'));
+  case Type::ASCII:
+  {
+    const char character = static_cast<char>(value[0]);
+    return IsPrintableCharacter(character) ? QString{QChar::fromLatin1(character)} :
+                                             QString{QChar::fromLatin1('.')};
+  }
+  case Type::U16:
+  {
+    u16 hex;
+    std::memcpy(&hex, value, sizeof(hex));
+    return QStringLiteral("%1").arg(Common::swap16(hex), 4, 16, QLatin1Char('0'));
+  }
+  case Type::U32:
+  {
+    u32 hex;
+    std::memcpy(&hex, value, sizeof(hex));
+    return QStringLiteral("%1").arg(Common::swap32(hex), 8, 16, QLatin1Char('0'));
+  }
+  case Type::Float32:
+  {
+    u32 hex;
+    std::memcpy(&hex, value, sizeof(hex));
+    return QString::number(Common::BitCast<float>(Common::swap32(hex)));
+  }
+  default:
+    return {};
+  }
+}
+
 void MemoryViewWidget::Update()
 {
   clearSelection();
@@ -83,11 +146,19 @@ void MemoryViewWidget::Update()
 
   setRowCount(rows);
 
+  const bool show_values = CanShowValues();
+  if (show_values)
+    FetchValues();
+  else
+    m_values.clear();
+
+  const int value_size = 16 / GetColumnCount(m_type);
+
   for (int i = 0; i < rows; i++)
   {
     setRowHeight(i, 24);
 
-    u32 addr = m_address - ((rowCount() / 2) * 16) + i * 16;
+    u32 addr = GetRowAddress(i);
 
     auto* bp_item = new QTableWidgetItem;
     bp_item->setFlags(Qt::ItemIsEnabled);
@@ -105,7 +176,7 @@ void MemoryViewWidget::Update()
     if (addr == m_address)
       addr_item->setSelected(true);
 
-    if (Core::GetState() != Core::State::Paused || !accessors->IsValidAddress(addr))
+    if (!show_values || !accessors->IsValidAddress(addr))
     {
       for (int c = 2; c < columnCount(); c++)
       {
@@ -131,67 +202,33 @@ void MemoryViewWidget::Update()
     }
     bool row_breakpoint = true;
 
-    auto update_values = [&](auto value_to_string) {
-      for (int c = 0; c < GetColumnCount(m_type); c++)
+    for (int c = 0; c < GetColumnCount(m_type); c++)
+    {
+      auto* hex_item = new QTableWidgetItem;
+      hex_item->setFlags(Qt::ItemIsEnabled | Qt::ItemIsSelectable);
+      const u32 address = addr + c * value_size;
+
+      if (m_address_space == AddressSpace::Type::Effective &&
+          PowerPC::memchecks.OverlapsMemcheck(address, value_size))
       {
-        auto* hex_item = new QTableWidgetItem;
-        hex_item->setFlags(Qt::ItemIsEnabled | Qt::ItemIsSelectable);
-        const u32 address = addr + c * (16 / GetColumnCount(m_type));
-
-        if (m_address_space == AddressSpace::Type::Effective &&
-            PowerPC::memchecks.OverlapsMemcheck(address, 16 / GetColumnCount(m_type)))
-        {
-          hex_item->setBackground(Qt::red);
-        }
-        else
-        {
-          row_breakpoint = false;
-        }
-        setItem(i, 2 + c, hex_item);
-
-        if (accessors->IsValidAddress(address))
-        {
-          hex_item->setText(value_to_string(address));
-          hex_item->setData(Qt::UserRole, address);
-        }
-        else
-        {
-          hex_item->setFlags(0);
-          hex_item->setText(QStringLiteral("-"));
-        }
+        hex_item->setBackground(Qt::red);
+      }
+      else
+      {
+        row_breakpoint = false;
+      }
+      setItem(i, 2 + c, hex_item);
+
+      if (accessors->IsValidAddress(address))
+      {
+        hex_item->setText(GetValueText(&m_values[i * 16 + c * value_size]));
+        hex_item->setData(Qt::UserRole, address);
+      }
+      else
+      {
+        hex_item->setFlags(0);
+        hex_item->setText(QStringLiteral("-"));
       }
-    };
-    switch (m_type)
-    {
-    case Type::U8:
-      update_values([&accessors](u32 address) {
-        const u8 value = accessors->ReadU8(address);
-        return QStringLiteral("%1").arg(value, 2, 16, QLatin1Char('0'));
-      });
-      break;
-    case Type::ASCII:
-      update_values([&accessors](u32 address) {
-        const char value = accessors->ReadU8(address);
-        return IsPrintableCharacter(value) ? QString{QChar::fromLatin1(value)} :
-                                             QString{QChar::fromLatin1('.')};
-      });
-      break;
-    case Type::U16:
-      update_values([&accessors](u32 address) {
-        const u16 value = accessors->ReadU16(address);
-        return QStringLiteral("%1").arg(value, 4, 16, QLatin1Char('0'));
-      });
-      break;
-    case Type::U32:
-      update_values([&accessors](u32 address) {
-        const u32 value = accessors->ReadU32(address);
-        return QStringLiteral("%1").arg(value, 8, 16, QLatin1Char('0'));
-      });
-      break;
-    case Type::Float32:
-      update_values(
-          [&accessors](u32 address) { return QString::number(accessors->ReadF32(address)); });
-      break;
     }
 
     if (row_breakpoint)
@@ -213,6 +250,47 @@ void MemoryViewWidget::Update()
   update();
 }
 
+// Only touches the cells whose value changed, so the table doesn't get rebuilt and only those
+// cells get repainted.
+void MemoryViewWidget::RefreshValues()
+{
+  if (!isVisible() || m_values.empty())
+    return;
+
+  std::swap(m_values, m_previous_values);
+  FetchValues();
+  if (m_values.size() != m_previous_values.size())
+  {
+    Update();
+    return;
+  }
+
+  const int columns = GetColumnCount(m_type);
+  const int value_size = 16 / columns;
+  for (int i = 0; i < rowCount(); i++)
+  {
+    for (int c = 0; c < columns; c++)
+    {
+      const size_t offset = i * 16 + c * value_size;
+      if (std::memcmp(&m_values[offset], &m_previous_values[offset], value_size) == 0)
+        continue;
+
+      // Cells of invalid addresses aren't selectable and stay as they are
+      QTableWidgetItem* hex_item = item(i, 2 + c);
+      if (hex_item && (hex_item->flags() & Qt::ItemIsSelectable))
+        hex_item->setText(GetValueText(&m_values[offset]));
+    }
+  }
+}
+
+void MemoryViewWidget::UpdateRefreshTimer()
+{
+  if (m_refresh_interval > 0 && Core::GetState() == Core::State::Running)
+    m_refresh_timer->start(m_refresh_interval);
+  else
+    m_refresh_timer->stop();
+}
+
 void MemoryViewWidget::SetAddressSpace(AddressSpace::Type address_space)
 {
   if (m_address_space == address_space)
@@ -257,6 +335,16 @@ void MemoryViewWidget::SetBPLoggingEnabled(bool enabled)
   m_do_log = enabled;
 }
 
+void MemoryViewWidget::SetRefreshInterval(int interval_ms)
+{
+  if (m_refresh_interval == interval_ms)
+    return;
+
+  m_refresh_interval = interval_ms;
+  UpdateRefreshTimer();
+  Update();
+}
+
 void MemoryViewWidget::resizeEvent(QResizeEvent*)
 {
   Update();
@@ -4,10 +4,14 @@
 
 #pragma once
 
+#include <vector>
+
 #include <QTableWidget>
 
 #include "Common/CommonTypes.h"
 
+class QTimer;
+
 namespace AddressSpace
 {
 enum class Type;
@@ -46,6 +50,8 @@ public:
   void SetAddress(u32 address);
 
   void SetBPLoggingEnabled(bool enabled);
+  // While the game runs, values are refreshed this often. 0 only shows them while paused.
+  void SetRefreshInterval(int interval_ms);
 
   u32 GetContextAddress() const;
 
@@ -63,10 +69,23 @@ private:
   void OnCopyAddress();
   void OnCopyHex();
 
+  u32 GetRowAddress(int row) const;
+  bool CanShowValues() const;
+  void FetchValues();
+  QString GetValueText(const u8* value) const;
+  void RefreshValues();
+  void UpdateRefreshTimer();
+
   AddressSpace::Type m_address_space{};
   Type m_type = Type::U8;
   BPType m_bp_type = BPType::ReadWrite;
   bool m_do_log = true;
   u32 m_context_address;
   u32 m_address = 0;
+
+  // Contents of the visible rows, fetched in one go per refresh
+  std::vector<u8> m_values;
+  std::vector<u8> m_previous_values;
+  QTimer* m_refresh_timer;
+  int m_refresh_interval = 0;
 };
@@ -16,6 +16,7 @@
 #include <QRadioButton>
 #include <QScrollArea>
 #include <QSpacerItem>
+#include <QSpinBox>
 #include <QSplitter>
 #include <QTableWidget>
 #include <QVBoxLayout>
@@ -176,6 +177,23 @@ void MemoryWidget::CreateWidgets()
   bp_layout->addWidget(m_bp_log_check);
   bp_layout->setSpacing(1);
 
+  // Auto update
+  auto* refresh_group = new QGroupBox(tr("Auto Update"));
+  auto* refresh_layout = new QVBoxLayout;
+  refresh_group->setLayout(refresh_layout);
+
+  m_refresh_interval = new QSpinBox;
+  m_refresh_interval->setRange(0, 10000);
+  m_refresh_interval->setSingleStep(50);
+  m_refresh_interval->setSuffix(tr(" ms"));
+  m_refresh_interval->setSpecialValueText(tr("Off"));
+  m_refresh_interval->setToolTip(
+      tr("How often values are refreshed while the game is running. When off, values are only "
+         "shown while paused."));
+
+  refresh_layout->addWidget(m_refresh_interval);
+  refresh_layout->setSpacing(1);
+
   // Sidebar
   auto* sidebar = new QWidget;
   auto* sidebar_layout = new QVBoxLayout;
@@ -197,6 +215,7 @@ void MemoryWidget::CreateWidgets()
   sidebar_layout->addWidget(address_space_group);
   sidebar_layout->addWidget(datatype_group);
   sidebar_layout->addWidget(bp_group);
+  sidebar_layout->addWidget(refresh_group);
   sidebar_layout->addItem(new QSpacerItem(0, 0, QSizePolicy::Expanding, QSizePolicy::Expanding));
 
   // Splitter
@@ -250,6 +269,8 @@ void MemoryWidget::ConnectWidgets()
     connect(radio, &QRadioButton::toggled, this, &MemoryWidget::OnBPTypeChanged);
 
   connect(m_bp_log_check, &QCheckBox::toggled, this, &MemoryWidget::OnBPLogChanged);
+  connect(m_refresh_interval, qOverload<int>(&QSpinBox::valueChanged), m_memory_view,
+          &MemoryViewWidget::SetRefreshInterval);
   connect(m_memory_view, &MemoryViewWidget::BreakpointsChanged, this,
           &MemoryWidget::BreakpointsChanged);
   connect(m_memory_view, &MemoryViewWidget::ShowCode, this, &MemoryWidget::ShowCode);
@@ -324,6 +345,10 @@ void MemoryWidget::LoadSettings()
   m_bp_read_only->setChecked(bp_r);
   m_bp_write_only->setChecked(bp_w);
   m_bp_log_check->setChecked(bp_log);
+
+  m_refresh_interval->setValue(
+      settings.value(QStringLiteral("memorywidget/refreshinterval"), 0).toInt());
+  m_memory_view->SetRefreshInterval(m_refresh_interval->value());
 }
 
 void MemoryWidget::SaveSettings()
@@ -350,6 +375,8 @@ void MemoryWidget::SaveSettings()
   settings.setValue(QStringLiteral("memorywidget/bpread"), m_bp_read_only->isChecked());
   settings.setValue(QStringLiteral("memorywidget/bpwrite"), m_bp_write_only->isChecked());
   settings.setValue(QStringLiteral("memorywidget/bplog"), m_bp_log_check->isChecked());
+
+  settings.setValue(QStringLiteral("memorywidget/refreshinterval"), m_refresh_interval->value());
 }
 
 void MemoryWidget::OnAddressSpaceChanged()
@@ -17,6 +17,7 @@ class QLineEdit;
 class QPushButton;
 class QRadioButton;
 class QShowEvent;
+class QSpinBox;
 class QSplitter;
 
 class MemoryWidget : public QDockWidget
@@ -97,4 +98,6 @@ private:
   QRadioButton* m_bp_read_only;
   QRadioButton* m_bp_write_only;
   QCheckBox* m_bp_log_check;
+
+  QSpinBox* m_refresh_interval;
 };
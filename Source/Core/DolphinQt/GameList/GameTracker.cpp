@@ -4,6 +4,9 @@
 
 #include "DolphinQt/GameList/GameTracker.h"
 
+#include <string>
+#include <vector>
+
 #include <QDir>
 #include <QDirIterator>
 #include <QFile>
@@ -252,6 +255,8 @@ void GameTracker::RemoveDirectoryInternal(const QString& dir)
 
 void GameTracker::UpdateDirectoryInternal(const QString& dir)
 {
+  QVector<QString> new_paths;
+
   auto it = GetIterator(dir);
   while (it->hasNext())
   {
@@ -267,10 +272,12 @@ void GameTracker::UpdateDirectoryInternal(const QString& dir)
     {
       AddPath(path);
       m_tracked_files[path] = QSet<QString>{dir};
-      LoadGame(path);
+      new_paths.push_back(path);
     }
   }
 
+  LoadGames(new_paths);
+
   for (const auto& missing : FindMissingFiles(dir))
   {
     auto& tracked_file = m_tracked_files[missing];
@@ -341,6 +348,28 @@ void GameTracker::LoadGame(const QString& path)
   }
 }
 
+void GameTracker::LoadGames(const QVector<QString>& paths)
+{
+  if (!m_started || paths.empty())
+    return;
+
+  std::vector<std::string> converted_paths;
+  converted_paths.reserve(paths.size());
+  for (const QString& path : paths)
+  {
+    std::string converted_path = path.toStdString();
+    if (!DiscIO::ShouldHideFromGameList(converted_path))
+      converted_paths.push_back(std::move(converted_path));
+  }
+
+  // The cache is saved once for the whole batch, since saving rewrites all of it
+  const bool cache_changed = m_cache.AddOrGet(
+      converted_paths,
+      [this](const std::shared_ptr<const UICommon::GameFile>& game) { emit GameLoaded(game); });
+  if (cache_changed)
+    m_cache.Save();
+}
+
 void GameTracker::PurgeCache()
 {
   m_load_thread.EmplaceItem(Command{CommandType::PurgeCache, {}});
@@ -59,6 +59,7 @@ private:
   void UpdateFileInternal(const QString& path);
   QSet<QString> FindMissingFiles(const QString& dir);
   void LoadGame(const QString& path);
+  void LoadGames(const QVector<QString>& paths);
 
   bool AddPath(const QString& path);
   bool RemovePath(const QString& path);
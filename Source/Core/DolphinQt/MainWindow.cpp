@@ -11,12 +11,15 @@
 #include <QFileDialog>
 #include <QFileInfo>
 #include <QIcon>
+#include <QInputDialog>
 #include <QMimeData>
 #include <QStackedWidget>
 #include <QVBoxLayout>
 #include <QWindow>
 
+#include <algorithm>
 #include <future>
+#include <limits>
 #include <optional>
 
 #if defined(__unix__) || defined(__unix) || defined(__APPLE__)
@@ -501,6 +504,7 @@ void MainWindow::ConnectMenuBar()
   connect(m_menu_bar, &MenuBar::StartRecording, this, &MainWindow::OnStartRecording);
   connect(m_menu_bar, &MenuBar::StopRecording, this, &MainWindow::OnStopRecording);
   connect(m_menu_bar, &MenuBar::ExportRecording, this, &MainWindow::OnExportRecording);
+  connect(m_menu_bar, &MenuBar::SeekRecording, this, &MainWindow::OnSeekRecording);
   connect(m_menu_bar, &MenuBar::ShowTASInput, this, &MainWindow::ShowTASInput);
 
   // View
@@ -977,6 +981,10 @@ void MainWindow::StartGame(std::unique_ptr<BootParameters>&& parameters)
   // If we're running, only start a new game once we've stopped the last.
   if (Core::GetState() != Core::State::Uninitialized)
   {
+    // Swapping the game in place keeps the render window and the video backend up
+    if (Core::WarmBoot(std::move(parameters)))
+      return;
+
     //Narrysmod - Replace RequestStop with plain old Stop
     ForceStop();
     /*
@@ -1675,6 +1683,26 @@ void MainWindow::OnExportRecording()
     Core::SetState(Core::State::Running);
 }
 
+void MainWindow::OnSeekRecording()
+{
+  if (!Movie::IsPlayingInput())
+    return;
+
+  bool ok = false;
+  const int frame = QInputDialog::getInt(
+      this, tr("Seek to Frame"), tr("Frame:"), static_cast<int>(Movie::GetCurrentFrame()), 1,
+      static_cast<int>(std::min<u64>(Movie::GetTotalFrames(), std::numeric_limits<int>::max())),
+      1, &ok);
+  if (!ok)
+    return;
+
+  if (!Movie::SeekToFrame(static_cast<u64>(frame)))
+  {
+    ModalMessageBox::critical(this, tr("Error"),
+                              tr("This frame can't be reached from the states kept so far."));
+  }
+}
+
 void MainWindow::OnActivateChat()
 {
   if (g_netplay_chat_ui)
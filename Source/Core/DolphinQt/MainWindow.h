@@ -179,6 +179,7 @@ private:
   void OnStartRecording();
   void OnStopRecording();
   void OnExportRecording();
+  void OnSeekRecording();
   void OnActivateChat();
   void OnRequestGolfControl();
   void ShowTASInput();
@@ -106,6 +106,7 @@ signals:
   void StartRecording();
   void StopRecording();
   void ExportRecording();
+  void SeekRecording();
   void ShowTASInput();
 
   void SelectionChanged(std::shared_ptr<const UICommon::GameFile> game_file);
@@ -223,6 +224,7 @@ private:
   QAction* m_recording_start;
   QAction* m_recording_stop;
   QAction* m_recording_read_only;
+  QAction* m_recording_seek;
 
   // Options
   QAction* m_boot_to_pause;
@@ -1,11 +1,24 @@
 #include "stdafx.h"
 
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Common/Config/Config.h"
 #include "Common/SPSCQueue.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/HW/DSP.h"
 #include "Core/HW/Memmap.h"
 
 #include "DolphinMemoryDomain.h"
+#include "NarrysMod/VanguardBlast.h"
+#include "NarrysMod/VanguardLockstep.h"
+#include "NarrysMod/VanguardReplay.h"
+#include "NarrysMod/VanguardSnapshot.h"
+#include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PPCCache.h"
 #include "Core/PowerPC/Jit64Common/Jit64PowerPCState.h"
 
@@ -41,6 +54,54 @@ using namespace Diagnostics;
 
 delegate void MessageDelegate(Object^);
 
+// Clamps [address, address + length) to a domain of the given size once so the bulk paths can
+// copy straight out of the backing memory. Returns the number of bytes that are in range.
+static int ClampRange(long long address, int length, long long size)
+{
+  if (address < 0 || length <= 0 || address >= size)
+    return 0;
+  return static_cast<int>(std::min<long long>(length, size - address));
+}
+
+// Copies out of a flat host buffer into a pinned managed array. Bytes outside the domain read
+// back as zero, matching PeekByte.
+static array<unsigned char> ^ PeekRange(const u8* base, long long address, int length,
+                                        long long size) {
+  array<unsigned char> ^ bytes = gcnew array<unsigned char>(std::max(length, 0));
+  const int count = ClampRange(address, length, size);
+  if (count == 0 || base == nullptr)
+    return bytes;
+
+  pin_ptr<unsigned char> pinned = &bytes[0];
+  std::memcpy(pinned, base + address, count);
+  return bytes;
+}
+
+// Copies a managed array into a flat host buffer. Returns the number of bytes written.
+static int PokeRange(u8* base, long long address, array<unsigned char> ^ data, long long size)
+{
+  if (data == nullptr || base == nullptr)
+    return 0;
+  const int count = ClampRange(address, data->Length, size);
+  if (count == 0)
+    return 0;
+
+  pin_ptr<unsigned char> pinned = &data[0];
+  std::memcpy(base + address, pinned, count);
+  return count;
+}
+
+// Logs pokes that went through a domain for corruption replays
+static void RecordPokes(VanguardBlast::Domain domain, long long address,
+                        array<unsigned char> ^ data, int count)
+{
+  if (count <= 0 || !VanguardReplay::IsRecording())
+    return;
+
+  pin_ptr<unsigned char> pinned = &data[0];
+  VanguardReplay::Record(domain, static_cast<u32>(address), pinned, count);
+}
+
 String^ SRAM::Name::get()
 {
   return "SRAM";
@@ -74,25 +135,31 @@ unsigned char SRAM::PeekByte(long long addr)
 
 array<unsigned char>^ SRAM::PeekBytes(long long address, int length)
 {
-  array<unsigned char> ^ bytes = gcnew array<unsigned char>(length);
-  for (int i = 0; i < length; i++)
-  {
-    bytes[i] = PeekByte(address + i);
-  }
-  return bytes;
+  return PeekRange(Memory::m_pRAM, address, length, SRAM_SIZE);
 }
 
 void SRAM::PokeByte(long long addr, unsigned char val)
 {
   if (addr < SRAM_SIZE)
   {
+    VanguardReplay::Record(VanguardBlast::Domain::SRAM, static_cast<u32>(addr), &val, 1);
     // Convert the address
     addr += SRAM_OFFSET;
     Memory::Write_U8(val, static_cast<u32>(addr));
     PowerPC::ppcState.iCache.Invalidate(addr);
+    if (Config::Get(Config::MAIN_VANGUARD_PRECISE_CODE_INVALIDATION))
+      JitInterface::InvalidateExternalWrite(static_cast<u32>(addr), 1);
   }
 }
 
+void SRAM::PokeBytes(long long address, array<unsigned char> ^ data)
+{
+  const int count = PokeRange(Memory::m_pRAM, address, data, SRAM_SIZE);
+  RecordPokes(VanguardBlast::Domain::SRAM, address, data, count);
+  if (count != 0)
+    VanguardBlast::InvalidateCode(static_cast<u32>(address + SRAM_OFFSET), count);
+}
+
 String^ EXRAM::Name::get()
 {
   return "EXRAM";
@@ -126,25 +193,31 @@ unsigned char EXRAM::PeekByte(long long addr)
 
 array<unsigned char>^ EXRAM::PeekBytes(long long address, int length)
 {
-  array<unsigned char> ^ bytes = gcnew array<unsigned char>(length);
-  for (int i = 0; i < length; i++)
-  {
-    bytes[i] = PeekByte(address + i);
-  }
-  return bytes;
+  return PeekRange(Memory::m_pEXRAM, address, length, EXRAM_SIZE);
 }
 
 void EXRAM::PokeByte(long long addr, unsigned char val)
 {
   if (addr < EXRAM_SIZE)
   {
+    VanguardReplay::Record(VanguardBlast::Domain::EXRAM, static_cast<u32>(addr), &val, 1);
     // Convert the address
     addr += EXRAM_OFFSET;
     Memory::Write_U8(val, static_cast<u32>(addr));
     PowerPC::ppcState.iCache.Invalidate(addr);
+    if (Config::Get(Config::MAIN_VANGUARD_PRECISE_CODE_INVALIDATION))
+      JitInterface::InvalidateExternalWrite(static_cast<u32>(addr), 1);
   }
 }
 
+void EXRAM::PokeBytes(long long address, array<unsigned char> ^ data)
+{
+  const int count = PokeRange(Memory::m_pEXRAM, address, data, EXRAM_SIZE);
+  RecordPokes(VanguardBlast::Domain::EXRAM, address, data, count);
+  if (count != 0)
+    VanguardBlast::InvalidateCode(static_cast<u32>(address + EXRAM_OFFSET), count);
+}
+
 String^ ARAM::Name::get()
 {
   return "ARAM";
@@ -178,20 +251,416 @@ unsigned char ARAM::PeekByte(long long addr)
 
 array<unsigned char>^ ARAM::PeekBytes(long long address, int length)
 {
-  array<unsigned char> ^ bytes = gcnew array<unsigned char>(length);
-  for (int i = 0; i < length; i++)
+  // On the Wii the ARAM pointer aliases MEM2 and reads are routed through MEM1, so only the
+  // GameCube layout can be copied flat.
+  if (SConfig::GetInstance().bWii)
   {
-    bytes[i] = PeekByte(address + i);
+    array<unsigned char> ^ bytes = gcnew array<unsigned char>(std::max(length, 0));
+    for (int i = 0; i < length; i++)
+    {
+      bytes[i] = PeekByte(address + i);
+    }
+    return bytes;
   }
-  return bytes;
+  return PeekRange(DSP::GetARAMPtr(), address, length, ARAM_SIZE);
 }
 
 void ARAM::PokeByte(long long addr, unsigned char val)
 {
   if (addr < ARAM_SIZE)
   {
+    VanguardReplay::Record(VanguardBlast::Domain::ARAM, static_cast<u32>(addr), &val, 1);
     // Convert the address
     addr += ARAM_OFFSET;
     DSP::WriteARAM(val, static_cast<u32>(addr));
   }
 }
+
+void ARAM::PokeBytes(long long address, array<unsigned char> ^ data)
+{
+  // ARAM is never executed from, so there is nothing to invalidate
+  if (SConfig::GetInstance().bWii)
+  {
+    if (data == nullptr)
+      return;
+    for (int i = 0; i < data->Length; i++)
+    {
+      PokeByte(address + i, data[i]);
+    }
+    return;
+  }
+  RecordPokes(VanguardBlast::Domain::ARAM, address, data,
+              PokeRange(DSP::GetARAMPtr(), address, data, ARAM_SIZE));
+}
+
+GPUMemoryDomain::GPUMemoryDomain(String ^ name, GPUMemoryAccess::Region region)
+    : m_name(name), m_region(region)
+{
+}
+
+String ^ GPUMemoryDomain::Name::get()
+{
+  return m_name;
+}
+
+long long GPUMemoryDomain::Size::get()
+{
+  return GPUMemoryAccess::GetRegionSize(m_region);
+}
+
+int GPUMemoryDomain::WordSize::get()
+{
+  return WORD_SIZE;
+}
+
+bool GPUMemoryDomain::BigEndian::get()
+{
+  // TMEM and the EFB hold console data, the register files are host-endian structs
+  return m_region == GPUMemoryAccess::Region::TMEM || m_region == GPUMemoryAccess::Region::EFB;
+}
+
+unsigned char GPUMemoryDomain::PeekByte(long long addr)
+{
+  array<unsigned char> ^ bytes = PeekBytes(addr, 1);
+  return bytes[0];
+}
+
+array<unsigned char> ^ GPUMemoryDomain::PeekBytes(long long address, int length)
+{
+  array<unsigned char> ^ bytes = gcnew array<unsigned char>(std::max(length, 0));
+  const int count = ClampRange(address, length, Size);
+  if (count == 0)
+    return bytes;
+
+  pin_ptr<unsigned char> pinned = &bytes[0];
+  VanguardBlast::RunGPUAccesses(
+      {{m_region, false, static_cast<u32>(address), static_cast<u32>(count), pinned}});
+  return bytes;
+}
+
+void GPUMemoryDomain::PokeByte(long long addr, unsigned char val)
+{
+  PokeBytes(addr, gcnew array<unsigned char>{val});
+}
+
+void GPUMemoryDomain::PokeBytes(long long address, array<unsigned char> ^ data)
+{
+  if (data == nullptr)
+    return;
+  const int count = ClampRange(address, data->Length, Size);
+  if (count == 0)
+    return;
+
+  pin_ptr<unsigned char> pinned = &data[0];
+  VanguardBlast::RunGPUAccesses(
+      {{m_region, true, static_cast<u32>(address), static_cast<u32>(count), pinned}});
+  RecordPokes(VanguardBlast::GetGPUDomain(m_region), address, data, count);
+}
+
+static bool ParseDomain(String ^ name, VanguardBlast::Domain* domain)
+{
+  if (name == "SRAM")
+    *domain = VanguardBlast::Domain::SRAM;
+  else if (name == "EXRAM")
+    *domain = VanguardBlast::Domain::EXRAM;
+  else if (name == "ARAM")
+    *domain = VanguardBlast::Domain::ARAM;
+  else if (name == "TMEM")
+    *domain = VanguardBlast::Domain::TMEM;
+  else if (name == "XFMEM")
+    *domain = VanguardBlast::Domain::XF;
+  else if (name == "BPMEM")
+    *domain = VanguardBlast::Domain::BP;
+  else if (name == "CPMEM")
+    *domain = VanguardBlast::Domain::CP;
+  else if (name == "EFB")
+    *domain = VanguardBlast::Domain::EFB;
+  else
+    return false;
+  return true;
+}
+
+static std::vector<VanguardBlast::Poke> BuildPokes(array<String ^> ^ domains,
+                                                   array<long long> ^ addresses,
+                                                   array<array<unsigned char> ^> ^ values)
+{
+  if (domains == nullptr || addresses == nullptr || values == nullptr)
+    return {};
+
+  const int count = std::min({domains->Length, addresses->Length, values->Length});
+  std::vector<VanguardBlast::Poke> pokes;
+  pokes.reserve(count);
+
+  for (int i = 0; i < count; i++)
+  {
+    VanguardBlast::Domain domain;
+    if (!ParseDomain(domains[i], &domain))
+      continue;
+
+    array<unsigned char> ^ value = values[i];
+    if (value == nullptr || addresses[i] < 0)
+      continue;
+
+    for (int j = 0; j < value->Length; j++)
+    {
+      pokes.push_back({domain, static_cast<u32>(addresses[i] + j), value[j]});
+    }
+  }
+
+  return pokes;
+}
+
+void BlastBatch::Apply(array<String ^> ^ domains, array<long long> ^ addresses,
+                       array<array<unsigned char> ^> ^ values)
+{
+  VanguardBlast::Apply(BuildPokes(domains, addresses, values));
+}
+
+void BlastBatch::Queue(array<String ^> ^ domains, array<long long> ^ addresses,
+                       array<array<unsigned char> ^> ^ values)
+{
+  VanguardBlast::Queue(BuildPokes(domains, addresses, values));
+}
+
+int BlastBatch::QueuedBatches::get()
+{
+  return static_cast<int>(VanguardBlast::GetQueuedBatchCount());
+}
+
+static std::string ToUTF8(String ^ str)
+{
+  if (String::IsNullOrEmpty(str))
+    return {};
+
+  array<unsigned char> ^ bytes = Text::Encoding::UTF8->GetBytes(str);
+  pin_ptr<unsigned char> pinned = &bytes[0];
+  return std::string(reinterpret_cast<const char*>(static_cast<unsigned char*>(pinned)),
+                     bytes->Length);
+}
+
+bool CorruptionReplay::StartRecording(String ^ state_path)
+{
+  return VanguardReplay::StartRecording(ToUTF8(state_path));
+}
+
+bool CorruptionReplay::StopRecording()
+{
+  return VanguardReplay::StopRecording();
+}
+
+bool CorruptionReplay::StartReplay(String ^ state_path)
+{
+  return VanguardReplay::StartReplay(ToUTF8(state_path));
+}
+
+void CorruptionReplay::StopReplay()
+{
+  VanguardReplay::StopReplay();
+}
+
+bool CorruptionReplay::Recording::get()
+{
+  return VanguardReplay::IsRecording();
+}
+
+bool CorruptionReplay::Replaying::get()
+{
+  return VanguardReplay::IsReplaying();
+}
+
+bool LockstepComparison::Start(String ^ session, int side, String ^ state_path)
+{
+  return VanguardLockstep::Start(ToUTF8(session), side, ToUTF8(state_path));
+}
+
+void LockstepComparison::Stop()
+{
+  VanguardLockstep::Stop();
+}
+
+bool LockstepComparison::Running::get()
+{
+  return VanguardLockstep::IsRunning();
+}
+
+bool LockstepComparison::GetDivergence(long long % field, long long % tick, String ^ % domain,
+                                       long long % address)
+{
+  VanguardLockstep::Divergence divergence;
+  if (!VanguardLockstep::GetDivergence(&divergence))
+    return false;
+
+  field = static_cast<long long>(divergence.field);
+  tick = static_cast<long long>(divergence.tick);
+  address = divergence.address;
+  if (divergence.out_of_step)
+    domain = String::Empty;
+  else if (divergence.domain == VanguardBlast::Domain::SRAM)
+    domain = "SRAM";
+  else if (divergence.domain == VanguardBlast::Domain::EXRAM)
+    domain = "EXRAM";
+  else
+    domain = "ARAM";
+  return true;
+}
+
+DomainSnapshot::DomainSnapshot(String ^ name, VanguardBlast::Domain domain, std::vector<u8>* data)
+    : m_name(name), m_domain(domain), m_data(data)
+{
+}
+
+DomainSnapshot ^ DomainSnapshot::Take(String ^ domain)
+{
+  VanguardBlast::Domain native_domain;
+  if (!ParseDomain(domain, &native_domain))
+    return nullptr;
+
+  std::vector<u8> data = VanguardSnapshot::Take(native_domain);
+  if (data.empty())
+    return nullptr;
+  return gcnew DomainSnapshot(domain, native_domain, new std::vector<u8>(std::move(data)));
+}
+
+DomainSnapshot::~DomainSnapshot()
+{
+  this->!DomainSnapshot();
+}
+
+DomainSnapshot::!DomainSnapshot()
+{
+  delete m_data;
+  m_data = nullptr;
+}
+
+String ^ DomainSnapshot::Domain::get()
+{
+  return m_name;
+}
+
+long long DomainSnapshot::Size::get()
+{
+  return m_data ? static_cast<long long>(m_data->size()) : 0;
+}
+
+array<long long> ^ DomainSnapshot::Diff()
+{
+  if (!m_data)
+    return gcnew array<long long>(0);
+
+  const std::vector<VanguardBlast::Range> ranges = VanguardSnapshot::Diff(m_domain, *m_data);
+  array<long long> ^ result = gcnew array<long long>(static_cast<int>(ranges.size() * 2));
+  for (size_t i = 0; i < ranges.size(); i++)
+  {
+    result[static_cast<int>(i * 2)] = ranges[i].start;
+    result[static_cast<int>(i * 2 + 1)] = ranges[i].end - ranges[i].start;
+  }
+  return result;
+}
+
+void DomainSnapshot::Update()
+{
+  if (!m_data)
+    return;
+
+  std::vector<u8> data = VanguardSnapshot::Take(m_domain);
+  if (!data.empty())
+    *m_data = std::move(data);
+}
+
+VirtualMemoryDomain::VirtualMemoryDomain(String ^ name, VanguardVirtualDomain::Table* table)
+    : m_name(name), m_table(table)
+{
+}
+
+VirtualMemoryDomain ^ VirtualMemoryDomain::Create(String ^ name, array<String ^> ^ domains,
+                                                  array<long long> ^ starts,
+                                                  array<long long> ^ lengths)
+{
+  if (domains == nullptr || starts == nullptr || lengths == nullptr)
+    return nullptr;
+
+  const int count = std::min({domains->Length, starts->Length, lengths->Length});
+  std::vector<VanguardVirtualDomain::Segment> segments;
+  segments.reserve(count);
+  for (int i = 0; i < count; i++)
+  {
+    VanguardVirtualDomain::Segment segment;
+    if (!ParseDomain(domains[i], &segment.domain) || starts[i] < 0 || lengths[i] < 0 ||
+        starts[i] + lengths[i] > 0x100000000LL)
+    {
+      return nullptr;
+    }
+    segment.start = static_cast<u32>(starts[i]);
+    segment.length = static_cast<u32>(lengths[i]);
+    segments.push_back(segment);
+  }
+
+  return gcnew VirtualMemoryDomain(name,
+                                   new VanguardVirtualDomain::Table(std::move(segments)));
+}
+
+VirtualMemoryDomain::~VirtualMemoryDomain()
+{
+  this->!VirtualMemoryDomain();
+}
+
+VirtualMemoryDomain::!VirtualMemoryDomain()
+{
+  delete m_table;
+  m_table = nullptr;
+}
+
+String ^ VirtualMemoryDomain::Name::get()
+{
+  return m_name;
+}
+
+long long VirtualMemoryDomain::Size::get()
+{
+  return static_cast<long long>(m_table->GetSize());
+}
+
+int VirtualMemoryDomain::WordSize::get()
+{
+  return WORD_SIZE;
+}
+
+bool VirtualMemoryDomain::BigEndian::get()
+{
+  return BIG_ENDIAN;
+}
+
+unsigned char VirtualMemoryDomain::PeekByte(long long addr)
+{
+  if (addr < 0)
+    return 0;
+  u8 value;
+  m_table->Read(static_cast<u64>(addr), &value, 1);
+  return value;
+}
+
+array<unsigned char> ^ VirtualMemoryDomain::PeekBytes(long long address, int length)
+{
+  array<unsigned char> ^ bytes = gcnew array<unsigned char>(std::max(length, 0));
+  if (length <= 0 || address < 0)
+    return bytes;
+
+  pin_ptr<unsigned char> pinned = &bytes[0];
+  m_table->Read(static_cast<u64>(address), pinned, length);
+  return bytes;
+}
+
+void VirtualMemoryDomain::PokeByte(long long addr, unsigned char val)
+{
+  if (addr >= 0)
+    m_table->Write(static_cast<u64>(addr), &val, 1);
+}
+
+void VirtualMemoryDomain::PokeBytes(long long address, array<unsigned char> ^ data)
+{
+  if (data == nullptr || data->Length == 0 || address < 0)
+    return;
+
+  pin_ptr<unsigned char> pinned = &data[0];
+  m_table->Write(static_cast<u64>(address), pinned, data->Length);
+}
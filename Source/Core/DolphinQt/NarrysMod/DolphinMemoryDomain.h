@@ -1,4 +1,12 @@
 #pragma once
+
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "NarrysMod/VanguardBlast.h"
+#include "NarrysMod/VanguardVirtualDomain.h"
+#include "VideoCommon/GPUMemoryAccess.h"
+
 public ref class SRAM : RTCV::CorruptCore::IMemoryDomain
 {
 public:
@@ -9,6 +17,7 @@ public:
   virtual unsigned char PeekByte(long long addr);
   virtual array<unsigned char> ^ PeekBytes(long long address, int length);
   virtual void PokeByte(long long addr, unsigned char val);
+  virtual void PokeBytes(long long address, array<unsigned char> ^ data);
 };
 
 public ref class EXRAM : RTCV::CorruptCore::IMemoryDomain
@@ -22,6 +31,7 @@ public:
   virtual unsigned char PeekByte(long long addr);
   virtual array<unsigned char> ^ PeekBytes(long long address, int length);
   virtual void PokeByte(long long addr, unsigned char val);
+  virtual void PokeBytes(long long address, array<unsigned char> ^ data);
 };
 
 public ref class ARAM : RTCV::CorruptCore::IMemoryDomain
@@ -35,4 +45,137 @@ public:
   virtual unsigned char PeekByte(long long addr);
   virtual array<unsigned char> ^ PeekBytes(long long address, int length);
   virtual void PokeByte(long long addr, unsigned char val);
+  virtual void PokeBytes(long long address, array<unsigned char> ^ data);
+};
+
+// GPU-side state (TMEM, the XF/BP/CP register files and the EFB). Every call is a single batch
+// run on the GPU thread, so prefer PeekBytes/PokeBytes and BlastBatch over byte accesses.
+public ref class GPUMemoryDomain : RTCV::CorruptCore::IMemoryDomain
+{
+public:
+  GPUMemoryDomain(System::String ^ name, GPUMemoryAccess::Region region);
+
+  property System::String^ Name { virtual System::String^ get(); }
+  property long long Size { virtual long long get(); }
+  property int WordSize { virtual int get(); }
+  property bool BigEndian { virtual bool get(); }
+
+  virtual unsigned char PeekByte(long long addr);
+  virtual array<unsigned char> ^ PeekBytes(long long address, int length);
+  virtual void PokeByte(long long addr, unsigned char val);
+  virtual void PokeBytes(long long address, array<unsigned char> ^ data);
+
+private:
+  System::String ^ m_name;
+  GPUMemoryAccess::Region m_region;
+};
+
+// Entry point for applying a whole step's worth of blast units in one go. The arrays are
+// parallel: each unit writes values[i] to addresses[i] in the domain named domains[i].
+public ref class BlastBatch
+{
+public:
+  static void Apply(array<System::String ^> ^ domains, array<long long> ^ addresses,
+                    array<array<unsigned char> ^> ^ values);
+  // Same as Apply, but returns straight away. The units are applied at the following steps, a
+  // slice at a time, so this can be called from a worker thread while the game is running.
+  static void Queue(array<System::String ^> ^ domains, array<long long> ^ addresses,
+                    array<array<unsigned char> ^> ^ values);
+
+  // Batches queued but not yet fully applied
+  static property int QueuedBatches { int get(); }
+};
+
+// Bit-exact reproduction of corruptions. Recording saves a state and logs every poke applied from
+// then on with its emulated tick. Replaying loads that state and re-applies the pokes on the same
+// ticks, without any round trips to the RTC.
+public ref class CorruptionReplay
+{
+public:
+  static bool StartRecording(System::String ^ state_path);
+  // Writes the log next to the state
+  static bool StopRecording();
+  static bool StartReplay(System::String ^ state_path);
+  static void StopReplay();
+
+  static property bool Recording { bool get(); }
+  static property bool Replaying { bool get(); }
+};
+
+// Lockstep memory comparison with a second instance, for A/B testing. Both instances start the
+// same session from the same state, one on each side, and get the same inputs.
+public ref class LockstepComparison
+{
+public:
+  // side is 0 or 1. The state is optional, without one the comparison starts where they are now.
+  static bool Start(System::String ^ session, int side, System::String ^ state_path);
+  static void Stop();
+
+  static property bool Running { bool get(); }
+
+  // Returns false if no divergence was found since the last Start. Otherwise gives the field and
+  // tick it was found on, and the domain and address of the first page that differs. The domain
+  // is empty if the instances weren't even on the same tick.
+  static bool GetDivergence(long long % field, long long % tick, System::String ^ % domain,
+                            long long % address);
+};
+
+// A copy of a whole domain, kept on the native side. Comparing memory before and after a
+// corruption only hands the changed ranges over, rather than pulling the domain through PeekBytes
+// twice.
+public ref class DomainSnapshot
+{
+public:
+  // Returns nullptr if the domain is unknown or isn't available right now
+  static DomainSnapshot ^ Take(System::String ^ domain);
+
+  ~DomainSnapshot();
+  !DomainSnapshot();
+
+  property System::String ^ Domain { System::String ^ get(); }
+  property long long Size { long long get(); }
+
+  // Returns the ranges that changed since the snapshot was taken as (address, length) pairs,
+  // relative to the start of the domain. Fetch their contents with PeekBytes.
+  array<long long> ^ Diff();
+  // Replaces the snapshot with the current contents of the domain
+  void Update();
+
+private:
+  DomainSnapshot(System::String ^ name, VanguardBlast::Domain domain, std::vector<u8>* data);
+
+  System::String ^ m_name;
+  VanguardBlast::Domain m_domain;
+  std::vector<u8>* m_data;
+};
+
+// An RTC virtual memory domain, translated on the native side. Bulk accesses are split into one
+// copy per range instead of going through the real domains a byte at a time.
+public ref class VirtualMemoryDomain : RTCV::CorruptCore::IMemoryDomain
+{
+public:
+  // The arrays are parallel: range i covers lengths[i] bytes from starts[i] in the domain named
+  // domains[i], and the ranges follow each other in the order given. Returns nullptr if a domain
+  // is unknown or a range doesn't fit into 32 bits.
+  static VirtualMemoryDomain ^ Create(System::String ^ name, array<System::String ^> ^ domains,
+                                      array<long long> ^ starts, array<long long> ^ lengths);
+
+  ~VirtualMemoryDomain();
+  !VirtualMemoryDomain();
+
+  property System::String^ Name { virtual System::String^ get(); }
+  property long long Size { virtual long long get(); }
+  property int WordSize { virtual int get(); }
+  property bool BigEndian { virtual bool get(); }
+
+  virtual unsigned char PeekByte(long long addr);
+  virtual array<unsigned char> ^ PeekBytes(long long address, int length);
+  virtual void PokeByte(long long addr, unsigned char val);
+  virtual void PokeBytes(long long address, array<unsigned char> ^ data);
+
+private:
+  VirtualMemoryDomain(System::String ^ name, VanguardVirtualDomain::Table* table);
+
+  System::String ^ m_name;
+  VanguardVirtualDomain::Table* m_table;
 };
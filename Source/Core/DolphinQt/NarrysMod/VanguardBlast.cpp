@@ -0,0 +1,233 @@
+#include "NarrysMod/VanguardBlast.h"
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+
+#include "Common/Config/Config.h"
+#include "Common/SPSCQueue.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/HW/DSP.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "NarrysMod/VanguardReplay.h"
+
+namespace VanguardBlast
+{
+// Keep these in sync with DolphinMemoryDomain.cpp
+constexpr u32 SRAM_SIZE = 25165824;
+constexpr u32 EXRAM_SIZE = 67108864;
+constexpr u32 ARAM_SIZE = 16777216;
+constexpr u32 SRAM_OFFSET = 0x80000000;
+constexpr u32 EXRAM_OFFSET = 0x90000000;
+constexpr u32 ARAM_OFFSET = 0x80000000;
+
+// JIT blocks are tracked per icache line, so there's no point invalidating any finer than this
+constexpr u32 CACHE_LINE_SIZE = 32;
+
+// Number of queued pokes applied between checks of the step's time budget
+constexpr size_t APPLY_SLICE_SIZE = 4096;
+
+static Common::SPSCQueue<std::vector<Poke>> s_queue;
+// Only serialises the producers against each other. The CPU thread never takes it.
+static std::mutex s_queue_push_lock;
+// How much of the batch at the front of the queue has already been applied. CPU thread only.
+static size_t s_front_offset = 0;
+
+std::vector<Range> CoalesceRanges(std::vector<Range> ranges)
+{
+  if (ranges.empty())
+    return ranges;
+
+  std::sort(ranges.begin(), ranges.end(),
+            [](const Range& a, const Range& b) { return a.start < b.start; });
+
+  std::vector<Range> merged;
+  merged.push_back(ranges.front());
+  for (auto it = ranges.begin() + 1; it != ranges.end(); ++it)
+  {
+    Range& last = merged.back();
+    if (it->start <= last.end)
+      last.end = std::max(last.end, it->end);
+    else
+      merged.push_back(*it);
+  }
+  return merged;
+}
+
+GPUMemoryAccess::Region GetGPURegion(Domain domain)
+{
+  switch (domain)
+  {
+  case Domain::TMEM:
+    return GPUMemoryAccess::Region::TMEM;
+  case Domain::XF:
+    return GPUMemoryAccess::Region::XF;
+  case Domain::BP:
+    return GPUMemoryAccess::Region::BP;
+  case Domain::CP:
+    return GPUMemoryAccess::Region::CP;
+  case Domain::EFB:
+  default:
+    return GPUMemoryAccess::Region::EFB;
+  }
+}
+
+Domain GetGPUDomain(GPUMemoryAccess::Region region)
+{
+  switch (region)
+  {
+  case GPUMemoryAccess::Region::TMEM:
+    return Domain::TMEM;
+  case GPUMemoryAccess::Region::XF:
+    return Domain::XF;
+  case GPUMemoryAccess::Region::BP:
+    return Domain::BP;
+  case GPUMemoryAccess::Region::CP:
+    return Domain::CP;
+  case GPUMemoryAccess::Region::EFB:
+  default:
+    return Domain::EFB;
+  }
+}
+
+void ApplyOnCPUThread(const Poke* pokes, size_t count)
+{
+  VanguardReplay::Record(pokes, count);
+
+  const bool is_wii = SConfig::GetInstance().bWii;
+  const bool precise = Config::Get(Config::MAIN_VANGUARD_PRECISE_CODE_INVALIDATION);
+  u8* const aram = DSP::GetARAMPtr();
+
+  std::vector<Range> dirty;
+  dirty.reserve(count);
+
+  // The accesses point into this, so it must not reallocate while they're collected
+  std::vector<u8> gpu_values;
+  gpu_values.reserve(count);
+  std::vector<GPUMemoryAccess::Access> gpu_accesses;
+
+  for (const Poke* it = pokes; it != pokes + count; ++it)
+  {
+    const Poke& poke = *it;
+    switch (poke.domain)
+    {
+    case Domain::TMEM:
+    case Domain::XF:
+    case Domain::BP:
+    case Domain::CP:
+    case Domain::EFB:
+      gpu_values.push_back(poke.value);
+      gpu_accesses.push_back(
+          {GetGPURegion(poke.domain), true, poke.address, 1, &gpu_values.back()});
+      continue;
+    case Domain::SRAM:
+      if (poke.address >= SRAM_SIZE || !Memory::m_pRAM)
+        break;
+      Memory::m_pRAM[poke.address] = poke.value;
+      break;
+    case Domain::EXRAM:
+      if (poke.address >= EXRAM_SIZE || !Memory::m_pEXRAM)
+        break;
+      Memory::m_pEXRAM[poke.address] = poke.value;
+      break;
+    case Domain::ARAM:
+      if (poke.address >= ARAM_SIZE)
+        break;
+      // The Wii aliases ARAM onto MEM2, so go through the regular accessor there
+      if (is_wii || !aram)
+        DSP::WriteARAM(poke.value, poke.address + ARAM_OFFSET);
+      else
+        aram[poke.address] = poke.value;
+      // ARAM is never executed from
+      continue;
+    default:
+      continue;
+    }
+
+    const u32 base = poke.domain == Domain::SRAM ? SRAM_OFFSET : EXRAM_OFFSET;
+    const u32 line = (base + poke.address) & ~(CACHE_LINE_SIZE - 1);
+    dirty.push_back({line, line + CACHE_LINE_SIZE});
+  }
+
+  for (const Range& range : CoalesceRanges(std::move(dirty)))
+  {
+    if (precise)
+      JitInterface::InvalidateExternalWrite(range.start, range.end - range.start);
+    else
+      JitInterface::InvalidateICache(range.start, range.end - range.start, false);
+  }
+
+  GPUMemoryAccess::Run(gpu_accesses);
+}
+
+void Apply(const std::vector<Poke>& pokes)
+{
+  if (pokes.empty())
+    return;
+
+  Core::RunAsCPUThread([&pokes] { ApplyOnCPUThread(pokes.data(), pokes.size()); });
+}
+
+void Queue(std::vector<Poke> pokes)
+{
+  if (pokes.empty())
+    return;
+
+  std::lock_guard<std::mutex> lock(s_queue_push_lock);
+  s_queue.Push(std::move(pokes));
+}
+
+void DrainQueue()
+{
+  if (s_queue.Empty())
+    return;
+
+  // Always make some progress, however small the budget
+  const auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::microseconds(Config::Get(Config::MAIN_VANGUARD_APPLY_BUDGET));
+  do
+  {
+    const std::vector<Poke>& batch = s_queue.Front();
+    const size_t count = std::min(APPLY_SLICE_SIZE, batch.size() - s_front_offset);
+    ApplyOnCPUThread(batch.data() + s_front_offset, count);
+
+    s_front_offset += count;
+    if (s_front_offset == batch.size())
+    {
+      s_queue.Pop();
+      s_front_offset = 0;
+    }
+  } while (!s_queue.Empty() && std::chrono::steady_clock::now() < deadline);
+}
+
+void ClearQueue()
+{
+  while (!s_queue.Empty())
+    s_queue.Pop();
+  s_front_offset = 0;
+}
+
+size_t GetQueuedBatchCount()
+{
+  return s_queue.Size();
+}
+
+void InvalidateCode(u32 address, u32 length)
+{
+  if (Config::Get(Config::MAIN_VANGUARD_PRECISE_CODE_INVALIDATION))
+    JitInterface::InvalidateExternalWrite(address, length);
+  else
+    JitInterface::InvalidateICache(address, length, false);
+}
+
+void RunGPUAccesses(const std::vector<GPUMemoryAccess::Access>& accesses)
+{
+  if (accesses.empty() || !Core::IsRunningAndStarted())
+    return;
+
+  Core::RunAsCPUThread([&accesses] { GPUMemoryAccess::Run(accesses); });
+}
+}  // namespace VanguardBlast
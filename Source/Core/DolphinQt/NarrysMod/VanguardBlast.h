@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/GPUMemoryAccess.h"
+
+// Native side of batched corruption. The managed client collects a whole step's worth of blast
+// units and hands them over in one call so the writes and the JIT invalidation can be amortised.
+namespace VanguardBlast
+{
+enum class Domain : u8
+{
+  SRAM,
+  EXRAM,
+  ARAM,
+  // GPU-side state, applied in a single batch on the GPU thread
+  TMEM,
+  XF,
+  BP,
+  CP,
+  EFB,
+};
+
+struct Poke
+{
+  Domain domain;
+  // Relative to the start of the domain, as seen by the RTC
+  u32 address;
+  u8 value;
+};
+
+struct Range
+{
+  u32 start;
+  u32 end;
+};
+
+// Only valid for the GPU-side domains
+GPUMemoryAccess::Region GetGPURegion(Domain domain);
+Domain GetGPUDomain(GPUMemoryAccess::Region region);
+
+// Merges overlapping and adjacent ranges. The input does not need to be sorted.
+std::vector<Range> CoalesceRanges(std::vector<Range> ranges);
+
+// Applies every poke in a single pass on the CPU thread, then issues one JIT invalidation per
+// coalesced range of touched code. Pokes to GPU-side domains are handed to the GPU thread as a
+// single batch.
+void Apply(const std::vector<Poke>& pokes);
+
+// Same as Apply, for callers that already are on the CPU thread
+void ApplyOnCPUThread(const Poke* pokes, size_t count);
+
+// Hands a batch over to the CPU thread without waiting for it. Safe to call from any thread, so
+// the RTC can generate blasts in the background while the game keeps running.
+void Queue(std::vector<Poke> pokes);
+
+// Applies queued batches, in the order they were queued, until Main.Vanguard.ApplyBudget runs out.
+// Called from the step hook on the CPU thread, so a huge blast is spread over several steps
+// rather than stalling a frame.
+void DrainQueue();
+
+// Drops everything still queued. Only call this while the CPU thread isn't running.
+void ClearQueue();
+
+size_t GetQueuedBatchCount();
+
+// Called after the RTC writes to emulated memory outside of a batch. With
+// Main.Vanguard.PreciseCodeInvalidation set, only the JIT blocks on the touched cache lines are
+// dropped, so the write takes effect straight away even for single bytes.
+void InvalidateCode(u32 address, u32 length);
+
+// Runs a batch of GPU-side accesses from the CPU thread and waits for it to complete
+void RunGPUAccesses(const std::vector<GPUMemoryAccess::Access>& accesses);
+}  // namespace VanguardBlast
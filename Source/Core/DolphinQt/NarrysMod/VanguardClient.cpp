@@ -5,8 +5,12 @@
 
 #include "stdafx.h"
 
+#include "Common/Config/Config.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
+#include "Core/HW/DSP.h"
+#include "Core/HW/Memmap.h"
 #include "Core/State.h"
 
 #include <string>
@@ -14,10 +18,12 @@
 #include "DolphinMemoryDomain.h"
 #include "DolphinQT/MainWindow.h"
 #include "NarrysMod/Helpers.hpp"
+#include "NarrysMod/VanguardBlast.h"
 #include "NarrysMod/VanguardClient.h"
 #include "NarrysMod/VanguardClientInitializer.h"
 #include "NarrysMod/VanguardConfigLoader.h"
 #include "NarrysMod/VanguardSettingsWrapper.h"
+#include "NarrysMod/VanguardStateRing.h"
 
 #include <msclr/marshal_cppstd.h>
 #include <QGuiApplication>
@@ -250,6 +256,13 @@ void VanguardClientInitializer::StartVanguardClient()
     VanguardConnector::ImplyClientConnected();
 }
 
+static void RefreshCachedParams()
+{
+  VanguardClientUnmanaged::OSD_ENABLED =
+      !VanguardClient::enableRTC ||
+      !RTCV::NetCore::Params::IsParamSet(RTCSPEC::CORE_EMULATOROSDDISABLED);
+}
+
 void VanguardClient::StartClient()
 {
 
@@ -271,6 +284,7 @@ void VanguardClient::StartClient()
     if (args[i] == "-DISABLERTC")
     {
       enableRTC = false;
+      VanguardClientUnmanaged::RTC_ENABLED = false;
     }
   }
 
@@ -279,6 +293,7 @@ void VanguardClient::StartClient()
   receiver->MessageReceived +=
       gcnew EventHandler<NetCoreEventArgs ^>(&VanguardClient::OnMessageReceived);
   connector = gcnew VanguardConnector(receiver);
+  RefreshCachedParams();
 }
 
 void VanguardClient::RestartClient()
@@ -307,16 +322,59 @@ static array<MemoryDomainProxy ^> ^
       if (String::IsNullOrWhiteSpace(AllSpec::VanguardSpec->Get<String ^>(VSPEC::OPENROMFILENAME)))
         return gcnew array<MemoryDomainProxy ^>(0);
 
-      array<MemoryDomainProxy ^> ^ interfaces = gcnew array<MemoryDomainProxy ^>(2);
+      array<MemoryDomainProxy ^> ^ interfaces = gcnew array<MemoryDomainProxy ^>(7);
       interfaces[0] = (gcnew MemoryDomainProxy(gcnew SRAM));
       if (isWii())
         interfaces[1] = (gcnew MemoryDomainProxy(gcnew EXRAM));
       else
         interfaces[1] = (gcnew MemoryDomainProxy(gcnew ARAM));
 
+      interfaces[2] = (gcnew MemoryDomainProxy(
+          gcnew GPUMemoryDomain("TMEM", GPUMemoryAccess::Region::TMEM)));
+      interfaces[3] = (gcnew MemoryDomainProxy(
+          gcnew GPUMemoryDomain("XFMEM", GPUMemoryAccess::Region::XF)));
+      interfaces[4] = (gcnew MemoryDomainProxy(
+          gcnew GPUMemoryDomain("BPMEM", GPUMemoryAccess::Region::BP)));
+      interfaces[5] = (gcnew MemoryDomainProxy(
+          gcnew GPUMemoryDomain("CPMEM", GPUMemoryAccess::Region::CP)));
+      interfaces[6] = (gcnew MemoryDomainProxy(
+          gcnew GPUMemoryDomain("EFB", GPUMemoryAccess::Region::EFB)));
+
       return interfaces;
     }
 
+static void AddSharedMemoryView(List<String ^> ^ views, String ^ domain, const std::string& segment,
+                                u32 offset, u32 size)
+{
+  if (segment.empty())
+    return;
+  views->Add(String::Format("{0}|{1}|{2}|{3}", domain, gcnew String(segment.c_str()), offset, size));
+}
+
+// Describes where each domain lives in Dolphin's shared memory so the RTC can map a read-only
+// mirror and peek locally. Entries are "domain|segment name|offset|size". Domains that can't be
+// mapped are left out and keep going through the domain proxies, as do all pokes.
+static array<String ^> ^ GetSharedMemoryViews()
+{
+  List<String ^> ^ views = gcnew List<String ^>();
+  if (!Config::Get(Config::MAIN_VANGUARD_SHARED_MEMORY) || !Memory::IsInitialized())
+    return views->ToArray();
+
+  AddSharedMemoryView(views, "SRAM", Memory::GetSharedMemoryName(),
+                      Memory::GetRamSharedMemoryOffset(), SRAM_SIZE);
+  if (isWii())
+  {
+    AddSharedMemoryView(views, "EXRAM", Memory::GetSharedMemoryName(),
+                        Memory::GetExRamSharedMemoryOffset(), EXRAM_SIZE);
+  }
+  else
+  {
+    AddSharedMemoryView(views, "ARAM", DSP::GetARAMSharedMemoryName(), 0, ARAM_SIZE);
+  }
+
+  return views->ToArray();
+}
+
     static bool RefreshDomains(bool updateSpecs = true)
 {
   array<MemoryDomainProxy ^> ^ oldInterfaces =
@@ -344,6 +402,7 @@ static array<MemoryDomainProxy ^> ^
 
   if (updateSpecs)
   {
+    AllSpec::VanguardSpec->Update("DOLPHIN_SHAREDMEMORYVIEWS", GetSharedMemoryViews(), true, true);
     AllSpec::VanguardSpec->Update(VSPEC::MEMORYDOMAINS_INTERFACES, newInterfaces, true, true);
     LocalNetCoreRouter::Route(Endpoints::CorruptCore,
                               Commands::Remote::EventDomainsUpdated, domainsChanged, true);
@@ -377,18 +436,25 @@ void VanguardClientUnmanaged::CORE_STEP()
 {
   if (!VanguardClient::enableRTC)
     return;
+  RefreshCachedParams();
+  // Units generated ahead of time by the RTC, within this step's time budget
+  VanguardBlast::DrainQueue();
   // Any step hook for corruption
   STEP_CORRUPT();
 }
 
 std::string VanguardClientUnmanaged::GAME_TO_LOAD = "";
+bool VanguardClientUnmanaged::RTC_ENABLED = true;
+bool VanguardClientUnmanaged::OSD_ENABLED = true;
 // This is on the main thread not the emu thread
 void VanguardClientUnmanaged::LOAD_GAME_START(std::string romPath)
 {
   if (!VanguardClient::enableRTC)
     return;
   StepActions::ClearStepBlastUnits();
+  VanguardBlast::ClearQueue();
   RtcClock::ResetCount();
+  VanguardStateRing::Clear();
 
   if (romPath == "")
   {
@@ -465,6 +531,7 @@ void VanguardClientUnmanaged::GAME_CLOSED()
 
   AllSpec::VanguardSpec->Update(VSPEC::OPENROMFILENAME, "", true, true);
   RefreshDomains();
+  VanguardStateRing::Clear();
 
   // We need to do this or else the thread hangs when you try and X down through the game itself
   // rather than the hex editor
@@ -481,14 +548,6 @@ void VanguardClientUnmanaged::EMULATOR_CLOSING()
   RtcCore::InvokeGameClosed(true);
 }
 
-bool VanguardClientUnmanaged::RTC_OSD_ENABLED()
-{
-  if (!VanguardClient::enableRTC)
-    return true;
-  if (RTCV::NetCore::Params::IsParamSet(RTCSPEC::CORE_EMULATOROSDDISABLED))
-    return false;
-  return true;
-}
 #pragma endregion
 
 // No fun anonymous classes with closure here
@@ -556,6 +615,32 @@ inline COMMANDS CheckCommand(String ^ inString)
 }
 
 /* IMPLEMENT YOUR COMMANDS HERE */
+// The sync settings JSON the Vanguard layer was last built from
+static std::string s_applied_sync_settings;
+
+static void ApplySyncSettings(String ^ settingStr)
+{
+  const std::string json =
+      String::IsNullOrWhiteSpace(settingStr) ? "" : Helpers::systemStringToUtf8String(settingStr);
+  // Most states in a session share the same settings, so don't even parse them again
+  if (json == s_applied_sync_settings)
+    return;
+  s_applied_sync_settings = json;
+
+  VanguardSettingsWrapper ^ settings =
+      json.empty() ? nullptr : VanguardClient::GetConfigFromJson(settingStr);
+  if (settings == nullptr)
+  {
+    // Clear out any old settings
+    Config::ClearCurrentVanguardLayer();
+    return;
+  }
+
+  // Only swaps the layer (and fires the config callbacks) if a value actually differs
+  auto unmanaged = VanguardSettings::GetVanguardSettingFromVanguardSettingsWrapper(settings);
+  Config::UpdateLayer(ConfigLoaders::GenerateVanguardConfigLoader(&unmanaged));
+}
+
 void VanguardClient::LoadRom(String ^ filename)
 {
   String ^ currentOpenRom = "";
@@ -567,6 +652,7 @@ void VanguardClient::LoadRom(String ^ filename)
   {
     // Clear out any old settings
     Config::ClearCurrentVanguardLayer();
+    s_applied_sync_settings.clear();
 
     const std::string& path = Helpers::systemStringToUtf8String(filename);
     loading = true;
@@ -589,7 +675,8 @@ bool VanguardClient::LoadState(std::string filename)
 {
   StepActions::ClearStepBlastUnits();
   RtcClock::ResetCount();
-  State::LoadAs(filename);
+  if (!VanguardStateRing::Load(filename))
+    State::LoadAs(filename);
   return true;
 }
 
@@ -598,7 +685,9 @@ bool VanguardClient::SaveState(String ^ filename, bool wait)
   if (Core::IsRunningAndStarted())
   {
     const std::string converted_filename = Helpers::systemStringToUtf8String(filename);
-    State::SaveAs(converted_filename, wait);
+    // Timejump states are kept in memory and only go to disk if spilling is enabled
+    if (!VanguardStateRing::Save(converted_filename))
+      State::SaveAs(converted_filename, wait);
     return true;
   }
   return false;
@@ -620,6 +709,8 @@ void VanguardClient::OnMessageReceived(Object ^ sender, NetCoreEventArgs ^ e)
   if (Helpers::is<NetCoreAdvancedMessage ^>(message))
     advancedMessage = static_cast<NetCoreAdvancedMessage ^>(message);
 
+  RefreshCachedParams();
+
   switch (CheckCommand(message->Type))
   {
   case REMOTE_ALLSPECSSENT: {
@@ -633,20 +724,7 @@ void VanguardClient::OnMessageReceived(Object ^ sender, NetCoreEventArgs ^ e)
     String ^ path = static_cast<String ^>(cmd[0]);
     std::string converted_path = Helpers::systemStringToUtf8String(path);
 
-    // Clear out any old settings
-    Config::ClearCurrentVanguardLayer();
-
-    // Load up the sync settings
-    String ^ settingStr = AllSpec::VanguardSpec->Get<String ^>(VSPEC::SYNCSETTINGS);
-    if (!String::IsNullOrWhiteSpace(settingStr))
-    {
-      VanguardSettingsWrapper ^ settings = GetConfigFromJson(settingStr);
-      if (settings != nullptr)
-      {
-        auto _settings = VanguardSettings::GetVanguardSettingFromVanguardSettingsWrapper(settings);
-        AddLayer(ConfigLoaders::GenerateVanguardConfigLoader(&_settings));
-      }
-    }
+    ApplySyncSettings(AllSpec::VanguardSpec->Get<String ^>(VSPEC::SYNCSETTINGS));
     e->setReturnValue(LoadState(converted_path));
   }
   break;
@@ -80,6 +80,13 @@ public:
   static void LOAD_GAME_DONE();
   static void GAME_CLOSED();
   static void EMULATOR_CLOSING();
-  static bool RTC_OSD_ENABLED();
+  // Called for every OSD message from the CPU and GPU threads, so it only reads the mirror below
+  static bool RTC_OSD_ENABLED() { return OSD_ENABLED; }
   static std::string GAME_TO_LOAD;
+  // Mirrors VanguardClient::enableRTC so native hot paths can check it without entering managed
+  // code
+  static bool RTC_ENABLED;
+  // Mirrors the RTC's emulator OSD param. The Vanguard client refreshes it whenever the RTC talks
+  // to it and on every step, which is when the params can change.
+  static bool OSD_ENABLED;
 };
@@ -0,0 +1,485 @@
+#include "NarrysMod/VanguardLockstep.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <fmt/format.h>
+#include <xxhash.h>
+
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+#include "Common/ThreadPool.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/CoreTiming.h"
+#include "Core/HW/DSP.h"
+#include "Core/HW/Memmap.h"
+#include "Core/HW/VideoInterface.h"
+#include "Core/State.h"
+
+namespace VanguardLockstep
+{
+// "LKST"
+constexpr u32 SHARED_MAGIC = 0x54534B4C;
+constexpr u32 SHARED_VERSION = 1;
+// Keep in sync with DolphinMemoryDomain.cpp
+constexpr u32 ARAM_SIZE = 16777216;
+// Pages hashed by each job
+constexpr size_t HASH_CHUNK_PAGES = 64;
+// The other instance may not have joined yet on the first field
+constexpr auto JOIN_TIMEOUT = std::chrono::seconds(60);
+constexpr auto STEP_TIMEOUT = std::chrono::seconds(10);
+
+struct SharedSide
+{
+  std::atomic<u32> joined;
+  std::atomic<u32> stopped;
+  // Last field whose hashes were published, and last field of the other side compared with
+  std::atomic<u64> published;
+  std::atomic<u64> compared;
+  // Tick each of the two hash buffers was taken on
+  u64 ticks[2];
+};
+
+// The hashes follow the header. Each side has two buffers of num_pages hashes, for odd and even
+// fields, so that a side can hash the next field while the other one still compares the last.
+struct SharedHeader
+{
+  // Stored last by the instance that creates the session
+  std::atomic<u32> magic;
+  u32 version;
+  u32 page_size;
+  u32 num_pages;
+  SharedSide sides[2];
+};
+static_assert(std::atomic<u64>::is_always_lock_free);
+
+struct Segment
+{
+  VanguardBlast::Domain domain;
+  const u8* memory;
+  u32 size;
+};
+
+static CoreTiming::EventType* s_event;
+static std::atomic<bool> s_running{false};
+
+// Only touched on the CPU thread
+static std::vector<Segment> s_segments;
+static u32 s_num_pages = 0;
+static int s_side = 0;
+static u64 s_field = 0;
+static SharedHeader* s_shared = nullptr;
+static size_t s_shared_size = 0;
+#ifdef _WIN32
+static HANDLE s_mapping = nullptr;
+#else
+static std::string s_shared_name;
+#endif
+
+static std::mutex s_divergence_mutex;
+static bool s_diverged = false;
+static Divergence s_divergence;
+
+static const char* GetDomainName(VanguardBlast::Domain domain)
+{
+  switch (domain)
+  {
+  case VanguardBlast::Domain::SRAM:
+    return "SRAM";
+  case VanguardBlast::Domain::EXRAM:
+    return "EXRAM";
+  default:
+    return "ARAM";
+  }
+}
+
+static std::vector<Segment> GetSegments()
+{
+  std::vector<Segment> segments;
+  if (Memory::m_pRAM)
+    segments.push_back({VanguardBlast::Domain::SRAM, Memory::m_pRAM, Memory::GetRamSizeReal()});
+  if (Memory::m_pEXRAM)
+  {
+    segments.push_back(
+        {VanguardBlast::Domain::EXRAM, Memory::m_pEXRAM, Memory::GetExRamSizeReal()});
+  }
+  // The Wii aliases ARAM onto MEM2
+  if (!SConfig::GetInstance().bWii)
+    segments.push_back({VanguardBlast::Domain::ARAM, DSP::GetARAMPtr(), ARAM_SIZE});
+  return segments;
+}
+
+// Returns the page with the given index, counting through the segments in order
+static const u8* GetPage(size_t page, const Segment** segment)
+{
+  for (const Segment& candidate : s_segments)
+  {
+    const size_t pages = candidate.size / PAGE_SIZE;
+    if (page < pages)
+    {
+      *segment = &candidate;
+      return candidate.memory + page * PAGE_SIZE;
+    }
+    page -= pages;
+  }
+  return nullptr;
+}
+
+static u64* GetHashes(int side, u64 field)
+{
+  u64* const hashes = reinterpret_cast<u64*>(s_shared + 1);
+  return hashes + (static_cast<size_t>(side) * 2 + field % 2) * s_num_pages;
+}
+
+static void HashPages(u64* out)
+{
+  const size_t chunks = (s_num_pages + HASH_CHUNK_PAGES - 1) / HASH_CHUNK_PAGES;
+  Common::ThreadPool::ParallelFor(chunks, [out](size_t chunk) {
+    const size_t end = std::min<size_t>(s_num_pages, (chunk + 1) * HASH_CHUNK_PAGES);
+    for (size_t page = chunk * HASH_CHUNK_PAGES; page < end; ++page)
+    {
+      const Segment* segment;
+      out[page] = XXH64(GetPage(page, &segment), PAGE_SIZE, 0);
+    }
+  });
+}
+
+// end_session is false when leaving a session which belongs to other instances
+static void UnmapShared(bool end_session)
+{
+#ifdef _WIN32
+  UnmapViewOfFile(s_shared);
+  CloseHandle(s_mapping);
+  s_mapping = nullptr;
+#else
+  munmap(s_shared, s_shared_size);
+  // The other side keeps its mapping, this only stops new instances from joining the old session
+  if (end_session)
+    shm_unlink(s_shared_name.c_str());
+#endif
+  s_shared = nullptr;
+}
+
+static void* MapShared(const std::string& session, size_t size, bool* created)
+{
+#ifdef _WIN32
+  const std::string name = "dolphin-lockstep-" + session;
+  s_mapping = CreateFileMapping(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                static_cast<DWORD>(static_cast<u64>(size) >> 32),
+                                static_cast<DWORD>(size), UTF8ToTStr(name).c_str());
+  if (!s_mapping)
+    return nullptr;
+  *created = GetLastError() != ERROR_ALREADY_EXISTS;
+
+  // Fails if the existing session is smaller, i.e. the other instance emulates less memory
+  void* view = MapViewOfFile(s_mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+  if (!view)
+  {
+    CloseHandle(s_mapping);
+    s_mapping = nullptr;
+  }
+  return view;
+#else
+  s_shared_name = "/dolphin-lockstep-" + session;
+  int fd = shm_open(s_shared_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  *created = fd >= 0;
+  if (*created && ftruncate(fd, size) != 0)
+  {
+    close(fd);
+    shm_unlink(s_shared_name.c_str());
+    return nullptr;
+  }
+  if (!*created)
+  {
+    fd = shm_open(s_shared_name.c_str(), O_RDWR, 0600);
+    if (fd < 0)
+      return nullptr;
+
+    // The creator sizes the segment right after creating it
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    struct stat info = {};
+    while (fstat(fd, &info) == 0 && info.st_size == 0 &&
+           std::chrono::steady_clock::now() < deadline)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (static_cast<size_t>(info.st_size) != size)
+    {
+      close(fd);
+      return nullptr;
+    }
+  }
+
+  void* view = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  return view != MAP_FAILED ? view : nullptr;
+#endif
+}
+
+// Opens or creates the shared memory of the session and claims the side. CPU thread only.
+static bool Open(const std::string& session, int side)
+{
+  s_segments = GetSegments();
+  s_num_pages = 0;
+  for (const Segment& segment : s_segments)
+    s_num_pages += segment.size / PAGE_SIZE;
+  s_side = side;
+  s_shared_size = sizeof(SharedHeader) + size_t(4) * s_num_pages * sizeof(u64);
+
+  bool created = false;
+  void* view = MapShared(session, s_shared_size, &created);
+  if (!view)
+  {
+    ERROR_LOG(CORE, "Could not open the shared memory of lockstep session %s", session.c_str());
+    return false;
+  }
+
+  if (created)
+  {
+    // Fresh shared memory is zeroed, which is also the starting state of both sides
+    s_shared = new (view) SharedHeader{};
+    s_shared->version = SHARED_VERSION;
+    s_shared->page_size = PAGE_SIZE;
+    s_shared->num_pages = s_num_pages;
+    s_shared->magic.store(SHARED_MAGIC, std::memory_order_release);
+  }
+  else
+  {
+    s_shared = static_cast<SharedHeader*>(view);
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (s_shared->magic.load(std::memory_order_acquire) != SHARED_MAGIC &&
+           std::chrono::steady_clock::now() < deadline)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  const SharedSide& other = s_shared->sides[side ^ 1];
+  if (s_shared->magic.load(std::memory_order_acquire) != SHARED_MAGIC ||
+      s_shared->version != SHARED_VERSION || s_shared->page_size != PAGE_SIZE ||
+      s_shared->num_pages != s_num_pages || other.stopped.load(std::memory_order_acquire))
+  {
+    ERROR_LOG(CORE, "Lockstep session %s doesn't match this instance or is already over",
+              session.c_str());
+    UnmapShared(created);
+    return false;
+  }
+
+  if (s_shared->sides[side].joined.exchange(1) != 0)
+  {
+    ERROR_LOG(CORE, "Side %d of lockstep session %s is already taken", side, session.c_str());
+    UnmapShared(false);
+    return false;
+  }
+  return true;
+}
+
+// Ends the session for this side, which makes the other side stop too. CPU thread only.
+static void Close()
+{
+  s_running = false;
+  if (!s_shared)
+    return;
+
+  s_shared->sides[s_side].stopped.store(1, std::memory_order_release);
+  UnmapShared(true);
+}
+
+// Waits until the condition holds. Returns false if the other side stopped or took too long, or
+// this side is being stopped.
+template <typename Condition>
+static bool WaitForOtherSide(Condition condition, std::chrono::steady_clock::duration timeout)
+{
+  const SharedSide& other = s_shared->sides[s_side ^ 1];
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  for (u32 spins = 0; !condition(); ++spins)
+  {
+    if (!s_running || other.stopped.load(std::memory_order_acquire) ||
+        std::chrono::steady_clock::now() > deadline)
+    {
+      return false;
+    }
+
+    if (spins < 64)
+      std::this_thread::yield();
+    else
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+static void Abort()
+{
+  // Nothing to report if this side is being stopped
+  if (s_running)
+  {
+    WARN_LOG(CORE, "Lockstep comparison stopped on field %" PRIu64
+                   ", the other instance stopped or didn't keep up",
+             s_field);
+    Core::DisplayMessage("Lockstep comparison stopped, the other instance is gone", 4000);
+  }
+  Close();
+}
+
+static void ReportDivergence(const Divergence& divergence)
+{
+  {
+    std::lock_guard lk(s_divergence_mutex);
+    s_diverged = true;
+    s_divergence = divergence;
+  }
+
+  const std::string message =
+      divergence.out_of_step ?
+          fmt::format("Lockstep instances fell out of step on field {} (tick {})",
+                      divergence.field, divergence.tick) :
+          fmt::format("Memory diverged on field {} (tick {}) in {} page 0x{:08x}",
+                      divergence.field, divergence.tick, GetDomainName(divergence.domain),
+                      divergence.address);
+  NOTICE_LOG(CORE, "%s", message.c_str());
+  Core::DisplayMessage(message, 10000);
+}
+
+// Returns false if the two sides differ on the field
+static bool Compare(u64 field)
+{
+  const u64 tick = s_shared->sides[s_side].ticks[field % 2];
+  if (tick != s_shared->sides[s_side ^ 1].ticks[field % 2])
+  {
+    ReportDivergence({field, tick, VanguardBlast::Domain::SRAM, 0, true});
+    return false;
+  }
+
+  const u64* const mine = GetHashes(s_side, field);
+  const u64* const theirs = GetHashes(s_side ^ 1, field);
+  const u64* const differing = std::mismatch(mine, mine + s_num_pages, theirs).first;
+  if (differing == mine + s_num_pages)
+    return true;
+
+  const Segment* segment;
+  const u8* const page = GetPage(differing - mine, &segment);
+  ReportDivergence(
+      {field, tick, segment->domain, static_cast<u32>(page - segment->memory), false});
+  return false;
+}
+
+static void StepCallback(u64 userdata, s64 cycles_late)
+{
+  if (!s_running || !s_shared)
+    return;
+
+  const u64 field = ++s_field;
+  SharedSide& self = s_shared->sides[s_side];
+  const SharedSide& other = s_shared->sides[s_side ^ 1];
+  const auto timeout = field == 1 ? JOIN_TIMEOUT : STEP_TIMEOUT;
+
+  // This field's buffer was last used two fields ago, the other side has to be done with it
+  if (field > 2 && !WaitForOtherSide(
+                       [&] { return other.compared.load(std::memory_order_acquire) >= field - 2; },
+                       timeout))
+  {
+    Abort();
+    return;
+  }
+
+  HashPages(GetHashes(s_side, field));
+  self.ticks[field % 2] = CoreTiming::GetTicks();
+  self.published.store(field, std::memory_order_release);
+
+  if (!WaitForOtherSide(
+          [&] { return other.published.load(std::memory_order_acquire) >= field; }, timeout))
+  {
+    Abort();
+    return;
+  }
+
+  const bool same = Compare(field);
+  self.compared.store(field, std::memory_order_release);
+  if (!same)
+  {
+    Close();
+    return;
+  }
+
+  CoreTiming::ScheduleEvent(VideoInterface::GetTicksPerField() - cycles_late, s_event);
+}
+
+void RegisterEvents()
+{
+  s_event = CoreTiming::RegisterEvent("VanguardLockstep", StepCallback);
+}
+
+bool Start(const std::string& session, int side, const std::string& state_path)
+{
+  if (!Core::IsRunningAndStarted() || session.empty() || (side != 0 && side != 1))
+    return false;
+
+  Stop();
+
+  // Both sides have to start on the same tick, so the state is loaded right before the first field
+  // is scheduled
+  bool started = false;
+  Core::RunOnCPUThread(
+      [&] {
+        if (!state_path.empty())
+          State::LoadAs(state_path);
+
+        if (!Open(session, side))
+          return;
+
+        {
+          std::lock_guard lk(s_divergence_mutex);
+          s_diverged = false;
+        }
+        s_field = 0;
+        s_running = true;
+        CoreTiming::ScheduleEvent(VideoInterface::GetTicksPerField(), s_event);
+        started = true;
+      },
+      true);
+  return started;
+}
+
+void Stop()
+{
+  // Clearing the flag first releases the CPU thread if it's waiting for the other side
+  if (!s_running.exchange(false))
+    return;
+
+  Core::RunOnCPUThread(
+      [] {
+        CoreTiming::RemoveEvent(s_event);
+        Close();
+      },
+      true);
+}
+
+bool IsRunning()
+{
+  return s_running;
+}
+
+bool GetDivergence(Divergence* divergence)
+{
+  std::lock_guard lk(s_divergence_mutex);
+  if (s_diverged)
+    *divergence = s_divergence;
+  return s_diverged;
+}
+}  // namespace VanguardLockstep
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <string>
+
+#include "Common/CommonTypes.h"
+#include "NarrysMod/VanguardBlast.h"
+
+// Lockstep memory comparison of two instances, for A/B testing corruptions. Both instances load
+// the same state and join the same session, one on each side. From then on, at every field each of
+// them hashes MEM1, MEM2 and ARAM in pages into memory shared between the two processes, waits for
+// the other one to get to the same field, and compares the hashes. The first field and page on
+// which they differ is reported, and the comparison stops there. Giving both instances the same
+// inputs, e.g. by playing back the same movie, is up to the caller.
+namespace VanguardLockstep
+{
+constexpr u32 PAGE_SIZE = 4096;
+
+struct Divergence
+{
+  // Fields compared since the start, including the one that differed
+  u64 field;
+  u64 tick;
+  VanguardBlast::Domain domain;
+  // Start of the first page that differs, relative to the start of the domain
+  u32 address;
+  // Set if the instances weren't even on the same tick. The domain and address are meaningless.
+  bool out_of_step;
+};
+
+// Called from SystemTimers::Init, alongside the other CoreTiming events
+void RegisterEvents();
+
+// Loads the state if one is given, and starts comparing with the other side of the session from
+// the tick it was loaded on. side is 0 or 1. Returns false if nothing is running or the session
+// can't be joined, e.g. because the side is taken or the other instance emulates another console.
+bool Start(const std::string& session, int side, const std::string& state_path);
+
+void Stop();
+
+bool IsRunning();
+
+// Returns false if no divergence was found since the last Start
+bool GetDivergence(Divergence* divergence);
+}  // namespace VanguardLockstep
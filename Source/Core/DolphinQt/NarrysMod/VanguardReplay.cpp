@@ -0,0 +1,314 @@
+#include "NarrysMod/VanguardReplay.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#include "Common/File.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Core/Core.h"
+#include "Core/CoreTiming.h"
+#include "Core/State.h"
+
+namespace VanguardReplay
+{
+// "RPLY"
+constexpr u32 LOG_MAGIC = 0x594C5052;
+constexpr u32 LOG_VERSION = 1;
+// Each poke in the file: domain (u8), address (u32), value (u8)
+constexpr size_t POKE_SIZE = 6;
+
+struct Entry
+{
+  u64 tick;
+  VanguardBlast::Poke poke;
+};
+
+static CoreTiming::EventType* s_event;
+
+// Guards the recording, which can be added to from any thread
+static std::mutex s_record_mutex;
+static std::atomic<bool> s_recording{false};
+static std::vector<Entry> s_recorded;
+static std::string s_state_path;
+
+// The replay schedule is only touched on the CPU thread. The ticks and pokes are kept apart so
+// that everything due on a tick can be applied as one batch straight out of the schedule.
+static std::atomic<bool> s_replaying{false};
+static std::vector<u64> s_replay_ticks;
+static std::vector<VanguardBlast::Poke> s_replay_pokes;
+static size_t s_replay_cursor = 0;
+
+static std::string GetLogPath(const std::string& state_path)
+{
+  return state_path + ".rtcreplay";
+}
+
+template <typename T>
+static void Append(std::vector<u8>* out, T value)
+{
+  const size_t offset = out->size();
+  out->resize(offset + sizeof(T));
+  std::memcpy(out->data() + offset, &value, sizeof(T));
+}
+
+template <typename T>
+static bool Extract(const std::vector<u8>& in, size_t* offset, T* value)
+{
+  if (in.size() - *offset < sizeof(T))
+    return false;
+  std::memcpy(value, in.data() + *offset, sizeof(T));
+  *offset += sizeof(T);
+  return true;
+}
+
+// Pokes are grouped by tick, since a whole batch usually lands on the same one
+static std::vector<u8> Serialize(const std::vector<Entry>& entries)
+{
+  std::vector<u8> out;
+  out.reserve(12 + entries.size() * POKE_SIZE);
+  Append(&out, LOG_MAGIC);
+  Append(&out, LOG_VERSION);
+  const size_t group_count_offset = out.size();
+  Append(&out, u32(0));
+
+  u32 group_count = 0;
+  for (size_t i = 0; i < entries.size();)
+  {
+    size_t end = i;
+    while (end < entries.size() && entries[end].tick == entries[i].tick)
+      ++end;
+
+    Append(&out, entries[i].tick);
+    Append(&out, static_cast<u32>(end - i));
+    for (; i < end; ++i)
+    {
+      Append(&out, static_cast<u8>(entries[i].poke.domain));
+      Append(&out, entries[i].poke.address);
+      Append(&out, entries[i].poke.value);
+    }
+    ++group_count;
+  }
+
+  std::memcpy(out.data() + group_count_offset, &group_count, sizeof(group_count));
+  return out;
+}
+
+static bool Deserialize(const std::vector<u8>& in, std::vector<u64>* ticks,
+                        std::vector<VanguardBlast::Poke>* pokes)
+{
+  size_t offset = 0;
+  u32 magic, version, group_count;
+  if (!Extract(in, &offset, &magic) || !Extract(in, &offset, &version) ||
+      !Extract(in, &offset, &group_count) || magic != LOG_MAGIC || version != LOG_VERSION)
+  {
+    return false;
+  }
+
+  for (u32 group = 0; group < group_count; ++group)
+  {
+    u64 tick;
+    u32 count;
+    if (!Extract(in, &offset, &tick) || !Extract(in, &offset, &count) ||
+        (in.size() - offset) / POKE_SIZE < count || (!ticks->empty() && tick < ticks->back()))
+    {
+      return false;
+    }
+
+    for (u32 i = 0; i < count; ++i)
+    {
+      u8 domain;
+      VanguardBlast::Poke poke;
+      Extract(in, &offset, &domain);
+      Extract(in, &offset, &poke.address);
+      Extract(in, &offset, &poke.value);
+      if (domain > static_cast<u8>(VanguardBlast::Domain::EFB))
+        return false;
+      poke.domain = static_cast<VanguardBlast::Domain>(domain);
+
+      ticks->push_back(tick);
+      pokes->push_back(poke);
+    }
+  }
+
+  return offset == in.size();
+}
+
+// Schedules the replay event for the next poke that is due. CPU thread only.
+static void ScheduleNextPoke()
+{
+  CoreTiming::RemoveEvent(s_event);
+  if (s_replay_cursor == s_replay_ticks.size())
+  {
+    s_replaying = false;
+    Core::DisplayMessage("Corruption replay finished", 2000);
+    return;
+  }
+
+  const u64 now = CoreTiming::GetTicks();
+  const u64 tick = s_replay_ticks[s_replay_cursor];
+  CoreTiming::ScheduleEvent(tick > now ? static_cast<s64>(tick - now) : 0, s_event);
+}
+
+static void ReplayCallback(u64 userdata, s64 cycles_late)
+{
+  if (!s_replaying)
+    return;
+
+  const u64 now = CoreTiming::GetTicks();
+  const size_t begin = s_replay_cursor;
+  while (s_replay_cursor < s_replay_ticks.size() && s_replay_ticks[s_replay_cursor] <= now)
+    ++s_replay_cursor;
+
+  if (s_replay_cursor != begin)
+    VanguardBlast::ApplyOnCPUThread(s_replay_pokes.data() + begin, s_replay_cursor - begin);
+  ScheduleNextPoke();
+}
+
+void RegisterEvents()
+{
+  s_event = CoreTiming::RegisterEvent("VanguardReplay", ReplayCallback);
+}
+
+bool StartRecording(const std::string& state_path)
+{
+  if (!Core::IsRunningAndStarted())
+    return false;
+
+  StopReplay();
+
+  // Logging has to start on the exact tick the state is taken at
+  Core::RunOnCPUThread(
+      [&state_path] {
+        State::SaveAs(state_path, true);
+
+        std::lock_guard lk(s_record_mutex);
+        s_recorded.clear();
+        s_state_path = state_path;
+        s_recording = true;
+      },
+      true);
+  return true;
+}
+
+bool StopRecording()
+{
+  std::vector<Entry> entries;
+  std::string state_path;
+  {
+    std::lock_guard lk(s_record_mutex);
+    if (!s_recording)
+      return false;
+    s_recording = false;
+    entries = std::move(s_recorded);
+    state_path = std::move(s_state_path);
+  }
+
+  // Pokes from other threads can be logged slightly out of order
+  std::stable_sort(entries.begin(), entries.end(),
+                   [](const Entry& a, const Entry& b) { return a.tick < b.tick; });
+
+  const std::vector<u8> data = Serialize(entries);
+  File::IOFile file(GetLogPath(state_path), "wb");
+  if (!file.WriteBytes(data.data(), data.size()))
+  {
+    ERROR_LOG(CORE, "Could not write the corruption log for %s", state_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool StartReplay(const std::string& state_path)
+{
+  if (!Core::IsRunningAndStarted() || !File::Exists(state_path))
+    return false;
+
+  std::string data;
+  if (!File::ReadFileToString(GetLogPath(state_path), data))
+    return false;
+
+  std::vector<u64> ticks;
+  std::vector<VanguardBlast::Poke> pokes;
+  if (!Deserialize(std::vector<u8>(data.begin(), data.end()), &ticks, &pokes))
+  {
+    ERROR_LOG(CORE, "The corruption log for %s is malformed", state_path.c_str());
+    return false;
+  }
+
+  StopRecording();
+
+  // The first poke can be due right after the state, so the schedule has to be in place before
+  // the CPU runs again
+  Core::RunOnCPUThread(
+      [&] {
+        State::LoadAs(state_path);
+
+        s_replay_ticks = std::move(ticks);
+        s_replay_pokes = std::move(pokes);
+        const u64 now = CoreTiming::GetTicks();
+        s_replay_cursor = std::lower_bound(s_replay_ticks.begin(), s_replay_ticks.end(), now) -
+                          s_replay_ticks.begin();
+        s_replaying = true;
+        ScheduleNextPoke();
+      },
+      true);
+  return true;
+}
+
+void StopReplay()
+{
+  if (!s_replaying)
+    return;
+
+  Core::RunOnCPUThread(
+      [] {
+        s_replaying = false;
+        CoreTiming::RemoveEvent(s_event);
+        s_replay_ticks.clear();
+        s_replay_pokes.clear();
+        s_replay_cursor = 0;
+      },
+      true);
+}
+
+bool IsRecording()
+{
+  return s_recording;
+}
+
+bool IsReplaying()
+{
+  return s_replaying;
+}
+
+void Record(const VanguardBlast::Poke* pokes, size_t count)
+{
+  if (!s_recording || count == 0)
+    return;
+
+  std::lock_guard lk(s_record_mutex);
+  if (!s_recording)
+    return;
+
+  const u64 tick = CoreTiming::GetTicks();
+  for (size_t i = 0; i < count; ++i)
+    s_recorded.push_back({tick, pokes[i]});
+}
+
+void Record(VanguardBlast::Domain domain, u32 address, const u8* values, size_t count)
+{
+  if (!s_recording || count == 0)
+    return;
+
+  std::lock_guard lk(s_record_mutex);
+  if (!s_recording)
+    return;
+
+  const u64 tick = CoreTiming::GetTicks();
+  for (size_t i = 0; i < count; ++i)
+    s_recorded.push_back({tick, {domain, static_cast<u32>(address + i), values[i]}});
+}
+}  // namespace VanguardReplay
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "Common/CommonTypes.h"
+#include "NarrysMod/VanguardBlast.h"
+
+// Deterministic record and replay of corruptions. Recording starts with a savestate, and from then
+// on every poke the native side applies is logged with the emulated tick it landed on. The log is
+// kept in memory and written next to the state. Replaying loads the state and re-applies each
+// poke on its tick from a CoreTiming event, so the result is bit-exact without the RTC being
+// involved, at whatever speed the emulation runs.
+namespace VanguardReplay
+{
+// Called from SystemTimers::Init, alongside the other CoreTiming events
+void RegisterEvents();
+
+// Saves a state to the given path and starts logging pokes. Returns false if nothing is running.
+bool StartRecording(const std::string& state_path);
+
+// Stops logging and writes the log next to the state. Returns false if it couldn't be written.
+bool StopRecording();
+
+// Loads the state and the log that was recorded with it, and replays the log from there. Returns
+// false if either is missing or the log is malformed.
+bool StartReplay(const std::string& state_path);
+
+void StopReplay();
+
+bool IsRecording();
+bool IsReplaying();
+
+// Logs pokes that were just applied. Does nothing unless recording. Pokes coming from other
+// threads than the CPU thread are logged with the tick the CPU thread was at, which is as close as
+// they can be placed.
+void Record(const VanguardBlast::Poke* pokes, size_t count);
+void Record(VanguardBlast::Domain domain, u32 address, const u8* values, size_t count);
+}  // namespace VanguardReplay
@@ -0,0 +1,142 @@
+#include "NarrysMod/VanguardSnapshot.h"
+
+#include <cstring>
+
+#include "Common/Intrinsics.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/HW/DSP.h"
+#include "Core/HW/Memmap.h"
+
+namespace VanguardSnapshot
+{
+// Keep these in sync with DolphinMemoryDomain.cpp
+constexpr u32 SRAM_SIZE = 25165824;
+constexpr u32 EXRAM_SIZE = 67108864;
+constexpr u32 ARAM_SIZE = 16777216;
+constexpr u32 ARAM_OFFSET = 0x80000000;
+
+constexpr size_t BLOCK_SIZE = 64;
+
+static bool IsGPUDomain(VanguardBlast::Domain domain)
+{
+  return domain >= VanguardBlast::Domain::TMEM;
+}
+
+// Returns the memory backing the domain if it can be read flat, and its size either way
+static const u8* GetFlatMemory(VanguardBlast::Domain domain, size_t* size)
+{
+  switch (domain)
+  {
+  case VanguardBlast::Domain::SRAM:
+    *size = Memory::m_pRAM ? SRAM_SIZE : 0;
+    return Memory::m_pRAM;
+  case VanguardBlast::Domain::EXRAM:
+    *size = Memory::m_pEXRAM ? EXRAM_SIZE : 0;
+    return Memory::m_pEXRAM;
+  case VanguardBlast::Domain::ARAM:
+    *size = ARAM_SIZE;
+    // The Wii aliases ARAM onto MEM2, so it has to go through the regular accessor there
+    return SConfig::GetInstance().bWii ? nullptr : DSP::GetARAMPtr();
+  default:
+    *size = IsGPUDomain(domain) && Core::IsRunningAndStarted() ?
+                GPUMemoryAccess::GetRegionSize(VanguardBlast::GetGPURegion(domain)) :
+                0;
+    return nullptr;
+  }
+}
+
+std::vector<u8> Take(VanguardBlast::Domain domain)
+{
+  size_t size;
+  const u8* memory = GetFlatMemory(domain, &size);
+  if (memory)
+    return std::vector<u8>(memory, memory + size);
+
+  std::vector<u8> data(size);
+  if (size == 0)
+    return data;
+
+  if (IsGPUDomain(domain))
+  {
+    VanguardBlast::RunGPUAccesses(
+        {{VanguardBlast::GetGPURegion(domain), false, 0, static_cast<u32>(size), data.data()}});
+  }
+  else
+  {
+    for (u32 i = 0; i < size; i++)
+      data[i] = DSP::ReadARAM(i + ARAM_OFFSET);
+  }
+  return data;
+}
+
+std::vector<VanguardBlast::Range> Diff(VanguardBlast::Domain domain, const std::vector<u8>& snapshot)
+{
+  size_t size;
+  const u8* memory = GetFlatMemory(domain, &size);
+  if (size == 0 || size != snapshot.size())
+    return {};
+
+  if (memory)
+    return DiffBuffers(snapshot.data(), memory, size);
+
+  const std::vector<u8> current = Take(domain);
+  if (current.size() != snapshot.size())
+    return {};
+  return DiffBuffers(snapshot.data(), current.data(), size);
+}
+
+static bool BlocksEqual(const u8* a, const u8* b)
+{
+#ifdef _M_X86
+  __m128i diff = _mm_setzero_si128();
+  for (size_t i = 0; i < BLOCK_SIZE; i += 16)
+  {
+    const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+    const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+    diff = _mm_or_si128(diff, _mm_xor_si128(va, vb));
+  }
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(diff, _mm_setzero_si128())) == 0xFFFF;
+#else
+  return std::memcmp(a, b, BLOCK_SIZE) == 0;
+#endif
+}
+
+std::vector<VanguardBlast::Range> DiffBuffers(const u8* a, const u8* b, size_t size)
+{
+  std::vector<VanguardBlast::Range> ranges;
+  size_t i = 0;
+  while (true)
+  {
+    // Skip to the first changed byte
+    while (i + BLOCK_SIZE <= size && BlocksEqual(a + i, b + i))
+      i += BLOCK_SIZE;
+    while (i < size && a[i] == b[i])
+      i++;
+    if (i == size)
+      break;
+
+    // Extend the range block by block until a whole block is unchanged. What's left at the end
+    // of the buffer is compared byte by byte.
+    const size_t start = i;
+    size_t end = start + 1;
+    while (end + BLOCK_SIZE <= size && !BlocksEqual(a + end, b + end))
+      end += BLOCK_SIZE;
+    if (end + BLOCK_SIZE > size)
+    {
+      for (size_t j = end; j < size; j++)
+      {
+        if (a[j] != b[j])
+          end = j + 1;
+      }
+    }
+
+    while (a[end - 1] == b[end - 1])
+      end--;
+    ranges.push_back({static_cast<u32>(start), static_cast<u32>(end)});
+    i = end;
+  }
+
+  return ranges;
+}
+}  // namespace VanguardSnapshot
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "NarrysMod/VanguardBlast.h"
+
+// Native side of memory comparisons. The RTC takes a copy of a whole domain before a corruption
+// and asks for the changed ranges afterwards, so only the ranges cross over to the managed side
+// instead of the full domain, twice.
+namespace VanguardSnapshot
+{
+// Returns a copy of the current contents of the domain, or an empty buffer if the domain isn't
+// available right now (e.g. EXRAM on the GameCube, or GPU-side state while nothing is running).
+std::vector<u8> Take(VanguardBlast::Domain domain);
+
+// Returns the ranges of the domain that differ from the snapshot, relative to the start of the
+// domain. Domains backed by flat memory are compared in place, without taking another copy.
+std::vector<VanguardBlast::Range> Diff(VanguardBlast::Domain domain, const std::vector<u8>& snapshot);
+
+// Returns the ranges in which the buffers differ, sorted and with exclusive ends. Buffers are
+// compared 64 bytes at a time, so a range can enclose unchanged bytes between changes that are
+// less than two such blocks apart.
+std::vector<VanguardBlast::Range> DiffBuffers(const u8* a, const u8* b, size_t size);
+}  // namespace VanguardSnapshot
@@ -0,0 +1,115 @@
+#include "NarrysMod/VanguardStateRing.h"
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/Core.h"
+#include "Core/State.h"
+
+namespace VanguardStateRing
+{
+struct Entry
+{
+  std::string key;
+  // Exactly one of these is used, depending on whether delta states were enabled at save time
+  std::vector<u8> buffer;
+  std::optional<State::Delta> delta;
+};
+
+static std::mutex s_mutex;
+static std::deque<Entry> s_entries;
+// Deltas are taken against the first state saved after the ring was cleared
+static std::optional<State::Snapshot> s_base;
+
+static auto Find(const std::string& key)
+{
+  return std::find_if(s_entries.begin(), s_entries.end(),
+                      [&key](const Entry& entry) { return entry.key == key; });
+}
+
+static std::optional<Entry> SaveEntry(const std::string& key)
+{
+  Entry entry{key};
+  const bool spill = Config::Get(Config::MAIN_VANGUARD_SPILL_STATES_TO_DISK);
+
+  if (!Config::Get(Config::MAIN_VANGUARD_DELTA_STATES))
+  {
+    State::SaveToBuffer(entry.buffer);
+    if (entry.buffer.empty())
+      return std::nullopt;
+    if (spill)
+      State::SaveBufferAs(key, entry.buffer);
+    return entry;
+  }
+
+  State::Snapshot snapshot;
+  State::SaveToSnapshot(snapshot);
+  if (snapshot.buffer.empty())
+    return std::nullopt;
+  if (spill)
+    State::SaveBufferAs(key, snapshot.buffer);
+
+  std::lock_guard<std::mutex> lk(s_mutex);
+  if (!s_base)
+    s_base = snapshot;
+  entry.delta = State::CreateDelta(*s_base, snapshot);
+  return entry;
+}
+
+bool Save(const std::string& key)
+{
+  const u32 capacity = Config::Get(Config::MAIN_VANGUARD_STATE_RING_SIZE);
+  if (capacity == 0 || !Core::IsRunningAndStarted())
+    return false;
+
+  std::optional<Entry> entry = SaveEntry(key);
+  if (!entry)
+    return false;
+
+  std::lock_guard<std::mutex> lk(s_mutex);
+  auto it = Find(key);
+  if (it != s_entries.end())
+    s_entries.erase(it);
+
+  while (s_entries.size() >= capacity)
+    s_entries.pop_front();
+
+  s_entries.push_back(std::move(*entry));
+  return true;
+}
+
+bool Load(const std::string& key)
+{
+  std::lock_guard<std::mutex> lk(s_mutex);
+  auto it = Find(key);
+  if (it == s_entries.end())
+    return false;
+
+  if (!it->delta)
+  {
+    State::LoadFromBuffer(it->buffer);
+    return true;
+  }
+
+  if (!s_base)
+    return false;
+
+  State::Snapshot snapshot = State::ApplyDelta(*s_base, *it->delta);
+  State::LoadFromBuffer(snapshot.buffer);
+  return true;
+}
+
+void Clear()
+{
+  std::lock_guard<std::mutex> lk(s_mutex);
+  s_entries.clear();
+  s_base.reset();
+}
+}  // namespace VanguardStateRing
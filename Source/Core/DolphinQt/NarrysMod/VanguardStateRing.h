@@ -0,0 +1,21 @@
+#pragma once
+
+#include <string>
+
+// RAM-resident savestates for the RTC. States are keyed by the path the RTC was handed back when
+// it asked for the save, so a later load of that path can be served without touching the disk.
+namespace VanguardStateRing
+{
+// Serialises the current state into the ring under the given key. Once the ring is full the
+// oldest state is dropped. If spilling is enabled the state is also written to the key's path on
+// the save thread. With delta states enabled, only the pages that differ from the first state
+// saved for the game are kept. Returns false if the ring is disabled or nothing could be saved.
+bool Save(const std::string& key);
+
+// Loads the state stored under the given key. Returns false if it isn't in the ring.
+bool Load(const std::string& key);
+
+// Drops every state in the ring. States belong to a single game, so call this whenever the
+// running game changes.
+void Clear();
+}  // namespace VanguardStateRing
@@ -0,0 +1,177 @@
+#include "NarrysMod/VanguardVirtualDomain.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "Core/ConfigManager.h"
+#include "Core/HW/DSP.h"
+#include "Core/HW/Memmap.h"
+#include "NarrysMod/VanguardReplay.h"
+#include "VideoCommon/GPUMemoryAccess.h"
+
+namespace VanguardVirtualDomain
+{
+// Keep these in sync with DolphinMemoryDomain.cpp
+constexpr u32 SRAM_SIZE = 25165824;
+constexpr u32 EXRAM_SIZE = 67108864;
+constexpr u32 ARAM_SIZE = 16777216;
+constexpr u32 SRAM_OFFSET = 0x80000000;
+constexpr u32 EXRAM_OFFSET = 0x90000000;
+constexpr u32 ARAM_OFFSET = 0x80000000;
+
+// Returns the memory backing the domain if it can be accessed flat, and its size either way
+static u8* GetFlatMemory(VanguardBlast::Domain domain, u32* size)
+{
+  switch (domain)
+  {
+  case VanguardBlast::Domain::SRAM:
+    *size = Memory::m_pRAM ? SRAM_SIZE : 0;
+    return Memory::m_pRAM;
+  case VanguardBlast::Domain::EXRAM:
+    *size = Memory::m_pEXRAM ? EXRAM_SIZE : 0;
+    return Memory::m_pEXRAM;
+  case VanguardBlast::Domain::ARAM:
+    *size = ARAM_SIZE;
+    // The Wii aliases ARAM onto MEM2, so it has to go through the regular accessor there
+    return SConfig::GetInstance().bWii ? nullptr : DSP::GetARAMPtr();
+  default:
+    *size = 0;
+    return nullptr;
+  }
+}
+
+static bool IsGPUDomain(VanguardBlast::Domain domain)
+{
+  return domain >= VanguardBlast::Domain::TMEM;
+}
+
+Table::Table(std::vector<Segment> segments)
+{
+  segments.erase(std::remove_if(segments.begin(), segments.end(),
+                                [](const Segment& segment) { return segment.length == 0; }),
+                 segments.end());
+  m_segments = std::move(segments);
+
+  m_starts.reserve(m_segments.size() + 1);
+  u64 start = 0;
+  for (const Segment& segment : m_segments)
+  {
+    m_starts.push_back(start);
+    start += segment.length;
+  }
+  m_starts.push_back(start);
+}
+
+u64 Table::GetSize() const
+{
+  return m_starts.back();
+}
+
+std::vector<Table::Piece> Table::Translate(u64 address, size_t length) const
+{
+  std::vector<Piece> pieces;
+  if (address >= GetSize())
+    return pieces;
+
+  // The segment that contains the address is the last one that starts at or before it
+  size_t index =
+      std::upper_bound(m_starts.begin(), m_starts.end(), address) - m_starts.begin() - 1;
+  size_t buffer_offset = 0;
+  while (buffer_offset < length && index < m_segments.size())
+  {
+    const u64 segment_offset = address + buffer_offset - m_starts[index];
+    const u64 count =
+        std::min<u64>(m_segments[index].length - segment_offset, length - buffer_offset);
+    pieces.push_back({&m_segments[index], static_cast<u32>(segment_offset), buffer_offset,
+                      static_cast<u32>(count)});
+    buffer_offset += count;
+    ++index;
+  }
+  return pieces;
+}
+
+void Table::Read(u64 address, u8* out, size_t length) const
+{
+  std::memset(out, 0, length);
+
+  std::vector<GPUMemoryAccess::Access> gpu_accesses;
+  for (const Piece& piece : Translate(address, length))
+  {
+    const VanguardBlast::Domain domain = piece.segment->domain;
+    const u64 domain_address = u64(piece.segment->start) + piece.segment_offset;
+    u8* const dest = out + piece.buffer_offset;
+
+    if (IsGPUDomain(domain))
+    {
+      gpu_accesses.push_back({VanguardBlast::GetGPURegion(domain), false,
+                              static_cast<u32>(domain_address), piece.length, dest});
+      continue;
+    }
+
+    u32 size;
+    const u8* const memory = GetFlatMemory(domain, &size);
+    if (domain_address >= size)
+      continue;
+    const u32 count = static_cast<u32>(std::min<u64>(piece.length, size - domain_address));
+
+    if (memory)
+    {
+      std::memcpy(dest, memory + domain_address, count);
+    }
+    else if (domain == VanguardBlast::Domain::ARAM)
+    {
+      for (u32 i = 0; i < count; ++i)
+        dest[i] = DSP::ReadARAM(static_cast<u32>(domain_address) + i + ARAM_OFFSET);
+    }
+  }
+
+  VanguardBlast::RunGPUAccesses(gpu_accesses);
+}
+
+void Table::Write(u64 address, const u8* data, size_t length) const
+{
+  std::vector<GPUMemoryAccess::Access> gpu_accesses;
+  for (const Piece& piece : Translate(address, length))
+  {
+    const VanguardBlast::Domain domain = piece.segment->domain;
+    const u64 domain_address = u64(piece.segment->start) + piece.segment_offset;
+    const u8* const source = data + piece.buffer_offset;
+
+    if (IsGPUDomain(domain))
+    {
+      // Writes only read from the buffer
+      gpu_accesses.push_back({VanguardBlast::GetGPURegion(domain), true,
+                              static_cast<u32>(domain_address), piece.length,
+                              const_cast<u8*>(source)});
+      VanguardReplay::Record(domain, static_cast<u32>(domain_address), source, piece.length);
+      continue;
+    }
+
+    u32 size;
+    u8* const memory = GetFlatMemory(domain, &size);
+    if (domain_address >= size)
+      continue;
+    const u32 count = static_cast<u32>(std::min<u64>(piece.length, size - domain_address));
+    const u32 start = static_cast<u32>(domain_address);
+
+    if (memory)
+    {
+      std::memcpy(memory + start, source, count);
+    }
+    else if (domain == VanguardBlast::Domain::ARAM)
+    {
+      for (u32 i = 0; i < count; ++i)
+        DSP::WriteARAM(source[i], start + i + ARAM_OFFSET);
+    }
+    VanguardReplay::Record(domain, start, source, count);
+
+    if (domain == VanguardBlast::Domain::SRAM)
+      VanguardBlast::InvalidateCode(start + SRAM_OFFSET, count);
+    else if (domain == VanguardBlast::Domain::EXRAM)
+      VanguardBlast::InvalidateCode(start + EXRAM_OFFSET, count);
+  }
+
+  VanguardBlast::RunGPUAccesses(gpu_accesses);
+}
+}  // namespace VanguardVirtualDomain
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "NarrysMod/VanguardBlast.h"
+
+// Native side of RTC virtual memory domains. A VMD strings ranges of the real domains together
+// into one contiguous address space. Translating on this side lets whole ranges be read and
+// written at once, instead of crossing into managed code for each byte.
+namespace VanguardVirtualDomain
+{
+struct Segment
+{
+  VanguardBlast::Domain domain;
+  // Relative to the start of the domain
+  u32 start;
+  u32 length;
+};
+
+class Table
+{
+public:
+  // Empty segments are dropped
+  explicit Table(std::vector<Segment> segments);
+
+  u64 GetSize() const;
+
+  // Bytes that map to memory that isn't available read back as zero, and writes to it are dropped
+  void Read(u64 address, u8* out, size_t length) const;
+  void Write(u64 address, const u8* data, size_t length) const;
+
+private:
+  struct Piece
+  {
+    const Segment* segment;
+    // Offset into the segment, and into the caller's buffer
+    u32 segment_offset;
+    size_t buffer_offset;
+    u32 length;
+  };
+
+  // Splits [address, address + length) into the parts that fall into each segment
+  std::vector<Piece> Translate(u64 address, size_t length) const;
+
+  std::vector<Segment> m_segments;
+  // Where each segment starts in the virtual address space, followed by the total size
+  std::vector<u64> m_starts;
+};
+}  // namespace VanguardVirtualDomain
@@ -441,6 +441,7 @@ void NetPlayDialog::OnStart()
   settings.m_PAL60 = Config::Get(Config::SYSCONF_PAL60);
   settings.m_DSPHLE = Config::Get(Config::MAIN_DSP_HLE);
   settings.m_DSPEnableJIT = Config::Get(Config::MAIN_DSP_JIT);
+  settings.m_DSPThread = Config::Get(Config::MAIN_DSP_THREAD);
   settings.m_WriteToMemcard = m_save_sd_action->isChecked();
   settings.m_CopyWiiSave = m_load_wii_action->isChecked();
   settings.m_OCEnable = Config::Get(Config::MAIN_OVERCLOCK_ENABLE);
@@ -68,6 +68,13 @@ void AdvancedPane::CreateLayout()
       "Enables the Memory Management Unit, needed for some games. (ON = Compatible, OFF = Fast)"));
   cpu_options_layout->addWidget(m_enable_mmu_checkbox);
 
+  m_low_latency_pacing_checkbox = new QCheckBox(tr("Low Latency Frame Pacing"));
+  m_low_latency_pacing_checkbox->setToolTip(
+      tr("Waits for each frame to be presented and starts emulating the next one as late as "
+         "possible, so that controller input is read closer to when its result is shown. Only "
+         "takes effect at 100% emulation speed. Needs a fast enough system to keep full speed."));
+  cpu_options_layout->addWidget(m_low_latency_pacing_checkbox);
+
   auto* clock_override = new QGroupBox(tr("Clock Override"));
   auto* clock_override_layout = new QVBoxLayout();
   clock_override->setLayout(clock_override_layout);
@@ -179,6 +186,11 @@ void AdvancedPane::ConnectLayout()
   connect(m_enable_mmu_checkbox, &QCheckBox::toggled, this,
           [](bool checked) { SConfig::GetInstance().bMMU = checked; });
 
+  m_low_latency_pacing_checkbox->setChecked(Config::Get(Config::MAIN_LOW_LATENCY_PACING));
+  connect(m_low_latency_pacing_checkbox, &QCheckBox::toggled, [](bool checked) {
+    Config::SetBaseOrCurrent(Config::MAIN_LOW_LATENCY_PACING, checked);
+  });
+
   m_cpu_clock_override_checkbox->setChecked(SConfig::GetInstance().m_OCEnable);
   connect(m_cpu_clock_override_checkbox, &QCheckBox::toggled, [this](bool enable_clock_override) {
     SConfig::GetInstance().m_OCEnable = enable_clock_override;
@@ -52,6 +52,11 @@ std::string ControlReference::GetExpression() const
 
 void ControlReference::SetExpression(std::string expr)
 {
+  // Loading a profile sets every control, but usually only changes a few of them. Keeping the
+  // parsed expression of the others also keeps their state, e.g. toggles stay latched.
+  if (m_parsed_expression && expr == m_expression)
+    return;
+
   m_expression = std::move(expr);
   auto parse_result = ParseExpression(m_expression);
   m_parse_status = parse_result.status;
@@ -382,26 +382,31 @@ public:
   CoalesceExpression(std::unique_ptr<Expression>&& lhs, std::unique_ptr<Expression>&& rhs)
       : m_lhs(std::move(lhs)), m_rhs(std::move(rhs))
   {
+    UpdateActiveChild();
   }
 
-  ControlState GetValue() const override { return GetActiveChild()->GetValue(); }
-  void SetValue(ControlState value) override { GetActiveChild()->SetValue(value); }
+  ControlState GetValue() const override { return m_active_child->GetValue(); }
+  void SetValue(ControlState value) override { m_active_child->SetValue(value); }
 
-  int CountNumControls() const override { return GetActiveChild()->CountNumControls(); }
+  int CountNumControls() const override { return m_active_child->CountNumControls(); }
   void UpdateReferences(ControlEnvironment& env) override
   {
     m_lhs->UpdateReferences(env);
     m_rhs->UpdateReferences(env);
+    UpdateActiveChild();
   }
 
 private:
-  const std::unique_ptr<Expression>& GetActiveChild() const
+  // Which controls are bound only changes when references are updated. Counting them walks the
+  // whole left-hand tree, which is too slow to do on every evaluation.
+  void UpdateActiveChild()
   {
-    return m_lhs->CountNumControls() > 0 ? m_lhs : m_rhs;
+    m_active_child = m_lhs->CountNumControls() > 0 ? m_lhs.get() : m_rhs.get();
   }
 
   std::unique_ptr<Expression> m_lhs;
   std::unique_ptr<Expression> m_rhs;
+  Expression* m_active_child;
 };
 
 std::shared_ptr<Device> ControlEnvironment::FindDevice(ControlQualifier qualifier) const
@@ -643,6 +648,20 @@ private:
     }
   }
 
+  // An operation on two literals always evaluates to the same value, so evaluate it only once.
+  // Every operator is free of side effects when both of its operands are literals.
+  static std::unique_ptr<Expression> FoldConstants(std::unique_ptr<Expression>&& expr)
+  {
+    const auto& binary = static_cast<const BinaryExpression&>(*expr);
+    if (!dynamic_cast<const LiteralExpression*>(binary.lhs.get()) ||
+        !dynamic_cast<const LiteralExpression*>(binary.rhs.get()))
+    {
+      return std::move(expr);
+    }
+
+    return std::make_unique<LiteralReal>(expr->GetValue());
+  }
+
   ParseResult ParseBinary(int precedence = 999)
   {
     ParseResult lhs = ParseAtom(Chew());
@@ -663,6 +682,7 @@ private:
       }
 
       expr = std::make_unique<BinaryExpression>(tok.type, std::move(expr), std::move(rhs.expr));
+      expr = FoldConstants(std::move(expr));
     }
 
     return ParseResult::MakeSuccessfulResult(std::move(expr));
@@ -5,8 +5,12 @@
 #include "InputCommon/ControllerInterface/ControllerInterface.h"
 
 #include <algorithm>
+#include <chrono>
 
+#include "Common/Config/Config.h"
 #include "Common/Logging/Log.h"
+#include "Common/Thread.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/HW/WiimoteReal/WiimoteReal.h"
 
 #ifdef CIFACE_USE_WIN32
@@ -77,6 +81,13 @@ void ControllerInterface::Initialize(const WindowSystemInfo& wsi)
 #endif
 
   RefreshDevices();
+
+  const int polling_rate = Config::Get(Config::MAIN_INPUT_POLLING_RATE);
+  if (polling_rate > 0)
+  {
+    m_polling_thread_running.Set();
+    m_polling_thread = std::thread(&ControllerInterface::PollingThread, this, polling_rate);
+  }
 }
 
 void ControllerInterface::ChangeWindow(void* hwnd)
@@ -149,6 +160,9 @@ void ControllerInterface::Shutdown()
   // Prevent additional devices from being added during shutdown.
   m_is_init = false;
 
+  if (m_polling_thread_running.TestAndClear())
+    m_polling_thread.join();
+
   {
     std::lock_guard lk(m_devices_mutex);
 
@@ -252,12 +266,44 @@ void ControllerInterface::RemoveDevice(std::function<bool(const ciface::Core::De
 // Update input for all devices if lock can be acquired without waiting.
 void ControllerInterface::UpdateInput()
 {
+  // The polling thread keeps the devices up to date on its own.
+  if (m_polling_thread_running.IsSet())
+    return;
+
   // Don't block the UI or CPU thread (to avoid a short but noticeable frame drop)
   if (m_devices_mutex.try_lock())
   {
     std::lock_guard lk(m_devices_mutex, std::adopt_lock);
-    for (const auto& d : m_devices)
-      d->UpdateInput();
+    UpdateDevices();
+  }
+}
+
+void ControllerInterface::UpdateDevices()
+{
+  for (const auto& d : m_devices)
+    d->UpdateInput();
+}
+
+void ControllerInterface::PollingThread(int rate)
+{
+  Common::SetCurrentThreadName("Input Polling");
+
+  // Faster than any device reports, and keeps the loop from spinning.
+  constexpr int MAX_POLLING_RATE = 1000;
+  const auto interval = std::chrono::microseconds(1000000 / std::min(rate, MAX_POLLING_RATE));
+  auto next_poll = std::chrono::steady_clock::now();
+
+  while (m_polling_thread_running.IsSet())
+  {
+    {
+      // This thread has nothing else to do, so unlike UpdateInput, it can wait for the lock.
+      std::lock_guard lk(m_devices_mutex);
+      UpdateDevices();
+    }
+
+    // Don't try to catch up on polls that a slow device made us miss.
+    next_poll = std::max(next_poll + interval, std::chrono::steady_clock::now());
+    std::this_thread::sleep_until(next_poll);
   }
 }
 
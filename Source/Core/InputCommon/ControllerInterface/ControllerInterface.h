@@ -9,7 +9,9 @@
 #include <list>
 #include <memory>
 #include <mutex>
+#include <thread>
 
+#include "Common/Flag.h"
 #include "Common/Matrix.h"
 #include "Common/WindowSystemInfo.h"
 #include "InputCommon/ControllerInterface/Device.h"
@@ -66,12 +68,17 @@ public:
   void InvokeDevicesChangedCallbacks() const;
 
 private:
+  void PollingThread(int rate);
+  void UpdateDevices();
+
   std::list<std::function<void()>> m_devices_changed_callbacks;
   mutable std::mutex m_callbacks_mutex;
   std::atomic<bool> m_is_init;
   std::atomic<bool> m_is_populating_devices{false};
   WindowSystemInfo m_wsi;
   std::atomic<float> m_aspect_ratio_adjustment = 1;
+  std::thread m_polling_thread;
+  Common::Flag m_polling_thread_running;
 };
 
 extern ControllerInterface g_controller_interface;
@@ -147,6 +147,7 @@ private:
   bool m_prev_touch_valid = false;
   int m_touch_x = 0;
   int m_touch_y = 0;
+  u64 m_prev_motion_timestamp_us = 0;
 };
 
 using MathUtil::GRAVITY_ACCELERATION;
@@ -426,6 +427,13 @@ void Device::UpdateInput()
       ERROR_LOG(SERIALINTERFACE, "DualShockUDPClient UpdateInput send failed");
   }
 
+  // Servers usually send motion data faster than we poll, so several packets can be waiting here.
+  // The gyroscope is integrated over time, so taking only the last packet's rates loses whatever
+  // rotation happened during the others. Report the mean rate over all of them instead, weighted
+  // by the time each one covers, which adds up to the same rotation.
+  Common::Vec3 gyro_sum{};
+  u64 gyro_duration_us = 0;
+
   // Receive and handle controller data
   Proto::Message<Proto::MessageType::FromServer> msg;
   std::size_t received_bytes;
@@ -438,6 +446,16 @@ void Device::UpdateInput()
     {
       m_pad_data = *pad_data;
 
+      if (m_pad_data.timestamp_us > m_prev_motion_timestamp_us && m_prev_motion_timestamp_us != 0)
+      {
+        const u64 duration_us = m_pad_data.timestamp_us - m_prev_motion_timestamp_us;
+        gyro_sum += Common::Vec3(m_pad_data.gyro_pitch_deg_s, m_pad_data.gyro_yaw_deg_s,
+                                 m_pad_data.gyro_roll_deg_s) *
+                    float(duration_us);
+        gyro_duration_us += duration_us;
+      }
+      m_prev_motion_timestamp_us = m_pad_data.timestamp_us;
+
       // Update touch pad relative coordinates
       if (m_pad_data.touch1.id != m_prev_touch.id)
         m_prev_touch_valid = false;
@@ -452,6 +470,14 @@ void Device::UpdateInput()
       m_prev_touch_valid = true;
     }
   }
+
+  if (gyro_duration_us != 0)
+  {
+    const Common::Vec3 gyro_mean = gyro_sum / float(gyro_duration_us);
+    m_pad_data.gyro_pitch_deg_s = gyro_mean.x;
+    m_pad_data.gyro_yaw_deg_s = gyro_mean.y;
+    m_pad_data.gyro_roll_deg_s = gyro_mean.z;
+  }
 }
 
 std::optional<int> Device::GetPreferredId() const
@@ -90,6 +90,10 @@ static void Read()
     if (err)
       ERROR_LOG(SERIALINTERFACE, "adapter libusb read failed: err=%s", libusb_error_name(err));
 
+    // A read that timed out has no new report in it, only whatever part of one had arrived. The
+    // previous report is still the freshest complete one, so keep handing that out rather than
+    // making the controllers look disconnected until the next read.
+    if (err != LIBUSB_ERROR_TIMEOUT)
     {
       std::lock_guard<std::mutex> lk(s_mutex);
       std::swap(s_controller_payload_swap, s_controller_payload);
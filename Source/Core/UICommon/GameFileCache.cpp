@@ -5,12 +5,16 @@
 #include "UICommon/GameFileCache.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <functional>
+#include <future>
 #include <list>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -29,6 +33,11 @@ namespace UICommon
 {
 static constexpr u32 CACHE_REVISION = 18;  // Last changed in PR 8891
 
+// Reading a game's metadata is mostly waiting for the storage, which can be a slow network share,
+// so we use more threads than there are cores on machines with few of them
+static constexpr unsigned int MIN_SCAN_THREADS = 4;
+static constexpr unsigned int MAX_SCAN_THREADS = 16;
+
 std::vector<std::string> FindAllGamePaths(const std::vector<std::string>& directories_to_scan,
                                           bool recursive_scan)
 {
@@ -87,6 +96,88 @@ std::shared_ptr<const GameFile> GameFileCache::AddOrGet(const std::string& path,
   return result;
 }
 
+bool GameFileCache::AddOrGet(
+    const std::vector<std::string>& paths,
+    std::function<void(const std::shared_ptr<const GameFile>&)> game_found)
+{
+  std::unordered_map<std::string, size_t> cached_indices;
+  cached_indices.reserve(m_cached_files.size());
+  for (size_t i = 0; i < m_cached_files.size(); ++i)
+    cached_indices.emplace(m_cached_files[i]->GetFilePath(), i);
+
+  bool cache_changed = false;
+
+  std::vector<std::string> new_paths;
+  for (const std::string& path : paths)
+  {
+    const auto it = cached_indices.find(path);
+    if (it == cached_indices.end())
+    {
+      new_paths.push_back(path);
+      continue;
+    }
+
+    std::shared_ptr<GameFile>& game = m_cached_files[it->second];
+    cache_changed |= UpdateAdditionalMetadata(&game);
+    if (game_found)
+      game_found(game);
+  }
+
+  if (new_paths.empty())
+    return cache_changed;
+
+  CreateGameFiles(new_paths, true, [&](std::shared_ptr<GameFile> game) {
+    if (game_found)
+      game_found(game);
+    m_cached_files.push_back(std::move(game));
+  });
+
+  return true;
+}
+
+void GameFileCache::CreateGameFiles(const std::vector<std::string>& paths,
+                                    bool update_additional_metadata,
+                                    const std::function<void(std::shared_ptr<GameFile>)>& add_game)
+{
+  std::mutex mutex;
+  std::atomic<size_t> next_index = 0;
+
+  const auto create_game_files = [&] {
+    while (true)
+    {
+      const size_t index = next_index++;
+      if (index >= paths.size())
+        return;
+
+      std::shared_ptr<GameFile> game = std::make_shared<GameFile>(paths[index]);
+      if (!game->IsValid())
+        continue;
+
+      // This only touches the GameFile, and it may download a cover, so it's done before locking
+      if (update_additional_metadata)
+        UpdateAdditionalMetadata(&game);
+
+      std::lock_guard lk(mutex);
+      add_game(std::move(game));
+    }
+  };
+
+  const size_t num_threads = std::min<size_t>(
+      paths.size(),
+      std::clamp(std::thread::hardware_concurrency(), MIN_SCAN_THREADS, MAX_SCAN_THREADS));
+
+  // The calling thread is one of the threads
+  std::vector<std::future<void>> futures;
+  futures.reserve(num_threads - 1);
+  for (size_t i = 1; i < num_threads; ++i)
+    futures.push_back(std::async(std::launch::async, create_game_files));
+
+  create_game_files();
+
+  for (std::future<void>& future : futures)
+    future.get();
+}
+
 bool GameFileCache::Update(
     const std::vector<std::string>& all_game_paths,
     std::function<void(const std::shared_ptr<const GameFile>&)> game_added_to_cache,
@@ -132,18 +223,14 @@ bool GameFileCache::Update(
 
   // Now that the previous loop has run, game_paths only contains paths that
   // aren't in m_cached_files, so we simply add all of them to m_cached_files.
-  for (const std::string& path : game_paths)
-  {
-    auto file = std::make_shared<GameFile>(path);
-    if (file->IsValid())
-    {
-      if (game_added_to_cache)
-        game_added_to_cache(file);
-
-      cache_changed = true;
-      m_cached_files.push_back(std::move(file));
-    }
-  }
+  CreateGameFiles({game_paths.begin(), game_paths.end()}, false,
+                  [&](std::shared_ptr<GameFile> file) {
+                    if (game_added_to_cache)
+                      game_added_to_cache(file);
+
+                    cache_changed = true;
+                    m_cached_files.push_back(std::move(file));
+                  });
 
   return cache_changed;
 }
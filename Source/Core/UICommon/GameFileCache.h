@@ -40,6 +40,12 @@ public:
 
   // Returns nullptr if the file is invalid.
   std::shared_ptr<const GameFile> AddOrGet(const std::string& path, bool* cache_changed);
+  // Like calling the above for each path, except that the files which aren't in the cache yet are
+  // read on several threads at once. game_found is called once for every valid file. It can be
+  // called from any of those threads, but never from two of them at the same time.
+  // Returns true if the call modified the cache.
+  bool AddOrGet(const std::vector<std::string>& paths,
+                std::function<void(const std::shared_ptr<const GameFile>&)> game_found);
 
   // These functions return true if the call modified the cache.
   bool Update(const std::vector<std::string>& all_game_paths,
@@ -54,6 +60,11 @@ public:
 private:
   bool UpdateAdditionalMetadata(std::shared_ptr<GameFile>* game_file);
 
+  // Creates a GameFile for each path on several threads, optionally updates its additional
+  // metadata, and calls add_game for the valid ones, never from two threads at the same time.
+  void CreateGameFiles(const std::vector<std::string>& paths, bool update_additional_metadata,
+                       const std::function<void(std::shared_ptr<GameFile>)>& add_game);
+
   bool SyncCacheFile(bool save);
   void DoState(PointerWrap* p, u64 size = 0);
 
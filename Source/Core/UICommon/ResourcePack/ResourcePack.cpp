@@ -5,6 +5,10 @@
 #include "UICommon/ResourcePack/ResourcePack.h"
 
 #include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <unordered_set>
 
 #include <unzip.h>
 
@@ -14,6 +18,7 @@
 #include "Common/MinizipUtil.h"
 #include "Common/ScopeGuard.h"
 #include "Common/StringUtil.h"
+#include "Common/ThreadPool.h"
 
 #include "UICommon/ResourcePack/Manager.h"
 #include "UICommon/ResourcePack/Manifest.h"
@@ -21,6 +26,29 @@
 namespace ResourcePack
 {
 constexpr char TEXTURE_PATH[] = HIRES_TEXTURES_DIR DIR_SEP;
+// Textures extracted by each job of an install, which opens the pack once for all of them
+constexpr size_t INSTALL_CHUNK_SIZE = 64;
+
+// Extracts the texture at the given central directory location of the pack to texture_path.
+static bool ExtractTexture(unzFile file, u64 directory_offset, u64 file_number,
+                           const std::string& texture_path, std::vector<char>* data)
+{
+  const unz64_file_pos position{directory_offset, file_number};
+  if (unzGoToFilePos64(file, &position) != UNZ_OK)
+    return false;
+
+  unz_file_info texture_info;
+  unzGetCurrentFileInfo(file, &texture_info, nullptr, 0, nullptr, 0, nullptr, 0);
+
+  data->resize(texture_info.uncompressed_size);
+  if (!Common::ReadFileFromZip(file, data))
+    return false;
+
+  std::ofstream out(texture_path, std::ios::trunc | std::ios::binary);
+  out.write(data->data(), data->size());
+  out.flush();
+  return out.good();
+}
 
 ResourcePack::ResourcePack(const std::string& path) : m_path(path)
 {
@@ -98,7 +126,10 @@ ResourcePack::ResourcePack(const std::string& path) : m_path(path)
       return;
     }
 
+    unz64_file_pos position;
+    unzGetFilePos64(file, &position);
     m_textures.push_back(filename.substr(9));
+    m_texture_locations.push_back({position.pos_in_zip_directory, position.num_of_file});
   } while (unzGoToNextFile(file) != UNZ_END_OF_LIST_OF_FILE);
 }
 
@@ -140,64 +171,71 @@ bool ResourcePack::Install(const std::string& path)
     return false;
   }
 
-  auto file = unzOpen(m_path.c_str());
-  Common::ScopeGuard file_guard{[&] { unzClose(file); }};
+  // Check which textures a higher priority pack already provides once, don't overwrite those
+  std::unordered_set<std::string> provided_by_other_packs;
+  for (const auto& pack : GetHigherPriorityPacks(*this))
+    provided_by_other_packs.insert(pack->GetTextures().begin(), pack->GetTextures().end());
 
-  for (const auto& texture : m_textures)
+  std::vector<size_t> textures_to_install;
+  std::set<std::string> directories;
+  for (size_t i = 0; i < m_textures.size(); i++)
   {
-    bool provided_by_other_pack = false;
-
-    // Check if a higher priority pack already provides a given texture, don't overwrite it
-    for (const auto& pack : GetHigherPriorityPacks(*this))
-    {
-      if (std::find(pack->GetTextures().begin(), pack->GetTextures().end(), texture) !=
-          pack->GetTextures().end())
-      {
-        provided_by_other_pack = true;
-        break;
-      }
-    }
-
-    if (provided_by_other_pack)
+    if (provided_by_other_packs.count(m_textures[i]) != 0)
       continue;
 
-    if (unzLocateFile(file, ("textures/" + texture).c_str(), 0) != UNZ_OK)
-    {
-      m_error = "Failed to locate texture " + texture;
-      return false;
-    }
-
-    const std::string texture_path = path + TEXTURE_PATH + texture;
-    std::string m_full_dir;
-    SplitPath(texture_path, &m_full_dir, nullptr, nullptr);
+    std::string directory;
+    SplitPath(path + TEXTURE_PATH + m_textures[i], &directory, nullptr, nullptr);
+    directories.insert(std::move(directory));
+    textures_to_install.push_back(i);
+  }
 
-    if (!File::CreateFullPath(m_full_dir))
+  // Create the directories before extracting, so the jobs don't race on creating their parents
+  for (const std::string& directory : directories)
+  {
+    if (!File::CreateFullPath(directory))
     {
-      m_error = "Failed to create full path " + m_full_dir;
+      m_error = "Failed to create full path " + directory;
       return false;
     }
+  }
 
-    unz_file_info texture_info;
-    unzGetCurrentFileInfo(file, &texture_info, nullptr, 0, nullptr, 0, nullptr, 0);
-
-    std::vector<char> data(texture_info.uncompressed_size);
-    if (!Common::ReadFileFromZip(file, &data))
+  // minizip handles can't be shared between threads, so each job opens the pack itself
+  std::mutex error_mutex;
+  std::atomic<bool> failed{false};
+  const auto set_error = [&](std::string error) {
+    std::lock_guard lock(error_mutex);
+    if (!failed.exchange(true))
+      m_error = std::move(error);
+  };
+
+  const size_t count = textures_to_install.size();
+  const size_t chunks = (count + INSTALL_CHUNK_SIZE - 1) / INSTALL_CHUNK_SIZE;
+  Common::ThreadPool::ParallelFor(chunks, [&](size_t chunk) {
+    auto file = unzOpen(m_path.c_str());
+    Common::ScopeGuard file_guard{[&] { unzClose(file); }};
+    if (file == nullptr)
     {
-      m_error = "Failed to read texture " + texture;
-      return false;
+      set_error("Failed to open resource pack");
+      return;
     }
 
-    std::ofstream out(texture_path, std::ios::trunc | std::ios::binary);
-
-    if (!out.good())
+    std::vector<char> data;
+    const size_t end = std::min(count, (chunk + 1) * INSTALL_CHUNK_SIZE);
+    for (size_t i = chunk * INSTALL_CHUNK_SIZE; i < end && !failed; i++)
     {
-      m_error = "Failed to write " + texture;
-      return false;
+      const size_t index = textures_to_install[i];
+      const TextureLocation& location = m_texture_locations[index];
+      if (!ExtractTexture(file, location.directory_offset, location.file_number,
+                          path + TEXTURE_PATH + m_textures[index], &data))
+      {
+        set_error("Failed to install texture " + m_textures[index]);
+        return;
+      }
     }
+  });
 
-    out.write(data.data(), data.size());
-    out.flush();
-  }
+  if (failed)
+    return false;
 
   SetInstalled(*this, true);
   return true;
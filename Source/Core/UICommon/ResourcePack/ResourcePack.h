@@ -41,6 +41,13 @@ private:
 
   std::shared_ptr<Manifest> m_manifest;
   std::vector<std::string> m_textures;
+  // Where each texture is in the zip's central directory, so it can be found without a search
+  struct TextureLocation
+  {
+    u64 directory_offset;
+    u64 file_number;
+  };
+  std::vector<TextureLocation> m_texture_locations;
   std::vector<char> m_logo_data;
 };
 }  // namespace ResourcePack
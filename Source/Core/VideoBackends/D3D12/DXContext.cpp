@@ -12,6 +12,8 @@
 
 #include "Common/Assert.h"
 #include "Common/DynamicLibrary.h"
+#include "Common/Logging/Log.h"
+#include "Common/MathUtil.h"
 #include "Common/StringUtil.h"
 #include "VideoBackends/D3D12/Common.h"
 #include "VideoBackends/D3D12/DescriptorHeapManager.h"
@@ -470,6 +472,8 @@ void DXContext::MoveToNextCommandList()
 void DXContext::ExecuteCommandList(bool wait_for_completion)
 {
   CommandListResources& res = m_command_lists[m_current_command_list];
+  res.descriptor_allocator.FlushPendingCopies();
+  res.sampler_allocator.FlushPendingCopies();
 
   // Close and queue command list.
   HRESULT hr = res.command_list->Close();
@@ -487,6 +491,30 @@ void DXContext::ExecuteCommandList(bool wait_for_completion)
     WaitForFence(res.ready_fence_value);
 }
 
+StreamBuffer* DXContext::GetLargeTextureUploadBuffer(u32 size)
+{
+  if (m_large_texture_upload_buffer && m_large_texture_upload_buffer->GetSize() / 2 >= size)
+    return m_large_texture_upload_buffer.get();
+
+  if (size > MAX_LARGE_TEXTURE_UPLOAD_BUFFER_SIZE / 2)
+    return nullptr;
+
+  // StreamBuffer releases its resource right away, so keep it alive until the command lists that
+  // copy from it have completed.
+  if (m_large_texture_upload_buffer)
+    DeferResourceDestruction(m_large_texture_upload_buffer->GetBuffer());
+
+  const u32 new_size =
+      std::max(LARGE_TEXTURE_UPLOAD_BUFFER_SIZE, MathUtil::NextPowerOf2(size * 2));
+  m_large_texture_upload_buffer = std::make_unique<StreamBuffer>();
+  if (!m_large_texture_upload_buffer->AllocateBuffer(new_size))
+  {
+    WARN_LOG(VIDEO, "Failed to create a %u byte texture upload buffer", new_size);
+    m_large_texture_upload_buffer.reset();
+  }
+  return m_large_texture_upload_buffer.get();
+}
+
 void DXContext::DeferResourceDestruction(ID3D12Resource* resource)
 {
   resource->AddRef();
@@ -97,6 +97,11 @@ public:
   // Texture streaming buffer for uploads.
   StreamBuffer& GetTextureUploadBuffer() { return m_texture_upload_buffer; }
 
+  // Texture streaming buffer for uploads that are too large for the one above, grown to fit size
+  // if needed. Returns nullptr if it can't be made large enough. Must not be called while memory
+  // is reserved in the buffer.
+  StreamBuffer* GetLargeTextureUploadBuffer(u32 size);
+
   // Feature level to use when compiling shaders.
   D3D_FEATURE_LEVEL GetFeatureLevel() const { return m_feature_level; }
 
@@ -131,6 +136,11 @@ private:
   // Textures that don't fit into this buffer will be uploaded with a staging buffer.
   static const u32 TEXTURE_UPLOAD_BUFFER_SIZE = 32 * 1024 * 1024;
 
+  // The buffer for large uploads is created on first use with this size, and grows to hold at
+  // least two uploads of the largest size seen so far, up to the maximum.
+  static const u32 LARGE_TEXTURE_UPLOAD_BUFFER_SIZE = 64 * 1024 * 1024;
+  static const u32 MAX_LARGE_TEXTURE_UPLOAD_BUFFER_SIZE = 1024 * 1024 * 1024;
+
   struct CommandListResources
   {
     ComPtr<ID3D12CommandAllocator> command_allocator;
@@ -184,6 +194,7 @@ private:
   ComPtr<ID3D12RootSignature> m_compute_root_signature;
 
   StreamBuffer m_texture_upload_buffer;
+  std::unique_ptr<StreamBuffer> m_large_texture_upload_buffer;
 };
 
 extern std::unique_ptr<DXContext> g_dx_context;
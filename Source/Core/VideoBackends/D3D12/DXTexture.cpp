@@ -198,11 +198,11 @@ bool DXTexture::CreateUAVDescriptor()
 void DXTexture::Load(u32 level, u32 width, u32 height, u32 row_length, const u8* buffer,
                      size_t buffer_size)
 {
-  // Textures greater than 1024*1024 will be put in staging textures that are released after
-  // execution instead. A 2048x2048 texture is 16MB, and we'd only fit four of these in our
-  // streaming buffer and be blocking frequently. Games are unlikely to have textures this
-  // large anyway, so it's only really an issue for HD texture packs, and memory is not
-  // a limiting factor in these scenarios anyway.
+  // Textures greater than 1024*1024 will be put in a separate buffer for large uploads instead. A
+  // 2048x2048 texture is 16MB, and we'd only fit four of these in our streaming buffer and be
+  // blocking frequently. Games are unlikely to have textures this large anyway, so it's only
+  // really an issue for HD texture packs. Uploads that are too large even for that buffer get
+  // staging textures that are released after execution.
   constexpr u32 STAGING_BUFFER_UPLOAD_THRESHOLD = 1024 * 1024 * 4;
 
   // Determine the stride in the stream buffer. It must be aligned to 256 bytes.
@@ -215,11 +215,14 @@ void DXTexture::Load(u32 level, u32 width, u32 height, u32 row_length, const u8*
   // Both paths need us in COPY_DEST state, and avoids switching back and forth for mips.
   TransitionToState(D3D12_RESOURCE_STATE_COPY_DEST);
 
+  StreamBuffer* stream_buffer = upload_size < STAGING_BUFFER_UPLOAD_THRESHOLD ?
+                                    &g_dx_context->GetTextureUploadBuffer() :
+                                    g_dx_context->GetLargeTextureUploadBuffer(upload_size);
   ComPtr<ID3D12Resource> staging_buffer;
   ID3D12Resource* upload_buffer_resource;
   void* upload_buffer_ptr;
   u32 upload_buffer_offset;
-  if (upload_size >= STAGING_BUFFER_UPLOAD_THRESHOLD)
+  if (!stream_buffer)
   {
     const D3D12_RANGE read_range = {0, 0};
     staging_buffer = CreateTextureUploadBuffer(upload_size);
@@ -236,22 +239,20 @@ void DXTexture::Load(u32 level, u32 width, u32 height, u32 row_length, const u8*
   }
   else
   {
-    if (!g_dx_context->GetTextureUploadBuffer().ReserveMemory(
-            upload_size, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT))
+    if (!stream_buffer->ReserveMemory(upload_size, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT))
     {
       WARN_LOG(VIDEO, "Executing command list while waiting for space in texture upload buffer");
       Renderer::GetInstance()->ExecuteCommandList(false);
-      if (!g_dx_context->GetTextureUploadBuffer().ReserveMemory(
-              upload_size, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT))
+      if (!stream_buffer->ReserveMemory(upload_size, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT))
       {
         PanicAlert("Failed to allocate texture upload buffer");
         return;
       }
     }
 
-    upload_buffer_resource = g_dx_context->GetTextureUploadBuffer().GetBuffer();
-    upload_buffer_ptr = g_dx_context->GetTextureUploadBuffer().GetCurrentHostPointer();
-    upload_buffer_offset = g_dx_context->GetTextureUploadBuffer().GetCurrentOffset();
+    upload_buffer_resource = stream_buffer->GetBuffer();
+    upload_buffer_ptr = stream_buffer->GetCurrentHostPointer();
+    upload_buffer_offset = stream_buffer->GetCurrentOffset();
   }
 
   // Copy in, slow path if the pitch differs.
@@ -279,7 +280,7 @@ void DXTexture::Load(u32 level, u32 width, u32 height, u32 row_length, const u8*
   }
   else
   {
-    g_dx_context->GetTextureUploadBuffer().CommitMemory(upload_size);
+    stream_buffer->CommitMemory(upload_size);
   }
 
   // Issue copy from buffer->texture.
@@ -20,6 +20,7 @@ bool DescriptorAllocator::Create(ID3D12Device* device, D3D12_DESCRIPTOR_HEAP_TYP
   if (FAILED(hr))
     return false;
 
+  m_type = type;
   m_num_descriptors = num_descriptors;
   m_descriptor_increment_size = device->GetDescriptorHandleIncrementSize(type);
   m_heap_base_cpu = m_descriptor_heap->GetCPUDescriptorHandleForHeapStart();
@@ -43,7 +44,57 @@ bool DescriptorAllocator::Allocate(u32 num_handles, DescriptorHandle* out_base_h
 
 void DescriptorAllocator::Reset()
 {
+  // Pending copies are kept, as the command list being recorded may still use those tables.
   m_current_offset = 0;
+  m_texture_group_map.clear();
+}
+
+bool DescriptorAllocator::GetTextureGroupHandle(const TextureDescriptorSet& tds,
+                                                D3D12_GPU_DESCRIPTOR_HANDLE* handle)
+{
+  auto it = m_texture_group_map.find(tds);
+  if (it != m_texture_group_map.end())
+  {
+    *handle = it->second;
+    return true;
+  }
+
+  DescriptorHandle allocation;
+  if (!Allocate(TextureDescriptorSet::NUM_TEXTURES_PER_GROUP, &allocation))
+    return false;
+
+  QueueCopy(allocation.cpu_handle, tds.handles, TextureDescriptorSet::NUM_TEXTURES_PER_GROUP);
+  *handle = allocation.gpu_handle;
+  m_texture_group_map.emplace(tds, allocation.gpu_handle);
+  return true;
+}
+
+void DescriptorAllocator::QueueCopy(D3D12_CPU_DESCRIPTOR_HANDLE dst,
+                                    const D3D12_CPU_DESCRIPTOR_HANDLE* src, u32 num_handles)
+{
+  m_pending_copy_dst.push_back(dst);
+  m_pending_copy_dst_sizes.push_back(num_handles);
+  m_pending_copy_src.insert(m_pending_copy_src.end(), src, src + num_handles);
+}
+
+void DescriptorAllocator::FlushPendingCopies()
+{
+  if (m_pending_copy_dst.empty())
+    return;
+
+  // A null source size array means every source range is a single descriptor.
+  g_dx_context->GetDevice()->CopyDescriptors(
+      static_cast<UINT>(m_pending_copy_dst.size()), m_pending_copy_dst.data(),
+      m_pending_copy_dst_sizes.data(), static_cast<UINT>(m_pending_copy_src.size()),
+      m_pending_copy_src.data(), nullptr, m_type);
+  m_pending_copy_dst.clear();
+  m_pending_copy_dst_sizes.clear();
+  m_pending_copy_src.clear();
+}
+
+bool operator<(const TextureDescriptorSet& lhs, const TextureDescriptorSet& rhs)
+{
+  return std::memcmp(lhs.handles, rhs.handles, sizeof(lhs.handles)) < 0;
 }
 
 bool operator==(const SamplerStateSet& lhs, const SamplerStateSet& rhs)
@@ -95,12 +146,7 @@ bool SamplerAllocator::GetGroupHandle(const SamplerStateSet& sss,
   }
 
   // Copy samplers from the sampler heap.
-  static constexpr std::array<UINT, SamplerStateSet::NUM_SAMPLERS_PER_GROUP> source_sizes = {
-      {1, 1, 1, 1, 1, 1, 1, 1}};
-  g_dx_context->GetDevice()->CopyDescriptors(
-      1, &allocation.cpu_handle, &SamplerStateSet::NUM_SAMPLERS_PER_GROUP,
-      SamplerStateSet::NUM_SAMPLERS_PER_GROUP, source_handles.data(), source_sizes.data(),
-      D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER);
+  QueueCopy(allocation.cpu_handle, source_handles.data(), SamplerStateSet::NUM_SAMPLERS_PER_GROUP);
   *handle = allocation.gpu_handle;
   m_sampler_map.emplace(sss, allocation.gpu_handle);
   return true;
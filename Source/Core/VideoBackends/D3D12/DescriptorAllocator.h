@@ -5,10 +5,19 @@
 #pragma once
 
 #include <map>
+#include <vector>
 #include "VideoBackends/D3D12/DescriptorHeapManager.h"
 
 namespace DX12
 {
+struct TextureDescriptorSet final
+{
+  static const u32 NUM_TEXTURES_PER_GROUP = 8;
+  D3D12_CPU_DESCRIPTOR_HANDLE handles[NUM_TEXTURES_PER_GROUP];
+};
+
+bool operator<(const TextureDescriptorSet& lhs, const TextureDescriptorSet& rhs);
+
 class DescriptorAllocator
 {
 public:
@@ -23,14 +32,31 @@ public:
   bool Allocate(u32 num_handles, DescriptorHandle* out_base_handle);
   void Reset();
 
+  // Returns a table holding copies of the given shadow heap descriptors. Until the next reset,
+  // draws binding the same set of textures share one table instead of copying it again.
+  bool GetTextureGroupHandle(const TextureDescriptorSet& tds, D3D12_GPU_DESCRIPTOR_HANDLE* handle);
+
+  // Copies into the heap are queued, and done in a single call before the command list executes.
+  void QueueCopy(D3D12_CPU_DESCRIPTOR_HANDLE dst, const D3D12_CPU_DESCRIPTOR_HANDLE* src,
+                 u32 num_handles);
+  void FlushPendingCopies();
+
 protected:
   ComPtr<ID3D12DescriptorHeap> m_descriptor_heap;
+  D3D12_DESCRIPTOR_HEAP_TYPE m_type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
   u32 m_descriptor_increment_size = 0;
   u32 m_num_descriptors = 0;
   u32 m_current_offset = 0;
 
   D3D12_CPU_DESCRIPTOR_HANDLE m_heap_base_cpu = {};
   D3D12_GPU_DESCRIPTOR_HANDLE m_heap_base_gpu = {};
+
+  std::map<TextureDescriptorSet, D3D12_GPU_DESCRIPTOR_HANDLE> m_texture_group_map;
+
+  // Destination ranges, and the single descriptors that are copied into them, in order.
+  std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> m_pending_copy_dst;
+  std::vector<UINT> m_pending_copy_dst_sizes;
+  std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> m_pending_copy_src;
 };
 
 struct SamplerStateSet final
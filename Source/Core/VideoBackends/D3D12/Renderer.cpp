@@ -2,6 +2,8 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
+
 #include "Common/Logging/Log.h"
 
 #include "VideoBackends/D3D12/BoundingBox.h"
@@ -15,6 +17,7 @@
 #include "VideoBackends/D3D12/PerfQuery.h"
 #include "VideoBackends/D3D12/Renderer.h"
 #include "VideoBackends/D3D12/SwapChain.h"
+#include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/VideoConfig.h"
 
 namespace DX12
@@ -135,6 +138,9 @@ void Renderer::WaitForGPUIdle()
 void Renderer::ClearScreen(const MathUtil::Rectangle<int>& rc, bool color_enable, bool alpha_enable,
                            bool z_enable, u32 color, u32 z)
 {
+  g_framebuffer_manager->FlushEFBPokes();
+  g_framebuffer_manager->FlagPeekCacheAsOutOfDate();
+
   // Use a fast path without the shader if both color/alpha are enabled.
   const bool fast_color_clear = color_enable && (alpha_enable || !EFBHasAlphaChannel());
   if (fast_color_clear || z_enable)
@@ -666,16 +672,15 @@ void Renderer::UpdateDescriptorTables()
 
 bool Renderer::UpdateSRVDescriptorTable()
 {
-  static constexpr std::array<UINT, MAX_TEXTURES> src_sizes = {1, 1, 1, 1, 1, 1, 1, 1};
-  DescriptorHandle dst_base_handle;
-  const UINT dst_handle_sizes = 8;
-  if (!g_dx_context->GetDescriptorAllocator()->Allocate(MAX_TEXTURES, &dst_base_handle))
+  static_assert(TextureDescriptorSet::NUM_TEXTURES_PER_GROUP == MAX_TEXTURES);
+  TextureDescriptorSet tds;
+  std::copy(m_state.textures.begin(), m_state.textures.end(), tds.handles);
+  if (!g_dx_context->GetDescriptorAllocator()->GetTextureGroupHandle(tds,
+                                                                     &m_state.srv_descriptor_base))
+  {
     return false;
+  }
 
-  g_dx_context->GetDevice()->CopyDescriptors(
-      1, &dst_base_handle.cpu_handle, &dst_handle_sizes, MAX_TEXTURES, m_state.textures.data(),
-      src_sizes.data(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-  m_state.srv_descriptor_base = dst_base_handle.gpu_handle;
   m_dirty_bits = (m_dirty_bits & ~DirtyState_Textures) | DirtyState_SRV_Descriptor;
   return true;
 }
@@ -703,8 +708,7 @@ bool Renderer::UpdateUAVDescriptorTable()
   if (!g_dx_context->GetDescriptorAllocator()->Allocate(1, &handle))
     return false;
 
-  g_dx_context->GetDevice()->CopyDescriptorsSimple(1, handle.cpu_handle, m_state.ps_uav,
-                                                   D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+  g_dx_context->GetDescriptorAllocator()->QueueCopy(handle.cpu_handle, &m_state.ps_uav, 1);
   m_state.uav_descriptor_base = handle.gpu_handle;
   m_dirty_bits = (m_dirty_bits & ~DirtyState_PS_UAV) | DirtyState_UAV_Descriptor;
   return true;
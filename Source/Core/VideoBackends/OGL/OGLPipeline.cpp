@@ -54,26 +54,14 @@ AbstractPipeline::CacheData OGLPipeline::GetCacheData() const
   if (!g_ActiveConfig.backend_info.bSupportsPipelineCacheData || m_program->binary_retrieved)
     return {};
 
-  GLint program_size = 0;
-  glGetProgramiv(m_program->shader.glprogid, GL_PROGRAM_BINARY_LENGTH, &program_size);
-  if (program_size == 0)
+  // Programs linked on a compiler thread had their binary retrieved there already.
+  CacheData data;
+  data.swap(m_program->binary);
+  if (data.empty())
+    data = ProgramShaderCache::GetProgramBinary(m_program->shader.glprogid);
+  if (data.empty())
     return {};
 
-  // Clear any existing error.
-  glGetError();
-
-  // We pack the format at the start of the buffer.
-  CacheData data(program_size + sizeof(u32));
-  GLsizei data_size = 0;
-  GLenum program_format = 0;
-  glGetProgramBinary(m_program->shader.glprogid, program_size, &data_size, &program_format,
-                     &data[sizeof(u32)]);
-  if (glGetError() != GL_NO_ERROR || data_size == 0)
-    return {};
-
-  u32 program_format_u32 = static_cast<u32>(program_format);
-  std::memcpy(&data[0], &program_format_u32, sizeof(u32));
-  data.resize(data_size + sizeof(u32));
   m_program->binary_retrieved = true;
   return data;
 }
@@ -8,6 +8,7 @@
 #include <atomic>
 #include <memory>
 #include <string>
+#include <thread>
 
 #include "Common/Align.h"
 #include "Common/Assert.h"
@@ -45,6 +46,7 @@ GLuint ProgramShaderCache::s_attributeless_VAO = 0;
 GLuint ProgramShaderCache::s_last_VAO = 0;
 
 static std::unique_ptr<StreamBuffer> s_buffer;
+static u32 s_buffer_wrap_count = 0;
 static int num_failures = 0;
 
 static GLuint CurrentProgram = 0;
@@ -224,36 +226,46 @@ u32 ProgramShaderCache::GetUniformBufferAlignment()
 
 void ProgramShaderCache::UploadConstants()
 {
-  if (PixelShaderManager::dirty || VertexShaderManager::dirty || GeometryShaderManager::dirty)
-  {
-    auto buffer = s_buffer->Map(s_ubo_buffer_size, s_ubo_align);
-
-    memcpy(buffer.first, &PixelShaderManager::constants, sizeof(PixelShaderConstants));
-
-    memcpy(buffer.first + Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align),
-           &VertexShaderManager::constants, sizeof(VertexShaderConstants));
-
-    memcpy(buffer.first + Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align) +
-               Common::AlignUp(sizeof(VertexShaderConstants), s_ubo_align),
-           &GeometryShaderManager::constants, sizeof(GeometryShaderConstants));
-
-    s_buffer->Unmap(s_ubo_buffer_size);
-    glBindBufferRange(GL_UNIFORM_BUFFER, 1, s_buffer->m_buffer, buffer.second,
-                      sizeof(PixelShaderConstants));
-    glBindBufferRange(GL_UNIFORM_BUFFER, 2, s_buffer->m_buffer,
-                      buffer.second + Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align),
-                      sizeof(VertexShaderConstants));
-    glBindBufferRange(GL_UNIFORM_BUFFER, 3, s_buffer->m_buffer,
-                      buffer.second + Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align) +
-                          Common::AlignUp(sizeof(VertexShaderConstants), s_ubo_align),
-                      sizeof(GeometryShaderConstants));
-
-    PixelShaderManager::dirty = false;
-    VertexShaderManager::dirty = false;
-    GeometryShaderManager::dirty = false;
+  if (!PixelShaderManager::dirty && !VertexShaderManager::dirty && !GeometryShaderManager::dirty)
+    return;
 
-    ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, s_ubo_buffer_size);
+  struct UniformBlock
+  {
+    GLuint index;
+    const void* data;
+    u32 size;
+    bool* dirty;
+  };
+  const std::array<UniformBlock, 3> blocks = {{
+      {1, &PixelShaderManager::constants, sizeof(PixelShaderConstants),
+       &PixelShaderManager::dirty},
+      {2, &VertexShaderManager::constants, sizeof(VertexShaderConstants),
+       &VertexShaderManager::dirty},
+      {3, &GeometryShaderManager::constants, sizeof(GeometryShaderConstants),
+       &GeometryShaderManager::dirty},
+  }};
+
+  // Only the blocks that changed are streamed, the others stay bound where they were last written.
+  // That data is only still there as long as the buffer hasn't wrapped around since.
+  auto buffer = s_buffer->Map(s_ubo_buffer_size, s_ubo_align);
+  const bool upload_all = s_buffer->GetWrapCount() != s_buffer_wrap_count;
+  s_buffer_wrap_count = s_buffer->GetWrapCount();
+
+  u32 used_size = 0;
+  for (const UniformBlock& block : blocks)
+  {
+    if (!upload_all && !*block.dirty)
+      continue;
+
+    std::memcpy(buffer.first + used_size, block.data, block.size);
+    glBindBufferRange(GL_UNIFORM_BUFFER, block.index, s_buffer->m_buffer,
+                      buffer.second + used_size, block.size);
+    used_size += Common::AlignUp(block.size, s_ubo_align);
+    *block.dirty = false;
   }
+
+  s_buffer->Unmap(used_size);
+  ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, used_size);
 }
 
 void ProgramShaderCache::UploadConstants(const void* data, u32 data_size)
@@ -271,6 +283,37 @@ void ProgramShaderCache::UploadConstants(const void* data, u32 data_size)
   ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, data_size);
 }
 
+// With KHR_parallel_shader_compile, the driver compiles and links on its own threads and querying
+// any other status waits for it. Polling for completion keeps this thread out of the driver while
+// that happens, so other contexts can submit their work in the meantime.
+static void WaitForCompletion(GLuint id, bool is_program)
+{
+  if (!g_ogl_config.bSupportsParallelShaderCompile)
+    return;
+
+  GLint complete = GL_FALSE;
+  while (true)
+  {
+    if (is_program)
+      glGetProgramiv(id, GL_COMPLETION_STATUS_KHR, &complete);
+    else
+      glGetShaderiv(id, GL_COMPLETION_STATUS_KHR, &complete);
+    if (complete == GL_TRUE)
+      return;
+
+    std::this_thread::yield();
+  }
+}
+
+static bool IsProgramLinked(GLuint id)
+{
+  WaitForCompletion(id, true);
+
+  GLint link_status;
+  glGetProgramiv(id, GL_LINK_STATUS, &link_status);
+  return link_status == GL_TRUE;
+}
+
 bool ProgramShaderCache::CompileComputeShader(SHADER& shader, std::string_view code)
 {
   // We need to enable GL_ARB_compute_shader for drivers that support the extension,
@@ -292,10 +335,16 @@ bool ProgramShaderCache::CompileComputeShader(SHADER& shader, std::string_view c
   shader.SetProgramBindings(true);
   glLinkProgram(shader.glprogid);
 
+  // The shader wasn't checked if it was compiled in parallel, and it's the likely culprit of a link
+  // failure, so check it before it goes away.
+  const bool shader_failed =
+      g_ogl_config.bSupportsParallelShaderCompile && !IsProgramLinked(shader.glprogid) &&
+      !CheckShaderCompileResult(shader_id, GL_COMPUTE_SHADER, full_code);
+
   // original shaders aren't needed any more
   glDeleteShader(shader_id);
 
-  if (!CheckProgramLinkResult(shader.glprogid, full_code, {}, {}))
+  if (shader_failed || !CheckProgramLinkResult(shader.glprogid, full_code, {}, {}))
   {
     shader.Destroy();
     return false;
@@ -322,6 +371,11 @@ GLuint ProgramShaderCache::CompileSingleShader(GLenum type, std::string_view cod
   glShaderSource(result, num_strings, src.data(), src_sizes.data());
   glCompileShader(result);
 
+  // When the driver compiles in parallel, the result is only checked once the shader is linked, so
+  // that the compile can carry on in the background until the program actually needs it.
+  if (g_ogl_config.bSupportsParallelShaderCompile)
+    return result;
+
   if (!CheckShaderCompileResult(result, type, code))
   {
     // Don't try to use this shader
@@ -334,6 +388,8 @@ GLuint ProgramShaderCache::CompileSingleShader(GLenum type, std::string_view cod
 
 bool ProgramShaderCache::CheckShaderCompileResult(GLuint id, GLenum type, std::string_view code)
 {
+  WaitForCompletion(id, false);
+
   GLint compileStatus;
   glGetShaderiv(id, GL_COMPILE_STATUS, &compileStatus);
   GLsizei length = 0;
@@ -391,6 +447,8 @@ bool ProgramShaderCache::CheckShaderCompileResult(GLuint id, GLenum type, std::s
 bool ProgramShaderCache::CheckProgramLinkResult(GLuint id, std::string_view vcode,
                                                 std::string_view pcode, std::string_view gcode)
 {
+  WaitForCompletion(id, true);
+
   GLint linkStatus;
   glGetProgramiv(id, GL_LINK_STATUS, &linkStatus);
   GLsizei length = 0;
@@ -433,6 +491,30 @@ bool ProgramShaderCache::CheckProgramLinkResult(GLuint id, std::string_view vcod
   return true;
 }
 
+std::vector<u8> ProgramShaderCache::GetProgramBinary(GLuint id)
+{
+  GLint program_size = 0;
+  glGetProgramiv(id, GL_PROGRAM_BINARY_LENGTH, &program_size);
+  if (program_size == 0)
+    return {};
+
+  // Clear any existing error.
+  glGetError();
+
+  // We pack the format at the start of the buffer.
+  std::vector<u8> data(program_size + sizeof(u32));
+  GLsizei data_size = 0;
+  GLenum program_format = 0;
+  glGetProgramBinary(id, program_size, &data_size, &program_format, &data[sizeof(u32)]);
+  if (glGetError() != GL_NO_ERROR || data_size == 0)
+    return {};
+
+  u32 program_format_u32 = static_cast<u32>(program_format);
+  std::memcpy(&data[0], &program_format_u32, sizeof(u32));
+  data.resize(data_size + sizeof(u32));
+  return data;
+}
+
 void ProgramShaderCache::Init()
 {
   // We have to get the UBO alignment here because
@@ -449,6 +531,7 @@ void ProgramShaderCache::Init()
   // So multiply by four to get how many floats we have from vec4s
   // Then once more to get bytes
   s_buffer = StreamBuffer::Create(GL_UNIFORM_BUFFER, VertexManagerBase::UNIFORM_STREAM_BUFFER_SIZE);
+  s_buffer_wrap_count = s_buffer->GetWrapCount();
 
   CreateHeader();
   CreateAttributelessVAO();
@@ -556,9 +639,7 @@ PipelineProgram* ProgramShaderCache::GetPipelineProgram(const GLVertexFormat* ve
                     static_cast<GLsizei>(cache_data_size - sizeof(u32)));
 
     // Check the link status. If this fails, it means the binary was invalid.
-    GLint link_status;
-    glGetProgramiv(prog->shader.glprogid, GL_LINK_STATUS, &link_status);
-    if (link_status != GL_TRUE)
+    if (!IsProgramLinked(prog->shader.glprogid))
     {
       WARN_LOG(VIDEO, "Failed to create GL program from program binary.");
       prog->shader.Destroy();
@@ -599,6 +680,21 @@ PipelineProgram* ProgramShaderCache::GetPipelineProgram(const GLVertexFormat* ve
     if (!s_is_shared_context.GetValue() && vao != s_last_VAO)
       glBindVertexArray(s_last_VAO);
 
+    // Shaders compiled in parallel haven't been checked yet. If the program didn't link, report the
+    // shader which failed to compile rather than the link, as that's where the error is.
+    if (g_ogl_config.bSupportsParallelShaderCompile && !IsProgramLinked(prog->shader.glprogid))
+    {
+      for (const OGLShader* shader : {vertex_shader, geometry_shader, pixel_shader})
+      {
+        if (shader && !CheckShaderCompileResult(shader->GetGLShaderID(),
+                                                shader->GetGLShaderType(), shader->GetSource()))
+        {
+          prog->shader.Destroy();
+          return nullptr;
+        }
+      }
+    }
+
     if (!CheckProgramLinkResult(prog->shader.glprogid,
                                 vertex_shader ? vertex_shader->GetSource() : std::string_view{},
                                 geometry_shader ? geometry_shader->GetSource() : std::string_view{},
@@ -607,6 +703,14 @@ PipelineProgram* ProgramShaderCache::GetPipelineProgram(const GLVertexFormat* ve
       prog->shader.Destroy();
       return nullptr;
     }
+
+    // Retrieving the binary waits on the driver, so do it here rather than when the main thread
+    // writes the pipeline to the cache.
+    if (s_is_shared_context.GetValue() && g_ActiveConfig.backend_info.bSupportsPipelineCacheData &&
+        g_ActiveConfig.bShaderCache)
+    {
+      prog->binary = GetProgramBinary(prog->shader.glprogid);
+    }
   }
 
   // Lock to insert. A duplicate program may have been created in the meantime.
@@ -882,6 +986,8 @@ bool SharedContextAsyncShaderCompiler::WorkerThreadInitWorkerThread(void* param)
   }
   if (g_ActiveConfig.backend_info.bSupportsPrimitiveRestart)
     GLUtil::EnablePrimitiveRestart(context);
+  if (g_ogl_config.bSupportsParallelShaderCompile)
+    glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
 
   return true;
 }
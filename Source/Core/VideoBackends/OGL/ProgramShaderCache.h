@@ -9,6 +9,7 @@
 #include <mutex>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include "Common/GL/GLUtil.h"
 #include "VideoCommon/AsyncShaderCompiler.h"
@@ -64,6 +65,8 @@ struct PipelineProgram
   SHADER shader;
   std::atomic_size_t reference_count{1};
   bool binary_retrieved = false;
+  // Retrieved on the compiler thread for programs linked there, for GetCacheData to hand out
+  std::vector<u8> binary;
 };
 
 class ProgramShaderCache
@@ -80,6 +83,7 @@ public:
   static bool CheckShaderCompileResult(GLuint id, GLenum type, std::string_view code);
   static bool CheckProgramLinkResult(GLuint id, std::string_view vcode, std::string_view pcode,
                                      std::string_view gcode);
+  static std::vector<u8> GetProgramBinary(GLuint id);
   static StreamBuffer* GetUniformBuffer();
   static u32 GetUniformBufferAlignment();
   static void UploadConstants();
@@ -70,6 +70,7 @@ struct VideoConfig
   bool bSupportsTextureSubImage;
   EsFbFetchType SupportedFramebufferFetch;
   bool bSupportsShaderThreadShuffleNV;
+  bool bSupportsParallelShaderCompile;
 
   const char* gl_vendor;
   const char* gl_renderer;
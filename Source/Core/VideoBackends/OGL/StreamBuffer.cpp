@@ -116,6 +116,7 @@ void StreamBuffer::AllocMemory(u32 size)
 
     // move to the start
     m_used_iterator = m_iterator = 0;  // offset 0 is always aligned
+    m_wrap_count++;
 
     // wait for space at the start
     for (int i = 0; i <= Slot(m_iterator + size); i++)
@@ -150,6 +151,7 @@ public:
     {
       glBufferData(m_buffertype, m_size, nullptr, GL_STREAM_DRAW);
       m_iterator = 0;
+      m_wrap_count++;
     }
     u8* pointer = (u8*)glMapBufferRange(m_buffertype, m_iterator, size,
                                         GL_MAP_WRITE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT |
@@ -317,7 +319,11 @@ public:
   }
 
   ~BufferSubData() { delete[] m_pointer; }
-  std::pair<u8*, u32> Map(u32 size) override { return std::make_pair(m_pointer, 0); }
+  std::pair<u8*, u32> Map(u32 size) override
+  {
+    m_wrap_count++;
+    return std::make_pair(m_pointer, 0);
+  }
   void Unmap(u32 used_size) override { glBufferSubData(m_buffertype, 0, used_size, m_pointer); }
   u8* m_pointer;
 };
@@ -337,7 +343,11 @@ public:
   }
 
   ~BufferData() { delete[] m_pointer; }
-  std::pair<u8*, u32> Map(u32 size) override { return std::make_pair(m_pointer, 0); }
+  std::pair<u8*, u32> Map(u32 size) override
+  {
+    m_wrap_count++;
+    return std::make_pair(m_pointer, 0);
+  }
   void Unmap(u32 used_size) override
   {
     glBufferData(m_buffertype, used_size, m_pointer, GL_STREAM_DRAW);
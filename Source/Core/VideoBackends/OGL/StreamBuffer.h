@@ -23,6 +23,10 @@ public:
   u32 GetSize() const { return m_size; }
   u32 GetCurrentOffset() const { return m_iterator; }
 
+  // Changes whenever data written by earlier Map calls may no longer be found at its offset,
+  // i.e. when the buffer wraps around, is orphaned, or is rewritten from the start.
+  u32 GetWrapCount() const { return m_wrap_count; }
+
   /* This mapping function will return a pair of:
    * - the pointer to the mapped buffer
    * - the offset into the real GPU buffer (always multiple of stride)
@@ -58,6 +62,7 @@ protected:
   u32 m_iterator;
   u32 m_used_iterator;
   u32 m_free_iterator;
+  u32 m_wrap_count = 0;
 
 private:
   static constexpr int SYNC_POINTS = 16;
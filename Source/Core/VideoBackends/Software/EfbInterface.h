@@ -59,5 +59,6 @@ void EncodeXFB(u8* xfb_in_ram, u32 memory_stride, const MathUtil::Rectangle<int>
 
 u32 GetPerfQueryResult(PerfQueryType type);
 void ResetPerfQuery();
-void IncPerfCounterQuadCount(PerfQueryType type);
+// Counts pixels towards a counter that hardware increments per quad.
+void IncPerfCounterQuadCount(PerfQueryType type, u32 pixels);
 }  // namespace EfbInterface
@@ -11,10 +11,16 @@ struct OutputVertexData;
 namespace Rasterizer
 {
 void Init();
+void Shutdown();
 
+// With more than one rasterizer thread, triangles are only binned here, and drawn by Flush().
 void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
                            const OutputVertexData* v2);
 
+// Draws the binned triangles, and folds the statistics, perf counters and bounding box of all
+// threads into the global ones. Has to be called before anything reads back the EFB.
+void Flush();
+
 void SetTevReg(int reg, int comp, s16 color);
 
 struct Slope
@@ -570,7 +570,7 @@ void Tev::Draw()
   ASSERT(Position[0] >= 0 && Position[0] < s32(EFB_WIDTH));
   ASSERT(Position[1] >= 0 && Position[1] < s32(EFB_HEIGHT));
 
-  INCSTAT(g_stats.this_frame.tev_pixels_in);
+  PixelsIn++;
 
   // initial color values
   for (int i = 0; i < 4; i++)
@@ -595,7 +595,7 @@ void Tev::Draw()
 
     TextureSampler::Sample(Uv[texcoordSel].s >> scaleS, Uv[texcoordSel].t >> scaleT,
                            IndirectLod[stageNum], IndirectLinear[stageNum], texmap,
-                           IndirectTex[stageNum]);
+                           IndirectTex[stageNum], SamplerCache);
 
 #if ALLOW_TEV_DUMPS
     if (g_ActiveConfig.bDumpTevStages)
@@ -631,7 +631,7 @@ void Tev::Draw()
       u8 texel[4];
 
       TextureSampler::Sample(TexCoord.s, TexCoord.t, TextureLod[stageNum], TextureLinear[stageNum],
-                             texmap, texel);
+                             texmap, texel, SamplerCache);
 
 #if ALLOW_TEV_DUMPS
       if (g_ActiveConfig.bDumpTevTextureFetches)
@@ -833,16 +833,18 @@ void Tev::Draw()
   if (late_ztest && bpmem.zmode.testenable)
   {
     // TODO: Check against hw if these values get incremented even if depth testing is disabled
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_INPUT);
+    PerfCounterPixels[PQ_ZCOMP_INPUT]++;
 
     if (!EfbInterface::ZCompare(Position[0], Position[1], Position[2]))
       return;
 
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT);
+    PerfCounterPixels[PQ_ZCOMP_OUTPUT]++;
   }
 
-  BoundingBox::Update(static_cast<u16>(Position[0]), static_cast<u16>(Position[0]),
-                      static_cast<u16>(Position[1]), static_cast<u16>(Position[1]));
+  BBoxLeft = std::min(BBoxLeft, static_cast<u16>(Position[0]));
+  BBoxRight = std::max(BBoxRight, static_cast<u16>(Position[0]));
+  BBoxTop = std::min(BBoxTop, static_cast<u16>(Position[1]));
+  BBoxBottom = std::max(BBoxBottom, static_cast<u16>(Position[1]));
 
 #if ALLOW_TEV_DUMPS
   if (g_ActiveConfig.bDumpTevStages)
@@ -864,12 +866,32 @@ void Tev::Draw()
   }
 #endif
 
-  INCSTAT(g_stats.this_frame.tev_pixels_out);
-  EfbInterface::IncPerfCounterQuadCount(PQ_BLEND_INPUT);
+  PixelsOut++;
+  PerfCounterPixels[PQ_BLEND_INPUT]++;
 
   EfbInterface::BlendTev(Position[0], Position[1], output);
 }
 
+void Tev::FlushCounters()
+{
+  ADDSTAT(g_stats.this_frame.tev_pixels_in, PixelsIn);
+  ADDSTAT(g_stats.this_frame.tev_pixels_out, PixelsOut);
+  PixelsIn = 0;
+  PixelsOut = 0;
+
+  for (u32 i = 0; i < PQ_NUM_MEMBERS; i++)
+  {
+    if (PerfCounterPixels[i] != 0)
+      EfbInterface::IncPerfCounterQuadCount(static_cast<PerfQueryType>(i), PerfCounterPixels[i]);
+  }
+  PerfCounterPixels = {};
+
+  if (BBoxLeft <= BBoxRight)
+    BoundingBox::Update(BBoxLeft, BBoxRight, BBoxTop, BBoxBottom);
+  BBoxLeft = BBoxTop = 0xffff;
+  BBoxRight = BBoxBottom = 0;
+}
+
 void Tev::SetRegColor(int reg, int comp, s16 color)
 {
   KonstantColors[reg][comp] = color;
@@ -4,7 +4,11 @@
 
 #pragma once
 
+#include <array>
+
+#include "Common/CommonTypes.h"
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/PerfQueryBase.h"
 
 class Tev
 {
@@ -75,6 +79,17 @@ public:
   s32 TextureLod[16];
   bool TextureLinear[16];
 
+  // Draw() writes nothing global but the EFB, so that each rasterizer thread can draw with a Tev of
+  // its own. Everything else it produces is gathered here until FlushCounters() is called.
+  u32 SamplerCache = 0;
+  std::array<u32, PQ_NUM_MEMBERS> PerfCounterPixels{};
+  u32 PixelsIn = 0;
+  u32 PixelsOut = 0;
+  u16 BBoxLeft = 0xffff;
+  u16 BBoxRight = 0;
+  u16 BBoxTop = 0xffff;
+  u16 BBoxBottom = 0;
+
   enum
   {
     ALP_C,
@@ -86,6 +101,7 @@ public:
   void Init();
 
   void Draw();
+  void FlushCounters();
 
   void SetRegColor(int reg, int comp, s16 color);
 };
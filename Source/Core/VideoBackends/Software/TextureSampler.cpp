@@ -5,7 +5,10 @@
 #include "VideoBackends/Software/TextureSampler.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstring>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Core/HW/Memmap.h"
@@ -18,6 +21,123 @@
 
 namespace TextureSampler
 {
+namespace
+{
+// Textures that get sampled a lot within a draw are decoded as a whole with the (SIMD) bulk
+// decoder and then read back texel by texel. Both decoders produce the same result, so this only
+// makes a difference to speed. Small triangles only sample a few texels of what may be a large
+// texture, so the whole texture is only decoded once a fraction of its texels have been sampled.
+constexpr u32 DECODE_THRESHOLD_DIVISOR = 8;
+constexpr int MAX_MIP_LEVELS = 11;
+
+struct DecodedTexture
+{
+  const u8* src = nullptr;
+  const u8* src_odd = nullptr;
+  const u8* tlut = nullptr;
+  TextureFormat format = TextureFormat::I4;
+  TLUTFormat tlut_format = TLUTFormat::IA8;
+  int width = 0;
+  int height = 0;
+
+  u32 samples = 0;
+  bool decoded = false;
+  int row_length = 0;
+  std::vector<u8> texels;
+};
+
+using DecodedTextureCache = std::array<std::array<DecodedTexture, MAX_MIP_LEVELS>, 8>;
+
+// One cache per rasterizer thread, so that lookups never need to be synchronized
+std::vector<DecodedTextureCache> s_decoded_textures(1);
+
+DecodedTexture* GetDecodedTexture(u32 cache, u8 texmap, s32 mip, const u8* src,
+                                  const u8* src_odd, const u8* tlut, TextureFormat format,
+                                  TLUTFormat tlut_format, int width, int height)
+{
+  if (!src || mip < 0 || mip >= MAX_MIP_LEVELS)
+    return nullptr;
+
+  DecodedTexture& texture = s_decoded_textures[cache][texmap & 7][mip];
+  if (texture.src != src || texture.src_odd != src_odd || texture.format != format ||
+      texture.width != width || texture.height != height ||
+      (IsColorIndexed(format) && (texture.tlut != tlut || texture.tlut_format != tlut_format)))
+  {
+    texture.src = src;
+    texture.src_odd = src_odd;
+    texture.tlut = tlut;
+    texture.format = format;
+    texture.tlut_format = tlut_format;
+    texture.width = width;
+    texture.height = height;
+    texture.samples = 0;
+    texture.decoded = false;
+  }
+
+  if (!texture.decoded)
+  {
+    const u32 texel_count = static_cast<u32>(width + 1) * static_cast<u32>(height + 1);
+    if (++texture.samples < texel_count / DECODE_THRESHOLD_DIVISOR)
+      return nullptr;
+
+    // The bulk decoders work on whole blocks
+    const int block_width = TexDecoder_GetBlockWidthInTexels(format);
+    const int block_height = TexDecoder_GetBlockHeightInTexels(format);
+    const int expanded_width = (width + block_width) / block_width * block_width;
+    const int expanded_height = (height + block_height) / block_height * block_height;
+
+    texture.texels.resize(static_cast<size_t>(expanded_width) * expanded_height * 4);
+    if (src_odd)
+    {
+      TexDecoder_DecodeRGBA8FromTmem(texture.texels.data(), src, src_odd, expanded_width,
+                                     expanded_height);
+    }
+    else
+    {
+      TexDecoder_Decode(texture.texels.data(), src, expanded_width, expanded_height, format, tlut,
+                        tlut_format);
+    }
+    texture.row_length = expanded_width;
+    texture.decoded = true;
+  }
+
+  return &texture;
+}
+
+void DecodeTexel(const DecodedTexture* texture, u8* dst, const u8* src, const u8* src_odd, int s,
+                 int t, int imageWidth, TextureFormat format, const u8* tlut,
+                 TLUTFormat tlut_format)
+{
+  if (texture)
+    std::memcpy(dst, &texture->texels[(static_cast<size_t>(t) * texture->row_length + s) * 4], 4);
+  else if (src_odd)
+    TexDecoder_DecodeTexelRGBA8FromTmem(dst, src, src_odd, s, t, imageWidth);
+  else
+    TexDecoder_DecodeTexel(dst, src, s, t, imageWidth, format, tlut, tlut_format);
+}
+}  // Anonymous namespace
+
+void SetNumCaches(u32 count)
+{
+  s_decoded_textures.resize(std::max(count, 1u));
+}
+
+void InvalidateCache()
+{
+  for (DecodedTextureCache& cache : s_decoded_textures)
+  {
+    for (auto& mips : cache)
+    {
+      for (DecodedTexture& texture : mips)
+      {
+        // Keep the texel storage around, the next draw most likely uses similar textures
+        texture.src = nullptr;
+        texture.decoded = false;
+      }
+    }
+  }
+}
+
 static inline void WrapCoord(int* coordp, int wrapMode, int imageSize)
 {
   int coord = *coordp;
@@ -59,7 +179,7 @@ static inline void AddTexel(const u8* inTexel, u32* outTexel, u32 fract)
   outTexel[3] += inTexel[3] * fract;
 }
 
-void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample)
+void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample, u32 cache)
 {
   int baseMip = 0;
   bool mipLinear = false;
@@ -85,10 +205,10 @@ void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample)
     u8 sampledTex[4];
     u32 texel[4];
 
-    SampleMip(s, t, baseMip, linear, texmap, sampledTex);
+    SampleMip(s, t, baseMip, linear, texmap, sampledTex, cache);
     SetTexel(sampledTex, texel, (16 - lodFract));
 
-    SampleMip(s, t, baseMip + 1, linear, texmap, sampledTex);
+    SampleMip(s, t, baseMip + 1, linear, texmap, sampledTex, cache);
     AddTexel(sampledTex, texel, lodFract);
 
     sample[0] = (u8)(texel[0] >> 4);
@@ -99,14 +219,15 @@ void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample)
   else
 #endif
   {
-    SampleMip(s, t, baseMip, linear, texmap, sample);
+    SampleMip(s, t, baseMip, linear, texmap, sample, cache);
   }
 }
 
-void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
+void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample, u32 cache)
 {
   const FourTexUnits& texUnit = bpmem.tex[(texmap >> 2) & 1];
   const u8 subTexmap = texmap & 3;
+  const s32 level = mip;
 
   const TexMode0& tm0 = texUnit.texMode0[subTexmap];
   const TexImage0& ti0 = texUnit.texImage0[subTexmap];
@@ -188,42 +309,25 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
     WrapCoord(&imageSPlus1, tm0.wrap_s, imageWidth);
     WrapCoord(&imageTPlus1, tm0.wrap_t, imageHeight);
 
-    if (!(texfmt == TextureFormat::RGBA8 && texUnit.texImage1[subTexmap].image_type))
-    {
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageS, imageT, imageWidth, texfmt, tlut,
-                             tlutfmt);
-      SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
+    const DecodedTexture* decoded =
+        GetDecodedTexture(cache, texmap, level, imageSrc, imageSrcOdd, tlut, texfmt, tlutfmt,
+                          imageWidth, imageHeight);
 
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageSPlus1, imageT, imageWidth, texfmt, tlut,
-                             tlutfmt);
-      AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
+    DecodeTexel(decoded, sampledTex, imageSrc, imageSrcOdd, imageS, imageT, imageWidth, texfmt,
+                tlut, tlutfmt);
+    SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
 
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageS, imageTPlus1, imageWidth, texfmt, tlut,
-                             tlutfmt);
-      AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
+    DecodeTexel(decoded, sampledTex, imageSrc, imageSrcOdd, imageSPlus1, imageT, imageWidth,
+                texfmt, tlut, tlutfmt);
+    AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
 
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageSPlus1, imageTPlus1, imageWidth, texfmt,
-                             tlut, tlutfmt);
-      AddTexel(sampledTex, texel, (fractS) * (fractT));
-    }
-    else
-    {
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageS, imageT,
-                                          imageWidth);
-      SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
+    DecodeTexel(decoded, sampledTex, imageSrc, imageSrcOdd, imageS, imageTPlus1, imageWidth,
+                texfmt, tlut, tlutfmt);
+    AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
 
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageSPlus1, imageT,
-                                          imageWidth);
-      AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageS, imageTPlus1,
-                                          imageWidth);
-      AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageSPlus1,
-                                          imageTPlus1, imageWidth);
-      AddTexel(sampledTex, texel, (fractS) * (fractT));
-    }
+    DecodeTexel(decoded, sampledTex, imageSrc, imageSrcOdd, imageSPlus1, imageTPlus1, imageWidth,
+                texfmt, tlut, tlutfmt);
+    AddTexel(sampledTex, texel, (fractS) * (fractT));
 
     sample[0] = (u8)(texel[0] >> 14);
     sample[1] = (u8)(texel[1] >> 14);
@@ -240,11 +344,11 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
     WrapCoord(&imageS, tm0.wrap_s, imageWidth);
     WrapCoord(&imageT, tm0.wrap_t, imageHeight);
 
-    if (!(texfmt == TextureFormat::RGBA8 && texUnit.texImage1[subTexmap].image_type))
-      TexDecoder_DecodeTexel(sample, imageSrc, imageS, imageT, imageWidth, texfmt, tlut, tlutfmt);
-    else
-      TexDecoder_DecodeTexelRGBA8FromTmem(sample, imageSrc, imageSrcOdd, imageS, imageT,
-                                          imageWidth);
+    const DecodedTexture* decoded =
+        GetDecodedTexture(cache, texmap, level, imageSrc, imageSrcOdd, tlut, texfmt, tlutfmt,
+                          imageWidth, imageHeight);
+    DecodeTexel(decoded, sample, imageSrc, imageSrcOdd, imageS, imageT, imageWidth, texfmt, tlut,
+                tlutfmt);
   }
 }
 }  // namespace TextureSampler
@@ -8,9 +8,15 @@
 
 namespace TextureSampler
 {
-void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample);
+// cache selects which decoded texture cache to go through. Every rasterizer thread uses its own.
+void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample, u32 cache);
 
-void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample);
+void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample, u32 cache = 0);
+
+void SetNumCaches(u32 count);
+
+// Forgets the textures decoded for the previous draw, since texture memory may have changed since
+void InvalidateCache();
 
 enum
 {
@@ -14,13 +14,17 @@
 
 namespace Vulkan
 {
-CommandBufferManager::CommandBufferManager(bool use_threaded_submission)
-    : m_submit_semaphore(1, 1), m_use_threaded_submission(use_threaded_submission)
+CommandBufferManager::CommandBufferManager(bool use_threaded_submission,
+                                           bool use_threaded_recording)
+    : m_submit_semaphore(1, 1), m_use_threaded_submission(use_threaded_submission),
+      m_use_threaded_recording(use_threaded_recording)
 {
 }
 
 CommandBufferManager::~CommandBufferManager()
 {
+  m_recorder.StopWorkerThread();
+
   // If the worker thread is enabled, stop and block until it exits.
   if (m_use_threaded_submission)
   {
@@ -39,6 +43,9 @@ bool CommandBufferManager::Initialize()
   if (m_use_threaded_submission && !CreateSubmitThread())
     return false;
 
+  if (m_use_threaded_recording)
+    m_recorder.StartWorkerThread();
+
   return true;
 }
 
@@ -55,25 +62,30 @@ bool CommandBufferManager::CreateCommandBuffers()
     resources.init_command_buffer_used = false;
     resources.semaphore_used = false;
 
-    VkCommandPoolCreateInfo pool_info = {VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO, nullptr, 0,
-                                         g_vulkan_context->GetGraphicsQueueFamilyIndex()};
-    res = vkCreateCommandPool(g_vulkan_context->GetDevice(), &pool_info, nullptr,
-                              &resources.command_pool);
-    if (res != VK_SUCCESS)
+    // Each command buffer gets its own pool, so the draw command buffer can be recorded on the
+    // recorder's worker thread while uploads are recorded into the init command buffer.
+    for (size_t i = 0; i < resources.command_buffers.size(); i++)
     {
-      LOG_VULKAN_ERROR(res, "vkCreateCommandPool failed: ");
-      return false;
-    }
+      VkCommandPoolCreateInfo pool_info = {VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO, nullptr, 0,
+                                           g_vulkan_context->GetGraphicsQueueFamilyIndex()};
+      res = vkCreateCommandPool(g_vulkan_context->GetDevice(), &pool_info, nullptr,
+                                &resources.command_pools[i]);
+      if (res != VK_SUCCESS)
+      {
+        LOG_VULKAN_ERROR(res, "vkCreateCommandPool failed: ");
+        return false;
+      }
 
-    VkCommandBufferAllocateInfo buffer_info = {
-        VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO, nullptr, resources.command_pool,
-        VK_COMMAND_BUFFER_LEVEL_PRIMARY, static_cast<uint32_t>(resources.command_buffers.size())};
+      VkCommandBufferAllocateInfo buffer_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+                                                 nullptr, resources.command_pools[i],
+                                                 VK_COMMAND_BUFFER_LEVEL_PRIMARY, 1};
 
-    res = vkAllocateCommandBuffers(device, &buffer_info, resources.command_buffers.data());
-    if (res != VK_SUCCESS)
-    {
-      LOG_VULKAN_ERROR(res, "vkAllocateCommandBuffers failed: ");
-      return false;
+      res = vkAllocateCommandBuffers(device, &buffer_info, &resources.command_buffers[i]);
+      if (res != VK_SUCCESS)
+      {
+        LOG_VULKAN_ERROR(res, "vkAllocateCommandBuffers failed: ");
+        return false;
+      }
     }
 
     VkFenceCreateInfo fence_info = {VK_STRUCTURE_TYPE_FENCE_CREATE_INFO, nullptr,
@@ -142,8 +154,11 @@ void CommandBufferManager::DestroyCommandBuffers()
     // from the pool are freed.". So we don't need to free the command buffers, just the pools.
     // We destroy the command pool first, to avoid any warnings from the validation layers about
     // objects which are pending destruction being in-use.
-    if (resources.command_pool != VK_NULL_HANDLE)
-      vkDestroyCommandPool(device, resources.command_pool, nullptr);
+    for (VkCommandPool command_pool : resources.command_pools)
+    {
+      if (command_pool != VK_NULL_HANDLE)
+        vkDestroyCommandPool(device, command_pool, nullptr);
+    }
 
     // Destroy any pending objects.
     for (auto& it : resources.cleanup_resources)
@@ -272,6 +287,9 @@ void CommandBufferManager::SubmitCommandBuffer(bool submit_on_worker_thread,
                                                VkSwapchainKHR present_swap_chain,
                                                uint32_t present_image_index)
 {
+  // Make sure queued draws have made it into the command buffer before ending it.
+  m_recorder.Flush();
+
   // End the current command buffer.
   FrameResources& resources = m_frame_resources[m_current_frame];
   for (VkCommandBuffer command_buffer : resources.command_buffers)
@@ -413,9 +431,12 @@ void CommandBufferManager::BeginCommandBuffer()
     LOG_VULKAN_ERROR(res, "vkResetFences failed: ");
 
   // Reset command pools to beginning since we can re-use the memory now
-  res = vkResetCommandPool(g_vulkan_context->GetDevice(), resources.command_pool, 0);
-  if (res != VK_SUCCESS)
-    LOG_VULKAN_ERROR(res, "vkResetCommandPool failed: ");
+  for (VkCommandPool command_pool : resources.command_pools)
+  {
+    res = vkResetCommandPool(g_vulkan_context->GetDevice(), command_pool, 0);
+    if (res != VK_SUCCESS)
+      LOG_VULKAN_ERROR(res, "vkResetCommandPool failed: ");
+  }
 
   // Enable commands to be recorded to the two buffers again.
   VkCommandBufferBeginInfo begin_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO, nullptr,
@@ -437,6 +458,7 @@ void CommandBufferManager::BeginCommandBuffer()
   resources.semaphore_used = false;
   resources.fence_counter = m_next_fence_counter++;
   m_current_frame = next_buffer_index;
+  m_recorder.SetCommandBuffer(resources.command_buffers[1]);
 }
 
 void CommandBufferManager::DeferBufferDestruction(VkBuffer object)
@@ -19,6 +19,7 @@
 #include "Common/Flag.h"
 #include "Common/Semaphore.h"
 
+#include "VideoBackends/Vulkan/CommandRecorder.h"
 #include "VideoBackends/Vulkan/Constants.h"
 
 namespace Vulkan
@@ -26,7 +27,7 @@ namespace Vulkan
 class CommandBufferManager
 {
 public:
-  explicit CommandBufferManager(bool use_threaded_submission);
+  CommandBufferManager(bool use_threaded_submission, bool use_threaded_recording);
   ~CommandBufferManager();
 
   bool Initialize();
@@ -38,10 +39,14 @@ public:
     m_frame_resources[m_current_frame].init_command_buffer_used = true;
     return m_frame_resources[m_current_frame].command_buffers[0];
   }
-  VkCommandBuffer GetCurrentCommandBuffer() const
+  // Waits for the recorder to catch up first, so commands can be written directly.
+  VkCommandBuffer GetCurrentCommandBuffer()
   {
+    m_recorder.Flush();
     return m_frame_resources[m_current_frame].command_buffers[1];
   }
+  // Draws and the state they use go through the recorder, which may record them on another thread.
+  CommandRecorder& GetRecorder() { return m_recorder; }
   VkDescriptorPool GetCurrentDescriptorPool() const
   {
     return m_frame_resources[m_current_frame].descriptor_pool;
@@ -105,7 +110,7 @@ private:
   struct FrameResources
   {
     // [0] - Init (upload) command buffer, [1] - draw command buffer
-    VkCommandPool command_pool = VK_NULL_HANDLE;
+    std::array<VkCommandPool, 2> command_pools = {};
     std::array<VkCommandBuffer, 2> command_buffers = {};
     VkDescriptorPool descriptor_pool = VK_NULL_HANDLE;
     VkFence fence = VK_NULL_HANDLE;
@@ -140,6 +145,10 @@ private:
   Common::Flag m_last_present_failed;
   VkResult m_last_present_result = VK_SUCCESS;
   bool m_use_threaded_submission = false;
+
+  // Threaded draw recording
+  CommandRecorder m_recorder;
+  bool m_use_threaded_recording = false;
 };
 
 extern std::unique_ptr<CommandBufferManager> g_command_buffer_mgr;
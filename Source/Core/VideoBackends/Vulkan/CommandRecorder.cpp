@@ -0,0 +1,307 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoBackends/Vulkan/CommandRecorder.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "Common/Assert.h"
+#include "Common/Thread.h"
+
+namespace Vulkan
+{
+CommandRecorder::CommandRecorder() = default;
+
+CommandRecorder::~CommandRecorder()
+{
+  StopWorkerThread();
+}
+
+void CommandRecorder::StartWorkerThread()
+{
+  if (m_worker_thread.joinable())
+    return;
+
+  m_shutdown = false;
+  m_worker_thread = std::thread(&CommandRecorder::WorkerThreadLoop, this);
+}
+
+void CommandRecorder::StopWorkerThread()
+{
+  if (!m_worker_thread.joinable())
+    return;
+
+  WaitForWorkerThread();
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_shutdown = true;
+  }
+  m_work_available.notify_one();
+  m_worker_thread.join();
+}
+
+void CommandRecorder::BeginRenderPass(const VkRenderPassBeginInfo& begin_info)
+{
+  ASSERT(begin_info.clearValueCount <= MAX_CLEAR_VALUES);
+
+  Command command;
+  command.type = Command::Type::BeginRenderPass;
+  command.begin_render_pass.render_pass = begin_info.renderPass;
+  command.begin_render_pass.framebuffer = begin_info.framebuffer;
+  command.begin_render_pass.area = begin_info.renderArea;
+  command.begin_render_pass.num_clear_values = begin_info.clearValueCount;
+  std::copy_n(begin_info.pClearValues, begin_info.clearValueCount,
+              command.begin_render_pass.clear_values.begin());
+  AddCommand(command);
+}
+
+void CommandRecorder::EndRenderPass()
+{
+  Command command;
+  command.type = Command::Type::EndRenderPass;
+  AddCommand(command);
+}
+
+void CommandRecorder::BindPipeline(VkPipeline pipeline)
+{
+  Command command;
+  command.type = Command::Type::BindPipeline;
+  command.pipeline = pipeline;
+  AddCommand(command);
+}
+
+void CommandRecorder::BindVertexBuffer(VkBuffer buffer, VkDeviceSize offset)
+{
+  Command command;
+  command.type = Command::Type::BindVertexBuffer;
+  command.buffer = {buffer, offset, VK_INDEX_TYPE_UINT16};
+  AddCommand(command);
+}
+
+void CommandRecorder::BindIndexBuffer(VkBuffer buffer, VkDeviceSize offset, VkIndexType type)
+{
+  Command command;
+  command.type = Command::Type::BindIndexBuffer;
+  command.buffer = {buffer, offset, type};
+  AddCommand(command);
+}
+
+void CommandRecorder::SetViewport(const VkViewport& viewport)
+{
+  Command command;
+  command.type = Command::Type::SetViewport;
+  command.viewport = viewport;
+  AddCommand(command);
+}
+
+void CommandRecorder::SetScissor(const VkRect2D& scissor)
+{
+  Command command;
+  command.type = Command::Type::SetScissor;
+  command.scissor = scissor;
+  AddCommand(command);
+}
+
+void CommandRecorder::BindDescriptorSets(VkPipelineLayout layout, u32 first_set, u32 set_count,
+                                         const VkDescriptorSet* sets, u32 dynamic_offset_count,
+                                         const u32* dynamic_offsets)
+{
+  ASSERT(set_count <= MAX_DESCRIPTOR_SETS && dynamic_offset_count <= MAX_DYNAMIC_OFFSETS);
+
+  Command command;
+  command.type = Command::Type::BindDescriptorSets;
+  command.descriptor_sets.layout = layout;
+  command.descriptor_sets.first_set = first_set;
+  command.descriptor_sets.set_count = set_count;
+  std::copy_n(sets, set_count, command.descriptor_sets.sets.begin());
+  command.descriptor_sets.dynamic_offset_count = dynamic_offset_count;
+  std::copy_n(dynamic_offsets, dynamic_offset_count,
+              command.descriptor_sets.dynamic_offsets.begin());
+  AddCommand(command);
+}
+
+void CommandRecorder::PushSamplers(VkPipelineLayout layout, u32 set,
+                                   const VkDescriptorImageInfo* samplers, VkBufferView texel_buffer)
+{
+  Command command;
+  command.type = Command::Type::PushSamplers;
+  command.push_samplers.layout = layout;
+  command.push_samplers.set = set;
+  std::copy_n(samplers, NUM_PIXEL_SHADER_SAMPLERS, command.push_samplers.samplers.begin());
+  command.push_samplers.texel_buffer = texel_buffer;
+  AddCommand(command);
+}
+
+void CommandRecorder::Draw(u32 num_vertices, u32 base_vertex)
+{
+  Command command;
+  command.type = Command::Type::Draw;
+  command.draw = {num_vertices, base_vertex, 0};
+  AddCommand(command);
+
+  if (!m_commands.empty() && ++m_batch_draws >= DRAWS_PER_BATCH)
+    SubmitBatch();
+}
+
+void CommandRecorder::DrawIndexed(u32 num_indices, u32 base_index, s32 base_vertex)
+{
+  Command command;
+  command.type = Command::Type::DrawIndexed;
+  command.draw = {num_indices, base_index, base_vertex};
+  AddCommand(command);
+
+  if (!m_commands.empty() && ++m_batch_draws >= DRAWS_PER_BATCH)
+    SubmitBatch();
+}
+
+void CommandRecorder::RecordCommand(VkCommandBuffer command_buffer, const Command& command)
+{
+  switch (command.type)
+  {
+  case Command::Type::BeginRenderPass:
+  {
+    const VkRenderPassBeginInfo begin_info = {VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
+                                              nullptr,
+                                              command.begin_render_pass.render_pass,
+                                              command.begin_render_pass.framebuffer,
+                                              command.begin_render_pass.area,
+                                              command.begin_render_pass.num_clear_values,
+                                              command.begin_render_pass.clear_values.data()};
+    vkCmdBeginRenderPass(command_buffer, &begin_info, VK_SUBPASS_CONTENTS_INLINE);
+    break;
+  }
+
+  case Command::Type::EndRenderPass:
+    vkCmdEndRenderPass(command_buffer);
+    break;
+
+  case Command::Type::BindPipeline:
+    vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, command.pipeline);
+    break;
+
+  case Command::Type::BindVertexBuffer:
+    vkCmdBindVertexBuffers(command_buffer, 0, 1, &command.buffer.buffer, &command.buffer.offset);
+    break;
+
+  case Command::Type::BindIndexBuffer:
+    vkCmdBindIndexBuffer(command_buffer, command.buffer.buffer, command.buffer.offset,
+                         command.buffer.type);
+    break;
+
+  case Command::Type::SetViewport:
+    vkCmdSetViewport(command_buffer, 0, 1, &command.viewport);
+    break;
+
+  case Command::Type::SetScissor:
+    vkCmdSetScissor(command_buffer, 0, 1, &command.scissor);
+    break;
+
+  case Command::Type::BindDescriptorSets:
+    vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                            command.descriptor_sets.layout, command.descriptor_sets.first_set,
+                            command.descriptor_sets.set_count,
+                            command.descriptor_sets.sets.data(),
+                            command.descriptor_sets.dynamic_offset_count,
+                            command.descriptor_sets.dynamic_offsets.data());
+    break;
+
+  case Command::Type::PushSamplers:
+  {
+    const std::array<VkWriteDescriptorSet, 2> writes{{
+        {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, VK_NULL_HANDLE, 0, 0,
+         NUM_PIXEL_SHADER_SAMPLERS, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+         command.push_samplers.samplers.data(), nullptr, nullptr},
+        {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, VK_NULL_HANDLE, 8, 0, 1,
+         VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER, nullptr, nullptr,
+         &command.push_samplers.texel_buffer},
+    }};
+    const u32 num_writes = command.push_samplers.texel_buffer != VK_NULL_HANDLE ? 2 : 1;
+    vkCmdPushDescriptorSetKHR(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                              command.push_samplers.layout, command.push_samplers.set,
+                              num_writes, writes.data());
+    break;
+  }
+
+  case Command::Type::Draw:
+    vkCmdDraw(command_buffer, command.draw.count, 1, command.draw.first, 0);
+    break;
+
+  case Command::Type::DrawIndexed:
+    vkCmdDrawIndexed(command_buffer, command.draw.count, 1, command.draw.first,
+                     command.draw.vertex_offset, 0);
+    break;
+  }
+}
+
+void CommandRecorder::AddCommand(const Command& command)
+{
+  if (!m_worker_thread.joinable())
+  {
+    RecordCommand(m_command_buffer, command);
+    return;
+  }
+
+  m_commands.push_back(command);
+}
+
+void CommandRecorder::SubmitBatch()
+{
+  std::vector<Command> next_commands;
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_pending_batches.push_back({m_command_buffer, std::move(m_commands)});
+    m_batches_in_flight++;
+    if (!m_free_command_lists.empty())
+    {
+      next_commands = std::move(m_free_command_lists.back());
+      m_free_command_lists.pop_back();
+    }
+  }
+  m_work_available.notify_one();
+
+  m_commands = std::move(next_commands);
+  m_batch_draws = 0;
+  m_worker_busy = true;
+}
+
+void CommandRecorder::WaitForWorkerThread()
+{
+  if (!m_commands.empty())
+    SubmitBatch();
+  if (!m_worker_busy)
+    return;
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_work_done.wait(lock, [this] { return m_batches_in_flight == 0; });
+  m_worker_busy = false;
+}
+
+void CommandRecorder::WorkerThreadLoop()
+{
+  Common::SetCurrentThreadName("Vulkan CommandRecorder");
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true)
+  {
+    m_work_available.wait(lock, [this] { return !m_pending_batches.empty() || m_shutdown; });
+    if (m_pending_batches.empty())
+      break;
+
+    Batch batch = std::move(m_pending_batches.front());
+    m_pending_batches.pop_front();
+    lock.unlock();
+
+    for (const Command& command : batch.commands)
+      RecordCommand(batch.command_buffer, command);
+    batch.commands.clear();
+
+    lock.lock();
+    m_free_command_lists.push_back(std::move(batch.commands));
+    if (--m_batches_in_flight == 0)
+      m_work_done.notify_one();
+  }
+}
+
+}  // namespace Vulkan
@@ -0,0 +1,162 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "VideoBackends/Vulkan/Constants.h"
+
+namespace Vulkan
+{
+// Records render passes, draw state and draws into the current draw command buffer. When threaded,
+// the commands are queued in a compact list on the GPU thread, and recorded into the command
+// buffer on a worker thread, so that API recording overlaps with FIFO processing. Anything else
+// that writes to the command buffer has to call Flush() first, which CommandBufferManager does
+// when the current command buffer is requested.
+class CommandRecorder
+{
+public:
+  CommandRecorder();
+  ~CommandRecorder();
+
+  void StartWorkerThread();
+  void StopWorkerThread();
+
+  // Sets the command buffer that subsequent commands are recorded into.
+  void SetCommandBuffer(VkCommandBuffer command_buffer) { m_command_buffer = command_buffer; }
+
+  void BeginRenderPass(const VkRenderPassBeginInfo& begin_info);
+  void EndRenderPass();
+  void BindPipeline(VkPipeline pipeline);
+  void BindVertexBuffer(VkBuffer buffer, VkDeviceSize offset);
+  void BindIndexBuffer(VkBuffer buffer, VkDeviceSize offset, VkIndexType type);
+  void SetViewport(const VkViewport& viewport);
+  void SetScissor(const VkRect2D& scissor);
+  void BindDescriptorSets(VkPipelineLayout layout, u32 first_set, u32 set_count,
+                          const VkDescriptorSet* sets, u32 dynamic_offset_count,
+                          const u32* dynamic_offsets);
+  // Pushes NUM_PIXEL_SHADER_SAMPLERS samplers to binding 0 of the push descriptor set, and
+  // optionally a texel buffer to binding 8, as the utility layout expects.
+  void PushSamplers(VkPipelineLayout layout, u32 set, const VkDescriptorImageInfo* samplers,
+                    VkBufferView texel_buffer);
+  void Draw(u32 num_vertices, u32 base_vertex);
+  void DrawIndexed(u32 num_indices, u32 base_index, s32 base_vertex);
+
+  // Records everything that has been queued and waits for the worker thread to go idle. After
+  // this returns, the command buffer can be written to directly.
+  void Flush()
+  {
+    if (m_worker_thread.joinable())
+      WaitForWorkerThread();
+  }
+
+private:
+  // Upper bounds of the descriptor sets and clear values the backend ever binds at once.
+  static constexpr u32 MAX_DESCRIPTOR_SETS = 3;
+  static constexpr u32 MAX_DYNAMIC_OFFSETS = 3;
+  static constexpr u32 MAX_CLEAR_VALUES = 2;
+
+  // Hand the queued commands over to the worker after this many draws.
+  static constexpr u32 DRAWS_PER_BATCH = 32;
+
+  struct Command
+  {
+    enum class Type : u32
+    {
+      BeginRenderPass,
+      EndRenderPass,
+      BindPipeline,
+      BindVertexBuffer,
+      BindIndexBuffer,
+      SetViewport,
+      SetScissor,
+      BindDescriptorSets,
+      PushSamplers,
+      Draw,
+      DrawIndexed
+    };
+
+    Type type;
+    union
+    {
+      struct
+      {
+        VkRenderPass render_pass;
+        VkFramebuffer framebuffer;
+        VkRect2D area;
+        u32 num_clear_values;
+        std::array<VkClearValue, MAX_CLEAR_VALUES> clear_values;
+      } begin_render_pass;
+      VkPipeline pipeline;
+      struct
+      {
+        VkBuffer buffer;
+        VkDeviceSize offset;
+        VkIndexType type;
+      } buffer;
+      VkViewport viewport;
+      VkRect2D scissor;
+      struct
+      {
+        VkPipelineLayout layout;
+        u32 first_set;
+        u32 set_count;
+        std::array<VkDescriptorSet, MAX_DESCRIPTOR_SETS> sets;
+        u32 dynamic_offset_count;
+        std::array<u32, MAX_DYNAMIC_OFFSETS> dynamic_offsets;
+      } descriptor_sets;
+      struct
+      {
+        VkPipelineLayout layout;
+        u32 set;
+        std::array<VkDescriptorImageInfo, NUM_PIXEL_SHADER_SAMPLERS> samplers;
+        VkBufferView texel_buffer;
+      } push_samplers;
+      struct
+      {
+        u32 count;
+        u32 first;
+        s32 vertex_offset;
+      } draw;
+    };
+  };
+
+  struct Batch
+  {
+    VkCommandBuffer command_buffer;
+    std::vector<Command> commands;
+  };
+
+  static void RecordCommand(VkCommandBuffer command_buffer, const Command& command);
+
+  void AddCommand(const Command& command);
+  void SubmitBatch();
+  void WaitForWorkerThread();
+  void WorkerThreadLoop();
+
+  VkCommandBuffer m_command_buffer = VK_NULL_HANDLE;
+
+  // Only touched by the GPU thread.
+  std::vector<Command> m_commands;
+  u32 m_batch_draws = 0;
+  bool m_worker_busy = false;
+
+  std::thread m_worker_thread;
+  std::mutex m_mutex;
+  std::condition_variable m_work_available;
+  std::condition_variable m_work_done;
+  std::deque<Batch> m_pending_batches;
+  std::vector<std::vector<Command>> m_free_command_lists;
+  u32 m_batches_in_flight = 0;
+  bool m_shutdown = false;
+};
+
+}  // namespace Vulkan
@@ -83,10 +83,15 @@ constexpr u32 NUM_COMPUTE_TEXEL_BUFFERS = 2;
 // Textures that don't fit into this buffer will be uploaded with a separate buffer (see below).
 constexpr u32 TEXTURE_UPLOAD_BUFFER_SIZE = 32 * 1024 * 1024;
 
-// Textures greater than 1024*1024 will be put in staging textures that are released after
-// execution instead. A 2048x2048 texture is 16MB, and we'd only fit four of these in our
-// streaming buffer and be blocking frequently. Games are unlikely to have textures this
-// large anyway, so it's only really an issue for HD texture packs, and memory is not
-// a limiting factor in these scenarios anyway.
+// Textures greater than 1024*1024 will be put in a separate buffer for large uploads instead. A
+// 2048x2048 texture is 16MB, and we'd only fit four of these in our streaming buffer and be
+// blocking frequently. Games are unlikely to have textures this large anyway, so it's only really
+// an issue for HD texture packs, and memory is not a limiting factor in these scenarios anyway.
 constexpr u32 STAGING_TEXTURE_UPLOAD_THRESHOLD = 1024 * 1024 * 4;
+
+// The buffer for large uploads is created on first use with this size, and grows to hold at least
+// two uploads of the largest size seen so far. Uploads that would need it to grow past the maximum
+// get a staging buffer of their own that is released after execution.
+constexpr u32 LARGE_TEXTURE_UPLOAD_BUFFER_SIZE = 64 * 1024 * 1024;
+constexpr u32 MAX_LARGE_TEXTURE_UPLOAD_BUFFER_SIZE = 1024 * 1024 * 1024;
 }  // namespace Vulkan
@@ -10,7 +10,10 @@
 
 #include "Common/Assert.h"
 #include "Common/CommonFuncs.h"
+#include "Common/File.h"
+#include "Common/FileUtil.h"
 #include "Common/LinearDiskCache.h"
+#include "Common/MathUtil.h"
 #include "Common/MsgHandler.h"
 
 #include "Core/ConfigManager.h"
@@ -39,6 +42,23 @@ ObjectCache::~ObjectCache()
   m_dummy_texture.reset();
 }
 
+StreamBuffer* ObjectCache::GetLargeTextureUploadBuffer(u32 size)
+{
+  if (m_large_texture_upload_buffer && m_large_texture_upload_buffer->GetCurrentSize() / 2 >= size)
+    return m_large_texture_upload_buffer.get();
+
+  if (size > MAX_LARGE_TEXTURE_UPLOAD_BUFFER_SIZE / 2)
+    return nullptr;
+
+  // The old buffer is destroyed once the command buffers that copy from it have completed.
+  const u32 new_size =
+      std::max(LARGE_TEXTURE_UPLOAD_BUFFER_SIZE, MathUtil::NextPowerOf2(size * 2));
+  m_large_texture_upload_buffer = StreamBuffer::Create(VK_BUFFER_USAGE_TRANSFER_SRC_BIT, new_size);
+  if (!m_large_texture_upload_buffer)
+    WARN_LOG(VIDEO, "Failed to create a %u byte texture upload buffer", new_size);
+  return m_large_texture_upload_buffer.get();
+}
+
 bool ObjectCache::Initialize()
 {
   if (!CreateDescriptorSetLayouts())
@@ -69,13 +89,27 @@ bool ObjectCache::Initialize()
       return false;
   }
 
+  if (g_ActiveConfig.bShaderCache && g_ActiveConfig.bSharedDriverPipelineCache &&
+      OpenSharedPipelineCache())
+  {
+    SyncSharedPipelineCache(true);
+  }
+
+  if (g_ActiveConfig.bShaderCache)
+    ShaderCompiler::LoadSPIRVCache();
+
   return true;
 }
 
 void ObjectCache::Shutdown()
 {
   if (g_ActiveConfig.bShaderCache && m_pipeline_cache != VK_NULL_HANDLE)
+  {
+    SyncSharedPipelineCache(true);
     SavePipelineCache();
+  }
+  m_shared_pipeline_cache_file.Close();
+  ShaderCompiler::CloseSPIRVCache();
 }
 
 void ObjectCache::ClearSamplerCache()
@@ -173,6 +207,16 @@ bool ObjectCache::CreateDescriptorSetLayouts()
   if (!g_ActiveConfig.backend_info.bSupportsGeometryShaders)
     create_infos[DESCRIPTOR_SET_LAYOUT_STANDARD_UNIFORM_BUFFERS].bindingCount--;
 
+  // Samplers change far more often than anything else, so push them when we can. The uniform
+  // buffers stay in regular sets, as push descriptors can't use dynamic offsets.
+  if (g_vulkan_context->SupportsPushDescriptors())
+  {
+    create_infos[DESCRIPTOR_SET_LAYOUT_STANDARD_SAMPLERS].flags =
+        VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR;
+    create_infos[DESCRIPTOR_SET_LAYOUT_UTILITY_SAMPLERS].flags =
+        VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR;
+  }
+
   for (size_t i = 0; i < create_infos.size(); i++)
   {
     VkResult res = vkCreateDescriptorSetLayout(g_vulkan_context->GetDevice(), &create_infos[i],
@@ -592,15 +636,17 @@ void ObjectCache::DestroyPipelineCache()
   m_pipeline_cache = VK_NULL_HANDLE;
 }
 
-void ObjectCache::SavePipelineCache()
+std::vector<u8> ObjectCache::GetPipelineCacheData()
 {
+  std::shared_lock<std::shared_mutex> lock(m_pipeline_cache_mutex);
+
   size_t data_size;
   VkResult res =
       vkGetPipelineCacheData(g_vulkan_context->GetDevice(), m_pipeline_cache, &data_size, nullptr);
   if (res != VK_SUCCESS)
   {
     LOG_VULKAN_ERROR(res, "vkGetPipelineCacheData failed: ");
-    return;
+    return {};
   }
 
   std::vector<u8> data(data_size);
@@ -609,9 +655,19 @@ void ObjectCache::SavePipelineCache()
   if (res != VK_SUCCESS)
   {
     LOG_VULKAN_ERROR(res, "vkGetPipelineCacheData failed: ");
-    return;
+    return {};
   }
 
+  data.resize(data_size);
+  return data;
+}
+
+void ObjectCache::SavePipelineCache()
+{
+  const std::vector<u8> data = GetPipelineCacheData();
+  if (data.empty())
+    return;
+
   // Delete the old cache and re-create.
   File::Delete(m_pipeline_cache_filename);
 
@@ -625,6 +681,184 @@ void ObjectCache::SavePipelineCache()
   disk_cache.Close();
 }
 
+void ObjectCache::MergePipelineCacheData(const std::vector<u8>& data)
+{
+  if (!ValidatePipelineCache(data.data(), data.size()))
+    return;
+
+  VkPipelineCacheCreateInfo info = {
+      VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,  // VkStructureType            sType
+      nullptr,                                       // const void*                pNext
+      0,                                             // VkPipelineCacheCreateFlags flags
+      data.size(),                                   // size_t                     initialDataSize
+      data.data()                                    // const void*                pInitialData
+  };
+
+  VkPipelineCache cache;
+  VkResult res = vkCreatePipelineCache(g_vulkan_context->GetDevice(), &info, nullptr, &cache);
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkCreatePipelineCache failed: ");
+    return;
+  }
+
+  {
+    // The destination cache of a merge must not be used by any other thread.
+    std::unique_lock<std::shared_mutex> lock(m_pipeline_cache_mutex);
+    res = vkMergePipelineCaches(g_vulkan_context->GetDevice(), m_pipeline_cache, 1, &cache);
+  }
+  if (res != VK_SUCCESS)
+    LOG_VULKAN_ERROR(res, "vkMergePipelineCaches failed: ");
+
+  vkDestroyPipelineCache(g_vulkan_context->GetDevice(), cache, nullptr);
+}
+
+// The shared pipeline cache is a file that all instances append snapshots of their pipeline cache
+// to, one record each. Each instance merges the others' records before appending, so the latest
+// snapshot contains everything before it, and the file is compacted to just that one once it grows
+// too large. All accesses happen while holding an exclusive lock on the file.
+namespace
+{
+struct SharedPipelineCacheHeader
+{
+  u32 magic;
+  // Incremented on compaction, readers start over from the first record when it changes.
+  u32 generation;
+};
+constexpr u32 SHARED_PIPELINE_CACHE_MAGIC = 0x53504B56;  // VKPS
+constexpr auto SHARED_PIPELINE_CACHE_SYNC_INTERVAL = std::chrono::seconds(1);
+constexpr u64 SHARED_PIPELINE_CACHE_COMPACT_RATIO = 4;
+}  // Anonymous namespace
+
+bool ObjectCache::OpenSharedPipelineCache()
+{
+  const std::string filename =
+      GetDiskShaderCacheFileName(APIType::Vulkan, "SharedPipeline", false, true);
+
+  // Another instance may have the file open already, so it must never be truncated here.
+  if (!File::Exists(filename))
+    File::IOFile(filename, "ab");
+  if (!m_shared_pipeline_cache_file.Open(filename, "rb+"))
+  {
+    WARN_LOG(VIDEO, "Failed to open shared pipeline cache %s", filename.c_str());
+    return false;
+  }
+
+  m_shared_pipeline_cache_generation = 0;
+  m_shared_pipeline_cache_read_offset = 0;
+  m_shared_pipeline_cache_synced_size = 0;
+  return true;
+}
+
+void ObjectCache::ReadSharedPipelineCache()
+{
+  File::IOFile& file = m_shared_pipeline_cache_file;
+  const u64 file_size = file.GetSize();
+
+  SharedPipelineCacheHeader header;
+  file.Seek(0, SEEK_SET);
+  if (file_size < sizeof(header) || !file.ReadBytes(&header, sizeof(header)) ||
+      header.magic != SHARED_PIPELINE_CACHE_MAGIC)
+  {
+    header = {SHARED_PIPELINE_CACHE_MAGIC, 0};
+    file.Clear();
+    file.Resize(0);
+    file.Seek(0, SEEK_SET);
+    file.WriteBytes(&header, sizeof(header));
+    m_shared_pipeline_cache_generation = header.generation;
+    m_shared_pipeline_cache_read_offset = sizeof(header);
+    return;
+  }
+
+  if (header.generation != m_shared_pipeline_cache_generation ||
+      m_shared_pipeline_cache_read_offset < sizeof(header))
+  {
+    m_shared_pipeline_cache_generation = header.generation;
+    m_shared_pipeline_cache_read_offset = sizeof(header);
+  }
+
+  file.Seek(m_shared_pipeline_cache_read_offset, SEEK_SET);
+  std::vector<u8> data;
+  u32 data_size;
+  while (m_shared_pipeline_cache_read_offset + sizeof(data_size) <= file_size &&
+         file.ReadBytes(&data_size, sizeof(data_size)) &&
+         m_shared_pipeline_cache_read_offset + sizeof(data_size) + data_size <= file_size)
+  {
+    data.resize(data_size);
+    if (!file.ReadBytes(data.data(), data.size()))
+      break;
+
+    m_shared_pipeline_cache_read_offset += sizeof(data_size) + data_size;
+    MergePipelineCacheData(data);
+  }
+  file.Clear();
+
+  // Whatever is left is a partial record from an instance that died while writing it.
+  if (m_shared_pipeline_cache_read_offset < file_size)
+    file.Resize(m_shared_pipeline_cache_read_offset);
+}
+
+void ObjectCache::SyncSharedPipelineCache(bool force)
+{
+  // Pipelines are created from several threads, one sync at a time is plenty.
+  std::unique_lock<std::mutex> guard(m_shared_pipeline_cache_lock, std::defer_lock);
+  if (force)
+    guard.lock();
+  else if (!guard.try_lock())
+    return;
+
+  if (!m_shared_pipeline_cache_file.IsOpen())
+    return;
+
+  const auto now = std::chrono::steady_clock::now();
+  if (!force && now - m_shared_pipeline_cache_last_sync < SHARED_PIPELINE_CACHE_SYNC_INTERVAL)
+    return;
+  m_shared_pipeline_cache_last_sync = now;
+
+  File::IOFile& file = m_shared_pipeline_cache_file;
+  if (!file.Lock(true))
+    return;
+
+  // Anything beyond what the last sync left us with was compiled by this instance.
+  size_t cache_size = 0;
+  {
+    std::shared_lock<std::shared_mutex> lock(m_pipeline_cache_mutex);
+    vkGetPipelineCacheData(g_vulkan_context->GetDevice(), m_pipeline_cache, &cache_size, nullptr);
+  }
+  const bool has_new_pipelines = cache_size > m_shared_pipeline_cache_synced_size;
+  ReadSharedPipelineCache();
+
+  std::vector<u8> data = GetPipelineCacheData();
+  const u64 file_size = file.GetSize();
+  const bool compact = file_size > SHARED_PIPELINE_CACHE_COMPACT_RATIO * data.size();
+  if (!data.empty() && (has_new_pipelines || compact))
+  {
+    if (compact)
+    {
+      const SharedPipelineCacheHeader header = {SHARED_PIPELINE_CACHE_MAGIC,
+                                                m_shared_pipeline_cache_generation + 1};
+      file.Resize(0);
+      file.Seek(0, SEEK_SET);
+      file.WriteBytes(&header, sizeof(header));
+      m_shared_pipeline_cache_generation = header.generation;
+    }
+    else
+    {
+      file.Seek(0, SEEK_END);
+    }
+
+    const u32 data_size = static_cast<u32>(data.size());
+    file.WriteBytes(&data_size, sizeof(data_size));
+    file.WriteBytes(data.data(), data.size());
+    m_shared_pipeline_cache_read_offset = file.Tell();
+    file.Clear();
+  }
+  m_shared_pipeline_cache_synced_size = data.size();
+
+  file.Flush();
+  file.Unlock();
+}
+
 void ObjectCache::ReloadPipelineCache()
 {
   SavePipelineCache();
@@ -633,5 +867,16 @@ void ObjectCache::ReloadPipelineCache()
     LoadPipelineCache();
   else
     CreatePipelineCache();
+
+  // The new cache has none of the shared pipelines yet.
+  if (m_shared_pipeline_cache_file.IsOpen())
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_shared_pipeline_cache_lock);
+      m_shared_pipeline_cache_read_offset = 0;
+      m_shared_pipeline_cache_synced_size = 0;
+    }
+    SyncSharedPipelineCache(true);
+  }
 }
 }  // namespace Vulkan
@@ -5,14 +5,19 @@
 #pragma once
 
 #include <array>
+#include <chrono>
 #include <cstddef>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <tuple>
 #include <unordered_map>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/File.h"
 #include "Common/LinearDiskCache.h"
 
 #include "VideoBackends/Vulkan/Constants.h"
@@ -54,6 +59,11 @@ public:
   // Staging buffer for textures.
   StreamBuffer* GetTextureUploadBuffer() const { return m_texture_upload_buffer.get(); }
 
+  // Staging buffer for textures above STAGING_TEXTURE_UPLOAD_THRESHOLD, grown to fit size if
+  // needed. Returns nullptr if it can't be made large enough. Must not be called while memory is
+  // reserved in the buffer.
+  StreamBuffer* GetLargeTextureUploadBuffer(u32 size);
+
   // Static samplers
   VkSampler GetPointSampler() const { return m_point_sampler; }
   VkSampler GetLinearSampler() const { return m_linear_sampler; }
@@ -64,7 +74,16 @@ public:
                              VkAttachmentLoadOp load_op);
 
   // Pipeline cache. Used when creating pipelines for drivers to store compiled programs.
+  // Hold the lock while creating pipelines with it, the shared pipeline cache is merged into it.
   VkPipelineCache GetPipelineCache() const { return m_pipeline_cache; }
+  std::shared_lock<std::shared_mutex> LockPipelineCache()
+  {
+    return std::shared_lock<std::shared_mutex>(m_pipeline_cache_mutex);
+  }
+
+  // Exchanges pipelines with the other instances using the shared pipeline cache. Unless forced,
+  // this does nothing if a sync happened recently or is running on another thread.
+  void SyncSharedPipelineCache(bool force = false);
 
   // Clear sampler cache, use when anisotropy mode changes
   // WARNING: Ensure none of the objects from here are in use when calling
@@ -88,11 +107,16 @@ private:
   bool LoadPipelineCache();
   bool ValidatePipelineCache(const u8* data, size_t data_length);
   void DestroyPipelineCache();
+  std::vector<u8> GetPipelineCacheData();
+  void MergePipelineCacheData(const std::vector<u8>& data);
+  bool OpenSharedPipelineCache();
+  void ReadSharedPipelineCache();
 
   std::array<VkDescriptorSetLayout, NUM_DESCRIPTOR_SET_LAYOUTS> m_descriptor_set_layouts = {};
   std::array<VkPipelineLayout, NUM_PIPELINE_LAYOUTS> m_pipeline_layouts = {};
 
   std::unique_ptr<StreamBuffer> m_texture_upload_buffer;
+  std::unique_ptr<StreamBuffer> m_large_texture_upload_buffer;
 
   VkSampler m_point_sampler = VK_NULL_HANDLE;
   VkSampler m_linear_sampler = VK_NULL_HANDLE;
@@ -108,7 +132,16 @@ private:
 
   // pipeline cache
   VkPipelineCache m_pipeline_cache = VK_NULL_HANDLE;
+  std::shared_mutex m_pipeline_cache_mutex;
   std::string m_pipeline_cache_filename;
+
+  // Pipeline cache shared with other instances, see SyncSharedPipelineCache
+  File::IOFile m_shared_pipeline_cache_file;
+  std::mutex m_shared_pipeline_cache_lock;
+  u32 m_shared_pipeline_cache_generation = 0;
+  u64 m_shared_pipeline_cache_read_offset = 0;
+  size_t m_shared_pipeline_cache_synced_size = 0;
+  std::chrono::steady_clock::time_point m_shared_pipeline_cache_last_sync;
 };
 
 extern std::unique_ptr<ObjectCache> g_object_cache;
@@ -10,7 +10,11 @@
 #include <cstring>
 #include <fstream>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+
+#include <xxhash.h>
 
 // glslang includes
 #include "GlslangToSpv.h"
@@ -19,12 +23,15 @@
 #include "disassemble.h"
 
 #include "Common/FileUtil.h"
+#include "Common/LinearDiskCache.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
 #include "Common/Version.h"
 
+#include "VideoCommon/ShaderGenCommon.h"
 #include "VideoCommon/VideoBackendBase.h"
+#include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
 
 namespace Vulkan::ShaderCompiler
@@ -108,22 +115,86 @@ static const char SUBGROUP_HELPER_HEADER[] = R"(
   #define SUBGROUP_MAX(value) value = subgroupMax(value)
 )";
 
+namespace
+{
+// The full source is hashed twice with different seeds, as a collision would hand out the wrong
+// shader. All the other compiler options are fixed, apart from the SPIR-V version.
+struct SPIRVCacheKey
+{
+  u64 source_hash;
+  u64 source_hash_alt;
+  u32 source_length;
+  u32 stage;
+  u32 spirv_version;
+  u32 padding;
+
+  bool operator==(const SPIRVCacheKey& rhs) const
+  {
+    return std::memcmp(this, &rhs, sizeof(*this)) == 0;
+  }
+};
+
+struct SPIRVCacheKeyHash
+{
+  std::size_t operator()(const SPIRVCacheKey& key) const
+  {
+    return static_cast<std::size_t>(key.source_hash);
+  }
+};
+
+using SPIRVCacheMap = std::unordered_map<SPIRVCacheKey, SPIRVCodeVector, SPIRVCacheKeyHash>;
+
+class SPIRVCacheReader : public LinearDiskCacheReader<SPIRVCacheKey, SPIRVCodeType>
+{
+public:
+  explicit SPIRVCacheReader(SPIRVCacheMap* map) : m_map(map) {}
+
+  void Read(const SPIRVCacheKey& key, const SPIRVCodeType* value, u32 value_size) override
+  {
+    m_map->emplace(key, SPIRVCodeVector(value, value + value_size));
+  }
+
+private:
+  SPIRVCacheMap* m_map;
+};
+
+// Shaders are compiled on the async compiler threads too
+std::mutex s_spirv_cache_lock;
+SPIRVCacheMap s_spirv_cache;
+LinearDiskCache<SPIRVCacheKey, SPIRVCodeType> s_spirv_disk_cache;
+bool s_spirv_cache_open = false;
+}  // Anonymous namespace
+
+void LoadSPIRVCache()
+{
+  std::lock_guard guard{s_spirv_cache_lock};
+  if (s_spirv_cache_open)
+    return;
+
+  const std::string filename = GetDiskShaderCacheFileName(APIType::Vulkan, "SPIRV", false, true);
+  SPIRVCacheReader reader(&s_spirv_cache);
+  const u32 count = s_spirv_disk_cache.OpenAndRead(filename, reader);
+  INFO_LOG(VIDEO, "Loaded %u shaders from the SPIR-V cache", count);
+  s_spirv_cache_open = true;
+}
+
+void CloseSPIRVCache()
+{
+  std::lock_guard guard{s_spirv_cache_lock};
+  if (!s_spirv_cache_open)
+    return;
+
+  s_spirv_disk_cache.Sync();
+  s_spirv_disk_cache.Close();
+  s_spirv_cache.clear();
+  s_spirv_cache_open = false;
+}
+
 static std::optional<SPIRVCodeVector> CompileShaderToSPV(EShLanguage stage,
                                                          const char* stage_filename,
                                                          std::string_view source,
                                                          std::string_view header)
 {
-  if (!InitializeGlslang())
-    return std::nullopt;
-
-  std::unique_ptr<glslang::TShader> shader = std::make_unique<glslang::TShader>(stage);
-  std::unique_ptr<glslang::TProgram> program;
-  glslang::TShader::ForbidIncluder includer;
-  EProfile profile = ECoreProfile;
-  EShMessages messages =
-      static_cast<EShMessages>(EShMsgDefault | EShMsgSpvRules | EShMsgVulkanRules);
-  int default_version = 450;
-
   std::string full_source_code;
   const char* pass_source_code = source.data();
   int pass_source_code_length = static_cast<int>(source.size());
@@ -140,7 +211,37 @@ static std::optional<SPIRVCodeVector> CompileShaderToSPV(EShLanguage stage,
   }
 
   // Sub-group operations require Vulkan 1.1 and SPIR-V 1.3.
-  if (g_vulkan_context->SupportsShaderSubgroupOperations())
+  const bool use_spirv_1_3 = g_vulkan_context->SupportsShaderSubgroupOperations();
+
+  // Dumping the shaders needs glslang's logs, so they always go through the compiler then.
+  const bool use_spirv_cache = !(g_ActiveConfig.iLog & CONF_SAVESHADERS);
+  const SPIRVCacheKey cache_key = {
+      XXH64(pass_source_code, pass_source_code_length, 0),
+      XXH64(pass_source_code, pass_source_code_length, 1),
+      static_cast<u32>(pass_source_code_length),
+      static_cast<u32>(stage),
+      use_spirv_1_3 ? static_cast<u32>(glslang::EShTargetSpv_1_3) : 0,
+      0};
+  if (use_spirv_cache)
+  {
+    std::lock_guard guard{s_spirv_cache_lock};
+    const auto iter = s_spirv_cache.find(cache_key);
+    if (iter != s_spirv_cache.end())
+      return iter->second;
+  }
+
+  if (!InitializeGlslang())
+    return std::nullopt;
+
+  std::unique_ptr<glslang::TShader> shader = std::make_unique<glslang::TShader>(stage);
+  std::unique_ptr<glslang::TProgram> program;
+  glslang::TShader::ForbidIncluder includer;
+  EProfile profile = ECoreProfile;
+  EShMessages messages =
+      static_cast<EShMessages>(EShMsgDefault | EShMsgSpvRules | EShMsgVulkanRules);
+  int default_version = 450;
+
+  if (use_spirv_1_3)
     shader->setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_3);
 
   shader->setStringsWithLengths(&pass_source_code, &pass_source_code_length, 1);
@@ -239,6 +340,13 @@ static std::optional<SPIRVCodeVector> CompileShaderToSPV(EShLanguage stage,
     }
   }
 
+  if (use_spirv_cache)
+  {
+    std::lock_guard guard{s_spirv_cache_lock};
+    if (s_spirv_cache_open && s_spirv_cache.emplace(cache_key, out_code).second)
+      s_spirv_disk_cache.Append(cache_key, out_code.data(), static_cast<u32>(out_code.size()));
+  }
+
   return out_code;
 }
 
@@ -17,6 +17,13 @@ namespace Vulkan::ShaderCompiler
 using SPIRVCodeType = u32;
 using SPIRVCodeVector = std::vector<SPIRVCodeType>;
 
+// Loads the SPIR-V cache, so that shaders which were compiled before skip glslang. The cache is
+// keyed by the source code, and shared between all games.
+void LoadSPIRVCache();
+
+// Closes the SPIR-V cache. Shaders compiled after this point are not added to it.
+void CloseSPIRVCache();
+
 // Compile a vertex shader to SPIR-V.
 std::optional<SPIRVCodeVector> CompileVertexShader(std::string_view source_code);
 
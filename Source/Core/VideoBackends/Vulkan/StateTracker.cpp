@@ -15,6 +15,8 @@
 #include "VideoBackends/Vulkan/VertexFormat.h"
 #include "VideoBackends/Vulkan/VulkanContext.h"
 
+#include "VideoCommon/Statistics.h"
+
 namespace Vulkan
 {
 static std::unique_ptr<StateTracker> s_state_tracker;
@@ -266,8 +268,7 @@ void StateTracker::BeginRenderPass()
                                       0,
                                       nullptr};
 
-  vkCmdBeginRenderPass(g_command_buffer_mgr->GetCurrentCommandBuffer(), &begin_info,
-                       VK_SUBPASS_CONTENTS_INLINE);
+  g_command_buffer_mgr->GetRecorder().BeginRenderPass(begin_info);
 }
 
 void StateTracker::BeginDiscardRenderPass()
@@ -286,8 +287,7 @@ void StateTracker::BeginDiscardRenderPass()
                                       0,
                                       nullptr};
 
-  vkCmdBeginRenderPass(g_command_buffer_mgr->GetCurrentCommandBuffer(), &begin_info,
-                       VK_SUBPASS_CONTENTS_INLINE);
+  g_command_buffer_mgr->GetRecorder().BeginRenderPass(begin_info);
 }
 
 void StateTracker::EndRenderPass()
@@ -295,7 +295,7 @@ void StateTracker::EndRenderPass()
   if (!InRenderPass())
     return;
 
-  vkCmdEndRenderPass(g_command_buffer_mgr->GetCurrentCommandBuffer());
+  g_command_buffer_mgr->GetRecorder().EndRenderPass();
   m_current_render_pass = VK_NULL_HANDLE;
 }
 
@@ -315,8 +315,7 @@ void StateTracker::BeginClearRenderPass(const VkRect2D& area, const VkClearValue
                                       num_clear_values,
                                       clear_values};
 
-  vkCmdBeginRenderPass(g_command_buffer_mgr->GetCurrentCommandBuffer(), &begin_info,
-                       VK_SUBPASS_CONTENTS_INLINE);
+  g_command_buffer_mgr->GetRecorder().BeginRenderPass(begin_info);
 }
 
 void StateTracker::SetViewport(const VkViewport& viewport)
@@ -366,21 +365,21 @@ bool StateTracker::Bind()
     BeginRenderPass();
 
   // Re-bind parts of the pipeline
-  const VkCommandBuffer command_buffer = g_command_buffer_mgr->GetCurrentCommandBuffer();
+  CommandRecorder& recorder = g_command_buffer_mgr->GetRecorder();
   if (m_dirty_flags & DIRTY_FLAG_VERTEX_BUFFER)
-    vkCmdBindVertexBuffers(command_buffer, 0, 1, &m_vertex_buffer, &m_vertex_buffer_offset);
+    recorder.BindVertexBuffer(m_vertex_buffer, m_vertex_buffer_offset);
 
   if (m_dirty_flags & DIRTY_FLAG_INDEX_BUFFER)
-    vkCmdBindIndexBuffer(command_buffer, m_index_buffer, m_index_buffer_offset, m_index_type);
+    recorder.BindIndexBuffer(m_index_buffer, m_index_buffer_offset, m_index_type);
 
   if (m_dirty_flags & DIRTY_FLAG_PIPELINE)
-    vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline->GetVkPipeline());
+    recorder.BindPipeline(m_pipeline->GetVkPipeline());
 
   if (m_dirty_flags & DIRTY_FLAG_VIEWPORT)
-    vkCmdSetViewport(command_buffer, 0, 1, &m_viewport);
+    recorder.SetViewport(m_viewport);
 
   if (m_dirty_flags & DIRTY_FLAG_SCISSOR)
-    vkCmdSetScissor(command_buffer, 0, 1, &m_scissor);
+    recorder.SetScissor(m_scissor);
 
   m_dirty_flags &= ~(DIRTY_FLAG_VERTEX_BUFFER | DIRTY_FLAG_INDEX_BUFFER | DIRTY_FLAG_PIPELINE |
                      DIRTY_FLAG_VIEWPORT | DIRTY_FLAG_SCISSOR);
@@ -497,7 +496,10 @@ bool StateTracker::UpdateGXDescriptorSet()
     m_dirty_flags = (m_dirty_flags & ~DIRTY_FLAG_GX_UBOS) | DIRTY_FLAG_DESCRIPTOR_SETS;
   }
 
-  if (m_dirty_flags & DIRTY_FLAG_GX_SAMPLERS || m_gx_descriptor_sets[1] == VK_NULL_HANDLE)
+  // Pushed samplers are written after the other sets are bound, see below.
+  const bool push_samplers = g_vulkan_context->SupportsPushDescriptors();
+  if (!push_samplers &&
+      (m_dirty_flags & DIRTY_FLAG_GX_SAMPLERS || m_gx_descriptor_sets[1] == VK_NULL_HANDLE))
   {
     m_gx_descriptor_sets[1] = g_command_buffer_mgr->AllocateDescriptorSet(
         g_object_cache->GetDescriptorSetLayout(DESCRIPTOR_SET_LAYOUT_STANDARD_SAMPLERS));
@@ -535,26 +537,47 @@ bool StateTracker::UpdateGXDescriptorSet()
   if (num_writes > 0)
     vkUpdateDescriptorSets(g_vulkan_context->GetDevice(), num_writes, writes.data(), 0, nullptr);
 
-  if (m_dirty_flags & DIRTY_FLAG_DESCRIPTOR_SETS)
+  if (m_dirty_flags & DIRTY_FLAG_DESCRIPTOR_SETS && push_samplers)
   {
-    vkCmdBindDescriptorSets(g_command_buffer_mgr->GetCurrentCommandBuffer(),
-                            VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline->GetVkPipelineLayout(), 0,
-                            g_ActiveConfig.backend_info.bSupportsBBox ?
-                                NUM_GX_DESCRIPTOR_SETS :
-                                (NUM_GX_DESCRIPTOR_SETS - 1),
-                            m_gx_descriptor_sets.data(), NUM_UBO_DESCRIPTOR_SET_BINDINGS,
-                            m_bindings.gx_ubo_offsets.data());
+    // The pushed set sits between the two allocated ones, so they have to be bound separately.
+    // Rebinding can disturb the pushed samplers, so they are always pushed again afterwards.
+    g_command_buffer_mgr->GetRecorder().BindDescriptorSets(
+        m_pipeline->GetVkPipelineLayout(), 0, 1, m_gx_descriptor_sets.data(),
+        NUM_UBO_DESCRIPTOR_SET_BINDINGS, m_bindings.gx_ubo_offsets.data());
+    if (g_ActiveConfig.backend_info.bSupportsBBox)
+    {
+      g_command_buffer_mgr->GetRecorder().BindDescriptorSets(
+          m_pipeline->GetVkPipelineLayout(), 2, 1, &m_gx_descriptor_sets[2], 0, nullptr);
+    }
+    m_dirty_flags = (m_dirty_flags & ~(DIRTY_FLAG_DESCRIPTOR_SETS | DIRTY_FLAG_GX_UBO_OFFSETS)) |
+                    DIRTY_FLAG_GX_SAMPLERS;
+  }
+  else if (m_dirty_flags & DIRTY_FLAG_DESCRIPTOR_SETS)
+  {
+    g_command_buffer_mgr->GetRecorder().BindDescriptorSets(
+        m_pipeline->GetVkPipelineLayout(), 0,
+        g_ActiveConfig.backend_info.bSupportsBBox ? NUM_GX_DESCRIPTOR_SETS :
+                                                    (NUM_GX_DESCRIPTOR_SETS - 1),
+        m_gx_descriptor_sets.data(), NUM_UBO_DESCRIPTOR_SET_BINDINGS,
+        m_bindings.gx_ubo_offsets.data());
     m_dirty_flags &= ~(DIRTY_FLAG_DESCRIPTOR_SETS | DIRTY_FLAG_GX_UBO_OFFSETS);
   }
   else if (m_dirty_flags & DIRTY_FLAG_GX_UBO_OFFSETS)
   {
-    vkCmdBindDescriptorSets(g_command_buffer_mgr->GetCurrentCommandBuffer(),
-                            VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline->GetVkPipelineLayout(), 0,
-                            1, m_gx_descriptor_sets.data(), NUM_UBO_DESCRIPTOR_SET_BINDINGS,
-                            m_bindings.gx_ubo_offsets.data());
+    g_command_buffer_mgr->GetRecorder().BindDescriptorSets(
+        m_pipeline->GetVkPipelineLayout(), 0, 1, m_gx_descriptor_sets.data(),
+        NUM_UBO_DESCRIPTOR_SET_BINDINGS, m_bindings.gx_ubo_offsets.data());
     m_dirty_flags &= ~DIRTY_FLAG_GX_UBO_OFFSETS;
   }
 
+  if (push_samplers && m_dirty_flags & DIRTY_FLAG_GX_SAMPLERS)
+  {
+    g_command_buffer_mgr->GetRecorder().PushSamplers(m_pipeline->GetVkPipelineLayout(), 1,
+                                                     m_bindings.samplers.data(), VK_NULL_HANDLE);
+    m_dirty_flags &= ~DIRTY_FLAG_GX_SAMPLERS;
+    INCSTAT(g_stats.this_frame.num_descriptor_sets_pushed);
+  }
+
   return true;
 }
 
@@ -586,7 +609,9 @@ bool StateTracker::UpdateUtilityDescriptorSet()
     m_dirty_flags = (m_dirty_flags & ~DIRTY_FLAG_UTILITY_UBO) | DIRTY_FLAG_DESCRIPTOR_SETS;
   }
 
-  if (m_dirty_flags & DIRTY_FLAG_UTILITY_BINDINGS || m_utility_descriptor_sets[1] == VK_NULL_HANDLE)
+  const bool push_bindings = g_vulkan_context->SupportsPushDescriptors();
+  if (!push_bindings && (m_dirty_flags & DIRTY_FLAG_UTILITY_BINDINGS ||
+                         m_utility_descriptor_sets[1] == VK_NULL_HANDLE))
   {
     m_utility_descriptor_sets[1] = g_command_buffer_mgr->AllocateDescriptorSet(
         g_object_cache->GetDescriptorSetLayout(DESCRIPTOR_SET_LAYOUT_UTILITY_SAMPLERS));
@@ -620,22 +645,38 @@ bool StateTracker::UpdateUtilityDescriptorSet()
   if (writes > 0)
     vkUpdateDescriptorSets(g_vulkan_context->GetDevice(), writes, dswrites.data(), 0, nullptr);
 
-  if (m_dirty_flags & DIRTY_FLAG_DESCRIPTOR_SETS)
+  if (m_dirty_flags & DIRTY_FLAG_DESCRIPTOR_SETS && push_bindings)
   {
-    vkCmdBindDescriptorSets(g_command_buffer_mgr->GetCurrentCommandBuffer(),
-                            VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline->GetVkPipelineLayout(), 0,
-                            NUM_UTILITY_DESCRIPTOR_SETS, m_utility_descriptor_sets.data(), 1,
-                            &m_bindings.utility_ubo_offset);
+    g_command_buffer_mgr->GetRecorder().BindDescriptorSets(m_pipeline->GetVkPipelineLayout(), 0, 1,
+                                                           m_utility_descriptor_sets.data(), 1,
+                                                           &m_bindings.utility_ubo_offset);
+    m_dirty_flags &= ~(DIRTY_FLAG_DESCRIPTOR_SETS | DIRTY_FLAG_UTILITY_UBO_OFFSET);
+    m_dirty_flags |= DIRTY_FLAG_UTILITY_BINDINGS;
+  }
+  else if (m_dirty_flags & DIRTY_FLAG_DESCRIPTOR_SETS)
+  {
+    g_command_buffer_mgr->GetRecorder().BindDescriptorSets(
+        m_pipeline->GetVkPipelineLayout(), 0, NUM_UTILITY_DESCRIPTOR_SETS,
+        m_utility_descriptor_sets.data(), 1, &m_bindings.utility_ubo_offset);
     m_dirty_flags &= ~(DIRTY_FLAG_DESCRIPTOR_SETS | DIRTY_FLAG_UTILITY_UBO_OFFSET);
   }
   else if (m_dirty_flags & DIRTY_FLAG_UTILITY_UBO_OFFSET)
   {
-    vkCmdBindDescriptorSets(g_command_buffer_mgr->GetCurrentCommandBuffer(),
-                            VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline->GetVkPipelineLayout(), 0,
-                            1, m_utility_descriptor_sets.data(), 1, &m_bindings.utility_ubo_offset);
+    g_command_buffer_mgr->GetRecorder().BindDescriptorSets(m_pipeline->GetVkPipelineLayout(), 0, 1,
+                                                           m_utility_descriptor_sets.data(), 1,
+                                                           &m_bindings.utility_ubo_offset);
     m_dirty_flags &= ~(DIRTY_FLAG_DESCRIPTOR_SETS | DIRTY_FLAG_UTILITY_UBO_OFFSET);
   }
 
+  if (push_bindings && m_dirty_flags & DIRTY_FLAG_UTILITY_BINDINGS)
+  {
+    g_command_buffer_mgr->GetRecorder().PushSamplers(m_pipeline->GetVkPipelineLayout(), 1,
+                                                     m_bindings.samplers.data(),
+                                                     m_bindings.texel_buffers[0]);
+    m_dirty_flags &= ~DIRTY_FLAG_UTILITY_BINDINGS;
+    INCSTAT(g_stats.this_frame.num_descriptor_sets_pushed);
+  }
+
   return true;
 }
 
@@ -10,6 +10,7 @@
 
 #include "Common/Align.h"
 #include "Common/Assert.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 
 #include "VideoBackends/Vulkan/CommandBufferManager.h"
@@ -193,6 +194,7 @@ bool StreamBuffer::ReserveMemory(u32 num_bytes, u32 alignment)
   // We tried everything we could, and still couldn't get anything. This means that too much space
   // in the buffer is being used by the command buffer currently being recorded. Therefore, the
   // only option is to execute it, and wait until it's done.
+  m_frame_stalled = true;
   return false;
 }
 
@@ -210,6 +212,36 @@ void StreamBuffer::CommitMemory(u32 final_num_bytes)
   }
 
   m_current_offset += final_num_bytes;
+  m_frame_committed_bytes += final_num_bytes;
+}
+
+bool StreamBuffer::ResizeForFrameUsage(u32 max_size)
+{
+  // A frame's worth of data can be queued in every command buffer, plus the one being recorded.
+  u64 wanted_size = static_cast<u64>(m_frame_committed_bytes) * (NUM_COMMAND_BUFFERS + 1);
+  if (m_frame_stalled)
+    wanted_size = std::max<u64>(wanted_size, static_cast<u64>(m_size) * 2);
+  m_frame_committed_bytes = 0;
+  m_frame_stalled = false;
+
+  u32 new_size = m_size;
+  while (new_size < wanted_size && new_size < max_size)
+    new_size = static_cast<u32>(std::min<u64>(static_cast<u64>(new_size) * 2, max_size));
+  if (new_size <= m_size)
+    return false;
+
+  // The old buffer is destroyed once the command buffer being recorded has completed.
+  const u32 old_size = m_size;
+  m_size = new_size;
+  if (!AllocateBuffer())
+  {
+    WARN_LOG(VIDEO, "Failed to grow stream buffer to %u bytes", new_size);
+    m_size = old_size;
+    return false;
+  }
+
+  INFO_LOG(VIDEO, "Grew stream buffer from %u to %u bytes", old_size, new_size);
+  return true;
 }
 
 void StreamBuffer::UpdateCurrentFencePosition()
@@ -316,6 +348,9 @@ bool StreamBuffer::WaitForClearSpace(u32 num_bytes)
     return false;
   }
 
+  if (iter->first > g_command_buffer_mgr->GetCompletedFenceCounter())
+    m_frame_stalled = true;
+
   // Wait until this fence is signaled. This will fire the callback, updating the GPU position.
   g_command_buffer_mgr->WaitForFenceCounter(iter->first);
   m_tracked_fences.erase(m_tracked_fences.begin(),
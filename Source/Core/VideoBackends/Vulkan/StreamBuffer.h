@@ -29,6 +29,12 @@ public:
   bool ReserveMemory(u32 num_bytes, u32 alignment);
   void CommitMemory(u32 final_num_bytes);
 
+  // Swaps in a bigger buffer, up to max_size, if the last frame had to wait for the GPU to free
+  // up space, or wouldn't fit in the buffer once per command buffer in flight. Must not be called
+  // while memory is reserved. Returns true if the buffer was replaced, in which case anything
+  // still bound to the old buffer has to be rebound.
+  bool ResizeForFrameUsage(u32 max_size);
+
   static std::unique_ptr<StreamBuffer> Create(VkBufferUsageFlags usage, u32 size);
 
 private:
@@ -45,6 +51,10 @@ private:
   u32 m_current_gpu_position = 0;
   u32 m_last_allocation_size = 0;
 
+  // Usage since the last call to ResizeForFrameUsage
+  u32 m_frame_committed_bytes = 0;
+  bool m_frame_stalled = false;
+
   VkBuffer m_buffer = VK_NULL_HANDLE;
   VkDeviceMemory m_memory = VK_NULL_HANDLE;
   u8* m_host_pointer = nullptr;
@@ -383,10 +383,17 @@ std::unique_ptr<VKPipeline> VKPipeline::Create(const AbstractPipelineConfig& con
       -1                     // int32_t                                          basePipelineIndex
   };
 
+  // Pick up what other instances compiled in the meantime, it may include this pipeline.
+  g_object_cache->SyncSharedPipelineCache();
+
   VkPipeline pipeline;
-  VkResult res =
-      vkCreateGraphicsPipelines(g_vulkan_context->GetDevice(), g_object_cache->GetPipelineCache(),
-                                1, &pipeline_info, nullptr, &pipeline);
+  VkResult res;
+  {
+    auto cache_lock = g_object_cache->LockPipelineCache();
+    res = vkCreateGraphicsPipelines(g_vulkan_context->GetDevice(),
+                                    g_object_cache->GetPipelineCache(), 1, &pipeline_info, nullptr,
+                                    &pipeline);
+  }
   if (res != VK_SUCCESS)
   {
     LOG_VULKAN_ERROR(res, "vkCreateGraphicsPipelines failed: ");
@@ -71,8 +71,12 @@ static std::unique_ptr<VKShader> CreateShaderObject(ShaderStage stage,
       -1};
 
   VkPipeline pipeline;
-  res = vkCreateComputePipelines(g_vulkan_context->GetDevice(), g_object_cache->GetPipelineCache(),
-                                 1, &pipeline_info, nullptr, &pipeline);
+  {
+    auto cache_lock = g_object_cache->LockPipelineCache();
+    res = vkCreateComputePipelines(g_vulkan_context->GetDevice(),
+                                   g_object_cache->GetPipelineCache(), 1, &pipeline_info, nullptr,
+                                   &pipeline);
+  }
 
   // Shader module is no longer needed, now it is compiled to a pipeline.
   vkDestroyShaderModule(g_vulkan_context->GetDevice(), mod, nullptr);
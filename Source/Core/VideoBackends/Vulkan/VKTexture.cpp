@@ -362,10 +362,13 @@ void VKTexture::Load(u32 level, u32 width, u32 height, u32 row_length, const u8*
   VkBuffer upload_buffer;
   VkDeviceSize upload_buffer_offset;
 
-  // Does this texture data fit within the streaming buffer?
-  if (upload_size <= STAGING_TEXTURE_UPLOAD_THRESHOLD)
+  // Large textures, e.g. from HD texture packs, go through a buffer of their own so that they
+  // don't end up waiting for each other in the regular one.
+  StreamBuffer* stream_buffer = upload_size <= STAGING_TEXTURE_UPLOAD_THRESHOLD ?
+                                    g_object_cache->GetTextureUploadBuffer() :
+                                    g_object_cache->GetLargeTextureUploadBuffer(upload_size);
+  if (stream_buffer)
   {
-    StreamBuffer* stream_buffer = g_object_cache->GetTextureUploadBuffer();
     if (!stream_buffer->ReserveMemory(upload_size, upload_alignment))
     {
       // Execute the command buffer first.
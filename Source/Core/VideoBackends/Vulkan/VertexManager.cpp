@@ -26,6 +26,9 @@
 
 namespace Vulkan
 {
+// How far the stream buffers are allowed to grow past their initial size.
+constexpr u32 MAX_STREAM_BUFFER_GROWTH = 2;
+
 static VkBufferView CreateTexelBufferView(VkBuffer buffer, VkFormat vk_format)
 {
   // Create a view of the whole buffer, we'll offset our texel load into it
@@ -139,6 +142,24 @@ void VertexManager::DestroyTexelBufferViews()
   }
 }
 
+void VertexManager::OnEndFrame()
+{
+  VertexManagerBase::OnEndFrame();
+
+  // The frame's last batch has been flushed, so nothing is reserved in the stream buffers. The
+  // texel buffer isn't resized, as its views are created once up front.
+  m_vertex_stream_buffer->ResizeForFrameUsage(VERTEX_STREAM_BUFFER_SIZE * MAX_STREAM_BUFFER_GROWTH);
+  m_index_stream_buffer->ResizeForFrameUsage(INDEX_STREAM_BUFFER_SIZE * MAX_STREAM_BUFFER_GROWTH);
+  if (m_uniform_stream_buffer->ResizeForFrameUsage(UNIFORM_STREAM_BUFFER_SIZE *
+                                                   MAX_STREAM_BUFFER_GROWTH))
+  {
+    // Constants left in the old buffer will be gone once the current command buffer completes.
+    InvalidateConstants();
+    StateTracker::GetInstance()->SetUtilityUniformBuffer(m_uniform_stream_buffer->GetBuffer(), 0,
+                                                         sizeof(VertexShaderConstants));
+  }
+}
+
 void VertexManager::ResetBuffer(u32 vertex_stride)
 {
   // Attempt to allocate from buffers
@@ -30,6 +30,8 @@ public:
                          const void* palette_data, u32 palette_size,
                          TexelBufferFormat palette_format, u32* out_palette_offset) override;
 
+  void OnEndFrame() override;
+
 protected:
   void ResetBuffer(u32 vertex_stride) override;
   void CommitBuffer(u32 num_vertices, u32 vertex_stride, u32 num_indices, u32* out_base_vertex,
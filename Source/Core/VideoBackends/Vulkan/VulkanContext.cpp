@@ -475,6 +475,10 @@ bool VulkanContext::SelectDeviceExtensions(bool enable_surface)
     INFO_LOG(VIDEO, "Using VK_EXT_full_screen_exclusive for exclusive fullscreen.");
 #endif
 
+  // VK_KHR_push_descriptor lets us write sampler bindings straight into the command buffer instead
+  // of allocating a descriptor set for every change.
+  m_supports_push_descriptors = AddExtension(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME, false);
+
   return true;
 }
 
@@ -6,6 +6,7 @@
 
 #include "VideoCommon/AsyncRequests.h"
 #include "VideoCommon/Fifo.h"
+#include "VideoCommon/GPUMemoryAccess.h"
 #include "VideoCommon/RenderBase.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexManagerBase.h"
@@ -158,13 +159,30 @@ void AsyncRequests::HandleEvent(const AsyncRequests::Event& e)
     *e.bbox.data = g_renderer->BBoxRead(e.bbox.index);
     break;
 
+  case Event::BBOX_READBACK:
+    for (int i = 0; i < 4; i++)
+      e.bbox_readback.data[i] = g_renderer->BBoxRead(i);
+    e.bbox_readback.pending->Clear();
+    break;
+
   case Event::PERF_QUERY:
     g_perf_query->FlushResults();
     break;
 
+  case Event::PERF_QUERY_READBACK:
+    g_perf_query->FlushResults();
+    for (int i = 0; i < PQ_NUM_MEMBERS; i++)
+      e.perf_query_readback.data[i] = g_perf_query->GetQueryResult(static_cast<PerfQueryType>(i));
+    e.perf_query_readback.pending->Clear();
+    break;
+
   case Event::DO_SAVE_STATE:
     VideoCommon_DoState(*e.do_save_state.p);
     break;
+
+  case Event::GPU_MEMORY_ACCESS:
+    GPUMemoryAccess::Execute(*e.gpu_memory_access.accesses);
+    break;
   }
 }
 
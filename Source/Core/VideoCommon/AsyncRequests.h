@@ -13,6 +13,10 @@
 #include "Common/Flag.h"
 
 struct EfbPokeData;
+namespace GPUMemoryAccess
+{
+struct Access;
+}
 class PointerWrap;
 
 class AsyncRequests
@@ -28,8 +32,11 @@ public:
       EFB_PEEK_Z,
       SWAP_EVENT,
       BBOX_READ,
+      BBOX_READBACK,
       PERF_QUERY,
+      PERF_QUERY_READBACK,
       DO_SAVE_STATE,
+      GPU_MEMORY_ACCESS,
     } type;
     u64 time;
 
@@ -63,14 +70,33 @@ public:
         u16* data;
       } bbox;
 
+      struct
+      {
+        // All four coordinates, then pending is cleared
+        u16* data;
+        Common::Flag* pending;
+      } bbox_readback;
+
       struct
       {
       } perf_query;
 
+      struct
+      {
+        // One value per PerfQueryType, then pending is cleared
+        u32* data;
+        Common::Flag* pending;
+      } perf_query_readback;
+
       struct
       {
         PointerWrap* p;
       } do_save_state;
+
+      struct
+      {
+        const std::vector<GPUMemoryAccess::Access>* accesses;
+      } gpu_memory_access;
     };
   };
 
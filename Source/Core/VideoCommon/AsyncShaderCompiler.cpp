@@ -6,6 +6,7 @@
 #include <thread>
 #include "Common/Assert.h"
 #include "Common/Logging/Log.h"
+#include "Common/Thread.h"
 
 namespace VideoCommon
 {
@@ -36,6 +37,18 @@ void AsyncShaderCompiler::QueueWorkItem(WorkItemPtr item, u32 priority)
   }
 }
 
+void AsyncShaderCompiler::ReprioritizeWorkItems()
+{
+  std::lock_guard<std::mutex> guard(m_pending_work_lock);
+  std::multimap<u32, WorkItemPtr> pending_work;
+  for (auto& it : m_pending_work)
+  {
+    const u32 priority = it.second->UpdatePriority(it.first);
+    pending_work.emplace(priority, std::move(it.second));
+  }
+  m_pending_work.swap(pending_work);
+}
+
 void AsyncShaderCompiler::RetrieveWorkItems()
 {
   std::deque<WorkItemPtr> completed_work;
@@ -192,6 +205,8 @@ void AsyncShaderCompiler::WorkerThreadExit(void* param)
 
 void AsyncShaderCompiler::WorkerThreadEntryPoint(void* param)
 {
+  Common::SetCurrentThreadCoreClass(Common::CoreClass::Efficiency);
+
   // Initialize worker thread with backend-specific method.
   if (!WorkerThreadInitWorkerThread(param))
   {
@@ -30,6 +30,9 @@ public:
     virtual ~WorkItem() = default;
     virtual bool Compile() = 0;
     virtual void Retrieve() = 0;
+
+    // Called from ReprioritizeWorkItems with the priority the item is queued at.
+    virtual u32 UpdatePriority(u32 priority) { return priority; }
   };
 
   using WorkItemPtr = std::unique_ptr<WorkItem>;
@@ -46,6 +49,9 @@ public:
   // Queues a new work item to the compiler threads. The lower the priority, the sooner
   // this work item will be compiled, relative to the other work items.
   void QueueWorkItem(WorkItemPtr item, u32 priority);
+  // Re-sorts the work items that haven't been picked up by a worker yet by their current
+  // priorities. Items keep their order within a priority.
+  void ReprioritizeWorkItems();
   void RetrieveWorkItems();
   bool HasPendingWork();
   bool HasCompletedWork();
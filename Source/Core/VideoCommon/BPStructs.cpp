@@ -4,6 +4,7 @@
 
 #include "VideoCommon/BPStructs.h"
 
+#include <array>
 #include <cmath>
 #include <cstring>
 #include <string>
@@ -47,6 +48,35 @@ void BPInit()
   bpmem.bpMask = 0xFFFFFF;
 }
 
+enum BPRegisterFlags : u8
+{
+  // Writing the register triggers something, so it has to be handled even if the value is the same
+  BP_TRIGGER = 1 << 0,
+  // The register is only read when a copy, clear, TLUT load or TMEM preload is triggered, and the
+  // trigger itself flushes. Writing it doesn't affect anything that is already batched.
+  BP_NO_FLUSH = 1 << 1,
+};
+
+static constexpr std::array<u8, 256> s_bp_register_flags = [] {
+  std::array<u8, 256> flags{};
+  for (const u32 address :
+       {BPMEM_TRIGGER_EFB_COPY, BPMEM_CLEARBBOX1, BPMEM_CLEARBBOX2, BPMEM_SETDRAWDONE,
+        BPMEM_PE_TOKEN_ID, BPMEM_PE_TOKEN_INT_ID, BPMEM_LOADTLUT0, BPMEM_LOADTLUT1,
+        BPMEM_TEXINVALIDATE, BPMEM_PRELOAD_MODE, BPMEM_CLEAR_PIXEL_PERF})
+  {
+    flags[address] |= BP_TRIGGER;
+  }
+  for (const u32 address :
+       {BPMEM_EFB_TL, BPMEM_EFB_BR, BPMEM_EFB_ADDR, BPMEM_MIPMAP_STRIDE, BPMEM_COPYYSCALE,
+        BPMEM_CLEAR_AR, BPMEM_CLEAR_GB, BPMEM_CLEAR_Z, BPMEM_COPYFILTER0, BPMEM_COPYFILTER1,
+        BPMEM_PRELOAD_ADDR, BPMEM_PRELOAD_TMEMEVEN, BPMEM_PRELOAD_TMEMODD, BPMEM_LOADTLUT0,
+        BPMEM_BP_MASK})
+  {
+    flags[address] |= BP_NO_FLUSH;
+  }
+  return flags;
+}();
+
 static void BPWritten(const BPCmd& bp)
 {
   /*
@@ -70,20 +100,14 @@ static void BPWritten(const BPCmd& bp)
   ----------------------------------------------------------------------------------------------------------------
   */
 
-  if (((s32*)&bpmem)[bp.address] == bp.newvalue)
-  {
-    if (!(bp.address == BPMEM_TRIGGER_EFB_COPY || bp.address == BPMEM_CLEARBBOX1 ||
-          bp.address == BPMEM_CLEARBBOX2 || bp.address == BPMEM_SETDRAWDONE ||
-          bp.address == BPMEM_PE_TOKEN_ID || bp.address == BPMEM_PE_TOKEN_INT_ID ||
-          bp.address == BPMEM_LOADTLUT0 || bp.address == BPMEM_LOADTLUT1 ||
-          bp.address == BPMEM_TEXINVALIDATE || bp.address == BPMEM_PRELOAD_MODE ||
-          bp.address == BPMEM_CLEAR_PIXEL_PERF))
-    {
-      return;
-    }
-  }
+  // Games rewrite a lot of state with the value it already has, so those writes have to cost no
+  // more than the compare to keep them from splitting batches
+  const u8 flags = s_bp_register_flags[bp.address & 0xFF];
+  if (!(flags & BP_TRIGGER) && ((s32*)&bpmem)[bp.address] == bp.newvalue)
+    return;
 
-  FlushPipeline();
+  if (!(flags & BP_NO_FLUSH))
+    FlushPipeline();
 
   ((u32*)&bpmem)[bp.address] = bp.newvalue;
 
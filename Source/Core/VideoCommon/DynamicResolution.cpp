@@ -0,0 +1,137 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/DynamicResolution.h"
+
+#include <algorithm>
+
+#ifdef ANDROID
+#include <chrono>
+#include <cmath>
+#include <dlfcn.h>
+#endif
+
+namespace
+{
+// Measurements are averaged over this many swaps before the scale is reconsidered.
+constexpr u32 SWAPS_PER_DECISION = 30;
+
+// A new scale gets this many swaps to settle, e.g. to recreate render targets, before it's judged.
+constexpr u32 COOLDOWN_SWAPS = 60;
+
+// Lower the scale when the GPU thread is busier than this. Only raise it when the higher scale is
+// expected to stay under the second threshold, so that it doesn't flip back and forth.
+constexpr double DECREASE_UTILIZATION = 0.9;
+constexpr double INCREASE_UTILIZATION = 0.75;
+
+// Thermal headroom is 1.0 where the device starts to throttle. The scale is lowered before it gets
+// there, and isn't raised again until the device has cooled down a bit.
+constexpr float DECREASE_HEADROOM = 0.9f;
+constexpr float INCREASE_HEADROOM = 0.75f;
+
+// Returns the thermal headroom forecast for a few seconds from now, or 0 if the device can't tell.
+// The thermal API is only there on Android 11 and later, so it is looked up at runtime.
+float GetThermalHeadroom()
+{
+#ifdef ANDROID
+  struct ThermalApi
+  {
+    void* manager = nullptr;
+    float (*get_headroom)(void* manager, int forecast_seconds) = nullptr;
+  };
+  static const ThermalApi api = [] {
+    ThermalApi result;
+    void* const library = dlopen("libandroid.so", RTLD_NOW);
+    if (!library)
+      return result;
+
+    const auto acquire_manager =
+        reinterpret_cast<void* (*)()>(dlsym(library, "AThermal_acquireManager"));
+    result.get_headroom = reinterpret_cast<float (*)(void*, int)>(
+        dlsym(library, "AThermal_getThermalHeadroom"));
+    if (acquire_manager && result.get_headroom)
+      result.manager = acquire_manager();
+    return result;
+  }();
+
+  if (!api.manager)
+    return 0.0f;
+
+  // Asking more than once a second only returns NaN, so the last answer is kept until then
+  static float s_headroom = 0.0f;
+  static std::chrono::steady_clock::time_point s_last_query;
+  const auto now = std::chrono::steady_clock::now();
+  if (now - s_last_query >= std::chrono::seconds(1))
+  {
+    s_last_query = now;
+    const float headroom = api.get_headroom(api.manager, 5);
+    s_headroom = std::isnan(headroom) ? 0.0f : headroom;
+  }
+  return s_headroom;
+#else
+  return 0.0f;
+#endif
+}
+}  // Anonymous namespace
+
+void DynamicResolution::Update(u64 interval_us, u64 idle_us)
+{
+  if (m_scale == 0)
+    return;
+
+  if (m_cooldown > 0)
+  {
+    m_cooldown--;
+    return;
+  }
+
+  m_total_time_us += interval_us;
+  m_busy_time_us += interval_us - std::min(idle_us, interval_us);
+  if (++m_num_samples < SWAPS_PER_DECISION)
+    return;
+
+  const double utilization =
+      m_total_time_us != 0 ? static_cast<double>(m_busy_time_us) / m_total_time_us : 0.0;
+  m_total_time_us = 0;
+  m_busy_time_us = 0;
+  m_num_samples = 0;
+
+  // Rendering less keeps the device from throttling the CPU, which emulation depends on far more
+  const float headroom = GetThermalHeadroom();
+
+  if ((utilization > DECREASE_UTILIZATION || headroom > DECREASE_HEADROOM) &&
+      m_scale > m_min_scale)
+  {
+    m_scale--;
+    m_cooldown = COOLDOWN_SWAPS;
+    return;
+  }
+
+  const double growth = static_cast<double>(m_scale + 1) / m_scale;
+  if (m_scale < m_max_scale && utilization * growth * growth < INCREASE_UTILIZATION &&
+      headroom < INCREASE_HEADROOM)
+  {
+    m_scale++;
+    m_cooldown = COOLDOWN_SWAPS;
+  }
+}
+
+u32 DynamicResolution::GetScale(u32 min_scale, u32 max_scale)
+{
+  if (min_scale != m_min_scale || max_scale != m_max_scale || m_scale == 0)
+  {
+    const u32 scale = m_scale != 0 ? m_scale : max_scale;
+    Reset();
+    m_min_scale = min_scale;
+    m_max_scale = max_scale;
+    m_scale = std::clamp(scale, min_scale, max_scale);
+  }
+
+  return m_scale;
+}
+
+void DynamicResolution::Reset()
+{
+  *this = {};
+}
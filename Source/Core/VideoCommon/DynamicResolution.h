@@ -0,0 +1,32 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+// Picks the EFB scale that keeps the GPU thread from holding emulation back. Every swap reports the
+// time since the previous one, and how much of it the GPU thread spent waiting for work or for the
+// presentation to finish. The rest is rendering cost, which is assumed to grow with pixel count.
+// On Android, the scale is also lowered when the device is about to throttle because of heat.
+class DynamicResolution
+{
+public:
+  void Update(u64 interval_us, u64 idle_us);
+
+  // Returns the scale to render at, within [min_scale, max_scale]. Starts at max_scale.
+  u32 GetScale(u32 min_scale, u32 max_scale);
+
+  void Reset();
+
+private:
+  u32 m_scale = 0;
+  u32 m_min_scale = 0;
+  u32 m_max_scale = 0;
+
+  u64 m_total_time_us = 0;
+  u64 m_busy_time_us = 0;
+  u32 m_num_samples = 0;
+  u32 m_cooldown = 0;
+};
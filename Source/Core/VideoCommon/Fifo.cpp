@@ -4,8 +4,12 @@
 
 #include "VideoCommon/Fifo.h"
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <cstdlib>
 #include <cstring>
+#include <limits>
 
 #include "Common/Assert.h"
 #include "Common/Atomic.h"
@@ -15,6 +19,9 @@
 #include "Common/FPURoundMode.h"
 #include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
+#include "Common/ScopeGuard.h"
+#include "Common/Timer.h"
+#include "Common/Trace.h"
 
 #include "Core/ConfigManager.h"
 #include "Core/CoreTiming.h"
@@ -25,6 +32,7 @@
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/CommandProcessor.h"
 #include "VideoCommon/DataReader.h"
+#include "VideoCommon/FrameProfiler.h"
 #include "VideoCommon/OpcodeDecoding.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexManagerBase.h"
@@ -50,12 +58,17 @@ static bool s_use_deterministic_gpu_thread;
 
 static CoreTiming::EventType* s_event_sync_gpu;
 
+// Time the GPU thread spent waiting for work, between runs of its loop payload.
+static u64 s_gpu_idle_time_us;
+static u64 s_gpu_payload_end_us;
+
 // STATE_TO_SAVE
 static u8* s_video_buffer;
 static u8* s_video_buffer_read_ptr;
 static std::atomic<u8*> s_video_buffer_write_ptr;
 static std::atomic<u8*> s_video_buffer_seen_ptr;
 static u8* s_video_buffer_pp_read_ptr;
+static std::atomic<u8*> s_video_buffer_decoded_ptr;
 // The read_ptr is always owned by the GPU thread.  In normal mode, so is the
 // write_ptr, despite it being atomic.  In deterministic GPU thread mode,
 // things get a bit more complicated:
@@ -67,11 +80,25 @@ static u8* s_video_buffer_pp_read_ptr;
 // FIFO.  Maybe someday it will be under the lock.  For now, because RunGpuLoop
 // polls, it's just atomic.
 // - The pp_read_ptr is the CPU preprocessing version of the read_ptr.
+// - The decoded_ptr is the pp_read_ptr as published to the GPU thread. Everything before it is
+// made of complete commands that the preprocessor has already walked, so the GPU thread only
+// runs up to there and never has to start on a command it can't finish.
 
 static std::atomic<int> s_sync_ticks;
 static bool s_syncing_suspended;
 static Common::Event s_sync_wakeup_event;
 
+// With bSyncGPUAdaptive, the distance the CPU thread may run ahead is adjusted by the CPU thread
+// every SYNC_GPU_ADAPT_INTERVAL_US. It grows when the CPU thread keeps waiting while the GPU
+// thread still has idle time, so the backlog comes in bursts that a larger distance absorbs. It
+// shrinks back when the CPU thread hardly waits, since a shorter distance is closer to how the
+// hardware behaves.
+constexpr u64 SYNC_GPU_ADAPT_INTERVAL_US = 100000;
+static std::atomic<int> s_sync_max_distance;
+static u64 s_sync_adapt_start_us;
+static u64 s_sync_cpu_wait_us;
+static std::atomic<u64> s_sync_gpu_idle_us;
+
 void DoState(PointerWrap& p)
 {
   p.DoArray(s_video_buffer, FIFO_SIZE);
@@ -83,6 +110,7 @@ void DoState(PointerWrap& p)
   {
     // We're good and paused, right?
     s_video_buffer_seen_ptr = s_video_buffer_pp_read_ptr = s_video_buffer_read_ptr;
+    s_video_buffer_decoded_ptr = s_video_buffer_read_ptr;
   }
 
   p.Do(s_sync_ticks);
@@ -118,6 +146,17 @@ void Init()
   if (SConfig::GetInstance().bCPUThread)
     s_gpu_mainloop.Prepare();
   s_sync_ticks.store(0);
+  s_sync_max_distance.store(SConfig::GetInstance().iSyncGpuMaxDistance);
+  s_sync_adapt_start_us = 0;
+  s_sync_cpu_wait_us = 0;
+  s_sync_gpu_idle_us.store(0);
+}
+
+static int GetSyncGpuMaxDistance()
+{
+  const SConfig& param = SConfig::GetInstance();
+  return param.bSyncGPUAdaptive ? s_sync_max_distance.load(std::memory_order_relaxed) :
+                                  param.iSyncGpuMaxDistance;
 }
 
 void Shutdown()
@@ -131,10 +170,18 @@ void Shutdown()
   s_video_buffer_pp_read_ptr = nullptr;
   s_video_buffer_read_ptr = nullptr;
   s_video_buffer_seen_ptr = nullptr;
+  s_video_buffer_decoded_ptr = nullptr;
   s_fifo_aux_write_ptr = nullptr;
   s_fifo_aux_read_ptr = nullptr;
 }
 
+u64 TakeGpuThreadIdleTime()
+{
+  const u64 idle_time_us = s_gpu_idle_time_us;
+  s_gpu_idle_time_us = 0;
+  return idle_time_us;
+}
+
 // May be executed from any thread, even the graphics thread.
 // Created to allow for self shutdown.
 void ExitGpuLoop()
@@ -161,7 +208,10 @@ void SyncGPU(SyncGPUReason reason, bool may_move_read_ptr)
 {
   if (s_use_deterministic_gpu_thread)
   {
-    s_gpu_mainloop.Wait();
+    {
+      FrameProfiler::ScopedTimer timer(FrameProfiler::Category::SyncGPU);
+      s_gpu_mainloop.Wait();
+    }
     if (!s_gpu_mainloop.IsRunning())
       return;
 
@@ -182,12 +232,13 @@ void SyncGPU(SyncGPUReason reason, bool may_move_read_ptr)
 
       memmove(s_video_buffer, s_video_buffer_pp_read_ptr, size);
       // This change always decreases the pointers.  We write seen_ptr
-      // after write_ptr here, and read it before in RunGpuLoop, so
-      // 'write_ptr > seen_ptr' there cannot become spuriously true.
+      // after decoded_ptr here, and read it before in RunGpuLoop, so
+      // 'decoded_ptr > seen_ptr' there cannot become spuriously true.
       s_video_buffer_write_ptr = write_ptr = s_video_buffer + size;
       s_video_buffer_pp_read_ptr = s_video_buffer;
       s_video_buffer_read_ptr = s_video_buffer;
-      s_video_buffer_seen_ptr = write_ptr;
+      s_video_buffer_decoded_ptr = s_video_buffer;
+      s_video_buffer_seen_ptr = s_video_buffer;
     }
   }
 }
@@ -276,6 +327,7 @@ static void ReadDataFromFifoOnCPU(u32 readPtr)
       DataReader(s_video_buffer_pp_read_ptr, write_ptr + len), nullptr, false);
   // This would have to be locked if the GPU thread didn't spin.
   s_video_buffer_write_ptr = write_ptr + len;
+  s_video_buffer_decoded_ptr = s_video_buffer_pp_read_ptr;
 }
 
 void ResetVideoBuffer()
@@ -284,6 +336,7 @@ void ResetVideoBuffer()
   s_video_buffer_write_ptr = s_video_buffer;
   s_video_buffer_seen_ptr = s_video_buffer;
   s_video_buffer_pp_read_ptr = s_video_buffer;
+  s_video_buffer_decoded_ptr = s_video_buffer;
   s_fifo_aux_write_ptr = s_fifo_aux_data;
   s_fifo_aux_read_ptr = s_fifo_aux_data;
 }
@@ -295,10 +348,23 @@ void RunGpuLoop()
   AsyncRequests::GetInstance()->SetEnable(true);
   AsyncRequests::GetInstance()->SetPassthrough(false);
 
+  s_gpu_idle_time_us = 0;
+  s_gpu_payload_end_us = 0;
+
   s_gpu_mainloop.Run(
       [] {
         const SConfig& param = SConfig::GetInstance();
 
+        const u64 payload_start_us = Common::Timer::GetTimeUs();
+        if (s_gpu_payload_end_us != 0)
+        {
+          s_gpu_idle_time_us += payload_start_us - s_gpu_payload_end_us;
+          if (param.bSyncGPUAdaptive)
+            s_sync_gpu_idle_us.fetch_add(payload_start_us - s_gpu_payload_end_us);
+        }
+        Common::ScopeGuard payload_end_guard{
+            [] { s_gpu_payload_end_us = Common::Timer::GetTimeUs(); }};
+
         // Run events from the CPU thread.
         AsyncRequests::GetInstance()->PullEvents();
 
@@ -306,17 +372,18 @@ void RunGpuLoop()
         if (!s_emu_running_state.IsSet())
           return;
 
+        TRACE_SCOPE("Fifo::RunGpuLoop");
         if (s_use_deterministic_gpu_thread)
         {
           // All the fifo/CP stuff is on the CPU.  We just need to run the opcode decoder.
           u8* seen_ptr = s_video_buffer_seen_ptr;
-          u8* write_ptr = s_video_buffer_write_ptr;
+          u8* decoded_ptr = s_video_buffer_decoded_ptr;
           // See comment in SyncGPU
-          if (write_ptr > seen_ptr)
+          if (decoded_ptr > seen_ptr)
           {
-            s_video_buffer_read_ptr =
-                OpcodeDecoder::Run(DataReader(s_video_buffer_read_ptr, write_ptr), nullptr, false);
-            s_video_buffer_seen_ptr = write_ptr;
+            s_video_buffer_read_ptr = OpcodeDecoder::Run(
+                DataReader(s_video_buffer_read_ptr, decoded_ptr), nullptr, false);
+            s_video_buffer_seen_ptr = decoded_ptr;
           }
         }
         else
@@ -359,9 +426,9 @@ void RunGpuLoop()
             if (param.bSyncGPU)
             {
               cyclesExecuted = (int)(cyclesExecuted / param.fSyncGpuOverclock);
+              const int max_distance = GetSyncGpuMaxDistance();
               int old = s_sync_ticks.fetch_sub(cyclesExecuted);
-              if (old >= param.iSyncGpuMaxDistance &&
-                  old - (int)cyclesExecuted < param.iSyncGpuMaxDistance)
+              if (old >= max_distance && old - (int)cyclesExecuted < max_distance)
                 s_sync_wakeup_event.Set();
             }
 
@@ -376,7 +443,7 @@ void RunGpuLoop()
           if (s_sync_ticks.load() > 0)
           {
             int old = s_sync_ticks.exchange(0);
-            if (old >= param.iSyncGpuMaxDistance)
+            if (old >= GetSyncGpuMaxDistance())
               s_sync_wakeup_event.Set();
           }
 
@@ -516,6 +583,7 @@ void UpdateWantDeterminism(bool want)
     {
       // These haven't been updated in non-deterministic mode.
       s_video_buffer_seen_ptr = s_video_buffer_pp_read_ptr = s_video_buffer_read_ptr;
+      s_video_buffer_decoded_ptr = s_video_buffer_read_ptr;
       CopyPreprocessCPStateFromMain();
       VertexLoaderManager::MarkAllDirty();
     }
@@ -532,10 +600,59 @@ bool UseDeterministicGPUThread()
  * @ticks The gone emulated CPU time.
  * @return A good time to call WaitForGpuThread() next.
  */
+static void AdaptSyncGpuDistance()
+{
+  const u64 now_us = Common::Timer::GetTimeUs();
+  if (s_sync_adapt_start_us == 0)
+    s_sync_adapt_start_us = now_us;
+  const u64 elapsed_us = now_us - s_sync_adapt_start_us;
+  if (elapsed_us < SYNC_GPU_ADAPT_INTERVAL_US)
+    return;
+
+  const SConfig& param = SConfig::GetInstance();
+  const s64 lower = std::max<s64>(param.iSyncGpuMaxDistance / 4,
+                                  s64(param.iSyncGpuMinDistance) + GPU_TIME_SLOT_SIZE);
+  const s64 upper = std::max<s64>(
+      lower, std::min<s64>(s64(param.iSyncGpuMaxDistance) * 4, std::numeric_limits<int>::max()));
+  const u64 gpu_idle_us = s_sync_gpu_idle_us.exchange(0);
+
+  s64 distance = s_sync_max_distance.load(std::memory_order_relaxed);
+  if (s_sync_cpu_wait_us * 20 > elapsed_us && gpu_idle_us * 20 > elapsed_us)
+    distance += std::max<s64>(std::abs(distance) / 4, GPU_TIME_SLOT_SIZE);
+  else if (s_sync_cpu_wait_us * 100 < elapsed_us)
+    distance -= std::max<s64>(std::abs(distance) / 16, GPU_TIME_SLOT_SIZE);
+  s_sync_max_distance.store(static_cast<int>(std::clamp(distance, lower, upper)));
+
+  s_sync_adapt_start_us = now_us;
+  s_sync_cpu_wait_us = 0;
+}
+
+// Waits for the GPU thread to catch up. The adaptive distance can change while the GPU thread
+// compares against the old one and misses its wakeup, so that needs to check again now and then.
+static void WaitForSyncWakeup()
+{
+  if (!SConfig::GetInstance().bSyncGPUAdaptive)
+  {
+    s_sync_wakeup_event.Wait();
+    return;
+  }
+
+  const u64 start_us = Common::Timer::GetTimeUs();
+  while (!s_sync_wakeup_event.WaitFor(std::chrono::milliseconds(1)))
+  {
+    if (s_sync_ticks.load() < GetSyncGpuMaxDistance() || !s_gpu_mainloop.IsRunning())
+      break;
+  }
+  s_sync_cpu_wait_us += Common::Timer::GetTimeUs() - start_us;
+}
+
 static int WaitForGpuThread(int ticks)
 {
   const SConfig& param = SConfig::GetInstance();
 
+  if (param.bSyncGPUAdaptive)
+    AdaptSyncGpuDistance();
+
   int old = s_sync_ticks.fetch_add(ticks);
   int now = old + ticks;
 
@@ -552,8 +669,11 @@ static int WaitForGpuThread(int ticks)
     return GPU_TIME_SLOT_SIZE + param.iSyncGpuMinDistance - now;
 
   // Wait for GPU
-  if (now >= param.iSyncGpuMaxDistance)
-    s_sync_wakeup_event.Wait();
+  if (now >= GetSyncGpuMaxDistance())
+  {
+    FrameProfiler::ScopedTimer timer(FrameProfiler::Category::SyncGPU);
+    WaitForSyncWakeup();
+  }
 
   return GPU_TIME_SLOT_SIZE;
 }
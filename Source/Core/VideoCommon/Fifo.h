@@ -40,6 +40,9 @@ void FlushGpu();
 void RunGpu();
 void GpuMaySleep();
 void RunGpuLoop();
+// Microseconds the GPU thread waited for work since the last call. Only valid on the GPU thread,
+// in dual core mode.
+u64 TakeGpuThreadIdleTime();
 void ExitGpuLoop();
 void EmulatorState(bool running);
 bool AtBreakpoint();
@@ -6,8 +6,10 @@
 #define __STDC_CONSTANT_MACROS 1
 #endif
 
+#include <atomic>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -15,7 +17,11 @@ extern "C" {
 #include <libavcodec/avcodec.h>
 #include <libavformat/avformat.h>
 #include <libavutil/mathematics.h>
+#include <libavutil/pixdesc.h>
 #include <libswscale/swscale.h>
+#if LIBAVUTIL_VERSION_MAJOR >= 56
+#include <libavutil/hwcontext.h>
+#endif
 }
 
 #include "Common/FileUtil.h"
@@ -43,7 +49,11 @@ static AVStream* s_stream = nullptr;
 static AVCodecContext* s_codec_context = nullptr;
 static AVFrame* s_src_frame = nullptr;
 static AVFrame* s_scaled_frame = nullptr;
-static AVPixelFormat s_pix_fmt = AV_PIX_FMT_BGR24;
+static AVFrame* s_hw_frame = nullptr;
+static AVBufferRef* s_hw_device_context = nullptr;
+// The format frames are handed to the encoder in, or uploaded from for hardware frame encoders.
+static AVPixelFormat s_sw_pix_fmt = AV_PIX_FMT_YUV420P;
+static std::atomic<bool> s_wants_nv12{false};
 static SwsContext* s_sws_context = nullptr;
 static int s_width;
 static int s_height;
@@ -82,8 +92,6 @@ static bool AVStreamCopyContext(AVStream* stream, AVCodecContext* codec_context)
 
 bool FrameDump::Start(int w, int h)
 {
-  s_pix_fmt = AV_PIX_FMT_RGBA;
-
   s_width = w;
   s_height = h;
   s_last_pts = 0;
@@ -99,6 +107,122 @@ bool FrameDump::Start(int w, int h)
   return success;
 }
 
+// Tried in this order when hardware encoding is enabled, appended to the codec name.
+constexpr const char* HARDWARE_ENCODER_SUFFIXES[] = {"nvenc", "amf", "qsv", "vaapi",
+                                                     "videotoolbox"};
+
+static bool IsHardwareEncoder(const AVCodec* codec)
+{
+#if defined(AV_CODEC_CAP_HARDWARE)
+  return (codec->capabilities & AV_CODEC_CAP_HARDWARE) != 0;
+#else
+  return false;
+#endif
+}
+
+static bool IsHardwarePixelFormat(AVPixelFormat format)
+{
+  const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(format);
+  return desc && (desc->flags & AV_PIX_FMT_FLAG_HWACCEL);
+}
+
+static AVPixelFormat ChooseEncoderPixelFormat(const AVCodec* codec)
+{
+  if (g_Config.bUseFFV1)
+    return AV_PIX_FMT_BGR0;
+  if (!codec->pix_fmts)
+    return AV_PIX_FMT_YUV420P;
+
+  // NV12 is what the GPU converts frames to, so it needs no conversion pass at all.
+  for (const AVPixelFormat preferred : {AV_PIX_FMT_NV12, AV_PIX_FMT_YUV420P})
+  {
+    for (const AVPixelFormat* format = codec->pix_fmts; *format != AV_PIX_FMT_NONE; format++)
+    {
+      if (*format == preferred)
+        return preferred;
+    }
+  }
+
+  return codec->pix_fmts[0];
+}
+
+// Encoders that only take hardware frames (e.g. VAAPI) need a device and a frame pool to upload
+// the NV12 frames to.
+static bool CreateHardwareFrames(AVPixelFormat hw_format)
+{
+#if LIBAVUTIL_VERSION_MAJOR >= 56
+  const AVHWDeviceType device_type = av_hwdevice_find_type_by_name(av_get_pix_fmt_name(hw_format));
+  if (device_type == AV_HWDEVICE_TYPE_NONE ||
+      av_hwdevice_ctx_create(&s_hw_device_context, device_type, nullptr, nullptr, 0) < 0)
+  {
+    return false;
+  }
+
+  AVBufferRef* frames_ref = av_hwframe_ctx_alloc(s_hw_device_context);
+  if (!frames_ref)
+    return false;
+
+  AVHWFramesContext* frames_context = reinterpret_cast<AVHWFramesContext*>(frames_ref->data);
+  frames_context->format = hw_format;
+  frames_context->sw_format = AV_PIX_FMT_NV12;
+  frames_context->width = s_width;
+  frames_context->height = s_height;
+  frames_context->initial_pool_size = 8;
+  if (av_hwframe_ctx_init(frames_ref) < 0)
+  {
+    av_buffer_unref(&frames_ref);
+    return false;
+  }
+
+  s_codec_context->hw_frames_ctx = frames_ref;
+  s_sw_pix_fmt = AV_PIX_FMT_NV12;
+  return true;
+#else
+  return false;
+#endif
+}
+
+static bool OpenEncoder(const AVCodec* codec, const AVOutputFormat* output_format)
+{
+  s_codec_context = avcodec_alloc_context3(codec);
+  if (!s_codec_context)
+    return false;
+
+  // Force XVID FourCC for better compatibility when using H.263
+  if (codec->id == AV_CODEC_ID_MPEG4)
+    s_codec_context->codec_tag = MKTAG('X', 'V', 'I', 'D');
+
+  s_codec_context->codec_type = AVMEDIA_TYPE_VIDEO;
+  s_codec_context->bit_rate = g_Config.iBitrateKbps * 1000;
+  s_codec_context->width = s_width;
+  s_codec_context->height = s_height;
+  s_codec_context->time_base.num = 1;
+  s_codec_context->time_base.den = VideoInterface::GetTargetRefreshRate();
+  s_codec_context->gop_size = 1;
+  // Hardware encoders reject levels too low for the resolution instead of ignoring them.
+  if (!IsHardwareEncoder(codec))
+    s_codec_context->level = 1;
+  s_codec_context->pix_fmt = ChooseEncoderPixelFormat(codec);
+  s_sw_pix_fmt = s_codec_context->pix_fmt;
+
+  if (IsHardwarePixelFormat(s_codec_context->pix_fmt) &&
+      !CreateHardwareFrames(s_codec_context->pix_fmt))
+  {
+    return false;
+  }
+
+  if (output_format->flags & AVFMT_GLOBALHEADER)
+    s_codec_context->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+
+  return avcodec_open2(s_codec_context, codec, nullptr) >= 0;
+}
+
+static void CloseEncoder()
+{
+  avcodec_free_context(&s_codec_context);
+  av_buffer_unref(&s_hw_device_context);
+}
+
 static std::string GetDumpPath(const std::string& format)
 {
   if (!g_Config.sDumpPath.empty())
@@ -151,6 +275,7 @@ bool FrameDump::CreateVideoFile()
   }
 
   const std::string& codec_name = g_Config.bUseFFV1 ? "ffv1" : g_Config.sDumpCodec;
+  const bool use_hardware_encoder = g_Config.bDumpHardwareEncoder && !g_Config.bUseFFV1;
 
   AVCodecID codec_id = output_format->video_codec;
 
@@ -162,52 +287,61 @@ bool FrameDump::CreateVideoFile()
     else
       WARN_LOG(VIDEO, "Invalid codec %s", codec_name.c_str());
   }
+  else if (use_hardware_encoder)
+  {
+    // The container defaults (e.g. MPEG-4 part 2 for AVI) have no hardware encoders.
+    codec_id = AV_CODEC_ID_H264;
+  }
 
-  const AVCodec* codec = nullptr;
-
+  // The encoders are tried in order, falling back to the software encoder for the codec.
+  std::vector<const AVCodec*> encoders;
   if (!g_Config.sDumpEncoder.empty())
   {
-    codec = avcodec_find_encoder_by_name(g_Config.sDumpEncoder.c_str());
-    if (!codec)
+    const AVCodec* codec = avcodec_find_encoder_by_name(g_Config.sDumpEncoder.c_str());
+    if (codec)
+      encoders.push_back(codec);
+    else
       WARN_LOG(VIDEO, "Invalid encoder %s", g_Config.sDumpEncoder.c_str());
   }
-  if (!codec)
-    codec = avcodec_find_encoder(codec_id);
-
-  s_codec_context = avcodec_alloc_context3(codec);
-  if (!codec || !s_codec_context)
+  else if (use_hardware_encoder)
   {
-    ERROR_LOG(VIDEO, "Could not find encoder or allocate codec context");
-    return false;
+    for (const char* suffix : HARDWARE_ENCODER_SUFFIXES)
+    {
+      const std::string name = fmt::format("{}_{}", avcodec_get_name(codec_id), suffix);
+      const AVCodec* codec = avcodec_find_encoder_by_name(name.c_str());
+      if (codec)
+        encoders.push_back(codec);
+    }
   }
+  if (const AVCodec* codec = avcodec_find_encoder(codec_id))
+    encoders.push_back(codec);
 
-  // Force XVID FourCC for better compatibility when using H.263
-  if (codec->id == AV_CODEC_ID_MPEG4)
-    s_codec_context->codec_tag = MKTAG('X', 'V', 'I', 'D');
-
-  s_codec_context->codec_type = AVMEDIA_TYPE_VIDEO;
-  s_codec_context->bit_rate = g_Config.iBitrateKbps * 1000;
-  s_codec_context->width = s_width;
-  s_codec_context->height = s_height;
-  s_codec_context->time_base.num = 1;
-  s_codec_context->time_base.den = VideoInterface::GetTargetRefreshRate();
-  s_codec_context->gop_size = 1;
-  s_codec_context->level = 1;
-  s_codec_context->pix_fmt = g_Config.bUseFFV1 ? AV_PIX_FMT_BGR0 : AV_PIX_FMT_YUV420P;
+  const AVCodec* codec = nullptr;
+  for (const AVCodec* encoder : encoders)
+  {
+    if (OpenEncoder(encoder, output_format))
+    {
+      codec = encoder;
+      break;
+    }
 
-  if (output_format->flags & AVFMT_GLOBALHEADER)
-    s_codec_context->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+    WARN_LOG(VIDEO, "Could not open encoder %s", encoder->name);
+    CloseEncoder();
+  }
 
-  if (avcodec_open2(s_codec_context, codec, nullptr) < 0)
+  if (!codec)
   {
-    ERROR_LOG(VIDEO, "Could not open codec");
+    ERROR_LOG(VIDEO, "Could not find or open an encoder");
     return false;
   }
 
+  NOTICE_LOG(VIDEO, "Encoding frame dump with %s", codec->name);
+
   s_src_frame = av_frame_alloc();
   s_scaled_frame = av_frame_alloc();
+  s_hw_frame = av_frame_alloc();
 
-  s_scaled_frame->format = s_codec_context->pix_fmt;
+  s_scaled_frame->format = s_sw_pix_fmt;
   s_scaled_frame->width = s_width;
   s_scaled_frame->height = s_height;
 
@@ -235,6 +369,7 @@ bool FrameDump::CreateVideoFile()
   }
 
   OSD::AddMessage(fmt::format("Dumping Frames to \"{}\" ({}x{})", dump_path, s_width, s_height));
+  s_wants_nv12 = s_sw_pix_fmt == AV_PIX_FMT_NV12 || s_sw_pix_fmt == AV_PIX_FMT_YUV420P;
   return true;
 }
 
@@ -254,7 +389,7 @@ static int ReceivePacket(AVCodecContext* avctx, AVPacket* pkt, int* got_packet)
   int error = avcodec_receive_packet(avctx, pkt);
   if (!error)
     *got_packet = 1;
-  if (error == AVERROR(EAGAIN))
+  if (error == AVERROR(EAGAIN) || error == AVERROR_EOF)
     return 0;
 
   return error;
@@ -295,7 +430,29 @@ static void WritePacket(AVPacket& pkt)
   av_interleaved_write_frame(s_format_context, &pkt);
 }
 
-void FrameDump::AddFrame(const u8* data, int width, int height, int stride, const Frame& state)
+static int SendFrame(AVFrame* frame, AVPacket* pkt, int* got_packet)
+{
+#if LIBAVUTIL_VERSION_MAJOR >= 56
+  if (s_codec_context->hw_frames_ctx)
+  {
+    int error = av_hwframe_get_buffer(s_codec_context->hw_frames_ctx, s_hw_frame, 0);
+    if (!error)
+      error = av_hwframe_transfer_data(s_hw_frame, frame, 0);
+    if (!error)
+    {
+      s_hw_frame->pts = frame->pts;
+      error = SendFrameAndReceivePacket(s_codec_context, pkt, s_hw_frame, got_packet);
+    }
+    av_frame_unref(s_hw_frame);
+    return error;
+  }
+#endif
+
+  return SendFrameAndReceivePacket(s_codec_context, pkt, frame, got_packet);
+}
+
+void FrameDump::AddFrame(const u8* data, int width, int height, int stride, PixelFormat format,
+                         const Frame& state)
 {
   // Assume that the timing is valid, if the savestate id of the new frame
   // doesn't match the last one.
@@ -306,20 +463,37 @@ void FrameDump::AddFrame(const u8* data, int width, int height, int stride, cons
   }
 
   CheckResolution(width, height);
+  const AVPixelFormat src_pix_fmt = format == PixelFormat::NV12 ? AV_PIX_FMT_NV12 : AV_PIX_FMT_RGBA;
   s_src_frame->data[0] = const_cast<u8*>(data);
   s_src_frame->linesize[0] = stride;
-  s_src_frame->format = s_pix_fmt;
+  s_src_frame->data[1] = nullptr;
+  s_src_frame->linesize[1] = 0;
+  if (format == PixelFormat::NV12)
+  {
+    s_src_frame->data[1] = s_src_frame->data[0] + stride * height;
+    s_src_frame->linesize[1] = stride;
+  }
+  s_src_frame->format = src_pix_fmt;
   s_src_frame->width = s_width;
   s_src_frame->height = s_height;
 
-  // Convert image from {BGR24, RGBA} to desired pixel format
-  s_sws_context =
-      sws_getCachedContext(s_sws_context, width, height, s_pix_fmt, s_width, s_height,
-                           s_codec_context->pix_fmt, SWS_BICUBIC, nullptr, nullptr, nullptr);
-  if (s_sws_context)
+  // Frames the GPU already converted to the encoder's format are passed through as they are.
+  AVFrame* frame = s_scaled_frame;
+  if (src_pix_fmt == s_sw_pix_fmt && width == s_width && height == s_height)
   {
-    sws_scale(s_sws_context, s_src_frame->data, s_src_frame->linesize, 0, height,
-              s_scaled_frame->data, s_scaled_frame->linesize);
+    frame = s_src_frame;
+  }
+  else
+  {
+    // Convert image from {RGBA, NV12} to desired pixel format
+    s_sws_context =
+        sws_getCachedContext(s_sws_context, width, height, src_pix_fmt, s_width, s_height,
+                             s_sw_pix_fmt, SWS_BICUBIC, nullptr, nullptr, nullptr);
+    if (s_sws_context)
+    {
+      sws_scale(s_sws_context, s_src_frame->data, s_src_frame->linesize, 0, height,
+                s_scaled_frame->data, s_scaled_frame->linesize);
+    }
   }
 
   // Encode and write the image.
@@ -349,12 +523,12 @@ void FrameDump::AddFrame(const u8* data, int width, int height, int stride, cons
     last_pts = (s_last_pts * s_codec_context->time_base.den) / state.ticks_per_second;
   }
   u64 pts_in_ticks = s_last_pts + delta;
-  s_scaled_frame->pts = (pts_in_ticks * s_codec_context->time_base.den) / state.ticks_per_second;
-  if (s_scaled_frame->pts != last_pts)
+  frame->pts = (pts_in_ticks * s_codec_context->time_base.den) / state.ticks_per_second;
+  if (frame->pts != last_pts)
   {
     s_last_frame = state.ticks;
     s_last_pts = pts_in_ticks;
-    error = SendFrameAndReceivePacket(s_codec_context, &pkt, s_scaled_frame, &got_packet);
+    error = SendFrame(frame, &pkt, &got_packet);
   }
   if (!error && got_packet)
   {
@@ -368,6 +542,11 @@ static void HandleDelayedPackets()
 {
   AVPacket pkt;
 
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57, 37, 100)
+  // Hardware encoders hold on to several frames, enter draining mode to get them back.
+  avcodec_send_frame(s_codec_context, nullptr);
+#endif
+
   while (true)
   {
     PreparePacket(&pkt);
@@ -399,10 +578,12 @@ void FrameDump::Stop()
 
 void FrameDump::CloseVideoFile()
 {
+  s_wants_nv12 = false;
   av_frame_free(&s_src_frame);
   av_frame_free(&s_scaled_frame);
+  av_frame_free(&s_hw_frame);
 
-  avcodec_free_context(&s_codec_context);
+  CloseEncoder();
 
   if (s_format_context)
   {
@@ -439,6 +620,11 @@ void FrameDump::CheckResolution(int width, int height)
   }
 }
 
+bool FrameDump::WantsNV12Frames()
+{
+  return s_wants_nv12;
+}
+
 FrameDump::Frame FrameDump::FetchState(u64 ticks)
 {
   Frame state;
@@ -14,6 +14,14 @@ private:
   static void CheckResolution(int width, int height);
 
 public:
+  // Layout of the frame data handed to AddFrame. NV12 frames are converted on the GPU, and can
+  // usually be passed to the encoder without a scaling pass.
+  enum class PixelFormat
+  {
+    RGBA8,
+    NV12
+  };
+
   struct Frame
   {
     u64 ticks = 0;
@@ -23,13 +31,19 @@ public:
   };
 
   static bool Start(int w, int h);
-  static void AddFrame(const u8* data, int width, int height, int stride, const Frame& state);
+  // NV12 frames have the luma plane followed by the chroma plane, both with the given stride.
+  static void AddFrame(const u8* data, int width, int height, int stride, PixelFormat format,
+                       const Frame& state);
   static void Stop();
   static void DoState();
 
 #if defined(HAVE_FFMPEG)
   static Frame FetchState(u64 ticks);
+  // Whether the open encoder takes 4:2:0 frames, so the GPU should convert them to NV12 first.
+  // Safe to call from any thread.
+  static bool WantsNV12Frames();
 #else
   static Frame FetchState(u64 ticks) { return {}; }
+  static bool WantsNV12Frames() { return false; }
 #endif
 };
@@ -0,0 +1,259 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/FrameProfiler.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <fstream>
+#include <iomanip>
+#include <string>
+
+#include <imgui.h>
+
+#include "Common/FileUtil.h"
+#include "Common/Timer.h"
+#include "Core/ConfigManager.h"
+#include "VideoCommon/VideoConfig.h"
+
+namespace FrameProfiler
+{
+namespace
+{
+constexpr size_t NUM_CATEGORIES = static_cast<size_t>(Category::Count);
+
+// Frames kept for the overlay's graph and its averages, about four seconds at 60 FPS.
+constexpr size_t HISTORY_SIZE = 240;
+
+// The export rolls over to a second file after this many frames, so a long session keeps at most
+// twice this many on disk.
+constexpr u32 MAX_CSV_ROWS = 60 * 60 * 10;
+constexpr u32 CSV_FLUSH_INTERVAL = 60;
+
+struct FrameSample
+{
+  u64 frame_us;
+  u64 cpu_thread_us;
+  u64 gpu_thread_us;
+  std::array<u64, NUM_CATEGORIES> category_us;
+};
+
+std::atomic<bool> s_enabled{false};
+std::array<std::atomic<u64>, NUM_CATEGORIES> s_accumulated_us{};
+
+std::array<FrameSample, HISTORY_SIZE> s_history{};
+size_t s_history_count = 0;
+size_t s_next_history_sample = 0;
+
+std::ofstream s_csv_file;
+u64 s_csv_start_us = 0;
+u64 s_csv_frame = 0;
+u32 s_csv_rows = 0;
+
+std::string GetCSVPath()
+{
+  return File::GetUserPath(D_LOGS_IDX) + "FrameProfile.csv";
+}
+
+u64 GetCategoryTime(const FrameSample& sample, Category category)
+{
+  return sample.category_us[static_cast<size_t>(category)];
+}
+
+void WriteCSVRow(const FrameSample& sample)
+{
+  if (s_csv_file.is_open() && s_csv_rows >= MAX_CSV_ROWS)
+  {
+    s_csv_file.close();
+    File::Rename(GetCSVPath(), File::GetUserPath(D_LOGS_IDX) + "FrameProfile.1.csv");
+  }
+
+  if (!s_csv_file.is_open())
+  {
+    File::OpenFStream(s_csv_file, GetCSVPath(), std::ios_base::out | std::ios_base::trunc);
+    if (!s_csv_file.is_open())
+      return;
+
+    if (s_csv_start_us == 0)
+      s_csv_start_us = Common::Timer::GetTimeUs();
+    s_csv_rows = 0;
+    s_csv_file << "frame,time_s,frame_ms,cpu_thread_ms,gpu_thread_ms,sync_gpu_ms,"
+                  "texture_decode_ms,shader_compile_ms,efb_stall_ms,swap_wait_ms\n";
+    s_csv_file << std::fixed << std::setprecision(3);
+  }
+
+  const auto ms = [](u64 time_us) { return time_us / 1000.0; };
+  s_csv_file << s_csv_frame << ',' << (Common::Timer::GetTimeUs() - s_csv_start_us) / 1000000.0
+             << ',' << ms(sample.frame_us) << ',' << ms(sample.cpu_thread_us) << ','
+             << ms(sample.gpu_thread_us) << ',' << ms(GetCategoryTime(sample, Category::SyncGPU))
+             << ',' << ms(GetCategoryTime(sample, Category::TextureDecode)) << ','
+             << ms(GetCategoryTime(sample, Category::ShaderCompile)) << ','
+             << ms(GetCategoryTime(sample, Category::EFBStall)) << ','
+             << ms(GetCategoryTime(sample, Category::SwapWait)) << '\n';
+
+  s_csv_frame++;
+  if (++s_csv_rows % CSV_FLUSH_INTERVAL == 0)
+    s_csv_file.flush();
+}
+}  // Anonymous namespace
+
+bool IsEnabled()
+{
+  return s_enabled.load(std::memory_order_relaxed);
+}
+
+void SetEnabled(bool enabled)
+{
+  if (enabled == IsEnabled())
+    return;
+
+  // Don't attribute time from before the profiler was turned on to the first frame.
+  for (std::atomic<u64>& accumulated : s_accumulated_us)
+    accumulated.store(0, std::memory_order_relaxed);
+  s_history_count = 0;
+  s_next_history_sample = 0;
+  s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void AddTime(Category category, u64 time_us)
+{
+  if (IsEnabled())
+    s_accumulated_us[static_cast<size_t>(category)].fetch_add(time_us, std::memory_order_relaxed);
+}
+
+ScopedTimer::ScopedTimer(Category category)
+    : m_category(category), m_start_us(IsEnabled() ? Common::Timer::GetTimeUs() : 0)
+{
+}
+
+ScopedTimer::~ScopedTimer()
+{
+  if (m_start_us != 0)
+    AddTime(m_category, Common::Timer::GetTimeUs() - m_start_us);
+}
+
+void EndFrame(u64 frame_time_us)
+{
+  if (!IsEnabled())
+    return;
+
+  FrameSample sample;
+  sample.frame_us = frame_time_us;
+  for (size_t i = 0; i < NUM_CATEGORIES; i++)
+    sample.category_us[i] = s_accumulated_us[i].exchange(0, std::memory_order_relaxed);
+
+  // Waiting on the GPU is still time the CPU thread can't emulate, so only sleeping is excluded.
+  const u64 cpu_idle_us = GetCategoryTime(sample, Category::CPUThreadIdle);
+  sample.cpu_thread_us = frame_time_us - std::min(cpu_idle_us, frame_time_us);
+
+  // In single core mode, the GPU work runs on the CPU thread and is part of its time.
+  if (SConfig::GetInstance().bCPUThread)
+  {
+    const u64 gpu_idle_us = GetCategoryTime(sample, Category::GPUThreadIdle) +
+                            GetCategoryTime(sample, Category::SwapWait);
+    sample.gpu_thread_us = frame_time_us - std::min(gpu_idle_us, frame_time_us);
+  }
+  else
+  {
+    sample.gpu_thread_us = 0;
+  }
+
+  s_history[s_next_history_sample] = sample;
+  s_next_history_sample = (s_next_history_sample + 1) % HISTORY_SIZE;
+  s_history_count = std::min(s_history_count + 1, HISTORY_SIZE);
+
+  if (g_ActiveConfig.bExportProfilerCSV)
+    WriteCSVRow(sample);
+  else if (s_csv_file.is_open())
+    s_csv_file.close();
+}
+
+void Display()
+{
+  if (s_history_count == 0)
+    return;
+
+  const float scale = ImGui::GetIO().DisplayFramebufferScale.x;
+  ImGui::SetNextWindowPos(ImVec2(10.0f * scale, 420.0f * scale), ImGuiCond_FirstUseEver);
+  ImGui::SetNextWindowSize(ImVec2(360.0f * scale, 0.0f), ImGuiCond_FirstUseEver);
+  if (!ImGui::Begin("Frame Profiler", nullptr, ImGuiWindowFlags_NoNavInputs))
+  {
+    ImGui::End();
+    return;
+  }
+
+  // Oldest sample first, so the graph scrolls to the left.
+  const size_t first_sample = (s_next_history_sample + HISTORY_SIZE - s_history_count) %
+                              HISTORY_SIZE;
+  const auto get_sample = [first_sample](size_t i) -> const FrameSample& {
+    return s_history[(first_sample + i) % HISTORY_SIZE];
+  };
+
+  std::array<float, HISTORY_SIZE> frame_times;
+  for (size_t i = 0; i < s_history_count; i++)
+    frame_times[i] = get_sample(i).frame_us / 1000.0f;
+  ImGui::PlotLines("##FrameTimes", frame_times.data(), static_cast<int>(s_history_count), 0,
+                   "Frame time (ms)", 0.0f, 50.0f, ImVec2(0.0f, 60.0f * scale));
+
+  ImGui::Columns(4, "FrameProfiler", true);
+  ImGui::TextUnformatted("ms");
+  ImGui::NextColumn();
+  ImGui::TextUnformatted("Last");
+  ImGui::NextColumn();
+  ImGui::TextUnformatted("Average");
+  ImGui::NextColumn();
+  ImGui::TextUnformatted("Max");
+  ImGui::NextColumn();
+  ImGui::Separator();
+
+  const auto draw_timing = [&](const char* name, auto&& get_time_us) {
+    u64 total_us = 0;
+    u64 max_us = 0;
+    for (size_t i = 0; i < s_history_count; i++)
+    {
+      const u64 time_us = get_time_us(get_sample(i));
+      total_us += time_us;
+      max_us = std::max(max_us, time_us);
+    }
+
+    ImGui::TextUnformatted(name);
+    ImGui::NextColumn();
+    ImGui::Text("%.2f", get_time_us(get_sample(s_history_count - 1)) / 1000.0);
+    ImGui::NextColumn();
+    ImGui::Text("%.2f", total_us / 1000.0 / s_history_count);
+    ImGui::NextColumn();
+    ImGui::Text("%.2f", max_us / 1000.0);
+    ImGui::NextColumn();
+  };
+  const auto draw_category = [&](const char* name, Category category) {
+    draw_timing(name, [category](const FrameSample& sample) {
+      return GetCategoryTime(sample, category);
+    });
+  };
+
+  draw_timing("Frame", [](const FrameSample& sample) { return sample.frame_us; });
+  draw_timing("CPU thread", [](const FrameSample& sample) { return sample.cpu_thread_us; });
+  if (SConfig::GetInstance().bCPUThread)
+    draw_timing("GPU thread", [](const FrameSample& sample) { return sample.gpu_thread_us; });
+  draw_category("SyncGPU", Category::SyncGPU);
+  draw_category("Texture decode", Category::TextureDecode);
+  draw_category("Shader compile", Category::ShaderCompile);
+  draw_category("EFB copy/peek", Category::EFBStall);
+  draw_category("Swap wait", Category::SwapWait);
+
+  ImGui::Columns(1);
+  ImGui::End();
+}
+
+void Shutdown()
+{
+  SetEnabled(false);
+  if (s_csv_file.is_open())
+    s_csv_file.close();
+  s_csv_start_us = 0;
+  s_csv_frame = 0;
+}
+}  // namespace FrameProfiler
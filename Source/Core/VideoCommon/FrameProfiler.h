@@ -0,0 +1,61 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+// Breaks each presented frame down into where the time went, for the profiler overlay and the
+// CSV export. Time is accumulated from the CPU and GPU threads as it is spent, and is attributed
+// to the frame that is being presented when Renderer::Swap calls EndFrame().
+namespace FrameProfiler
+{
+enum class Category : u32
+{
+  // Time the CPU thread spent sleeping in the throttler or the frame pacer.
+  CPUThreadIdle,
+  // Time the GPU thread spent waiting for work, as measured by the FIFO loop.
+  GPUThreadIdle,
+  // Time the CPU thread was blocked waiting for the GPU thread to catch up.
+  SyncGPU,
+  // Texture decoding and uploads on a texture cache miss.
+  TextureDecode,
+  // Pipelines that had to be compiled before a draw could be issued.
+  ShaderCompile,
+  // Waiting for EFB copies to RAM and EFB peeks to be read back from the host GPU.
+  EFBStall,
+  // Time spent presenting to the window system, including waiting for vsync.
+  SwapWait,
+  Count
+};
+
+// Set from the GPU thread at the end of every frame, so that the timers are free when neither the
+// overlay nor the export is enabled.
+bool IsEnabled();
+void SetEnabled(bool enabled);
+
+// Safe to call from any thread.
+void AddTime(Category category, u64 time_us);
+
+class ScopedTimer
+{
+public:
+  explicit ScopedTimer(Category category);
+  ~ScopedTimer();
+
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+  Category m_category;
+  u64 m_start_us;
+};
+
+// The remaining functions must only be called from the GPU thread.
+
+// Closes the current frame, which took frame_time_us to present since the previous one.
+void EndFrame(u64 frame_time_us);
+void Display();
+void Shutdown();
+}  // namespace FrameProfiler
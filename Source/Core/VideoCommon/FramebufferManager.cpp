@@ -4,6 +4,7 @@
 
 #include "VideoCommon/FramebufferManager.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "Common/ChunkFile.h"
@@ -16,6 +17,7 @@
 #include "VideoCommon/AbstractStagingTexture.h"
 #include "VideoCommon/AbstractTexture.h"
 #include "VideoCommon/DriverDetails.h"
+#include "VideoCommon/FrameProfiler.h"
 #include "VideoCommon/FramebufferShaderGen.h"
 #include "VideoCommon/RenderBase.h"
 #include "VideoCommon/VertexManagerBase.h"
@@ -87,8 +89,13 @@ void FramebufferManager::RecreateEFBFramebuffer()
   InvalidatePeekCache(true);
 
   DestroyReadbackFramebuffer();
+  if (g_ActiveConfig.bDynamicResolution)
+    PoolEFBFramebuffer();
+  else
+    m_efb_texture_pool.clear();
   DestroyEFBFramebuffer();
-  if (!CreateEFBFramebuffer() || !CreateReadbackFramebuffer())
+
+  if (!(RestorePooledEFBFramebuffer() || CreateEFBFramebuffer()) || !CreateReadbackFramebuffer())
     PanicAlert("Failed to recreate EFB framebuffer");
 }
 
@@ -229,11 +236,95 @@ void FramebufferManager::DestroyEFBFramebuffer()
   m_efb_depth_resolve_texture.reset();
 }
 
+void FramebufferManager::PoolEFBFramebuffer()
+{
+  if (!m_efb_framebuffer)
+    return;
+
+  EFBTextureSet set;
+  set.color_texture = std::move(m_efb_color_texture);
+  set.convert_color_texture = std::move(m_efb_convert_color_texture);
+  set.depth_texture = std::move(m_efb_depth_texture);
+  set.resolve_color_texture = std::move(m_efb_resolve_color_texture);
+  set.depth_resolve_texture = std::move(m_efb_depth_resolve_texture);
+  set.framebuffer = std::move(m_efb_framebuffer);
+  set.convert_framebuffer = std::move(m_efb_convert_framebuffer);
+  set.depth_resolve_framebuffer = std::move(m_efb_depth_resolve_framebuffer);
+
+  m_efb_texture_pool.insert(m_efb_texture_pool.begin(), std::move(set));
+  if (m_efb_texture_pool.size() > MAX_POOLED_EFB_TEXTURE_SETS)
+    m_efb_texture_pool.pop_back();
+}
+
+bool FramebufferManager::RestorePooledEFBFramebuffer()
+{
+  const TextureConfig color_config = GetEFBColorTextureConfig();
+  const TextureConfig depth_config = GetEFBDepthTextureConfig();
+  const auto iter = std::find_if(
+      m_efb_texture_pool.begin(), m_efb_texture_pool.end(), [&](const EFBTextureSet& set) {
+        return set.color_texture->GetConfig() == color_config &&
+               set.depth_texture->GetConfig() == depth_config;
+      });
+  if (iter == m_efb_texture_pool.end())
+    return false;
+
+  m_efb_color_texture = std::move(iter->color_texture);
+  m_efb_convert_color_texture = std::move(iter->convert_color_texture);
+  m_efb_depth_texture = std::move(iter->depth_texture);
+  m_efb_resolve_color_texture = std::move(iter->resolve_color_texture);
+  m_efb_depth_resolve_texture = std::move(iter->depth_resolve_texture);
+  m_efb_framebuffer = std::move(iter->framebuffer);
+  m_efb_convert_framebuffer = std::move(iter->convert_framebuffer);
+  m_efb_depth_resolve_framebuffer = std::move(iter->depth_resolve_framebuffer);
+  m_efb_texture_pool.erase(iter);
+
+  // The contents are from an older frame, so start out cleared like a new EFB.
+  g_renderer->SetAndClearFramebuffer(
+      m_efb_framebuffer.get(), {{0.0f, 0.0f, 0.0f, 0.0f}},
+      g_ActiveConfig.backend_info.bSupportsReversedDepthRange ? 1.0f : 0.0f);
+  return true;
+}
+
 void FramebufferManager::BindEFBFramebuffer()
 {
   g_renderer->SetFramebuffer(m_efb_framebuffer.get());
 }
 
+// Most games copy from a handful of regions at most between draws
+constexpr size_t MAX_RESOLVED_EFB_REGIONS = 8;
+
+// Returns true if the region is already covered by one that was resolved, and records it as
+// resolved otherwise.
+static bool TrackResolvedRegion(std::vector<MathUtil::Rectangle<int>>* regions,
+                                const MathUtil::Rectangle<int>& region)
+{
+  const auto contains = [](const MathUtil::Rectangle<int>& outer,
+                           const MathUtil::Rectangle<int>& inner) {
+    return outer.left <= inner.left && outer.top <= inner.top && outer.right >= inner.right &&
+           outer.bottom >= inner.bottom;
+  };
+
+  if (std::any_of(regions->begin(), regions->end(),
+                  [&](const auto& resolved) { return contains(resolved, region); }))
+  {
+    return true;
+  }
+
+  regions->erase(std::remove_if(regions->begin(), regions->end(),
+                                [&](const auto& resolved) { return contains(region, resolved); }),
+                 regions->end());
+  if (regions->size() == MAX_RESOLVED_EFB_REGIONS)
+    regions->erase(regions->begin());
+  regions->push_back(region);
+  return false;
+}
+
+void FramebufferManager::InvalidateEFBResolves()
+{
+  m_efb_resolved_color_regions.clear();
+  m_efb_resolved_depth_regions.clear();
+}
+
 AbstractTexture* FramebufferManager::ResolveEFBColorTexture(const MathUtil::Rectangle<int>& region)
 {
   // Return the normal EFB texture if multisampling is off.
@@ -244,6 +335,9 @@ AbstractTexture* FramebufferManager::ResolveEFBColorTexture(const MathUtil::Rect
   MathUtil::Rectangle<int> clamped_region = region;
   clamped_region.ClampUL(0, 0, GetEFBWidth(), GetEFBHeight());
 
+  if (TrackResolvedRegion(&m_efb_resolved_color_regions, clamped_region))
+    return m_efb_resolve_color_texture.get();
+
   // Resolve to our already-created texture.
   for (u32 layer = 0; layer < GetEFBLayers(); layer++)
   {
@@ -268,6 +362,9 @@ AbstractTexture* FramebufferManager::ResolveEFBDepthTexture(const MathUtil::Rect
   MathUtil::Rectangle<int> clamped_region = region;
   clamped_region.ClampUL(0, 0, GetEFBWidth(), GetEFBHeight());
 
+  if (TrackResolvedRegion(&m_efb_resolved_depth_regions, clamped_region))
+    return m_efb_depth_resolve_texture.get();
+
   m_efb_depth_texture->FinishedRendering();
   g_renderer->BeginUtilityDrawing();
   g_renderer->SetAndDiscardFramebuffer(m_efb_depth_resolve_framebuffer.get());
@@ -282,11 +379,24 @@ AbstractTexture* FramebufferManager::ResolveEFBDepthTexture(const MathUtil::Rect
   return m_efb_depth_resolve_texture.get();
 }
 
+// Only the conversions between RGB8 and RGBA6 change the color. The ones from or to RGB565 pass it
+// through as it is, see GenerateFormatConversionShader.
+static bool IsPassthroughReinterpret(EFBReinterpretType convtype)
+{
+  return convtype != EFBReinterpretType::RGB8ToRGBA6 &&
+         convtype != EFBReinterpretType::RGBA6ToRGB8;
+}
+
 bool FramebufferManager::ReinterpretPixelData(EFBReinterpretType convtype)
 {
   if (!m_format_conversion_pipelines[static_cast<u32>(convtype)])
     return false;
 
+  // A passthrough leaves every sample as it was, unless it has to average them because there's no
+  // sample shading. The peek cache holds the raw colors, so it stays valid too.
+  if (IsPassthroughReinterpret(convtype) && (GetEFBSamples() == 1 || g_ActiveConfig.bSSAA))
+    return true;
+
   // Draw to the secondary framebuffer.
   // We don't discard here because discarding the framebuffer also throws away the depth
   // buffer, which we want to preserve. If we find this to be hindering performance in the
@@ -384,6 +494,8 @@ u32 FramebufferManager::PeekEFBColor(u32 x, u32 y)
   u32 tile_index;
   if (!IsEFBCacheTilePresent(false, x, y, &tile_index))
     PopulateEFBCache(false, tile_index);
+  FinishEFBCacheReadback(m_efb_color_cache);
+  m_efb_color_cache.accessed_tiles[tile_index] = true;
 
   u32 value;
   m_efb_color_cache.readback_texture->ReadTexel(x, y, &value);
@@ -399,6 +511,8 @@ float FramebufferManager::PeekEFBDepth(u32 x, u32 y)
   u32 tile_index;
   if (!IsEFBCacheTilePresent(true, x, y, &tile_index))
     PopulateEFBCache(true, tile_index);
+  FinishEFBCacheReadback(m_efb_depth_cache);
+  m_efb_depth_cache.accessed_tiles[tile_index] = true;
 
   float value;
   m_efb_depth_cache.readback_texture->ReadTexel(x, y, &value);
@@ -419,6 +533,10 @@ void FramebufferManager::SetEFBCacheTileSize(u32 size)
 
 void FramebufferManager::InvalidatePeekCache(bool forced)
 {
+  // Forced invalidations come from the EFB being replaced or rewritten
+  if (forced)
+    InvalidateEFBResolves();
+
   if (forced || m_efb_color_cache.out_of_date)
   {
     if (m_efb_color_cache.valid)
@@ -435,10 +553,30 @@ void FramebufferManager::InvalidatePeekCache(bool forced)
     m_efb_depth_cache.valid = false;
     m_efb_depth_cache.out_of_date = false;
   }
+
+  // Unforced invalidations come from the game syncing with the GPU, which is usually right before
+  // it peeks. Start reading back what it peeked last time, so the peeks don't have to wait.
+  if (!forced && g_ActiveConfig.bEFBAccessPrefetch)
+  {
+    PrefetchEFBCache(false);
+    PrefetchEFBCache(true);
+  }
+}
+
+void FramebufferManager::OnEndFrame()
+{
+  auto EndFrame = [](EFBCacheData& data) {
+    data.last_frame_accessed_tiles.swap(data.accessed_tiles);
+    std::fill(data.accessed_tiles.begin(), data.accessed_tiles.end(), false);
+  };
+  EndFrame(m_efb_color_cache);
+  EndFrame(m_efb_depth_cache);
 }
 
 void FramebufferManager::FlagPeekCacheAsOutOfDate()
 {
+  InvalidateEFBResolves();
+
   if (m_efb_color_cache.valid)
     m_efb_color_cache.out_of_date = true;
   if (m_efb_depth_cache.valid)
@@ -568,6 +706,14 @@ bool FramebufferManager::CreateReadbackFramebuffer()
     m_efb_cache_tiles_wide = tiles_wide;
   }
 
+  const size_t cache_entries = IsUsingTiledEFBCache() ? m_efb_color_cache.tiles.size() : 1;
+  for (EFBCacheData* data : {&m_efb_color_cache, &m_efb_depth_cache})
+  {
+    data->accessed_tiles.assign(cache_entries, false);
+    data->last_frame_accessed_tiles.assign(cache_entries, false);
+    data->readback_pending = false;
+  }
+
   return true;
 }
 
@@ -583,9 +729,11 @@ void FramebufferManager::DestroyReadbackFramebuffer()
   DestroyCache(m_efb_depth_cache);
 }
 
-void FramebufferManager::PopulateEFBCache(bool depth, u32 tile_index)
+void FramebufferManager::PopulateEFBCache(bool depth, u32 tile_index, bool wait)
 {
-  g_vertex_manager->OnCPUEFBAccess();
+  // Prefetches aren't waited on, so they don't need the command buffer to be submitted early
+  if (wait)
+    g_vertex_manager->OnCPUEFBAccess();
 
   // Force the path through the intermediate texture, as we can't do an image copy from a depth
   // buffer directly to a staging texture (must be the whole resource).
@@ -642,13 +790,55 @@ void FramebufferManager::PopulateEFBCache(bool depth, u32 tile_index)
   }
 
   // Wait until the copy is complete.
-  data.readback_texture->Flush();
+  if (wait)
+  {
+    FrameProfiler::ScopedTimer timer(FrameProfiler::Category::EFBStall);
+    data.readback_texture->Flush();
+  }
+  data.readback_pending = !wait;
   data.valid = true;
   data.out_of_date = false;
   if (IsUsingTiledEFBCache())
     data.tiles[tile_index] = true;
 }
 
+void FramebufferManager::PrefetchEFBCache(bool depth)
+{
+  EFBCacheData& data = depth ? m_efb_depth_cache : m_efb_color_cache;
+  if (!data.readback_texture)
+    return;
+
+  bool issued = false;
+  for (u32 i = 0; i < static_cast<u32>(data.accessed_tiles.size()); i++)
+  {
+    if (!data.accessed_tiles[i] && !data.last_frame_accessed_tiles[i])
+      continue;
+    if (data.valid && (!IsUsingTiledEFBCache() || data.tiles[i]))
+      continue;
+
+    // Pokes only update tiles that are already present, so draw them before copying
+    if (!issued)
+      FlushEFBPokes();
+
+    PopulateEFBCache(depth, i, false);
+    issued = true;
+  }
+
+  // Get the copies going now rather than when the first peek waits for them
+  if (issued)
+    g_renderer->Flush();
+}
+
+void FramebufferManager::FinishEFBCacheReadback(EFBCacheData& data)
+{
+  if (!data.readback_pending)
+    return;
+
+  FrameProfiler::ScopedTimer timer(FrameProfiler::Category::EFBStall);
+  data.readback_texture->Flush();
+  data.readback_pending = false;
+}
+
 void FramebufferManager::ClearEFB(const MathUtil::Rectangle<int>& rc, bool clear_color,
                                   bool clear_alpha, bool clear_z, u32 color, u32 z)
 {
@@ -750,7 +940,10 @@ void FramebufferManager::PokeEFBColor(u32 x, u32 y, u32 color)
   // Update the peek cache if it's valid, since we know the color of the pixel now.
   u32 tile_index;
   if (IsEFBCacheTilePresent(false, x, y, &tile_index))
+  {
+    FinishEFBCacheReadback(m_efb_color_cache);
     m_efb_color_cache.readback_texture->WriteTexel(x, y, &color);
+  }
 }
 
 void FramebufferManager::PokeEFBDepth(u32 x, u32 y, float depth)
@@ -768,7 +961,10 @@ void FramebufferManager::PokeEFBDepth(u32 x, u32 y, float depth)
   // Update the peek cache if it's valid, since we know the color of the pixel now.
   u32 tile_index;
   if (IsEFBCacheTilePresent(true, x, y, &tile_index))
+  {
+    FinishEFBCacheReadback(m_efb_depth_cache);
     m_efb_depth_cache.readback_texture->WriteTexel(x, y, &depth);
+  }
 }
 
 void FramebufferManager::CreatePokeVertices(std::vector<EFBPokeVertex>* destination_list, u32 x,
@@ -801,6 +997,9 @@ void FramebufferManager::CreatePokeVertices(std::vector<EFBPokeVertex>* destinat
 
 void FramebufferManager::FlushEFBPokes()
 {
+  if (!m_color_poke_vertices.empty() || !m_depth_poke_vertices.empty())
+    InvalidateEFBResolves();
+
   if (!m_color_poke_vertices.empty())
   {
     DrawPokeVertices(m_color_poke_vertices.data(), static_cast<u32>(m_color_poke_vertices.size()),
@@ -905,7 +1104,18 @@ void FramebufferManager::DoState(PointerWrap& p)
     DoLoadState(p);
 }
 
-void FramebufferManager::DoSaveState(PointerWrap& p)
+void FramebufferManager::QueueSaveStateReadbacks()
+{
+  if (!Config::Get(Config::GFX_SAVE_TEXTURE_CACHE_TO_STATE))
+    return;
+
+  FlushEFBPokes();
+  for (const auto& [texture, config] : GetSaveStateTextures())
+    g_texture_cache->QueueTextureReadback(texture, config);
+}
+
+std::array<std::pair<AbstractTexture*, TextureConfig>, 2>
+FramebufferManager::GetSaveStateTextures()
 {
   // For multisampling, we need to resolve first before we can save.
   // This won't be bit-exact when loading, which could cause interesting rendering side-effects for
@@ -917,12 +1127,16 @@ void FramebufferManager::DoSaveState(PointerWrap& p)
   const TextureConfig color_texture_config(color_texture->GetWidth(), color_texture->GetHeight(),
                                            color_texture->GetLevels(), color_texture->GetLayers(),
                                            1, GetEFBColorFormat(), 0);
-  g_texture_cache->SerializeTexture(color_texture, color_texture_config, p);
-
   const TextureConfig depth_texture_config(depth_texture->GetWidth(), depth_texture->GetHeight(),
                                            depth_texture->GetLevels(), depth_texture->GetLayers(),
                                            1, GetEFBDepthCopyFormat(), 0);
-  g_texture_cache->SerializeTexture(depth_texture, depth_texture_config, p);
+  return {{{color_texture, color_texture_config}, {depth_texture, depth_texture_config}}};
+}
+
+void FramebufferManager::DoSaveState(PointerWrap& p)
+{
+  for (const auto& [texture, config] : GetSaveStateTextures())
+    g_texture_cache->SerializeTexture(texture, config, p);
 }
 
 void FramebufferManager::DoLoadState(PointerWrap& p)
@@ -7,6 +7,8 @@
 #include <array>
 #include <memory>
 #include <optional>
+#include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "VideoCommon/AbstractFramebuffer.h"
@@ -92,6 +94,8 @@ public:
   void SetEFBCacheTileSize(u32 size);
   void InvalidatePeekCache(bool forced = true);
   void FlagPeekCacheAsOutOfDate();
+  // Remembers which tiles were peeked in the frame that just ended, for prefetching.
+  void OnEndFrame();
 
   // Writes a value to the framebuffer. This will never block, and writes will be batched.
   void PokeEFBColor(u32 x, u32 y, u32 color);
@@ -101,6 +105,9 @@ public:
   // Save state load/save.
   void DoState(PointerWrap& p);
 
+  // Starts reading back the EFB for the save state about to be written.
+  void QueueSaveStateReadbacks();
+
 protected:
   struct EFBPokeVertex
   {
@@ -118,12 +125,34 @@ protected:
     std::unique_ptr<AbstractStagingTexture> readback_texture;
     std::unique_ptr<AbstractPipeline> copy_pipeline;
     std::vector<bool> tiles;
+    // Tiles peeked in this and the previous frame, one entry if the cache isn't tiled
+    std::vector<bool> accessed_tiles;
+    std::vector<bool> last_frame_accessed_tiles;
+    // A prefetch copied into readback_texture without waiting for it
+    bool readback_pending;
     bool out_of_date;
     bool valid;
   };
 
+  // The EFB render targets. With dynamic resolution, the set for the previous scale is kept when
+  // the scale changes, so switching back to it doesn't have to allocate.
+  struct EFBTextureSet
+  {
+    std::unique_ptr<AbstractTexture> color_texture;
+    std::unique_ptr<AbstractTexture> convert_color_texture;
+    std::unique_ptr<AbstractTexture> depth_texture;
+    std::unique_ptr<AbstractTexture> resolve_color_texture;
+    std::unique_ptr<AbstractTexture> depth_resolve_texture;
+    std::unique_ptr<AbstractFramebuffer> framebuffer;
+    std::unique_ptr<AbstractFramebuffer> convert_framebuffer;
+    std::unique_ptr<AbstractFramebuffer> depth_resolve_framebuffer;
+  };
+  static constexpr size_t MAX_POOLED_EFB_TEXTURE_SETS = 2;
+
   bool CreateEFBFramebuffer();
   void DestroyEFBFramebuffer();
+  void PoolEFBFramebuffer();
+  bool RestorePooledEFBFramebuffer();
 
   bool CompileConversionPipelines();
   void DestroyConversionPipelines();
@@ -143,7 +172,9 @@ protected:
   bool IsUsingTiledEFBCache() const;
   bool IsEFBCacheTilePresent(bool depth, u32 x, u32 y, u32* tile_index) const;
   MathUtil::Rectangle<int> GetEFBCacheTileRect(u32 tile_index) const;
-  void PopulateEFBCache(bool depth, u32 tile_index);
+  void PopulateEFBCache(bool depth, u32 tile_index, bool wait = true);
+  void PrefetchEFBCache(bool depth);
+  void FinishEFBCacheReadback(EFBCacheData& data);
 
   void CreatePokeVertices(std::vector<EFBPokeVertex>* destination_list, u32 x, u32 y, float z,
                           u32 color);
@@ -151,9 +182,14 @@ protected:
   void DrawPokeVertices(const EFBPokeVertex* vertices, u32 vertex_count,
                         const AbstractPipeline* pipeline);
 
+  void InvalidateEFBResolves();
+
   void DoLoadState(PointerWrap& p);
   void DoSaveState(PointerWrap& p);
 
+  // Resolves the EFB, and returns the color and depth textures as they are saved to states.
+  std::array<std::pair<AbstractTexture*, TextureConfig>, 2> GetSaveStateTextures();
+
   std::unique_ptr<AbstractTexture> m_efb_color_texture;
   std::unique_ptr<AbstractTexture> m_efb_convert_color_texture;
   std::unique_ptr<AbstractTexture> m_efb_depth_texture;
@@ -165,6 +201,14 @@ protected:
   std::unique_ptr<AbstractFramebuffer> m_efb_depth_resolve_framebuffer;
   std::unique_ptr<AbstractPipeline> m_efb_depth_resolve_pipeline;
 
+  // Regions whose resolved contents in the resolve textures are still current. Anything that
+  // writes to the EFB empties them, so copies of a region that hasn't changed reuse its resolve.
+  std::vector<MathUtil::Rectangle<int>> m_efb_resolved_color_regions;
+  std::vector<MathUtil::Rectangle<int>> m_efb_resolved_depth_regions;
+
+  // Most recently used first.
+  std::vector<EFBTextureSet> m_efb_texture_pool;
+
   // Pipeline for restoring the contents of the EFB from a save state
   std::unique_ptr<AbstractPipeline> m_efb_restore_pipeline;
 
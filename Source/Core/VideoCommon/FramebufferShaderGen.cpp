@@ -697,6 +697,59 @@ std::string GenerateEFBRestorePixelShader()
   return ss.str();
 }
 
+std::string GenerateNV12ConversionPixelShader()
+{
+  // The target is an RGBA8 texture a quarter of the image width wide, holding the full-resolution
+  // luma plane in the first luma_height rows, and the interleaved half-resolution chroma plane
+  // below it. Read back, that is exactly the NV12 memory layout, with 4 pixels per texel.
+  // Uses the BT.601 limited range coefficients, same as libswscale's default.
+  std::ostringstream ss;
+  EmitUniformBufferDeclaration(ss);
+  ss << "{\n"
+        "  int2 src_offset;\n"
+        "  int luma_height;\n"
+        "  int padding;\n"
+        "};\n\n";
+  EmitSamplerDeclarations(ss, 0, 1, false);
+  ss << "float3 LoadPixel(int2 coords)\n"
+        "{\n"
+        "  return ";
+  EmitTextureLoad(ss, 0, "int4(src_offset + coords, 0, 0)");
+  ss << ".rgb;\n"
+        "}\n\n"
+        "float RGBToY(float3 rgb)\n"
+        "{\n"
+        "  return (16.0 + dot(rgb, float3(65.481, 128.553, 24.966))) / 255.0;\n"
+        "}\n\n"
+        "float2 RGBToUV(float3 rgb)\n"
+        "{\n"
+        "  return (128.0 + float2(dot(rgb, float3(-37.797, -74.203, 112.0)),\n"
+        "                         dot(rgb, float3(112.0, -93.786, -18.214)))) / 255.0;\n"
+        "}\n\n"
+        "float3 LoadChroma(int2 coords)\n"
+        "{\n"
+        "  return (LoadPixel(coords) + LoadPixel(coords + int2(1, 0)) +\n"
+        "          LoadPixel(coords + int2(0, 1)) + LoadPixel(coords + int2(1, 1))) * 0.25;\n"
+        "}\n\n";
+  EmitPixelMainDeclaration(ss, 1, 0, "float4", "", true);
+  ss << "{\n"
+        "  int2 coords = int2(frag_coord.xy);\n"
+        "  if (coords.y < luma_height)\n"
+        "  {\n"
+        "    int2 src = int2(coords.x * 4, coords.y);\n"
+        "    ocol0 = float4(RGBToY(LoadPixel(src)), RGBToY(LoadPixel(src + int2(1, 0))),\n"
+        "                   RGBToY(LoadPixel(src + int2(2, 0))),\n"
+        "                   RGBToY(LoadPixel(src + int2(3, 0))));\n"
+        "  }\n"
+        "  else\n"
+        "  {\n"
+        "    int2 src = int2(coords.x * 4, (coords.y - luma_height) * 2);\n"
+        "    ocol0 = float4(RGBToUV(LoadChroma(src)), RGBToUV(LoadChroma(src + int2(2, 0))));\n"
+        "  }\n"
+        "}\n";
+  return ss.str();
+}
+
 std::string GenerateImGuiVertexShader()
 {
   std::ostringstream ss;
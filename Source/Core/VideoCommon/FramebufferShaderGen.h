@@ -23,6 +23,7 @@ std::string GenerateColorPixelShader();
 std::string GenerateFormatConversionShader(EFBReinterpretType convtype, u32 samples);
 std::string GenerateTextureReinterpretShader(TextureFormat from_format, TextureFormat to_format);
 std::string GenerateEFBRestorePixelShader();
+std::string GenerateNV12ConversionPixelShader();
 std::string GenerateImGuiVertexShader();
 std::string GenerateImGuiPixelShader();
 
@@ -0,0 +1,195 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/GPUMemoryAccess.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+#include "Common/BitSet.h"
+#include "Common/Swap.h"
+#include "VideoCommon/AsyncRequests.h"
+#include "VideoCommon/BPMemory.h"
+#include "VideoCommon/BPStructs.h"
+#include "VideoCommon/CPMemory.h"
+#include "VideoCommon/GeometryShaderManager.h"
+#include "VideoCommon/PixelShaderManager.h"
+#include "VideoCommon/RenderBase.h"
+#include "VideoCommon/TextureDecoder.h"
+#include "VideoCommon/VertexManagerBase.h"
+#include "VideoCommon/VertexShaderManager.h"
+#include "VideoCommon/VideoBackendBase.h"
+#include "VideoCommon/VideoCommon.h"
+#include "VideoCommon/XFMemory.h"
+
+namespace GPUMemoryAccess
+{
+namespace
+{
+// The part of CPState that mirrors the hardware registers. The rest belongs to the vertex loader.
+constexpr u32 CP_REGISTERS_SIZE = offsetof(CPState, attr_dirty);
+constexpr u32 EFB_SIZE = EFB_WIDTH * EFB_HEIGHT * sizeof(u32);
+
+u8* GetFlatRegion(Region region)
+{
+  switch (region)
+  {
+  case Region::TMEM:
+    return texMem;
+  case Region::XF:
+    return reinterpret_cast<u8*>(&xfmem);
+  case Region::BP:
+    return reinterpret_cast<u8*>(&bpmem);
+  case Region::CP:
+    return reinterpret_cast<u8*>(&g_main_cp_state);
+  default:
+    return nullptr;
+  }
+}
+
+u32 PeekEFB(u32 pixel)
+{
+  return g_renderer->AccessEFB(EFBAccessType::PeekColor, pixel % EFB_WIDTH, pixel / EFB_WIDTH, 0);
+}
+
+void AccessEFB(const Access& access, u32 length)
+{
+  for (u32 offset = 0; offset < length;)
+  {
+    const u32 address = access.address + offset;
+    const u32 pixel = address / sizeof(u32);
+    const u32 first = address % sizeof(u32);
+    const u32 count = std::min<u32>(sizeof(u32) - first, length - offset);
+
+    u32 value = Common::swap32(PeekEFB(pixel));
+    if (access.write)
+    {
+      // Poke straight away rather than merging, since later reads in the batch must see this
+      std::memcpy(reinterpret_cast<u8*>(&value) + first, access.data + offset, count);
+      const EfbPokeData poke = {static_cast<u16>(pixel % EFB_WIDTH),
+                                static_cast<u16>(pixel / EFB_WIDTH), Common::swap32(value)};
+      g_renderer->PokeEFB(EFBAccessType::PokeColor, &poke, 1);
+    }
+    else
+    {
+      std::memcpy(access.data + offset, reinterpret_cast<u8*>(&value) + first, count);
+    }
+
+    offset += count;
+  }
+}
+}  // Anonymous namespace
+
+u32 GetRegionSize(Region region)
+{
+  switch (region)
+  {
+  case Region::TMEM:
+    return TMEM_SIZE;
+  case Region::XF:
+    return sizeof(XFMemory);
+  case Region::BP:
+    return sizeof(BPMemory);
+  case Region::CP:
+    return CP_REGISTERS_SIZE;
+  case Region::EFB:
+    return EFB_SIZE;
+  default:
+    return 0;
+  }
+}
+
+void Execute(const std::vector<Access>& accesses)
+{
+  // Anything already batched has to be drawn with the state it was batched with
+  g_vertex_manager->Flush();
+
+  bool xf_registers_dirty = false;
+  bool bp_dirty = false;
+  bool cp_dirty = false;
+
+  for (const Access& access : accesses)
+  {
+    const u32 size = GetRegionSize(access.region);
+    const u32 length = access.address < size ? std::min(access.length, size - access.address) : 0;
+    if (!access.write)
+      std::fill(access.data + length, access.data + access.length, 0);
+    if (length == 0)
+      continue;
+
+    if (access.region == Region::EFB)
+    {
+      AccessEFB(access, length);
+      continue;
+    }
+
+    u8* const region = GetFlatRegion(access.region);
+    if (!access.write)
+    {
+      std::memcpy(access.data, region + access.address, length);
+      continue;
+    }
+
+    std::memcpy(region + access.address, access.data, length);
+    switch (access.region)
+    {
+    case Region::XF:
+    {
+      const u32 start = access.address / sizeof(u32);
+      const u32 end = (access.address + length + sizeof(u32) - 1) / sizeof(u32);
+      if (start < XFMEM_ERROR)
+        VertexShaderManager::InvalidateXFRange(start, std::min<u32>(end, XFMEM_ERROR));
+      if (end > XFMEM_ERROR)
+        xf_registers_dirty = true;
+      break;
+    }
+    case Region::BP:
+      bp_dirty = true;
+      break;
+    case Region::CP:
+      cp_dirty = true;
+      break;
+    default:
+      break;
+    }
+  }
+
+  // Written registers are picked up the same way as after loading a savestate
+  if (xf_registers_dirty)
+  {
+    VertexShaderManager::SetViewportChanged();
+    VertexShaderManager::SetProjectionChanged();
+    VertexShaderManager::SetLightingConfigChanged();
+    for (int i = 0; i < NUM_XF_COLOR_CHANNELS; ++i)
+      VertexShaderManager::SetMaterialColorChanged(i);
+    for (int i = 0; i < 8; ++i)
+      VertexShaderManager::SetTexMatrixInfoChanged(i);
+    GeometryShaderManager::Dirty();
+  }
+  if (bp_dirty)
+  {
+    BPReload();
+    PixelShaderManager::Dirty();
+    GeometryShaderManager::Dirty();
+  }
+  if (cp_dirty)
+  {
+    g_main_cp_state.attr_dirty = BitSet32::AllTrue(8);
+    g_main_cp_state.bases_dirty = true;
+  }
+}
+
+void Run(const std::vector<Access>& accesses)
+{
+  if (accesses.empty())
+    return;
+
+  AsyncRequests::Event e;
+  e.type = AsyncRequests::Event::GPU_MEMORY_ACCESS;
+  e.time = 0;
+  e.gpu_memory_access.accesses = &accesses;
+  AsyncRequests::GetInstance()->PushEvent(e, true);
+}
+}  // namespace GPUMemoryAccess
@@ -0,0 +1,45 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// Raw byte access to the GPU-side state (texture memory, the register files and the EFB) for
+// tools that want to inspect or corrupt it. Accesses are batched and run on the GPU thread at a
+// safe point, so a batch costs one round trip rather than one GPU sync per byte.
+
+#pragma once
+
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace GPUMemoryAccess
+{
+enum class Region : u8
+{
+  TMEM,
+  XF,
+  BP,
+  CP,
+  // The colour buffer as 32-bit ARGB pixels in row-major order, stored big endian
+  EFB,
+};
+
+struct Access
+{
+  Region region;
+  bool write;
+  u32 address;
+  u32 length;
+  // Destination for reads, source for writes. Bytes outside the region read back as zero.
+  u8* data;
+};
+
+u32 GetRegionSize(Region region);
+
+// Queues the accesses on the GPU thread and waits for them to complete. Must be called from the
+// CPU thread (or with the CPU thread paused), the same as other EFB accesses.
+void Run(const std::vector<Access>& accesses);
+
+// Runs the accesses immediately. Only call this from the GPU thread.
+void Execute(const std::vector<Access>& accesses);
+}  // namespace GPUMemoryAccess
@@ -5,12 +5,16 @@
 #include "VideoCommon/HiresTextures.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 #include <xxhash.h>
@@ -24,10 +28,12 @@
 #include "Common/Flag.h"
 #include "Common/Image.h"
 #include "Common/Logging/Log.h"
+#include "Common/MappedFile.h"
 #include "Common/MemoryUtil.h"
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
 #include "Common/Thread.h"
+#include "Common/ThreadPool.h"
 #include "Common/Timer.h"
 #include "Core/Config/GraphicsSettings.h"
 #include "Core/ConfigManager.h"
@@ -38,17 +44,166 @@ struct DiskTexture
 {
   std::string path;
   bool has_arbitrary_mipmaps;
+  // Set for textures inside the texture pack, which don't have a file of their own
+  const u8* data = nullptr;
+  size_t size = 0;
 };
 
 constexpr std::string_view s_format_prefix{"tex1_"};
 
+// A texture pack holds all custom textures of a game in a single file, so that they can be found
+// without searching the texture directories. It's placed in the root of the texture directory,
+// named after the game ID. Everything is little endian:
+//   TexturePackHeader
+//   TexturePackEntry[num_entries], sorted by name_hash
+//   the names of the entries, the same as for loose files but without extension and "_arb"
+//   the contents of the entries, which are PNG or DDS files
+constexpr u32 TEXTURE_PACK_MAGIC = 0x4B505444;  // "DTPK"
+constexpr u32 TEXTURE_PACK_VERSION = 1;
+constexpr std::string_view s_texture_pack_extension{".texpack"};
+
+struct TexturePackHeader
+{
+  u32 magic;
+  u32 version;
+  u32 num_entries;
+  u32 reserved;
+};
+
+struct TexturePackEntry
+{
+  u64 name_hash;  // XXH64 of the name with a seed of 0
+  u32 name_offset;
+  u16 name_length;
+  u8 has_arbitrary_mipmaps;
+  u8 reserved;
+  u64 data_offset;
+  u64 data_size;
+};
+static_assert(sizeof(TexturePackEntry) == 32, "Texture pack entry size mismatch");
+
 static std::unordered_map<std::string, DiskTexture> s_textureMap;
+static File::MappedFile s_texturePack;
+static std::string s_texturePackPath;
+static const TexturePackEntry* s_texturePackEntries = nullptr;
+static u32 s_texturePackEntryCount = 0;
 static std::unordered_map<std::string, std::shared_ptr<HiresTexture>> s_textureCache;
 static std::mutex s_textureCacheMutex;
 static Common::Flag s_textureCacheAbortLoading;
 
 static std::thread s_prefetcher;
 
+// Streaming state, guarded by s_textureCacheMutex. Textures which failed to load stay in
+// s_streamingTextures, so they aren't queued over and over again.
+static Common::ThreadPool::JobGroup s_streamingJobs;
+static bool s_streamingStarted = false;
+static std::unordered_set<std::string> s_streamingTextures;
+static size_t s_streamedSize = 0;
+static u64 s_useCounter = 0;
+static std::atomic<u32> s_loadCount{0};
+
+static bool IsStreaming()
+{
+  return g_ActiveConfig.bStreamHiresTextures && !g_ActiveConfig.bCacheHiresTextures;
+}
+
+static size_t GetMaxCacheSize()
+{
+  const size_t sys_mem = Common::MemPhysical();
+  const size_t recommended_min_mem = 2 * size_t(1024 * 1024 * 1024);
+  // keep 2GB memory for system stability if system RAM is 4GB+ - use half of memory in other cases
+  return (sys_mem / 2 < recommended_min_mem) ? (sys_mem / 2) : (sys_mem - recommended_min_mem);
+}
+
+static bool OpenTexturePack(const std::string& path)
+{
+  if (!s_texturePack.Open(path))
+    return false;
+
+  TexturePackHeader header;
+  const size_t size = s_texturePack.GetSize();
+  if (size >= sizeof(header))
+    std::memcpy(&header, s_texturePack.GetData(), sizeof(header));
+  if (size < sizeof(header) || header.magic != TEXTURE_PACK_MAGIC ||
+      header.version != TEXTURE_PACK_VERSION ||
+      (size - sizeof(header)) / sizeof(TexturePackEntry) < header.num_entries)
+  {
+    ERROR_LOG(VIDEO, "Texture pack '%s' is invalid", path.c_str());
+    s_texturePack.Close();
+    return false;
+  }
+
+  // The mapping is page aligned, so the entries following the header are aligned as well
+  s_texturePackEntries =
+      reinterpret_cast<const TexturePackEntry*>(s_texturePack.GetData() + sizeof(header));
+  s_texturePackEntryCount = header.num_entries;
+  s_texturePackPath = path;
+  return true;
+}
+
+static void CloseTexturePack()
+{
+  s_texturePack.Close();
+  s_texturePackPath.clear();
+  s_texturePackEntries = nullptr;
+  s_texturePackEntryCount = 0;
+}
+
+static std::string_view GetTexturePackEntryName(const TexturePackEntry& entry)
+{
+  if (entry.name_offset > s_texturePack.GetSize() ||
+      entry.name_length > s_texturePack.GetSize() - entry.name_offset)
+  {
+    return {};
+  }
+
+  return {reinterpret_cast<const char*>(s_texturePack.GetData()) + entry.name_offset,
+          entry.name_length};
+}
+
+static std::optional<DiskTexture> FindDiskTexture(const std::string& name)
+{
+  const auto iter = s_textureMap.find(name);
+  if (iter != s_textureMap.end())
+    return iter->second;
+
+  if (!s_texturePack)
+    return std::nullopt;
+
+  const u64 hash = XXH64(name.data(), name.size(), 0);
+  const TexturePackEntry* const end = s_texturePackEntries + s_texturePackEntryCount;
+  const TexturePackEntry* entry =
+      std::lower_bound(s_texturePackEntries, end, hash,
+                       [](const TexturePackEntry& e, u64 value) { return e.name_hash < value; });
+  for (; entry != end && entry->name_hash == hash; ++entry)
+  {
+    if (GetTexturePackEntryName(*entry) != name)
+      continue;
+
+    const size_t pack_size = s_texturePack.GetSize();
+    if (entry->data_offset > pack_size || entry->data_size > pack_size - entry->data_offset)
+      return std::nullopt;
+
+    return DiskTexture{s_texturePackPath, entry->has_arbitrary_mipmaps != 0,
+                       s_texturePack.GetData() + entry->data_offset,
+                       static_cast<size_t>(entry->data_size)};
+  }
+
+  return std::nullopt;
+}
+
+static bool HasDiskTexture(const std::string& name)
+{
+  return FindDiskTexture(name).has_value();
+}
+
+static void ClearTextureCache()
+{
+  s_textureCache.clear();
+  s_streamingTextures.clear();
+  s_streamedSize = 0;
+}
+
 void HiresTexture::Init()
 {
   Update();
@@ -56,38 +211,51 @@ void HiresTexture::Init()
 
 void HiresTexture::Shutdown()
 {
-  if (s_prefetcher.joinable())
-  {
-    s_textureCacheAbortLoading.Set();
-    s_prefetcher.join();
-  }
+  StopLoading();
 
   s_textureMap.clear();
-  s_textureCache.clear();
+  CloseTexturePack();
+  ClearTextureCache();
 }
 
-void HiresTexture::Update()
+void HiresTexture::StopLoading()
 {
+  s_textureCacheAbortLoading.Set();
   if (s_prefetcher.joinable())
-  {
-    s_textureCacheAbortLoading.Set();
     s_prefetcher.join();
-  }
+
+  // Queued requests return right away once the abort flag is set
+  s_streamingJobs.Wait();
+  s_streamingStarted = false;
+}
+
+void HiresTexture::Update()
+{
+  StopLoading();
+
+  s_textureMap.clear();
+  CloseTexturePack();
 
   if (!g_ActiveConfig.bHiresTextures)
   {
-    s_textureMap.clear();
-    s_textureCache.clear();
+    ClearTextureCache();
     return;
   }
 
   if (!g_ActiveConfig.bCacheHiresTextures)
   {
-    s_textureCache.clear();
+    ClearTextureCache();
   }
 
+  // Games with a texture pack don't need their texture directories to be searched
   const std::string& game_id = SConfig::GetInstance().GetGameID();
-  const std::set<std::string> texture_directories = GetTextureDirectories(game_id);
+  const std::string root_directory = File::GetUserPath(D_HIRESTEXTURES_IDX);
+  const bool has_texture_pack =
+      OpenTexturePack(root_directory + game_id + std::string(s_texture_pack_extension)) ||
+      OpenTexturePack(root_directory + game_id.substr(0, 3) +
+                      std::string(s_texture_pack_extension));
+  const std::set<std::string> texture_directories =
+      has_texture_pack ? std::set<std::string>() : GetTextureDirectories(game_id);
   const std::vector<std::string> extensions{".png", ".dds"};
 
   for (const auto& texture_directory : texture_directories)
@@ -130,7 +298,7 @@ void HiresTexture::Update()
     auto iter = s_textureCache.begin();
     while (iter != s_textureCache.end())
     {
-      if (s_textureMap.find(iter->first) == s_textureMap.end())
+      if (!HasDiskTexture(iter->first))
       {
         iter = s_textureCache.erase(iter);
       }
@@ -143,24 +311,31 @@ void HiresTexture::Update()
     s_textureCacheAbortLoading.Clear();
     s_prefetcher = std::thread(Prefetch);
   }
+  else if (IsStreaming())
+  {
+    s_textureCacheAbortLoading.Clear();
+    s_streamingStarted = true;
+  }
 }
 
 void HiresTexture::Prefetch()
 {
   Common::SetCurrentThreadName("Prefetcher");
+  Common::SetCurrentThreadCoreClass(Common::CoreClass::Efficiency);
 
   size_t size_sum = 0;
-  const size_t sys_mem = Common::MemPhysical();
-  const size_t recommended_min_mem = 2 * size_t(1024 * 1024 * 1024);
-  // keep 2GB memory for system stability if system RAM is 4GB+ - use half of memory in other cases
-  const size_t max_mem =
-      (sys_mem / 2 < recommended_min_mem) ? (sys_mem / 2) : (sys_mem - recommended_min_mem);
+  const size_t max_mem = GetMaxCacheSize();
 
-  const u32 start_time = Common::Timer::GetTimeMs();
+  std::vector<std::string> base_filenames;
+  base_filenames.reserve(s_textureMap.size() + s_texturePackEntryCount);
   for (const auto& entry : s_textureMap)
-  {
-    const std::string& base_filename = entry.first;
+    base_filenames.push_back(entry.first);
+  for (u32 i = 0; i < s_texturePackEntryCount; i++)
+    base_filenames.emplace_back(GetTexturePackEntryName(s_texturePackEntries[i]));
 
+  const u32 start_time = Common::Timer::GetTimeMs();
+  for (const std::string& base_filename : base_filenames)
+  {
     if (base_filename.find("_mip") == std::string::npos)
     {
       std::unique_lock<std::mutex> lk(s_textureCacheMutex);
@@ -214,7 +389,7 @@ std::string HiresTexture::GenBaseName(const u8* texture, size_t texture_size, co
                                       size_t tlut_size, u32 width, u32 height, TextureFormat format,
                                       bool has_mipmaps, bool dump)
 {
-  if (!dump && s_textureMap.empty())
+  if (!dump && s_textureMap.empty() && !s_texturePack)
     return "";
 
   // checking for min/max on paletted textures
@@ -274,12 +449,12 @@ std::string HiresTexture::GenBaseName(const u8* texture, size_t texture_size, co
   if (!dump)
   {
     const std::string texture_name = fmt::format("{}_${}", base_name, format_name);
-    if (s_textureMap.find(texture_name) != s_textureMap.end())
+    if (HasDiskTexture(texture_name))
       return texture_name;
   }
 
   // else generate the complete texture
-  if (dump || s_textureMap.find(full_name) != s_textureMap.end())
+  if (dump || HasDiskTexture(full_name))
     return full_name;
 
   return "";
@@ -303,7 +478,7 @@ u32 HiresTexture::CalculateMipCount(u32 width, u32 height)
 std::shared_ptr<HiresTexture> HiresTexture::Search(const u8* texture, size_t texture_size,
                                                    const u8* tlut, size_t tlut_size, u32 width,
                                                    u32 height, TextureFormat format,
-                                                   bool has_mipmaps)
+                                                   bool has_mipmaps, std::string* pending_base_name)
 {
   std::string base_filename =
       GenBaseName(texture, texture_size, tlut, tlut_size, width, height, format, has_mipmaps);
@@ -313,9 +488,26 @@ std::shared_ptr<HiresTexture> HiresTexture::Search(const u8* texture, size_t tex
   auto iter = s_textureCache.find(base_filename);
   if (iter != s_textureCache.end())
   {
+    iter->second->m_last_use = ++s_useCounter;
     return iter->second;
   }
 
+  if (IsStreaming() && s_streamingStarted)
+  {
+    if (!HasDiskTexture(base_filename))
+      return nullptr;
+
+    if (s_streamingTextures.insert(base_filename).second)
+    {
+      s_streamingJobs.Submit(Common::ThreadPool::Priority::Low, [base_filename, width, height] {
+        StreamTexture(base_filename, width, height);
+      });
+    }
+    if (pending_base_name)
+      *pending_base_name = std::move(base_filename);
+    return nullptr;
+  }
+
   std::shared_ptr<HiresTexture> ptr(Load(base_filename, width, height));
 
   if (ptr && g_ActiveConfig.bCacheHiresTextures)
@@ -326,21 +518,89 @@ std::shared_ptr<HiresTexture> HiresTexture::Search(const u8* texture, size_t tex
   return ptr;
 }
 
+bool HiresTexture::IsLoaded(const std::string& base_filename)
+{
+  std::lock_guard<std::mutex> lk(s_textureCacheMutex);
+  return s_textureCache.find(base_filename) != s_textureCache.end();
+}
+
+u32 HiresTexture::GetLoadCount()
+{
+  return s_loadCount.load(std::memory_order_acquire);
+}
+
+void HiresTexture::StreamTexture(const std::string& base_filename, u32 width, u32 height)
+{
+  if (s_textureCacheAbortLoading.IsSet())
+    return;
+
+  std::unique_ptr<HiresTexture> texture = Load(base_filename, width, height);
+  if (!texture)
+    return;
+
+  for (const Level& level : texture->m_levels)
+    texture->m_size += level.data.size();
+
+  std::lock_guard<std::mutex> lk(s_textureCacheMutex);
+  texture->m_last_use = ++s_useCounter;
+  s_streamedSize += texture->m_size;
+  s_textureCache.emplace(base_filename, std::move(texture));
+  s_streamingTextures.erase(base_filename);
+
+  // Evict the least recently used textures. Those still in the texture cache stay on the GPU, and
+  // are only loaded again if the game changes them.
+  const size_t max_size = GetMaxCacheSize();
+  while (s_streamedSize > max_size && s_textureCache.size() > 1)
+  {
+    auto oldest = std::min_element(s_textureCache.begin(), s_textureCache.end(),
+                                   [](const auto& a, const auto& b) {
+                                     return a.second->m_last_use < b.second->m_last_use;
+                                   });
+    s_streamedSize -= oldest->second->m_size;
+    s_textureCache.erase(oldest);
+  }
+
+  s_loadCount.fetch_add(1, std::memory_order_release);
+}
+
 std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filename, u32 width,
                                                  u32 height)
 {
   // We need to have a level 0 custom texture to even consider loading.
-  auto filename_iter = s_textureMap.find(base_filename);
-  if (filename_iter == s_textureMap.end())
+  const std::optional<DiskTexture> first_mip_file = FindDiskTexture(base_filename);
+  if (!first_mip_file)
     return nullptr;
 
+  // Loose files are mapped, textures in the pack are read from its mapping
+  const auto map_texture = [](const DiskTexture& texture, File::MappedFile* file, const u8** data,
+                              size_t* size) {
+    if (texture.data)
+    {
+      *data = texture.data;
+      *size = texture.size;
+      return true;
+    }
+
+    if (!file->Open(texture.path))
+      return false;
+
+    *data = file->GetData();
+    *size = file->GetSize();
+    return true;
+  };
+
   // Try to load level 0 (and any mipmaps) from a DDS file.
   // If this fails, it's fine, we'll just load level0 again using SOIL.
   // Can't use make_unique due to private constructor.
   std::unique_ptr<HiresTexture> ret = std::unique_ptr<HiresTexture>(new HiresTexture());
-  const DiskTexture& first_mip_file = filename_iter->second;
-  ret->m_has_arbitrary_mipmaps = first_mip_file.has_arbitrary_mipmaps;
-  LoadDDSTexture(ret.get(), first_mip_file.path);
+  ret->m_has_arbitrary_mipmaps = first_mip_file->has_arbitrary_mipmaps;
+  {
+    File::MappedFile file;
+    const u8* data;
+    size_t size;
+    if (map_texture(*first_mip_file, &file, &data, &size))
+      LoadDDSTexture(ret.get(), data, size, first_mip_file->path);
+  }
 
   // Load remaining mip levels, or from the start if it's not a DDS texture.
   for (u32 mip_level = static_cast<u32>(ret->m_levels.size());; mip_level++)
@@ -349,20 +609,24 @@ std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filenam
     if (mip_level != 0)
       filename += fmt::format("_mip{}", mip_level);
 
-    filename_iter = s_textureMap.find(filename);
-    if (filename_iter == s_textureMap.end())
+    const std::optional<DiskTexture> mip_file = FindDiskTexture(filename);
+    if (!mip_file)
       break;
 
+    File::MappedFile file;
+    const u8* data;
+    size_t size;
+    if (!map_texture(*mip_file, &file, &data, &size))
+    {
+      ERROR_LOG(VIDEO, "Custom texture %s failed to load", filename.c_str());
+      break;
+    }
+
     // Try loading DDS textures first, that way we maintain compression of DXT formats.
-    // TODO: Reduce the number of open() calls here. We could use one fd.
     Level level;
-    if (!LoadDDSTexture(level, filename_iter->second.path, mip_level))
+    if (!LoadDDSTexture(level, data, size, mip_file->path, mip_level))
     {
-      File::IOFile file;
-      file.Open(filename_iter->second.path, "rb");
-      std::vector<u8> buffer(file.GetSize());
-      file.ReadBytes(buffer.data(), file.GetSize());
-
+      const std::vector<u8> buffer(data, data + size);
       if (!LoadTexture(level, buffer))
       {
         ERROR_LOG(VIDEO, "Custom texture %s failed to load", filename.c_str());
@@ -384,7 +648,7 @@ std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filenam
     ERROR_LOG(VIDEO,
               "Invalid custom texture size %ux%u for texture %s. The aspect differs "
               "from the native size %ux%u.",
-              first_mip.width, first_mip.height, first_mip_file.path.c_str(), width, height);
+              first_mip.width, first_mip.height, first_mip_file->path.c_str(), width, height);
   }
 
   // Same deal if the custom texture isn't a multiple of the native size.
@@ -393,7 +657,7 @@ std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filenam
     ERROR_LOG(VIDEO,
               "Invalid custom texture size %ux%u for texture %s. Please use an integer "
               "upscaling factor based on the native size %ux%u.",
-              first_mip.width, first_mip.height, first_mip_file.path.c_str(), width, height);
+              first_mip.width, first_mip.height, first_mip_file->path.c_str(), width, height);
   }
 
   // Verify that each mip level is the correct size (divide by 2 each time).
@@ -412,14 +676,14 @@ std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filenam
 
       ERROR_LOG(VIDEO,
                 "Invalid custom texture size %dx%d for texture %s. Mipmap level %u must be %dx%d.",
-                level.width, level.height, first_mip_file.path.c_str(), mip_level,
+                level.width, level.height, first_mip_file->path.c_str(), mip_level,
                 current_mip_width, current_mip_height);
     }
     else
     {
       // It is invalid to have more than a single 1x1 mipmap.
       ERROR_LOG(VIDEO, "Custom texture %s has too many 1x1 mipmaps. Skipping extra levels.",
-                first_mip_file.path.c_str());
+                first_mip_file->path.c_str());
     }
 
     // Drop this mip level and any others after it.
@@ -432,7 +696,7 @@ std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filenam
                   [&ret](const Level& l) { return l.format != ret->m_levels[0].format; }))
   {
     ERROR_LOG(VIDEO, "Custom texture %s has inconsistent formats across mip levels.",
-              first_mip_file.path.c_str());
+              first_mip_file->path.c_str());
 
     return nullptr;
   }
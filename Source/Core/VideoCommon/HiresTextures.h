@@ -21,9 +21,15 @@ public:
   static void Update();
   static void Shutdown();
 
+  // When streaming, a texture which isn't in memory yet is queued for loading in the background
+  // and nothing is returned. Its name is then stored in pending_base_name, for IsLoaded.
   static std::shared_ptr<HiresTexture> Search(const u8* texture, size_t texture_size,
                                               const u8* tlut, size_t tlut_size, u32 width,
-                                              u32 height, TextureFormat format, bool has_mipmaps);
+                                              u32 height, TextureFormat format, bool has_mipmaps,
+                                              std::string* pending_base_name = nullptr);
+  static bool IsLoaded(const std::string& base_filename);
+  // Incremented whenever a streamed texture has finished loading
+  static u32 GetLoadCount();
 
   static std::string GenBaseName(const u8* texture, size_t texture_size, const u8* tlut,
                                  size_t tlut_size, u32 width, u32 height, TextureFormat format,
@@ -49,13 +55,22 @@ public:
 private:
   static std::unique_ptr<HiresTexture> Load(const std::string& base_filename, u32 width,
                                             u32 height);
-  static bool LoadDDSTexture(HiresTexture* tex, const std::string& filename);
-  static bool LoadDDSTexture(Level& level, const std::string& filename, u32 mip_level);
+  // The filename is only used in error messages, the file itself has to be in memory already
+  static bool LoadDDSTexture(HiresTexture* tex, const u8* data, size_t size,
+                             const std::string& filename);
+  static bool LoadDDSTexture(Level& level, const u8* data, size_t size,
+                             const std::string& filename, u32 mip_level);
   static bool LoadTexture(Level& level, const std::vector<u8>& buffer);
   static void Prefetch();
+  static void StreamTexture(const std::string& base_filename, u32 width, u32 height);
+  static void StopLoading();
 
   static std::set<std::string> GetTextureDirectories(const std::string& game_id);
 
   HiresTexture() {}
   bool m_has_arbitrary_mipmaps;
+
+  // Used to evict the least recently used streamed textures
+  size_t m_size = 0;
+  u64 m_last_use = 0;
 };
@@ -11,7 +11,6 @@
 #include <functional>
 
 #include "Common/Align.h"
-#include "Common/File.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
 #include "VideoCommon/VideoConfig.h"
@@ -151,6 +150,39 @@ struct DDSLoadInfo
   std::function<void(HiresTexture::Level*)> conversion_function;
 };
 
+// Reads a DDS file which is already in memory, either mapped on its own or inside a texture pack
+class DDSReader
+{
+public:
+  DDSReader(const u8* data, size_t size) : m_data(data), m_size(size) {}
+
+  bool ReadBytes(void* dst, size_t length)
+  {
+    if (length > m_size - m_position)
+      return false;
+
+    std::memcpy(dst, m_data + m_position, length);
+    m_position += length;
+    return true;
+  }
+
+  bool Seek(size_t position)
+  {
+    if (position > m_size)
+      return false;
+
+    m_position = position;
+    return true;
+  }
+
+  size_t GetSize() const { return m_size; }
+
+private:
+  const u8* m_data;
+  size_t m_size;
+  size_t m_position = 0;
+};
+
 u32 GetBlockCount(u32 extent, u32 block_size)
 {
   return std::max(Common::AlignUp(extent, block_size) / block_size, 1u);
@@ -228,7 +260,7 @@ void ConvertTexture_R8G8B8(HiresTexture::Level* level)
   level->data = std::move(new_data);
 }
 
-bool ParseDDSHeader(File::IOFile& file, DDSLoadInfo* info)
+bool ParseDDSHeader(DDSReader& file, DDSLoadInfo* info)
 {
   // Exit as early as possible for non-DDS textures, since all extensions are currently
   // passed through this function.
@@ -401,7 +433,7 @@ bool ParseDDSHeader(File::IOFile& file, DDSLoadInfo* info)
   return true;
 }
 
-bool ReadMipLevel(HiresTexture::Level* level, File::IOFile& file, const std::string& filename,
+bool ReadMipLevel(HiresTexture::Level* level, DDSReader& file, const std::string& filename,
                   u32 mip_level, const DDSLoadInfo& info, u32 width, u32 height, u32 row_length,
                   size_t size)
 {
@@ -435,20 +467,17 @@ bool ReadMipLevel(HiresTexture::Level* level, File::IOFile& file, const std::str
 
 }  // namespace
 
-bool HiresTexture::LoadDDSTexture(HiresTexture* tex, const std::string& filename)
+bool HiresTexture::LoadDDSTexture(HiresTexture* tex, const u8* data, size_t size,
+                                  const std::string& filename)
 {
-  File::IOFile file;
-  file.Open(filename, "rb");
-  if (!file.IsOpen())
-    return false;
-
+  DDSReader file(data, size);
   DDSLoadInfo info;
   if (!ParseDDSHeader(file, &info))
     return false;
 
   // Read first mip level, as it may have a custom pitch.
   Level first_level;
-  if (!file.Seek(info.first_mip_offset, SEEK_SET) ||
+  if (!file.Seek(info.first_mip_offset) ||
       !ReadMipLevel(&first_level, file, filename, 0, info, info.width, info.height,
                     info.first_mip_row_length, info.first_mip_size))
   {
@@ -482,14 +511,11 @@ bool HiresTexture::LoadDDSTexture(HiresTexture* tex, const std::string& filename
   return true;
 }
 
-bool HiresTexture::LoadDDSTexture(Level& level, const std::string& filename, u32 mip_level)
+bool HiresTexture::LoadDDSTexture(Level& level, const u8* data, size_t size,
+                                  const std::string& filename, u32 mip_level)
 {
   // Only loading a single mip level.
-  File::IOFile file;
-  file.Open(filename, "rb");
-  if (!file.IsOpen())
-    return false;
-
+  DDSReader file(data, size);
   DDSLoadInfo info;
   if (!ParseDDSHeader(file, &info))
     return false;
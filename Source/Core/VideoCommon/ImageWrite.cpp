@@ -2,14 +2,20 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
 #include <list>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/File.h"
 #include "Common/FileUtil.h"
 #include "Common/MsgHandler.h"
+#include "Common/Thread.h"
 #include "VideoCommon/ImageWrite.h"
 #include "png.h"
 
@@ -144,3 +150,80 @@ finalise:
 #ifdef _MSC_VER
 #pragma warning(pop)
 #endif
+
+namespace
+{
+struct PngJob
+{
+  const u8* data;
+  int row_stride;
+  std::string filename;
+  int width;
+  int height;
+  bool save_alpha;
+  std::function<void(bool)> on_done;
+};
+
+std::mutex s_png_mutex;
+std::condition_variable s_png_work_available;
+std::deque<PngJob> s_png_jobs;
+std::vector<std::thread> s_png_workers;
+bool s_png_shutdown = false;
+
+void PngWorkerLoop()
+{
+  Common::SetCurrentThreadName("PNG Writer");
+
+  std::unique_lock<std::mutex> lock(s_png_mutex);
+  while (true)
+  {
+    s_png_work_available.wait(lock, [] { return !s_png_jobs.empty() || s_png_shutdown; });
+    if (s_png_jobs.empty())
+      break;
+
+    PngJob job = std::move(s_png_jobs.front());
+    s_png_jobs.pop_front();
+    lock.unlock();
+
+    const bool success = TextureToPng(job.data, job.row_stride, job.filename, job.width,
+                                      job.height, job.save_alpha);
+    if (job.on_done)
+      job.on_done(success);
+
+    lock.lock();
+  }
+}
+}  // Anonymous namespace
+
+void TextureToPngAsync(const u8* data, int row_stride, std::string filename, int width,
+                       int height, bool save_alpha, std::function<void(bool)> on_done)
+{
+  {
+    std::lock_guard<std::mutex> guard(s_png_mutex);
+    if (s_png_workers.empty())
+    {
+      // Compression is the expensive part, and each image is compressed on a single thread.
+      const u32 num_workers = std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u);
+      s_png_shutdown = false;
+      for (u32 i = 0; i < num_workers; i++)
+        s_png_workers.emplace_back(PngWorkerLoop);
+    }
+
+    s_png_jobs.push_back(
+        {data, row_stride, std::move(filename), width, height, save_alpha, std::move(on_done)});
+  }
+  s_png_work_available.notify_one();
+}
+
+void ShutdownPngWriters()
+{
+  {
+    std::lock_guard<std::mutex> guard(s_png_mutex);
+    s_png_shutdown = true;
+  }
+  s_png_work_available.notify_all();
+
+  for (std::thread& worker : s_png_workers)
+    worker.join();
+  s_png_workers.clear();
+}
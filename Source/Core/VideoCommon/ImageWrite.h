@@ -4,9 +4,17 @@
 
 #pragma once
 
+#include <functional>
 #include <string>
 #include "Common/CommonTypes.h"
 
 bool SaveData(const std::string& filename, const std::string& data);
 bool TextureToPng(const u8* data, int row_stride, const std::string& filename, int width,
                   int height, bool saveAlpha = true);
+
+// Same as TextureToPng, but encodes on a shared pool of worker threads. The data has to stay
+// valid until on_done is called with the result, which happens on the worker thread.
+void TextureToPngAsync(const u8* data, int row_stride, std::string filename, int width,
+                       int height, bool save_alpha, std::function<void(bool)> on_done);
+// Waits for the queued PNG writes and stops the worker threads.
+void ShutdownPngWriters();
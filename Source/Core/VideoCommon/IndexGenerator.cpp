@@ -8,6 +8,7 @@
 #include <cstddef>
 #include <cstring>
 
+#include "Common/Assert.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "VideoCommon/OpcodeDecoding.h"
@@ -162,13 +163,6 @@ u16* AddQuads(u16* index_ptr, u32 num_verts, u32 index)
   return index_ptr;
 }
 
-template <bool pr>
-u16* AddQuads_nonstandard(u16* index_ptr, u32 num_verts, u32 index)
-{
-  WARN_LOG(VIDEO, "Non-standard primitive drawing command GL_DRAW_QUADS_2");
-  return AddQuads<pr>(index_ptr, num_verts, index);
-}
-
 u16* AddLineList(u16* index_ptr, u32 num_verts, u32 index)
 {
   for (u32 i = 1; i < num_verts; i += 2)
@@ -199,29 +193,122 @@ u16* AddPoints(u16* index_ptr, u32 num_verts, u32 index)
   }
   return index_ptr;
 }
+
+/*
+ * Blocked generators
+ *
+ * Relative to its first vertex, a run of primitives of the same type always produces the same
+ * indices. So the generators above are run once for a block of primitives, and long draws are
+ * written a block at a time by adding the first vertex of each block to that pattern. The fixed
+ * size loop turns into a few vector adds, rather than one index at a time.
+ */
+template <size_t N>
+struct IndexPattern
+{
+  std::array<u16, N> offsets{};
+  // Primitive restart markers don't move with the first vertex
+  std::array<u16, N> restart{};
+};
+
+template <size_t N>
+IndexPattern<N> MakeIndexPattern(u16* (*generate)(u16*, u32, u32), u32 num_verts)
+{
+  std::array<u16, N> indices{};
+  [[maybe_unused]] const u16* end = generate(indices.data(), num_verts, 0);
+  ASSERT(end == indices.data() + N);
+
+  IndexPattern<N> pattern;
+  for (size_t i = 0; i < N; ++i)
+  {
+    if (indices[i] == s_primitive_restart)
+      pattern.restart[i] = s_primitive_restart;
+    else
+      pattern.offsets[i] = indices[i];
+  }
+  return pattern;
+}
+
+// generate(num_verts = PATTERN_VERTS) writes N indices and covers BLOCK_VERTS vertices. Strips
+// need two more vertices than they advance by.
+template <u16* (*generate)(u16*, u32, u32), size_t N, u32 PATTERN_VERTS, u32 BLOCK_VERTS>
+u16* AddBlocks(u16* index_ptr, u32 num_verts, u32 index)
+{
+  static const IndexPattern<N> pattern = MakeIndexPattern<N>(generate, PATTERN_VERTS);
+
+  if (num_verts >= PATTERN_VERTS)
+  {
+    const u32 blocks = (num_verts - (PATTERN_VERTS - BLOCK_VERTS)) / BLOCK_VERTS;
+    for (u32 block = 0; block < blocks; ++block)
+    {
+      for (size_t i = 0; i < N; ++i)
+        index_ptr[i] = static_cast<u16>(pattern.offsets[i] + index) | pattern.restart[i];
+      index_ptr += N;
+      index += BLOCK_VERTS;
+    }
+    num_verts -= blocks * BLOCK_VERTS;
+  }
+
+  return generate(index_ptr, num_verts, index);
+}
+
+// Blocks of 8 primitives
+template <bool pr>
+u16* AddListBlocks(u16* index_ptr, u32 num_verts, u32 index)
+{
+  return AddBlocks<AddList<pr>, pr ? 32 : 24, 24, 24>(index_ptr, num_verts, index);
+}
+
+template <bool pr>
+u16* AddStripBlocks(u16* index_ptr, u32 num_verts, u32 index)
+{
+  if constexpr (pr)
+  {
+    index_ptr = AddBlocks<AddPoints, 8, 8, 8>(index_ptr, num_verts, index);
+    *index_ptr++ = s_primitive_restart;
+    return index_ptr;
+  }
+  else
+  {
+    // An even number of triangles per block keeps the winding in step
+    return AddBlocks<AddStrip<false>, 24, 10, 8>(index_ptr, num_verts, index);
+  }
+}
+
+template <bool pr>
+u16* AddQuadsBlocks(u16* index_ptr, u32 num_verts, u32 index)
+{
+  return AddBlocks<AddQuads<pr>, pr ? 40 : 48, 32, 32>(index_ptr, num_verts, index);
+}
+
+template <bool pr>
+u16* AddQuads_nonstandard(u16* index_ptr, u32 num_verts, u32 index)
+{
+  WARN_LOG(VIDEO, "Non-standard primitive drawing command GL_DRAW_QUADS_2");
+  return AddQuadsBlocks<pr>(index_ptr, num_verts, index);
+}
 }  // Anonymous namespace
 
 void IndexGenerator::Init()
 {
   if (g_Config.backend_info.bSupportsPrimitiveRestart)
   {
-    m_primitive_table[OpcodeDecoder::GX_DRAW_QUADS] = AddQuads<true>;
+    m_primitive_table[OpcodeDecoder::GX_DRAW_QUADS] = AddQuadsBlocks<true>;
     m_primitive_table[OpcodeDecoder::GX_DRAW_QUADS_2] = AddQuads_nonstandard<true>;
-    m_primitive_table[OpcodeDecoder::GX_DRAW_TRIANGLES] = AddList<true>;
-    m_primitive_table[OpcodeDecoder::GX_DRAW_TRIANGLE_STRIP] = AddStrip<true>;
+    m_primitive_table[OpcodeDecoder::GX_DRAW_TRIANGLES] = AddListBlocks<true>;
+    m_primitive_table[OpcodeDecoder::GX_DRAW_TRIANGLE_STRIP] = AddStripBlocks<true>;
     m_primitive_table[OpcodeDecoder::GX_DRAW_TRIANGLE_FAN] = AddFan<true>;
   }
   else
   {
-    m_primitive_table[OpcodeDecoder::GX_DRAW_QUADS] = AddQuads<false>;
+    m_primitive_table[OpcodeDecoder::GX_DRAW_QUADS] = AddQuadsBlocks<false>;
     m_primitive_table[OpcodeDecoder::GX_DRAW_QUADS_2] = AddQuads_nonstandard<false>;
-    m_primitive_table[OpcodeDecoder::GX_DRAW_TRIANGLES] = AddList<false>;
-    m_primitive_table[OpcodeDecoder::GX_DRAW_TRIANGLE_STRIP] = AddStrip<false>;
+    m_primitive_table[OpcodeDecoder::GX_DRAW_TRIANGLES] = AddListBlocks<false>;
+    m_primitive_table[OpcodeDecoder::GX_DRAW_TRIANGLE_STRIP] = AddStripBlocks<false>;
     m_primitive_table[OpcodeDecoder::GX_DRAW_TRIANGLE_FAN] = AddFan<false>;
   }
   m_primitive_table[OpcodeDecoder::GX_DRAW_LINES] = AddLineList;
   m_primitive_table[OpcodeDecoder::GX_DRAW_LINE_STRIP] = AddLineStrip;
-  m_primitive_table[OpcodeDecoder::GX_DRAW_POINTS] = AddPoints;
+  m_primitive_table[OpcodeDecoder::GX_DRAW_POINTS] = AddBlocks<AddPoints, 8, 8, 8>;
 }
 
 void IndexGenerator::Start(u16* index_ptr)
@@ -15,6 +15,8 @@
 
 #include "VideoCommon/OpcodeDecoding.h"
 
+#include <xxhash.h>
+
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Core/FifoPlayer/FifoRecorder.h"
@@ -26,6 +28,7 @@
 #include "VideoCommon/Fifo.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
+#include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/XFMemory.h"
 #include "Common/StringUtil.h"
 
@@ -35,6 +38,11 @@ namespace
 {
 bool s_is_fifo_error_seen = false;
 
+// The display list being interpreted on the GPU thread, if its vertex loads may be cached. Hashing
+// the whole list once is enough to identify every draw in it by its offset.
+const u8* s_display_list_start = nullptr;
+u64 s_display_list_hash = 0;
+
 u32 InterpretDisplayList(u32 address, u32 size)
 {
   u8* start_address;
@@ -52,9 +60,18 @@ u32 InterpretDisplayList(u32 address, u32 size)
     // temporarily swap dl and non-dl (small "hack" for the stats)
     g_stats.SwapDL();
 
+    if (g_ActiveConfig.bCacheVertexLoads)
+    {
+      s_display_list_start = start_address;
+      s_display_list_hash = XXH64(start_address, size, 0);
+    }
+
     Run(DataReader(start_address, start_address + size), &cycles, true);
     INCSTAT(g_stats.this_frame.num_dlists_called);
 
+    s_display_list_start = nullptr;
+    s_display_list_hash = 0;
+
     // un-swap
     g_stats.SwapDL();
   }
@@ -251,9 +268,19 @@ u8* Run(DataReader src, u32* cycles, bool in_display_list)
           return finish_up();
 
         const u16 num_vertices = src.Read<u16>();
+        u64 source_key = 0;
+        if constexpr (!is_preprocess)
+        {
+          if (in_display_list && s_display_list_hash != 0)
+          {
+            const u64 offset = static_cast<u64>(opcode_start - s_display_list_start);
+            source_key = s_display_list_hash + offset;
+          }
+        }
         const int bytes = VertexLoaderManager::RunVertices(
             cmd_byte & GX_VAT_MASK,  // Vertex loader index (0 - 7)
-            (cmd_byte & GX_PRIMITIVE_MASK) >> GX_PRIMITIVE_SHIFT, num_vertices, src, is_preprocess);
+            (cmd_byte & GX_PRIMITIVE_MASK) >> GX_PRIMITIVE_SHIFT, num_vertices, src, is_preprocess,
+            source_key);
 
         if (bytes < 0)
           return finish_up();
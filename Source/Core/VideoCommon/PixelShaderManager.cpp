@@ -197,6 +197,9 @@ void PixelShaderManager::SetConstants()
 void PixelShaderManager::SetTevColor(int index, int component, s32 value)
 {
   auto& c = constants.colors[index];
+  if (c[component] == value)
+    return;
+
   c[component] = value;
   dirty = true;
 
@@ -206,6 +209,10 @@ void PixelShaderManager::SetTevColor(int index, int component, s32 value)
 void PixelShaderManager::SetTevKonstColor(int index, int component, s32 value)
 {
   auto& c = constants.kcolors[index];
+  // The konst entries below are only ever derived from this, so they're unchanged as well
+  if (c[component] == value)
+    return;
+
   c[component] = value;
   dirty = true;
 
@@ -257,9 +264,15 @@ void PixelShaderManager::SetTevIndirectChanged()
 
 void PixelShaderManager::SetAlpha()
 {
-  constants.alpha[0] = bpmem.alpha_test.ref0;
-  constants.alpha[1] = bpmem.alpha_test.ref1;
-  constants.alpha[3] = static_cast<s32>(bpmem.dstalpha.alpha);
+  const s32 ref0 = bpmem.alpha_test.ref0;
+  const s32 ref1 = bpmem.alpha_test.ref1;
+  const s32 dst_alpha = static_cast<s32>(bpmem.dstalpha.alpha);
+  if (constants.alpha[0] == ref0 && constants.alpha[1] == ref1 && constants.alpha[3] == dst_alpha)
+    return;
+
+  constants.alpha[0] = ref0;
+  constants.alpha[1] = ref1;
+  constants.alpha[3] = dst_alpha;
   dirty = true;
 }
 
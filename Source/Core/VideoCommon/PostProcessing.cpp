@@ -4,6 +4,9 @@
 
 #include "VideoCommon/PostProcessing.h"
 
+#include <algorithm>
+#include <array>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <string_view>
@@ -35,6 +38,16 @@ namespace VideoCommon
 {
 static const char s_default_shader[] = "void main() { SetOutput(Sample()); }\n";
 
+// Targets that haven't been used for this many blits are freed. Stereo modes blit twice a frame.
+constexpr u64 RENDER_TARGET_EXPIRY_BLITS = 8;
+
+static PostProcessingConfiguration::RenderPass GetDefaultPass()
+{
+  PostProcessingConfiguration::RenderPass pass;
+  pass.inputs.push_back({PostProcessingConfiguration::RenderPass::InputType::ColorBuffer, 0});
+  return pass;
+}
+
 PostProcessingConfiguration::PostProcessingConfiguration() = default;
 
 PostProcessingConfiguration::~PostProcessingConfiguration() = default;
@@ -77,7 +90,13 @@ void PostProcessingConfiguration::LoadShader(const std::string& shader)
     return;
   }
 
-  LoadOptions(code);
+  if (!LoadOptions(code))
+  {
+    ERROR_LOG(VIDEO, "Invalid pass configuration in post-processing shader %s", path.c_str());
+    LoadDefaultShader();
+    return;
+  }
+
   LoadOptionsConfiguration();
   m_current_shader_code = code;
 }
@@ -85,11 +104,12 @@ void PostProcessingConfiguration::LoadShader(const std::string& shader)
 void PostProcessingConfiguration::LoadDefaultShader()
 {
   m_options.clear();
+  m_passes = {GetDefaultPass()};
   m_any_options_dirty = false;
   m_current_shader_code = s_default_shader;
 }
 
-void PostProcessingConfiguration::LoadOptions(const std::string& code)
+bool PostProcessingConfiguration::LoadOptions(const std::string& code)
 {
   const std::string config_start_delimiter = "[configuration]";
   const std::string config_end_delimiter = "[/configuration]";
@@ -97,12 +117,13 @@ void PostProcessingConfiguration::LoadOptions(const std::string& code)
   size_t configuration_end = code.find(config_end_delimiter);
 
   m_options.clear();
+  m_passes = {GetDefaultPass()};
   m_any_options_dirty = true;
 
   if (configuration_start == std::string::npos || configuration_end == std::string::npos)
   {
     // Issue loading configuration or there isn't one.
-    return;
+    return true;
   }
 
   std::string configuration_string =
@@ -161,8 +182,16 @@ void PostProcessingConfiguration::LoadOptions(const std::string& code)
     }
   }
 
+  m_passes.clear();
   for (const auto& it : option_strings)
   {
+    if (it.m_type == "Pass")
+    {
+      if (!LoadPass(it.m_options))
+        return false;
+      continue;
+    }
+
     ConfigurationOption option;
     option.m_dirty = true;
 
@@ -234,6 +263,77 @@ void PostProcessingConfiguration::LoadOptions(const std::string& code)
     }
     m_options[option.m_option_name] = option;
   }
+
+  if (m_passes.empty())
+    m_passes.push_back(GetDefaultPass());
+
+  return true;
+}
+
+bool PostProcessingConfiguration::LoadPass(
+    const std::vector<std::pair<std::string, std::string>>& options)
+{
+  RenderPass pass;
+  std::array<std::string, MAX_PASS_INPUTS> input_names;
+  for (const auto& [key, value] : options)
+  {
+    if (key == "EntryPoint")
+    {
+      pass.entry_point = value;
+    }
+    else if (key == "Output")
+    {
+      pass.output_name = value;
+    }
+    else if (key == "OutputScale")
+    {
+      if (!TryParse(value, &pass.output_scale) || pass.output_scale <= 0.0f)
+        return false;
+    }
+    else if (key.size() == 6 && key.compare(0, 5, "Input") == 0 && key[5] >= '0' &&
+             key[5] < static_cast<char>('0' + MAX_PASS_INPUTS))
+    {
+      input_names[key[5] - '0'] = value;
+    }
+  }
+
+  // Inputs are ColorBuffer, PreviousPass or the output name of an earlier pass, bound to
+  // consecutive samplers from Input0 on.
+  if (input_names[0].empty())
+    input_names[0] = "PreviousPass";
+
+  for (const std::string& name : input_names)
+  {
+    if (name.empty())
+      break;
+
+    if (name == "ColorBuffer" || (name == "PreviousPass" && m_passes.empty()))
+    {
+      pass.inputs.push_back({RenderPass::InputType::ColorBuffer, 0});
+      continue;
+    }
+
+    if (name == "PreviousPass")
+    {
+      pass.inputs.push_back({RenderPass::InputType::PassOutput, m_passes.size() - 1});
+      continue;
+    }
+
+    const auto iter = std::find_if(m_passes.begin(), m_passes.end(),
+                                   [&name](const RenderPass& p) { return p.output_name == name; });
+    if (iter == m_passes.end())
+    {
+      ERROR_LOG(VIDEO, "Post-processing pass input %s is not the output of an earlier pass",
+                name.c_str());
+      return false;
+    }
+
+    pass.inputs.push_back({RenderPass::InputType::PassOutput,
+                           static_cast<size_t>(std::distance(m_passes.begin(), iter))});
+  }
+
+  m_passes.push_back(std::move(pass));
+  return true;
 }
 
 void PostProcessingConfiguration::LoadOptionsConfiguration()
@@ -386,7 +486,7 @@ std::vector<std::string> PostProcessing::GetPassiveShaderList()
 bool PostProcessing::Initialize(AbstractTextureFormat format)
 {
   m_framebuffer_format = format;
-  if (!CompileVertexShader() || !CompilePixelShader() || !CompilePipeline())
+  if (!CompileVertexShader() || !CompilePixelShaders() || !CompilePipelines())
     return false;
 
   return true;
@@ -394,43 +494,180 @@ bool PostProcessing::Initialize(AbstractTextureFormat format)
 
 void PostProcessing::RecompileShader()
 {
-  m_pipeline.reset();
-  m_pixel_shader.reset();
-  if (!CompilePixelShader())
+  m_pipelines.clear();
+  m_pixel_shaders.clear();
+  if (!CompilePixelShaders())
     return;
 
-  CompilePipeline();
+  CompilePipelines();
 }
 
 void PostProcessing::RecompilePipeline()
 {
-  m_pipeline.reset();
-  CompilePipeline();
+  m_pipelines.clear();
+  CompilePipelines();
 }
 
 void PostProcessing::BlitFromTexture(const MathUtil::Rectangle<int>& dst,
                                      const MathUtil::Rectangle<int>& src,
                                      const AbstractTexture* src_tex, int src_layer)
 {
-  if (g_renderer->GetCurrentFramebuffer()->GetColorFormat() != m_framebuffer_format)
+  AbstractFramebuffer* const output_framebuffer = g_renderer->GetCurrentFramebuffer();
+  if (output_framebuffer->GetColorFormat() != m_framebuffer_format)
   {
-    m_framebuffer_format = g_renderer->GetCurrentFramebuffer()->GetColorFormat();
+    m_framebuffer_format = output_framebuffer->GetColorFormat();
+    m_render_target_pool.clear();
     RecompilePipeline();
   }
 
-  if (!m_pipeline)
+  const auto& passes = m_config.GetPasses();
+  if (m_pipelines.empty() || m_pipelines.size() != passes.size())
     return;
 
-  FillUniformBuffer(src, src_tex, src_layer);
-  g_vertex_manager->UploadUtilityUniforms(m_uniform_staging_buffer.data(),
-                                          static_cast<u32>(m_uniform_staging_buffer.size()));
+  m_blit_count++;
+
+  const float rcp_src_width = 1.0f / src_tex->GetWidth();
+  const float rcp_src_height = 1.0f / src_tex->GetHeight();
+  const PassInput color_buffer = {src_tex,
+                                  {static_cast<float>(src.left) * rcp_src_width,
+                                   static_cast<float>(src.top) * rcp_src_height,
+                                   static_cast<float>(src.GetWidth()) * rcp_src_width,
+                                   static_cast<float>(src.GetHeight()) * rcp_src_height},
+                                  src_layer};
+
+  // Pass outputs hold the whole source image. On backends with a lower-left origin, drawing into
+  // a texture flips it relative to how it's sampled, so read those upside down.
+  std::array<float, 4> intermediate_rect = {0.0f, 0.0f, 1.0f, 1.0f};
+  if (g_ActiveConfig.backend_info.bUsesLowerLeftOrigin)
+    intermediate_rect = {0.0f, 1.0f, 1.0f, -1.0f};
+
+  // Each output goes back to the pool after the last pass that reads it.
+  std::vector<size_t> pass_targets(passes.size());
+  std::vector<size_t> last_reads(passes.size());
+  for (size_t i = 0; i < passes.size(); i++)
+  {
+    last_reads[i] = i;
+    for (const auto& input : passes[i].inputs)
+    {
+      if (input.type == PostProcessingConfiguration::RenderPass::InputType::PassOutput)
+        last_reads[input.pass_index] = i;
+    }
+  }
+
+  std::vector<PassInput> inputs;
+  for (size_t i = 0; i < passes.size(); i++)
+  {
+    const auto& pass = passes[i];
+    const bool is_last_pass = i + 1 == passes.size();
+
+    inputs.clear();
+    for (const auto& input : pass.inputs)
+    {
+      if (input.type == PostProcessingConfiguration::RenderPass::InputType::ColorBuffer)
+      {
+        inputs.push_back(color_buffer);
+      }
+      else
+      {
+        inputs.push_back({m_render_target_pool[pass_targets[input.pass_index]].texture.get(),
+                          intermediate_rect, 0});
+      }
+    }
+
+    AbstractTexture* output_texture = nullptr;
+    if (is_last_pass)
+    {
+      g_renderer->SetFramebuffer(output_framebuffer);
+      g_renderer->SetViewportAndScissor(
+          g_renderer->ConvertFramebufferRectangle(dst, output_framebuffer));
+    }
+    else
+    {
+      const u32 width = std::max(static_cast<u32>(src.GetWidth() * pass.output_scale + 0.5f), 1u);
+      const u32 height =
+          std::max(static_cast<u32>(src.GetHeight() * pass.output_scale + 0.5f), 1u);
+      const std::optional<size_t> target_index = AcquireRenderTarget(width, height);
+      if (!target_index)
+      {
+        for (RenderTarget& target : m_render_target_pool)
+          target.in_use = false;
+        g_renderer->SetFramebuffer(output_framebuffer);
+        return;
+      }
+
+      pass_targets[i] = *target_index;
+      const RenderTarget& target = m_render_target_pool[pass_targets[i]];
+      output_texture = target.texture.get();
+      g_renderer->SetAndDiscardFramebuffer(target.framebuffer.get());
+      g_renderer->SetViewportAndScissor(target.framebuffer->GetRect());
+    }
+
+    FillUniformBuffer(inputs);
+    g_vertex_manager->UploadUtilityUniforms(m_uniform_staging_buffer.data(),
+                                            static_cast<u32>(m_uniform_staging_buffer.size()));
+
+    g_renderer->SetPipeline(m_pipelines[i].get());
+    for (u32 j = 0; j < PostProcessingConfiguration::MAX_PASS_INPUTS; j++)
+    {
+      // Unused samplers get the first input, so that every binding is valid.
+      g_renderer->SetTexture(j, inputs[j < inputs.size() ? j : 0].texture);
+      g_renderer->SetSamplerState(j, RenderState::GetLinearSamplerState());
+    }
+    g_renderer->Draw(0, 3);
+
+    if (output_texture)
+      output_texture->FinishedRendering();
+
+    for (size_t j = 0; j <= i && j + 1 < passes.size(); j++)
+    {
+      if (last_reads[j] == i)
+        m_render_target_pool[pass_targets[j]].in_use = false;
+    }
+  }
 
-  g_renderer->SetViewportAndScissor(
-      g_renderer->ConvertFramebufferRectangle(dst, g_renderer->GetCurrentFramebuffer()));
-  g_renderer->SetPipeline(m_pipeline.get());
-  g_renderer->SetTexture(0, src_tex);
-  g_renderer->SetSamplerState(0, RenderState::GetLinearSamplerState());
-  g_renderer->Draw(0, 3);
+  FreeStaleRenderTargets();
+}
+
+std::optional<size_t> PostProcessing::AcquireRenderTarget(u32 width, u32 height)
+{
+  for (size_t i = 0; i < m_render_target_pool.size(); i++)
+  {
+    RenderTarget& target = m_render_target_pool[i];
+    if (!target.in_use && target.texture->GetWidth() == width &&
+        target.texture->GetHeight() == height)
+    {
+      target.in_use = true;
+      target.last_used = m_blit_count;
+      return i;
+    }
+  }
+
+  RenderTarget target;
+  const TextureConfig config(width, height, 1, 1, 1, m_framebuffer_format,
+                             AbstractTextureFlag_RenderTarget);
+  target.texture = g_renderer->CreateTexture(config);
+  if (!target.texture)
+    return std::nullopt;
+
+  target.framebuffer = g_renderer->CreateFramebuffer(target.texture.get(), nullptr);
+  if (!target.framebuffer)
+    return std::nullopt;
+
+  target.in_use = true;
+  target.last_used = m_blit_count;
+  m_render_target_pool.push_back(std::move(target));
+  return m_render_target_pool.size() - 1;
+}
+
+void PostProcessing::FreeStaleRenderTargets()
+{
+  m_render_target_pool.erase(
+      std::remove_if(m_render_target_pool.begin(), m_render_target_pool.end(),
+                     [this](const RenderTarget& target) {
+                       return !target.in_use &&
+                              target.last_used + RENDER_TARGET_EXPIRY_BLITS < m_blit_count;
+                     }),
+      m_render_target_pool.end());
 }
 
 std::string PostProcessing::GetUniformBufferHeader() const
@@ -450,6 +687,10 @@ std::string PostProcessing::GetUniformBufferHeader() const
   ss << "  uint time;\n";
   for (u32 i = 0; i < 2; i++)
     ss << "  uint ubo_align_" << unused_counter++ << "_;\n";
+  ss << fmt::format("  float4 input_resolution[{}];\n",
+                    PostProcessingConfiguration::MAX_PASS_INPUTS);
+  ss << fmt::format("  float4 input_rect[{}];\n", PostProcessingConfiguration::MAX_PASS_INPUTS);
+  ss << "  int4 input_layer;\n";
   ss << "\n";
 
   // Custom options/uniforms
@@ -498,12 +739,16 @@ std::string PostProcessing::GetHeader() const
   ss << GetUniformBufferHeader();
   if (g_ActiveConfig.backend_info.api_type == APIType::D3D)
   {
-    ss << "Texture2DArray samp0 : register(t0);\n";
-    ss << "SamplerState samp0_ss : register(s0);\n";
+    for (u32 i = 0; i < PostProcessingConfiguration::MAX_PASS_INPUTS; i++)
+    {
+      ss << fmt::format("Texture2DArray samp{0} : register(t{0});\n", i);
+      ss << fmt::format("SamplerState samp{0}_ss : register(s{0});\n", i);
+    }
   }
   else
   {
-    ss << "SAMPLER_BINDING(0) uniform sampler2DArray samp0;\n";
+    for (u32 i = 0; i < PostProcessingConfiguration::MAX_PASS_INPUTS; i++)
+      ss << fmt::format("SAMPLER_BINDING({0}) uniform sampler2DArray samp{0};\n", i);
 
     if (g_ActiveConfig.backend_info.bSupportsGeometryShaders)
     {
@@ -569,6 +814,41 @@ uint GetTime()
   return time;
 }
 
+// Coordinates within the source image, which every input of a pass covers.
+float2 GetNormalizedCoordinates()
+{
+  return (v_tex0.xy - src_rect.xy) / src_rect.zw;
+}
+
+float2 GetInputResolution(int input)
+{
+  return input_resolution[input].xy;
+}
+
+float2 GetInvInputResolution(int input)
+{
+  return input_resolution[input].zw;
+}
+
+float4 SampleInputLocation(int input, float2 location)
+{
+  float3 coords = float3(input_rect[input].xy + location * input_rect[input].zw,
+                         float(input_layer[input]));
+  if (input == 1)
+    return texture(samp1, coords);
+  else if (input == 2)
+    return texture(samp2, coords);
+  else if (input == 3)
+    return texture(samp3, coords);
+  else
+    return texture(samp0, coords);
+}
+
+float4 SampleInput(int input)
+{
+  return SampleInputLocation(input, GetNormalizedCoordinates());
+}
+
 void SetOutput(float4 color)
 {
   ocol0 = color;
@@ -581,19 +861,24 @@ void SetOutput(float4 color)
   return ss.str();
 }
 
-std::string PostProcessing::GetFooter() const
+std::string PostProcessing::GetFooter(const std::string& entry_point) const
 {
   if (g_ActiveConfig.backend_info.api_type == APIType::D3D)
   {
-    return R"(
+    return fmt::format(R"(
 
 #undef main
 void main(in float3 v_tex0_ : TEXCOORD0, out float4 ocol0_ : SV_Target)
-{
+{{
   v_tex0 = v_tex0_;
-  real_main();
+  {}();
   ocol0_ = ocol0;
-})";
+}})",
+                       entry_point == "main" ? "real_main" : entry_point);
+  }
+  else if (entry_point != "main")
+  {
+    return fmt::format("\n\nvoid main() {{ {}(); }}\n", entry_point);
   }
   else
   {
@@ -655,6 +940,9 @@ struct BuiltinUniforms
   s32 src_layer;
   u32 time;
   u32 padding[2];
+  float input_resolution[PostProcessingConfiguration::MAX_PASS_INPUTS][4];
+  float input_rect[PostProcessingConfiguration::MAX_PASS_INPUTS][4];
+  s32 input_layer[PostProcessingConfiguration::MAX_PASS_INPUTS];
 };
 
 size_t PostProcessing::CalculateUniformsSize() const
@@ -663,23 +951,30 @@ size_t PostProcessing::CalculateUniformsSize() const
   return sizeof(BuiltinUniforms) + m_config.GetOptions().size() * sizeof(float) * 4;
 }
 
-void PostProcessing::FillUniformBuffer(const MathUtil::Rectangle<int>& src,
-                                       const AbstractTexture* src_tex, int src_layer)
+void PostProcessing::FillUniformBuffer(const std::vector<PassInput>& inputs)
 {
   const auto& window_rect = g_renderer->GetTargetRectangle();
-  const float rcp_src_width = 1.0f / src_tex->GetWidth();
-  const float rcp_src_height = 1.0f / src_tex->GetHeight();
-  BuiltinUniforms builtin_uniforms = {
-      {static_cast<float>(src_tex->GetWidth()), static_cast<float>(src_tex->GetHeight()),
-       rcp_src_width, rcp_src_height},
-      {static_cast<float>(window_rect.GetWidth()), static_cast<float>(window_rect.GetHeight()),
-       0.0f, 0.0f},
-      {static_cast<float>(src.left) * rcp_src_width, static_cast<float>(src.top) * rcp_src_height,
-       static_cast<float>(src.GetWidth()) * rcp_src_width,
-       static_cast<float>(src.GetHeight()) * rcp_src_height},
-      static_cast<s32>(src_layer),
-      static_cast<u32>(m_timer.GetTimeElapsed()),
-  };
+  BuiltinUniforms builtin_uniforms = {};
+  builtin_uniforms.window_resolution[0] = static_cast<float>(window_rect.GetWidth());
+  builtin_uniforms.window_resolution[1] = static_cast<float>(window_rect.GetHeight());
+  builtin_uniforms.time = static_cast<u32>(m_timer.GetTimeElapsed());
+
+  // Unused inputs repeat the first one, like their sampler bindings.
+  for (u32 i = 0; i < PostProcessingConfiguration::MAX_PASS_INPUTS; i++)
+  {
+    const PassInput& input = inputs[i < inputs.size() ? i : 0];
+    const float width = static_cast<float>(input.texture->GetWidth());
+    const float height = static_cast<float>(input.texture->GetHeight());
+    const float resolution[4] = {width, height, 1.0f / width, 1.0f / height};
+    std::copy_n(resolution, 4, builtin_uniforms.input_resolution[i]);
+    std::copy_n(input.rect.begin(), 4, builtin_uniforms.input_rect[i]);
+    builtin_uniforms.input_layer[i] = input.layer;
+  }
+
+  // The plain Sample() functions and the vertex shader work on the first input.
+  std::copy_n(builtin_uniforms.input_resolution[0], 4, builtin_uniforms.resolution);
+  std::copy_n(builtin_uniforms.input_rect[0], 4, builtin_uniforms.src_rect);
+  builtin_uniforms.src_layer = inputs[0].layer;
 
   u8* buf = m_uniform_staging_buffer.data();
   std::memcpy(buf, &builtin_uniforms, sizeof(builtin_uniforms));
@@ -718,24 +1013,20 @@ void PostProcessing::FillUniformBuffer(const MathUtil::Rectangle<int>& src,
   }
 }
 
-bool PostProcessing::CompilePixelShader()
+bool PostProcessing::CompilePixelShaders()
 {
-  m_pipeline.reset();
-  m_pixel_shader.reset();
+  m_pipelines.clear();
+  m_pixel_shaders.clear();
 
   // Generate GLSL and compile the new shader.
   m_config.LoadShader(g_ActiveConfig.sPostProcessingShader);
-  m_pixel_shader = g_renderer->CreateShaderFromSource(
-      ShaderStage::Pixel, GetHeader() + m_config.GetShaderCode() + GetFooter());
-  if (!m_pixel_shader)
+  if (!CompilePassShaders())
   {
     PanicAlert("Failed to compile post-processing shader %s", m_config.GetShader().c_str());
 
     // Use default shader.
     m_config.LoadDefaultShader();
-    m_pixel_shader = g_renderer->CreateShaderFromSource(
-        ShaderStage::Pixel, GetHeader() + m_config.GetShaderCode() + GetFooter());
-    if (!m_pixel_shader)
+    if (!CompilePassShaders())
       return false;
   }
 
@@ -743,21 +1034,51 @@ bool PostProcessing::CompilePixelShader()
   return true;
 }
 
-bool PostProcessing::CompilePipeline()
+bool PostProcessing::CompilePassShaders()
+{
+  // Every pass is compiled from the same source, with its entry point called from main.
+  const std::string source = GetHeader() + m_config.GetShaderCode();
+  for (const auto& pass : m_config.GetPasses())
+  {
+    std::unique_ptr<AbstractShader> shader = g_renderer->CreateShaderFromSource(
+        ShaderStage::Pixel, source + GetFooter(pass.entry_point));
+    if (!shader)
+    {
+      m_pixel_shaders.clear();
+      return false;
+    }
+
+    m_pixel_shaders.push_back(std::move(shader));
+  }
+
+  return true;
+}
+
+bool PostProcessing::CompilePipelines()
 {
   AbstractPipelineConfig config = {};
   config.vertex_shader = m_vertex_shader.get();
   config.geometry_shader =
       g_renderer->UseGeometryShaderForUI() ? g_shader_cache->GetTexcoordGeometryShader() : nullptr;
-  config.pixel_shader = m_pixel_shader.get();
   config.rasterization_state = RenderState::GetNoCullRasterizationState(PrimitiveType::Triangles);
   config.depth_state = RenderState::GetNoDepthTestingDepthState();
   config.blending_state = RenderState::GetNoBlendingBlendState();
   config.framebuffer_state = RenderState::GetColorFramebufferState(m_framebuffer_format);
   config.usage = AbstractPipelineUsage::Utility;
-  m_pipeline = g_renderer->CreatePipeline(config);
-  if (!m_pipeline)
-    return false;
+
+  // Intermediate targets use the output format, so all passes can share one framebuffer state.
+  for (const auto& pixel_shader : m_pixel_shaders)
+  {
+    config.pixel_shader = pixel_shader.get();
+    std::unique_ptr<AbstractPipeline> pipeline = g_renderer->CreatePipeline(config);
+    if (!pipeline)
+    {
+      m_pipelines.clear();
+      return false;
+    }
+
+    m_pipelines.push_back(std::move(pipeline));
+  }
 
   return true;
 }
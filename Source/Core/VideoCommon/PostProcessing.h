@@ -4,9 +4,12 @@
 
 #pragma once
 
+#include <array>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -14,6 +17,7 @@
 #include "Common/Timer.h"
 #include "VideoCommon/TextureConfig.h"
 
+class AbstractFramebuffer;
 class AbstractPipeline;
 class AbstractShader;
 class AbstractTexture;
@@ -56,6 +60,31 @@ public:
 
   using ConfigMap = std::map<std::string, ConfigurationOption>;
 
+  static constexpr u32 MAX_PASS_INPUTS = 4;
+
+  // Declared with [Pass] sections in the configuration. A shader without any runs main() once over
+  // the color buffer. Every pass but the last renders into an intermediate texture of output_scale
+  // times the source size, which later passes can read by the pass's output name.
+  struct RenderPass
+  {
+    enum class InputType
+    {
+      ColorBuffer,
+      PassOutput,
+    };
+
+    struct Input
+    {
+      InputType type;
+      size_t pass_index;
+    };
+
+    std::string entry_point = "main";
+    std::string output_name;
+    float output_scale = 1.0f;
+    std::vector<Input> inputs;
+  };
+
   PostProcessingConfiguration();
   virtual ~PostProcessingConfiguration();
 
@@ -73,6 +102,7 @@ public:
   const ConfigMap& GetOptions() const { return m_options; }
   ConfigMap& GetOptions() { return m_options; }
   const ConfigurationOption& GetOption(const std::string& option) { return m_options[option]; }
+  const std::vector<RenderPass>& GetPasses() const { return m_passes; }
   // For updating option's values
   void SetOptionf(const std::string& option, int index, float value);
   void SetOptioni(const std::string& option, int index, s32 value);
@@ -83,8 +113,10 @@ private:
   std::string m_current_shader;
   std::string m_current_shader_code;
   ConfigMap m_options;
+  std::vector<RenderPass> m_passes;
 
-  void LoadOptions(const std::string& code);
+  bool LoadOptions(const std::string& code);
+  bool LoadPass(const std::vector<std::pair<std::string, std::string>>& options);
   void LoadOptionsConfiguration();
 };
 
@@ -109,26 +141,51 @@ public:
                        const AbstractTexture* src_tex, int src_layer);
 
 protected:
+  struct PassInput
+  {
+    const AbstractTexture* texture;
+    // Normalized rectangle of the texture that holds the source image. Can be flipped.
+    std::array<float, 4> rect;
+    int layer;
+  };
+
+  struct RenderTarget
+  {
+    std::unique_ptr<AbstractTexture> texture;
+    std::unique_ptr<AbstractFramebuffer> framebuffer;
+    u64 last_used = 0;
+    bool in_use = false;
+  };
+
   std::string GetUniformBufferHeader() const;
   std::string GetHeader() const;
-  std::string GetFooter() const;
+  std::string GetFooter(const std::string& entry_point) const;
 
   bool CompileVertexShader();
-  bool CompilePixelShader();
-  bool CompilePipeline();
+  bool CompilePixelShaders();
+  bool CompilePassShaders();
+  bool CompilePipelines();
 
   size_t CalculateUniformsSize() const;
-  void FillUniformBuffer(const MathUtil::Rectangle<int>& src, const AbstractTexture* src_tex,
-                         int src_layer);
+  void FillUniformBuffer(const std::vector<PassInput>& inputs);
+
+  // Returns the index in m_render_target_pool of a free target of this size, creating it if needed.
+  std::optional<size_t> AcquireRenderTarget(u32 width, u32 height);
+  void FreeStaleRenderTargets();
 
   // Timer for determining our time value
   Common::Timer m_timer;
   PostProcessingConfiguration m_config;
 
   std::unique_ptr<AbstractShader> m_vertex_shader;
-  std::unique_ptr<AbstractShader> m_pixel_shader;
-  std::unique_ptr<AbstractPipeline> m_pipeline;
+  std::vector<std::unique_ptr<AbstractShader>> m_pixel_shaders;
+  std::vector<std::unique_ptr<AbstractPipeline>> m_pipelines;
   AbstractTextureFormat m_framebuffer_format = AbstractTextureFormat::Undefined;
   std::vector<u8> m_uniform_staging_buffer;
+
+  // Intermediate pass outputs. Targets are reused across passes once nothing reads them anymore,
+  // and across frames until they go unused for a while.
+  std::vector<RenderTarget> m_render_target_pool;
+  u64 m_blit_count = 0;
 };
 }  // namespace VideoCommon
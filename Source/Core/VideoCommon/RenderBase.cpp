@@ -21,6 +21,7 @@
 #include <mutex>
 #include <string>
 #include <tuple>
+#include <utility>
 
 #include <fmt/format.h>
 #include <imgui.h>
@@ -49,6 +50,8 @@
 #include "Core/HW/VideoInterface.h"
 #include "Core/Host.h"
 #include "Core/Movie.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/PowerPC.h"
 
 #include "InputCommon/ControllerInterface/ControllerInterface.h"
 
@@ -60,7 +63,9 @@
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/CommandProcessor.h"
 #include "VideoCommon/FPSCounter.h"
+#include "VideoCommon/Fifo.h"
 #include "VideoCommon/FrameDump.h"
+#include "VideoCommon/FrameProfiler.h"
 #include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/FramebufferShaderGen.h"
 #include "VideoCommon/FreeLookCamera.h"
@@ -87,11 +92,71 @@
 
 std::unique_ptr<Renderer> g_renderer;
 
+static std::mutex s_frame_readback_mutex;
+static Renderer::FrameReadbackCallback s_frame_readback_callback;
+static Common::Flag s_frame_readback_enabled;
+
 static float AspectToWidescreen(float aspect)
 {
   return aspect * ((16.0f / 9.0f) / (4.0f / 3.0f));
 }
 
+// Totals since the JIT was started, and how much each changed since the last frame was drawn
+static void DrawJitStatistics()
+{
+  static JitInterface::Statistics s_last_stats;
+  static u64 s_last_exceptions = 0;
+
+  const JitInterface::Statistics stats = JitInterface::GetStatistics();
+  const u64 exceptions = PowerPC::GetExceptionCount();
+
+  const float scale = ImGui::GetIO().DisplayFramebufferScale.x;
+  ImGui::SetNextWindowPos(ImVec2(300.0f * scale, 10.0f * scale), ImGuiCond_FirstUseEver);
+  ImGui::SetNextWindowSize(ImVec2(320.0f * scale, 0.0f), ImGuiCond_FirstUseEver);
+  if (ImGui::Begin("JIT Statistics", nullptr, ImGuiWindowFlags_NoNavInputs))
+  {
+    ImGui::Columns(3, "JIT Statistics", true);
+    ImGui::TextUnformatted("");
+    ImGui::NextColumn();
+    ImGui::TextUnformatted("Total");
+    ImGui::NextColumn();
+    ImGui::TextUnformatted("This frame");
+    ImGui::NextColumn();
+
+    const auto draw_statistic = [](const char* name, u64 total, u64 last_total) {
+      ImGui::TextUnformatted(name);
+      ImGui::NextColumn();
+      ImGui::Text("%" PRIu64, total);
+      ImGui::NextColumn();
+      // The counters restart from zero when the JIT is shut down and started again
+      ImGui::Text("%" PRIu64, total >= last_total ? total - last_total : total);
+      ImGui::NextColumn();
+    };
+
+    draw_statistic("Fast map misses", stats.fast_map_misses, s_last_stats.fast_map_misses);
+    draw_statistic("Block cache misses", stats.block_cache_misses,
+                   s_last_stats.block_cache_misses);
+    draw_statistic("Blocks compiled", stats.blocks_compiled, s_last_stats.blocks_compiled);
+    draw_statistic("Bytes emitted", stats.bytes_emitted, s_last_stats.bytes_emitted);
+    draw_statistic("Compile time (us)", stats.compile_time_us, s_last_stats.compile_time_us);
+    draw_statistic("ICache invalidations", stats.icache_invalidations,
+                   s_last_stats.icache_invalidations);
+    draw_statistic("Blocks destroyed", stats.blocks_destroyed, s_last_stats.blocks_destroyed);
+    draw_statistic("Full cache clears", stats.full_cache_clears, s_last_stats.full_cache_clears);
+    draw_statistic("Segment evictions", stats.code_segment_evictions,
+                   s_last_stats.code_segment_evictions);
+    draw_statistic("Backpatched faults", stats.backpatched_faults,
+                   s_last_stats.backpatched_faults);
+    draw_statistic("Exception exits", exceptions, s_last_exceptions);
+
+    ImGui::Columns(1);
+  }
+  ImGui::End();
+
+  s_last_stats = stats;
+  s_last_exceptions = exceptions;
+}
+
 Renderer::Renderer(int backbuffer_width, int backbuffer_height, float backbuffer_scale,
                    AbstractTextureFormat backbuffer_format)
     : m_backbuffer_width(backbuffer_width), m_backbuffer_height(backbuffer_height),
@@ -129,6 +194,7 @@ void Renderer::Shutdown()
   // can require additional graphics sub-systems so it needs to be done first
   ShutdownFrameDumping();
   ShutdownImGui();
+  FrameProfiler::Shutdown();
   m_post_processor.reset();
 }
 
@@ -324,6 +390,19 @@ bool Renderer::CalculateTargetSize()
   if (max_size < EFB_WIDTH * m_efb_scale)
     m_efb_scale = max_size / EFB_WIDTH;
 
+  // The configured scale is the upper bound for dynamic resolution.
+  if (UseDynamicResolution())
+  {
+    const u32 min_scale =
+        std::min(static_cast<u32>(std::max(g_ActiveConfig.iDynamicResolutionMinScale, 1)),
+                 m_efb_scale);
+    m_efb_scale = m_dynamic_resolution.GetScale(min_scale, m_efb_scale);
+  }
+  else
+  {
+    m_dynamic_resolution.Reset();
+  }
+
   auto [new_efb_width, new_efb_height] = CalculateTargetScale(EFB_WIDTH, EFB_HEIGHT);
   new_efb_width = std::max(new_efb_width, 1);
   new_efb_height = std::max(new_efb_height, 1);
@@ -333,11 +412,20 @@ bool Renderer::CalculateTargetSize()
     m_target_width = new_efb_width;
     m_target_height = new_efb_height;
     PixelShaderManager::SetEfbScaleChanged(EFBToScaledXf(1), EFBToScaledYf(1));
+    // The viewport constants are scaled as well, and games rewriting the same viewport no longer
+    // recompute them
+    VertexShaderManager::SetViewportChanged();
     return true;
   }
   return false;
 }
 
+bool Renderer::UseDynamicResolution() const
+{
+  // Headroom is judged from the GPU thread's idle time, which only exists in dual core.
+  return g_ActiveConfig.bDynamicResolution && SConfig::GetInstance().bCPUThread;
+}
+
 std::tuple<MathUtil::Rectangle<int>, MathUtil::Rectangle<int>>
 Renderer::ConvertStereoRectangle(const MathUtil::Rectangle<int>& rc) const
 {
@@ -478,6 +566,8 @@ void Renderer::CheckForConfigChanges()
     g_shader_cache->SetHostConfig(new_host_config);
     g_shader_cache->Reload();
     g_framebuffer_manager->RecompileShaders();
+    // Vertex rounding changes how the viewport constants are computed
+    VertexShaderManager::SetViewportChanged();
   }
 
   // Viewport and scissor rect have to be reset since they will be scaled differently.
@@ -555,6 +645,12 @@ void Renderer::DrawDebugText()
   if (g_ActiveConfig.bOverlayStats)
     g_stats.Display();
 
+  if (g_ActiveConfig.bOverlayProfiler)
+    FrameProfiler::Display();
+
+  if (g_ActiveConfig.bOverlayJitStats)
+    DrawJitStatistics();
+
   if (g_ActiveConfig.bShowNetPlayMessages && g_netplay_chat_ui)
     g_netplay_chat_ui->Display();
 
@@ -1119,6 +1215,27 @@ std::unique_lock<std::mutex> Renderer::GetImGuiLock()
   return std::unique_lock<std::mutex>(m_imgui_mutex);
 }
 
+void Renderer::SetFrameTimingRecording(bool enabled)
+{
+  std::lock_guard<std::mutex> guard(m_frame_timings_mutex);
+  m_record_frame_timings = enabled;
+}
+
+std::vector<Renderer::FrameTiming> Renderer::TakeFrameTimings()
+{
+  std::vector<FrameTiming> timings;
+  std::lock_guard<std::mutex> guard(m_frame_timings_mutex);
+  timings.swap(m_frame_timings);
+  return timings;
+}
+
+void Renderer::SetFrameReadbackCallback(FrameReadbackCallback callback)
+{
+  std::lock_guard<std::mutex> guard(s_frame_readback_mutex);
+  s_frame_readback_enabled.Set(callback != nullptr);
+  s_frame_readback_callback = std::move(callback);
+}
+
 void Renderer::BeginUIFrame()
 {
   if (IsHeadless())
@@ -1202,6 +1319,8 @@ void Renderer::UpdateWidescreenHeuristic()
 
 void Renderer::Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u64 ticks)
 {
+  const u64 swap_start_us = Common::Timer::GetTimeUs();
+
   if (SConfig::GetInstance().bWii)
     m_is_game_widescreen = Config::Get(Config::SYSCONF_WIDESCREEN);
 
@@ -1221,10 +1340,10 @@ void Renderer::Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u6
       m_is_game_widescreen = true;
   }
 
-  // Ensure the last frame was written to the dump.
-  // This is required even if frame dumping has stopped, since the frame dump is one frame
-  // behind the renderer.
-  FlushFrameDump();
+  // Ensure the frames from FRAME_DUMP_READBACK_LATENCY swaps ago are written to the dump.
+  // This is required even if frame dumping has stopped, since the frame dump is behind the
+  // renderer.
+  FlushFrameDump(FRAME_DUMP_READBACK_LATENCY - 1);
 
   if (xfb_addr && fb_width && fb_stride && fb_height)
   {
@@ -1253,8 +1372,9 @@ void Renderer::Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u6
       }
 
       // Render the XFB to the screen.
+      u64 present_duration_us = 0;
       BeginUtilityDrawing();
-      if (!IsHeadless())
+      if (!IsHeadless() && !m_skip_frame_draws)
       {
         BindBackbuffer({{0.0f, 0.0f, 0.0f, 1.0f}});
 
@@ -1273,16 +1393,31 @@ void Renderer::Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u6
         DrawImGui();
 
         // Present to the window system.
+        const u64 present_start_us = Common::Timer::GetTimeUs();
         {
           std::lock_guard<std::mutex> guard(m_swap_mutex);
           PresentBackbuffer();
         }
+        present_duration_us = Common::Timer::GetTimeUs() - present_start_us;
 
         // Update the window size based on the frame that was just rendered.
         // Due to depending on guest state, we need to call this every frame.
         SetWindowSize(xfb_rect.GetWidth(), xfb_rect.GetHeight());
       }
 
+      const u64 gpu_idle_us = Fifo::TakeGpuThreadIdleTime();
+      FrameProfiler::AddTime(FrameProfiler::Category::GPUThreadIdle, gpu_idle_us);
+      FrameProfiler::AddTime(FrameProfiler::Category::SwapWait, present_duration_us);
+
+      // Waiting on vsync is not rendering cost, so it counts as idle.
+      if (UseDynamicResolution())
+      {
+        const u64 idle_us = gpu_idle_us + present_duration_us;
+        if (m_last_swap_start_us != 0)
+          m_dynamic_resolution.Update(swap_start_us - m_last_swap_start_us, idle_us);
+      }
+      m_last_swap_start_us = swap_start_us;
+
       if (!is_duplicate_frame)
       {
         m_fps_counter.Update();
@@ -1299,10 +1434,12 @@ void Renderer::Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u6
         // Begin new frame
         m_frame_count++;
         g_stats.ResetFrame();
+        m_skip_frame_draws = ShouldSkipFrameDraws();
       }
 
       g_shader_cache->RetrieveAsyncShaders();
       g_vertex_manager->OnEndFrame();
+      g_framebuffer_manager->OnEndFrame();
       BeginImGuiFrame();
 
       // We invalidate the pipeline object at the start of the frame.
@@ -1313,13 +1450,28 @@ void Renderer::Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u6
 
       // Flush any outstanding EFB copies to RAM, in case the game is running at an uncapped frame
       // rate and not waiting for vblank. Otherwise, we'd end up with a huge list of pending copies.
-      g_texture_cache->FlushEFBCopies();
+      g_texture_cache->FlushEFBCopiesAtEndOfFrame();
 
       if (!is_duplicate_frame)
       {
         // Remove stale EFB/XFB copies.
         g_texture_cache->Cleanup(m_frame_count);
         Core::Callback_FramePresented();
+
+        const u64 present_time_us = Common::Timer::GetTimeUs();
+        {
+          std::lock_guard<std::mutex> guard(m_frame_timings_mutex);
+          if (m_record_frame_timings)
+          {
+            m_frame_timings.push_back(
+                {present_time_us - m_last_present_time_us, present_time_us - swap_start_us});
+          }
+        }
+        if (m_last_present_time_us != 0)
+          FrameProfiler::EndFrame(present_time_us - m_last_present_time_us);
+        FrameProfiler::SetEnabled(g_ActiveConfig.bOverlayProfiler ||
+                                  g_ActiveConfig.bExportProfilerCSV);
+        m_last_present_time_us = present_time_us;
       }
 
       // Handle any config changes, this gets propogated to the backend.
@@ -1364,6 +1516,25 @@ void Renderer::RenderXFBToScreen(const MathUtil::Rectangle<int>& target_rc,
   }
 }
 
+bool Renderer::ShouldSkipFrameDraws() const
+{
+  const int frame_skip = g_ActiveConfig.iFrameSkip;
+  if (frame_skip <= 0 || IsFrameDumping())
+    return false;
+
+  // Only for fast-forwarding, when nobody is watching every frame anyway
+  if (SConfig::GetInstance().m_EmulationSpeed > 0.0f && !Core::GetIsThrottlerTempDisabled())
+    return false;
+
+  // Perf query results and EFB copies to RAM are visible to the game, so those frames can't be
+  // skipped without changing what it does. Bounding box is checked for each draw. EFB peeks and
+  // XFB copies in skipped frames see the last frame that was drawn.
+  if (g_ActiveConfig.bPerfQueriesEnable || !g_ActiveConfig.bSkipEFBCopyToRam)
+    return false;
+
+  return m_frame_count % (frame_skip + 1) != 0;
+}
+
 bool Renderer::IsFrameDumping() const
 {
   if (m_screenshot_request.IsSet())
@@ -1372,6 +1543,9 @@ bool Renderer::IsFrameDumping() const
   if (SConfig::GetInstance().m_DumpFrames)
     return true;
 
+  if (s_frame_readback_enabled.IsSet())
+    return true;
+
   return false;
 }
 
@@ -1405,17 +1579,73 @@ void Renderer::DumpCurrentFrame(const AbstractTexture* src_texture,
     copy_rect = src_texture->GetRect();
   }
 
-  // Index 0 was just sent to FFMPEG dump. Swap with the second texture.
-  if (m_frame_dump_readback_textures[0])
-    std::swap(m_frame_dump_readback_textures[0], m_frame_dump_readback_textures[1]);
+  // Screenshots and readback callbacks want RGBA8, so only video frames are converted. The NV12
+  // image is a quarter of the width in RGBA8 texels and half again as high.
+  const bool screenshot = m_screenshot_request.TestAndClear();
+  FrameDump::PixelFormat format = FrameDump::PixelFormat::RGBA8;
+  if (!screenshot && ShouldConvertFrameDumpToNV12(target_width, target_height) &&
+      ConvertFrameDumpToNV12(src_texture, copy_rect))
+  {
+    format = FrameDump::PixelFormat::NV12;
+    src_texture = m_frame_dump_nv12_texture.get();
+    copy_rect = MathUtil::Rectangle<int>(0, 0, target_width / 4, target_height * 3 / 2);
+  }
 
-  if (!CheckFrameDumpReadbackTexture(target_width, target_height))
+  // Move on to the next texture in the ring, which is older than all of the pending readbacks.
+  m_frame_dump_readback_index =
+      (m_frame_dump_readback_index + 1) % NUM_FRAME_DUMP_READBACK_TEXTURES;
+  ReleaseFrameDumpReadbackTexture(m_frame_dump_readback_index);
+
+  if (!CheckFrameDumpReadbackTexture(copy_rect.GetWidth(), copy_rect.GetHeight()))
     return;
 
-  m_frame_dump_readback_textures[0]->CopyFromTexture(src_texture, copy_rect, 0, 0,
-                                                     m_frame_dump_readback_textures[0]->GetRect());
-  m_last_frame_state = FrameDump::FetchState(ticks);
-  m_last_frame_exported = true;
+  AbstractStagingTexture* readback_texture =
+      m_frame_dump_readback_textures[m_frame_dump_readback_index].get();
+  readback_texture->CopyFromTexture(src_texture, copy_rect, 0, 0, readback_texture->GetRect());
+  m_pending_frame_dumps.push_back(FrameDumpConfig{nullptr, target_width, target_height, 0, format,
+                                                  screenshot, m_frame_dump_readback_index,
+                                                  FrameDump::FetchState(ticks)});
+}
+
+bool Renderer::ShouldConvertFrameDumpToNV12(u32 target_width, u32 target_height) const
+{
+  if (!SConfig::GetInstance().m_DumpFrames || g_ActiveConfig.bDumpFramesAsImages ||
+      s_frame_readback_enabled.IsSet() || !FrameDump::WantsNV12Frames())
+  {
+    return false;
+  }
+
+  // Each texel holds four luma samples, or two chroma pairs from two rows.
+  return target_width % 4 == 0 && target_height % 2 == 0;
+}
+
+bool Renderer::ConvertFrameDumpToNV12(const AbstractTexture* src_texture,
+                                      const MathUtil::Rectangle<int>& src_rect)
+{
+  const AbstractPipeline* pipeline = g_shader_cache->GetNV12ConversionPipeline();
+  if (!pipeline || !CheckFrameDumpNV12Texture(src_rect.GetWidth(), src_rect.GetHeight()))
+    return false;
+
+  BeginUtilityDrawing();
+
+  struct Uniforms
+  {
+    s32 src_offset[2];
+    s32 luma_height;
+    s32 padding;
+  };
+  const Uniforms uniforms = {{src_rect.left, src_rect.top}, src_rect.GetHeight(), 0};
+  g_vertex_manager->UploadUtilityUniforms(&uniforms, sizeof(uniforms));
+
+  SetAndDiscardFramebuffer(m_frame_dump_nv12_framebuffer.get());
+  SetViewportAndScissor(m_frame_dump_nv12_framebuffer->GetRect());
+  SetPipeline(pipeline);
+  SetTexture(0, src_texture);
+  SetSamplerState(0, RenderState::GetPointSamplerState());
+  Draw(0, 3);
+  EndUtilityDrawing();
+  m_frame_dump_nv12_texture->FinishedRendering();
+  return true;
 }
 
 bool Renderer::CheckFrameDumpRenderTexture(u32 target_width, u32 target_height)
@@ -1444,9 +1674,31 @@ bool Renderer::CheckFrameDumpRenderTexture(u32 target_width, u32 target_height)
   return true;
 }
 
+bool Renderer::CheckFrameDumpNV12Texture(u32 target_width, u32 target_height)
+{
+  const u32 width = target_width / 4;
+  const u32 height = target_height * 3 / 2;
+  if (m_frame_dump_nv12_texture && m_frame_dump_nv12_texture->GetWidth() == width &&
+      m_frame_dump_nv12_texture->GetHeight() == height)
+  {
+    return true;
+  }
+
+  m_frame_dump_nv12_framebuffer.reset();
+  m_frame_dump_nv12_texture.reset();
+  m_frame_dump_nv12_texture = CreateTexture(TextureConfig(
+      width, height, 1, 1, 1, AbstractTextureFormat::RGBA8, AbstractTextureFlag_RenderTarget));
+  if (!m_frame_dump_nv12_texture)
+    return false;
+
+  m_frame_dump_nv12_framebuffer = CreateFramebuffer(m_frame_dump_nv12_texture.get(), nullptr);
+  return m_frame_dump_nv12_framebuffer != nullptr;
+}
+
 bool Renderer::CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height)
 {
-  std::unique_ptr<AbstractStagingTexture>& rbtex = m_frame_dump_readback_textures[0];
+  std::unique_ptr<AbstractStagingTexture>& rbtex =
+      m_frame_dump_readback_textures[m_frame_dump_readback_index];
   if (rbtex && rbtex->GetWidth() == target_width && rbtex->GetHeight() == target_height)
     return true;
 
@@ -1460,26 +1712,31 @@ bool Renderer::CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height
   return true;
 }
 
-void Renderer::FlushFrameDump()
+void Renderer::FlushFrameDump(size_t max_pending)
 {
-  if (!m_last_frame_exported)
+  if (m_pending_frame_dumps.empty())
     return;
 
-  // Ensure the previously-queued frame was encoded.
-  FinishFrameData();
+  // Nothing will push the remaining readbacks out once frame dumping has stopped.
+  if (!IsFrameDumping())
+    max_pending = 0;
 
-  // Queue encoding of the last frame dumped.
-  std::unique_ptr<AbstractStagingTexture>& rbtex = m_frame_dump_readback_textures[0];
-  rbtex->Flush();
-  if (rbtex->Map())
+  // Queue encoding of the oldest frames. The textures stay mapped until they have been encoded.
+  while (m_pending_frame_dumps.size() > max_pending)
   {
-    DumpFrameData(reinterpret_cast<u8*>(rbtex->GetMappedPointer()), rbtex->GetConfig().width,
-                  rbtex->GetConfig().height, static_cast<int>(rbtex->GetMappedStride()),
-                  m_last_frame_state);
-    rbtex->Unmap();
-  }
+    FrameDumpConfig config = m_pending_frame_dumps.front();
+    m_pending_frame_dumps.pop_front();
 
-  m_last_frame_exported = false;
+    AbstractStagingTexture* rbtex = m_frame_dump_readback_textures[config.readback_index].get();
+    rbtex->Flush();
+    if (!rbtex->Map())
+      continue;
+
+    m_frame_dump_readback_mapped[config.readback_index] = true;
+    config.data = reinterpret_cast<u8*>(rbtex->GetMappedPointer());
+    config.stride = static_cast<int>(rbtex->GetMappedStride());
+    DumpFrameData(config);
+  }
 
   // Shutdown frame dumping if it is no longer active.
   if (!IsFrameDumping())
@@ -1488,51 +1745,87 @@ void Renderer::FlushFrameDump()
 
 void Renderer::ShutdownFrameDumping()
 {
-  // Ensure the last queued readback has been sent to the encoder.
-  FlushFrameDump();
+  // Ensure the queued readbacks have been sent to the encoder.
+  FlushFrameDump(0);
 
-  if (!m_frame_dump_thread_running.IsSet())
+  if (!m_frame_dump_thread.joinable())
     return;
 
-  // Ensure previous frame has been encoded.
+  // Ensure all queued frames have been encoded.
   FinishFrameData();
 
   // Wake thread up, and wait for it to exit.
-  m_frame_dump_thread_running.Clear();
-  m_frame_dump_start.Set();
-  if (m_frame_dump_thread.joinable())
-    m_frame_dump_thread.join();
+  {
+    std::lock_guard<std::mutex> guard(m_frame_dump_mutex);
+    m_frame_dump_thread_running = false;
+  }
+  m_frame_dump_queued.notify_one();
+  m_frame_dump_thread.join();
   m_frame_dump_render_framebuffer.reset();
   m_frame_dump_render_texture.reset();
-  for (auto& tex : m_frame_dump_readback_textures)
-    tex.reset();
+  m_frame_dump_nv12_framebuffer.reset();
+  m_frame_dump_nv12_texture.reset();
+  for (size_t i = 0; i < NUM_FRAME_DUMP_READBACK_TEXTURES; i++)
+  {
+    ReleaseFrameDumpReadbackTexture(i);
+    m_frame_dump_readback_textures[i].reset();
+  }
+  ShutdownPngWriters();
 }
 
-void Renderer::DumpFrameData(const u8* data, int w, int h, int stride,
-                             const FrameDump::Frame& state)
+void Renderer::DumpFrameData(const FrameDumpConfig& config)
 {
-  m_frame_dump_config = FrameDumpConfig{data, w, h, stride, state};
-
-  if (!m_frame_dump_thread_running.IsSet())
+  if (!m_frame_dump_thread.joinable())
   {
-    if (m_frame_dump_thread.joinable())
-      m_frame_dump_thread.join();
-    m_frame_dump_thread_running.Set();
+    m_frame_dump_thread_running = true;
     m_frame_dump_thread = std::thread(&Renderer::RunFrameDumps, this);
   }
 
   // Wake worker thread up.
-  m_frame_dump_start.Set();
-  m_frame_dump_frame_running = true;
+  {
+    std::lock_guard<std::mutex> guard(m_frame_dump_mutex);
+    m_frame_dump_readback_refs[config.readback_index] = 1;
+    m_frame_dump_queue.push_back(config);
+  }
+  m_frame_dump_queued.notify_one();
 }
 
-void Renderer::FinishFrameData()
+void Renderer::ReleaseFrameDumpReadbackTexture(size_t index)
 {
-  if (!m_frame_dump_frame_running)
+  if (!m_frame_dump_readback_mapped[index])
     return;
 
-  m_frame_dump_done.Wait();
-  m_frame_dump_frame_running = false;
+  {
+    std::unique_lock<std::mutex> lock(m_frame_dump_mutex);
+    m_frame_dump_done.wait(lock, [this, index] { return m_frame_dump_readback_refs[index] == 0; });
+  }
+
+  m_frame_dump_readback_textures[index]->Unmap();
+  m_frame_dump_readback_mapped[index] = false;
+}
+
+void Renderer::AddFrameDumpDataReference(size_t index)
+{
+  std::lock_guard<std::mutex> guard(m_frame_dump_mutex);
+  m_frame_dump_readback_refs[index]++;
+}
+
+void Renderer::ReleaseFrameDumpData(size_t index)
+{
+  {
+    std::lock_guard<std::mutex> guard(m_frame_dump_mutex);
+    m_frame_dump_readback_refs[index]--;
+  }
+  m_frame_dump_done.notify_all();
+}
+
+void Renderer::FinishFrameData()
+{
+  std::unique_lock<std::mutex> lock(m_frame_dump_mutex);
+  m_frame_dump_done.wait(lock, [this] {
+    return std::all_of(m_frame_dump_readback_refs.begin(), m_frame_dump_readback_refs.end(),
+                       [](u32 refs) { return refs == 0; });
+  });
 }
 
 void Renderer::RunFrameDumps()
@@ -1551,26 +1844,45 @@ void Renderer::RunFrameDumps()
   }
 #endif
 
+  std::unique_lock<std::mutex> lock(m_frame_dump_mutex);
   while (true)
   {
-    m_frame_dump_start.Wait();
-    if (!m_frame_dump_thread_running.IsSet())
+    m_frame_dump_queued.wait(
+        lock, [this] { return !m_frame_dump_queue.empty() || !m_frame_dump_thread_running; });
+    if (m_frame_dump_queue.empty())
       break;
 
-    auto config = m_frame_dump_config;
+    const FrameDumpConfig config = m_frame_dump_queue.front();
+    m_frame_dump_queue.pop_front();
+    lock.unlock();
 
     // Save screenshot
-    if (m_screenshot_request.TestAndClear())
+    if (config.screenshot)
     {
-      std::lock_guard<std::mutex> lk(m_screenshot_lock);
+      std::string name;
+      {
+        std::lock_guard<std::mutex> lk(m_screenshot_lock);
+        name = std::move(m_screenshot_name);
+
+        // Reset settings
+        m_screenshot_name.clear();
+      }
 
-      if (TextureToPng(config.data, config.stride, m_screenshot_name, config.width, config.height,
-                       false))
-        OSD::AddMessage("Screenshot saved to " + m_screenshot_name);
+      AddFrameDumpDataReference(config.readback_index);
+      TextureToPngAsync(config.data, config.stride, name, config.width, config.height, false,
+                        [this, name, index = config.readback_index](bool success) {
+                          if (success)
+                            OSD::AddMessage("Screenshot saved to " + name);
+                          m_screenshot_completed.Set();
+                          ReleaseFrameDumpData(index);
+                        });
+    }
 
-      // Reset settings
-      m_screenshot_name.clear();
-      m_screenshot_completed.Set();
+    if (config.format == FrameDump::PixelFormat::RGBA8)
+    {
+      std::lock_guard<std::mutex> lk(s_frame_readback_mutex);
+      if (s_frame_readback_callback)
+        s_frame_readback_callback(config.data, config.width, config.height, config.stride);
     }
 
     if (SConfig::GetInstance().m_DumpFrames)
@@ -1597,7 +1909,8 @@ void Renderer::RunFrameDumps()
       }
     }
 
-    m_frame_dump_done.Set();
+    ReleaseFrameDumpData(config.readback_index);
+    lock.lock();
   }
 
   if (frame_dump_started)
@@ -1617,7 +1930,8 @@ bool Renderer::StartFrameDumpToFFMPEG(const FrameDumpConfig& config)
 
 void Renderer::DumpFrameToFFMPEG(const FrameDumpConfig& config)
 {
-  FrameDump::AddFrame(config.data, config.width, config.height, config.stride, config.state);
+  FrameDump::AddFrame(config.data, config.width, config.height, config.stride, config.format,
+                      config.state);
 }
 
 void Renderer::StopFrameDumpToFFMPEG()
@@ -1669,8 +1983,10 @@ bool Renderer::StartFrameDumpToImage(const FrameDumpConfig& config)
 
 void Renderer::DumpFrameToImage(const FrameDumpConfig& config)
 {
-  std::string filename = GetFrameDumpNextImageFileName();
-  TextureToPng(config.data, config.stride, filename, config.width, config.height, false);
+  AddFrameDumpDataReference(config.readback_index);
+  TextureToPngAsync(config.data, config.stride, GetFrameDumpNextImageFileName(), config.width,
+                    config.height, false,
+                    [this, index = config.readback_index](bool) { ReleaseFrameDumpData(index); });
   m_frame_dump_image_counter++;
 }
 
@@ -15,6 +15,9 @@
 #pragma once
 
 #include <array>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -29,6 +32,7 @@
 #include "Common/MathUtil.h"
 #include "VideoCommon/AsyncShaderCompiler.h"
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/DynamicResolution.h"
 #include "VideoCommon/FPSCounter.h"
 #include "VideoCommon/FrameDump.h"
 #include "VideoCommon/RenderState.h"
@@ -221,6 +225,10 @@ public:
   // Finish up the current frame, print some stats
   void Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u64 ticks);
 
+  // True while the current frame is being skipped: the FIFO is still processed, but nothing is
+  // drawn to the EFB and the frame isn't presented.
+  bool IsSkippingFrameDraws() const { return m_skip_frame_draws; }
+
   void UpdateWidescreenHeuristic();
 
   // Draws the specified XFB buffer to the screen, performing any post-processing.
@@ -259,6 +267,25 @@ public:
   void BeginUIFrame();
   void EndUIFrame();
 
+  // Timings of presented frames, collected while recording is enabled. Used for benchmarking
+  // FIFO logs. Both functions can be called from any thread.
+  struct FrameTiming
+  {
+    // Time since the previous frame was presented
+    u64 frame_time_us;
+    // Time the GPU thread spent in Swap(), which includes submitting the frame to the driver
+    u64 swap_time_us;
+  };
+  void SetFrameTimingRecording(bool enabled);
+  std::vector<FrameTiming> TakeFrameTimings();
+
+  // While a callback is set, every presented frame goes through the pipelined frame dump readback,
+  // and is then passed to the callback as RGBA8 rows on the frame dumping thread. This can be set
+  // before the renderer is created, so that no frame is missed.
+  using FrameReadbackCallback =
+      std::function<void(const u8* data, int width, int height, int stride)>;
+  static void SetFrameReadbackCallback(FrameReadbackCallback callback);
+
 protected:
   // Bitmask containing information about which configuration has changed for the backend.
   enum ConfigChangeBits : u32
@@ -275,6 +302,7 @@ protected:
 
   std::tuple<int, int> CalculateTargetScale(int x, int y) const;
   bool CalculateTargetSize();
+  bool UseDynamicResolution() const;
 
   void CheckForConfigChanges();
 
@@ -320,9 +348,13 @@ protected:
   AbstractTextureFormat m_backbuffer_format = AbstractTextureFormat::Undefined;
   MathUtil::Rectangle<int> m_target_rectangle = {};
   int m_frame_count = 0;
+  bool m_skip_frame_draws = false;
 
   FPSCounter m_fps_counter;
 
+  DynamicResolution m_dynamic_resolution;
+  u64 m_last_swap_start_us = 0;
+
   std::unique_ptr<VideoCommon::PostProcessing> m_post_processor;
 
   void* m_new_surface_handle = nullptr;
@@ -337,6 +369,11 @@ protected:
   std::mutex m_imgui_mutex;
   u64 m_imgui_last_frame_time;
 
+  std::mutex m_frame_timings_mutex;
+  std::vector<FrameTiming> m_frame_timings;
+  bool m_record_frame_timings = false;
+  u64 m_last_present_time_us = 0;
+
 private:
   void RunFrameDumps();
   std::tuple<int, int> CalculateOutputDimensions(int width, int height) const;
@@ -349,27 +386,46 @@ private:
   int m_last_window_request_height = 0;
 
   // frame dumping
-  std::thread m_frame_dump_thread;
-  Common::Event m_frame_dump_start;
-  Common::Event m_frame_dump_done;
-  Common::Flag m_frame_dump_thread_running;
-  u32 m_frame_dump_image_counter = 0;
-  bool m_frame_dump_frame_running = false;
+  // Frames are read back into a ring of staging textures, which stay mapped while they are queued
+  // for the frame dump thread, so the GPU thread only waits once the encoder is this far behind.
+  // The readback of a frame is only mapped FRAME_DUMP_READBACK_LATENCY swaps later, by which
+  // point the copy has long finished on the GPU.
+  static constexpr size_t NUM_FRAME_DUMP_READBACK_TEXTURES = 5;
+  static constexpr size_t FRAME_DUMP_READBACK_LATENCY = 2;
   struct FrameDumpConfig
   {
     const u8* data;
     int width;
     int height;
     int stride;
+    FrameDump::PixelFormat format;
+    bool screenshot;
+    size_t readback_index;
     FrameDump::Frame state;
-  } m_frame_dump_config;
+  };
+  std::thread m_frame_dump_thread;
+  std::mutex m_frame_dump_mutex;
+  std::condition_variable m_frame_dump_queued;
+  std::condition_variable m_frame_dump_done;
+  std::deque<FrameDumpConfig> m_frame_dump_queue;
+  // Users of each mapped readback texture: the frame dump thread, and any pending PNG writes.
+  std::array<u32, NUM_FRAME_DUMP_READBACK_TEXTURES> m_frame_dump_readback_refs{};
+  bool m_frame_dump_thread_running = false;
+  u32 m_frame_dump_image_counter = 0;
 
   // Texture used for screenshot/frame dumping
   std::unique_ptr<AbstractTexture> m_frame_dump_render_texture;
   std::unique_ptr<AbstractFramebuffer> m_frame_dump_render_framebuffer;
-  std::array<std::unique_ptr<AbstractStagingTexture>, 2> m_frame_dump_readback_textures;
-  FrameDump::Frame m_last_frame_state;
-  bool m_last_frame_exported = false;
+  // Render target for the GPU-side NV12 conversion.
+  std::unique_ptr<AbstractTexture> m_frame_dump_nv12_texture;
+  std::unique_ptr<AbstractFramebuffer> m_frame_dump_nv12_framebuffer;
+  std::array<std::unique_ptr<AbstractStagingTexture>, NUM_FRAME_DUMP_READBACK_TEXTURES>
+      m_frame_dump_readback_textures;
+  // Only touched by the GPU thread, textures are unmapped once the frame dump thread is done.
+  std::array<bool, NUM_FRAME_DUMP_READBACK_TEXTURES> m_frame_dump_readback_mapped{};
+  size_t m_frame_dump_readback_index = 0;
+  // Frames whose readback has been recorded, but not mapped yet, oldest first.
+  std::deque<FrameDumpConfig> m_pending_frame_dumps;
 
   // Tracking of XFB textures so we don't render duplicate frames.
   u64 m_last_xfb_id = std::numeric_limits<u64>::max();
@@ -390,21 +446,43 @@ private:
 
   bool IsFrameDumping() const;
 
+  bool ShouldSkipFrameDraws() const;
+
   // Checks that the frame dump render texture exists and is the correct size.
   bool CheckFrameDumpRenderTexture(u32 target_width, u32 target_height);
 
-  // Checks that the frame dump readback texture exists and is the correct size.
+  // Checks that the frame dump NV12 conversion target exists and fits an image of this size.
+  bool CheckFrameDumpNV12Texture(u32 target_width, u32 target_height);
+
+  // Checks that the current frame dump readback texture exists and is the correct size.
   bool CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height);
 
+  // Whether the current frame should be converted to NV12 on the GPU before it is read back.
+  bool ShouldConvertFrameDumpToNV12(u32 target_width, u32 target_height) const;
+
+  // Converts the RGBA8 source rectangle into m_frame_dump_nv12_texture.
+  bool ConvertFrameDumpToNV12(const AbstractTexture* src_texture,
+                              const MathUtil::Rectangle<int>& src_rect);
+
+  // Waits until the frame dump thread is done with the readback texture, and unmaps it.
+  void ReleaseFrameDumpReadbackTexture(size_t index);
+
+  // Adds or drops a reference to the frame data in a mapped readback texture. Called on the
+  // frame dump thread and the PNG writers.
+  void AddFrameDumpDataReference(size_t index);
+  void ReleaseFrameDumpData(size_t index);
+
   // Fills the frame dump staging texture with the current XFB texture.
   void DumpCurrentFrame(const AbstractTexture* src_texture,
                         const MathUtil::Rectangle<int>& src_rect, u64 ticks);
 
-  // Asynchronously encodes the specified pointer of frame data to the frame dump.
-  void DumpFrameData(const u8* data, int w, int h, int stride, const FrameDump::Frame& state);
+  // Queues the frame for encoding on the frame dump thread. The data has to stay valid until
+  // the thread is done with the readback texture.
+  void DumpFrameData(const FrameDumpConfig& config);
 
-  // Ensures all rendered frames are queued for encoding.
-  void FlushFrameDump();
+  // Queues rendered frames for encoding until at most max_pending readbacks remain in flight.
+  // Once frame dumping has stopped, all of them are queued.
+  void FlushFrameDump(size_t max_pending);
 
   // Ensures all encoded frames have been written to the output file.
   void FinishFrameData();
@@ -4,11 +4,19 @@
 
 #include "VideoCommon/ShaderCache.h"
 
+#include <algorithm>
+#include <memory>
+
 #include "Common/Assert.h"
+#include "Common/CommonPaths.h"
+#include "Common/FileSearch.h"
 #include "Common/FileUtil.h"
+#include "Common/MathUtil.h"
 #include "Common/MsgHandler.h"
+#include "Common/Trace.h"
 #include "Core/ConfigManager.h"
 
+#include "VideoCommon/FrameProfiler.h"
 #include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/FramebufferShaderGen.h"
 #include "VideoCommon/RenderBase.h"
@@ -93,8 +101,51 @@ void ShaderCache::Reload()
   m_async_shader_compiler->ResizeWorkerThreads(g_ActiveConfig.GetShaderCompilerThreads());
 }
 
+void ShaderCache::ReloadGameCaches()
+{
+  if (!g_ActiveConfig.bShaderCache || m_api_type == APIType::Nothing ||
+      m_game_id == SConfig::GetInstance().GetGameID())
+  {
+    return;
+  }
+
+  // Shaders still compiling for the old game would otherwise end up in the new game's files
+  WaitForAsyncCompiler();
+  ClosePipelineUIDCache();
+  m_game_id = SConfig::GetInstance().GetGameID();
+
+  if (g_ActiveConfig.backend_info.bSupportsShaderBinaries)
+  {
+    m_vs_cache.disk_cache.Sync();
+    m_vs_cache.disk_cache.Close();
+    LoadShaderCache<ShaderStage::Vertex, VertexShaderUid>(m_vs_cache, m_api_type, "specialized-vs",
+                                                          true);
+    m_ps_cache.disk_cache.Sync();
+    m_ps_cache.disk_cache.Close();
+    LoadShaderCache<ShaderStage::Pixel, PixelShaderUid>(m_ps_cache, m_api_type, "specialized-ps",
+                                                        true);
+  }
+
+  if (g_ActiveConfig.backend_info.bSupportsPipelineCacheData)
+  {
+    m_gx_pipeline_disk_cache.Sync();
+    m_gx_pipeline_disk_cache.Close();
+    LoadPipelineCache<GXPipelineUid, SerializedGXPipelineUid>(
+        m_gx_pipeline_cache, m_gx_pipeline_disk_cache, m_api_type, "specialized-pipeline", true);
+  }
+
+  LoadPipelineUIDCache();
+  CompileMissingPipelines();
+}
+
 void ShaderCache::RetrieveAsyncShaders()
 {
+  if (m_pending_pipeline_priorities_changed)
+  {
+    m_async_shader_compiler->ReprioritizeWorkItems();
+    m_pending_pipeline_priorities_changed = false;
+  }
+
   m_async_shader_compiler->RetrieveWorkItems();
 }
 
@@ -114,6 +165,8 @@ const AbstractPipeline* ShaderCache::GetPipelineForUid(const GXPipelineUid& uid)
   if (it != m_gx_pipeline_cache.end() && !it->second.second)
     return it->second.first.get();
 
+  FrameProfiler::ScopedTimer timer(FrameProfiler::Category::ShaderCompile);
+  TRACE_SCOPE("ShaderCache::CompilePipeline");
   const bool exists_in_cache = it != m_gx_pipeline_cache.end();
   std::unique_ptr<AbstractPipeline> pipeline;
   std::optional<AbstractPipelineConfig> pipeline_config = GetGXPipelineConfig(uid);
@@ -137,16 +190,40 @@ std::optional<const AbstractPipeline*> ShaderCache::GetPipelineForUidAsync(const
   }
 
   AppendGXPipelineUID(uid);
-  QueuePipelineCompile(uid, COMPILE_PRIORITY_ONDEMAND_PIPELINE);
+  auto usage = std::make_shared<PendingPipelineUsage>();
+  usage->priority = COMPILE_PRIORITY_ONDEMAND_PIPELINE;
+  m_pending_pipeline_usage.emplace(uid, usage);
+  QueuePipelineCompile(uid, COMPILE_PRIORITY_ONDEMAND_PIPELINE, std::move(usage));
   return {};
 }
 
+void ShaderCache::CountPendingPipelineUse(const GXPipelineUid& uid, u64 pixels)
+{
+  auto it = m_pending_pipeline_usage.find(uid);
+  if (it == m_pending_pipeline_usage.end())
+    return;
+
+  // Every draw counts for something, even if it is clipped away entirely.
+  PendingPipelineUsage& usage = *it->second;
+  usage.pixels += std::max<u64>(pixels, 1);
+
+  const u32 priority = COMPILE_PRIORITY_ONDEMAND_PIPELINE -
+                       std::min(IntLog2(usage.pixels), MAX_PENDING_PIPELINE_USAGE_BOOST);
+  if (priority != usage.priority)
+  {
+    usage.priority = priority;
+    m_pending_pipeline_priorities_changed = true;
+  }
+}
+
 const AbstractPipeline* ShaderCache::GetUberPipelineForUid(const GXUberPipelineUid& uid)
 {
   auto it = m_gx_uber_pipeline_cache.find(uid);
   if (it != m_gx_uber_pipeline_cache.end() && !it->second.second)
     return it->second.first.get();
 
+  FrameProfiler::ScopedTimer timer(FrameProfiler::Category::ShaderCompile);
+  TRACE_SCOPE("ShaderCache::CompileUberPipeline");
   std::unique_ptr<AbstractPipeline> pipeline;
   std::optional<AbstractPipelineConfig> pipeline_config = GetGXPipelineConfig(uid);
   if (pipeline_config)
@@ -219,6 +296,10 @@ void ShaderCache::LoadShaderCache(T& cache, APIType api_type, const char* type,
     CacheReader(T& cache_) : cache(cache_) {}
     void Read(const K& key, const u8* value, u32 value_size)
     {
+      // Shaders that were compiled for a game that ran before are kept
+      if (cache.shader_map.find(key) != cache.shader_map.end())
+        return;
+
       auto shader = g_renderer->CreateShaderFromBinary(stage, value, value_size);
       if (shader)
       {
@@ -336,6 +417,8 @@ void ShaderCache::ClearPipelineCache(T& cache, Y& disk_cache)
 
 void ShaderCache::LoadCaches()
 {
+  m_game_id = SConfig::GetInstance().GetGameID();
+
   // Ubershader caches, if present.
   if (g_ActiveConfig.backend_info.bSupportsShaderBinaries)
   {
@@ -369,6 +452,7 @@ void ShaderCache::LoadCaches()
 void ShaderCache::ClearCaches()
 {
   ClearPipelineCache(m_gx_pipeline_cache, m_gx_pipeline_disk_cache);
+  m_pending_pipeline_usage.clear();
   ClearShaderCache(m_vs_cache);
   ClearShaderCache(m_gs_cache);
   ClearShaderCache(m_ps_cache);
@@ -392,6 +476,8 @@ void ShaderCache::ClearCaches()
   for (auto& pipeline : m_palette_conversion_pipelines)
     pipeline.reset();
   m_texture_reinterpret_pipelines.clear();
+  m_nv12_conversion_pipeline.reset();
+  m_nv12_conversion_pipeline_compiled = false;
   m_texture_decoding_shaders.clear();
 
   SETSTAT(g_stats.num_pixel_shaders_created, 0);
@@ -675,6 +761,7 @@ const AbstractPipeline* ShaderCache::InsertGXPipeline(const GXPipelineUid& confi
 {
   auto& entry = m_gx_pipeline_cache[config];
   entry.second = false;
+  m_pending_pipeline_usage.erase(config);
   if (!entry.first && pipeline)
   {
     entry.first = std::move(pipeline);
@@ -721,121 +808,170 @@ ShaderCache::InsertGXUberPipeline(const GXUberPipelineUid& config,
   return entry.first.get();
 }
 
+static std::string GetSharedPipelineUIDCacheDirectory()
+{
+  return File::GetUserPath(D_CACHE_IDX) + "SharedUIDs" DIR_SEP;
+}
+
 void ShaderCache::LoadPipelineUIDCache()
 {
-  constexpr u32 CACHE_FILE_MAGIC = 0x44495550;  // PUID
-  constexpr size_t CACHE_HEADER_SIZE = sizeof(u32) + sizeof(u32);
-  std::string filename =
+  const std::string filename =
       File::GetUserPath(D_CACHE_IDX) + SConfig::GetInstance().GetGameID() + ".uidcache";
-  if (m_gx_pipeline_uid_cache_file.Open(filename, "rb+"))
+  OpenPipelineUIDCache(m_gx_pipeline_uid_cache_file, filename);
+  INFO_LOG(VIDEO, "Read %u pipeline UIDs from %s",
+           static_cast<unsigned>(m_gx_pipeline_cache.size()), filename.c_str());
+
+  if (!g_ActiveConfig.bSharedPipelineUIDCache)
+    return;
+
+  // The shared database is a directory of UID caches in the same format as the per-game ones.
+  // Every file in it is imported, and the local one gains whatever it doesn't contain yet, so it
+  // ends up holding the UIDs of all games and imported packs. That file can then be handed to
+  // other machines as a pack of its own.
+  const std::string directory = GetSharedPipelineUIDCacheDirectory();
+  const std::string local_filename = directory + SHARED_PIPELINE_UID_CACHE_NAME;
+  File::CreateFullPath(directory);
+  for (const std::string& path : Common::DoFileSearch({directory}, {".uidcache"}))
   {
-    // If an existing case exists, validate the version before reading entries.
-    u32 existing_magic;
-    u32 existing_version;
-    bool uid_file_valid = false;
-    if (m_gx_pipeline_uid_cache_file.ReadBytes(&existing_magic, sizeof(existing_magic)) &&
-        m_gx_pipeline_uid_cache_file.ReadBytes(&existing_version, sizeof(existing_version)) &&
-        existing_magic == CACHE_FILE_MAGIC && existing_version == GX_PIPELINE_UID_VERSION)
-    {
-      // Ensure the expected size matches the actual size of the file. If it doesn't, it means
-      // the cache file may be corrupted, and we should not proceed with loading potentially
-      // garbage or invalid UIDs.
-      const u64 file_size = m_gx_pipeline_uid_cache_file.GetSize();
-      const size_t uid_count =
-          static_cast<size_t>(file_size - CACHE_HEADER_SIZE) / sizeof(SerializedGXPipelineUid);
-      const size_t expected_size = uid_count * sizeof(SerializedGXPipelineUid) + CACHE_HEADER_SIZE;
-      uid_file_valid = file_size == expected_size;
-      if (uid_file_valid)
-      {
-        for (size_t i = 0; i < uid_count; i++)
-        {
-          SerializedGXPipelineUid serialized_uid;
-          if (m_gx_pipeline_uid_cache_file.ReadBytes(&serialized_uid, sizeof(serialized_uid)))
-          {
-            // This just adds the pipeline to the map, it is compiled later.
-            AddSerializedGXPipelineUID(serialized_uid);
-          }
-          else
-          {
-            uid_file_valid = false;
-            break;
-          }
-        }
-      }
+    if (path == local_filename)
+      continue;
 
-      // We open the file for reading and writing, so we must seek to the end before writing.
-      if (uid_file_valid)
-        uid_file_valid = m_gx_pipeline_uid_cache_file.Seek(expected_size, SEEK_SET);
-    }
+    File::IOFile file(path, "rb");
+    if (!ReadPipelineUIDCache(file, nullptr))
+      WARN_LOG(VIDEO, "Ignoring invalid or outdated pipeline UID pack %s", path.c_str());
+  }
+  OpenPipelineUIDCache(m_shared_pipeline_uid_cache_file, local_filename);
 
-    // If the file is invalid, close it. We re-open and truncate it below.
-    if (!uid_file_valid)
-      m_gx_pipeline_uid_cache_file.Close();
+  INFO_LOG(VIDEO, "Pipeline UID cache holds %u UIDs including shared ones",
+           static_cast<unsigned>(m_gx_pipeline_cache.size()));
+}
+
+bool ShaderCache::ReadPipelineUIDCache(File::IOFile& file, std::set<GXPipelineUid>* read_uids)
+{
+  constexpr size_t CACHE_HEADER_SIZE = sizeof(u32) + sizeof(u32);
+
+  // Validate the version before reading entries.
+  u32 existing_magic;
+  u32 existing_version;
+  if (!file.ReadBytes(&existing_magic, sizeof(existing_magic)) ||
+      !file.ReadBytes(&existing_version, sizeof(existing_version)) ||
+      existing_magic != PIPELINE_UID_CACHE_FILE_MAGIC ||
+      existing_version != GX_PIPELINE_UID_VERSION)
+  {
+    return false;
   }
 
-  // If the file is not open, it means it was either corrupted or didn't exist.
-  if (!m_gx_pipeline_uid_cache_file.IsOpen())
+  // Ensure the expected size matches the actual size of the file. If it doesn't, it means
+  // the cache file may be corrupted, and we should not proceed with loading potentially
+  // garbage or invalid UIDs.
+  const u64 file_size = file.GetSize();
+  const size_t uid_count =
+      static_cast<size_t>(file_size - CACHE_HEADER_SIZE) / sizeof(SerializedGXPipelineUid);
+  const size_t expected_size = uid_count * sizeof(SerializedGXPipelineUid) + CACHE_HEADER_SIZE;
+  if (file_size != expected_size)
+    return false;
+
+  for (size_t i = 0; i < uid_count; i++)
   {
-    if (m_gx_pipeline_uid_cache_file.Open(filename, "wb"))
+    SerializedGXPipelineUid serialized_uid;
+    if (!file.ReadBytes(&serialized_uid, sizeof(serialized_uid)))
+      return false;
+
+    // This just adds the pipeline to the map, it is compiled later.
+    const GXPipelineUid uid = AddSerializedGXPipelineUID(serialized_uid);
+    if (read_uids)
+      read_uids->insert(uid);
+  }
+
+  // We open the file for reading and writing, so we must seek to the end before writing.
+  return file.Seek(expected_size, SEEK_SET);
+}
+
+void ShaderCache::OpenPipelineUIDCache(File::IOFile& file, const std::string& filename)
+{
+  std::set<GXPipelineUid> file_uids;
+  if (file.Open(filename, "rb+"))
+  {
+    // If the file is invalid, close it. We re-open and truncate it below.
+    if (!ReadPipelineUIDCache(file, &file_uids))
     {
-      // Write the version identifier.
-      m_gx_pipeline_uid_cache_file.WriteBytes(&CACHE_FILE_MAGIC, sizeof(GX_PIPELINE_UID_VERSION));
-      m_gx_pipeline_uid_cache_file.WriteBytes(&GX_PIPELINE_UID_VERSION,
-                                              sizeof(GX_PIPELINE_UID_VERSION));
-
-      // Write any current UIDs out to the file.
-      // This way, if we load a UID cache where the data was incomplete (e.g. Dolphin crashed),
-      // we don't lose the existing UIDs which were previously at the beginning.
-      for (const auto& it : m_gx_pipeline_cache)
-        AppendGXPipelineUID(it.first);
+      file.Close();
+      file_uids.clear();
     }
   }
 
-  INFO_LOG(VIDEO, "Read %u pipeline UIDs from %s",
-           static_cast<unsigned>(m_gx_pipeline_cache.size()), filename.c_str());
+  // If the file is not open, it means it was either corrupted or didn't exist.
+  if (!file.IsOpen())
+  {
+    if (!file.Open(filename, "wb"))
+      return;
+
+    // Write the version identifier.
+    file.WriteBytes(&PIPELINE_UID_CACHE_FILE_MAGIC, sizeof(PIPELINE_UID_CACHE_FILE_MAGIC));
+    file.WriteBytes(&GX_PIPELINE_UID_VERSION, sizeof(GX_PIPELINE_UID_VERSION));
+  }
+
+  // Write any current UIDs the file doesn't have yet out to it.
+  // This way, if we load a UID cache where the data was incomplete (e.g. Dolphin crashed),
+  // we don't lose the existing UIDs which were previously at the beginning.
+  for (const auto& it : m_gx_pipeline_cache)
+  {
+    if (!file_uids.count(it.first))
+      WritePipelineUID(file, it.first);
+  }
 }
 
 void ShaderCache::ClosePipelineUIDCache()
 {
   // This is left as a method in case we need to append extra data to the file in the future.
   m_gx_pipeline_uid_cache_file.Close();
+  m_shared_pipeline_uid_cache_file.Close();
 }
 
-void ShaderCache::AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid)
+GXPipelineUid ShaderCache::AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid)
 {
   GXPipelineUid real_uid;
   UnserializePipelineUid(uid, real_uid);
 
   auto iter = m_gx_pipeline_cache.find(real_uid);
   if (iter != m_gx_pipeline_cache.end())
-    return;
+    return real_uid;
 
   // Flag it as empty with a null pipeline object, for later compilation.
   auto& entry = m_gx_pipeline_cache[real_uid];
   entry.second = false;
+  return real_uid;
 }
 
 void ShaderCache::AppendGXPipelineUID(const GXPipelineUid& config)
 {
-  if (!m_gx_pipeline_uid_cache_file.IsOpen())
+  WritePipelineUID(m_gx_pipeline_uid_cache_file, config);
+  WritePipelineUID(m_shared_pipeline_uid_cache_file, config);
+}
+
+void ShaderCache::WritePipelineUID(File::IOFile& file, const GXPipelineUid& config)
+{
+  if (!file.IsOpen())
     return;
 
   SerializedGXPipelineUid disk_uid;
   SerializePipelineUid(config, disk_uid);
-  if (!m_gx_pipeline_uid_cache_file.WriteBytes(&disk_uid, sizeof(disk_uid)))
+  if (!file.WriteBytes(&disk_uid, sizeof(disk_uid)))
   {
     WARN_LOG(VIDEO, "Writing pipeline UID to cache failed, closing file.");
-    m_gx_pipeline_uid_cache_file.Close();
+    file.Close();
   }
 }
 
-void ShaderCache::QueueVertexShaderCompile(const VertexShaderUid& uid, u32 priority)
+void ShaderCache::QueueVertexShaderCompile(const VertexShaderUid& uid, u32 priority,
+                                           PendingPipelineUsagePtr usage)
 {
   class VertexShaderWorkItem final : public AsyncShaderCompiler::WorkItem
   {
   public:
-    VertexShaderWorkItem(ShaderCache* shader_cache_, const VertexShaderUid& uid_)
-        : shader_cache(shader_cache_), uid(uid_)
+    VertexShaderWorkItem(ShaderCache* shader_cache_, const VertexShaderUid& uid_,
+                         PendingPipelineUsagePtr usage_)
+        : shader_cache(shader_cache_), uid(uid_), usage(std::move(usage_))
     {
     }
 
@@ -847,14 +983,18 @@ void ShaderCache::QueueVertexShaderCompile(const VertexShaderUid& uid, u32 prior
 
     void Retrieve() override { shader_cache->InsertVertexShader(uid, std::move(shader)); }
 
+    u32 UpdatePriority(u32 priority) override { return usage ? usage->priority : priority; }
+
   private:
     ShaderCache* shader_cache;
     std::unique_ptr<AbstractShader> shader;
     VertexShaderUid uid;
+    PendingPipelineUsagePtr usage;
   };
 
   m_vs_cache.shader_map[uid].pending = true;
-  auto wi = m_async_shader_compiler->CreateWorkItem<VertexShaderWorkItem>(this, uid);
+  auto wi =
+      m_async_shader_compiler->CreateWorkItem<VertexShaderWorkItem>(this, uid, std::move(usage));
   m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
 }
 
@@ -887,13 +1027,15 @@ void ShaderCache::QueueVertexUberShaderCompile(const UberShader::VertexShaderUid
   m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
 }
 
-void ShaderCache::QueuePixelShaderCompile(const PixelShaderUid& uid, u32 priority)
+void ShaderCache::QueuePixelShaderCompile(const PixelShaderUid& uid, u32 priority,
+                                          PendingPipelineUsagePtr usage)
 {
   class PixelShaderWorkItem final : public AsyncShaderCompiler::WorkItem
   {
   public:
-    PixelShaderWorkItem(ShaderCache* shader_cache_, const PixelShaderUid& uid_)
-        : shader_cache(shader_cache_), uid(uid_)
+    PixelShaderWorkItem(ShaderCache* shader_cache_, const PixelShaderUid& uid_,
+                        PendingPipelineUsagePtr usage_)
+        : shader_cache(shader_cache_), uid(uid_), usage(std::move(usage_))
     {
     }
 
@@ -905,14 +1047,18 @@ void ShaderCache::QueuePixelShaderCompile(const PixelShaderUid& uid, u32 priorit
 
     void Retrieve() override { shader_cache->InsertPixelShader(uid, std::move(shader)); }
 
+    u32 UpdatePriority(u32 priority) override { return usage ? usage->priority : priority; }
+
   private:
     ShaderCache* shader_cache;
     std::unique_ptr<AbstractShader> shader;
     PixelShaderUid uid;
+    PendingPipelineUsagePtr usage;
   };
 
   m_ps_cache.shader_map[uid].pending = true;
-  auto wi = m_async_shader_compiler->CreateWorkItem<PixelShaderWorkItem>(this, uid);
+  auto wi =
+      m_async_shader_compiler->CreateWorkItem<PixelShaderWorkItem>(this, uid, std::move(usage));
   m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
 }
 
@@ -945,13 +1091,15 @@ void ShaderCache::QueuePixelUberShaderCompile(const UberShader::PixelShaderUid&
   m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
 }
 
-void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
+void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority,
+                                       PendingPipelineUsagePtr usage)
 {
   class PipelineWorkItem final : public AsyncShaderCompiler::WorkItem
   {
   public:
-    PipelineWorkItem(ShaderCache* shader_cache_, const GXPipelineUid& uid_, u32 priority_)
-        : shader_cache(shader_cache_), uid(uid_), priority(priority_)
+    PipelineWorkItem(ShaderCache* shader_cache_, const GXPipelineUid& uid_, u32 priority_,
+                     PendingPipelineUsagePtr usage_)
+        : shader_cache(shader_cache_), uid(uid_), priority(priority_), usage(std::move(usage_))
     {
       // Check if all the stages required for this pipeline have been compiled.
       // If not, this work item becomes a no-op, and re-queues the pipeline for the next frame.
@@ -966,7 +1114,7 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
       auto vs_it = shader_cache->m_vs_cache.shader_map.find(uid.vs_uid);
       stages_ready &= vs_it != shader_cache->m_vs_cache.shader_map.end() && !vs_it->second.pending;
       if (vs_it == shader_cache->m_vs_cache.shader_map.end())
-        shader_cache->QueueVertexShaderCompile(uid.vs_uid, priority);
+        shader_cache->QueueVertexShaderCompile(uid.vs_uid, priority, usage);
 
       PixelShaderUid ps_uid = uid.ps_uid;
       ClearUnusedPixelShaderUidBits(shader_cache->m_api_type, shader_cache->m_host_config, &ps_uid);
@@ -974,7 +1122,7 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
       auto ps_it = shader_cache->m_ps_cache.shader_map.find(ps_uid);
       stages_ready &= ps_it != shader_cache->m_ps_cache.shader_map.end() && !ps_it->second.pending;
       if (ps_it == shader_cache->m_ps_cache.shader_map.end())
-        shader_cache->QueuePixelShaderCompile(ps_uid, priority);
+        shader_cache->QueuePixelShaderCompile(ps_uid, priority, usage);
 
       return stages_ready;
     }
@@ -995,22 +1143,27 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
       else
       {
         // Re-queue for next frame.
+        const u32 new_priority = UpdatePriority(priority);
         auto wi = shader_cache->m_async_shader_compiler->CreateWorkItem<PipelineWorkItem>(
-            shader_cache, uid, priority);
-        shader_cache->m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
+            shader_cache, uid, new_priority, usage);
+        shader_cache->m_async_shader_compiler->QueueWorkItem(std::move(wi), new_priority);
       }
     }
 
+    u32 UpdatePriority(u32 priority_) override { return usage ? usage->priority : priority_; }
+
   private:
     ShaderCache* shader_cache;
     std::unique_ptr<AbstractPipeline> pipeline;
     GXPipelineUid uid;
     u32 priority;
+    PendingPipelineUsagePtr usage;
     std::optional<AbstractPipelineConfig> config;
     bool stages_ready;
   };
 
-  auto wi = m_async_shader_compiler->CreateWorkItem<PipelineWorkItem>(this, uid, priority);
+  auto wi = m_async_shader_compiler->CreateWorkItem<PipelineWorkItem>(this, uid, priority,
+                                                                      std::move(usage));
   m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
   m_gx_pipeline_cache[uid].second = true;
 }
@@ -1322,6 +1475,31 @@ const AbstractPipeline* ShaderCache::GetTextureReinterpretPipeline(TextureFormat
   return iiter.first->second.get();
 }
 
+const AbstractPipeline* ShaderCache::GetNV12ConversionPipeline()
+{
+  if (m_nv12_conversion_pipeline_compiled)
+    return m_nv12_conversion_pipeline.get();
+
+  m_nv12_conversion_pipeline_compiled = true;
+  std::unique_ptr<AbstractShader> shader = g_renderer->CreateShaderFromSource(
+      ShaderStage::Pixel, FramebufferShaderGen::GenerateNV12ConversionPixelShader());
+  if (!shader)
+    return nullptr;
+
+  AbstractPipelineConfig config;
+  config.vertex_format = nullptr;
+  config.vertex_shader = m_screen_quad_vertex_shader.get();
+  config.geometry_shader = nullptr;
+  config.pixel_shader = shader.get();
+  config.rasterization_state = RenderState::GetNoCullRasterizationState(PrimitiveType::Triangles);
+  config.depth_state = RenderState::GetNoDepthTestingDepthState();
+  config.blending_state = RenderState::GetNoBlendingBlendState();
+  config.framebuffer_state = RenderState::GetRGBA8FramebufferState();
+  config.usage = AbstractPipelineUsage::Utility;
+  m_nv12_conversion_pipeline = g_renderer->CreatePipeline(config);
+  return m_nv12_conversion_pipeline.get();
+}
+
 const AbstractShader* ShaderCache::GetTextureDecodingShader(TextureFormat format,
                                                             TLUTFormat palette_format)
 {
@@ -10,6 +10,7 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <set>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -59,6 +60,10 @@ public:
   // Reloads/recreates all shaders and pipelines.
   void Reload();
 
+  // Switches the game-specific disk caches over to the running game, if it changed. Everything
+  // compiled so far stays in memory.
+  void ReloadGameCaches();
+
   // Retrieves all pending shaders/pipelines from the async compiler.
   void RetrieveAsyncShaders();
 
@@ -70,6 +75,10 @@ public:
   // The optional will be empty if this pipeline is now background compiling.
   std::optional<const AbstractPipeline*> GetPipelineForUidAsync(const GXPipelineUid& uid);
 
+  // Records a draw with a pipeline that is still being compiled in the background, covering
+  // roughly the given number of pixels. Pipelines that cover more of the screen compile first.
+  void CountPendingPipelineUse(const GXPipelineUid& uid, u64 pixels);
+
   // Shared shaders
   const AbstractShader* GetScreenQuadVertexShader() const
   {
@@ -110,16 +119,35 @@ public:
   const AbstractPipeline* GetTextureReinterpretPipeline(TextureFormat from_format,
                                                         TextureFormat to_format);
 
+  // RGBA8 to NV12 conversion pipeline for frame dumping, compiled on first use
+  const AbstractPipeline* GetNV12ConversionPipeline();
+
   // Texture decoding compute shaders
   const AbstractShader* GetTextureDecodingShader(TextureFormat format, TLUTFormat palette_format);
 
 private:
+  // How often and how much of the screen a specialized pipeline has been drawn with while it was
+  // compiling. Shared with its work items and those of its shader stages.
+  struct PendingPipelineUsage
+  {
+    u64 pixels = 0;
+    u32 priority = 0;
+  };
+  using PendingPipelineUsagePtr = std::shared_ptr<PendingPipelineUsage>;
+
   static constexpr size_t NUM_PALETTE_CONVERSION_SHADERS = 3;
+  static constexpr u32 PIPELINE_UID_CACHE_FILE_MAGIC = 0x44495550;  // PUID
+  static constexpr const char* SHARED_PIPELINE_UID_CACHE_NAME = "Local.uidcache";
 
   void WaitForAsyncCompiler();
   void LoadCaches();
   void ClearCaches();
   void LoadPipelineUIDCache();
+  // Adds the UIDs of a UID cache file to the pipeline map, optionally also collecting them.
+  // Returns false if the file is corrupted or from another UID version.
+  bool ReadPipelineUIDCache(File::IOFile& file, std::set<GXPipelineUid>* read_uids);
+  // Opens a UID cache for appending, writing out all known UIDs the file doesn't have yet.
+  void OpenPipelineUIDCache(File::IOFile& file, const std::string& filename);
   void ClosePipelineUIDCache();
   void CompileMissingPipelines();
   void QueueUberShaderPipelines();
@@ -158,15 +186,19 @@ private:
                                            std::unique_ptr<AbstractPipeline> pipeline);
   const AbstractPipeline* InsertGXUberPipeline(const GXUberPipelineUid& config,
                                                std::unique_ptr<AbstractPipeline> pipeline);
-  void AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid);
+  GXPipelineUid AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid);
   void AppendGXPipelineUID(const GXPipelineUid& config);
+  void WritePipelineUID(File::IOFile& file, const GXPipelineUid& config);
 
   // ASync Compiler Methods
-  void QueueVertexShaderCompile(const VertexShaderUid& uid, u32 priority);
+  void QueueVertexShaderCompile(const VertexShaderUid& uid, u32 priority,
+                                PendingPipelineUsagePtr usage = nullptr);
   void QueueVertexUberShaderCompile(const UberShader::VertexShaderUid& uid, u32 priority);
-  void QueuePixelShaderCompile(const PixelShaderUid& uid, u32 priority);
+  void QueuePixelShaderCompile(const PixelShaderUid& uid, u32 priority,
+                               PendingPipelineUsagePtr usage = nullptr);
   void QueuePixelUberShaderCompile(const UberShader::PixelShaderUid& uid, u32 priority);
-  void QueuePipelineCompile(const GXPipelineUid& uid, u32 priority);
+  void QueuePipelineCompile(const GXPipelineUid& uid, u32 priority,
+                            PendingPipelineUsagePtr usage = nullptr);
   void QueueUberPipelineCompile(const GXUberPipelineUid& uid, u32 priority);
 
   // Populating various caches.
@@ -191,8 +223,13 @@ private:
     COMPILE_PRIORITY_SHADERCACHE_PIPELINE = 300
   };
 
+  // On demand pipelines move up by one for every doubling of the pixels they have covered.
+  static constexpr int MAX_PENDING_PIPELINE_USAGE_BOOST = 63;
+
   // Configuration bits.
   APIType m_api_type;
+  // The game the game-specific disk caches are open for
+  std::string m_game_id;
   ShaderHostConfig m_host_config = {};
   std::unique_ptr<AsyncShaderCompiler> m_async_shader_compiler;
 
@@ -227,7 +264,10 @@ private:
   std::map<GXPipelineUid, std::pair<std::unique_ptr<AbstractPipeline>, bool>> m_gx_pipeline_cache;
   std::map<GXUberPipelineUid, std::pair<std::unique_ptr<AbstractPipeline>, bool>>
       m_gx_uber_pipeline_cache;
+  std::map<GXPipelineUid, PendingPipelineUsagePtr> m_pending_pipeline_usage;
+  bool m_pending_pipeline_priorities_changed = false;
   File::IOFile m_gx_pipeline_uid_cache_file;
+  File::IOFile m_shared_pipeline_uid_cache_file;
   LinearDiskCache<SerializedGXPipelineUid, u8> m_gx_pipeline_disk_cache;
   LinearDiskCache<SerializedGXUberPipelineUid, u8> m_gx_uber_pipeline_disk_cache;
 
@@ -248,6 +288,10 @@ private:
   std::map<std::pair<TextureFormat, TextureFormat>, std::unique_ptr<AbstractPipeline>>
       m_texture_reinterpret_pipelines;
 
+  // Frame dump NV12 conversion pipeline
+  std::unique_ptr<AbstractPipeline> m_nv12_conversion_pipeline;
+  bool m_nv12_conversion_pipeline_compiled = false;
+
   // Texture decoding shaders
   std::map<std::pair<u32, u32>, std::unique_ptr<AbstractShader>> m_texture_decoding_shaders;
 };
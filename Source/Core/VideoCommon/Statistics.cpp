@@ -64,6 +64,8 @@ void Statistics::Display() const
   draw_statistic("Textures created", "%d", num_textures_created);
   draw_statistic("Textures uploaded", "%d", num_textures_uploaded);
   draw_statistic("Textures alive", "%d", num_textures_alive);
+  draw_statistic("Texture memory", "%.1f MB", texture_cache_bytes / (1024.0 * 1024.0));
+  draw_statistic("Texture pool", "%.1f MB", texture_pool_bytes / (1024.0 * 1024.0));
   draw_statistic("pshaders created", "%d", num_pixel_shaders_created);
   draw_statistic("pshaders alive", "%d", num_pixel_shaders_alive);
   draw_statistic("vshaders created", "%d", num_vertex_shaders_created);
@@ -86,6 +88,7 @@ void Statistics::Display() const
   draw_statistic("Vertex Loaders", "%d", num_vertex_loaders);
   draw_statistic("EFB peeks:", "%d", this_frame.num_efb_peeks);
   draw_statistic("EFB pokes:", "%d", this_frame.num_efb_pokes);
+  draw_statistic("Descriptor sets pushed:", "%d", this_frame.num_descriptor_sets_pushed);
 
   ImGui::Columns(1);
 
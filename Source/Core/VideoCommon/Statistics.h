@@ -5,6 +5,7 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 
 struct Statistics
 {
@@ -16,6 +17,9 @@ struct Statistics
   int num_textures_created;
   int num_textures_uploaded;
   int num_textures_alive;
+  // Host memory taken by the textures in the texture cache, and by the textures pooled for reuse
+  size_t texture_cache_bytes;
+  size_t texture_pool_bytes;
 
   int num_vertex_loaders;
 
@@ -59,6 +63,9 @@ struct Statistics
 
     int num_efb_peeks;
     int num_efb_pokes;
+
+    // Descriptor sets written into the command buffer instead of being allocated
+    int num_descriptor_sets_pushed;
   };
   ThisFrame this_frame;
   void ResetFrame();
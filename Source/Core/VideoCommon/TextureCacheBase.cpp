@@ -26,6 +26,7 @@
 #include "Common/Logging/Log.h"
 #include "Common/MathUtil.h"
 #include "Common/MemoryUtil.h"
+#include "Common/Trace.h"
 
 #include "Core/Config/GraphicsSettings.h"
 #include "Core/ConfigManager.h"
@@ -36,6 +37,7 @@
 #include "VideoCommon/AbstractFramebuffer.h"
 #include "VideoCommon/AbstractStagingTexture.h"
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/FrameProfiler.h"
 #include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/HiresTextures.h"
 #include "VideoCommon/OpcodeDecoding.h"
@@ -55,6 +57,8 @@ static const u64 TEXHASH_INVALID = 0;
 // Sonic the Fighters (inside Sonic Gems Collection) loops a 64 frames animation
 static const int TEXTURE_KILL_THRESHOLD = 64;
 static const int TEXTURE_POOL_KILL_THRESHOLD = 3;
+// Host memory the readbacks queued for a save state may take up at once
+static const size_t MAX_STATE_READBACK_SIZE = 256 * 1024 * 1024;
 
 std::unique_ptr<TextureCacheBase> g_texture_cache;
 
@@ -96,6 +100,8 @@ TextureCacheBase::TextureCacheBase()
 
   Common::SetHash64Function();
 
+  m_mipmap_detection_thread.Reset([](std::function<void()> detection) { detection(); });
+
   InvalidateAllBindPoints();
 }
 
@@ -133,14 +139,36 @@ void TextureCacheBase::Invalidate()
   }
   textures_by_address.clear();
   textures_by_hash.clear();
+  m_texture_size_classes.fill(0);
 
   texture_pool.clear();
 }
 
+void TextureCacheBase::DiscardAll()
+{
+  // Copies that were invalidated already only live on in the pending list
+  for (TCacheEntry* entry : m_pending_efb_copies)
+  {
+    ReleaseEFBCopyStagingTexture(std::move(entry->pending_efb_copy));
+    if (entry->pending_efb_copy_invalidated)
+      delete entry;
+  }
+  m_pending_efb_copies.clear();
+
+  // With nothing bound, every entry is removed outright rather than being kept for TMEM
+  InvalidateAllBindPoints();
+  bound_textures.fill(nullptr);
+
+  auto iter = textures_by_address.begin();
+  while (iter != textures_by_address.end())
+    iter = InvalidateTexture(iter, true);
+}
+
 void TextureCacheBase::OnConfigChanged(const VideoConfig& config)
 {
   if (config.bHiresTextures != backup_config.hires_textures ||
-      config.bCacheHiresTextures != backup_config.cache_hires_textures)
+      config.bCacheHiresTextures != backup_config.cache_hires_textures ||
+      config.bStreamHiresTextures != backup_config.stream_hires_textures)
   {
     HiresTexture::Update();
   }
@@ -222,6 +250,8 @@ void TextureCacheBase::Cleanup(int _frameCount)
       ++iter2;
     }
   }
+
+  EnforceMemoryBudget(_frameCount);
 }
 
 bool TextureCacheBase::TCacheEntry::OverlapsMemoryRange(u32 range_address, u32 range_size) const
@@ -242,6 +272,7 @@ void TextureCacheBase::SetBackupConfig(const VideoConfig& config)
   backup_config.texfmt_overlay_center = config.bTexFmtOverlayCenter;
   backup_config.hires_textures = config.bHiresTextures;
   backup_config.cache_hires_textures = config.bCacheHiresTextures;
+  backup_config.stream_hires_textures = config.bStreamHiresTextures;
   backup_config.stereo_3d = config.stereo_mode != StereoMode::Off;
   backup_config.efb_mono_depth = config.bStereoEFBMonoDepth;
   backup_config.gpu_texture_decoding = config.bEnableGPUTextureDecoding;
@@ -314,7 +345,7 @@ TextureCacheBase::ApplyPaletteToEntry(TCacheEntry* entry, u8* palette, TLUTForma
     g_renderer->EndUtilityDrawing();
   }
 
-  textures_by_address.emplace(decoded_entry->addr, decoded_entry);
+  AddToAddressCache(decoded_entry->addr, decoded_entry);
 
   return decoded_entry;
 }
@@ -361,7 +392,7 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::ReinterpretEntry(const TCacheEn
   g_renderer->EndUtilityDrawing();
   reinterpreted_entry->texture->FinishedRendering();
 
-  textures_by_address.emplace(reinterpreted_entry->addr, reinterpreted_entry);
+  AddToAddressCache(reinterpreted_entry->addr, reinterpreted_entry);
 
   return reinterpreted_entry;
 }
@@ -427,8 +458,14 @@ void TextureCacheBase::SerializeTexture(AbstractTexture* tex, const TextureConfi
   const bool skip_readback = p.GetMode() == PointerWrap::MODE_MEASURE;
   p.DoPOD(config);
 
+  // Use the readback queued at the start of the save if there is one.
+  auto queued = skip_readback ? m_state_readbacks.end() : m_state_readbacks.find(tex);
+  if (queued != m_state_readbacks.end() && queued->second.config != config)
+    queued = m_state_readbacks.end();
+
   std::vector<u8> texture_data;
-  if (skip_readback || CheckReadbackTexture(config.width, config.height, config.format))
+  if (queued != m_state_readbacks.end() || skip_readback ||
+      CheckReadbackTexture(config.width, config.height, config.format))
   {
     // Save out each layer of the texture to the staging texture, and then
     // append it onto the end of the vector. This gives us all the sub-images
@@ -440,7 +477,10 @@ void TextureCacheBase::SerializeTexture(AbstractTexture* tex, const TextureConfi
         u32 level_width = std::max(config.width >> level, 1u);
         u32 level_height = std::max(config.height >> level, 1u);
         auto rect = tex->GetConfig().GetMipRect(level);
-        if (!skip_readback)
+        AbstractStagingTexture* staging_texture = m_readback_texture.get();
+        if (queued != m_state_readbacks.end())
+          staging_texture = queued->second.levels[layer * config.levels + level].get();
+        else if (!skip_readback)
           m_readback_texture->CopyFromTexture(tex, rect, layer, level, rect);
 
         size_t stride = AbstractTexture::CalculateStrideForFormat(config.format, level_width);
@@ -448,9 +488,12 @@ void TextureCacheBase::SerializeTexture(AbstractTexture* tex, const TextureConfi
         size_t start = texture_data.size();
         texture_data.resize(texture_data.size() + size);
         if (!skip_readback)
-          m_readback_texture->ReadTexels(rect, &texture_data[start], static_cast<u32>(stride));
+          staging_texture->ReadTexels(rect, &texture_data[start], static_cast<u32>(stride));
       }
     }
+
+    if (queued != m_state_readbacks.end())
+      m_state_readbacks.erase(queued);
   }
   else
   {
@@ -460,6 +503,60 @@ void TextureCacheBase::SerializeTexture(AbstractTexture* tex, const TextureConfi
   p.Do(texture_data);
 }
 
+void TextureCacheBase::QueueTextureReadback(const AbstractTexture* tex,
+                                            const TextureConfig& config)
+{
+  if (m_state_readbacks.count(tex) != 0)
+    return;
+
+  const size_t size = GetTextureMemorySize(config);
+  if (m_state_readback_size + size > MAX_STATE_READBACK_SIZE)
+    return;
+
+  StateReadback readback;
+  readback.config = config;
+  for (u32 layer = 0; layer < config.layers; layer++)
+  {
+    for (u32 level = 0; level < config.levels; level++)
+    {
+      const auto rect = tex->GetConfig().GetMipRect(level);
+      const TextureConfig staging_config(rect.GetWidth(), rect.GetHeight(), 1, 1, 1,
+                                         config.format, 0);
+      auto staging_texture =
+          g_renderer->CreateStagingTexture(StagingTextureType::Readback, staging_config);
+      if (!staging_texture)
+        return;
+
+      staging_texture->CopyFromTexture(tex, rect, layer, level, rect);
+      readback.levels.push_back(std::move(staging_texture));
+    }
+  }
+
+  m_state_readback_size += size;
+  m_state_readbacks.emplace(tex, std::move(readback));
+}
+
+void TextureCacheBase::QueueSaveStateReadbacks()
+{
+  if (!Config::Get(Config::GFX_SAVE_TEXTURE_CACHE_TO_STATE))
+    return;
+
+  // Write out the pending EFB copies first, so waiting for them doesn't also wait for the
+  // readbacks queued here.
+  FlushEFBCopies();
+
+  for (const auto& it : textures_by_address)
+  {
+    if (ShouldSaveEntryToState(it.second))
+      QueueTextureReadback(it.second->texture.get(), it.second->texture->GetConfig());
+  }
+  for (const auto& it : textures_by_hash)
+  {
+    if (ShouldSaveEntryToState(it.second))
+      QueueTextureReadback(it.second->texture.get(), it.second->texture->GetConfig());
+  }
+}
+
 std::optional<TextureCacheBase::TexPoolEntry> TextureCacheBase::DeserializeTexture(PointerWrap& p)
 {
   TextureConfig config;
@@ -514,15 +611,20 @@ void TextureCacheBase::DoState(PointerWrap& p)
     DoLoadState(p);
 }
 
+bool TextureCacheBase::ShouldSaveEntryToState(const TCacheEntry* entry)
+{
+  // We skip non-copies as they can be decoded from RAM when the state is loaded.
+  // Storing them would duplicate data in the save state file, adding to decompression time.
+  // Optionally, copies that were also written to RAM are skipped too, at the cost of their
+  // upscaling after loading.
+  return entry->IsCopy() &&
+         !(entry->copied_to_ram && Config::Get(Config::GFX_SAVE_ONLY_VRAM_COPIES_TO_STATE));
+}
+
 void TextureCacheBase::DoSaveState(PointerWrap& p)
 {
   std::map<const TCacheEntry*, u32> entry_map;
   std::vector<TCacheEntry*> entries_to_save;
-  auto ShouldSaveEntry = [](const TCacheEntry* entry) {
-    // We skip non-copies as they can be decoded from RAM when the state is loaded.
-    // Storing them would duplicate data in the save state file, adding to decompression time.
-    return entry->IsCopy();
-  };
   auto AddCacheEntryToMap = [&entry_map, &entries_to_save](TCacheEntry* entry) -> u32 {
     auto iter = entry_map.find(entry);
     if (iter != entry_map.end())
@@ -549,7 +651,7 @@ void TextureCacheBase::DoSaveState(PointerWrap& p)
   {
     for (const auto& it : textures_by_address)
     {
-      if (ShouldSaveEntry(it.second))
+      if (ShouldSaveEntryToState(it.second))
       {
         const u32 id = AddCacheEntryToMap(it.second);
         textures_by_address_list.emplace_back(it.first, id);
@@ -557,7 +659,7 @@ void TextureCacheBase::DoSaveState(PointerWrap& p)
     }
     for (const auto& it : textures_by_hash)
     {
-      if (ShouldSaveEntry(it.second))
+      if (ShouldSaveEntryToState(it.second))
       {
         const u32 id = AddCacheEntryToMap(it.second);
         textures_by_hash_list.emplace_back(it.first, id);
@@ -622,9 +724,11 @@ void TextureCacheBase::DoSaveState(PointerWrap& p)
     p.Do(it.second);
   }
 
-  // Free the readback texture to potentially save host-mapped GPU memory, depending on where
+  // Free the readback textures to potentially save host-mapped GPU memory, depending on where
   // the driver mapped the staging buffer.
   m_readback_texture.reset();
+  m_state_readbacks.clear();
+  m_state_readback_size = 0;
 }
 
 void TextureCacheBase::DoLoadState(PointerWrap& p)
@@ -685,7 +789,7 @@ void TextureCacheBase::DoLoadState(PointerWrap& p)
 
     TCacheEntry* entry = GetEntry(id);
     if (entry)
-      textures_by_address.emplace(addr, entry);
+      AddToAddressCache(addr, entry);
   }
 
   // Fill in hash map.
@@ -1004,11 +1108,23 @@ static void SetSamplerState(u32 index, float custom_tex_scale, bool custom_tex,
 
 void TextureCacheBase::BindTextures()
 {
+  m_num_memoized_hashes = 0;
+
   for (u32 i = 0; i < bound_textures.size(); i++)
   {
-    const TCacheEntry* tentry = bound_textures[i];
+    TCacheEntry* tentry = bound_textures[i];
     if (IsValidBindPoint(i) && tentry)
     {
+      if (tentry->pending_arbitrary_mips)
+      {
+        const int result = tentry->pending_arbitrary_mips->load(std::memory_order_acquire);
+        if (result >= 0)
+        {
+          tentry->has_arbitrary_mips = result != 0;
+          tentry->pending_arbitrary_mips.reset();
+        }
+      }
+
       g_renderer->SetTexture(i, tentry->texture.get());
       PixelShaderManager::SetTexDims(i, tentry->native_width, tentry->native_height);
 
@@ -1032,12 +1148,40 @@ public:
     levels.push_back({{width, height, row_length}, buffer});
   }
 
-  bool HasArbitraryMipmaps(u8* downsample_buffer) const
+  bool NeedsDetection() const
   {
-    if (levels.size() < 2)
-      return false;
+    return levels.size() >= 2 && g_ActiveConfig.bArbitraryMipmapDetection;
+  }
+
+  // Copies the levels out of the decoding buffer, so the detector can outlive it
+  void CopyLevels()
+  {
+    size_t total_size = 0;
+    for (const Level& level : levels)
+      total_size += static_cast<size_t>(level.shape.row_length) * level.shape.height * 4;
 
-    if (!g_ActiveConfig.bArbitraryMipmapDetection)
+    storage.resize(total_size);
+    u8* dst = storage.data();
+    for (Level& level : levels)
+    {
+      const size_t size = static_cast<size_t>(level.shape.row_length) * level.shape.height * 4;
+      std::memcpy(dst, level.pixels, size);
+      level.pixels = dst;
+      dst += size;
+    }
+  }
+
+  // Room for two downsampled copies of the first level
+  size_t GetDownsampleBufferSize() const
+  {
+    return levels.size() < 2 ?
+               0 :
+               static_cast<size_t>(levels[1].shape.row_length) * levels[1].shape.height * 4 * 2;
+  }
+
+  bool HasArbitraryMipmaps(u8* downsample_buffer) const
+  {
+    if (!NeedsDetection())
       return false;
 
     // This is the average per-pixel, per-channel difference in percent between what we
@@ -1161,6 +1305,7 @@ private:
     }
   };
   std::vector<Level> levels;
+  std::vector<u8> storage;
 };
 
 TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
@@ -1171,6 +1316,7 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
     return bound_textures[stage];
   }
 
+  TRACE_SCOPE("TextureCacheBase::Load");
   const FourTexUnits& tex = bpmem.tex[stage >> 2];
   const u32 id = stage & 3;
   const u32 address = (tex.texImage3[id].image_base /* & 0x1FFFFF*/) << 5;
@@ -1276,13 +1422,13 @@ TextureCacheBase::GetTexture(u32 address, u32 width, u32 height, const TextureFo
 
   // TODO: This doesn't hash GB tiles for preloaded RGBA8 textures (instead, it's hashing more data
   // from the low tmem bank than it should)
-  base_hash = Common::GetHash64(src_data, texture_size, textureCacheSafetyColorSampleSize);
+  base_hash = GetMemoizedHash(src_data, texture_size, textureCacheSafetyColorSampleSize);
   u32 palette_size = 0;
   if (isPaletteTexture)
   {
     palette_size = TexDecoder_GetPaletteSize(texformat);
-    full_hash = base_hash ^ Common::GetHash64(&texMem[tlutaddr], palette_size,
-                                              textureCacheSafetyColorSampleSize);
+    full_hash = base_hash ^ GetMemoizedHash(&texMem[tlutaddr], palette_size,
+                                            textureCacheSafetyColorSampleSize);
   }
   else
   {
@@ -1420,6 +1566,12 @@ TextureCacheBase::GetTexture(u32 address, u32 width, u32 height, const TextureFo
           entry->native_levels >= tex_levels && entry->native_width == nativeW &&
           entry->native_height == nativeH)
       {
+        if (IsHiresTextureReady(entry))
+        {
+          iter = InvalidateTexture(iter);
+          continue;
+        }
+
         entry = DoPartialTextureUpdates(iter->second, &texMem[tlutaddr], tlutfmt);
         entry->texture->FinishedRendering();
         return entry;
@@ -1481,7 +1633,8 @@ TextureCacheBase::GetTexture(u32 address, u32 width, u32 height, const TextureFo
       TCacheEntry* entry = hash_iter->second;
       // All parameters, except the address, need to match here
       if (entry->format == full_format && entry->native_levels >= tex_levels &&
-          entry->native_width == nativeW && entry->native_height == nativeH)
+          entry->native_width == nativeW && entry->native_height == nativeH &&
+          !IsHiresTextureReady(entry))
       {
         entry = DoPartialTextureUpdates(hash_iter->second, &texMem[tlutaddr], tlutfmt);
         entry->texture->FinishedRendering();
@@ -1499,10 +1652,12 @@ TextureCacheBase::GetTexture(u32 address, u32 width, u32 height, const TextureFo
   }
 
   std::shared_ptr<HiresTexture> hires_tex;
-  if (g_ActiveConfig.bHiresTextures)
+  std::string pending_hires_name;
+  const u32 hires_load_count = HiresTexture::GetLoadCount();
+  if (g_ActiveConfig.bHiresTextures && !m_loading_palette_indices)
   {
     hires_tex = HiresTexture::Search(src_data, texture_size, &texMem[tlutaddr], palette_size, width,
-                                     height, texformat, use_mipmaps);
+                                     height, texformat, use_mipmaps, &pending_hires_name);
 
     if (hires_tex)
     {
@@ -1517,16 +1672,46 @@ TextureCacheBase::GetTexture(u32 address, u32 width, u32 height, const TextureFo
     }
   }
 
+  // Keep the indices of C4/C8 textures in an I4/I8 texture, and apply the palette on the GPU. When
+  // only the palette changes, as with palette animations, the indices don't need to be decoded and
+  // uploaded again. Dumped textures still need the palette applied on the CPU.
+  if (!hires_tex && tex_levels == 1 &&
+      (texformat == TextureFormat::C4 || texformat == TextureFormat::C8) &&
+      g_ActiveConfig.backend_info.bSupportsPaletteConversion && !g_ActiveConfig.bDumpTextures)
+  {
+    const TextureFormat index_format =
+        texformat == TextureFormat::C4 ? TextureFormat::I4 : TextureFormat::I8;
+    m_loading_palette_indices = true;
+    TCacheEntry* index_entry = GetTexture(address, nativeW, nativeH, index_format,
+                                          textureCacheSafetyColorSampleSize, tlutaddr, tlutfmt,
+                                          false, 1, from_tmem, tmem_address_even, tmem_address_odd);
+    m_loading_palette_indices = false;
+
+    // The indices are used whenever the palette changes, so keep them alive like a bound texture
+    if (index_entry)
+      index_entry->frameCount = FRAMECOUNT_INVALID;
+
+    TCacheEntry* decoded_entry =
+        index_entry ? ApplyPaletteToEntry(index_entry, &texMem[tlutaddr], tlutfmt) : nullptr;
+    if (decoded_entry)
+    {
+      // Unlike palettes applied to EFB copies, this is found again by the palette's hash
+      decoded_entry->format = full_format;
+      decoded_entry->SetHashes(base_hash, full_hash);
+      if (textureCacheSafetyColorSampleSize == 0 ||
+          std::max(texture_size, palette_size) <= (u32)textureCacheSafetyColorSampleSize * 8)
+      {
+        decoded_entry->textures_by_hash_iter = textures_by_hash.emplace(full_hash, decoded_entry);
+      }
+      return decoded_entry;
+    }
+  }
+
   // how many levels the allocated texture shall have
   const u32 texLevels = hires_tex ? (u32)hires_tex->m_levels.size() : tex_levels;
 
   // We can decode on the GPU if it is a supported format and the flag is enabled.
-  // Currently we don't decode RGBA8 textures from Tmem, as that would require copying from both
-  // banks, and if we're doing an copy we may as well just do the whole thing on the CPU, since
-  // there's no conversion between formats. In the future this could be extended with a separate
-  // shader, however.
-  const bool decode_on_gpu = !hires_tex && g_ActiveConfig.UseGPUTextureDecoding() &&
-                             !(from_tmem && texformat == TextureFormat::RGBA8);
+  const bool decode_on_gpu = !hires_tex && g_ActiveConfig.UseGPUTextureDecoding();
 
   // create the entry/texture
   const TextureConfig config(width, height, texLevels, 1, 1,
@@ -1535,6 +1720,7 @@ TextureCacheBase::GetTexture(u32 address, u32 width, u32 height, const TextureFo
   if (!entry)
     return nullptr;
 
+  FrameProfiler::ScopedTimer decode_timer(FrameProfiler::Category::TextureDecode);
   ArbitraryMipmapDetector arbitrary_mip_detector;
   const u8* tlut = &texMem[tlutaddr];
   if (hires_tex)
@@ -1549,8 +1735,19 @@ TextureCacheBase::GetTexture(u32 address, u32 width, u32 height, const TextureFo
 
   if (!hires_tex)
   {
+    // RGBA8 textures from TMEM are split across both banks, so merge them back into the main
+    // memory layout the decoding shader expects
+    const u8* gpu_src_data = src_data;
+    if (decode_on_gpu && from_tmem && texformat == TextureFormat::RGBA8)
+    {
+      CheckTempSize(texture_size);
+      TexDecoder_InterleaveRGBA8FromTmem(temp, src_data, &texMem[tmem_address_odd], expandedWidth,
+                                         expandedHeight);
+      gpu_src_data = temp;
+    }
+
     if (!decode_on_gpu ||
-        !DecodeTextureOnGPU(entry, 0, src_data, texture_size, texformat, width, height,
+        !DecodeTextureOnGPU(entry, 0, gpu_src_data, texture_size, texformat, width, height,
                             expandedWidth, expandedHeight, bytes_per_block * (expandedWidth / bsw),
                             tlut, tlutfmt))
     {
@@ -1594,7 +1791,7 @@ TextureCacheBase::GetTexture(u32 address, u32 width, u32 height, const TextureFo
     }
   }
 
-  iter = textures_by_address.emplace(address, entry);
+  iter = AddToAddressCache(address, entry);
   if (textureCacheSafetyColorSampleSize == 0 ||
       std::max(texture_size, palette_size) <= (u32)textureCacheSafetyColorSampleSize * 8)
   {
@@ -1605,6 +1802,8 @@ TextureCacheBase::GetTexture(u32 address, u32 width, u32 height, const TextureFo
   entry->SetDimensions(nativeW, nativeH, tex_levels);
   entry->SetHashes(base_hash, full_hash);
   entry->is_custom_tex = hires_tex != nullptr;
+  entry->pending_hires_name = std::move(pending_hires_name);
+  entry->pending_hires_load_count = hires_load_count;
   entry->memory_stride = entry->BytesPerRow();
   entry->SetNotCopy();
 
@@ -1669,8 +1868,29 @@ TextureCacheBase::GetTexture(u32 address, u32 width, u32 height, const TextureFo
     }
   }
 
-  entry->has_arbitrary_mips = hires_tex ? hires_tex->HasArbitraryMipmaps() :
-                                          arbitrary_mip_detector.HasArbitraryMipmaps(dst_buffer);
+  entry->pending_arbitrary_mips.reset();
+  if (hires_tex)
+  {
+    entry->has_arbitrary_mips = hires_tex->HasArbitraryMipmaps();
+  }
+  else if (arbitrary_mip_detector.NeedsDetection() && !g_ActiveConfig.bDumpTextures)
+  {
+    // Sample as normal mipmaps until the detection has finished in the background. Dumped
+    // textures are named after the result, so they still wait for it.
+    entry->has_arbitrary_mips = false;
+    entry->pending_arbitrary_mips = std::make_shared<std::atomic<int>>(-1);
+    arbitrary_mip_detector.CopyLevels();
+    m_mipmap_detection_thread.EmplaceItem(
+        [detector = std::move(arbitrary_mip_detector), result = entry->pending_arbitrary_mips] {
+          std::vector<u8> downsample_buffer(detector.GetDownsampleBufferSize());
+          result->store(detector.HasArbitraryMipmaps(downsample_buffer.data()) ? 1 : 0,
+                        std::memory_order_release);
+        });
+  }
+  else
+  {
+    entry->has_arbitrary_mips = arbitrary_mip_detector.HasArbitraryMipmaps(dst_buffer);
+  }
 
   if (g_ActiveConfig.bDumpTextures && !hires_tex)
   {
@@ -1741,9 +1961,13 @@ TextureCacheBase::GetXFBTexture(u32 address, u32 width, u32 height, u32 stride,
   entry->is_custom_tex = false;
   entry->may_have_overlapping_textures = false;
   entry->frameCount = FRAMECOUNT_INVALID;
-  if (!g_ActiveConfig.UseGPUTextureDecoding() ||
-      !DecodeTextureOnGPU(entry, 0, src_data, total_size, entry->format.texfmt, width, height,
-                          width, height, stride, texMem, entry->format.tlutfmt))
+  // Without XFB copies to RAM, guest memory only holds placeholder data. There is no point in
+  // decoding it if the VRAM copies are going to replace all of it anyway.
+  const bool skip_ram_decode = g_ActiveConfig.bSkipXFBCopyToRam && IsXFBCoveredByCopies(entry);
+  if (!skip_ram_decode &&
+      (!g_ActiveConfig.UseGPUTextureDecoding() ||
+       !DecodeTextureOnGPU(entry, 0, src_data, total_size, entry->format.texfmt, width, height,
+                           width, height, stride, texMem, entry->format.tlutfmt)))
   {
     const u32 decoded_size = width * height * sizeof(u32);
     CheckTempSize(decoded_size);
@@ -1756,7 +1980,7 @@ TextureCacheBase::GetXFBTexture(u32 address, u32 width, u32 height, u32 stride,
   entry->texture->FinishedRendering();
 
   // Insert into the texture cache so we can re-use it next frame, if needed.
-  textures_by_address.emplace(entry->addr, entry);
+  AddToAddressCache(entry->addr, entry);
   SETSTAT(g_stats.num_textures_alive, static_cast<int>(textures_by_address.size()));
   INCSTAT(g_stats.num_textures_uploaded);
 
@@ -1815,6 +2039,64 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::GetXFBFromCache(u32 address, u3
   return nullptr;
 }
 
+bool TextureCacheBase::IsXFBCoveredByCopies(const TCacheEntry* xfb_entry)
+{
+  // This mirrors the placement in StitchXFBCopy, but only accepts copies which span whole lines
+  const u32 width = xfb_entry->native_width;
+  const u32 height = xfb_entry->native_height;
+  std::vector<bool> covered_lines(height, false);
+
+  auto iter = FindOverlappingTextures(xfb_entry->addr, xfb_entry->size_in_bytes);
+  for (; iter.first != iter.second; ++iter.first)
+  {
+    TCacheEntry* entry = iter.first->second;
+    if (entry == xfb_entry || !entry->IsCopy() || entry->tmem_only ||
+        !entry->OverlapsMemoryRange(xfb_entry->addr, xfb_entry->size_in_bytes) ||
+        entry->memory_stride != xfb_entry->memory_stride)
+    {
+      continue;
+    }
+
+    // StitchXFBCopy skips copies whose VRAM size doesn't match, e.g. because of Y scaling
+    const bool upscaled = entry->native_width != entry->GetWidth();
+    if (entry->GetHeight() !=
+        (upscaled ? g_renderer->EFBToScaledY(entry->native_height) : entry->native_height))
+    {
+      continue;
+    }
+
+    u32 first_line, src_x, src_y;
+    if (entry->addr >= xfb_entry->addr)
+    {
+      const u32 pixel_offset = (entry->addr - xfb_entry->addr) / 2;
+      if (pixel_offset % width != 0)
+        continue;
+      first_line = pixel_offset / width;
+      src_x = 0;
+      src_y = 0;
+    }
+    else
+    {
+      const u32 pixel_offset = (xfb_entry->addr - entry->addr) / 2;
+      first_line = 0;
+      src_x = pixel_offset % entry->native_width;
+      src_y = pixel_offset / entry->native_width;
+    }
+
+    if (src_x != 0 || entry->native_width < width || src_y >= entry->native_height ||
+        entry->hash != entry->CalculateHash())
+    {
+      continue;
+    }
+
+    const u32 end_line = std::min(height, first_line + entry->native_height - src_y);
+    for (u32 line = first_line; line < end_line; line++)
+      covered_lines[line] = true;
+  }
+
+  return std::all_of(covered_lines.begin(), covered_lines.end(), [](bool line) { return line; });
+}
+
 void TextureCacheBase::StitchXFBCopy(TCacheEntry* stitched_entry)
 {
   // It is possible that some of the overlapping textures overlap each other. This behavior has been
@@ -2167,6 +2449,7 @@ void TextureCacheBase::CopyRenderTargetToTexture(
       }
       entry->may_have_overlapping_textures = false;
       entry->is_custom_tex = false;
+      entry->copied_to_ram = copy_to_ram;
 
       CopyEFBToCacheEntry(entry, is_depth_copy, srcRect, scaleByHalf, linear_filter, dstFormat,
                           isIntensity, gamma, clamp_top, clamp_bottom,
@@ -2217,6 +2500,7 @@ void TextureCacheBase::CopyRenderTargetToTexture(
         entry->pending_efb_copy_width = bytes_per_row / sizeof(u32);
         entry->pending_efb_copy_height = num_blocks_y;
         entry->pending_efb_copy_invalidated = false;
+        entry->pending_efb_copy_frame = m_efb_copy_frame;
         m_pending_efb_copies.push_back(entry);
       }
     }
@@ -2322,7 +2606,7 @@ void TextureCacheBase::CopyRenderTargetToTexture(
   {
     const u64 hash = entry->CalculateHash();
     entry->SetHashes(hash, hash);
-    textures_by_address.emplace(dstAddr, entry);
+    AddToAddressCache(dstAddr, entry);
   }
 }
 
@@ -2336,9 +2620,31 @@ void TextureCacheBase::FlushEFBCopies()
   m_pending_efb_copies.clear();
 }
 
+void TextureCacheBase::FlushEFBCopiesAtEndOfFrame()
+{
+  const u32 frame = m_efb_copy_frame++;
+  if (!g_ActiveConfig.bDeferEFBCopiesAcrossFrames)
+  {
+    FlushEFBCopies();
+    return;
+  }
+
+  // Copies from this frame stay pending, behind the older ones, so the order is kept.
+  std::vector<TCacheEntry*> still_pending;
+  for (TCacheEntry* entry : m_pending_efb_copies)
+  {
+    if (entry->pending_efb_copy_frame == frame)
+      still_pending.push_back(entry);
+    else
+      FlushEFBCopy(entry);
+  }
+  m_pending_efb_copies = std::move(still_pending);
+}
+
 void TextureCacheBase::WriteEFBCopyToRAM(u8* dst_ptr, u32 width, u32 height, u32 stride,
                                          std::unique_ptr<AbstractStagingTexture> staging_texture)
 {
+  FrameProfiler::ScopedTimer timer(FrameProfiler::Category::EFBStall);
   MathUtil::Rectangle<int> copy_rect(0, 0, static_cast<int>(width), static_cast<int>(height));
   staging_texture->ReadTexels(copy_rect, dst_ptr, stride);
   ReleaseEFBCopyStagingTexture(std::move(staging_texture));
@@ -2346,6 +2652,8 @@ void TextureCacheBase::WriteEFBCopyToRAM(u8* dst_ptr, u32 width, u32 height, u32
 
 void TextureCacheBase::FlushEFBCopy(TCacheEntry* entry)
 {
+  m_num_memoized_hashes = 0;
+
   // Copy from texture -> guest memory.
   u8* const dst = Memory::GetPointer(entry->addr);
   WriteEFBCopyToRAM(dst, entry->pending_efb_copy_width, entry->pending_efb_copy_height,
@@ -2537,7 +2845,17 @@ TextureCacheBase::FindOverlappingTextures(u32 addr, u32 size_in_bytes)
   // texture size. But this yields false-positives which must be checked later on.
 
   // 1024 x 1024 texel times 8 nibbles per texel
-  constexpr u32 max_texture_size = 1024 * 1024 * 4;
+  u32 max_texture_size = 1024 * 1024 * 4;
+  // Usually no live texture comes close to that, though
+  for (int size_class = static_cast<int>(m_texture_size_classes.size()) - 1; size_class >= 0;
+       size_class--)
+  {
+    if (m_texture_size_classes[size_class] != 0)
+    {
+      max_texture_size = static_cast<u32>(std::min<u64>(max_texture_size, u64(1) << size_class));
+      break;
+    }
+  }
   u32 lower_addr = addr > max_texture_size ? addr - max_texture_size : 0;
   auto begin = textures_by_address.lower_bound(lower_addr);
   auto end = textures_by_address.upper_bound(addr + size_in_bytes);
@@ -2601,6 +2919,8 @@ TextureCacheBase::InvalidateTexture(TexAddrCache::iterator iter, bool discard_pe
   texture_pool.emplace(config,
                        TexPoolEntry(std::move(entry->texture), std::move(entry->framebuffer)));
 
+  m_texture_size_classes[entry->size_class]--;
+
   // Don't delete if there's a pending EFB copy, as we need the TCacheEntry alive.
   if (!entry->pending_efb_copy)
     delete entry;
@@ -2608,6 +2928,127 @@ TextureCacheBase::InvalidateTexture(TexAddrCache::iterator iter, bool discard_pe
   return textures_by_address.erase(iter);
 }
 
+TextureCacheBase::TexAddrCache::iterator TextureCacheBase::AddToAddressCache(u32 address,
+                                                                             TCacheEntry* entry)
+{
+  // Sizes below 2^n are in class n
+  entry->size_class =
+      entry->size_in_bytes != 0 ? static_cast<u32>(IntLog2(entry->size_in_bytes)) + 1 : 0;
+  m_texture_size_classes[entry->size_class]++;
+  return textures_by_address.emplace(address, entry);
+}
+
+size_t TextureCacheBase::GetTextureMemorySize(const TextureConfig& config)
+{
+  const u32 block_size = AbstractTexture::GetBlockSizeForFormat(config.format);
+  size_t size = 0;
+  for (u32 level = 0; level < config.levels; level++)
+  {
+    const u32 width = std::max(config.width >> level, 1u);
+    const u32 height = std::max(config.height >> level, 1u);
+    const u32 rows = (height + block_size - 1) / block_size;
+    size += static_cast<size_t>(AbstractTexture::CalculateStrideForFormat(config.format, width)) *
+            rows;
+  }
+  return size * config.layers * config.samples;
+}
+
+void TextureCacheBase::EnforceMemoryBudget(int frame_count)
+{
+  size_t cache_size = 0;
+  for (const auto& entry : textures_by_address)
+    cache_size += GetTextureMemorySize(entry.second->texture->GetConfig());
+
+  size_t pool_size = 0;
+  for (const auto& entry : texture_pool)
+    pool_size += GetTextureMemorySize(entry.second.texture->GetConfig());
+
+  const size_t budget = static_cast<size_t>(std::max(g_ActiveConfig.iTextureCacheBudget, 0)) << 20;
+  if (budget != 0 && cache_size + pool_size > budget)
+  {
+    // Evict textures which weren't used this frame, oldest and then largest first. EFB copies
+    // count towards the budget, but can't be evicted as they can't be recreated from RAM.
+    if (cache_size > budget)
+    {
+      std::vector<std::pair<TexAddrCache::iterator, size_t>> candidates;
+      for (auto iter = textures_by_address.begin(); iter != textures_by_address.end(); ++iter)
+      {
+        const TCacheEntry* entry = iter->second;
+        if (!entry->IsCopy() && !entry->tmem_only && entry->frameCount < frame_count)
+          candidates.emplace_back(iter, GetTextureMemorySize(entry->texture->GetConfig()));
+      }
+      std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) {
+        return std::make_pair(a.first->second->frameCount, b.second) <
+               std::make_pair(b.first->second->frameCount, a.second);
+      });
+
+      for (const auto& [iter, size] : candidates)
+      {
+        if (cache_size <= budget)
+          break;
+
+        // The texture moves to the pool, which is trimmed below
+        InvalidateTexture(iter);
+        cache_size -= size;
+        pool_size += size;
+      }
+    }
+
+    // Pooled textures are only kept for reuse, so drop the oldest ones
+    std::vector<std::pair<TexPool::iterator, size_t>> pooled;
+    for (auto iter = texture_pool.begin(); iter != texture_pool.end(); ++iter)
+      pooled.emplace_back(iter, GetTextureMemorySize(iter->second.texture->GetConfig()));
+    std::sort(pooled.begin(), pooled.end(), [](const auto& a, const auto& b) {
+      return std::make_pair(a.first->second.frameCount, b.second) <
+             std::make_pair(b.first->second.frameCount, a.second);
+    });
+
+    for (const auto& [iter, size] : pooled)
+    {
+      if (cache_size + pool_size <= budget)
+        break;
+
+      texture_pool.erase(iter);
+      pool_size -= size;
+    }
+  }
+
+  g_stats.texture_cache_bytes = cache_size;
+  g_stats.texture_pool_bytes = pool_size;
+}
+
+bool TextureCacheBase::IsHiresTextureReady(TCacheEntry* entry)
+{
+  if (entry->pending_hires_name.empty())
+    return false;
+
+  // Only look the texture up again after another one has finished loading
+  const u32 load_count = HiresTexture::GetLoadCount();
+  if (entry->pending_hires_load_count == load_count)
+    return false;
+
+  if (HiresTexture::IsLoaded(entry->pending_hires_name))
+    return true;
+
+  entry->pending_hires_load_count = load_count;
+  return false;
+}
+
+u64 TextureCacheBase::GetMemoizedHash(const u8* src, u32 size, u32 samples)
+{
+  for (u32 i = 0; i < m_num_memoized_hashes; i++)
+  {
+    const MemoizedHash& memo = m_memoized_hashes[i];
+    if (memo.src == src && memo.size == size && memo.samples == samples)
+      return memo.hash;
+  }
+
+  const u64 hash = Common::GetHash64(src, size, samples);
+  if (m_num_memoized_hashes < m_memoized_hashes.size())
+    m_memoized_hashes[m_num_memoized_hashes++] = {src, size, samples, hash};
+  return hash;
+}
+
 bool TextureCacheBase::CreateUtilityTextures()
 {
   constexpr TextureConfig encoding_texture_config(
@@ -5,7 +5,9 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <bitset>
+#include <functional>
 #include <map>
 #include <memory>
 #include <optional>
@@ -17,6 +19,7 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/MathUtil.h"
+#include "Common/WorkQueueThread.h"
 #include "VideoCommon/AbstractTexture.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/TextureConfig.h"
@@ -104,6 +107,9 @@ public:
     bool should_force_safe_hashing = false;  // for XFB
     bool is_xfb_copy = false;
     bool is_xfb_container = false;
+    // Set for copies whose contents were also written to guest RAM, so they can be decoded
+    // again from there. Not saved to states, entries loaded from one are assumed not to be.
+    bool copied_to_ram = false;
     u64 id;
 
     bool reference_changed = false;  // used by xfb to determine when a reference xfb changed
@@ -119,6 +125,10 @@ public:
     // removing the cache entry
     std::multimap<u64, TCacheEntry*>::iterator textures_by_hash_iter;
 
+    // Which of TextureCacheBase::m_texture_size_classes counts this entry while it is in
+    // textures_by_address
+    u32 size_class = 0;
+
     // This is used to keep track of both:
     //   * efb copies used by this partially updated texture
     //   * partially updated textures which refer to this efb copy
@@ -129,6 +139,15 @@ public:
     u32 pending_efb_copy_width = 0;
     u32 pending_efb_copy_height = 0;
     bool pending_efb_copy_invalidated = false;
+    u32 pending_efb_copy_frame = 0;
+
+    // Result of the arbitrary mipmap detection running in the background, -1 until it's done
+    std::shared_ptr<std::atomic<int>> pending_arbitrary_mips;
+
+    // Custom texture which was still streaming in when this entry was created, and the
+    // HiresTexture load count it was last checked at
+    std::string pending_hires_name;
+    u32 pending_hires_load_count = 0;
 
     explicit TCacheEntry(std::unique_ptr<AbstractTexture> tex,
                          std::unique_ptr<AbstractFramebuffer> fb);
@@ -212,6 +231,10 @@ public:
 
   void Invalidate();
 
+  // Drops every entry for a game change, without writing pending EFB copies back to memory. The
+  // textures are kept in the pool.
+  void DiscardAll();
+
   TCacheEntry* Load(const u32 stage);
   static void InvalidateAllBindPoints() { valid_bind_points.reset(); }
   static bool IsValidBindPoint(u32 i) { return valid_bind_points.test(i); }
@@ -236,10 +259,24 @@ public:
   // Flushes all pending EFB copies to emulated RAM.
   void FlushEFBCopies();
 
+  // Called at the end of each frame. Flushes all pending EFB copies, or with copies deferred
+  // across frames, only those made before the previous end of frame. Those are long finished on
+  // the GPU, so writing them out doesn't stall.
+  void FlushEFBCopiesAtEndOfFrame();
+
   // Texture Serialization
   void SerializeTexture(AbstractTexture* tex, const TextureConfig& config, PointerWrap& p);
   std::optional<TexPoolEntry> DeserializeTexture(PointerWrap& p);
 
+  // Starts copying the texture to the CPU for a later SerializeTexture call with the same
+  // config, so the readbacks of a save state are all in flight at once instead of stalling in
+  // turn. Textures which don't fit the readback budget are read back synchronously instead.
+  void QueueTextureReadback(const AbstractTexture* tex, const TextureConfig& config);
+
+  // Queues the readbacks of the cache entries which DoState will save. Called at the start of
+  // writing a save state, the backend has to be flushed afterwards to submit them.
+  void QueueSaveStateReadbacks();
+
   // Save States
   void DoState(PointerWrap& p);
 
@@ -292,6 +329,8 @@ private:
   TCacheEntry* DoPartialTextureUpdates(TCacheEntry* entry_to_update, u8* palette,
                                        TLUTFormat tlutfmt);
   void StitchXFBCopy(TCacheEntry* entry_to_update);
+  // Whether StitchXFBCopy will overwrite every line of the entry with VRAM copies
+  bool IsXFBCoveredByCopies(const TCacheEntry* xfb_entry);
 
   void DumpTexture(TCacheEntry* entry, std::string basename, unsigned int level, bool is_arbitrary);
   void CheckTempSize(size_t required_size);
@@ -330,12 +369,48 @@ private:
   void ReleaseEFBCopyStagingTexture(std::unique_ptr<AbstractStagingTexture> tex);
 
   bool CheckReadbackTexture(u32 width, u32 height, AbstractTextureFormat format);
+  static bool ShouldSaveEntryToState(const TCacheEntry* entry);
   void DoSaveState(PointerWrap& p);
   void DoLoadState(PointerWrap& p);
 
+  TexAddrCache::iterator AddToAddressCache(u32 address, TCacheEntry* entry);
+
+  // Evicts the least recently used textures while the cache and pool use more than the
+  // configured budget, and updates the texture memory statistics
+  void EnforceMemoryBudget(int frame_count);
+  static size_t GetTextureMemorySize(const TextureConfig& config);
+
+  // Whether the custom texture this entry is a placeholder for has finished streaming in
+  static bool IsHiresTextureReady(TCacheEntry* entry);
+
+  // Hashes texture or TLUT memory, reusing the result if the same range was already hashed for
+  // another stage of the current draw
+  u64 GetMemoizedHash(const u8* src, u32 size, u32 samples);
+
   TexAddrCache textures_by_address;
   TexHashCache textures_by_hash;
   TexPool texture_pool;
+  // Number of entries in textures_by_address by the bit width of their size in bytes, so overlap
+  // queries only have to look back as far as the largest live texture
+  std::array<u32, 33> m_texture_size_classes{};
+
+  // Set while GetTexture loads the indices of a C4/C8 texture, to apply its palette on the GPU
+  bool m_loading_palette_indices = false;
+
+  // Runs arbitrary mipmap detection off the GPU thread
+  Common::WorkQueueThread<std::function<void()>> m_mipmap_detection_thread;
+
+  // Hashes taken while loading the textures of the current draw, cleared by BindTextures and
+  // whenever guest memory is written by an EFB copy
+  struct MemoizedHash
+  {
+    const u8* src;
+    u32 size;
+    u32 samples;
+    u64 hash;
+  };
+  std::array<MemoizedHash, 16> m_memoized_hashes;
+  u32 m_num_memoized_hashes = 0;
   u64 last_entry_id = 0;
 
   // Backup configuration values
@@ -346,6 +421,7 @@ private:
     bool texfmt_overlay_center;
     bool hires_textures;
     bool cache_hires_textures;
+    bool stream_hires_textures;
     bool copy_cache_enable;
     bool stereo_3d;
     bool efb_mono_depth;
@@ -368,11 +444,21 @@ private:
   // List of pending EFB copies. It is important that the order is preserved for these,
   // so that overlapping textures are written to guest RAM in the order they are issued.
   std::vector<TCacheEntry*> m_pending_efb_copies;
+  u32 m_efb_copy_frame = 0;
 
   // Staging texture used for readbacks.
   // We store this in the class so that the same staging texture can be used for multiple
   // readbacks, saving the overhead of allocating a new buffer every time.
   std::unique_ptr<AbstractStagingTexture> m_readback_texture;
+
+  // Readbacks queued for the save state being written, one staging texture per layer and level
+  struct StateReadback
+  {
+    TextureConfig config;
+    std::vector<std::unique_ptr<AbstractStagingTexture>> levels;
+  };
+  std::map<const AbstractTexture*, StateReadback> m_state_readbacks;
+  size_t m_state_readback_size = 0;
 };
 
 extern std::unique_ptr<TextureCacheBase> g_texture_cache;
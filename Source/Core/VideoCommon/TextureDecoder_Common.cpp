@@ -5,10 +5,12 @@
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include <cstring>
 
 #include "Common/CommonTypes.h"
 #include "Common/MsgHandler.h"
 #include "Common/Swap.h"
+#include "Common/ThreadPool.h"
 
 #include "VideoCommon/LookUpTables.h"
 #include "VideoCommon/TextureDecoder.h"
@@ -370,10 +372,53 @@ static void TexDecoder_DrawOverlay(u8* dst, int width, int height, TextureFormat
   }
 }
 
+namespace
+{
+// Textures with at least this many texels are split into bands of block rows, which a few pool
+// threads decode together with the calling thread.
+constexpr int PARALLEL_DECODE_MIN_TEXELS = 256 * 256;
+constexpr int PARALLEL_DECODE_MIN_BAND_HEIGHT = 32;
+constexpr unsigned int PARALLEL_DECODE_MAX_WORKERS = 3;
+
+// Returns false if the texture has to be decoded on the calling thread alone
+bool DecodeInParallel(u32* dst, const u8* src, int width, int height, TextureFormat texformat,
+                      const u8* tlut, TLUTFormat tlutfmt)
+{
+  const unsigned int workers = static_cast<unsigned int>(
+      std::min<size_t>(Common::ThreadPool::GetWorkerCount(), PARALLEL_DECODE_MAX_WORKERS));
+  if (workers == 0 || width * height < PARALLEL_DECODE_MIN_TEXELS)
+    return false;
+
+  const int block_width = TexDecoder_GetBlockWidthInTexels(texformat);
+  const int block_height = TexDecoder_GetBlockHeightInTexels(texformat);
+  if (width % block_width != 0 || height % block_height != 0)
+    return false;
+
+  const int max_bands = static_cast<int>(workers) + 1;
+  const int bands = std::min(max_bands, height / PARALLEL_DECODE_MIN_BAND_HEIGHT);
+  if (bands < 2)
+    return false;
+
+  // Rows of blocks are contiguous in the source, so every band starts where the last one ended
+  const int block_rows = height / block_height;
+  const int band_height = (block_rows + bands - 1) / bands * block_height;
+  const int num_bands = (height - 1) / band_height + 1;
+
+  Common::ThreadPool::ParallelFor(num_bands, [&](size_t band) {
+    const int row = static_cast<int>(band) * band_height;
+    const u8* band_src = src + TexDecoder_GetTextureSizeInBytes(width, row, texformat);
+    _TexDecoder_DecodeImpl(dst + row * width, band_src, width,
+                           std::min(band_height, height - row), texformat, tlut, tlutfmt);
+  });
+  return true;
+}
+}  // Anonymous namespace
+
 void TexDecoder_Decode(u8* dst, const u8* src, int width, int height, TextureFormat texformat,
                        const u8* tlut, TLUTFormat tlutfmt)
 {
-  _TexDecoder_DecodeImpl((u32*)dst, src, width, height, texformat, tlut, tlutfmt);
+  if (!DecodeInParallel((u32*)dst, src, width, height, texformat, tlut, tlutfmt))
+    _TexDecoder_DecodeImpl((u32*)dst, src, width, height, texformat, tlut, tlutfmt);
 
   if (TexFmt_Overlay_Enable)
     TexDecoder_DrawOverlay(dst, width, height, texformat);
@@ -751,6 +796,22 @@ void TexDecoder_DecodeRGBA8FromTmem(u8* dst, const u8* src_ar, const u8* src_gb,
   }
 }
 
+void TexDecoder_InterleaveRGBA8FromTmem(u8* dst, const u8* src_ar, const u8* src_gb, int width,
+                                        int height)
+{
+  // In main memory, every 4x4 block holds its 32 bytes of AR followed by its 32 bytes of GB
+  constexpr int BANK_BLOCK_SIZE = 32;
+  const int blocks = ((width + 3) / 4) * ((height + 3) / 4);
+  for (int i = 0; i < blocks; ++i)
+  {
+    std::memcpy(dst, src_ar, BANK_BLOCK_SIZE);
+    std::memcpy(dst + BANK_BLOCK_SIZE, src_gb, BANK_BLOCK_SIZE);
+    dst += BANK_BLOCK_SIZE * 2;
+    src_ar += BANK_BLOCK_SIZE;
+    src_gb += BANK_BLOCK_SIZE;
+  }
+}
+
 void TexDecoder_DecodeXFB(u8* dst, const u8* src, u32 width, u32 height, u32 stride)
 {
   const u8* src_ptr = src;
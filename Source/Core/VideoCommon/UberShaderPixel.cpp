@@ -32,6 +32,16 @@ PixelShaderUid GetPixelShaderUid()
       (bpmem.zmode.testenable && bpmem.genMode.zfreeze);
   uid_data->uint_output = bpmem.blendmode.UseLogicOp();
 
+  // Stages only use indirect texturing when they refer to an enabled indirect stage, see
+  // PixelShaderManager.
+  uid_data->no_indirect = true;
+  for (u32 i = 0; i <= bpmem.genMode.numtevstages; i++)
+  {
+    if (bpmem.tevind[i].bt < bpmem.genMode.numindstages)
+      uid_data->no_indirect = false;
+  }
+  uid_data->alpha_test_pass = bpmem.alpha_test.TestResult() == AlphaTest::PASS;
+
   return out;
 }
 
@@ -45,6 +55,10 @@ void ClearUnusedPixelShaderUidBits(APIType ApiType, const ShaderHostConfig& host
   // uint output when logic op is not supported (i.e. driver/device does not support D3D11.1).
   if (ApiType != APIType::D3D || !host_config.backend_logic_op)
     uid_data->uint_output = 0;
+
+  // Without texgens, the shader doesn't do any indirect texturing in the first place.
+  if (uid_data->num_texgens == 0)
+    uid_data->no_indirect = 0;
 }
 
 ShaderCode GenPixelShader(APIType ApiType, const ShaderHostConfig& host_config,
@@ -59,11 +73,14 @@ ShaderCode GenPixelShader(APIType ApiType, const ShaderHostConfig& host_config,
   const bool early_depth = uid_data->early_depth != 0;
   const bool per_pixel_depth = uid_data->per_pixel_depth != 0;
   const bool bounding_box = host_config.bounding_box;
+  const bool no_indirect = uid_data->no_indirect != 0;
+  const bool alpha_test_pass = uid_data->alpha_test_pass != 0;
   const u32 numTexgen = uid_data->num_texgens;
   ShaderCode out;
 
-  out.Write("// Pixel UberShader for %u texgens%s%s\n", numTexgen,
-            early_depth ? ", early-depth" : "", per_pixel_depth ? ", per-pixel depth" : "");
+  out.Write("// Pixel UberShader for %u texgens%s%s%s%s\n", numTexgen,
+            early_depth ? ", early-depth" : "", per_pixel_depth ? ", per-pixel depth" : "",
+            no_indirect ? ", no indirect" : "", alpha_test_pass ? ", no alpha test" : "");
   WritePixelShaderCommonHeader(out, ApiType, numTexgen, host_config, bounding_box);
   WriteUberShaderCommonHeader(out, ApiType, host_config);
   if (per_pixel_lighting)
@@ -794,103 +811,114 @@ ShaderCode GenPixelShader(APIType ApiType, const ShaderHostConfig& host_config,
               "\n"
               "    bool texture_enabled = (ss.order & %du) != 0u;\n",
               1 << TwoTevStageOrders().enable0.StartBit());
+    if (no_indirect)
+    {
+      out.Write("\n"
+                "    if (texture_enabled)\n"
+                "      tevcoord.xy = fixedPoint_uv;\n");
+    }
+    else
+    {
+      out.Write("\n"
+                "    // Indirect textures\n"
+                "    uint tevind = bpmem_tevind(stage);\n"
+                "    if (tevind != 0u)\n"
+                "    {\n"
+                "      uint bs = %s;\n",
+                BitfieldExtract("tevind", TevStageIndirect().bs).c_str());
+      out.Write("      uint fmt = %s;\n",
+                BitfieldExtract("tevind", TevStageIndirect().fmt).c_str());
+      out.Write("      uint bias = %s;\n",
+                BitfieldExtract("tevind", TevStageIndirect().bias).c_str());
+      out.Write("      uint bt = %s;\n", BitfieldExtract("tevind", TevStageIndirect().bt).c_str());
+      out.Write("      uint mid = %s;\n",
+                BitfieldExtract("tevind", TevStageIndirect().mid).c_str());
+      out.Write("\n");
+      out.Write("      int3 indcoord;\n");
+      LookupIndirectTexture("indcoord", "bt");
+      out.Write("      if (bs != 0u)\n"
+                "        s.AlphaBump = indcoord[bs - 1u];\n"
+                "      switch(fmt)\n"
+                "      {\n"
+                "      case %iu:\n",
+                ITF_8);
+      out.Write("        indcoord.x = indcoord.x + ((bias & 1u) != 0u ? -128 : 0);\n"
+                "        indcoord.y = indcoord.y + ((bias & 2u) != 0u ? -128 : 0);\n"
+                "        indcoord.z = indcoord.z + ((bias & 4u) != 0u ? -128 : 0);\n"
+                "        s.AlphaBump = s.AlphaBump & 0xf8;\n"
+                "        break;\n"
+                "      case %iu:\n",
+                ITF_5);
+      out.Write("        indcoord.x = (indcoord.x & 0x1f) + ((bias & 1u) != 0u ? 1 : 0);\n"
+                "        indcoord.y = (indcoord.y & 0x1f) + ((bias & 2u) != 0u ? 1 : 0);\n"
+                "        indcoord.z = (indcoord.z & 0x1f) + ((bias & 4u) != 0u ? 1 : 0);\n"
+                "        s.AlphaBump = s.AlphaBump & 0xe0;\n"
+                "        break;\n"
+                "      case %iu:\n",
+                ITF_4);
+      out.Write("        indcoord.x = (indcoord.x & 0x0f) + ((bias & 1u) != 0u ? 1 : 0);\n"
+                "        indcoord.y = (indcoord.y & 0x0f) + ((bias & 2u) != 0u ? 1 : 0);\n"
+                "        indcoord.z = (indcoord.z & 0x0f) + ((bias & 4u) != 0u ? 1 : 0);\n"
+                "        s.AlphaBump = s.AlphaBump & 0xf0;\n"
+                "        break;\n"
+                "      case %iu:\n",
+                ITF_3);
+      out.Write("        indcoord.x = (indcoord.x & 0x07) + ((bias & 1u) != 0u ? 1 : 0);\n"
+                "        indcoord.y = (indcoord.y & 0x07) + ((bias & 2u) != 0u ? 1 : 0);\n"
+                "        indcoord.z = (indcoord.z & 0x07) + ((bias & 4u) != 0u ? 1 : 0);\n"
+                "        s.AlphaBump = s.AlphaBump & 0xf8;\n"
+                "        break;\n"
+                "      }\n"
+                "\n"
+                "      // Matrix multiply\n"
+                "      int2 indtevtrans = int2(0, 0);\n"
+                "      if ((mid & 3u) != 0u)\n"
+                "      {\n"
+                "        uint mtxidx = 2u * ((mid & 3u) - 1u);\n"
+                "        int shift = " I_INDTEXMTX "[mtxidx].w;\n"
+                "\n"
+                "        switch (mid >> 2)\n"
+                "        {\n"
+                "        case 0u: // 3x2 S0.10 matrix\n"
+                "          indtevtrans = int2(idot(" I_INDTEXMTX
+                "[mtxidx].xyz, indcoord), idot(" I_INDTEXMTX "[mtxidx + 1u].xyz, indcoord)) >> 3;\n"
+                "          break;\n"
+                "        case 1u: // S matrix, S17.7 format\n"
+                "          indtevtrans = (fixedPoint_uv * indcoord.xx) >> 8;\n"
+                "          break;\n"
+                "        case 2u: // T matrix, S17.7 format\n"
+                "          indtevtrans = (fixedPoint_uv * indcoord.yy) >> 8;\n"
+                "          break;\n"
+                "        }\n"
+                "\n"
+                "        if (shift >= 0)\n"
+                "          indtevtrans = indtevtrans >> shift;\n"
+                "        else\n"
+                "          indtevtrans = indtevtrans << ((-shift) & 31);\n"
+                "      }\n"
+                "\n"
+                "      // Wrapping\n"
+                "      uint sw = %s;\n",
+                BitfieldExtract("tevind", TevStageIndirect().sw).c_str());
+      out.Write("      uint tw = %s; \n", BitfieldExtract("tevind", TevStageIndirect().tw).c_str());
+      out.Write(
+          "      int2 wrapped_coord = int2(Wrap(fixedPoint_uv.x, sw), Wrap(fixedPoint_uv.y, tw));\n"
+          "\n"
+          "      if ((tevind & %du) != 0u) // add previous tevcoord\n",
+          1 << TevStageIndirect().fb_addprev.StartBit());
+      out.Write("        tevcoord.xy += wrapped_coord + indtevtrans;\n"
+                "      else\n"
+                "        tevcoord.xy = wrapped_coord + indtevtrans;\n"
+                "\n"
+                "      // Emulate s24 overflows\n"
+                "      tevcoord.xy = (tevcoord.xy << 8) >> 8;\n"
+                "    }\n"
+                "    else if (texture_enabled)\n"
+                "    {\n"
+                "      tevcoord.xy = fixedPoint_uv;\n"
+                "    }\n");
+    }
     out.Write("\n"
-              "    // Indirect textures\n"
-              "    uint tevind = bpmem_tevind(stage);\n"
-              "    if (tevind != 0u)\n"
-              "    {\n"
-              "      uint bs = %s;\n",
-              BitfieldExtract("tevind", TevStageIndirect().bs).c_str());
-    out.Write("      uint fmt = %s;\n", BitfieldExtract("tevind", TevStageIndirect().fmt).c_str());
-    out.Write("      uint bias = %s;\n",
-              BitfieldExtract("tevind", TevStageIndirect().bias).c_str());
-    out.Write("      uint bt = %s;\n", BitfieldExtract("tevind", TevStageIndirect().bt).c_str());
-    out.Write("      uint mid = %s;\n", BitfieldExtract("tevind", TevStageIndirect().mid).c_str());
-    out.Write("\n");
-    out.Write("      int3 indcoord;\n");
-    LookupIndirectTexture("indcoord", "bt");
-    out.Write("      if (bs != 0u)\n"
-              "        s.AlphaBump = indcoord[bs - 1u];\n"
-              "      switch(fmt)\n"
-              "      {\n"
-              "      case %iu:\n",
-              ITF_8);
-    out.Write("        indcoord.x = indcoord.x + ((bias & 1u) != 0u ? -128 : 0);\n"
-              "        indcoord.y = indcoord.y + ((bias & 2u) != 0u ? -128 : 0);\n"
-              "        indcoord.z = indcoord.z + ((bias & 4u) != 0u ? -128 : 0);\n"
-              "        s.AlphaBump = s.AlphaBump & 0xf8;\n"
-              "        break;\n"
-              "      case %iu:\n",
-              ITF_5);
-    out.Write("        indcoord.x = (indcoord.x & 0x1f) + ((bias & 1u) != 0u ? 1 : 0);\n"
-              "        indcoord.y = (indcoord.y & 0x1f) + ((bias & 2u) != 0u ? 1 : 0);\n"
-              "        indcoord.z = (indcoord.z & 0x1f) + ((bias & 4u) != 0u ? 1 : 0);\n"
-              "        s.AlphaBump = s.AlphaBump & 0xe0;\n"
-              "        break;\n"
-              "      case %iu:\n",
-              ITF_4);
-    out.Write("        indcoord.x = (indcoord.x & 0x0f) + ((bias & 1u) != 0u ? 1 : 0);\n"
-              "        indcoord.y = (indcoord.y & 0x0f) + ((bias & 2u) != 0u ? 1 : 0);\n"
-              "        indcoord.z = (indcoord.z & 0x0f) + ((bias & 4u) != 0u ? 1 : 0);\n"
-              "        s.AlphaBump = s.AlphaBump & 0xf0;\n"
-              "        break;\n"
-              "      case %iu:\n",
-              ITF_3);
-    out.Write("        indcoord.x = (indcoord.x & 0x07) + ((bias & 1u) != 0u ? 1 : 0);\n"
-              "        indcoord.y = (indcoord.y & 0x07) + ((bias & 2u) != 0u ? 1 : 0);\n"
-              "        indcoord.z = (indcoord.z & 0x07) + ((bias & 4u) != 0u ? 1 : 0);\n"
-              "        s.AlphaBump = s.AlphaBump & 0xf8;\n"
-              "        break;\n"
-              "      }\n"
-              "\n"
-              "      // Matrix multiply\n"
-              "      int2 indtevtrans = int2(0, 0);\n"
-              "      if ((mid & 3u) != 0u)\n"
-              "      {\n"
-              "        uint mtxidx = 2u * ((mid & 3u) - 1u);\n"
-              "        int shift = " I_INDTEXMTX "[mtxidx].w;\n"
-              "\n"
-              "        switch (mid >> 2)\n"
-              "        {\n"
-              "        case 0u: // 3x2 S0.10 matrix\n"
-              "          indtevtrans = int2(idot(" I_INDTEXMTX
-              "[mtxidx].xyz, indcoord), idot(" I_INDTEXMTX "[mtxidx + 1u].xyz, indcoord)) >> 3;\n"
-              "          break;\n"
-              "        case 1u: // S matrix, S17.7 format\n"
-              "          indtevtrans = (fixedPoint_uv * indcoord.xx) >> 8;\n"
-              "          break;\n"
-              "        case 2u: // T matrix, S17.7 format\n"
-              "          indtevtrans = (fixedPoint_uv * indcoord.yy) >> 8;\n"
-              "          break;\n"
-              "        }\n"
-              "\n"
-              "        if (shift >= 0)\n"
-              "          indtevtrans = indtevtrans >> shift;\n"
-              "        else\n"
-              "          indtevtrans = indtevtrans << ((-shift) & 31);\n"
-              "      }\n"
-              "\n"
-              "      // Wrapping\n"
-              "      uint sw = %s;\n",
-              BitfieldExtract("tevind", TevStageIndirect().sw).c_str());
-    out.Write("      uint tw = %s; \n", BitfieldExtract("tevind", TevStageIndirect().tw).c_str());
-    out.Write(
-        "      int2 wrapped_coord = int2(Wrap(fixedPoint_uv.x, sw), Wrap(fixedPoint_uv.y, tw));\n"
-        "\n"
-        "      if ((tevind & %du) != 0u) // add previous tevcoord\n",
-        1 << TevStageIndirect().fb_addprev.StartBit());
-    out.Write("        tevcoord.xy += wrapped_coord + indtevtrans;\n"
-              "      else\n"
-              "        tevcoord.xy = wrapped_coord + indtevtrans;\n"
-              "\n"
-              "      // Emulate s24 overflows\n"
-              "      tevcoord.xy = (tevcoord.xy << 8) >> 8;\n"
-              "    }\n"
-              "    else if (texture_enabled)\n"
-              "    {\n"
-              "      tevcoord.xy = fixedPoint_uv;\n"
-              "    }\n"
-              "\n"
               "    // Sample texture for stage\n"
               "    if(texture_enabled) {\n"
               "      uint sampler_num = %s;\n",
@@ -1124,28 +1152,33 @@ ShaderCode GenPixelShader(APIType ApiType, const ShaderHostConfig& host_config,
       out.Write("  depth = float(zbuffer_zCoord) / 16777216.0;\n");
   }
 
-  out.Write("  // Alpha Test\n"
-            "  if (bpmem_alphaTest != 0u) {\n"
-            "    bool comp0 = alphaCompare(TevResult.a, " I_ALPHA ".r, %s);\n",
-            BitfieldExtract("bpmem_alphaTest", AlphaTest().comp0).c_str());
-  out.Write("    bool comp1 = alphaCompare(TevResult.a, " I_ALPHA ".g, %s);\n",
-            BitfieldExtract("bpmem_alphaTest", AlphaTest().comp1).c_str());
-  out.Write("\n"
-            "    // These if statements are written weirdly to work around intel and qualcom bugs "
-            "with handling booleans.\n"
-            "    switch (%s) {\n",
-            BitfieldExtract("bpmem_alphaTest", AlphaTest().logic).c_str());
-  out.Write("    case 0u: // AND\n"
-            "      if (comp0 && comp1) break; else discard; break;\n"
-            "    case 1u: // OR\n"
-            "      if (comp0 || comp1) break; else discard; break;\n"
-            "    case 2u: // XOR\n"
-            "      if (comp0 != comp1) break; else discard; break;\n"
-            "    case 3u: // XNOR\n"
-            "      if (comp0 == comp1) break; else discard; break;\n"
-            "    }\n"
-            "  }\n"
-            "\n");
+  // Draws whose alpha test always passes don't need it, and without the discard the GPU can
+  // skip shading hidden pixels.
+  if (!alpha_test_pass)
+  {
+    out.Write("  // Alpha Test\n"
+              "  if (bpmem_alphaTest != 0u) {\n"
+              "    bool comp0 = alphaCompare(TevResult.a, " I_ALPHA ".r, %s);\n",
+              BitfieldExtract("bpmem_alphaTest", AlphaTest().comp0).c_str());
+    out.Write("    bool comp1 = alphaCompare(TevResult.a, " I_ALPHA ".g, %s);\n",
+              BitfieldExtract("bpmem_alphaTest", AlphaTest().comp1).c_str());
+    out.Write("\n"
+              "    // These if statements are written weirdly to work around intel and qualcom "
+              "bugs with handling booleans.\n"
+              "    switch (%s) {\n",
+              BitfieldExtract("bpmem_alphaTest", AlphaTest().logic).c_str());
+    out.Write("    case 0u: // AND\n"
+              "      if (comp0 && comp1) break; else discard; break;\n"
+              "    case 1u: // OR\n"
+              "      if (comp0 || comp1) break; else discard; break;\n"
+              "    case 2u: // XOR\n"
+              "      if (comp0 != comp1) break; else discard; break;\n"
+              "    case 3u: // XNOR\n"
+              "      if (comp0 == comp1) break; else discard; break;\n"
+              "    }\n"
+              "  }\n"
+              "\n");
+  }
 
   // =========
   // Dithering
@@ -1415,7 +1448,15 @@ void EnumeratePixelShaderUids(const std::function<void(const PixelShaderUid&)>&
         for (u32 uint_output = 0; uint_output < 2; uint_output++)
         {
           puid->uint_output = uint_output;
-          callback(uid);
+          for (u32 no_indirect = 0; no_indirect < (texgens != 0 ? 2u : 1u); no_indirect++)
+          {
+            puid->no_indirect = no_indirect;
+            for (u32 alpha_test_pass = 0; alpha_test_pass < 2; alpha_test_pass++)
+            {
+              puid->alpha_test_pass = alpha_test_pass;
+              callback(uid);
+            }
+          }
         }
       }
     }
@@ -19,6 +19,10 @@ struct pixel_ubershader_uid_data
   u32 early_depth : 1;
   u32 per_pixel_depth : 1;
   u32 uint_output : 1;
+  // Coarse specializations which hold for most draws and let whole sections of the shader go.
+  // Zero selects the generic code, so these stay compatible with existing shader caches.
+  u32 no_indirect : 1;
+  u32 alpha_test_pass : 1;
 
   u32 NumValues() const { return sizeof(pixel_ubershader_uid_data); }
 };
@@ -30,6 +30,12 @@ VertexLoaderBase::VertexLoaderBase(const TVtxDesc& vtx_desc, const VAT& vtx_attr
     : m_VtxDesc{vtx_desc}, m_vat{vtx_attr}
 {
   SetVAT(vtx_attr);
+
+  for (int i = 0; i < 12; ++i)
+  {
+    if (m_VtxDesc.GetVertexArrayStatus(i) & MASK_INDEXED)
+      m_direct_only = false;
+  }
 }
 
 void VertexLoaderBase::SetVAT(const VAT& vat)
@@ -140,7 +146,7 @@ std::string VertexLoaderBase::ToString() const
     dest += fmt::format("T{}: {} {}-{} ", i, tex_coord.Elements, pos_mode[tex_mode[i]],
                         pos_formats[tex_coord.Format]);
   }
-  dest += fmt::format(" - {} v", m_numLoadedVertices);
+  dest += fmt::format(" - {} v", m_numLoadedVertices.load());
   return dest;
 }
 
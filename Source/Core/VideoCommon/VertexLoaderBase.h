@@ -5,6 +5,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <memory>
 #include <string>
 
@@ -67,6 +68,15 @@ public:
 
   virtual bool IsInitialized() = 0;
 
+  // Whether RunVertices may be called from several threads at once, on different parts of a batch.
+  // Apart from the buffers passed in, such loaders may only write the zfreeze caches in
+  // VertexLoaderManager.
+  virtual bool CanRunInParallel() const { return false; }
+
+  // True if no attribute is indexed, so the output only depends on the vertex data itself
+  bool IsDirectOnly() const { return m_direct_only; }
+  bool HasPosMatIdx() const { return m_VtxDesc.PosMatIdx; }
+
   // For debugging / profiling
   std::string ToString() const;
 
@@ -79,7 +89,7 @@ public:
 
   // used by VertexLoaderManager
   NativeVertexFormat* m_native_vertex_format = nullptr;
-  int m_numLoadedVertices = 0;
+  std::atomic<int> m_numLoadedVertices{0};
 
 protected:
   VertexLoaderBase(const TVtxDesc& vtx_desc, const VAT& vtx_attr);
@@ -89,4 +99,7 @@ protected:
   TVtxAttr m_VtxAttr;  // VAT decoded into easy format
   TVtxDesc m_VtxDesc;  // Not really used currently - or well it is, but could be easily avoided.
   VAT m_vat;
+
+private:
+  bool m_direct_only = true;
 };
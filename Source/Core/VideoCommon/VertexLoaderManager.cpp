@@ -5,19 +5,27 @@
 #include "VideoCommon/VertexLoaderManager.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
 #include <iterator>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include <xxhash.h>
+
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
 #include "Core/HW/Memmap.h"
 
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/BoundingBox.h"
 #include "VideoCommon/CommandProcessor.h"
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/IndexGenerator.h"
@@ -27,6 +35,7 @@
 #include "VideoCommon/VertexLoaderBase.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VertexShaderManager.h"
+#include "VideoCommon/VideoConfig.h"
 
 namespace VertexLoaderManager
 {
@@ -57,8 +66,280 @@ void Init()
   SETSTAT(g_stats.num_vertex_loaders, 0);
 }
 
+namespace
+{
+// Batches at least this big are split into chunks and loaded by a few worker threads together
+// with the calling thread.
+constexpr int PARALLEL_LOAD_MIN_VERTICES = 8192;
+constexpr int PARALLEL_LOAD_CHUNK_VERTICES = 2048;
+constexpr int PARALLEL_LOAD_MAX_CHUNKS = 32;
+constexpr unsigned int PARALLEL_LOAD_MAX_WORKERS = 3;
+
+class ParallelVertexLoader
+{
+public:
+  ~ParallelVertexLoader() { Stop(); }
+
+  bool IsAvailable()
+  {
+    if (m_workers.empty() && !m_started)
+      Start();
+    return !m_workers.empty();
+  }
+
+  void Stop()
+  {
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      m_shutdown = true;
+    }
+    m_work_cv.notify_all();
+    for (std::thread& worker : m_workers)
+      worker.join();
+    m_workers.clear();
+    m_shutdown = false;
+    m_started = false;
+  }
+
+  // Loads the batch like loader->RunVertices would. The last chunk is always loaded on this thread
+  // after all the others, so the zfreeze caches end up holding the last vertices of the batch.
+  int Run(VertexLoaderBase* loader, DataReader src, DataReader dst, int count)
+  {
+    const int chunks = std::min(count / PARALLEL_LOAD_CHUNK_VERTICES, PARALLEL_LOAD_MAX_CHUNKS);
+    const u32 stride = loader->m_native_vtx_decl.stride;
+
+    u32 generation;
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      generation = ++m_generation;
+      m_loader = loader;
+      m_src = src.GetPointer();
+      m_src_end = m_src + src.size();
+      m_dst = dst.GetPointer();
+      m_dst_end = m_dst + dst.size();
+      m_count = count;
+      m_chunks = chunks;
+      m_boundaries.resize(static_cast<size_t>(chunks) * stride);
+      m_completed.store(0, std::memory_order_relaxed);
+      m_next_chunk.store(static_cast<u64>(generation) << 32, std::memory_order_release);
+    }
+    m_work_cv.notify_all();
+
+    u32 chunk;
+    while (ClaimChunk(generation, &chunk))
+      LoadChunk(chunk);
+    while (m_completed.load(std::memory_order_acquire) != chunks - 1)
+      std::this_thread::yield();
+    m_loaded[chunks - 1] = LoadVertices(chunks - 1, nullptr);
+
+    // Put the chunks back together. A loader may write a few bytes past the end of a vertex, which
+    // can clobber the first vertex of the next chunk if that was loaded first, so the saved copies
+    // of those are restored. Skipped vertices leave gaps that have to be closed as well.
+    u8* out = m_dst;
+    for (int i = 0; i < chunks; ++i)
+    {
+      u8* chunk_dst = m_dst + static_cast<size_t>(GetChunkStart(i)) * stride;
+      if (i != 0 && i != chunks - 1 && m_loaded[i] != 0)
+        std::memcpy(chunk_dst, &m_boundaries[static_cast<size_t>(i) * stride], stride);
+      if (out != chunk_dst)
+        std::memmove(out, chunk_dst, static_cast<size_t>(m_loaded[i]) * stride);
+      out += static_cast<size_t>(m_loaded[i]) * stride;
+    }
+    return static_cast<int>((out - m_dst) / stride);
+  }
+
+private:
+  void Start()
+  {
+    m_started = true;
+
+    // The CPU and GPU threads are already busy
+    const unsigned int threads = std::thread::hardware_concurrency();
+    const unsigned int workers = std::min(threads > 2 ? threads - 2 : 0, PARALLEL_LOAD_MAX_WORKERS);
+    for (unsigned int i = 0; i < workers; ++i)
+      m_workers.emplace_back(&ParallelVertexLoader::WorkerLoop, this);
+  }
+
+  void WorkerLoop()
+  {
+    u32 seen_generation = 0;
+    std::unique_lock<std::mutex> lk(m_mutex);
+    while (true)
+    {
+      m_work_cv.wait(lk, [&] { return m_shutdown || m_generation != seen_generation; });
+      if (m_shutdown)
+        return;
+      seen_generation = m_generation;
+      lk.unlock();
+
+      u32 chunk;
+      while (ClaimChunk(seen_generation, &chunk))
+        LoadChunk(chunk);
+
+      lk.lock();
+    }
+  }
+
+  // All chunks but the last one are up for grabs. The generation in the upper half keeps threads
+  // that wake up late from taking chunks of a newer batch with the state of an older one.
+  bool ClaimChunk(u32 generation, u32* chunk)
+  {
+    u64 state = m_next_chunk.load(std::memory_order_acquire);
+    do
+    {
+      if (static_cast<u32>(state >> 32) != generation ||
+          static_cast<int>(static_cast<u32>(state)) >= m_chunks.load() - 1)
+      {
+        return false;
+      }
+    } while (!m_next_chunk.compare_exchange_weak(state, state + 1, std::memory_order_acq_rel));
+
+    *chunk = static_cast<u32>(state);
+    return true;
+  }
+
+  void LoadChunk(u32 chunk)
+  {
+    const u32 stride = m_loader->m_native_vtx_decl.stride;
+    m_loaded[chunk] = LoadVertices(chunk, &m_boundaries[static_cast<size_t>(chunk) * stride]);
+    m_completed.fetch_add(1, std::memory_order_release);
+  }
+
+  // Saves a copy of the first loaded vertex to boundary, if given.
+  int LoadVertices(int chunk, u8* boundary)
+  {
+    const int start = GetChunkStart(chunk);
+    const int size = GetChunkStart(chunk + 1) - start;
+    const u32 stride = m_loader->m_native_vtx_decl.stride;
+    const u32 vertex_size = m_loader->m_VertexSize;
+    u8* const src = m_src + static_cast<size_t>(start) * vertex_size;
+    u8* const dst = m_dst + static_cast<size_t>(start) * stride;
+    const auto run = [&](int first, int loaded, int num) {
+      return m_loader->RunVertices(
+          DataReader(src + static_cast<size_t>(first) * vertex_size, m_src_end),
+          DataReader(dst + static_cast<size_t>(loaded) * stride, m_dst_end), num);
+    };
+
+    if (!boundary)
+      return run(0, 0, size);
+
+    // Load the first vertex on its own, so anything it writes past its end is overwritten by the
+    // rest of the chunk and the saved copy is exact.
+    int first = 0;
+    int loaded = 0;
+    while (first < size && loaded == 0)
+      loaded = run(first++, 0, 1);
+    if (loaded != 0)
+      std::memcpy(boundary, dst, stride);
+    if (first < size)
+      loaded += run(first, loaded, size - first);
+    return loaded;
+  }
+
+  int GetChunkStart(int chunk) const
+  {
+    return static_cast<int>(static_cast<s64>(m_count) * chunk / m_chunks.load());
+  }
+
+  std::vector<std::thread> m_workers;
+  bool m_started = false;
+
+  std::mutex m_mutex;
+  std::condition_variable m_work_cv;
+  bool m_shutdown = false;
+  u32 m_generation = 0;
+
+  // The current batch. Only written while no chunks can be claimed.
+  VertexLoaderBase* m_loader = nullptr;
+  u8* m_src = nullptr;
+  u8* m_src_end = nullptr;
+  u8* m_dst = nullptr;
+  u8* m_dst_end = nullptr;
+  int m_count = 0;
+  std::atomic<int> m_chunks{0};
+  std::vector<u8> m_boundaries;
+  std::array<int, PARALLEL_LOAD_MAX_CHUNKS> m_loaded{};
+
+  std::atomic<u64> m_next_chunk{0};
+  std::atomic<int> m_completed{0};
+};
+
+ParallelVertexLoader s_parallel_loader;
+
+// The output of a loader without indexed attributes only depends on the vertex data in the FIFO,
+// so display lists that are submitted again every frame don't need to be converted again.
+constexpr int CACHE_MIN_VERTICES = 32;
+constexpr size_t CACHE_MAX_BYTES = 32 * 1024 * 1024;
+
+struct CachedBatch
+{
+  VertexLoaderBase* loader;
+  int source_count;
+  int count;
+  std::vector<u8> vertices;
+  // What the loader left in the zfreeze caches
+  float position_cache[3][4];
+  u32 position_matrix_index[4];
+};
+
+std::unordered_map<u64, CachedBatch> s_batch_cache;
+size_t s_batch_cache_bytes = 0;
+
+u64 GetBatchHash(const VertexLoaderBase* loader, const DataReader& src, int size, u64 source_key)
+{
+  if (source_key != 0)
+    return XXH64(&source_key, sizeof(source_key), reinterpret_cast<uintptr_t>(loader));
+  return XXH64(src.GetPointer(), size, reinterpret_cast<uintptr_t>(loader));
+}
+
+bool LoadBatchFromCache(VertexLoaderBase* loader, u64 hash, int source_count, DataReader dst,
+                        int* count)
+{
+  const auto it = s_batch_cache.find(hash);
+  if (it == s_batch_cache.end() || it->second.loader != loader ||
+      it->second.source_count != source_count)
+  {
+    return false;
+  }
+
+  const CachedBatch& batch = it->second;
+  std::memcpy(dst.GetPointer(), batch.vertices.data(), batch.vertices.size());
+  std::memcpy(position_cache, batch.position_cache, sizeof(position_cache));
+  if (loader->HasPosMatIdx())
+    std::memcpy(position_matrix_index, batch.position_matrix_index, sizeof(position_matrix_index));
+  loader->m_numLoadedVertices += source_count;
+  *count = batch.count;
+  return true;
+}
+
+void StoreBatchInCache(VertexLoaderBase* loader, u64 hash, int source_count, DataReader dst,
+                       int count)
+{
+  const size_t size = static_cast<size_t>(count) * loader->m_native_vtx_decl.stride;
+  if (s_batch_cache_bytes + size > CACHE_MAX_BYTES)
+  {
+    // Whatever is still being used will be back soon enough
+    s_batch_cache.clear();
+    s_batch_cache_bytes = 0;
+  }
+
+  CachedBatch& batch = s_batch_cache[hash];
+  s_batch_cache_bytes += size - batch.vertices.size();
+  batch.loader = loader;
+  batch.source_count = source_count;
+  batch.count = count;
+  batch.vertices.assign(dst.GetPointer(), dst.GetPointer() + size);
+  std::memcpy(batch.position_cache, position_cache, sizeof(position_cache));
+  std::memcpy(batch.position_matrix_index, position_matrix_index, sizeof(position_matrix_index));
+}
+}  // Anonymous namespace
+
 void Clear()
 {
+  s_parallel_loader.Stop();
+  s_batch_cache.clear();
+  s_batch_cache_bytes = 0;
+
   std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
   s_vertex_loader_map.clear();
   s_native_vertex_map.clear();
@@ -249,7 +530,8 @@ static VertexLoaderBase* RefreshLoader(int vtx_attr_group, bool preprocess = fal
   return loader;
 }
 
-int RunVertices(int vtx_attr_group, int primitive, int count, DataReader src, bool is_preprocess)
+int RunVertices(int vtx_attr_group, int primitive, int count, DataReader src, bool is_preprocess,
+                u64 source_key)
 {
   if (!count)
     return 0;
@@ -278,10 +560,34 @@ int RunVertices(int vtx_attr_group, int primitive, int count, DataReader src, bo
   // slope.
   bool cullall = (bpmem.genMode.cullmode == GenMode::CULL_ALL && primitive < 5);
 
+  // Skipped frames still load vertices for the same reason, but draw nothing at all. Bounding box
+  // results are read back by the game, so those draws have to happen.
+  if (g_renderer->IsSkippingFrameDraws() && !BoundingBox::IsEnabled())
+    cullall = true;
+
   DataReader dst = g_vertex_manager->PrepareForAdditionalData(
       primitive, count, loader->m_native_vtx_decl.stride, cullall);
 
-  count = loader->RunVertices(src, dst, count);
+  // Hashing small batches on their own costs more than converting them, but a source key is free
+  const bool use_cache = g_ActiveConfig.bCacheVertexLoads && loader->IsDirectOnly() &&
+                         (count >= CACHE_MIN_VERTICES || source_key != 0);
+  const u64 hash = use_cache ? GetBatchHash(loader, src, size, source_key) : 0;
+  if (!use_cache || !LoadBatchFromCache(loader, hash, count, dst, &count))
+  {
+    const int source_count = count;
+    if (count >= PARALLEL_LOAD_MIN_VERTICES && loader->CanRunInParallel() &&
+        s_parallel_loader.IsAvailable())
+    {
+      count = s_parallel_loader.Run(loader, src, dst, count);
+    }
+    else
+    {
+      count = loader->RunVertices(src, dst, count);
+    }
+
+    if (use_cache)
+      StoreBatchInCache(loader, hash, source_count, dst, count);
+  }
 
   g_vertex_manager->AddIndices(primitive, count);
   g_vertex_manager->FlushData(count, loader->m_native_vtx_decl.stride);
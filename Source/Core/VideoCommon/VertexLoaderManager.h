@@ -34,8 +34,11 @@ NativeVertexFormat* GetOrCreateMatchingFormat(const PortableVertexDeclaration& d
 // offsets set to the unused attributes.
 NativeVertexFormat* GetUberVertexFormat(const PortableVertexDeclaration& decl);
 
-// Returns -1 if buf_size is insufficient, else the amount of bytes consumed
-int RunVertices(int vtx_attr_group, int primitive, int count, DataReader src, bool is_preprocess);
+// Returns -1 if buf_size is insufficient, else the amount of bytes consumed. A nonzero
+// source_key identifies the vertex data without looking at it (e.g. a known display list and an
+// offset into it), which lets even small batches use the vertex load cache.
+int RunVertices(int vtx_attr_group, int primitive, int count, DataReader src, bool is_preprocess,
+                u64 source_key = 0);
 
 // For debugging
 std::string VertexLoadersToString();
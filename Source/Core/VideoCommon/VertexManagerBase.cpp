@@ -13,6 +13,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/MathUtil.h"
+#include "Common/Trace.h"
 
 #include "Core/Analytics.h"
 #include "Core/ConfigManager.h"
@@ -353,6 +354,7 @@ void VertexManagerBase::Flush()
   if (m_is_flushed)
     return;
 
+  TRACE_SCOPE("VertexManagerBase::Flush");
   m_is_flushed = true;
 
   if (xfmem.numTexGen.numTexGens != bpmem.genMode.numtexgens ||
@@ -481,6 +483,12 @@ void VertexManagerBase::Flush()
     // Update the pipeline, or compile one if needed.
     UpdatePipelineConfig();
     UpdatePipelineObject();
+    if (m_current_pipeline_pending)
+    {
+      // The viewport is a cheap stand-in for the area the draw covers.
+      const u64 pixels = static_cast<u64>(std::abs(xfmem.viewport.wd * xfmem.viewport.ht) * 4.0f);
+      g_shader_cache->CountPendingPipelineUse(m_current_pipeline_config, pixels);
+    }
     if (m_current_pipeline_object)
     {
       g_renderer->SetPipeline(m_current_pipeline_object);
@@ -672,6 +680,7 @@ void VertexManagerBase::UpdatePipelineObject()
 
   m_current_pipeline_object = nullptr;
   m_pipeline_config_changed = false;
+  m_current_pipeline_pending = false;
 
   switch (g_ActiveConfig.iShaderCompilationMode)
   {
@@ -702,6 +711,8 @@ void VertexManagerBase::UpdatePipelineObject()
       return;
     }
 
+    m_current_pipeline_pending = true;
+
     if (g_ActiveConfig.iShaderCompilationMode == ShaderCompilationMode::AsynchronousUberShaders)
     {
       // Specialized shaders not ready, use the ubershaders.
@@ -144,7 +144,7 @@ public:
   void OnEFBCopyToRAM();
 
   // Call at the end of a frame.
-  void OnEndFrame();
+  virtual void OnEndFrame();
 
 protected:
   // When utility uniforms are used, the GX uniforms need to be re-written afterwards.
@@ -184,6 +184,8 @@ protected:
   const AbstractPipeline* m_current_pipeline_object = nullptr;
   PrimitiveType m_current_primitive_type = PrimitiveType::Points;
   bool m_pipeline_config_changed = true;
+  // The specialized pipeline for the current config is still being compiled in the background.
+  bool m_current_pipeline_pending = false;
   bool m_rasterization_state_changed = true;
   bool m_depth_state_changed = true;
   bool m_blending_state_changed = true;
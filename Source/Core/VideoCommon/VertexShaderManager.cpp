@@ -49,6 +49,18 @@ static Common::Matrix44 s_viewportCorrection;
 VertexShaderConstants VertexShaderManager::constants;
 bool VertexShaderManager::dirty;
 
+// Copies the registers and flags the constants as dirty, unless they already hold these values.
+// While nothing is dirty the constants match what the backend streamed last, so games that reload
+// the same matrices for every draw (which skinned models do a lot) don't cost another upload.
+static void UpdateRegisters(void* dst, const void* src, size_t size)
+{
+  if (std::memcmp(dst, src, size) == 0)
+    return;
+
+  std::memcpy(dst, src, size);
+  VertexShaderManager::dirty = true;
+}
+
 // Viewport correction:
 // In D3D, the viewport rectangle must fit within the render target.
 // Say you want a viewport at (ix, iy) with size (iw, ih),
@@ -141,9 +153,8 @@ void VertexShaderManager::SetConstants()
   {
     int startn = nTransformMatricesChanged[0] / 4;
     int endn = (nTransformMatricesChanged[1] + 3) / 4;
-    memcpy(constants.transformmatrices[startn].data(), &xfmem.posMatrices[startn * 4],
-           (endn - startn) * sizeof(float4));
-    dirty = true;
+    UpdateRegisters(constants.transformmatrices[startn].data(), &xfmem.posMatrices[startn * 4],
+                    (endn - startn) * sizeof(float4));
     nTransformMatricesChanged[0] = nTransformMatricesChanged[1] = -1;
   }
 
@@ -153,9 +164,8 @@ void VertexShaderManager::SetConstants()
     int endn = (nNormalMatricesChanged[1] + 2) / 3;
     for (int i = startn; i < endn; i++)
     {
-      memcpy(constants.normalmatrices[i].data(), &xfmem.normalMatrices[3 * i], 12);
+      UpdateRegisters(constants.normalmatrices[i].data(), &xfmem.normalMatrices[3 * i], 12);
     }
-    dirty = true;
     nNormalMatricesChanged[0] = nNormalMatricesChanged[1] = -1;
   }
 
@@ -163,9 +173,8 @@ void VertexShaderManager::SetConstants()
   {
     int startn = nPostTransformMatricesChanged[0] / 4;
     int endn = (nPostTransformMatricesChanged[1] + 3) / 4;
-    memcpy(constants.posttransformmatrices[startn].data(), &xfmem.postMatrices[startn * 4],
-           (endn - startn) * sizeof(float4));
-    dirty = true;
+    UpdateRegisters(constants.posttransformmatrices[startn].data(),
+                    &xfmem.postMatrices[startn * 4], (endn - startn) * sizeof(float4));
     nPostTransformMatricesChanged[0] = nPostTransformMatricesChanged[1] = -1;
   }
 
@@ -179,7 +188,7 @@ void VertexShaderManager::SetConstants()
     for (int i = istart; i < iend; ++i)
     {
       const Light& light = xfmem.lights[i];
-      VertexShaderConstants::Light& dstlight = constants.lights[i];
+      VertexShaderConstants::Light dstlight = constants.lights[i];
 
       // xfmem.light.color is packed as abgr in u8[4], so we have to swap the order
       dstlight.color[0] = light.color[3];
@@ -216,8 +225,9 @@ void VertexShaderManager::SetConstants()
       dstlight.dir[0] = light.ddir[0] * norm_float;
       dstlight.dir[1] = light.ddir[1] * norm_float;
       dstlight.dir[2] = light.ddir[2] * norm_float;
+
+      UpdateRegisters(&constants.lights[i], &dstlight, sizeof(dstlight));
     }
-    dirty = true;
 
     nLightsChanged[0] = nLightsChanged[1] = -1;
   }
@@ -225,11 +235,10 @@ void VertexShaderManager::SetConstants()
   for (int i : nMaterialsChanged)
   {
     u32 data = i >= 2 ? xfmem.matColor[i - 2] : xfmem.ambColor[i];
-    constants.materials[i][0] = (data >> 24) & 0xFF;
-    constants.materials[i][1] = (data >> 16) & 0xFF;
-    constants.materials[i][2] = (data >> 8) & 0xFF;
-    constants.materials[i][3] = data & 0xFF;
-    dirty = true;
+    const int4 material = {static_cast<int>((data >> 24) & 0xFF),
+                           static_cast<int>((data >> 16) & 0xFF),
+                           static_cast<int>((data >> 8) & 0xFF), static_cast<int>(data & 0xFF)};
+    UpdateRegisters(constants.materials[i].data(), material.data(), sizeof(material));
   }
   nMaterialsChanged = BitSet32(0);
 
@@ -241,11 +250,13 @@ void VertexShaderManager::SetConstants()
     const float* norm =
         &xfmem.normalMatrices[3 * (g_main_cp_state.matrix_index_a.PosNormalMtxIdx & 31)];
 
-    memcpy(constants.posnormalmatrix.data(), pos, 3 * sizeof(float4));
-    memcpy(constants.posnormalmatrix[3].data(), norm, 3 * sizeof(float));
-    memcpy(constants.posnormalmatrix[4].data(), norm + 3, 3 * sizeof(float));
-    memcpy(constants.posnormalmatrix[5].data(), norm + 6, 3 * sizeof(float));
-    dirty = true;
+    auto posnormalmatrix = constants.posnormalmatrix;
+    memcpy(posnormalmatrix.data(), pos, 3 * sizeof(float4));
+    memcpy(posnormalmatrix[3].data(), norm, 3 * sizeof(float));
+    memcpy(posnormalmatrix[4].data(), norm + 3, 3 * sizeof(float));
+    memcpy(posnormalmatrix[5].data(), norm + 6, 3 * sizeof(float));
+    UpdateRegisters(constants.posnormalmatrix.data(), posnormalmatrix.data(),
+                    sizeof(posnormalmatrix));
   }
 
   if (bTexMatricesChanged[0])
@@ -260,9 +271,9 @@ void VertexShaderManager::SetConstants()
 
     for (size_t i = 0; i < pos_matrix_ptrs.size(); ++i)
     {
-      memcpy(constants.texmatrices[3 * i].data(), pos_matrix_ptrs[i], 3 * sizeof(float4));
+      UpdateRegisters(constants.texmatrices[3 * i].data(), pos_matrix_ptrs[i],
+                      3 * sizeof(float4));
     }
-    dirty = true;
   }
 
   if (bTexMatricesChanged[1])
@@ -277,9 +288,9 @@ void VertexShaderManager::SetConstants()
 
     for (size_t i = 0; i < pos_matrix_ptrs.size(); ++i)
     {
-      memcpy(constants.texmatrices[3 * i + 12].data(), pos_matrix_ptrs[i], 3 * sizeof(float4));
+      UpdateRegisters(constants.texmatrices[3 * i + 12].data(), pos_matrix_ptrs[i],
+                      3 * sizeof(float4));
     }
-    dirty = true;
   }
 
   if (bViewportChanged)
@@ -423,11 +434,10 @@ void VertexShaderManager::SetConstants()
     if (g_ActiveConfig.bFreeLook && xfmem.projection.type == GX_PERSPECTIVE)
       corrected_matrix *= g_freelook_camera.GetView();
 
-    memcpy(constants.projection.data(), corrected_matrix.data.data(), 4 * sizeof(float4));
+    UpdateRegisters(constants.projection.data(), corrected_matrix.data.data(),
+                    4 * sizeof(float4));
 
     g_freelook_camera.SetClean();
-
-    dirty = true;
   }
 
   if (bTexMtxInfoChanged)
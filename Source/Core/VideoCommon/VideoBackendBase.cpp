@@ -5,6 +5,7 @@
 #include "VideoCommon/VideoBackendBase.h"
 
 #include <algorithm>
+#include <array>
 #include <cstring>
 #include <memory>
 #include <string>
@@ -16,11 +17,13 @@
 #include "Common/CommonTypes.h"
 #include "Common/Config/Config.h"
 #include "Common/Event.h"
+#include "Common/Flag.h"
 #include "Common/Logging/Log.h"
 
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
+#include "Core/FramePacer.h"
 
 // OpenGL is not available on Windows-on-ARM64
 #if !defined(_WIN32) || !defined(_M_ARM64)
@@ -45,11 +48,13 @@
 #include "VideoCommon/CommandProcessor.h"
 #include "VideoCommon/Fifo.h"
 #include "VideoCommon/GeometryShaderManager.h"
+#include "VideoCommon/HiresTextures.h"
 #include "VideoCommon/IndexGenerator.h"
 #include "VideoCommon/OpcodeDecoding.h"
 #include "VideoCommon/PixelEngine.h"
 #include "VideoCommon/PixelShaderManager.h"
 #include "VideoCommon/RenderBase.h"
+#include "VideoCommon/ShaderCache.h"
 #include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexManagerBase.h"
@@ -100,7 +105,9 @@ void VideoBackendBase::Video_BeginField(u32 xfb_addr, u32 fb_width, u32 fb_strid
     e.swap_event.fbWidth = fb_width;
     e.swap_event.fbStride = fb_stride;
     e.swap_event.fbHeight = fb_height;
-    AsyncRequests::GetInstance()->PushEvent(e, false);
+    // With low latency pacing, wait for the swap to be presented so the next field can be timed
+    // from it.
+    AsyncRequests::GetInstance()->PushEvent(e, FramePacer::IsEnabled());
   }
 }
 
@@ -138,6 +145,53 @@ u32 VideoBackendBase::Video_AccessEFB(EFBAccessType type, u32 x, u32 y, u32 data
   }
 }
 
+// For deferred perf query reads, handed over the same way as the bounding box readbacks below
+static std::array<u32, PQ_NUM_MEMBERS> s_perf_query_readback;
+static Common::Flag s_perf_query_readback_pending;
+static std::array<u32, PQ_NUM_MEMBERS> s_perf_query_values;
+static bool s_perf_query_values_valid = false;
+// How often each counter was read since s_perf_query_values was last updated
+static std::array<u32, PQ_NUM_MEMBERS> s_perf_query_values_read;
+
+static void RequestPerfQueryReadback(bool blocking)
+{
+  AsyncRequests::Event e;
+  e.time = 0;
+  e.type = AsyncRequests::Event::PERF_QUERY_READBACK;
+  e.perf_query_readback.data = s_perf_query_readback.data();
+  e.perf_query_readback.pending = &s_perf_query_readback_pending;
+  s_perf_query_readback_pending.Set();
+  AsyncRequests::GetInstance()->PushEvent(e, blocking);
+}
+
+static u32 GetDeferredQueryResult(PerfQueryType type)
+{
+  if (!s_perf_query_values_valid)
+  {
+    // Nothing to go on yet, so the first read waits for the GPU like it normally would
+    Fifo::SyncGPU(Fifo::SyncGPUReason::PerfQuery);
+    RequestPerfQueryReadback(true);
+    if (s_perf_query_readback_pending.IsSet())
+      return 0;
+
+    s_perf_query_values_valid = true;
+    s_perf_query_values_read.fill(2);
+  }
+
+  // Each counter is read as two halves. Reading one a third time means the game has started on a
+  // new set, so answer it from the newest finished readback and start the next one without waiting
+  // for it. Both halves of a counter always come from the same readback that way.
+  if (s_perf_query_values_read[type] >= 2 && !s_perf_query_readback_pending.IsSet())
+  {
+    s_perf_query_values = s_perf_query_readback;
+    s_perf_query_values_read.fill(0);
+    RequestPerfQueryReadback(false);
+  }
+
+  s_perf_query_values_read[type]++;
+  return s_perf_query_values[type];
+}
+
 u32 VideoBackendBase::Video_GetQueryResult(PerfQueryType type)
 {
   if (!g_perf_query->ShouldEmulate())
@@ -145,6 +199,9 @@ u32 VideoBackendBase::Video_GetQueryResult(PerfQueryType type)
     return 0;
   }
 
+  if (g_ActiveConfig.bPerfQueriesDeferReads)
+    return GetDeferredQueryResult(type);
+
   Fifo::SyncGPU(Fifo::SyncGPUReason::PerfQuery);
 
   AsyncRequests::Event e;
@@ -157,6 +214,54 @@ u32 VideoBackendBase::Video_GetQueryResult(PerfQueryType type)
   return g_perf_query->GetQueryResult(type);
 }
 
+// For deferred bounding box reads. The GPU thread fills s_bbox_readback and then clears the
+// pending flag, the CPU thread only copies it out while no readback is pending.
+static std::array<u16, 4> s_bbox_readback;
+static Common::Flag s_bbox_readback_pending;
+static std::array<u16, 4> s_bbox_values;
+static bool s_bbox_values_valid = false;
+// The coordinates returned since s_bbox_values was last updated
+static u32 s_bbox_values_read = 0;
+
+static void RequestBoundingBoxReadback(bool blocking)
+{
+  AsyncRequests::Event e;
+  e.time = 0;
+  e.type = AsyncRequests::Event::BBOX_READBACK;
+  e.bbox_readback.data = s_bbox_readback.data();
+  e.bbox_readback.pending = &s_bbox_readback_pending;
+  s_bbox_readback_pending.Set();
+  AsyncRequests::GetInstance()->PushEvent(e, blocking);
+}
+
+static u16 GetDeferredBoundingBox(int index)
+{
+  if (!s_bbox_values_valid)
+  {
+    // Nothing to go on yet, so the first read waits for the GPU like it normally would
+    Fifo::SyncGPU(Fifo::SyncGPUReason::BBox);
+    RequestBoundingBoxReadback(true);
+    if (s_bbox_readback_pending.IsSet())
+      return 0;
+
+    s_bbox_values_valid = true;
+    s_bbox_values_read = ~0u;
+  }
+
+  // Reading a coordinate again means the game has started on a new set. Answer it from the newest
+  // finished readback, so all four values come from the same one, and start the next readback
+  // without waiting for it.
+  if ((s_bbox_values_read & (1u << index)) && !s_bbox_readback_pending.IsSet())
+  {
+    s_bbox_values = s_bbox_readback;
+    s_bbox_values_read = 0;
+    RequestBoundingBoxReadback(false);
+  }
+
+  s_bbox_values_read |= 1u << index;
+  return s_bbox_values[index];
+}
+
 u16 VideoBackendBase::Video_GetBoundingBox(int index)
 {
   if (!g_ActiveConfig.bBBoxEnable)
@@ -184,6 +289,9 @@ u16 VideoBackendBase::Video_GetBoundingBox(int index)
     return 0;
   }
 
+  if (g_ActiveConfig.bBBoxDeferReads)
+    return GetDeferredBoundingBox(index);
+
   Fifo::SyncGPU(Fifo::SyncGPUReason::BBox);
 
   AsyncRequests::Event e;
@@ -280,14 +388,18 @@ void VideoBackendBase::DoState(PointerWrap& p)
   Fifo::GpuMaySleep();
 }
 
-void VideoBackendBase::InitializeShared()
+// The CoreTiming events of the command processor and pixel engine are registered here, so this
+// has to follow HW::Init
+static void InitializeEmulatedState()
 {
   memset(&g_main_cp_state, 0, sizeof(g_main_cp_state));
   memset(&g_preprocess_cp_state, 0, sizeof(g_preprocess_cp_state));
   memset(texMem, 0, TMEM_SIZE);
 
-  // do not initialize again for the config window
-  m_initialized = true;
+  s_bbox_readback_pending.Clear();
+  s_bbox_values_valid = false;
+  s_perf_query_readback_pending.Clear();
+  s_perf_query_values_valid = false;
 
   CommandProcessor::Init();
   Fifo::Init();
@@ -298,11 +410,37 @@ void VideoBackendBase::InitializeShared()
   VertexShaderManager::Init();
   GeometryShaderManager::Init();
   PixelShaderManager::Init();
+}
+
+void VideoBackendBase::InitializeShared()
+{
+  // do not initialize again for the config window
+  m_initialized = true;
+
+  InitializeEmulatedState();
 
   g_Config.VerifyValidity();
   UpdateActiveConfig();
 }
 
+void VideoBackendBase::ResetEmulatedState()
+{
+  // Draw what the last game left batched with its own state, before that goes away
+  g_vertex_manager->Flush();
+
+  // The memory pending EFB copies were headed for is gone, and nothing in the cache is valid for
+  // the next game's memory
+  g_texture_cache->DiscardAll();
+
+  VertexLoaderManager::Clear();
+  Fifo::Shutdown();
+  InitializeEmulatedState();
+
+  // The game config layers changed, so the game-specific files are picked up for the new game
+  HiresTexture::Update();
+  g_shader_cache->ReloadGameCaches();
+}
+
 void VideoBackendBase::ShutdownShared()
 {
   m_initialized = false;
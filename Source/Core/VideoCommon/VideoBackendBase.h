@@ -71,6 +71,12 @@ public:
   // Wrapper function which pushes the event to the GPU thread.
   void DoState(PointerWrap& p);
 
+  // Puts all emulated GPU state back to how it is at boot, so that another game can run without
+  // the backend being initialized again. What the host has built up, like the compiled shaders
+  // and the texture pool, is kept. Called on the video thread with the GPU loop stopped, after
+  // the hardware was initialized for the next game.
+  void ResetEmulatedState();
+
 protected:
   void InitializeShared();
   void ShutdownShared();
@@ -78,6 +78,8 @@ struct VideoConfig final
   u32 iMultisamples;
   bool bSSAA;
   int iEFBScale;
+  bool bDynamicResolution;
+  int iDynamicResolutionMinScale;
   bool bForceFiltering;
   int iMaxAnisotropy;
   std::string sPostProcessingShader;
@@ -92,6 +94,9 @@ struct VideoConfig final
   bool bShowNetPlayMessages;
   bool bOverlayStats;
   bool bOverlayProjStats;
+  bool bOverlayProfiler;
+  bool bOverlayJitStats;
+  bool bExportProfilerCSV;
   bool bTexFmtOverlayEnable;
   bool bTexFmtOverlayCenter;
   bool bLogRenderTimeToFile;
@@ -106,10 +111,12 @@ struct VideoConfig final
   bool bDumpBaseTextures;
   bool bHiresTextures;
   bool bCacheHiresTextures;
+  bool bStreamHiresTextures;
   bool bDumpEFBTarget;
   bool bDumpXFBTarget;
   bool bDumpFramesAsImages;
   bool bUseFFV1;
+  bool bDumpHardwareEncoder;
   std::string sDumpCodec;
   std::string sDumpEncoder;
   std::string sDumpFormat;
@@ -124,8 +131,14 @@ struct VideoConfig final
   // Hacks
   bool bEFBAccessEnable;
   bool bEFBAccessDeferInvalidation;
+  // Read back the EFB tiles that were peeked in the last frame as soon as the game syncs
+  bool bEFBAccessPrefetch;
   bool bPerfQueriesEnable;
+  // Answer perf query reads from the previous readback instead of waiting for the GPU
+  bool bPerfQueriesDeferReads;
   bool bBBoxEnable;
+  // Answer bounding box reads from the previous readback instead of waiting for the GPU
+  bool bBBoxDeferReads;
   bool bForceProgressive;
 
   bool bEFBEmulateFormatChanges;
@@ -133,15 +146,22 @@ struct VideoConfig final
   bool bSkipXFBCopyToRam;
   bool bDisableCopyToVRAM;
   bool bDeferEFBCopies;
+  // Let deferred EFB copies stay pending over one end of frame when nothing else flushes them
+  bool bDeferEFBCopiesAcrossFrames;
   bool bImmediateXFB;
   bool bSkipPresentingDuplicateXFBs;
   bool bCopyEFBScaled;
   int iSafeTextureCache_ColorSamples;
+  int iTextureCacheBudget;  // MiB
   float fAspectRatioHackW, fAspectRatioHackH;
   bool bEnablePixelLighting;
   bool bFastDepthCalc;
   bool bVertexRounding;
   int iEFBAccessTileSize;
+  // Number of frames to skip drawing after each drawn frame while running unthrottled
+  int iFrameSkip;
+  // Reuse the converted vertices of batches that are submitted again with the same data
+  bool bCacheVertexLoads;
   int iLog;           // CONF_ bits
   int iSaveTargetId;  // TODO: Should be dropped
 
@@ -162,6 +182,7 @@ struct VideoConfig final
   int drawEnd;
   bool bZComploc;
   bool bZFreeze;
+  int iSWRasterizerThreads;
   bool bDumpObjects;
   bool bDumpTevStages;
   bool bDumpTevTextureFetches;
@@ -176,8 +197,17 @@ struct VideoConfig final
   // Currently only supported with Vulkan.
   int iCommandBufferExecuteInterval;
 
+  // Record draws into command buffers on a worker thread, overlapping with FIFO processing.
+  // Currently only supported with Vulkan.
+  bool bThreadedCommandRecording;
+
   // Shader compilation settings.
   bool bWaitForShadersBeforeStarting;
+  // Also use and extend the pipeline UID database shared by all games, see ShaderCache.
+  bool bSharedPipelineUIDCache;
+  // Share the driver's pipeline cache live with other instances running at the same time.
+  // Currently only supported with Vulkan.
+  bool bSharedDriverPipelineCache;
   ShaderCompilationMode iShaderCompilationMode;
 
   // Number of shader compiler threads.
@@ -250,6 +280,7 @@ struct VideoConfig final
   bool UsingUberShaders() const;
   u32 GetShaderCompilerThreads() const;
   u32 GetShaderPrecompilerThreads() const;
+  u32 GetSWRasterizerThreads() const;
 };
 
 extern VideoConfig g_Config;
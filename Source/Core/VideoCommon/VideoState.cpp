@@ -33,6 +33,15 @@ void VideoCommon_DoState(PointerWrap& p)
     p.SetMode(PointerWrap::MODE_VERIFY);
   }
 
+  // Get the EFB and texture cache readbacks going on the GPU first, so they overlap with
+  // serializing the rest instead of stalling one after another.
+  if (p.GetMode() == PointerWrap::MODE_WRITE)
+  {
+    g_framebuffer_manager->QueueSaveStateReadbacks();
+    g_texture_cache->QueueSaveStateReadbacks();
+    g_renderer->Flush();
+  }
+
   // BP Memory
   p.Do(bpmem);
   p.DoMarker("BP Memory");
@@ -2,6 +2,8 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
+
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
@@ -23,6 +25,19 @@ static void XFMemWritten(u32 transferSize, u32 baseAddress)
   VertexShaderManager::InvalidateXFRange(baseAddress, baseAddress + transferSize);
 }
 
+// Whether the part of a register group that the transfer covers gets a different value
+static bool XFRegsDiffer(u32 address, u32 group_end, int transferSize, DataReader src,
+                         u32 dataIndex)
+{
+  const u32 end = std::min(group_end, address + static_cast<u32>(transferSize));
+  for (u32 i = address; i < end; ++i)
+  {
+    if (((u32*)&xfmem)[i] != src.Peek<u32>((dataIndex + i - address) * sizeof(u32)))
+      return true;
+  }
+  return false;
+}
+
 static void XFRegWritten(int transferSize, u32 baseAddress, DataReader src)
 {
   u32 address = baseAddress;
@@ -55,8 +70,10 @@ static void XFRegWritten(int transferSize, u32 baseAddress, DataReader src)
 
     case XFMEM_SETNUMCHAN:
       if (xfmem.numChan.numColorChans != (newValue & 3))
+      {
         g_vertex_manager->Flush();
-      VertexShaderManager::SetLightingConfigChanged();
+        VertexShaderManager::SetLightingConfigChanged();
+      }
       break;
 
     case XFMEM_SETCHAN0_AMBCOLOR:  // Channel Ambient Color
@@ -89,13 +106,17 @@ static void XFRegWritten(int transferSize, u32 baseAddress, DataReader src)
     case XFMEM_SETCHAN1_ALPHA:
       if (((u32*)&xfmem)[address] != (newValue & 0x7fff))
         g_vertex_manager->Flush();
-      VertexShaderManager::SetLightingConfigChanged();
+      // The constants hold the whole register
+      if (((u32*)&xfmem)[address] != newValue)
+        VertexShaderManager::SetLightingConfigChanged();
       break;
 
     case XFMEM_DUALTEX:
       if (xfmem.dualTexTrans.enabled != (newValue & 1))
+      {
         g_vertex_manager->Flush();
-      VertexShaderManager::SetTexMatrixInfoChanged(-1);
+        VertexShaderManager::SetTexMatrixInfoChanged(-1);
+      }
       break;
 
     case XFMEM_SETMATRIXINDA:
@@ -111,10 +132,13 @@ static void XFRegWritten(int transferSize, u32 baseAddress, DataReader src)
     case XFMEM_SETVIEWPORT + 3:
     case XFMEM_SETVIEWPORT + 4:
     case XFMEM_SETVIEWPORT + 5:
-      g_vertex_manager->Flush();
-      VertexShaderManager::SetViewportChanged();
-      PixelShaderManager::SetViewportChanged();
-      GeometryShaderManager::SetViewportChanged();
+      if (XFRegsDiffer(address, XFMEM_SETVIEWPORT + 6, transferSize, src, dataIndex))
+      {
+        g_vertex_manager->Flush();
+        VertexShaderManager::SetViewportChanged();
+        PixelShaderManager::SetViewportChanged();
+        GeometryShaderManager::SetViewportChanged();
+      }
 
       nextAddress = XFMEM_SETVIEWPORT + 6;
       break;
@@ -126,9 +150,12 @@ static void XFRegWritten(int transferSize, u32 baseAddress, DataReader src)
     case XFMEM_SETPROJECTION + 4:
     case XFMEM_SETPROJECTION + 5:
     case XFMEM_SETPROJECTION + 6:
-      g_vertex_manager->Flush();
-      VertexShaderManager::SetProjectionChanged();
-      GeometryShaderManager::SetProjectionChanged();
+      if (XFRegsDiffer(address, XFMEM_SETPROJECTION + 7, transferSize, src, dataIndex))
+      {
+        g_vertex_manager->Flush();
+        VertexShaderManager::SetProjectionChanged();
+        GeometryShaderManager::SetProjectionChanged();
+      }
 
       nextAddress = XFMEM_SETPROJECTION + 7;
       break;
@@ -146,8 +173,11 @@ static void XFRegWritten(int transferSize, u32 baseAddress, DataReader src)
     case XFMEM_SETTEXMTXINFO + 5:
     case XFMEM_SETTEXMTXINFO + 6:
     case XFMEM_SETTEXMTXINFO + 7:
-      g_vertex_manager->Flush();
-      VertexShaderManager::SetTexMatrixInfoChanged(address - XFMEM_SETTEXMTXINFO);
+      if (XFRegsDiffer(address, XFMEM_SETTEXMTXINFO + 8, transferSize, src, dataIndex))
+      {
+        g_vertex_manager->Flush();
+        VertexShaderManager::SetTexMatrixInfoChanged(address - XFMEM_SETTEXMTXINFO);
+      }
 
       nextAddress = XFMEM_SETTEXMTXINFO + 8;
       break;
@@ -160,8 +190,11 @@ static void XFRegWritten(int transferSize, u32 baseAddress, DataReader src)
     case XFMEM_SETPOSTMTXINFO + 5:
     case XFMEM_SETPOSTMTXINFO + 6:
     case XFMEM_SETPOSTMTXINFO + 7:
-      g_vertex_manager->Flush();
-      VertexShaderManager::SetTexMatrixInfoChanged(address - XFMEM_SETPOSTMTXINFO);
+      if (XFRegsDiffer(address, XFMEM_SETPOSTMTXINFO + 8, transferSize, src, dataIndex))
+      {
+        g_vertex_manager->Flush();
+        VertexShaderManager::SetTexMatrixInfoChanged(address - XFMEM_SETPOSTMTXINFO);
+      }
 
       nextAddress = XFMEM_SETPOSTMTXINFO + 8;
       break;
@@ -235,10 +268,28 @@ void LoadXFReg(u32 transferSize, u32 baseAddress, DataReader src)
       transferSize = 0;
     }
 
-    XFMemWritten(xfMemTransferSize, xfMemBase);
+    // Games often reload the same matrices before every draw, so only break the batch when the
+    // data actually differs, like LoadIndexedXF does
+    u32* const currData = (u32*)&xfmem + xfMemBase;
+    bool changed = false;
     for (u32 i = 0; i < xfMemTransferSize; i++)
     {
-      ((u32*)&xfmem)[xfMemBase + i] = src.Read<u32>();
+      if (currData[i] != src.Peek<u32>(static_cast<int>(i * sizeof(u32))))
+      {
+        changed = true;
+        break;
+      }
+    }
+
+    if (changed)
+    {
+      XFMemWritten(xfMemTransferSize, xfMemBase);
+      for (u32 i = 0; i < xfMemTransferSize; i++)
+        currData[i] = src.Read<u32>();
+    }
+    else
+    {
+      src.Skip(xfMemTransferSize * sizeof(u32));
     }
   }
 
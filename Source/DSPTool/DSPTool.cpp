@@ -25,9 +25,8 @@ void DSP::Host::WriteHostMemory(u8 value, u32 addr)
 void DSP::Host::OSD_AddMessage(std::string str, u32 ms)
 {
 }
-bool DSP::Host::OnThread()
+void DSP::Host::WaitForMemoryAccess()
 {
-  return false;
 }
 bool DSP::Host::IsWiiHost()
 {
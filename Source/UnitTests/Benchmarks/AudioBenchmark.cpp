@@ -0,0 +1,73 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <array>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "AudioCommon/Mixer.h"
+#include "Common/CommonTypes.h"
+
+#define AX_GC
+#include "Core/HW/DSPHLE/UCodes/AXVoice.h"
+
+namespace
+{
+// Mixing one frame of a voice into every main and aux channel, for as many voices as a game
+// usually has playing. Decoding the samples goes through ARAM and isn't covered here.
+void BM_AXMixAdd(benchmark::State& state)
+{
+  const int num_voices = static_cast<int>(state.range(0));
+  const bool ramp = state.range(1) != 0;
+
+  std::array<s16, MAX_SAMPLES_PER_FRAME> samples;
+  for (size_t i = 0; i < samples.size(); ++i)
+    samples[i] = static_cast<s16>(i * 1000 - 16000);
+  std::array<std::array<int, MAX_SAMPLES_PER_FRAME>, 9> channels{};
+  std::array<u16, 2> volume = {0x6000, 0x10};
+  s16 dpop = 0;
+
+  for (auto _ : state)
+  {
+    for (int voice = 0; voice < num_voices; ++voice)
+    {
+      for (auto& channel : channels)
+      {
+        DSP::HLE::MixAdd(channel.data(), samples.data(), MAX_SAMPLES_PER_FRAME, volume.data(),
+                         &dpop, ramp);
+      }
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * num_voices * channels.size() *
+                          MAX_SAMPLES_PER_FRAME);
+}
+BENCHMARK(BM_AXMixAdd)->ArgNames({"voices", "ramp"})->Args({16, 0})->Args({64, 0})->Args({64, 1});
+
+// Resampling the 32 kHz DMA stream to the output rate, which is what the mixer does for most of
+// the audio a game plays
+void BM_MixerResample(benchmark::State& state)
+{
+  constexpr unsigned int OUTPUT_SAMPLE_RATE = 48000;
+  // 5 ms of stereo audio at a time, like a typical backend callback
+  constexpr unsigned int OUTPUT_FRAMES = OUTPUT_SAMPLE_RATE / 200;
+  constexpr unsigned int INPUT_FRAMES = 32000 / 200;
+
+  Mixer mixer(OUTPUT_SAMPLE_RATE);
+  std::vector<short> input(INPUT_FRAMES * 2);
+  for (size_t i = 0; i < input.size(); ++i)
+    input[i] = static_cast<short>((i * 1237) & 0x3FFF);
+  std::vector<short> output(OUTPUT_FRAMES * 2);
+
+  for (auto _ : state)
+  {
+    mixer.PushSamples(input.data(), INPUT_FRAMES);
+    benchmark::DoNotOptimize(mixer.Mix(output.data(), OUTPUT_FRAMES));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * OUTPUT_FRAMES);
+}
+BENCHMARK(BM_MixerResample);
+}  // namespace
@@ -0,0 +1,78 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Common/ChunkFile.h"
+#include "Common/CommonTypes.h"
+#include "Common/Hash.h"
+
+namespace
+{
+std::vector<u8> MakeData(size_t size)
+{
+  std::vector<u8> data(size);
+  u32 seed = 0x12345678;
+  for (u8& byte : data)
+  {
+    seed = seed * 1103515245 + 12345;
+    byte = static_cast<u8>(seed >> 16);
+  }
+  return data;
+}
+
+// Texture hashing with an argument of 0 samples hashes every byte, like a game without
+// "Fast Texture Cache" would.
+void BM_GetHash64(benchmark::State& state)
+{
+  Common::SetHash64Function();
+  const std::vector<u8> data = MakeData(state.range(0));
+  const u32 samples = static_cast<u32>(state.range(1));
+  const u32 size = static_cast<u32>(data.size());
+  for (auto _ : state)
+    benchmark::DoNotOptimize(Common::GetHash64(data.data(), size, samples));
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_GetHash64)->Apply([](benchmark::internal::Benchmark* b) {
+  for (const int size : {1 << 10, 1 << 16, 1 << 20})
+  {
+    for (const int samples : {0, 128})
+      b->Args({size, samples});
+  }
+});
+
+void BM_HashAdler32(benchmark::State& state)
+{
+  const std::vector<u8> data = MakeData(state.range(0));
+  for (auto _ : state)
+    benchmark::DoNotOptimize(Common::HashAdler32(data.data(), data.size()));
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_HashAdler32)->Arg(1 << 16);
+
+// Savestates and rollback snapshots spend most of their time copying MEM1 and MEM2
+constexpr u32 WII_RAM_SIZE = 0x01800000 + 0x04000000;
+
+void BM_PointerWrapFullRAM(benchmark::State& state)
+{
+  const auto mode = static_cast<PointerWrap::Mode>(state.range(0));
+  std::vector<u8> ram = MakeData(WII_RAM_SIZE);
+  std::vector<u8> buffer(WII_RAM_SIZE);
+  for (auto _ : state)
+  {
+    u8* ptr = buffer.data();
+    PointerWrap p(&ptr, mode);
+    p.DoArray(ram.data(), WII_RAM_SIZE);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * WII_RAM_SIZE);
+}
+BENCHMARK(BM_PointerWrapFullRAM)
+    ->Arg(PointerWrap::MODE_WRITE)
+    ->Arg(PointerWrap::MODE_READ)
+    ->Arg(PointerWrap::MODE_MEASURE)
+    ->Unit(benchmark::kMillisecond);
+}  // namespace
@@ -0,0 +1,176 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Common/CommonTypes.h"
+#include "DiscIO/VolumeWii.h"
+#include "DiscIO/WIACompression.h"
+
+namespace
+{
+enum class Method
+{
+  Bzip2,
+  LZMA,
+  LZMA2,
+  Zstd,
+};
+
+// The size of a chunk in an RVZ file with the default settings
+constexpr size_t CHUNK_SIZE = 0x20000;
+
+// Game data is a mix of runs that compress well and runs that barely compress at all
+std::vector<u8> MakeChunk()
+{
+  std::vector<u8> data(CHUNK_SIZE);
+  u32 seed = 0x12345678;
+  for (size_t i = 0; i < data.size(); ++i)
+  {
+    seed = seed * 1103515245 + 12345;
+    data[i] = (i & 0x1000) ? static_cast<u8>(seed >> 16) : static_cast<u8>(i >> 4);
+  }
+  return data;
+}
+
+struct CompressedChunk
+{
+  std::vector<u8> data;
+  std::array<u8, 7> compressor_data{};
+  u8 compressor_data_size = 0;
+};
+
+std::unique_ptr<DiscIO::Compressor> CreateCompressor(Method method, CompressedChunk* chunk)
+{
+  switch (method)
+  {
+  case Method::Bzip2:
+    return std::make_unique<DiscIO::Bzip2Compressor>(9);
+  case Method::LZMA:
+  case Method::LZMA2:
+    return std::make_unique<DiscIO::LZMACompressor>(method == Method::LZMA2, 5,
+                                                    chunk->compressor_data.data(),
+                                                    &chunk->compressor_data_size);
+  case Method::Zstd:
+  default:
+    return std::make_unique<DiscIO::ZstdCompressor>(5);
+  }
+}
+
+std::unique_ptr<DiscIO::Decompressor> CreateDecompressor(Method method,
+                                                         const CompressedChunk& chunk)
+{
+  switch (method)
+  {
+  case Method::Bzip2:
+    return std::make_unique<DiscIO::Bzip2Decompressor>();
+  case Method::LZMA:
+  case Method::LZMA2:
+    return std::make_unique<DiscIO::LZMADecompressor>(
+        method == Method::LZMA2, chunk.compressor_data.data(), chunk.compressor_data_size);
+  case Method::Zstd:
+  default:
+    return std::make_unique<DiscIO::ZstdDecompressor>();
+  }
+}
+
+bool Compress(Method method, const std::vector<u8>& data, CompressedChunk* chunk)
+{
+  std::unique_ptr<DiscIO::Compressor> compressor = CreateCompressor(method, chunk);
+  if (!compressor->Start(data.size()) || !compressor->Compress(data.data(), data.size()) ||
+      !compressor->End())
+  {
+    return false;
+  }
+
+  chunk->data.assign(compressor->GetData(), compressor->GetData() + compressor->GetSize());
+  return true;
+}
+
+void BM_WIACompress(benchmark::State& state)
+{
+  const auto method = static_cast<Method>(state.range(0));
+  const std::vector<u8> data = MakeChunk();
+  CompressedChunk chunk;
+
+  for (auto _ : state)
+  {
+    if (!Compress(method, data, &chunk))
+    {
+      state.SkipWithError("Compression failed");
+      break;
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+void BM_WIADecompress(benchmark::State& state)
+{
+  const auto method = static_cast<Method>(state.range(0));
+  const std::vector<u8> data = MakeChunk();
+  CompressedChunk chunk;
+  if (!Compress(method, data, &chunk))
+  {
+    state.SkipWithError("Compression failed");
+    return;
+  }
+
+  DiscIO::DecompressionBuffer in;
+  in.data = chunk.data;
+  in.bytes_written = chunk.data.size();
+  DiscIO::DecompressionBuffer out;
+  out.data.resize(data.size());
+
+  for (auto _ : state)
+  {
+    std::unique_ptr<DiscIO::Decompressor> decompressor = CreateDecompressor(method, chunk);
+    out.bytes_written = 0;
+    size_t in_bytes_read = 0;
+    while (out.bytes_written < out.data.size())
+    {
+      const size_t previous_bytes_written = out.bytes_written;
+      if (!decompressor->Decompress(in, &out, &in_bytes_read) ||
+          out.bytes_written == previous_bytes_written)
+      {
+        state.SkipWithError("Decompression failed");
+        return;
+      }
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+void Methods(benchmark::internal::Benchmark* b)
+{
+  b->ArgName("method");
+  for (const Method method : {Method::Bzip2, Method::LZMA, Method::LZMA2, Method::Zstd})
+    b->Arg(static_cast<int>(method));
+}
+BENCHMARK(BM_WIACompress)->Apply(Methods)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_WIADecompress)->Apply(Methods)->Unit(benchmark::kMicrosecond);
+
+// Re-encrypting a group is what reading a Wii partition from a WIA or RVZ file costs on top of
+// the decompression. The data is left zeroed, so this only measures hashing and AES.
+void BM_EncryptGroup(benchmark::State& state)
+{
+  const std::array<u8, DiscIO::VolumeWii::AES_KEY_SIZE> key{};
+  auto out = std::make_unique<std::array<u8, DiscIO::VolumeWii::GROUP_TOTAL_SIZE>>();
+
+  for (auto _ : state)
+  {
+    if (!DiscIO::VolumeWii::EncryptGroup(0, 0, 0, key, nullptr, out.get()))
+    {
+      state.SkipWithError("Encryption failed");
+      break;
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * DiscIO::VolumeWii::GROUP_TOTAL_SIZE);
+}
+BENCHMARK(BM_EncryptGroup)->Unit(benchmark::kMillisecond)->UseRealTime();
+}  // namespace
@@ -0,0 +1,55 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/TextureDecoder.h"
+
+namespace
+{
+constexpr int WIDTH = 512;
+constexpr int HEIGHT = 512;
+
+void BM_TexDecoder_Decode(benchmark::State& state)
+{
+  const auto format = static_cast<TextureFormat>(state.range(0));
+  const auto tlut_format = static_cast<TLUTFormat>(state.range(1));
+
+  std::vector<u8> src(TexDecoder_GetTextureSizeInBytes(WIDTH, HEIGHT, format));
+  for (size_t i = 0; i < src.size(); ++i)
+    src[i] = static_cast<u8>(i * 7 + (i >> 8));
+  // Big enough for C14X2
+  std::vector<u8> tlut(0x4000 * 2);
+  for (size_t i = 0; i < tlut.size(); ++i)
+    tlut[i] = static_cast<u8>(i);
+  std::vector<u8> dst(WIDTH * HEIGHT * 4);
+
+  for (auto _ : state)
+  {
+    TexDecoder_Decode(dst.data(), src.data(), WIDTH, HEIGHT, format, tlut.data(), tlut_format);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * WIDTH * HEIGHT);
+  state.SetBytesProcessed(state.iterations() * src.size());
+}
+
+void TextureFormats(benchmark::internal::Benchmark* b)
+{
+  for (const TextureFormat format :
+       {TextureFormat::I4, TextureFormat::I8, TextureFormat::IA4, TextureFormat::IA8,
+        TextureFormat::RGB565, TextureFormat::RGB5A3, TextureFormat::RGBA8, TextureFormat::CMPR})
+  {
+    b->Args({static_cast<int>(format), static_cast<int>(TLUTFormat::IA8)});
+  }
+  for (const TextureFormat format : {TextureFormat::C4, TextureFormat::C8, TextureFormat::C14X2})
+  {
+    for (const TLUTFormat tlut_format : {TLUTFormat::IA8, TLUTFormat::RGB565, TLUTFormat::RGB5A3})
+      b->Args({static_cast<int>(format), static_cast<int>(tlut_format)});
+  }
+}
+BENCHMARK(BM_TexDecoder_Decode)->Apply(TextureFormats)->ArgNames({"format", "tlut"});
+}  // namespace
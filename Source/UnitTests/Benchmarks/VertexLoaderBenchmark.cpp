@@ -0,0 +1,120 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/CPMemory.h"
+#include "VideoCommon/DataReader.h"
+#include "VideoCommon/IndexGenerator.h"
+#include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/VertexLoader.h"
+#include "VideoCommon/VertexLoaderBase.h"
+#include "VideoCommon/VertexLoaderManager.h"
+#include "VideoCommon/VideoConfig.h"
+
+namespace
+{
+constexpr int NUM_VERTICES = 0x10000;
+
+// A common layout for 3D geometry: indexed position and normal, a direct color and one set of
+// texture coordinates.
+void GetTypicalFormat(TVtxDesc* vtx_desc, VAT* vtx_attr)
+{
+  std::memset(vtx_desc, 0, sizeof(*vtx_desc));
+  std::memset(vtx_attr, 0, sizeof(*vtx_attr));
+
+  vtx_desc->Position = INDEX16;
+  vtx_attr->g0.PosElements = 1;
+  vtx_attr->g0.PosFormat = FORMAT_FLOAT;
+  vtx_desc->Normal = INDEX16;
+  vtx_attr->g0.NormalFormat = FORMAT_SHORT;
+  vtx_desc->Color0 = DIRECT;
+  vtx_attr->g0.Color0Elements = 1;
+  vtx_attr->g0.Color0Comp = FORMAT_32B_8888;
+  vtx_desc->Tex0Coord = DIRECT;
+  vtx_attr->g0.Tex0CoordElements = 1;
+  vtx_attr->g0.Tex0CoordFormat = FORMAT_SHORT;
+  vtx_attr->g0.Tex0Frac = 8;
+  vtx_attr->g0.ByteDequant = true;
+}
+
+template <bool software>
+void BM_VertexLoader(benchmark::State& state)
+{
+  TVtxDesc vtx_desc;
+  VAT vtx_attr;
+  GetTypicalFormat(&vtx_desc, &vtx_attr);
+
+  std::vector<float> positions(NUM_VERTICES * 3, 1.0f);
+  std::vector<s16> normals(NUM_VERTICES * 3, 0x1000);
+  VertexLoaderManager::cached_arraybases[ARRAY_POSITION] =
+      reinterpret_cast<u8*>(positions.data());
+  g_main_cp_state.array_strides[ARRAY_POSITION] = 3 * sizeof(float);
+  VertexLoaderManager::cached_arraybases[ARRAY_NORMAL] = reinterpret_cast<u8*>(normals.data());
+  g_main_cp_state.array_strides[ARRAY_NORMAL] = 3 * sizeof(s16);
+
+  std::unique_ptr<VertexLoaderBase> loader;
+  if (software)
+    loader = std::make_unique<VertexLoader>(vtx_desc, vtx_attr);
+  else
+    loader = VertexLoaderBase::CreateVertexLoader(vtx_desc, vtx_attr);
+
+  std::vector<u8> input(NUM_VERTICES * loader->m_VertexSize);
+  for (int i = 0; i < NUM_VERTICES; ++i)
+  {
+    // Big endian indices into the arrays
+    u8* vertex = input.data() + i * loader->m_VertexSize;
+    vertex[0] = vertex[2] = static_cast<u8>(i >> 8);
+    vertex[1] = vertex[3] = static_cast<u8>(i);
+  }
+  std::vector<u8> output(NUM_VERTICES * loader->m_native_vtx_decl.stride);
+
+  for (auto _ : state)
+  {
+    DataReader src(input.data(), input.data() + input.size());
+    DataReader dst(output.data(), output.data() + output.size());
+    benchmark::DoNotOptimize(loader->RunVertices(src, dst, NUM_VERTICES));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * NUM_VERTICES);
+}
+BENCHMARK_TEMPLATE(BM_VertexLoader, false)->Name("BM_VertexLoader/Compiled");
+BENCHMARK_TEMPLATE(BM_VertexLoader, true)->Name("BM_VertexLoader/Software");
+
+void BM_IndexGenerator(benchmark::State& state)
+{
+  const int primitive = static_cast<int>(state.range(0));
+  const u32 num_vertices = static_cast<u32>(state.range(1));
+  g_Config.backend_info.bSupportsPrimitiveRestart = state.range(2) != 0;
+
+  IndexGenerator generator;
+  generator.Init();
+  // Draws are split up so that they fit into a 16-bit index buffer
+  constexpr u32 DRAWS = 0x8000;
+  std::vector<u16> indices(DRAWS * num_vertices * 3);
+
+  for (auto _ : state)
+  {
+    generator.Start(indices.data());
+    for (u32 i = 0; i < DRAWS && generator.GetNumVerts() + num_vertices <= UINT16_MAX; ++i)
+      generator.AddIndices(primitive, num_vertices);
+    benchmark::DoNotOptimize(generator.GetIndexLen());
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BM_IndexGenerator)
+    ->ArgNames({"primitive", "verts", "restart"})
+    ->Args({OpcodeDecoder::GX_DRAW_TRIANGLES, 3, 0})
+    ->Args({OpcodeDecoder::GX_DRAW_TRIANGLE_STRIP, 4, 0})
+    ->Args({OpcodeDecoder::GX_DRAW_TRIANGLE_STRIP, 4, 1})
+    ->Args({OpcodeDecoder::GX_DRAW_TRIANGLE_STRIP, 32, 1})
+    ->Args({OpcodeDecoder::GX_DRAW_TRIANGLE_FAN, 8, 0})
+    ->Args({OpcodeDecoder::GX_DRAW_QUADS, 4, 0})
+    ->Args({OpcodeDecoder::GX_DRAW_LINES, 2, 0});
+}  // namespace
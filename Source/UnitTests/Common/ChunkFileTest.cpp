@@ -0,0 +1,67 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "Common/ChunkFile.h"
+#include "Common/CommonTypes.h"
+
+static void DoTestState(PointerWrap& p, u32& a, std::string& b, u64& c)
+{
+  p.Do(a);
+  p.Do(b);
+  p.Do(c);
+}
+
+TEST(PointerWrap, WriteWithinEnd)
+{
+  u32 a = 0x12345678;
+  std::string b = "state";
+  u64 c = 0x1122334455667788;
+
+  std::vector<u8> buffer(64);
+  u8* ptr = buffer.data();
+  PointerWrap p(&ptr, PointerWrap::MODE_WRITE);
+  p.SetWriteEnd(buffer.data() + buffer.size());
+  DoTestState(p, a, b, c);
+  EXPECT_FALSE(p.WriteOverflowed());
+  EXPECT_EQ(p.GetMode(), PointerWrap::MODE_WRITE);
+  const size_t size = ptr - buffer.data();
+
+  u32 a2 = 0;
+  std::string b2;
+  u64 c2 = 0;
+  ptr = buffer.data();
+  PointerWrap read(&ptr, PointerWrap::MODE_READ);
+  DoTestState(read, a2, b2, c2);
+  EXPECT_EQ(static_cast<size_t>(ptr - buffer.data()), size);
+  EXPECT_EQ(a2, a);
+  EXPECT_EQ(b2, b);
+  EXPECT_EQ(c2, c);
+}
+
+TEST(PointerWrap, WriteOverflowMeasuresTheRest)
+{
+  u32 a = 1;
+  std::string b = "a string that doesn't fit";
+  u64 c = 2;
+
+  u8* ptr = nullptr;
+  PointerWrap measure(&ptr, PointerWrap::MODE_MEASURE);
+  DoTestState(measure, a, b, c);
+  const size_t size = reinterpret_cast<size_t>(ptr);
+
+  // One guard byte after the end, which must stay untouched
+  std::vector<u8> buffer(9, 0xCC);
+  ptr = buffer.data();
+  PointerWrap p(&ptr, PointerWrap::MODE_WRITE);
+  p.SetWriteEnd(buffer.data() + 8);
+  DoTestState(p, a, b, c);
+  EXPECT_TRUE(p.WriteOverflowed());
+  EXPECT_EQ(p.GetMode(), PointerWrap::MODE_MEASURE);
+  EXPECT_EQ(static_cast<size_t>(ptr - buffer.data()), size);
+  EXPECT_EQ(buffer[8], 0xCC);
+}
@@ -0,0 +1,73 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <gtest/gtest.h>
+#include <memory>
+
+#include "Common/Config/Config.h"
+
+namespace
+{
+class NullLoader final : public Config::ConfigLayerLoader
+{
+public:
+  explicit NullLoader(Config::LayerType layer) : ConfigLayerLoader(layer) {}
+  void Load(Config::Layer*) override {}
+  void Save(Config::Layer*) override {}
+};
+
+const Config::Info<int> TEST_INT{{Config::System::Main, "Test", "Int"}, 1};
+const Config::Info<bool> TEST_BOOL{{Config::System::Main, "Test", "Bool"}, false};
+
+class ConfigTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    Config::AddLayer(std::make_unique<NullLoader>(Config::LayerType::Base));
+    Config::Init();
+  }
+  void TearDown() override { Config::Shutdown(); }
+};
+}  // namespace
+
+TEST_F(ConfigTest, CachedValueFollowsChanges)
+{
+  EXPECT_EQ(Config::Get(TEST_INT), 1);
+  EXPECT_EQ(Config::Get(TEST_INT), 1);
+
+  Config::SetBase(TEST_INT, 5);
+  EXPECT_EQ(Config::Get(TEST_INT), 5);
+
+  // Higher layers override the cached base value
+  Config::SetCurrent(TEST_INT, 7);
+  EXPECT_EQ(Config::Get(TEST_INT), 7);
+
+  Config::ClearCurrentRunLayer();
+  EXPECT_EQ(Config::Get(TEST_INT), 5);
+}
+
+TEST_F(ConfigTest, DirectLayerChangesInvalidateTheCache)
+{
+  EXPECT_FALSE(Config::Get(TEST_BOOL));
+
+  const u64 version = Config::GetConfigVersion();
+  Config::GetLayer(Config::LayerType::Base)->Set(TEST_BOOL, true);
+  EXPECT_NE(Config::GetConfigVersion(), version);
+  EXPECT_TRUE(Config::Get(TEST_BOOL));
+
+  Config::GetLayer(Config::LayerType::Base)->DeleteKey(TEST_BOOL.location);
+  EXPECT_FALSE(Config::Get(TEST_BOOL));
+}
+
+TEST_F(ConfigTest, CopiesReadTheCurrentValue)
+{
+  Config::SetBase(TEST_INT, 3);
+  EXPECT_EQ(Config::Get(TEST_INT), 3);
+
+  const Config::Info<int> copy = TEST_INT;
+  Config::SetBase(TEST_INT, 4);
+  EXPECT_EQ(Config::Get(copy), 4);
+  EXPECT_EQ(Config::Get(TEST_INT), 4);
+}
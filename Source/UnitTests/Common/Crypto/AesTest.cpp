@@ -0,0 +1,67 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <array>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/Crypto/AES.h"
+
+constexpr std::array<u8, 16> KEY{{0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15,
+                                  0x88, 0x09, 0xcf, 0x4f, 0x3c}};
+constexpr std::array<u8, 16> IV{{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a,
+                                 0x0b, 0x0c, 0x0d, 0x0e, 0x0f}};
+
+static std::vector<u8> MakeData(size_t size)
+{
+  std::vector<u8> data(size);
+  for (size_t i = 0; i < size; ++i)
+    data[i] = static_cast<u8>(i * 7 + 3);
+  return data;
+}
+
+TEST(AES, CBCDecryptorMatchesMbedtls)
+{
+  const Common::AES::CBCDecryptor decryptor(KEY.data());
+
+  // Sizes both above and below the number of blocks that are decrypted at once
+  for (size_t blocks : {1, 3, 4, 5, 8, 11})
+  {
+    const std::vector<u8> encrypted = MakeData(blocks * 16);
+    std::array<u8, 16> expected_iv = IV;
+    const std::vector<u8> expected =
+        Common::AES::Decrypt(KEY.data(), expected_iv.data(), encrypted.data(), encrypted.size());
+
+    std::array<u8, 16> iv = IV;
+    std::vector<u8> decrypted(encrypted.size());
+    decryptor.Decrypt(iv.data(), encrypted.data(), decrypted.data(), encrypted.size());
+    EXPECT_EQ(decrypted, expected);
+    EXPECT_EQ(iv, expected_iv);
+
+    // In place, continuing from one call to the next
+    iv = IV;
+    std::vector<u8> in_place = encrypted;
+    decryptor.Decrypt(iv.data(), in_place.data(), in_place.data(), 16);
+    decryptor.Decrypt(iv.data(), in_place.data() + 16, in_place.data() + 16, in_place.size() - 16);
+    EXPECT_EQ(in_place, expected);
+    EXPECT_EQ(iv, expected_iv);
+  }
+}
+
+TEST(AES, CBCDecryptorReversesCBCEncryptor)
+{
+  const std::vector<u8> data = MakeData(0x400);
+
+  std::array<u8, 16> iv = IV;
+  std::vector<u8> encrypted(data.size());
+  Common::AES::CBCEncryptor(KEY.data()).Encrypt(iv.data(), data.data(), encrypted.data(),
+                                                data.size());
+
+  iv = IV;
+  std::vector<u8> decrypted(data.size());
+  Common::AES::CBCDecryptor(KEY.data()).Decrypt(iv.data(), encrypted.data(), decrypted.data(),
+                                                data.size());
+  EXPECT_EQ(decrypted, data);
+}
@@ -0,0 +1,40 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/GekkoDisassembler.h"
+
+using Common::GekkoDisassembler;
+
+TEST(GekkoDisassembler, Disassemble)
+{
+  EXPECT_EQ(GekkoDisassembler::Disassemble(0x38600001, 0), "li\tr3, 1");
+  EXPECT_EQ(GekkoDisassembler::Disassemble(0x4e800020, 0), "blr\t");
+  EXPECT_EQ(GekkoDisassembler::Disassemble(0x48000010, 0x80003100), "b\t->0x80003110");
+}
+
+TEST(GekkoDisassembler, DisassembleRangeMatchesSingleInstructions)
+{
+  std::mt19937 rng(1234);
+  std::vector<u32> code(20000);
+  for (u32& opcode : code)
+    opcode = static_cast<u32>(rng());
+
+  constexpr u32 start_address = 0x80004000;
+  const std::vector<std::string> range =
+      GekkoDisassembler::DisassembleRange(code.data(), code.size(), start_address);
+  ASSERT_EQ(range.size(), code.size());
+  for (size_t i = 0; i < code.size(); i++)
+  {
+    const u32 address = start_address + static_cast<u32>(i * 4);
+    EXPECT_EQ(range[i], GekkoDisassembler::Disassemble(code[i], address));
+  }
+
+  EXPECT_TRUE(GekkoDisassembler::DisassembleRange(code.data(), 0, start_address).empty());
+}
@@ -0,0 +1,44 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <vector>
+
+#include "Common/ThreadPool.h"
+
+using namespace Common::ThreadPool;
+
+TEST(ThreadPool, ParallelForRunsEveryIndexOnce)
+{
+  std::vector<std::atomic<int>> runs(1000);
+  ParallelFor(runs.size(), [&runs](size_t i) { runs[i]++; });
+  for (const auto& count : runs)
+    EXPECT_EQ(count, 1);
+}
+
+TEST(ThreadPool, NestedParallelFor)
+{
+  std::atomic<int> total{0};
+  ParallelFor(16, [&total](size_t) {
+    ParallelFor(16, [&total](size_t) { total++; });
+  });
+  EXPECT_EQ(total, 256);
+}
+
+TEST(ThreadPool, JobGroupWaitsForItsJobs)
+{
+  std::atomic<int> done{0};
+  {
+    JobGroup group;
+    for (int i = 0; i < 100; i++)
+      group.Submit(i % 2 ? Priority::High : Priority::Low, [&done] { done++; });
+    group.Wait();
+    EXPECT_EQ(done, 100);
+
+    group.Submit(Priority::Low, [&done] { done++; });
+  }
+  // The destructor waits as well
+  EXPECT_EQ(done, 101);
+}
@@ -0,0 +1,53 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+
+#include "Common/FileUtil.h"
+#include "Common/Trace.h"
+
+static std::string RecordTrace()
+{
+  const std::string dir = File::CreateTempDir();
+  const std::string path = dir + "/trace.json";
+
+  Common::Trace::Start();
+  {
+    Common::Trace::Scope scope("Main scope");
+  }
+  std::thread thread([] {
+    Common::Trace::SetCurrentThreadName("Worker \"1\"");
+    Common::Trace::Scope scope("Worker scope");
+  });
+  thread.join();
+  EXPECT_TRUE(Common::Trace::StopAndWrite(path));
+
+  std::string trace;
+  File::ReadFileToString(path, trace);
+  File::DeleteDirRecursively(dir);
+  return trace;
+}
+
+TEST(Trace, RecordsScopesOfAllThreads)
+{
+  const std::string trace = RecordTrace();
+
+  EXPECT_EQ(0u, trace.find("{\"traceEvents\":["));
+  EXPECT_NE(std::string::npos, trace.find("\"name\":\"Main scope\",\"ph\":\"X\""));
+  EXPECT_NE(std::string::npos, trace.find("\"name\":\"Worker scope\",\"ph\":\"X\""));
+  EXPECT_NE(std::string::npos, trace.find("\"args\":{\"name\":\"Worker \\\"1\\\"\"}"));
+}
+
+TEST(Trace, NothingIsRecordedWhileStopped)
+{
+  RecordTrace();
+  {
+    Common::Trace::Scope scope("Stopped scope");
+  }
+
+  const std::string trace = RecordTrace();
+  EXPECT_EQ(std::string::npos, trace.find("Stopped scope"));
+}
@@ -279,6 +279,71 @@ TEST(CoreTiming, ScheduleIntoPast)
   AdvanceAndCheck(0, MAX_SLICE_LENGTH, 1000);
 }
 
+TEST(CoreTiming, RemoveEvent)
+{
+  ScopeInit guard;
+
+  CoreTiming::EventType* cb_a = CoreTiming::RegisterEvent("callbackA", CallbackTemplate<0>);
+  CoreTiming::EventType* cb_b = CoreTiming::RegisterEvent("callbackB", CallbackTemplate<1>);
+
+  // Enter slice 0
+  CoreTiming::Advance();
+
+  CoreTiming::ScheduleEvent(100, cb_a, CB_IDS[0]);
+  CoreTiming::ScheduleEvent(300, cb_b, CB_IDS[1]);
+  CoreTiming::ScheduleEvent(200, cb_a, CB_IDS[0]);
+  EXPECT_EQ(100, PowerPC::ppcState.downcount);
+  CoreTiming::RemoveEvent(cb_a);
+
+  // The slice was already shortened, but the removed events must not run
+  s_callbacks_ran_flags = 0;
+  PowerPC::ppcState.downcount = 0;
+  CoreTiming::Advance();
+  EXPECT_EQ(0ULL, s_callbacks_ran_flags.to_ullong());
+  EXPECT_EQ(200, PowerPC::ppcState.downcount);
+
+  // Events scheduled after the removal still run
+  CoreTiming::ScheduleEvent(100, cb_a, CB_IDS[0]);
+  EXPECT_EQ(100, PowerPC::ppcState.downcount);
+  AdvanceAndCheck(0, 100);
+  AdvanceAndCheck(1, MAX_SLICE_LENGTH);
+}
+
+namespace CoalesceTest
+{
+static int s_calls = 0;
+
+static void CountingCallback(u64 userdata, s64 lateness)
+{
+  ++s_calls;
+}
+}  // namespace CoalesceTest
+
+TEST(CoreTiming, Coalesce)
+{
+  using namespace CoalesceTest;
+
+  ScopeInit guard;
+
+  CoreTiming::EventType* cb_a = CoreTiming::RegisterEvent("callbackA", CallbackTemplate<0>);
+  CoreTiming::EventType* cb_count =
+      CoreTiming::RegisterEvent("callbackCount", CountingCallback, true);
+
+  // Enter slice 0
+  CoreTiming::Advance();
+
+  s_calls = 0;
+  CoreTiming::ScheduleEvent(100, cb_count, 0);
+  CoreTiming::ScheduleEvent(100, cb_count, 0);
+  CoreTiming::ScheduleEvent(100, cb_count, 1);
+  CoreTiming::ScheduleEvent(100, cb_a, CB_IDS[0]);
+  CoreTiming::ScheduleEvent(100, cb_count, 1);
+
+  // Only the first two are back to back with the same userdata
+  AdvanceAndCheck(0, MAX_SLICE_LENGTH);
+  EXPECT_EQ(3, s_calls);
+}
+
 TEST(CoreTiming, Overclocking)
 {
   ScopeInit guard;
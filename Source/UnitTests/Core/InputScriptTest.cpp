@@ -0,0 +1,60 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <gtest/gtest.h>
+
+#include "Core/InputScript.h"
+#include "InputCommon/GCPadStatus.h"
+
+TEST(InputScript, InputsAreHeldUntilTheNextLine)
+{
+  std::string error;
+  const auto script = InputScript::Parse("# frame device buttons\n"
+                                         "10 gc0 0100\n"
+                                         "\n"
+                                         "20 gc0 0000 128 255  # up\n",
+                                         &error);
+  ASSERT_TRUE(script);
+
+  EXPECT_FALSE(script->GetGCInput(0, 9));
+  EXPECT_EQ(PAD_BUTTON_A, script->GetGCInput(0, 10)->button);
+  EXPECT_EQ(0xFF, script->GetGCInput(0, 19)->analogA);
+  EXPECT_EQ(0, script->GetGCInput(0, 20)->button);
+  EXPECT_EQ(255, script->GetGCInput(0, 1000)->stickY);
+  EXPECT_FALSE(script->GetGCInput(1, 20));
+}
+
+TEST(InputScript, MissingAnalogValuesAreCentered)
+{
+  std::string error;
+  const auto script = InputScript::Parse("0 gc2 1000 10\n", &error);
+  ASSERT_TRUE(script);
+
+  const GCPadStatus status = *script->GetGCInput(2, 0);
+  EXPECT_EQ(10, status.stickX);
+  EXPECT_EQ(u8{GCPadStatus::MAIN_STICK_CENTER_Y}, status.stickY);
+  EXPECT_EQ(u8{GCPadStatus::C_STICK_CENTER_X}, status.substickX);
+  EXPECT_EQ(0, status.triggerLeft);
+  EXPECT_TRUE(status.isConnected);
+}
+
+TEST(InputScript, ParsesWiimoteButtons)
+{
+  std::string error;
+  const auto script = InputScript::Parse("5 wii3 0808\n", &error);
+  ASSERT_TRUE(script);
+
+  EXPECT_EQ(0x0808, script->GetWiimoteButtons(3, 7));
+  EXPECT_FALSE(script->GetWiimoteButtons(3, 4));
+}
+
+TEST(InputScript, RejectsMalformedLines)
+{
+  std::string error;
+  EXPECT_FALSE(InputScript::Parse("0 gc0 0000\n1 gc4 0000\n", &error));
+  EXPECT_EQ(0u, error.find("line 2"));
+  EXPECT_FALSE(InputScript::Parse("0 gc0 0000 256\n", &error));
+  EXPECT_FALSE(InputScript::Parse("0 wii0 0000 128\n", &error));
+  EXPECT_FALSE(InputScript::Parse("x gc0 0000\n", &error));
+}
@@ -0,0 +1,67 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <gtest/gtest.h>
+
+#include "Core/NetPlayRollback.h"
+#include "InputCommon/GCPadStatus.h"
+
+static GCPadStatus MakeStatus(u16 button)
+{
+  GCPadStatus status{};
+  status.button = button;
+  status.isConnected = true;
+  return status;
+}
+
+TEST(InputPredictor, GuessesLastConfirmedInput)
+{
+  NetPlay::InputPredictor predictor;
+  predictor.ConfirmInput(0, 10, MakeStatus(PAD_BUTTON_A));
+
+  EXPECT_EQ(PAD_BUTTON_A, predictor.GetInput(0, 10).button);
+  EXPECT_EQ(PAD_BUTTON_A, predictor.GetInput(0, 11).button);
+  EXPECT_EQ(0, predictor.GetInput(1, 11).button);
+}
+
+TEST(InputPredictor, CorrectGuessIsNotMispredicted)
+{
+  NetPlay::InputPredictor predictor;
+  predictor.ConfirmInput(0, 10, MakeStatus(PAD_BUTTON_A));
+  predictor.GetInput(0, 11);
+  predictor.ConfirmInput(0, 11, MakeStatus(PAD_BUTTON_A));
+
+  EXPECT_FALSE(predictor.GetFirstMispredictedFrame());
+}
+
+TEST(InputPredictor, ReportsEarliestMisprediction)
+{
+  NetPlay::InputPredictor predictor;
+  predictor.ConfirmInput(0, 10, MakeStatus(PAD_BUTTON_A));
+  for (u64 frame = 11; frame < 15; ++frame)
+  {
+    predictor.GetInput(0, frame);
+    predictor.GetInput(1, frame);
+  }
+
+  predictor.ConfirmInput(1, 13, MakeStatus(PAD_BUTTON_B));
+  predictor.ConfirmInput(0, 12, MakeStatus(PAD_BUTTON_B));
+  EXPECT_EQ(12u, predictor.GetFirstMispredictedFrame());
+
+  predictor.RollBack(12);
+  EXPECT_FALSE(predictor.GetFirstMispredictedFrame());
+
+  // After rolling back, the emulated frames get the confirmed inputs
+  EXPECT_EQ(PAD_BUTTON_B, predictor.GetInput(0, 12).button);
+  EXPECT_EQ(PAD_BUTTON_B, predictor.GetInput(1, 13).button);
+}
+
+TEST(InputPredictor, DiscardKeepsLastConfirmedInput)
+{
+  NetPlay::InputPredictor predictor;
+  predictor.ConfirmInput(0, 10, MakeStatus(PAD_BUTTON_X));
+  predictor.DiscardBefore(20);
+
+  EXPECT_EQ(PAD_BUTTON_X, predictor.GetInput(0, 20).button);
+}
@@ -0,0 +1,75 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <gtest/gtest.h>
+
+#include "Core/StateDelta.h"
+
+using State::DELTA_PAGE_SIZE;
+
+static State::Snapshot MakeSnapshot(std::vector<u32> sections, size_t size)
+{
+  State::Snapshot snapshot;
+  snapshot.sections = std::move(sections);
+  snapshot.buffer.resize(size);
+  for (size_t i = 0; i < size; ++i)
+    snapshot.buffer[i] = static_cast<u8>(i * 7);
+  return snapshot;
+}
+
+TEST(StateDelta, Identical)
+{
+  const State::Snapshot base = MakeSnapshot({0, 100}, DELTA_PAGE_SIZE * 4);
+  const State::Delta delta = State::CreateDelta(base, base);
+
+  EXPECT_TRUE(delta.page_offsets.empty());
+  EXPECT_EQ(base.buffer, State::ApplyDelta(base, delta).buffer);
+}
+
+TEST(StateDelta, ChangedPagesOnly)
+{
+  const State::Snapshot base = MakeSnapshot({0}, DELTA_PAGE_SIZE * 8);
+  State::Snapshot snapshot = base;
+  snapshot.buffer[DELTA_PAGE_SIZE * 2 + 5] ^= 0xFF;
+  snapshot.buffer[DELTA_PAGE_SIZE * 7] ^= 0xFF;
+
+  const State::Delta delta = State::CreateDelta(base, snapshot);
+
+  ASSERT_EQ(2u, delta.page_offsets.size());
+  EXPECT_EQ(DELTA_PAGE_SIZE * 2, delta.page_offsets[0]);
+  EXPECT_EQ(DELTA_PAGE_SIZE * 7, delta.page_offsets[1]);
+  EXPECT_EQ(DELTA_PAGE_SIZE * 2, delta.page_data.size());
+  EXPECT_EQ(snapshot.buffer, State::ApplyDelta(base, delta).buffer);
+}
+
+TEST(StateDelta, SectionGrowthKeepsLaterPagesAligned)
+{
+  // The first section grows by a few bytes, which shifts everything after it
+  const State::Snapshot base = MakeSnapshot({0, 16}, 16 + DELTA_PAGE_SIZE * 4);
+  State::Snapshot snapshot;
+  snapshot.sections = {0, 20};
+  snapshot.buffer.assign(20, 0xAB);
+  snapshot.buffer.insert(snapshot.buffer.end(), base.buffer.begin() + 16, base.buffer.end());
+
+  const State::Delta delta = State::CreateDelta(base, snapshot);
+
+  ASSERT_EQ(1u, delta.page_offsets.size());
+  EXPECT_EQ(0u, delta.page_offsets[0]);
+  EXPECT_EQ(20u, delta.page_data.size());
+  EXPECT_EQ(snapshot.buffer, State::ApplyDelta(base, delta).buffer);
+}
+
+TEST(StateDelta, ShortTrailingPage)
+{
+  const State::Snapshot base = MakeSnapshot({}, DELTA_PAGE_SIZE + 10);
+  State::Snapshot snapshot = MakeSnapshot({}, DELTA_PAGE_SIZE + 30);
+  snapshot.buffer.back() = 0;
+
+  const State::Delta delta = State::CreateDelta(base, snapshot);
+
+  ASSERT_EQ(1u, delta.page_offsets.size());
+  EXPECT_EQ(DELTA_PAGE_SIZE, delta.page_offsets[0]);
+  EXPECT_EQ(30u, delta.page_data.size());
+  EXPECT_EQ(snapshot.buffer, State::ApplyDelta(base, delta).buffer);
+}
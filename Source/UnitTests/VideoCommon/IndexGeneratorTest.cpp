@@ -0,0 +1,104 @@
+// Copyright 2020 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/IndexGenerator.h"
+#include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/VideoConfig.h"
+
+namespace
+{
+constexpr u16 RESTART = UINT16_MAX;
+
+std::vector<u16> Generate(bool primitive_restart, int primitive, u32 first, u32 num_verts)
+{
+  g_Config.backend_info.bSupportsPrimitiveRestart = primitive_restart;
+  IndexGenerator generator;
+  generator.Init();
+
+  std::vector<u16> indices(num_verts * 3 + first * 2 + 16);
+  generator.Start(indices.data());
+  if (first != 0)
+    generator.AddIndices(OpcodeDecoder::GX_DRAW_POINTS, first);
+  generator.AddIndices(primitive, num_verts);
+  indices.resize(generator.GetIndexLen());
+  indices.erase(indices.begin(), indices.begin() + first);
+  return indices;
+}
+
+void AddTriangle(std::vector<u16>* indices, bool primitive_restart, u32 a, u32 b, u32 c)
+{
+  indices->insert(indices->end(), {static_cast<u16>(a), static_cast<u16>(b), static_cast<u16>(c)});
+  if (primitive_restart)
+    indices->push_back(RESTART);
+}
+}  // namespace
+
+TEST(IndexGenerator, Triangles)
+{
+  for (bool pr : {false, true})
+  {
+    for (u32 n = 0; n < 100; ++n)
+    {
+      std::vector<u16> expected;
+      for (u32 i = 2; i < n; i += 3)
+        AddTriangle(&expected, pr, 5 + i - 2, 5 + i - 1, 5 + i);
+      EXPECT_EQ(expected, Generate(pr, OpcodeDecoder::GX_DRAW_TRIANGLES, 5, n)) << n;
+    }
+  }
+}
+
+TEST(IndexGenerator, TriangleStrip)
+{
+  for (u32 n = 0; n < 100; ++n)
+  {
+    std::vector<u16> expected;
+    for (u32 i = 2; i < n; ++i)
+    {
+      if (i % 2 == 0)
+        AddTriangle(&expected, false, 7 + i - 2, 7 + i - 1, 7 + i);
+      else
+        AddTriangle(&expected, false, 7 + i - 2, 7 + i, 7 + i - 1);
+    }
+    EXPECT_EQ(expected, Generate(false, OpcodeDecoder::GX_DRAW_TRIANGLE_STRIP, 7, n)) << n;
+
+    expected.clear();
+    for (u32 i = 0; i < n; ++i)
+      expected.push_back(static_cast<u16>(7 + i));
+    expected.push_back(RESTART);
+    EXPECT_EQ(expected, Generate(true, OpcodeDecoder::GX_DRAW_TRIANGLE_STRIP, 7, n)) << n;
+  }
+}
+
+TEST(IndexGenerator, Quads)
+{
+  for (u32 n = 0; n < 100; ++n)
+  {
+    std::vector<u16> expected;
+    u32 i = 3;
+    for (; i < n; i += 4)
+    {
+      AddTriangle(&expected, false, 3 + i - 3, 3 + i - 2, 3 + i - 1);
+      AddTriangle(&expected, false, 3 + i - 3, 3 + i - 1, 3 + i);
+    }
+    if (i == n)
+      AddTriangle(&expected, false, 3 + n - 3, 3 + n - 2, 3 + n - 1);
+    EXPECT_EQ(expected, Generate(false, OpcodeDecoder::GX_DRAW_QUADS, 3, n)) << n;
+
+    expected.clear();
+    for (i = 3; i < n; i += 4)
+    {
+      expected.insert(expected.end(), {static_cast<u16>(3 + i - 2), static_cast<u16>(3 + i - 1),
+                                       static_cast<u16>(3 + i - 3), static_cast<u16>(3 + i),
+                                       RESTART});
+    }
+    if (i == n)
+      AddTriangle(&expected, true, 3 + n - 3, 3 + n - 2, 3 + n - 1);
+    EXPECT_EQ(expected, Generate(true, OpcodeDecoder::GX_DRAW_QUADS, 3, n)) << n;
+  }
+}